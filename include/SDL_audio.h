@@ -387,6 +387,87 @@ extern DECLSPEC void SDLCALL SDL_PauseAudioDevice(SDL_AudioDeviceID dev,
                                                   int pause_on);
 /* @} *//* Pause audio functions */
 
+/**
+ *  Get the measured latency of an opened audio device, in microseconds.
+ *
+ *  This is the time between audio being handed to the device and it being
+ *  heard, as last reported by the backend.
+ *
+ *  \return The latency in microseconds, or -1 if the device ID is invalid
+ *           or the audio backend can't measure it; call SDL_GetError() for
+ *           more information.
+ */
+extern DECLSPEC int SDLCALL SDL_GetAudioDeviceLatency(SDL_AudioDeviceID dev);
+
+/**
+ *  \name Audio device statistics
+ *
+ *  The audio thread of every open device times each stage of producing a
+ *  buffer, so glitches can be correlated with load.
+ *
+ *  histogram[0] counts measurements under 1 microsecond, and histogram[i]
+ *  counts those of at least 2^(i-1) and under 2^i microseconds.  The last
+ *  bucket also counts everything longer.
+ */
+/* @{ */
+#define SDL_AUDIO_HISTOGRAM_BUCKETS 20
+
+typedef struct SDL_AudioTiming
+{
+    Uint32 count;       /**< Number of measurements */
+    Uint32 max_us;      /**< Longest measurement, in microseconds */
+    Uint64 total_us;    /**< Sum of all measurements, in microseconds */
+    Uint32 histogram[SDL_AUDIO_HISTOGRAM_BUCKETS];
+} SDL_AudioTiming;
+
+typedef struct SDL_AudioDeviceStats
+{
+    Uint32 buffers;     /**< Buffers handed to the device */
+    Uint32 late_buffers;    /**< Buffers that took longer to produce than to play,
+                                 or captured buffers the callback was too slow for */
+    Uint32 xruns;       /**< Underruns/overruns reported by the backend */
+    SDL_AudioTiming lock_wait;  /**< Waiting for the device lock */
+    SDL_AudioTiming callback;   /**< Running the application's callback */
+    SDL_AudioTiming convert;    /**< Converting to the device format */
+    SDL_AudioTiming wait_device;    /**< Waiting for the device to want more */
+} SDL_AudioDeviceStats;
+
+/**
+ *  Get a snapshot of the statistics of an opened audio device.
+ *
+ *  \return 0 on success, or -1 if the device ID is invalid.
+ */
+extern DECLSPEC int SDLCALL SDL_GetAudioDeviceStats(SDL_AudioDeviceID dev,
+                                                    SDL_AudioDeviceStats * stats);
+
+/**
+ *  Clear the statistics of an opened audio device.
+ */
+extern DECLSPEC void SDLCALL SDL_ResetAudioDeviceStats(SDL_AudioDeviceID dev);
+/* @} *//* Audio device statistics */
+
+/**
+ *  A function run on the audio callback thread between two callbacks.
+ */
+typedef void (SDLCALL * SDL_AudioCommandCallback) (void *userdata);
+
+/**
+ *  Queue a function to run on the thread that calls the audio callback,
+ *  right before the next time it does.
+ *
+ *  Commands run in the order they were queued, without the device lock
+ *  held, so they may safely update state the callback reads.  Unlike
+ *  SDL_LockAudioDevice(), queueing a command never blocks, and can be done
+ *  from any thread.  Commands still queued when the device is closed are
+ *  discarded without being run.
+ *
+ *  \return 0 on success, or -1 on error; call SDL_GetError() for more
+ *           information.
+ */
+extern DECLSPEC int SDLCALL SDL_QueueAudioCommand(SDL_AudioDeviceID dev,
+                                                  SDL_AudioCommandCallback callback,
+                                                  void *userdata);
+
 /**
  *  This function loads a WAVE from the data source, automatically freeing
  *  that source if \c freesrc is non-zero.  For example, to load a WAVE file,
@@ -424,6 +505,67 @@ extern DECLSPEC SDL_AudioSpec *SDLCALL SDL_LoadWAV_RW(SDL_RWops * src,
  */
 extern DECLSPEC void SDLCALL SDL_FreeWAV(Uint8 * audio_buf);
 
+/**
+ *  \name WAVE streaming
+ *
+ *  These functions read a WAVE file a piece at a time instead of loading
+ *  and decoding all of it up front like SDL_LoadWAV_RW() does.  The chunk
+ *  headers are parsed once when the stream is opened; after that, only the
+ *  data asked for is read from the data source and decoded, so memory use
+ *  does not grow with the length of the file.  The same raw, float,
+ *  MS-ADPCM and IMA-ADPCM files are supported.
+ */
+/* @{ */
+struct SDL_WAVStream;
+typedef struct SDL_WAVStream SDL_WAVStream;
+
+/**
+ *  Open a WAVE from the data source for streaming, automatically freeing
+ *  that source when the stream is closed if \c freesrc is non-zero.
+ *
+ *  On success, \c spec is filled with the audio data format of the wave
+ *  data, exactly as SDL_LoadWAV_RW() would fill it.
+ *
+ *  \return A new stream, or NULL if the wave file cannot be opened, uses an
+ *          unknown data format, or is corrupt.  The data source is freed
+ *          on failure too if \c freesrc is non-zero.
+ */
+extern DECLSPEC SDL_WAVStream *SDLCALL SDL_OpenWAVStream_RW(SDL_RWops * src,
+                                                            int freesrc,
+                                                            SDL_AudioSpec * spec);
+
+/**
+ *  Get the number of sample frames in a stream.
+ */
+extern DECLSPEC Uint32 SDLCALL SDL_GetWAVStreamLength(SDL_WAVStream * stream);
+
+/**
+ *  Decode up to \c len bytes of audio data from the current position of
+ *  the stream into \c buf, in the format given when it was opened.  Only
+ *  whole sample frames are read.
+ *
+ *  \return The number of bytes read, 0 at the end of the data, or -1 on
+ *          error.
+ */
+extern DECLSPEC int SDLCALL SDL_ReadWAVStream(SDL_WAVStream * stream,
+                                              void *buf, int len);
+
+/**
+ *  Move the read position of a stream to the given sample frame.  Seeking
+ *  to the length of the stream is allowed, and leaves it at the end.
+ *
+ *  \return 0 on success, or -1 if the frame is past the end of the stream.
+ */
+extern DECLSPEC int SDLCALL SDL_SeekWAVStream(SDL_WAVStream * stream,
+                                              Uint32 frame);
+
+/**
+ *  Close a stream, freeing its data source if it was opened with
+ *  \c freesrc set.
+ */
+extern DECLSPEC void SDLCALL SDL_CloseWAVStream(SDL_WAVStream * stream);
+/* @} *//* WAVE streaming */
+
 /**
  *  This function takes a source format and rate and a destination format
  *  and rate, and initializes the \c cvt structure with information needed
@@ -139,6 +139,11 @@ extern DECLSPEC SDL_bool SDLCALL SDL_HasSSE42(void);
  */
 extern DECLSPEC SDL_bool SDLCALL SDL_HasAVX(void);
 
+/**
+ *  This function returns true if the CPU has AVX2 features.
+ */
+extern DECLSPEC SDL_bool SDLCALL SDL_HasAVX2(void);
+
 /**
  *  This function returns the amount of RAM configured in the system, in MB.
  */
@@ -94,6 +94,17 @@ extern "C" {
  */
 #define SDL_HINT_RENDER_OPENGL_SHADERS      "SDL_RENDER_OPENGL_SHADERS"
 
+/**
+ *  \brief  A variable controlling whether the OpenGL render driver uploads texture data through pixel buffer objects.
+ *
+ *  This variable can be set to the following values:
+ *    "0"       - Upload texture data directly from application memory
+ *    "1"       - Stage texture uploads in a ring of pixel buffer objects
+ *
+ *  By default pixel buffer objects are used if OpenGL supports them.
+ */
+#define SDL_HINT_RENDER_OPENGL_PBO          "SDL_RENDER_OPENGL_PBO"
+
 /**
  *  \brief  A variable controlling whether the Direct3D device is initialized for thread-safe operations.
  *
@@ -123,7 +134,7 @@ extern "C" {
  *
  *  This variable can be set to the following values:
  *    "0" or "nearest" - Nearest pixel sampling
- *    "1" or "linear"  - Linear filtering (supported by OpenGL and Direct3D)
+ *    "1" or "linear"  - Linear filtering (supported by OpenGL, Direct3D and the software renderer)
  *    "2" or "best"    - Currently this is the same as "linear"
  *
  *  By default nearest pixel sampling is used
@@ -141,6 +152,117 @@ extern "C" {
  */
 #define SDL_HINT_RENDER_VSYNC               "SDL_RENDER_VSYNC"
 
+/**
+ *  \brief  A variable controlling whether SDL_RenderCopy() and SDL_RenderFillRects() are batched.
+ *
+ *  When batching is enabled, draws are queued and submitted to the driver
+ *  together, as few draws as possible for each texture, when the renderer
+ *  state changes or SDL_RenderPresent() is called.  Applications that mix
+ *  their own OpenGL or Direct3D calls with the renderer's must call
+ *  SDL_RenderFlush() before doing so.
+ *
+ *  This variable can be set to the following values:
+ *    "0"       - Draws are submitted to the driver immediately
+ *    "1"       - Draws are batched, if the render driver supports it
+ *
+ *  By default draws are batched only when the application lets SDL choose the
+ *  render driver, passing -1 to SDL_CreateRenderer() without setting
+ *  SDL_HINT_RENDER_DRIVER.  The hint is checked when a renderer is created.
+ */
+#define SDL_HINT_RENDER_BATCHING            "SDL_RENDER_BATCHING"
+
+/**
+ *  \brief  A variable controlling whether small static textures are packed into shared textures.
+ *
+ *  When the atlas is enabled, textures created with SDL_TEXTUREACCESS_STATIC
+ *  that are no larger than 128x128 are packed into larger textures shared
+ *  with other textures of the same format, so that drawing different
+ *  textures one after another can be batched into a single draw.
+ *  SDL_GL_BindTexture() fails for textures that were packed.
+ *
+ *  This variable can be set to the following values:
+ *    "0"       - Every texture is created separately
+ *    "1"       - Small static textures are packed together
+ *
+ *  By default textures are not packed.  The hint is checked when a renderer is created.
+ */
+#define SDL_HINT_RENDER_ATLAS               "SDL_RENDER_ATLAS"
+
+/**
+ *  \brief  A variable controlling how many threads the software renderer draws with.
+ *
+ *  When more than one thread is used, fills, points and unscaled copies are
+ *  recorded and drawn when the frame is presented or read back, with the
+ *  target split into tiles that are drawn in parallel.  Lines and scaled or
+ *  rotated copies are still drawn as they are submitted.
+ *
+ *  This variable can be set to the following values:
+ *    "0"       - Use one thread per CPU
+ *    "1"       - Draw everything immediately on the calling thread
+ *    "N"       - Use N threads
+ *
+ *  By default the software renderer uses one thread.  The hint is checked when a renderer is created.
+ */
+#define SDL_HINT_RENDER_SOFTWARE_THREADS    "SDL_RENDER_SOFTWARE_THREADS"
+
+/**
+ *  \brief  A variable setting how large a surface blit has to be before it's split between threads.
+ *
+ *  Software blits, scaled or not, that write at least this many pixels are
+ *  split into bands of rows that are blitted in parallel, one thread per
+ *  CPU.  Blits smaller than 128x128 pixels and blits within a single surface
+ *  are always done on the calling thread.  The same threshold applies to
+ *  the size of surfaces being RLE encoded for SDL_RLEACCEL.
+ *
+ *  This variable can be set to the following values:
+ *    "0"       - Blits are always done on the calling thread
+ *    "N"       - Blits writing N pixels or more are split between threads
+ *
+ *  By default blits are done on the calling thread.  The hint is checked for each blit.
+ */
+#define SDL_HINT_BLIT_THREADS_THRESHOLD     "SDL_BLIT_THREADS_THRESHOLD"
+
+/**
+ *  \brief  A variable setting the alignment of the rows of new surfaces, in bytes.
+ *
+ *  Surfaces created by SDL_CreateRGBSurface(), which includes textures of
+ *  the software renderer, get a pitch that is a multiple of this many bytes,
+ *  and their pixels start on a 64 byte boundary.  Such surfaces have the
+ *  SDL_SIMD_ALIGNED flag set.  Blits and fills choose their SIMD code from
+ *  the actual alignment of the rows they are given, not from the flag, so
+ *  aligned rows let them skip the work of lining up each row.
+ *
+ *  The pixels of SDL_SIMD_ALIGNED surfaces are not the pointer that was
+ *  allocated, so applications must not free them, or replace them with
+ *  pixels of their own, even if they also set or clear SDL_PREALLOC.  Doing
+ *  so can crash or corrupt the heap.  Code that manages the pixels of
+ *  surfaces itself should leave this hint at "4".
+ *
+ *  This variable can be set to the following values:
+ *    "4"       - Rows are aligned to 4 bytes, as they always used to be
+ *    "16"      - Rows are aligned to 16 bytes, for SSE
+ *    "32"      - Rows are aligned to 32 bytes, for AVX
+ *    "64"      - Rows are aligned to 64 bytes, a cache line on most CPUs
+ *
+ *  By default rows are aligned to 4 bytes.  Other powers of two up to 64 work
+ *  too.  The hint is checked when a surface is created.
+ */
+#define SDL_HINT_SURFACE_ALIGNMENT          "SDL_SURFACE_ALIGNMENT"
+
+/**
+ *  \brief  A variable controlling how YUV textures are converted to RGB when they are drawn in software.
+ *
+ *  This applies to renderers without native YUV support, such as the software renderer.
+ *
+ *  This variable can be set to the following values:
+ *    "JPEG"    - Full range BT.601, as used by JPEG
+ *    "BT601"   - Video range BT.601, for standard definition video
+ *    "BT709"   - Video range BT.709, for high definition video
+ *
+ *  By default JPEG conversion is used.  The hint is checked when a texture is created.
+ */
+#define SDL_HINT_YUV_CONVERSION_MODE        "SDL_YUV_CONVERSION_MODE"
+
 /**
  *  \brief  A variable controlling whether the screensaver is enabled. 
  *
@@ -435,6 +557,63 @@ extern "C" {
  */
 #define SDL_HINT_VIDEO_MAC_FULLSCREEN_SPACES    "SDL_VIDEO_MAC_FULLSCREEN_SPACES"
 
+/**
+ *  \brief  A variable specifying the output latency to aim for, in milliseconds.
+ *
+ *  Audio backends that can control their buffering (currently PulseAudio)
+ *  size the server-side buffer to this many milliseconds and may pick a
+ *  smaller callback size than requested in SDL_AudioSpec::samples to meet
+ *  it.  The buffer grows again if the device underruns.
+ *
+ *  By default this is unset, and the latency is derived from the requested
+ *  buffer size.  This hint must be set before the audio device is opened.
+ */
+#define SDL_HINT_AUDIO_TARGET_LATENCY "SDL_AUDIO_TARGET_LATENCY"
+
+/**
+ *  \brief  A variable controlling how often audio device statistics are logged, in milliseconds.
+ *
+ *  When set to a positive number, each audio device thread logs its
+ *  SDL_AudioDeviceStats to SDL_LOG_CATEGORY_AUDIO at this interval, with
+ *  SDL_LOG_PRIORITY_INFO.
+ *
+ *  By default this is unset, and nothing is logged.  This hint must be set
+ *  before the audio device is opened.
+ */
+#define SDL_HINT_AUDIO_STATS_INTERVAL "SDL_AUDIO_STATS_INTERVAL"
+
+/**
+ *  \brief  A variable controlling how many buffers the audio callback renders ahead.
+ *
+ *  When set to 2 or more, the audio callback runs on its own thread and
+ *  renders into a ring of this many buffers while the device plays from
+ *  it.  SDL_LockAudioDevice() then only holds up rendering, not playback,
+ *  at the cost of that many buffers of extra latency.  If the callback
+ *  still falls behind, the device plays silence instead of waiting.
+ *
+ *  Capture devices always hand captured buffers to the callback through
+ *  such a ring, so a slow callback drops buffers instead of overrunning
+ *  the device.  This hint sets its size there, which defaults to 4.
+ *
+ *  By default this is unset, and the callback feeds the device directly.
+ *  This hint must be set before the audio device is opened.
+ */
+#define SDL_HINT_AUDIO_RENDER_AHEAD "SDL_AUDIO_RENDER_AHEAD"
+
+/**
+ *  \brief  A variable controlling how many threads SDL_LoadWAV_RW() decodes ADPCM data with.
+ *
+ *  ADPCM blocks are independent, so a large file can be split between
+ *  threads.  Each thread is given at least a few hundred kilobytes of
+ *  output, so small files are always decoded on the calling thread.
+ *
+ *  This variable can be set to the following values:
+ *    "0"       - Use one thread per CPU core
+ *    "1"       - Decode on the calling thread (default)
+ *    "N"       - Use up to N threads, including the calling thread
+ */
+#define SDL_HINT_AUDIO_DECODE_THREADS "SDL_AUDIO_DECODE_THREADS"
+
 
 /**
  *  \brief  An enumeration of hint priorities
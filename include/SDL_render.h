@@ -830,6 +830,19 @@ extern DECLSPEC int SDLCALL SDL_RenderReadPixels(SDL_Renderer * renderer,
  */
 extern DECLSPEC void SDLCALL SDL_RenderPresent(SDL_Renderer * renderer);
 
+/**
+ *  \brief Submit any batched rendering to the driver.
+ *
+ *  Rendering is flushed automatically when the renderer state changes and
+ *  by SDL_RenderPresent(), so this is only needed before mixing your own
+ *  OpenGL or Direct3D calls with the renderer's.
+ *
+ *  \return 0 on success, or -1 if any of the batched rendering failed.
+ *
+ *  \sa SDL_HINT_RENDER_BATCHING
+ */
+extern DECLSPEC int SDLCALL SDL_RenderFlush(SDL_Renderer * renderer);
+
 /**
  *  \brief Destroy the specified texture.
  *
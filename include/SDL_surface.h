@@ -53,6 +53,10 @@ extern "C" {
 #define SDL_PREALLOC        0x00000001  /**< Surface uses preallocated memory */
 #define SDL_RLEACCEL        0x00000002  /**< Surface is RLE encoded */
 #define SDL_DONTFREE        0x00000004  /**< Surface is referenced internally */
+#define SDL_SIMD_ALIGNED    0x00000008  /**< Surface uses aligned memory,
+                                             whose pixels mustn't be freed or
+                                             replaced by the application.
+                                             \sa SDL_HINT_SURFACE_ALIGNMENT */
 /* @} *//* Surface flags */
 
 /**
@@ -245,7 +249,8 @@ extern DECLSPEC int SDLCALL SDL_GetColorKey(SDL_Surface * surface,
  *  \param g The green color value multiplied into blit operations.
  *  \param b The blue color value multiplied into blit operations.
  *
- *  \return 0 on success, or -1 if the surface is not valid.
+ *  \return 0 on success, or -1 if the surface is not valid or can't be
+ *          blitted with color modulation.
  *
  *  \sa SDL_GetSurfaceColorMod()
  */
@@ -275,7 +280,8 @@ extern DECLSPEC int SDLCALL SDL_GetSurfaceColorMod(SDL_Surface * surface,
  *  \param surface The surface to update.
  *  \param alpha The alpha value multiplied into blit operations.
  *
- *  \return 0 on success, or -1 if the surface is not valid.
+ *  \return 0 on success, or -1 if the surface is not valid or can't be
+ *          blitted with alpha modulation.
  *
  *  \sa SDL_GetSurfaceAlphaMod()
  */
@@ -301,7 +307,8 @@ extern DECLSPEC int SDLCALL SDL_GetSurfaceAlphaMod(SDL_Surface * surface,
  *  \param surface The surface to update.
  *  \param blendMode ::SDL_BlendMode to use for blit blending.
  *
- *  \return 0 on success, or -1 if the parameters are not valid.
+ *  \return 0 on success, or -1 if the parameters are not valid or the
+ *          surface can't be blitted with that blend mode.
  *
  *  \sa SDL_GetSurfaceBlendMode()
  */
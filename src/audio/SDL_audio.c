@@ -24,9 +24,11 @@
 
 #include "SDL.h"
 #include "SDL_audio.h"
+#include "SDL_bits.h"
 #include "SDL_audio_c.h"
 #include "SDL_audiomem.h"
 #include "SDL_sysaudio.h"
+#include "../thread/SDL_thread_c.h"
 
 #define _THIS SDL_AudioDevice *_this
 
@@ -187,6 +189,12 @@ SDL_AudioCloseDevice_Default(_THIS)
 {                               /* no-op. */
 }
 
+static int
+SDL_AudioGetDeviceLatency_Default(_THIS)
+{
+    return SDL_Unsupported();
+}
+
 static void
 SDL_AudioDeinitialize_Default(void)
 {                               /* no-op. */
@@ -239,6 +247,7 @@ finalize_audio_entry_points(void)
     FILL_STUB(CloseDevice);
     FILL_STUB(LockDevice);
     FILL_STUB(UnlockDevice);
+    FILL_STUB(GetDeviceLatency);
     FILL_STUB(Deinitialize);
 #undef FILL_STUB
 }
@@ -309,6 +318,263 @@ SDL_StreamDeinit(SDL_AudioStreamer * stream)
 #include <android/log.h>
 #endif
 
+static void
+SDL_AudioTimingAdd(SDL_AudioTiming * timing, Uint64 ticks, Uint64 freq)
+{
+    const Uint64 us64 = (ticks * 1000000) / freq;
+    const Uint32 us = (us64 > 0xFFFFFFFF) ? 0xFFFFFFFF : (Uint32) us64;
+    int bucket = (us == 0) ? 0 : SDL_MostSignificantBitIndex32(us) + 1;
+
+    if (bucket >= SDL_AUDIO_HISTOGRAM_BUCKETS) {
+        bucket = SDL_AUDIO_HISTOGRAM_BUCKETS - 1;
+    }
+    timing->histogram[bucket]++;
+    timing->count++;
+    timing->total_us += us;
+    if (us > timing->max_us) {
+        timing->max_us = us;
+    }
+}
+
+void
+SDL_AudioDeviceXrun(SDL_AudioDevice * device)
+{
+    SDL_AtomicLock(&device->stats_lock);
+    device->stats.xruns++;
+    SDL_AtomicUnlock(&device->stats_lock);
+}
+
+static void
+SDL_LogAudioTiming(const char *name, const SDL_AudioTiming * timing)
+{
+    if (timing->count > 0) {
+        SDL_LogInfo(SDL_LOG_CATEGORY_AUDIO,
+                    "  %-12s avg %6u us, max %6u us\n", name,
+                    (unsigned int) (timing->total_us / timing->count),
+                    (unsigned int) timing->max_us);
+    }
+}
+
+static void
+SDL_LogAudioDeviceStats(SDL_AudioDevice * device)
+{
+    SDL_AudioDeviceStats stats;
+
+    SDL_AtomicLock(&device->stats_lock);
+    stats = device->stats;
+    SDL_AtomicUnlock(&device->stats_lock);
+
+    SDL_LogInfo(SDL_LOG_CATEGORY_AUDIO,
+                "Audio device %p: %u buffers, %u late, %u xruns\n",
+                (void *) device, (unsigned int) stats.buffers,
+                (unsigned int) stats.late_buffers, (unsigned int) stats.xruns);
+    SDL_LogAudioTiming("lock wait", &stats.lock_wait);
+    SDL_LogAudioTiming("callback", &stats.callback);
+    SDL_LogAudioTiming("convert", &stats.convert);
+    SDL_LogAudioTiming("wait device", &stats.wait_device);
+}
+
+static void
+SDL_AudioStatsAdd(SDL_AudioDevice * device, SDL_AudioTiming * timing,
+                  Uint64 ticks)
+{
+    SDL_AtomicLock(&device->stats_lock);
+    SDL_AudioTimingAdd(timing, ticks, SDL_GetPerformanceFrequency());
+    SDL_AtomicUnlock(&device->stats_lock);
+}
+
+/* A queued SDL_QueueAudioCommand() call */
+typedef struct SDL_AudioCommand
+{
+    SDL_AudioCommandCallback callback;
+    void *userdata;
+    struct SDL_AudioCommand *next;
+} SDL_AudioCommand;
+
+static void
+SDL_FreeAudioCommands(SDL_AudioCommand * cmd)
+{
+    while (cmd) {
+        SDL_AudioCommand *next = cmd->next;
+        SDL_free(cmd);
+        cmd = next;
+    }
+}
+
+/* Run everything queued so far, oldest first */
+void
+SDL_RunAudioCommands(SDL_AudioDevice * device)
+{
+    SDL_AudioCommand *cmd;
+    SDL_AudioCommand *list = NULL;
+
+    if (SDL_AtomicGetPtr(&device->commands) == NULL) {
+        return;
+    }
+
+    /* Producers only ever push, so taking the whole stack is ABA-safe */
+    cmd = (SDL_AudioCommand *) SDL_AtomicSetPtr(&device->commands, NULL);
+    while (cmd) {
+        SDL_AudioCommand *next = cmd->next;
+        cmd->next = list;
+        list = cmd;
+        cmd = next;
+    }
+
+    for (cmd = list; cmd; cmd = cmd->next) {
+        cmd->callback(cmd->userdata);
+    }
+    SDL_FreeAudioCommands(list);
+}
+
+/* Run the application's callback (or silence, if paused) on stream */
+static void
+SDL_AudioFill(SDL_AudioDevice * device, Uint8 * stream, int len)
+{
+    Uint64 start, locked, filled;
+
+    SDL_RunAudioCommands(device);
+
+    start = SDL_GetPerformanceCounter();
+    SDL_LockMutex(device->mixer_lock);
+    locked = SDL_GetPerformanceCounter();
+    if (device->paused) {
+        if (!device->iscapture) {
+            SDL_memset(stream, device->spec.silence, len);
+        }
+    } else {
+        (*device->spec.callback) (device->spec.userdata, stream, len);
+    }
+    SDL_UnlockMutex(device->mixer_lock);
+    filled = SDL_GetPerformanceCounter();
+
+    SDL_AudioStatsAdd(device, &device->stats.lock_wait, locked - start);
+    if (!device->paused) {
+        SDL_AudioStatsAdd(device, &device->stats.callback, filled - locked);
+    }
+}
+
+/* The thread that renders ahead into the ring, for SDL_HINT_AUDIO_RENDER_AHEAD */
+static int SDLCALL
+SDL_RunAudioRenderer(void *devicep)
+{
+    SDL_AudioDevice *device = (SDL_AudioDevice *) devicep;
+    Uint8 *slot;
+    Uint64 start;
+    int index = 0;
+
+    SDL_SetThreadPriority(SDL_THREAD_PRIORITY_HIGH);
+
+    while (SDL_SemWait(device->render_free) == 0 && device->enabled) {
+        slot = device->render_buffers + (index * device->render_len);
+        if (device->convert.needed) {
+            SDL_AudioFill(device, device->convert.buf, device->convert.len);
+            start = SDL_GetPerformanceCounter();
+            SDL_ConvertAudio(&device->convert);
+            SDL_memcpy(slot, device->convert.buf, device->convert.len_cvt);
+            SDL_AudioStatsAdd(device, &device->stats.convert,
+                              SDL_GetPerformanceCounter() - start);
+        } else {
+            SDL_AudioFill(device, slot, device->spec.size);
+        }
+        SDL_SemPost(device->render_ready);
+        index = (index + 1) % device->render_count;
+    }
+
+    return 0;
+}
+
+/* The thread that hands captured buffers from the ring to the callback */
+static int SDLCALL
+SDL_RunAudioCaptureCallback(void *devicep)
+{
+    SDL_AudioDevice *device = (SDL_AudioDevice *) devicep;
+    int index = 0;
+
+    SDL_SetThreadPriority(SDL_THREAD_PRIORITY_HIGH);
+
+    while (SDL_SemWait(device->render_ready) == 0 && device->enabled) {
+        SDL_AudioFill(device, device->render_buffers +
+                      (index * device->render_len), device->render_len);
+        SDL_SemPost(device->render_free);
+        index = (index + 1) % device->render_count;
+    }
+
+    return 0;
+}
+
+/* The device thread for capture: read from the device and pass the data on
+   through the ring, dropping it rather than waiting if the ring is full. */
+static void
+SDL_RunAudioCapture(SDL_AudioDevice * device, Uint32 log_interval)
+{
+    const int silence = (int) device->spec.silence;
+    Uint32 last_log = SDL_GetTicks();
+    Uint64 start, captured;
+    Uint8 *slot, *buf;
+    int index = 0;
+    int len, late;
+
+    while (device->enabled) {
+        slot = NULL;
+        if (device->render_thread && SDL_SemTryWait(device->render_free) == 0) {
+            slot = device->render_buffers + (index * device->render_len);
+        }
+        if (device->convert.needed) {
+            buf = device->convert.buf;
+        } else {
+            buf = slot ? slot : device->fake_stream;
+        }
+
+        start = SDL_GetPerformanceCounter();
+        len = current_audio.impl.CaptureFromDevice(device, buf, device->spec.size);
+        captured = SDL_GetPerformanceCounter();
+        if (len < 0) {
+            device->enabled = 0;
+            break;
+        }
+
+        if (device->convert.needed) {
+            device->convert.len = len;
+            SDL_ConvertAudio(&device->convert);
+            len = device->convert.len_cvt;
+            SDL_AudioStatsAdd(device, &device->stats.convert,
+                              SDL_GetPerformanceCounter() - captured);
+        }
+
+        late = 0;
+        if (slot) {
+            if (buf != slot) {
+                len = SDL_min(len, device->render_len);
+                SDL_memcpy(slot, buf, len);
+            }
+            if (len < device->render_len) {
+                SDL_memset(slot + len, silence, device->render_len - len);
+            }
+            SDL_SemPost(device->render_ready);
+            index = (index + 1) % device->render_count;
+        } else if (device->render_thread) {
+            late = 1;  /* the callback fell behind; drop this buffer. */
+        } else {
+            SDL_AudioFill(device, buf, len);
+        }
+
+        SDL_AtomicLock(&device->stats_lock);
+        device->stats.buffers++;
+        if (late) {
+            device->stats.late_buffers++;
+        }
+        SDL_AudioTimingAdd(&device->stats.wait_device, captured - start,
+                           SDL_GetPerformanceFrequency());
+        SDL_AtomicUnlock(&device->stats_lock);
+
+        if (log_interval && SDL_TICKS_PASSED(SDL_GetTicks(), last_log + log_interval)) {
+            SDL_LogAudioDeviceStats(device);
+            last_log = SDL_GetTicks();
+        }
+    }
+}
+
 /* The general mixing thread function */
 int SDLCALL
 SDL_RunAudio(void *devicep)
@@ -316,9 +582,20 @@ SDL_RunAudio(void *devicep)
     SDL_AudioDevice *device = (SDL_AudioDevice *) devicep;
     Uint8 *stream;
     int stream_len;
+#if 0  /* !!! FIXME: rewrite/remove this streamer code. */
     void *udata;
     void (SDLCALL * fill) (void *userdata, Uint8 * stream, int len);
+#endif
     Uint32 delay;
+    const Uint64 freq = SDL_GetPerformanceFrequency();
+    Uint64 buffer_ticks;
+    Uint64 start, filled, converted, played, waited;
+    int late;
+    int render_index = 0;
+    int render_primed = 0;
+    const char *hint;
+    Uint32 log_interval = 0;
+    Uint32 last_log = 0;
 
 #if 0  /* !!! FIXME: rewrite/remove this streamer code. */
     /* For streaming when the buffer sizes don't match up */
@@ -333,9 +610,11 @@ SDL_RunAudio(void *devicep)
     device->threadid = SDL_ThreadID();
     current_audio.impl.ThreadInit(device);
 
+#if 0  /* !!! FIXME: rewrite/remove this streamer code. */
     /* Set up the mixing function */
     fill = device->spec.callback;
     udata = device->spec.userdata;
+#endif
 
     /* By default do not stream */
     device->use_streamer = 0;
@@ -371,6 +650,20 @@ SDL_RunAudio(void *devicep)
     /* Calculate the delay while paused */
     delay = ((device->spec.samples * 1000) / device->spec.freq);
 
+    /* A buffer that takes longer than this to produce will starve the device */
+    buffer_ticks = (device->spec.samples * freq) / device->spec.freq;
+
+    hint = SDL_GetHint(SDL_HINT_AUDIO_STATS_INTERVAL);
+    if (hint && SDL_atoi(hint) > 0) {
+        log_interval = (Uint32) SDL_atoi(hint);
+        last_log = SDL_GetTicks();
+    }
+
+    if (device->iscapture && current_audio.impl.CaptureFromDevice) {
+        SDL_RunAudioCapture(device, log_interval);
+        return 0;
+    }
+
     /* Determine if the streamer is necessary here */
 #if 0  /* !!! FIXME: rewrite/remove this streamer code. */
     if (device->use_streamer == 1) {
@@ -467,50 +760,93 @@ SDL_RunAudio(void *devicep)
         /* Otherwise, do not use the streamer. This is the old code. */
         const int silence = (int) device->spec.silence;
 
+        /* Don't start the device until the renderer has something for it */
+        while (device->render_thread && device->enabled && !render_primed) {
+            render_primed = (SDL_SemWaitTimeout(device->render_ready, delay) == 0);
+        }
+
         /* Loop, filling the audio buffers */
         while (device->enabled) {
 
-            /* Fill the current buffer with sound */
-            if (device->convert.needed) {
-                if (device->convert.buf) {
-                    stream = device->convert.buf;
-                } else {
-                    continue;
-                }
-            } else {
+            if (device->render_thread) {
+                /* Take the oldest rendered buffer, never waiting for one */
                 stream = current_audio.impl.GetDeviceBuf(device);
                 if (stream == NULL) {
                     stream = device->fake_stream;
                 }
-            }
-
-            SDL_LockMutex(device->mixer_lock);
-            if (device->paused) {
-                SDL_memset(stream, silence, stream_len);
+                start = SDL_GetPerformanceCounter();
+                if (render_primed || SDL_SemTryWait(device->render_ready) == 0) {
+                    SDL_memcpy(stream, device->render_buffers +
+                               (render_index * device->spec.size),
+                               device->spec.size);
+                    SDL_SemPost(device->render_free);
+                    render_index = (render_index + 1) % device->render_count;
+                    render_primed = 0;
+                    late = 0;
+                } else {
+                    SDL_memset(stream, silence, device->spec.size);
+                    late = 1;
+                }
+                converted = SDL_GetPerformanceCounter();
             } else {
-                (*fill) (udata, stream, stream_len);
-            }
-            SDL_UnlockMutex(device->mixer_lock);
+                /* Fill the current buffer with sound */
+                if (device->convert.needed) {
+                    if (device->convert.buf) {
+                        stream = device->convert.buf;
+                    } else {
+                        continue;
+                    }
+                } else {
+                    stream = current_audio.impl.GetDeviceBuf(device);
+                    if (stream == NULL) {
+                        stream = device->fake_stream;
+                    }
+                }
 
-            /* Convert the audio if necessary */
-            if (device->convert.needed) {
-                SDL_ConvertAudio(&device->convert);
-                stream = current_audio.impl.GetDeviceBuf(device);
-                if (stream == NULL) {
-                    stream = device->fake_stream;
+                start = SDL_GetPerformanceCounter();
+                SDL_AudioFill(device, stream, stream_len);
+                filled = SDL_GetPerformanceCounter();
+
+                /* Convert the audio if necessary */
+                if (device->convert.needed) {
+                    SDL_ConvertAudio(&device->convert);
+                    stream = current_audio.impl.GetDeviceBuf(device);
+                    if (stream == NULL) {
+                        stream = device->fake_stream;
+                    }
+                    SDL_memcpy(stream, device->convert.buf,
+                               device->convert.len_cvt);
+                    SDL_AudioStatsAdd(device, &device->stats.convert,
+                                      SDL_GetPerformanceCounter() - filled);
                 }
-                SDL_memcpy(stream, device->convert.buf,
-                           device->convert.len_cvt);
+                converted = SDL_GetPerformanceCounter();
+                late = ((converted - start) > buffer_ticks);
             }
 
             /* Ready current buffer for play and change current buffer */
             if (stream != device->fake_stream) {
                 current_audio.impl.PlayDevice(device);
+                played = SDL_GetPerformanceCounter();
                 /* Wait for an audio buffer to become available */
                 current_audio.impl.WaitDevice(device);
             } else {
+                played = SDL_GetPerformanceCounter();
                 SDL_Delay(delay);
             }
+            waited = SDL_GetPerformanceCounter();
+
+            SDL_AtomicLock(&device->stats_lock);
+            device->stats.buffers++;
+            if (late) {
+                device->stats.late_buffers++;
+            }
+            SDL_AudioTimingAdd(&device->stats.wait_device, waited - played, freq);
+            SDL_AtomicUnlock(&device->stats_lock);
+
+            if (log_interval && SDL_TICKS_PASSED(SDL_GetTicks(), last_log + log_interval)) {
+                SDL_LogAudioDeviceStats(device);
+                last_log = SDL_GetTicks();
+            }
         }
     }
 
@@ -763,6 +1099,71 @@ no_such_device:
 }
 
 
+static void
+close_audio_renderer(SDL_AudioDevice * device)
+{
+    if (device->render_thread != NULL) {
+        /* in case it's waiting. */
+        SDL_SemPost(device->render_free);
+        SDL_SemPost(device->render_ready);
+        SDL_WaitThread(device->render_thread, NULL);
+        device->render_thread = NULL;
+    }
+    if (device->render_free != NULL) {
+        SDL_DestroySemaphore(device->render_free);
+        device->render_free = NULL;
+    }
+    if (device->render_ready != NULL) {
+        SDL_DestroySemaphore(device->render_ready);
+        device->render_ready = NULL;
+    }
+    SDL_FreeAudioMem(device->render_buffers);
+    device->render_buffers = NULL;
+    device->render_count = 0;
+}
+
+/* Set up SDL_HINT_AUDIO_RENDER_AHEAD; the device falls back to feeding the
+   callback directly if this fails. */
+static void
+open_audio_renderer(SDL_AudioDevice * device, int id)
+{
+    const char *hint = SDL_GetHint(SDL_HINT_AUDIO_RENDER_AHEAD);
+    int count = hint ? SDL_atoi(hint) : 0;
+    char name[64];
+
+    if (device->iscapture) {
+        /* Only drivers with CaptureFromDevice go through SDL_RunAudioCapture;
+           the old capture path feeds the callback from the device thread. */
+        if (!current_audio.impl.CaptureFromDevice) {
+            return;
+        } else if (count < 2) {
+            count = 4;
+        }
+    } else if (count < 2) {
+        return;
+    }
+
+    device->render_count = count;
+    device->render_buffers = (Uint8 *) SDL_AllocAudioMem(count * device->render_len);
+    device->render_free = SDL_CreateSemaphore(count);
+    device->render_ready = SDL_CreateSemaphore(0);
+    if (!device->render_buffers || !device->render_free || !device->render_ready) {
+        close_audio_renderer(device);
+        return;
+    }
+
+    if (device->iscapture) {
+        SDL_snprintf(name, sizeof (name), "SDLAudioCapture%d", id);
+        device->render_thread = SDL_CreateThreadInternal(SDL_RunAudioCaptureCallback, name, device);
+    } else {
+        SDL_snprintf(name, sizeof (name), "SDLAudioRender%d", id);
+        device->render_thread = SDL_CreateThreadInternal(SDL_RunAudioRenderer, name, device);
+    }
+    if (device->render_thread == NULL) {
+        close_audio_renderer(device);
+    }
+}
+
 static void
 close_audio_device(SDL_AudioDevice * device)
 {
@@ -770,6 +1171,8 @@ close_audio_device(SDL_AudioDevice * device)
     if (device->thread != NULL) {
         SDL_WaitThread(device->thread, NULL);
     }
+    close_audio_renderer(device);
+    SDL_FreeAudioCommands((SDL_AudioCommand *) device->commands);
     if (device->mixer_lock != NULL) {
         SDL_DestroyMutex(device->mixer_lock);
     }
@@ -999,7 +1402,28 @@ open_audio_device(const char *devname, int iscapture,
         SDL_CalculateAudioSpec(obtained);
     }
 
-    if (build_cvt) {
+    if (build_cvt && iscapture) {
+        /* Build an audio conversion block, from the device to the app */
+        if (SDL_BuildAudioCVT(&device->convert,
+                              device->spec.format, device->spec.channels,
+                              device->spec.freq,
+                              obtained->format, obtained->channels,
+                              obtained->freq) < 0) {
+            close_audio_device(device);
+            return 0;
+        }
+        if (device->convert.needed) {
+            device->convert.len = device->spec.size;
+            device->convert.buf =
+                (Uint8 *) SDL_AllocAudioMem(device->convert.len *
+                                            device->convert.len_mult);
+            if (device->convert.buf == NULL) {
+                close_audio_device(device);
+                SDL_OutOfMemory();
+                return 0;
+            }
+        }
+    } else if (build_cvt) {
         /* Build an audio conversion block */
         if (SDL_BuildAudioCVT(&device->convert,
                               obtained->format, obtained->channels,
@@ -1042,18 +1466,10 @@ open_audio_device(const char *devname, int iscapture,
     if (!current_audio.impl.ProvidesOwnCallbackThread) {
         /* Start the audio thread */
         char name[64];
+        device->render_len = iscapture ? obtained->size : device->spec.size;
+        open_audio_renderer(device, (int) (id + 1));
         SDL_snprintf(name, sizeof (name), "SDLAudioDev%d", (int) (id + 1));
-/* !!! FIXME: this is nasty. */
-#if defined(__WIN32__) && !defined(HAVE_LIBC)
-#undef SDL_CreateThread
-#if SDL_DYNAMIC_API
-        device->thread = SDL_CreateThread_REAL(SDL_RunAudio, name, device, NULL, NULL);
-#else
-        device->thread = SDL_CreateThread(SDL_RunAudio, name, device, NULL, NULL);
-#endif
-#else
-        device->thread = SDL_CreateThread(SDL_RunAudio, name, device);
-#endif
+        device->thread = SDL_CreateThreadInternal(SDL_RunAudio, name, device);
         if (device->thread == NULL) {
             SDL_CloseAudioDevice(id + 1);
             SDL_SetError("Couldn't create audio thread");
@@ -1142,6 +1558,70 @@ SDL_PauseAudio(int pause_on)
     SDL_PauseAudioDevice(1, pause_on);
 }
 
+int
+SDL_GetAudioDeviceLatency(SDL_AudioDeviceID devid)
+{
+    SDL_AudioDevice *device = get_audio_device(devid);
+    if (!device) {
+        return -1;
+    }
+    return current_audio.impl.GetDeviceLatency(device);
+}
+
+int
+SDL_GetAudioDeviceStats(SDL_AudioDeviceID devid, SDL_AudioDeviceStats * stats)
+{
+    SDL_AudioDevice *device = get_audio_device(devid);
+    if (!device) {
+        return -1;
+    }
+    if (!stats) {
+        return SDL_InvalidParamError("stats");
+    }
+    SDL_AtomicLock(&device->stats_lock);
+    *stats = device->stats;
+    SDL_AtomicUnlock(&device->stats_lock);
+    return 0;
+}
+
+void
+SDL_ResetAudioDeviceStats(SDL_AudioDeviceID devid)
+{
+    SDL_AudioDevice *device = get_audio_device(devid);
+    if (device) {
+        SDL_AtomicLock(&device->stats_lock);
+        SDL_zero(device->stats);
+        SDL_AtomicUnlock(&device->stats_lock);
+    }
+}
+
+int
+SDL_QueueAudioCommand(SDL_AudioDeviceID devid,
+                      SDL_AudioCommandCallback callback, void *userdata)
+{
+    SDL_AudioDevice *device = get_audio_device(devid);
+    SDL_AudioCommand *cmd;
+
+    if (!device) {
+        return -1;
+    }
+    if (!callback) {
+        return SDL_InvalidParamError("callback");
+    }
+
+    cmd = (SDL_AudioCommand *) SDL_malloc(sizeof (SDL_AudioCommand));
+    if (!cmd) {
+        return SDL_OutOfMemory();
+    }
+    cmd->callback = callback;
+    cmd->userdata = userdata;
+    do {
+        cmd->next = (SDL_AudioCommand *) SDL_AtomicGetPtr(&device->commands);
+    } while (!SDL_AtomicCASPtr(&device->commands, cmd->next, cmd));
+
+    return 0;
+}
+
 
 void
 SDL_LockAudioDevice(SDL_AudioDeviceID devid)
@@ -810,6 +810,145 @@ SDL_ConvertSurround_4(SDL_AudioCVT * cvt, SDL_AudioFormat format)
 }
 
 
+/*
+ * Blocked conversion: instead of running each filter over the whole buffer
+ *  in turn, run the complete filter chain over small blocks that stay in
+ *  the CPU cache. This is only possible when every filter is sample-local
+ *  (type and channel conversions); the resamplers carry state across the
+ *  buffer and need to see all of it in one go.
+ */
+#define SDL_AUDIOCVT_BLOCKSIZE  (16 * 1024)
+
+/* Input blocks must hold whole frames for 1, 2, 4 and 6 channels. */
+#define SDL_AUDIOCVT_BLOCKALIGN 12
+
+/* Below this working set, the separate passes stay in cache anyhow. */
+#define SDL_AUDIOCVT_BLOCKTHRESHOLD  (256 * 1024)
+
+/* Work out the exact size ratio of a blockable filter chain. */
+static SDL_bool
+SDL_GetBlockedCVTRatio(const SDL_AudioCVT * cvt, int *num, int *den)
+{
+    int i = 0;
+
+    /* there's a resampler at the end of the chain; can't block that. */
+    if (cvt->rate_incr != 1.0) {
+        return SDL_FALSE;
+    }
+
+    *num = *den = 1;
+
+    /* the type converter, if any, is always the first filter. */
+    if (cvt->src_format != cvt->dst_format) {
+        *num *= SDL_AUDIO_BITSIZE(cvt->dst_format);
+        *den *= SDL_AUDIO_BITSIZE(cvt->src_format);
+        i++;
+    }
+
+    for (; cvt->filters[i] != NULL; i++) {
+        const SDL_AudioFilter filter = cvt->filters[i];
+        if (filter == SDL_ConvertStereo || filter == SDL_ConvertSurround_4) {
+            *num *= 2;
+        } else if (filter == SDL_ConvertSurround) {
+            *num *= 3;
+        } else if (filter == SDL_ConvertMono) {
+            *den *= 2;
+        } else if (filter == SDL_ConvertStrip) {
+            *den *= 3;
+        } else if (filter == SDL_ConvertStrip_2) {
+            *num *= 2;
+            *den *= 3;
+        } else {
+            return SDL_FALSE;  /* someone else's filter; don't touch it. */
+        }
+    }
+
+    /* a single pass gains nothing from blocking. */
+    return (i > 1) ? SDL_TRUE : SDL_FALSE;
+}
+
+/* Run the filter chain over one block and move the result to (dst).
+   If (scratch) is NULL, the chain never grows the data and runs in place. */
+static int
+SDL_ConvertAudioBlock(SDL_AudioCVT * cvt, Uint8 * scratch,
+                      Uint8 * src, Uint8 * dst, int len)
+{
+    if (scratch != NULL) {
+        SDL_memcpy(scratch, src, len);
+        src = scratch;
+    }
+    cvt->buf = src;
+    cvt->len_cvt = len;
+    cvt->filter_index = 0;
+    cvt->filters[0] (cvt, cvt->src_format);
+    if (dst != src) {
+        SDL_memmove(dst, src, cvt->len_cvt);
+    }
+    return cvt->len_cvt;
+}
+
+static SDL_bool
+SDL_ConvertAudioBlocked(SDL_AudioCVT * cvt)
+{
+    Uint32 scratch[SDL_AUDIOCVT_BLOCKSIZE / sizeof (Uint32)];
+    Uint8 *buf = cvt->buf;
+    const int len = cvt->len;
+    const int align = SDL_AUDIOCVT_BLOCKALIGN *
+                      (SDL_AUDIO_BITSIZE(cvt->src_format) / 8);
+    int blocklen, lastlen, outlen, num, den, pos;
+
+    if (((Sint64) len * cvt->len_mult) < SDL_AUDIOCVT_BLOCKTHRESHOLD) {
+        return SDL_FALSE;
+    }
+    if (!SDL_GetBlockedCVTRatio(cvt, &num, &den)) {
+        return SDL_FALSE;
+    }
+
+    /* len_mult is the worst case any filter in the chain grows a block. */
+    blocklen = (SDL_AUDIOCVT_BLOCKSIZE / cvt->len_mult);
+    blocklen -= blocklen % align;
+    if ((blocklen == 0) || (len <= blocklen) || ((len % align) != 0)) {
+        return SDL_FALSE;
+    }
+
+    lastlen = len % blocklen;
+    if (lastlen == 0) {
+        lastlen = blocklen;
+    }
+
+    if (num <= den) {
+        /* Shrinking: walk forward, output never passes unread input. */
+        Uint8 *tmp = (cvt->len_mult > 1) ? (Uint8 *) scratch : NULL;
+        outlen = 0;
+        for (pos = 0; pos < len; pos += blocklen) {
+            const int inlen = (pos + blocklen > len) ? lastlen : blocklen;
+            outlen += SDL_ConvertAudioBlock(cvt, tmp, buf + pos,
+                                            buf + outlen, inlen);
+        }
+    } else {
+        /* Growing: walk backward from the end, placing each block exactly. */
+        const int total = (int) (((Sint64) len * num) / den);
+        outlen = total;
+        pos = len - lastlen;
+        outlen -= SDL_ConvertAudioBlock(cvt, (Uint8 *) scratch, buf + pos,
+                                        buf + ((Sint64) pos * num) / den,
+                                        lastlen);
+        while (pos > 0) {
+            pos -= blocklen;
+            outlen -= SDL_ConvertAudioBlock(cvt, (Uint8 *) scratch, buf + pos,
+                                            buf + ((Sint64) pos * num) / den,
+                                            blocklen);
+        }
+        SDL_assert(outlen == 0);
+        outlen = total;
+    }
+
+    cvt->buf = buf;
+    cvt->len_cvt = outlen;
+    return SDL_TRUE;
+}
+
+
 int
 SDL_ConvertAudio(SDL_AudioCVT * cvt)
 {
@@ -827,6 +966,11 @@ SDL_ConvertAudio(SDL_AudioCVT * cvt)
         return (0);
     }
 
+    /* Keep the whole chain in cache if we can. */
+    if (SDL_ConvertAudioBlocked(cvt)) {
+        return (0);
+    }
+
     /* Set up the conversion and go! */
     cvt->filter_index = 0;
     cvt->filters[0] (cvt, cvt->src_format);
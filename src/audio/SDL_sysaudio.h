@@ -25,6 +25,7 @@
 
 #include "SDL_mutex.h"
 #include "SDL_thread.h"
+#include "SDL_atomic.h"
 
 /* The SDL audio driver */
 typedef struct SDL_AudioDevice SDL_AudioDevice;
@@ -45,6 +46,8 @@ typedef struct SDL_AudioDriverImpl
     void (*CloseDevice) (_THIS);
     void (*LockDevice) (_THIS);
     void (*UnlockDevice) (_THIS);
+    int (*CaptureFromDevice) (_THIS, void *buffer, int buflen);  /* blocks until buflen bytes are read */
+    int (*GetDeviceLatency) (_THIS);   /* microseconds, or -1 if unknown */
     void (*Deinitialize) (void);
 
     /* !!! FIXME: add pause(), so we can optimize instead of mixing silence. */
@@ -119,12 +122,35 @@ struct SDL_AudioDevice
     SDL_Thread *thread;
     SDL_threadID threadid;
 
+    /* Timing and xrun statistics, guarded by stats_lock */
+    SDL_AudioDeviceStats stats;
+    SDL_SpinLock stats_lock;
+
+    /* Render-ahead mode: the callback runs on render_thread into a ring of
+       render_count buffers, and the device thread only copies them out.
+       Capture uses the same ring the other way around. */
+    int render_count;
+    int render_len;     /* device format for playback, the app's for capture */
+    Uint8 *render_buffers;
+    SDL_sem *render_free;
+    SDL_sem *render_ready;
+    SDL_Thread *render_thread;
+
+    /* Commands from SDL_QueueAudioCommand(), newest first */
+    void *commands;
+
     /* * * */
     /* Data private to this driver */
     struct SDL_PrivateAudioData *hidden;
 };
 #undef _THIS
 
+/* Backends call this from the audio thread when the device under/overruns */
+extern void SDL_AudioDeviceXrun(SDL_AudioDevice *device);
+
+/* Drivers that call the callback themselves call this right before it */
+extern void SDL_RunAudioCommands(SDL_AudioDevice *device);
+
 typedef struct AudioBootStrap
 {
     const char *name;
@@ -23,11 +23,28 @@
 /* Microsoft WAVE file loading routines */
 
 #include "SDL_audio.h"
+#include "SDL_cpuinfo.h"
+#include "SDL_hints.h"
+#include "SDL_atomic.h"
 #include "SDL_wave.h"
+#include "../thread/SDL_threadpool_c.h"
 
 
 static int ReadChunk(SDL_RWops * src, Chunk * chunk);
 
+/* Everything needed to decode the data chunk, parsed from the fmt chunk.
+   This lives on the stack of each load (or in each stream), so several
+   files can be decoded at once. */
+typedef struct WaveDecoder
+{
+    Uint16 encoding;
+    Uint16 channels;
+    Uint16 blockalign;
+    Uint16 wSamplesPerBlock;
+    Uint16 wNumCoef;
+    Sint16 aCoeff[7][2];
+} WaveDecoder;
+
 struct MS_ADPCM_decodestate
 {
     Uint8 hPredictor;
@@ -35,416 +52,487 @@ struct MS_ADPCM_decodestate
     Sint16 iSamp1;
     Sint16 iSamp2;
 };
-static struct MS_ADPCM_decoder
-{
-    WaveFMT wavefmt;
-    Uint16 wSamplesPerBlock;
-    Uint16 wNumCoef;
-    Sint16 aCoeff[7][2];
-    /* * * */
-    struct MS_ADPCM_decodestate state[2];
-} MS_ADPCM_state;
 
 static int
-InitMS_ADPCM(WaveFMT * format)
+InitMS_ADPCM(WaveDecoder * decoder, const Uint8 * format, Uint32 formatlen)
 {
-    Uint8 *rogue_feel;
+    const Uint8 *rogue_feel;
     int i;
 
-    /* Set the rogue pointer to the MS_ADPCM specific data */
-    MS_ADPCM_state.wavefmt.encoding = SDL_SwapLE16(format->encoding);
-    MS_ADPCM_state.wavefmt.channels = SDL_SwapLE16(format->channels);
-    MS_ADPCM_state.wavefmt.frequency = SDL_SwapLE32(format->frequency);
-    MS_ADPCM_state.wavefmt.byterate = SDL_SwapLE32(format->byterate);
-    MS_ADPCM_state.wavefmt.blockalign = SDL_SwapLE16(format->blockalign);
-    MS_ADPCM_state.wavefmt.bitspersample =
-        SDL_SwapLE16(format->bitspersample);
-    rogue_feel = (Uint8 *) format + sizeof(*format);
-    if (sizeof(*format) == 16) {
-        /* const Uint16 extra_info = ((rogue_feel[1] << 8) | rogue_feel[0]); */
-        rogue_feel += sizeof(Uint16);
+    /* Skip the standard fields and the size of the extra data */
+    if (formatlen < sizeof(WaveFMT) + 3 * sizeof(Uint16) + 7 * 2 * sizeof(Sint16)) {
+        return SDL_SetError("MS ADPCM format chunk too short");
     }
-    MS_ADPCM_state.wSamplesPerBlock = ((rogue_feel[1] << 8) | rogue_feel[0]);
+    rogue_feel = format + sizeof(WaveFMT) + sizeof(Uint16);
+    decoder->wSamplesPerBlock = ((rogue_feel[1] << 8) | rogue_feel[0]);
     rogue_feel += sizeof(Uint16);
-    MS_ADPCM_state.wNumCoef = ((rogue_feel[1] << 8) | rogue_feel[0]);
+    decoder->wNumCoef = ((rogue_feel[1] << 8) | rogue_feel[0]);
     rogue_feel += sizeof(Uint16);
-    if (MS_ADPCM_state.wNumCoef != 7) {
+    if (decoder->wNumCoef != 7) {
         SDL_SetError("Unknown set of MS_ADPCM coefficients");
         return (-1);
     }
-    for (i = 0; i < MS_ADPCM_state.wNumCoef; ++i) {
-        MS_ADPCM_state.aCoeff[i][0] = ((rogue_feel[1] << 8) | rogue_feel[0]);
+    for (i = 0; i < decoder->wNumCoef; ++i) {
+        decoder->aCoeff[i][0] = ((rogue_feel[1] << 8) | rogue_feel[0]);
         rogue_feel += sizeof(Uint16);
-        MS_ADPCM_state.aCoeff[i][1] = ((rogue_feel[1] << 8) | rogue_feel[0]);
+        decoder->aCoeff[i][1] = ((rogue_feel[1] << 8) | rogue_feel[0]);
         rogue_feel += sizeof(Uint16);
     }
+
+    /* Make sure a block really holds the samples it claims to, two per byte */
+    if ((decoder->channels < 1) || (decoder->channels > 2)) {
+        return SDL_SetError("MS ADPCM decoder can only handle %d channels", 2);
+    }
+    if ((decoder->wSamplesPerBlock < 2) ||
+        (((decoder->wSamplesPerBlock - 2) * decoder->channels) % 2) ||
+        ((7 * decoder->channels +
+          (decoder->wSamplesPerBlock - 2) * decoder->channels / 2) >
+         decoder->blockalign)) {
+        return SDL_SetError("Invalid MS ADPCM block size");
+    }
     return (0);
 }
 
-static Sint32
+static const Sint32 MS_ADPCM_adaptive[16] = {
+    230, 230, 230, 230, 307, 409, 512, 614,
+    768, 614, 512, 409, 307, 230, 230, 230
+};
+
+SDL_FORCE_INLINE Sint16
 MS_ADPCM_nibble(struct MS_ADPCM_decodestate *state,
-                Uint8 nybble, Sint16 * coeff)
+                Uint8 nybble, const Sint16 * coeff)
 {
     const Sint32 max_audioval = ((1 << (16 - 1)) - 1);
     const Sint32 min_audioval = -(1 << (16 - 1));
-    const Sint32 adaptive[] = {
-        230, 230, 230, 230, 307, 409, 512, 614,
-        768, 614, 512, 409, 307, 230, 230, 230
-    };
     Sint32 new_sample, delta;
 
+    /* The nibble is a signed 4-bit multiple of the current delta */
     new_sample = ((state->iSamp1 * coeff[0]) +
                   (state->iSamp2 * coeff[1])) / 256;
-    if (nybble & 0x08) {
-        new_sample += state->iDelta * (nybble - 0x10);
-    } else {
-        new_sample += state->iDelta * nybble;
-    }
+    new_sample += state->iDelta * (((Sint32) nybble ^ 0x08) - 0x08);
     if (new_sample < min_audioval) {
         new_sample = min_audioval;
     } else if (new_sample > max_audioval) {
         new_sample = max_audioval;
     }
-    delta = ((Sint32) state->iDelta * adaptive[nybble]) / 256;
+    delta = ((Sint32) state->iDelta * MS_ADPCM_adaptive[nybble]) >> 8;
     if (delta < 16) {
         delta = 16;
     }
     state->iDelta = (Uint16) delta;
     state->iSamp2 = state->iSamp1;
     state->iSamp1 = (Sint16) new_sample;
-    return (new_sample);
+    return (Sint16) new_sample;
 }
 
+/* Decode one block of blockalign bytes into wSamplesPerBlock sample frames */
 static int
-MS_ADPCM_decode(Uint8 ** audio_buf, Uint32 * audio_len)
+MS_ADPCM_decode_block(const WaveDecoder * decoder,
+                      const Uint8 * encoded, Uint8 * decoded)
 {
-    struct MS_ADPCM_decodestate *state[2];
-    Uint8 *freeable, *encoded, *decoded;
-    Sint32 encoded_len, samplesleft;
-    Sint8 nybble, stereo;
-    Sint16 *coeff[2];
-    Sint32 new_sample;
-
-    /* Allocate the proper sized output buffer */
-    encoded_len = *audio_len;
-    encoded = *audio_buf;
-    freeable = *audio_buf;
-    *audio_len = (encoded_len / MS_ADPCM_state.wavefmt.blockalign) *
-        MS_ADPCM_state.wSamplesPerBlock *
-        MS_ADPCM_state.wavefmt.channels * sizeof(Sint16);
-    *audio_buf = (Uint8 *) SDL_malloc(*audio_len);
-    if (*audio_buf == NULL) {
-        return SDL_OutOfMemory();
-    }
-    decoded = *audio_buf;
-
-    /* Get ready... Go! */
-    stereo = (MS_ADPCM_state.wavefmt.channels == 2);
-    state[0] = &MS_ADPCM_state.state[0];
-    state[1] = &MS_ADPCM_state.state[stereo];
-    while (encoded_len >= MS_ADPCM_state.wavefmt.blockalign) {
-        /* Grab the initial information for this block */
-        state[0]->hPredictor = *encoded++;
-        if (stereo) {
-            state[1]->hPredictor = *encoded++;
+    struct MS_ADPCM_decodestate state[2];
+    const Sint16 *coeff[2];
+    Sint16 *out = (Sint16 *) decoded;
+    const int channels = decoder->channels;
+    const int last = channels - 1;
+    Sint32 samplesleft;
+    Uint8 byte;
+    int c;
+
+    /* Grab the initial information for this block, one field at a time
+       for every channel */
+    for (c = 0; c < channels; ++c) {
+        state[c].hPredictor = *encoded++;
+        if (state[c].hPredictor >= decoder->wNumCoef) {
+            /* ADPCM_decode() reports it, as this may be another thread */
+            return (-1);
         }
-        state[0]->iDelta = ((encoded[1] << 8) | encoded[0]);
+        coeff[c] = decoder->aCoeff[state[c].hPredictor];
+    }
+    for (c = 0; c < channels; ++c) {
+        state[c].iDelta = ((encoded[1] << 8) | encoded[0]);
         encoded += sizeof(Sint16);
-        if (stereo) {
-            state[1]->iDelta = ((encoded[1] << 8) | encoded[0]);
-            encoded += sizeof(Sint16);
-        }
-        state[0]->iSamp1 = ((encoded[1] << 8) | encoded[0]);
+    }
+    for (c = 0; c < channels; ++c) {
+        state[c].iSamp1 = ((encoded[1] << 8) | encoded[0]);
         encoded += sizeof(Sint16);
-        if (stereo) {
-            state[1]->iSamp1 = ((encoded[1] << 8) | encoded[0]);
-            encoded += sizeof(Sint16);
-        }
-        state[0]->iSamp2 = ((encoded[1] << 8) | encoded[0]);
+    }
+    for (c = 0; c < channels; ++c) {
+        state[c].iSamp2 = ((encoded[1] << 8) | encoded[0]);
         encoded += sizeof(Sint16);
-        if (stereo) {
-            state[1]->iSamp2 = ((encoded[1] << 8) | encoded[0]);
-            encoded += sizeof(Sint16);
-        }
-        coeff[0] = MS_ADPCM_state.aCoeff[state[0]->hPredictor];
-        coeff[1] = MS_ADPCM_state.aCoeff[state[1]->hPredictor];
-
-        /* Store the two initial samples we start with */
-        decoded[0] = state[0]->iSamp2 & 0xFF;
-        decoded[1] = state[0]->iSamp2 >> 8;
-        decoded += 2;
-        if (stereo) {
-            decoded[0] = state[1]->iSamp2 & 0xFF;
-            decoded[1] = state[1]->iSamp2 >> 8;
-            decoded += 2;
-        }
-        decoded[0] = state[0]->iSamp1 & 0xFF;
-        decoded[1] = state[0]->iSamp1 >> 8;
-        decoded += 2;
-        if (stereo) {
-            decoded[0] = state[1]->iSamp1 & 0xFF;
-            decoded[1] = state[1]->iSamp1 >> 8;
-            decoded += 2;
-        }
+    }
 
-        /* Decode and store the other samples in this block */
-        samplesleft = (MS_ADPCM_state.wSamplesPerBlock - 2) *
-            MS_ADPCM_state.wavefmt.channels;
-        while (samplesleft > 0) {
-            nybble = (*encoded) >> 4;
-            new_sample = MS_ADPCM_nibble(state[0], nybble, coeff[0]);
-            decoded[0] = new_sample & 0xFF;
-            new_sample >>= 8;
-            decoded[1] = new_sample & 0xFF;
-            decoded += 2;
-
-            nybble = (*encoded) & 0x0F;
-            new_sample = MS_ADPCM_nibble(state[1], nybble, coeff[1]);
-            decoded[0] = new_sample & 0xFF;
-            new_sample >>= 8;
-            decoded[1] = new_sample & 0xFF;
-            decoded += 2;
-
-            ++encoded;
-            samplesleft -= 2;
-        }
-        encoded_len -= MS_ADPCM_state.wavefmt.blockalign;
+    /* Store the two initial samples we start with */
+    for (c = 0; c < channels; ++c) {
+        *out++ = SDL_SwapLE16(state[c].iSamp2);
+    }
+    for (c = 0; c < channels; ++c) {
+        *out++ = SDL_SwapLE16(state[c].iSamp1);
+    }
+
+    /* Decode and store the other samples in this block, high nibble
+       first; in stereo the two nibbles of a byte belong to each channel */
+    samplesleft = (decoder->wSamplesPerBlock - 2) * channels;
+    while (samplesleft > 0) {
+        byte = *encoded++;
+        *out++ = SDL_SwapLE16(MS_ADPCM_nibble(&state[0], byte >> 4, coeff[0]));
+        *out++ = SDL_SwapLE16(MS_ADPCM_nibble(&state[last], byte & 0x0F, coeff[last]));
+        samplesleft -= 2;
     }
-    SDL_free(freeable);
     return (0);
 }
 
 struct IMA_ADPCM_decodestate
 {
     Sint32 sample;
-    Sint8 index;
+    Uint8 index;                /* always clamped to the step table */
 };
-static struct IMA_ADPCM_decoder
-{
-    WaveFMT wavefmt;
-    Uint16 wSamplesPerBlock;
-    /* * * */
-    struct IMA_ADPCM_decodestate state[2];
-} IMA_ADPCM_state;
 
 static int
-InitIMA_ADPCM(WaveFMT * format)
+InitIMA_ADPCM(WaveDecoder * decoder, const Uint8 * format, Uint32 formatlen)
 {
-    Uint8 *rogue_feel;
-
-    /* Set the rogue pointer to the IMA_ADPCM specific data */
-    IMA_ADPCM_state.wavefmt.encoding = SDL_SwapLE16(format->encoding);
-    IMA_ADPCM_state.wavefmt.channels = SDL_SwapLE16(format->channels);
-    IMA_ADPCM_state.wavefmt.frequency = SDL_SwapLE32(format->frequency);
-    IMA_ADPCM_state.wavefmt.byterate = SDL_SwapLE32(format->byterate);
-    IMA_ADPCM_state.wavefmt.blockalign = SDL_SwapLE16(format->blockalign);
-    IMA_ADPCM_state.wavefmt.bitspersample =
-        SDL_SwapLE16(format->bitspersample);
-    rogue_feel = (Uint8 *) format + sizeof(*format);
-    if (sizeof(*format) == 16) {
-        /* const Uint16 extra_info = ((rogue_feel[1] << 8) | rogue_feel[0]); */
-        rogue_feel += sizeof(Uint16);
+    const Uint8 *rogue_feel;
+
+    /* Skip the standard fields and the size of the extra data */
+    if (formatlen < sizeof(WaveFMT) + 2 * sizeof(Uint16)) {
+        return SDL_SetError("IMA ADPCM format chunk too short");
+    }
+    rogue_feel = format + sizeof(WaveFMT) + sizeof(Uint16);
+    decoder->wSamplesPerBlock = ((rogue_feel[1] << 8) | rogue_feel[0]);
+
+    /* Make sure a block really holds the samples it claims to, eight
+       samples per channel in every four bytes after the headers. */
+    if ((decoder->channels < 1) || (decoder->channels > 2)) {
+        return SDL_SetError("IMA ADPCM decoder can only handle %d channels", 2);
+    }
+    if ((decoder->wSamplesPerBlock < 1) ||
+        ((decoder->wSamplesPerBlock - 1) % 8) ||
+        ((4 * decoder->channels +
+          (decoder->wSamplesPerBlock - 1) * decoder->channels / 2) >
+         decoder->blockalign)) {
+        return SDL_SetError("Invalid IMA ADPCM block size");
     }
-    IMA_ADPCM_state.wSamplesPerBlock = ((rogue_feel[1] << 8) | rogue_feel[0]);
     return (0);
 }
 
-static Sint32
+/* The difference each 3-bit magnitude makes at every step index, and the
+   step index that follows it.  This is the IMA step table with the usual
+   shift-and-add done ahead of time; the sign bit just negates the delta. */
+static const struct
+{
+    Uint16 delta[8];
+    Uint8 next[8];
+} IMA_ADPCM_steps[89] = {
+    { { 0, 1, 3, 4, 7, 8, 10, 11 }, { 0, 0, 0, 0, 2, 4, 6, 8 } },
+    { { 1, 3, 5, 7, 9, 11, 13, 15 }, { 0, 0, 0, 0, 3, 5, 7, 9 } },
+    { { 1, 3, 5, 7, 10, 12, 14, 16 }, { 1, 1, 1, 1, 4, 6, 8, 10 } },
+    { { 1, 3, 6, 8, 11, 13, 16, 18 }, { 2, 2, 2, 2, 5, 7, 9, 11 } },
+    { { 1, 3, 6, 8, 12, 14, 17, 19 }, { 3, 3, 3, 3, 6, 8, 10, 12 } },
+    { { 1, 4, 7, 10, 13, 16, 19, 22 }, { 4, 4, 4, 4, 7, 9, 11, 13 } },
+    { { 1, 4, 7, 10, 14, 17, 20, 23 }, { 5, 5, 5, 5, 8, 10, 12, 14 } },
+    { { 1, 4, 8, 11, 15, 18, 22, 25 }, { 6, 6, 6, 6, 9, 11, 13, 15 } },
+    { { 2, 6, 10, 14, 18, 22, 26, 30 }, { 7, 7, 7, 7, 10, 12, 14, 16 } },
+    { { 2, 6, 10, 14, 19, 23, 27, 31 }, { 8, 8, 8, 8, 11, 13, 15, 17 } },
+    { { 2, 6, 11, 15, 21, 25, 30, 34 }, { 9, 9, 9, 9, 12, 14, 16, 18 } },
+    { { 2, 7, 12, 17, 23, 28, 33, 38 }, { 10, 10, 10, 10, 13, 15, 17, 19 } },
+    { { 2, 7, 13, 18, 25, 30, 36, 41 }, { 11, 11, 11, 11, 14, 16, 18, 20 } },
+    { { 3, 9, 15, 21, 28, 34, 40, 46 }, { 12, 12, 12, 12, 15, 17, 19, 21 } },
+    { { 3, 10, 17, 24, 31, 38, 45, 52 }, { 13, 13, 13, 13, 16, 18, 20, 22 } },
+    { { 3, 10, 18, 25, 34, 41, 49, 56 }, { 14, 14, 14, 14, 17, 19, 21, 23 } },
+    { { 4, 12, 21, 29, 38, 46, 55, 63 }, { 15, 15, 15, 15, 18, 20, 22, 24 } },
+    { { 4, 13, 22, 31, 41, 50, 59, 68 }, { 16, 16, 16, 16, 19, 21, 23, 25 } },
+    { { 5, 15, 25, 35, 46, 56, 66, 76 }, { 17, 17, 17, 17, 20, 22, 24, 26 } },
+    { { 5, 16, 27, 38, 50, 61, 72, 83 }, { 18, 18, 18, 18, 21, 23, 25, 27 } },
+    { { 6, 18, 31, 43, 56, 68, 81, 93 }, { 19, 19, 19, 19, 22, 24, 26, 28 } },
+    { { 6, 19, 33, 46, 61, 74, 88, 101 }, { 20, 20, 20, 20, 23, 25, 27, 29 } },
+    { { 7, 22, 37, 52, 67, 82, 97, 112 }, { 21, 21, 21, 21, 24, 26, 28, 30 } },
+    { { 8, 24, 41, 57, 74, 90, 107, 123 }, { 22, 22, 22, 22, 25, 27, 29, 31 } },
+    { { 9, 27, 45, 63, 82, 100, 118, 136 }, { 23, 23, 23, 23, 26, 28, 30, 32 } },
+    { { 10, 30, 50, 70, 90, 110, 130, 150 }, { 24, 24, 24, 24, 27, 29, 31, 33 } },
+    { { 11, 33, 55, 77, 99, 121, 143, 165 }, { 25, 25, 25, 25, 28, 30, 32, 34 } },
+    { { 12, 36, 60, 84, 109, 133, 157, 181 }, { 26, 26, 26, 26, 29, 31, 33, 35 } },
+    { { 13, 39, 66, 92, 120, 146, 173, 199 }, { 27, 27, 27, 27, 30, 32, 34, 36 } },
+    { { 14, 43, 73, 102, 132, 161, 191, 220 }, { 28, 28, 28, 28, 31, 33, 35, 37 } },
+    { { 16, 48, 81, 113, 146, 178, 211, 243 }, { 29, 29, 29, 29, 32, 34, 36, 38 } },
+    { { 17, 52, 88, 123, 160, 195, 231, 266 }, { 30, 30, 30, 30, 33, 35, 37, 39 } },
+    { { 19, 58, 97, 136, 176, 215, 254, 293 }, { 31, 31, 31, 31, 34, 36, 38, 40 } },
+    { { 21, 64, 107, 150, 194, 237, 280, 323 }, { 32, 32, 32, 32, 35, 37, 39, 41 } },
+    { { 23, 70, 118, 165, 213, 260, 308, 355 }, { 33, 33, 33, 33, 36, 38, 40, 42 } },
+    { { 26, 78, 130, 182, 235, 287, 339, 391 }, { 34, 34, 34, 34, 37, 39, 41, 43 } },
+    { { 28, 85, 143, 200, 258, 315, 373, 430 }, { 35, 35, 35, 35, 38, 40, 42, 44 } },
+    { { 31, 94, 157, 220, 284, 347, 410, 473 }, { 36, 36, 36, 36, 39, 41, 43, 45 } },
+    { { 34, 103, 173, 242, 313, 382, 452, 521 }, { 37, 37, 37, 37, 40, 42, 44, 46 } },
+    { { 38, 114, 191, 267, 345, 421, 498, 574 }, { 38, 38, 38, 38, 41, 43, 45, 47 } },
+    { { 42, 126, 210, 294, 379, 463, 547, 631 }, { 39, 39, 39, 39, 42, 44, 46, 48 } },
+    { { 46, 138, 231, 323, 417, 509, 602, 694 }, { 40, 40, 40, 40, 43, 45, 47, 49 } },
+    { { 51, 153, 255, 357, 459, 561, 663, 765 }, { 41, 41, 41, 41, 44, 46, 48, 50 } },
+    { { 56, 168, 280, 392, 505, 617, 729, 841 }, { 42, 42, 42, 42, 45, 47, 49, 51 } },
+    { { 61, 184, 308, 431, 555, 678, 802, 925 }, { 43, 43, 43, 43, 46, 48, 50, 52 } },
+    { { 68, 204, 340, 476, 612, 748, 884, 1020 }, { 44, 44, 44, 44, 47, 49, 51, 53 } },
+    { { 74, 223, 373, 522, 672, 821, 971, 1120 }, { 45, 45, 45, 45, 48, 50, 52, 54 } },
+    { { 82, 246, 411, 575, 740, 904, 1069, 1233 }, { 46, 46, 46, 46, 49, 51, 53, 55 } },
+    { { 90, 271, 452, 633, 814, 995, 1176, 1357 }, { 47, 47, 47, 47, 50, 52, 54, 56 } },
+    { { 99, 298, 497, 696, 895, 1094, 1293, 1492 }, { 48, 48, 48, 48, 51, 53, 55, 57 } },
+    { { 109, 328, 547, 766, 985, 1204, 1423, 1642 }, { 49, 49, 49, 49, 52, 54, 56, 58 } },
+    { { 120, 360, 601, 841, 1083, 1323, 1564, 1804 }, { 50, 50, 50, 50, 53, 55, 57, 59 } },
+    { { 132, 397, 662, 927, 1192, 1457, 1722, 1987 }, { 51, 51, 51, 51, 54, 56, 58, 60 } },
+    { { 145, 436, 728, 1019, 1311, 1602, 1894, 2185 }, { 52, 52, 52, 52, 55, 57, 59, 61 } },
+    { { 160, 480, 801, 1121, 1442, 1762, 2083, 2403 }, { 53, 53, 53, 53, 56, 58, 60, 62 } },
+    { { 176, 528, 881, 1233, 1587, 1939, 2292, 2644 }, { 54, 54, 54, 54, 57, 59, 61, 63 } },
+    { { 194, 582, 970, 1358, 1746, 2134, 2522, 2910 }, { 55, 55, 55, 55, 58, 60, 62, 64 } },
+    { { 213, 639, 1066, 1492, 1920, 2346, 2773, 3199 }, { 56, 56, 56, 56, 59, 61, 63, 65 } },
+    { { 234, 703, 1173, 1642, 2112, 2581, 3051, 3520 }, { 57, 57, 57, 57, 60, 62, 64, 66 } },
+    { { 258, 774, 1291, 1807, 2324, 2840, 3357, 3873 }, { 58, 58, 58, 58, 61, 63, 65, 67 } },
+    { { 284, 852, 1420, 1988, 2556, 3124, 3692, 4260 }, { 59, 59, 59, 59, 62, 64, 66, 68 } },
+    { { 312, 936, 1561, 2185, 2811, 3435, 4060, 4684 }, { 60, 60, 60, 60, 63, 65, 67, 69 } },
+    { { 343, 1030, 1717, 2404, 3092, 3779, 4466, 5153 }, { 61, 61, 61, 61, 64, 66, 68, 70 } },
+    { { 378, 1134, 1890, 2646, 3402, 4158, 4914, 5670 }, { 62, 62, 62, 62, 65, 67, 69, 71 } },
+    { { 415, 1246, 2078, 2909, 3742, 4573, 5405, 6236 }, { 63, 63, 63, 63, 66, 68, 70, 72 } },
+    { { 457, 1372, 2287, 3202, 4117, 5032, 5947, 6862 }, { 64, 64, 64, 64, 67, 69, 71, 73 } },
+    { { 503, 1509, 2516, 3522, 4529, 5535, 6542, 7548 }, { 65, 65, 65, 65, 68, 70, 72, 74 } },
+    { { 553, 1660, 2767, 3874, 4981, 6088, 7195, 8302 }, { 66, 66, 66, 66, 69, 71, 73, 75 } },
+    { { 608, 1825, 3043, 4260, 5479, 6696, 7914, 9131 }, { 67, 67, 67, 67, 70, 72, 74, 76 } },
+    { { 669, 2008, 3348, 4687, 6027, 7366, 8706, 10045 }, { 68, 68, 68, 68, 71, 73, 75, 77 } },
+    { { 736, 2209, 3683, 5156, 6630, 8103, 9577, 11050 }, { 69, 69, 69, 69, 72, 74, 76, 78 } },
+    { { 810, 2431, 4052, 5673, 7294, 8915, 10536, 12157 }, { 70, 70, 70, 70, 73, 75, 77, 79 } },
+    { { 891, 2674, 4457, 6240, 8023, 9806, 11589, 13372 }, { 71, 71, 71, 71, 74, 76, 78, 80 } },
+    { { 980, 2941, 4902, 6863, 8825, 10786, 12747, 14708 }, { 72, 72, 72, 72, 75, 77, 79, 81 } },
+    { { 1078, 3235, 5393, 7550, 9708, 11865, 14023, 16180 }, { 73, 73, 73, 73, 76, 78, 80, 82 } },
+    { { 1186, 3559, 5932, 8305, 10679, 13052, 15425, 17798 }, { 74, 74, 74, 74, 77, 79, 81, 83 } },
+    { { 1305, 3915, 6526, 9136, 11747, 14357, 16968, 19578 }, { 75, 75, 75, 75, 78, 80, 82, 84 } },
+    { { 1435, 4306, 7178, 10049, 12922, 15793, 18665, 21536 }, { 76, 76, 76, 76, 79, 81, 83, 85 } },
+    { { 1579, 4737, 7896, 11054, 14214, 17372, 20531, 23689 }, { 77, 77, 77, 77, 80, 82, 84, 86 } },
+    { { 1737, 5211, 8686, 12160, 15636, 19110, 22585, 26059 }, { 78, 78, 78, 78, 81, 83, 85, 87 } },
+    { { 1911, 5733, 9555, 13377, 17200, 21022, 24844, 28666 }, { 79, 79, 79, 79, 82, 84, 86, 88 } },
+    { { 2102, 6306, 10511, 14715, 18920, 23124, 27329, 31533 }, { 80, 80, 80, 80, 83, 85, 87, 88 } },
+    { { 2312, 6937, 11562, 16187, 20812, 25437, 30062, 34687 }, { 81, 81, 81, 81, 84, 86, 88, 88 } },
+    { { 2543, 7630, 12718, 17805, 22893, 27980, 33068, 38155 }, { 82, 82, 82, 82, 85, 87, 88, 88 } },
+    { { 2798, 8394, 13990, 19586, 25183, 30779, 36375, 41971 }, { 83, 83, 83, 83, 86, 88, 88, 88 } },
+    { { 3077, 9232, 15388, 21543, 27700, 33855, 40011, 46166 }, { 84, 84, 84, 84, 87, 88, 88, 88 } },
+    { { 3385, 10156, 16928, 23699, 30471, 37242, 44014, 50785 }, { 85, 85, 85, 85, 88, 88, 88, 88 } },
+    { { 3724, 11172, 18621, 26069, 33518, 40966, 48415, 55863 }, { 86, 86, 86, 86, 88, 88, 88, 88 } },
+    { { 4095, 12286, 20478, 28669, 36862, 45053, 53245, 61436 }, { 87, 87, 87, 87, 88, 88, 88, 88 } }
+};
+
+SDL_FORCE_INLINE Sint16
 IMA_ADPCM_nibble(struct IMA_ADPCM_decodestate *state, Uint8 nybble)
 {
     const Sint32 max_audioval = ((1 << (16 - 1)) - 1);
     const Sint32 min_audioval = -(1 << (16 - 1));
-    const int index_table[16] = {
-        -1, -1, -1, -1,
-        2, 4, 6, 8,
-        -1, -1, -1, -1,
-        2, 4, 6, 8
-    };
-    const Sint32 step_table[89] = {
-        7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31,
-        34, 37, 41, 45, 50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130,
-        143, 157, 173, 190, 209, 230, 253, 279, 307, 337, 371, 408,
-        449, 494, 544, 598, 658, 724, 796, 876, 963, 1060, 1166, 1282,
-        1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327,
-        3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630,
-        9493, 10442, 11487, 12635, 13899, 15289, 16818, 18500, 20350,
-        22385, 24623, 27086, 29794, 32767
-    };
-    Sint32 delta, step;
-
-    /* Compute difference and new sample value */
-    if (state->index > 88) {
-        state->index = 88;
-    } else if (state->index < 0) {
-        state->index = 0;
-    }
-    step = step_table[state->index];
-    delta = step >> 3;
-    if (nybble & 0x04)
-        delta += step;
-    if (nybble & 0x02)
-        delta += (step >> 1);
-    if (nybble & 0x01)
-        delta += (step >> 2);
-    if (nybble & 0x08)
-        delta = -delta;
-    state->sample += delta;
+    const Sint32 delta = IMA_ADPCM_steps[state->index].delta[nybble & 0x07];
+
+    /* Compute the new sample value and clamp it */
+    if (nybble & 0x08) {
+        state->sample -= delta;
+        if (state->sample < min_audioval) {
+            state->sample = min_audioval;
+        }
+    } else {
+        state->sample += delta;
+        if (state->sample > max_audioval) {
+            state->sample = max_audioval;
+        }
+    }
 
     /* Update index value */
-    state->index += index_table[nybble];
+    state->index = IMA_ADPCM_steps[state->index].next[nybble & 0x07];
+    return (Sint16) state->sample;
+}
+
+/* Decode one block of blockalign bytes into wSamplesPerBlock sample frames */
+static int
+IMA_ADPCM_decode_block(const WaveDecoder * decoder,
+                       const Uint8 * encoded, Uint8 * decoded)
+{
+    struct IMA_ADPCM_decodestate state[2];
+    Sint16 *out = (Sint16 *) decoded;
+    Sint16 *dst;
+    const int channels = decoder->channels;
+    int c, i, groups;
+    Sint8 index;
+    Uint8 byte;
+
+    /* Grab the initial information for this block */
+    for (c = 0; c < channels; ++c) {
+        /* Fill the state information for this block */
+        state[c].sample = (Sint16) ((encoded[1] << 8) | encoded[0]);
+        encoded += 2;
+        index = (Sint8) *encoded++;
+        state[c].index = (Uint8) SDL_max(0, SDL_min(index, 88));
+        /* Reserved byte in buffer header, should be 0 */
+        if (*encoded++ != 0) {
+            /* Uh oh, corrupt data?  Buggy code? */ ;
+        }
 
-    /* Clamp output sample */
-    if (state->sample > max_audioval) {
-        state->sample = max_audioval;
-    } else if (state->sample < min_audioval) {
-        state->sample = min_audioval;
+        /* Store the initial sample we start with */
+        *out++ = SDL_SwapLE16((Sint16) state[c].sample);
     }
-    return (state->sample);
+
+    /* Decode and store the other samples in this block: each channel in
+       turn has four bytes holding its next eight samples, low nibble first */
+    groups = (decoder->wSamplesPerBlock - 1) / 8;
+    while (groups--) {
+        for (c = 0; c < channels; ++c) {
+            dst = out + c;
+            for (i = 0; i < 4; ++i) {
+                byte = *encoded++;
+                *dst = SDL_SwapLE16(IMA_ADPCM_nibble(&state[c], byte & 0x0F));
+                dst += channels;
+                *dst = SDL_SwapLE16(IMA_ADPCM_nibble(&state[c], byte >> 4));
+                dst += channels;
+            }
+        }
+        out += channels * 8;
+    }
+    return (0);
 }
 
-/* Fill the decode buffer with a channel block of data (8 samples) */
+static int
+ADPCM_decode_block(const WaveDecoder * decoder,
+                   const Uint8 * encoded, Uint8 * decoded)
+{
+    if (decoder->encoding == MS_ADPCM_CODE) {
+        return MS_ADPCM_decode_block(decoder, encoded, decoded);
+    }
+    return IMA_ADPCM_decode_block(decoder, encoded, decoded);
+}
+
+/* The blocks of an ADPCM_decode() call, split into bands for the thread pool */
+typedef struct ADPCM_DecodeJob
+{
+    const WaveDecoder *decoder;
+    const Uint8 *encoded;
+    Uint8 *decoded;
+    Uint32 blocks;
+    int bands;
+    SDL_atomic_t failed;
+} ADPCM_DecodeJob;
+
 static void
-Fill_IMA_ADPCM_block(Uint8 * decoded, Uint8 * encoded,
-                     int channel, int numchannels,
-                     struct IMA_ADPCM_decodestate *state)
+ADPCM_decode_band(void *data, int band)
 {
-    int i;
-    Sint8 nybble;
-    Sint32 new_sample;
-
-    decoded += (channel * 2);
-    for (i = 0; i < 4; ++i) {
-        nybble = (*encoded) & 0x0F;
-        new_sample = IMA_ADPCM_nibble(state, nybble);
-        decoded[0] = new_sample & 0xFF;
-        new_sample >>= 8;
-        decoded[1] = new_sample & 0xFF;
-        decoded += 2 * numchannels;
-
-        nybble = (*encoded) >> 4;
-        new_sample = IMA_ADPCM_nibble(state, nybble);
-        decoded[0] = new_sample & 0xFF;
-        new_sample >>= 8;
-        decoded[1] = new_sample & 0xFF;
-        decoded += 2 * numchannels;
-
-        ++encoded;
+    ADPCM_DecodeJob *job = (ADPCM_DecodeJob *) data;
+    const WaveDecoder *decoder = job->decoder;
+    const Uint32 blocklen =
+        decoder->wSamplesPerBlock * decoder->channels * sizeof(Sint16);
+    const Uint32 share = job->blocks / job->bands;
+    const Uint32 extra = job->blocks % job->bands;
+    Uint32 first, blocks;
+    const Uint8 *encoded;
+    Uint8 *decoded;
+
+    /* The first (blocks % bands) bands get a block more than the rest */
+    first = band * share + SDL_min((Uint32) band, extra);
+    blocks = share + ((Uint32) band < extra);
+    encoded = job->encoded + first * decoder->blockalign;
+    decoded = job->decoded + first * blocklen;
+    while (blocks--) {
+        if (ADPCM_decode_block(decoder, encoded, decoded) < 0) {
+            SDL_AtomicSet(&job->failed, 1);
+            break;
+        }
+        encoded += decoder->blockalign;
+        decoded += blocklen;
     }
 }
 
+/* Threads aren't worth using for less than this many blocks each */
+#define ADPCM_BLOCKS_PER_THREAD 256
+
 static int
-IMA_ADPCM_decode(Uint8 ** audio_buf, Uint32 * audio_len)
+ADPCM_decode_threads(Uint32 blocks)
 {
-    struct IMA_ADPCM_decodestate *state;
-    Uint8 *freeable, *encoded, *decoded;
-    Sint32 encoded_len, samplesleft;
-    unsigned int c, channels;
-
-    /* Check to make sure we have enough variables in the state array */
-    channels = IMA_ADPCM_state.wavefmt.channels;
-    if (channels > SDL_arraysize(IMA_ADPCM_state.state)) {
-        SDL_SetError("IMA ADPCM decoder can only handle %d channels",
-                     SDL_arraysize(IMA_ADPCM_state.state));
-        return (-1);
+    const char *hint = SDL_GetHint(SDL_HINT_AUDIO_DECODE_THREADS);
+    int threads = hint ? SDL_atoi(hint) : 1;
+
+    if (threads <= 0) {
+        threads = SDL_GetCPUCount();
     }
-    state = IMA_ADPCM_state.state;
+    threads = SDL_min(threads, (int) (blocks / ADPCM_BLOCKS_PER_THREAD));
+    threads = SDL_min(threads, SDL_THREADPOOL_MAX_THREADS);
+    return SDL_max(threads, 1);
+}
 
-    /* Allocate the proper sized output buffer */
-    encoded_len = *audio_len;
-    encoded = *audio_buf;
+/* Replace the encoded data chunk with the decoded samples of every
+   complete block in it. */
+static int
+ADPCM_decode(const WaveDecoder * decoder, Uint8 ** audio_buf,
+             Uint32 * audio_len)
+{
+    ADPCM_DecodeJob job;
+    Uint8 *freeable;
+    Uint32 blocks, blocklen;
+
+    blocks = *audio_len / decoder->blockalign;
+    blocklen = decoder->wSamplesPerBlock * decoder->channels * sizeof(Sint16);
     freeable = *audio_buf;
-    *audio_len = (encoded_len / IMA_ADPCM_state.wavefmt.blockalign) *
-        IMA_ADPCM_state.wSamplesPerBlock *
-        IMA_ADPCM_state.wavefmt.channels * sizeof(Sint16);
+
+    /* Allocate the proper sized output buffer */
+    *audio_len = blocks * blocklen;
     *audio_buf = (Uint8 *) SDL_malloc(*audio_len);
     if (*audio_buf == NULL) {
+        *audio_buf = freeable;
         return SDL_OutOfMemory();
     }
-    decoded = *audio_buf;
 
-    /* Get ready... Go! */
-    while (encoded_len >= IMA_ADPCM_state.wavefmt.blockalign) {
-        /* Grab the initial information for this block */
-        for (c = 0; c < channels; ++c) {
-            /* Fill the state information for this block */
-            state[c].sample = ((encoded[1] << 8) | encoded[0]);
-            encoded += 2;
-            if (state[c].sample & 0x8000) {
-                state[c].sample -= 0x10000;
-            }
-            state[c].index = *encoded++;
-            /* Reserved byte in buffer header, should be 0 */
-            if (*encoded++ != 0) {
-                /* Uh oh, corrupt data?  Buggy code? */ ;
-            }
-
-            /* Store the initial sample we start with */
-            decoded[0] = (Uint8) (state[c].sample & 0xFF);
-            decoded[1] = (Uint8) (state[c].sample >> 8);
-            decoded += 2;
-        }
+    job.decoder = decoder;
+    job.encoded = freeable;
+    job.decoded = *audio_buf;
+    job.blocks = blocks;
+    job.bands = ADPCM_decode_threads(blocks);
+    SDL_AtomicSet(&job.failed, 0);
+    if (job.bands > 1) {
+        SDL_RunParallel(ADPCM_decode_band, &job, job.bands, job.bands);
+    } else {
+        ADPCM_decode_band(&job, 0);
+    }
 
-        /* Decode and store the other samples in this block */
-        samplesleft = (IMA_ADPCM_state.wSamplesPerBlock - 1) * channels;
-        while (samplesleft > 0) {
-            for (c = 0; c < channels; ++c) {
-                Fill_IMA_ADPCM_block(decoded, encoded,
-                                     c, channels, &state[c]);
-                encoded += 4;
-                samplesleft -= 8;
-            }
-            decoded += (channels * 8 * 2);
+    SDL_free(freeable);
+    if (SDL_AtomicGet(&job.failed)) {
+        /* Maybe found on another thread, whose error string we can't see */
+        if (decoder->encoding == MS_ADPCM_CODE) {
+            return SDL_SetError("Invalid MS ADPCM predictor");
         }
-        encoded_len -= IMA_ADPCM_state.wavefmt.blockalign;
+        return SDL_SetError("Invalid IMA ADPCM block");
     }
-    SDL_free(freeable);
     return (0);
 }
 
-SDL_AudioSpec *
-SDL_LoadWAV_RW(SDL_RWops * src, int freesrc,
-               SDL_AudioSpec * spec, Uint8 ** audio_buf, Uint32 * audio_len)
+/* Check the RIFF header and parse the fmt chunk, leaving src at the chunk
+   that follows it.  Fills in the decoder and spec on success. */
+static int
+ReadWaveFormat(SDL_RWops * src, WaveDecoder * decoder, SDL_AudioSpec * spec,
+               Uint32 * wavelen, Uint32 * headerDiff)
 {
     int was_error;
     Chunk chunk;
     int lenread;
-    int IEEE_float_encoded, MS_ADPCM_encoded, IMA_ADPCM_encoded;
-    int samplesize;
+    int IEEE_float_encoded, ADPCM_encoded;
 
     /* WAV magic header */
     Uint32 RIFFchunk;
-    Uint32 wavelen = 0;
     Uint32 WAVEmagic;
-    Uint32 headerDiff = 0;
 
     /* FMT chunk */
     WaveFMT *format = NULL;
 
     SDL_zero(chunk);
-
-    /* Make sure we are passed a valid data source */
-    was_error = 0;
-    if (src == NULL) {
-        was_error = 1;
-        goto done;
-    }
+    SDL_zerop(decoder);
 
     /* Check the magic header */
     RIFFchunk = SDL_ReadLE32(src);
-    wavelen = SDL_ReadLE32(src);
-    if (wavelen == WAVE) {      /* The RIFFchunk has already been read */
-        WAVEmagic = wavelen;
-        wavelen = RIFFchunk;
+    *wavelen = SDL_ReadLE32(src);
+    if (*wavelen == WAVE) {     /* The RIFFchunk has already been read */
+        WAVEmagic = *wavelen;
+        *wavelen = RIFFchunk;
         RIFFchunk = RIFF;
     } else {
         WAVEmagic = SDL_ReadLE32(src);
     }
     if ((RIFFchunk != RIFF) || (WAVEmagic != WAVE)) {
-        SDL_SetError("Unrecognized file type (not WAVE)");
-        was_error = 1;
-        goto done;
+        return SDL_SetError("Unrecognized file type (not WAVE)");
     }
-    headerDiff += sizeof(Uint32);       /* for WAVE */
+    *headerDiff += sizeof(Uint32);      /* for WAVE */
 
     /* Read the audio data format chunk */
     chunk.data = NULL;
@@ -453,22 +541,35 @@ SDL_LoadWAV_RW(SDL_RWops * src, int freesrc,
         chunk.data = NULL;
         lenread = ReadChunk(src, &chunk);
         if (lenread < 0) {
-            was_error = 1;
-            goto done;
+            return (-1);
         }
         /* 2 Uint32's for chunk header+len, plus the lenread */
-        headerDiff += lenread + 2 * sizeof(Uint32);
+        *headerDiff += lenread + 2 * sizeof(Uint32);
     } while ((chunk.magic == FACT) || (chunk.magic == LIST));
 
     /* Decode the audio data format */
+    was_error = 0;
     format = (WaveFMT *) chunk.data;
     if (chunk.magic != FMT) {
         SDL_SetError("Complex WAVE files not supported");
         was_error = 1;
         goto done;
     }
-    IEEE_float_encoded = MS_ADPCM_encoded = IMA_ADPCM_encoded = 0;
-    switch (SDL_SwapLE16(format->encoding)) {
+    if (chunk.length < sizeof(*format)) {
+        SDL_SetError("WAVE format chunk too short");
+        was_error = 1;
+        goto done;
+    }
+    decoder->encoding = SDL_SwapLE16(format->encoding);
+    decoder->channels = SDL_SwapLE16(format->channels);
+    decoder->blockalign = SDL_SwapLE16(format->blockalign);
+    if (decoder->channels == 0) {
+        SDL_SetError("WAVE file has no channels");
+        was_error = 1;
+        goto done;
+    }
+    IEEE_float_encoded = ADPCM_encoded = 0;
+    switch (decoder->encoding) {
     case PCM_CODE:
         /* We can understand this */
         break;
@@ -478,19 +579,19 @@ SDL_LoadWAV_RW(SDL_RWops * src, int freesrc,
         break;
     case MS_ADPCM_CODE:
         /* Try to understand this */
-        if (InitMS_ADPCM(format) < 0) {
+        if (InitMS_ADPCM(decoder, chunk.data, chunk.length) < 0) {
             was_error = 1;
             goto done;
         }
-        MS_ADPCM_encoded = 1;
+        ADPCM_encoded = 1;
         break;
     case IMA_ADPCM_CODE:
         /* Try to understand this */
-        if (InitIMA_ADPCM(format) < 0) {
+        if (InitIMA_ADPCM(decoder, chunk.data, chunk.length) < 0) {
             was_error = 1;
             goto done;
         }
-        IMA_ADPCM_encoded = 1;
+        ADPCM_encoded = 1;
         break;
     case MP3_CODE:
         SDL_SetError("MPEG Layer 3 data not supported",
@@ -515,7 +616,7 @@ SDL_LoadWAV_RW(SDL_RWops * src, int freesrc,
     } else {
         switch (SDL_SwapLE16(format->bitspersample)) {
         case 4:
-            if (MS_ADPCM_encoded || IMA_ADPCM_encoded) {
+            if (ADPCM_encoded) {
                 spec->format = AUDIO_S16;
             } else {
                 was_error = 1;
@@ -541,9 +642,40 @@ SDL_LoadWAV_RW(SDL_RWops * src, int freesrc,
                      SDL_SwapLE16(format->bitspersample));
         goto done;
     }
-    spec->channels = (Uint8) SDL_SwapLE16(format->channels);
+    spec->channels = (Uint8) decoder->channels;
     spec->samples = 4096;       /* Good default buffer size */
 
+  done:
+    SDL_free(format);
+    return was_error ? -1 : 0;
+}
+
+SDL_AudioSpec *
+SDL_LoadWAV_RW(SDL_RWops * src, int freesrc,
+               SDL_AudioSpec * spec, Uint8 ** audio_buf, Uint32 * audio_len)
+{
+    int was_error;
+    Chunk chunk;
+    int lenread;
+    int samplesize;
+    WaveDecoder decoder;
+    Uint32 wavelen = 0;
+    Uint32 headerDiff = 0;
+
+    SDL_zero(chunk);
+
+    /* Make sure we are passed a valid data source */
+    was_error = 0;
+    if (src == NULL) {
+        was_error = 1;
+        goto done;
+    }
+
+    if (ReadWaveFormat(src, &decoder, spec, &wavelen, &headerDiff) < 0) {
+        was_error = 1;
+        goto done;
+    }
+
     /* Read the audio data chunk */
     *audio_buf = NULL;
     do {
@@ -561,14 +693,11 @@ SDL_LoadWAV_RW(SDL_RWops * src, int freesrc,
     } while (chunk.magic != DATA);
     headerDiff += 2 * sizeof(Uint32);   /* for the data chunk and len */
 
-    if (MS_ADPCM_encoded) {
-        if (MS_ADPCM_decode(audio_buf, audio_len) < 0) {
-            was_error = 1;
-            goto done;
-        }
-    }
-    if (IMA_ADPCM_encoded) {
-        if (IMA_ADPCM_decode(audio_buf, audio_len) < 0) {
+    if ((decoder.encoding == MS_ADPCM_CODE) ||
+        (decoder.encoding == IMA_ADPCM_CODE)) {
+        if (ADPCM_decode(&decoder, audio_buf, audio_len) < 0) {
+            SDL_free(*audio_buf);
+            *audio_buf = NULL;
             was_error = 1;
             goto done;
         }
@@ -579,7 +708,6 @@ SDL_LoadWAV_RW(SDL_RWops * src, int freesrc,
     *audio_len &= ~(samplesize - 1);
 
   done:
-    SDL_free(format);
     if (src) {
         if (freesrc) {
             SDL_RWclose(src);
@@ -603,6 +731,234 @@ SDL_FreeWAV(Uint8 * audio_buf)
     SDL_free(audio_buf);
 }
 
+/* An open WAVE file that is decoded a block at a time as it is read */
+struct SDL_WAVStream
+{
+    SDL_RWops *src;
+    int freesrc;
+    WaveDecoder decoder;
+    Sint64 datastart;       /* offset of the data chunk payload in src */
+    Uint32 framesize;       /* bytes in a decoded sample frame */
+    Uint32 frames;          /* sample frames in the stream */
+    Uint32 position;        /* next sample frame to be read */
+
+    /* ADPCM streams decode whole blocks into a cache; PCM streams are read
+       straight into the caller's buffer and treat every frame as a block. */
+    Uint32 blockframes;
+    Uint32 nextblock;       /* the block src is positioned at, if known */
+    Uint32 cachedblock;     /* the block held in decoded, if any */
+    Uint8 *encoded;
+    Uint8 *decoded;
+};
+
+#define WAVE_NO_BLOCK ((Uint32) -1)
+
+SDL_WAVStream *
+SDL_OpenWAVStream_RW(SDL_RWops * src, int freesrc, SDL_AudioSpec * spec)
+{
+    SDL_WAVStream *stream = NULL;
+    WaveDecoder decoder;
+    Uint32 wavelen = 0;
+    Uint32 headerDiff = 0;
+    Uint32 header[2];
+    Uint32 datalen;
+
+    if (src == NULL) {
+        SDL_InvalidParamError("src");
+        return NULL;
+    }
+    if (spec == NULL) {
+        SDL_InvalidParamError("spec");
+        goto error;
+    }
+
+    if (ReadWaveFormat(src, &decoder, spec, &wavelen, &headerDiff) < 0) {
+        goto error;
+    }
+
+    /* Find the audio data chunk, skipping over anything else */
+    for (;;) {
+        if (SDL_RWread(src, header, sizeof(header), 1) != 1) {
+            SDL_Error(SDL_EFREAD);
+            goto error;
+        }
+        datalen = SDL_SwapLE32(header[1]);
+        if (SDL_SwapLE32(header[0]) == DATA) {
+            break;
+        }
+        if (SDL_RWseek(src, datalen, RW_SEEK_CUR) < 0) {
+            goto error;
+        }
+    }
+
+    stream = (SDL_WAVStream *) SDL_calloc(1, sizeof(*stream));
+    if (stream == NULL) {
+        SDL_OutOfMemory();
+        goto error;
+    }
+    stream->src = src;
+    stream->freesrc = freesrc;
+    stream->decoder = decoder;
+    stream->datastart = SDL_RWtell(src);
+    if (stream->datastart < 0) {
+        goto error;
+    }
+    stream->framesize = (SDL_AUDIO_BITSIZE(spec->format) / 8) * spec->channels;
+    stream->nextblock = 0;
+    stream->cachedblock = WAVE_NO_BLOCK;
+
+    if ((decoder.encoding == MS_ADPCM_CODE) ||
+        (decoder.encoding == IMA_ADPCM_CODE)) {
+        stream->blockframes = decoder.wSamplesPerBlock;
+        stream->frames = (datalen / decoder.blockalign) * stream->blockframes;
+        stream->encoded = (Uint8 *) SDL_malloc(decoder.blockalign);
+        stream->decoded = (Uint8 *) SDL_malloc(stream->blockframes * stream->framesize);
+        if ((stream->encoded == NULL) || (stream->decoded == NULL)) {
+            SDL_OutOfMemory();
+            goto error;
+        }
+    } else {
+        stream->blockframes = 1;
+        stream->frames = datalen / stream->framesize;
+    }
+    return stream;
+
+  error:
+    if (stream) {
+        SDL_free(stream->encoded);
+        SDL_free(stream->decoded);
+        SDL_free(stream);
+    }
+    if (freesrc) {
+        SDL_RWclose(src);
+    }
+    return NULL;
+}
+
+Uint32
+SDL_GetWAVStreamLength(SDL_WAVStream * stream)
+{
+    if (stream == NULL) {
+        SDL_InvalidParamError("stream");
+        return 0;
+    }
+    return stream->frames;
+}
+
+/* Position src at the start of a block, unless it is already there */
+static int
+SeekWAVStreamBlock(SDL_WAVStream * stream, Uint32 block)
+{
+    const Uint32 blocksize = (stream->blockframes == 1) ?
+        stream->framesize : stream->decoder.blockalign;
+
+    if (block != stream->nextblock) {
+        stream->nextblock = WAVE_NO_BLOCK;
+        if (SDL_RWseek(stream->src,
+                       stream->datastart + (Sint64) block * blocksize,
+                       RW_SEEK_SET) < 0) {
+            return (-1);
+        }
+        stream->nextblock = block;
+    }
+    return (0);
+}
+
+int
+SDL_ReadWAVStream(SDL_WAVStream * stream, void *buf, int len)
+{
+    Uint8 *dst = (Uint8 *) buf;
+    Uint32 wanted, count, block, offset;
+    int total = 0;
+
+    if (stream == NULL) {
+        return SDL_InvalidParamError("stream");
+    }
+    if ((buf == NULL) || (len < 0)) {
+        return SDL_InvalidParamError("buf");
+    }
+    wanted = SDL_min((Uint32) len / stream->framesize,
+                     stream->frames - stream->position);
+
+    if (stream->blockframes == 1) {
+        if (wanted == 0) {
+            return 0;
+        }
+        if (SeekWAVStreamBlock(stream, stream->position) < 0) {
+            return (-1);
+        }
+        count = (Uint32) SDL_RWread(stream->src, dst, stream->framesize, wanted);
+        stream->position += count;
+        stream->nextblock = stream->position;
+        if (count < wanted) {
+            /* The data chunk is shorter than the header said */
+            stream->frames = stream->position;
+        }
+        return (int) (count * stream->framesize);
+    }
+
+    while (wanted > 0) {
+        block = stream->position / stream->blockframes;
+        offset = stream->position % stream->blockframes;
+        if (block != stream->cachedblock) {
+            stream->cachedblock = WAVE_NO_BLOCK;
+            if (SeekWAVStreamBlock(stream, block) < 0) {
+                return (-1);
+            }
+            if (SDL_RWread(stream->src, stream->encoded,
+                           stream->decoder.blockalign, 1) != 1) {
+                /* The data chunk is shorter than the header said */
+                stream->nextblock = WAVE_NO_BLOCK;
+                stream->frames = block * stream->blockframes;
+                break;
+            }
+            stream->nextblock = block + 1;
+            if (ADPCM_decode_block(&stream->decoder, stream->encoded,
+                                   stream->decoded) < 0) {
+                return (-1);
+            }
+            stream->cachedblock = block;
+        }
+
+        count = SDL_min(stream->blockframes - offset, wanted);
+        SDL_memcpy(dst, stream->decoded + offset * stream->framesize,
+                   count * stream->framesize);
+        dst += count * stream->framesize;
+        total += (int) (count * stream->framesize);
+        stream->position += count;
+        wanted -= count;
+    }
+    return total;
+}
+
+int
+SDL_SeekWAVStream(SDL_WAVStream * stream, Uint32 frame)
+{
+    if (stream == NULL) {
+        return SDL_InvalidParamError("stream");
+    }
+    if (frame > stream->frames) {
+        return SDL_SetError("Seek past the end of the WAVE data");
+    }
+    /* The data is read from the new position lazily */
+    stream->position = frame;
+    return (0);
+}
+
+void
+SDL_CloseWAVStream(SDL_WAVStream * stream)
+{
+    if (stream == NULL) {
+        return;
+    }
+    if (stream->freesrc) {
+        SDL_RWclose(stream->src);
+    }
+    SDL_free(stream->encoded);
+    SDL_free(stream->decoded);
+    SDL_free(stream);
+}
+
 static int
 ReadChunk(SDL_RWops * src, Chunk * chunk)
 {
@@ -28,6 +28,7 @@
 #include <signal.h>             /* For kill() */
 #include <errno.h>
 #include <string.h>
+#include <poll.h>
 
 #include "SDL_timer.h"
 #include "SDL_audio.h"
@@ -44,9 +45,14 @@ static int (*ALSA_snd_pcm_open)
 static int (*ALSA_snd_pcm_close) (snd_pcm_t * pcm);
 static snd_pcm_sframes_t(*ALSA_snd_pcm_writei)
   (snd_pcm_t *, const void *, snd_pcm_uframes_t);
+static snd_pcm_sframes_t(*ALSA_snd_pcm_readi)
+  (snd_pcm_t *, void *, snd_pcm_uframes_t);
 static int (*ALSA_snd_pcm_recover) (snd_pcm_t *, int, int);
 static int (*ALSA_snd_pcm_prepare) (snd_pcm_t *);
 static int (*ALSA_snd_pcm_drain) (snd_pcm_t *);
+static int (*ALSA_snd_pcm_start) (snd_pcm_t *);
+static int (*ALSA_snd_pcm_resume) (snd_pcm_t *);
+static snd_pcm_state_t (*ALSA_snd_pcm_state) (snd_pcm_t *);
 static const char *(*ALSA_snd_strerror) (int);
 static size_t(*ALSA_snd_pcm_hw_params_sizeof) (void);
 static size_t(*ALSA_snd_pcm_sw_params_sizeof) (void);
@@ -85,6 +91,17 @@ static int (*ALSA_snd_pcm_nonblock) (snd_pcm_t *, int);
 static int (*ALSA_snd_pcm_wait)(snd_pcm_t *, int);
 static int (*ALSA_snd_pcm_sw_params_set_avail_min)
   (snd_pcm_t *, snd_pcm_sw_params_t *, snd_pcm_uframes_t);
+static snd_pcm_sframes_t (*ALSA_snd_pcm_avail_update) (snd_pcm_t *);
+static int (*ALSA_snd_pcm_mmap_begin)
+  (snd_pcm_t *, const snd_pcm_channel_area_t **, snd_pcm_uframes_t *,
+   snd_pcm_uframes_t *);
+static snd_pcm_sframes_t (*ALSA_snd_pcm_mmap_commit)
+  (snd_pcm_t *, snd_pcm_uframes_t, snd_pcm_uframes_t);
+static int (*ALSA_snd_pcm_poll_descriptors_count) (snd_pcm_t *);
+static int (*ALSA_snd_pcm_poll_descriptors)
+  (snd_pcm_t *, struct pollfd *, unsigned int);
+static int (*ALSA_snd_pcm_poll_descriptors_revents)
+  (snd_pcm_t *, struct pollfd *, unsigned int, unsigned short *);
 
 #ifdef SDL_AUDIO_DRIVER_ALSA_DYNAMIC
 #define snd_pcm_hw_params_sizeof ALSA_snd_pcm_hw_params_sizeof
@@ -118,9 +135,13 @@ load_alsa_syms(void)
     SDL_ALSA_SYM(snd_pcm_open);
     SDL_ALSA_SYM(snd_pcm_close);
     SDL_ALSA_SYM(snd_pcm_writei);
+    SDL_ALSA_SYM(snd_pcm_readi);
     SDL_ALSA_SYM(snd_pcm_recover);
     SDL_ALSA_SYM(snd_pcm_prepare);
     SDL_ALSA_SYM(snd_pcm_drain);
+    SDL_ALSA_SYM(snd_pcm_start);
+    SDL_ALSA_SYM(snd_pcm_resume);
+    SDL_ALSA_SYM(snd_pcm_state);
     SDL_ALSA_SYM(snd_strerror);
     SDL_ALSA_SYM(snd_pcm_hw_params_sizeof);
     SDL_ALSA_SYM(snd_pcm_sw_params_sizeof);
@@ -144,6 +165,12 @@ load_alsa_syms(void)
     SDL_ALSA_SYM(snd_pcm_nonblock);
     SDL_ALSA_SYM(snd_pcm_wait);
     SDL_ALSA_SYM(snd_pcm_sw_params_set_avail_min);
+    SDL_ALSA_SYM(snd_pcm_avail_update);
+    SDL_ALSA_SYM(snd_pcm_mmap_begin);
+    SDL_ALSA_SYM(snd_pcm_mmap_commit);
+    SDL_ALSA_SYM(snd_pcm_poll_descriptors_count);
+    SDL_ALSA_SYM(snd_pcm_poll_descriptors);
+    SDL_ALSA_SYM(snd_pcm_poll_descriptors_revents);
     return 0;
 }
 
@@ -196,12 +223,14 @@ LoadALSALibrary(void)
 #endif /* SDL_AUDIO_DRIVER_ALSA_DYNAMIC */
 
 static const char *
-get_audio_device(int channels)
+get_audio_device(int channels, int iscapture)
 {
     const char *device;
 
     device = SDL_getenv("AUDIODEV");    /* Is there a standard variable name? */
-    if (device == NULL) {
+    if (device == NULL && iscapture) {
+        device = "default";
+    } else if (device == NULL) {
         switch (channels) {
         case 6:
             device = "plug:surround51";
@@ -218,11 +247,97 @@ get_audio_device(int channels)
 }
 
 
+static SDL_INLINE int
+ALSA_frame_size(_THIS)
+{
+    return (((int) (this->spec.format & 0xFF)) / 8) * this->spec.channels;
+}
+
+/* Recover from an xrun or suspend; returns 0 if the stream is usable again */
+static int
+ALSA_recover(_THIS, int err)
+{
+    if (err == -EAGAIN) {
+        return 0;
+    }
+    if (err == -EPIPE) {
+        SDL_AudioDeviceXrun(this);
+    } else if (err == -ESTRPIPE) {
+        /* The system was suspended; that's not an xrun, so just pick up
+           where we left off, or re-prepare if the driver can't resume. */
+        while ((err = ALSA_snd_pcm_resume(this->hidden->pcm_handle)) == -EAGAIN &&
+               this->enabled) {
+            SDL_Delay(1);
+        }
+        if (err == 0) {
+            return 0;
+        }
+        err = ALSA_snd_pcm_prepare(this->hidden->pcm_handle);
+    }
+    if (err < 0) {
+        err = ALSA_snd_pcm_recover(this->hidden->pcm_handle, err, 0);
+    }
+    if (err < 0) {
+        /* Hmm, not much we can do - abort */
+        fprintf(stderr, "ALSA %s failed (unrecoverable): %s\n",
+                this->iscapture ? "read" : "write",
+                ALSA_snd_strerror(err));
+        this->enabled = 0;
+        return -1;
+    }
+    return 0;
+}
+
+/* Sleep on the PCM descriptors until the device wants more data */
+static void
+ALSA_poll(_THIS)
+{
+    struct SDL_PrivateAudioData *h = this->hidden;
+    const int timeout = (int) ((this->spec.samples * 2000) / this->spec.freq) + 10;
+    unsigned short revents = 0;
+    int status;
+
+    status = poll(h->pfds, h->nfds, timeout);
+    if (status < 0) {
+        if (errno != EINTR) {
+            SDL_Delay(1);
+        }
+        return;
+    } else if (status == 0) {
+        return;  /* timed out, let the caller look at avail again */
+    }
+
+    status = ALSA_snd_pcm_poll_descriptors_revents(h->pcm_handle, h->pfds,
+                                                   h->nfds, &revents);
+    if ((status < 0) || (revents & (POLLERR | POLLNVAL))) {
+        /* avail_update will report the xrun, which the caller recovers */
+        ALSA_snd_pcm_avail_update(h->pcm_handle);
+    }
+}
+
 /* This function waits until it is possible to write a full sound buffer */
 static void
 ALSA_WaitDevice(_THIS)
 {
-    /* We're in blocking mode, so there's nothing to do here */
+    snd_pcm_sframes_t avail;
+
+    if (!this->hidden->use_mmap) {
+        /* We're in blocking mode, so there's nothing to do here */
+        return;
+    }
+
+    while (this->enabled) {
+        avail = ALSA_snd_pcm_avail_update(this->hidden->pcm_handle);
+        if (avail < 0) {
+            if (ALSA_recover(this, (int) avail) < 0) {
+                return;
+            }
+            continue;
+        } else if (avail >= (snd_pcm_sframes_t) this->spec.samples) {
+            return;
+        }
+        ALSA_poll(this);
+    }
 }
 
 
@@ -233,7 +348,7 @@ ALSA_WaitDevice(_THIS)
  *  and for Windows DirectX [and CoreAudio], this is FL-FR-C-LFE-RL-RR"
  */
 #define SWIZ6(T) \
-    T *ptr = (T *) this->hidden->mixbuf; \
+    T *ptr = (T *) buf; \
     Uint32 i; \
     for (i = 0; i < this->spec.samples; i++, ptr += 6) { \
         T tmp; \
@@ -242,25 +357,25 @@ ALSA_WaitDevice(_THIS)
     }
 
 static SDL_INLINE void
-swizzle_alsa_channels_6_64bit(_THIS)
+swizzle_alsa_channels_6_64bit(_THIS, void *buf)
 {
     SWIZ6(Uint64);
 }
 
 static SDL_INLINE void
-swizzle_alsa_channels_6_32bit(_THIS)
+swizzle_alsa_channels_6_32bit(_THIS, void *buf)
 {
     SWIZ6(Uint32);
 }
 
 static SDL_INLINE void
-swizzle_alsa_channels_6_16bit(_THIS)
+swizzle_alsa_channels_6_16bit(_THIS, void *buf)
 {
     SWIZ6(Uint16);
 }
 
 static SDL_INLINE void
-swizzle_alsa_channels_6_8bit(_THIS)
+swizzle_alsa_channels_6_8bit(_THIS, void *buf)
 {
     SWIZ6(Uint8);
 }
@@ -269,38 +384,168 @@ swizzle_alsa_channels_6_8bit(_THIS)
 
 
 /*
- * Called right before feeding this->hidden->mixbuf to the hardware. Swizzle
+ * Called right before feeding a buffer to the hardware. Swizzle
  *  channels from Windows/Mac order to the format alsalib will want.
  */
 static SDL_INLINE void
-swizzle_alsa_channels(_THIS)
+swizzle_alsa_channels(_THIS, void *buf)
 {
     if (this->spec.channels == 6) {
         const Uint16 fmtsize = (this->spec.format & 0xFF);      /* bits/channel. */
         if (fmtsize == 16)
-            swizzle_alsa_channels_6_16bit(this);
+            swizzle_alsa_channels_6_16bit(this, buf);
         else if (fmtsize == 8)
-            swizzle_alsa_channels_6_8bit(this);
+            swizzle_alsa_channels_6_8bit(this, buf);
         else if (fmtsize == 32)
-            swizzle_alsa_channels_6_32bit(this);
+            swizzle_alsa_channels_6_32bit(this, buf);
         else if (fmtsize == 64)
-            swizzle_alsa_channels_6_64bit(this);
+            swizzle_alsa_channels_6_64bit(this, buf);
     }
 
     /* !!! FIXME: update this for 7.1 if needed, later. */
 }
 
 
+static Uint8 *
+ALSA_GetDeviceBuf(_THIS)
+{
+    struct SDL_PrivateAudioData *h = this->hidden;
+    const int frame_size = ALSA_frame_size(this);
+    const snd_pcm_channel_area_t *areas;
+    snd_pcm_uframes_t offset, frames;
+
+    h->mmap_frames = 0;
+    if (!h->use_mmap) {
+        return (h->mixbuf);
+    }
+
+    /* mmap_begin works from the pointers fetched by the last avail_update,
+       and this runs before the first WaitDevice, so fetch them here */
+    if (ALSA_snd_pcm_avail_update(h->pcm_handle) <
+            (snd_pcm_sframes_t) this->spec.samples) {
+        return (h->mixbuf);
+    }
+    frames = this->spec.samples;
+    if (ALSA_snd_pcm_mmap_begin(h->pcm_handle, &areas, &offset, &frames) < 0) {
+        return (h->mixbuf);
+    }
+
+    /* Write in place only if the whole fragment is contiguous in the ring */
+    if ((frames != this->spec.samples) || (areas[0].first != 0) ||
+        (areas[0].step != (unsigned int) (frame_size * 8))) {
+        return (h->mixbuf);
+    }
+
+    h->mmap_offset = offset;
+    h->mmap_frames = frames;
+    h->mmap_buf = (Uint8 *) areas[0].addr + (offset * frame_size);
+    return (h->mmap_buf);
+}
+
+/* Unlike writei, mmap_commit never starts the stream, whatever the start
+   threshold, so start it once there's something in the ring. */
+static void
+ALSA_StartMmap(_THIS)
+{
+    struct SDL_PrivateAudioData *h = this->hidden;
+    int status;
+
+    if (this->enabled &&
+        ALSA_snd_pcm_state(h->pcm_handle) == SND_PCM_STATE_PREPARED) {
+        status = ALSA_snd_pcm_start(h->pcm_handle);
+        if (status < 0) {
+            ALSA_recover(this, status);
+        }
+    }
+}
+
+/* Copy mixbuf into the ring, for when the callback couldn't write in place */
+static void
+ALSA_PlayDeviceMmapCopy(_THIS)
+{
+    struct SDL_PrivateAudioData *h = this->hidden;
+    const Uint8 *sample_buf = (const Uint8 *) h->mixbuf;
+    const int frame_size = ALSA_frame_size(this);
+    snd_pcm_uframes_t frames_left = ((snd_pcm_uframes_t) this->spec.samples);
+    const snd_pcm_channel_area_t *areas;
+    snd_pcm_uframes_t offset, frames;
+    snd_pcm_sframes_t status;
+
+    while ( frames_left > 0 && this->enabled ) {
+        status = ALSA_snd_pcm_avail_update(h->pcm_handle);
+        if (status < 0) {
+            if (ALSA_recover(this, (int) status) < 0) {
+                return;
+            }
+            continue;
+        } else if (status == 0) {
+            /* A ring only one fragment long fills up before it's started */
+            ALSA_StartMmap(this);
+            ALSA_poll(this);
+            continue;
+        }
+
+        frames = frames_left;
+        status = ALSA_snd_pcm_mmap_begin(h->pcm_handle, &areas, &offset, &frames);
+        if (status < 0) {
+            if (ALSA_recover(this, (int) status) < 0) {
+                return;
+            }
+            continue;
+        }
+        SDL_memcpy((Uint8 *) areas[0].addr + (offset * frame_size),
+                   sample_buf, frames * frame_size);
+        status = ALSA_snd_pcm_mmap_commit(h->pcm_handle, offset, frames);
+        if (status < 0) {
+            if (ALSA_recover(this, (int) status) < 0) {
+                return;
+            }
+            continue;
+        }
+        sample_buf += status * frame_size;
+        frames_left -= status;
+    }
+}
+
+static void
+ALSA_PlayDeviceMmap(_THIS)
+{
+    struct SDL_PrivateAudioData *h = this->hidden;
+    snd_pcm_sframes_t status;
+
+    if (h->mmap_frames == 0) {
+        swizzle_alsa_channels(this, h->mixbuf);
+        ALSA_PlayDeviceMmapCopy(this);
+        ALSA_StartMmap(this);
+        return;
+    }
+
+    /* The callback already wrote into the ring; just hand it over. */
+    swizzle_alsa_channels(this, h->mmap_buf);
+    status = ALSA_snd_pcm_mmap_commit(h->pcm_handle, h->mmap_offset,
+                                      h->mmap_frames);
+    h->mmap_frames = 0;
+    if (status < 0) {
+        ALSA_recover(this, (int) status);
+        return;
+    }
+    ALSA_StartMmap(this);
+}
+
 static void
 ALSA_PlayDevice(_THIS)
 {
     int status;
     const Uint8 *sample_buf = (const Uint8 *) this->hidden->mixbuf;
-    const int frame_size = (((int) (this->spec.format & 0xFF)) / 8) *
-                                this->spec.channels;
+    const int frame_size = ALSA_frame_size(this);
     snd_pcm_uframes_t frames_left = ((snd_pcm_uframes_t) this->spec.samples);
 
-    swizzle_alsa_channels(this);
+    if (this->hidden->use_mmap) {
+        ALSA_PlayDeviceMmap(this);
+        return;
+    }
+
+    swizzle_alsa_channels(this, this->hidden->mixbuf);
 
     while ( frames_left > 0 && this->enabled ) {
         /* !!! FIXME: This works, but needs more testing before going live */
@@ -315,12 +560,7 @@ ALSA_PlayDevice(_THIS)
                 SDL_Delay(1);
                 continue;
             }
-            status = ALSA_snd_pcm_recover(this->hidden->pcm_handle, status, 0);
-            if (status < 0) {
-                /* Hmm, not much we can do - abort */
-                fprintf(stderr, "ALSA write failed (unrecoverable): %s\n",
-                        ALSA_snd_strerror(status));
-                this->enabled = 0;
+            if (ALSA_recover(this, status) < 0) {
                 return;
             }
             continue;
@@ -330,10 +570,36 @@ ALSA_PlayDevice(_THIS)
     }
 }
 
-static Uint8 *
-ALSA_GetDeviceBuf(_THIS)
+
+static int
+ALSA_CaptureFromDevice(_THIS, void *buffer, int buflen)
 {
-    return (this->hidden->mixbuf);
+    Uint8 *sample_buf = (Uint8 *) buffer;
+    const int frame_size = ALSA_frame_size(this);
+    snd_pcm_uframes_t frames_left = (snd_pcm_uframes_t) (buflen / frame_size);
+    snd_pcm_sframes_t status;
+
+    while (frames_left > 0 && this->enabled) {
+        status = ALSA_snd_pcm_readi(this->hidden->pcm_handle,
+                                    sample_buf, frames_left);
+        if (status < 0) {
+            if (status == -EAGAIN) {
+                SDL_Delay(1);
+                continue;
+            }
+            if (ALSA_recover(this, (int) status) < 0) {
+                return -1;
+            }
+            continue;
+        }
+        sample_buf += status * frame_size;
+        frames_left -= status;
+    }
+
+    /* ALSA's channel order to SDL's; the swaps undo themselves. */
+    swizzle_alsa_channels(this, buffer);
+
+    return buflen;
 }
 
 static void
@@ -342,8 +608,14 @@ ALSA_CloseDevice(_THIS)
     if (this->hidden != NULL) {
         SDL_FreeAudioMem(this->hidden->mixbuf);
         this->hidden->mixbuf = NULL;
+        SDL_free(this->hidden->pfds);
+        this->hidden->pfds = NULL;
         if (this->hidden->pcm_handle) {
-            ALSA_snd_pcm_drain(this->hidden->pcm_handle);
+            if (!this->iscapture) {
+                /* drain() won't wait for the ring to empty in non-blocking mode */
+                ALSA_snd_pcm_nonblock(this->hidden->pcm_handle, 0);
+                ALSA_snd_pcm_drain(this->hidden->pcm_handle);
+            }
             ALSA_snd_pcm_close(this->hidden->pcm_handle);
             this->hidden->pcm_handle = NULL;
         }
@@ -475,6 +747,7 @@ ALSA_OpenDevice(_THIS, const char *devname, int iscapture)
     SDL_AudioFormat test_format = 0;
     unsigned int rate = 0;
     unsigned int channels = 0;
+    const char *env;
 
     /* Initialize all variables that we clean on shutdown */
     this->hidden = (struct SDL_PrivateAudioData *)
@@ -487,8 +760,10 @@ ALSA_OpenDevice(_THIS, const char *devname, int iscapture)
     /* Open the audio device */
     /* Name of device should depend on # channels in spec */
     status = ALSA_snd_pcm_open(&pcm_handle,
-                               get_audio_device(this->spec.channels),
-                               SND_PCM_STREAM_PLAYBACK, SND_PCM_NONBLOCK);
+                               get_audio_device(this->spec.channels, iscapture),
+                               iscapture ? SND_PCM_STREAM_CAPTURE :
+                                           SND_PCM_STREAM_PLAYBACK,
+                               SND_PCM_NONBLOCK);
 
     if (status < 0) {
         ALSA_CloseDevice(this);
@@ -507,9 +782,19 @@ ALSA_OpenDevice(_THIS, const char *devname, int iscapture)
                             ALSA_snd_strerror(status));
     }
 
-    /* SDL only uses interleaved sample output */
-    status = ALSA_snd_pcm_hw_params_set_access(pcm_handle, hwparams,
+    /* SDL only uses interleaved sample output. Prefer mmap access, so the
+       callback can write directly into the hardware ring. */
+    status = -1;
+    env = SDL_getenv("SDL_AUDIO_ALSA_MMAP");
+    if (!iscapture && (!env || SDL_atoi(env))) {
+        status = ALSA_snd_pcm_hw_params_set_access(pcm_handle, hwparams,
+                                           SND_PCM_ACCESS_MMAP_INTERLEAVED);
+    }
+    this->hidden->use_mmap = (status >= 0);
+    if (!this->hidden->use_mmap) {
+        status = ALSA_snd_pcm_hw_params_set_access(pcm_handle, hwparams,
                                                SND_PCM_ACCESS_RW_INTERLEAVED);
+    }
     if (status < 0) {
         ALSA_CloseDevice(this);
         return SDL_SetError("ALSA: Couldn't set interleaved access: %s",
@@ -643,8 +928,36 @@ ALSA_OpenDevice(_THIS, const char *devname, int iscapture)
     }
     SDL_memset(this->hidden->mixbuf, this->spec.silence, this->hidden->mixlen);
 
-    /* Switch to blocking mode for playback */
-    ALSA_snd_pcm_nonblock(pcm_handle, 0);
+    if (this->hidden->use_mmap) {
+        /* Stay non-blocking; WaitDevice() sleeps in poll() on the PCM */
+        status = ALSA_snd_pcm_poll_descriptors_count(pcm_handle);
+        if (status <= 0) {
+            ALSA_CloseDevice(this);
+            return SDL_SetError("ALSA: Couldn't get poll descriptors");
+        }
+        this->hidden->nfds = status;
+        this->hidden->pfds = (struct pollfd *)
+            SDL_calloc(this->hidden->nfds, sizeof (struct pollfd));
+        if (this->hidden->pfds == NULL) {
+            ALSA_CloseDevice(this);
+            return SDL_OutOfMemory();
+        }
+        status = ALSA_snd_pcm_poll_descriptors(pcm_handle, this->hidden->pfds,
+                                               this->hidden->nfds);
+        if (status < 0) {
+            ALSA_CloseDevice(this);
+            return SDL_SetError("ALSA: Couldn't get poll descriptors: %s",
+                                ALSA_snd_strerror(status));
+        }
+    } else {
+        /* Switch to blocking mode for playback */
+        ALSA_snd_pcm_nonblock(pcm_handle, 0);
+    }
+
+    if ( SDL_getenv("SDL_AUDIO_ALSA_DEBUG") ) {
+        fprintf(stderr, "ALSA: using %s access\n",
+                this->hidden->use_mmap ? "mmap" : "read/write");
+    }
 
     /* We're ready to rock and roll. :-) */
     return 0;
@@ -668,9 +981,12 @@ ALSA_Init(SDL_AudioDriverImpl * impl)
     impl->WaitDevice = ALSA_WaitDevice;
     impl->GetDeviceBuf = ALSA_GetDeviceBuf;
     impl->PlayDevice = ALSA_PlayDevice;
+    impl->CaptureFromDevice = ALSA_CaptureFromDevice;
     impl->CloseDevice = ALSA_CloseDevice;
     impl->Deinitialize = ALSA_Deinitialize;
+    impl->HasCaptureSupport = 1;
     impl->OnlyHasDefaultOutputDevice = 1;       /* !!! FIXME: Add device enum! */
+    impl->OnlyHasDefaultInputDevice = 1;
 
     return 1;   /* this audio target is available. */
 }
@@ -38,6 +38,14 @@ struct SDL_PrivateAudioData
     /* Raw mixing buffer */
     Uint8 *mixbuf;
     int mixlen;
+
+    /* mmap access: the callback writes straight into the hardware ring */
+    int use_mmap;
+    struct pollfd *pfds;
+    int nfds;
+    Uint8 *mmap_buf;
+    snd_pcm_uframes_t mmap_offset;
+    snd_pcm_uframes_t mmap_frames;  /* 0 if GetDeviceBuf handed out mixbuf */
 };
 
 #endif /* _SDL_ALSA_audio_h */
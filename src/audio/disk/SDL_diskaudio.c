@@ -41,6 +41,40 @@
 #define DISKENVR_WRITEDELAY      "SDL_DISKAUDIODELAY"
 #define DISKDEFAULT_WRITEDELAY   150
 
+/* For benchmarking the audio pipeline without sound hardware:
+   SDL_DISKAUDIOSPEED paces buffers at a multiple of real time instead of
+   SDL_DISKAUDIODELAY, with 0 meaning as fast as possible, and
+   SDL_DISKAUDIODISCARD=1 throws the output away instead of writing it.
+   The device format can be forced to something other than what the app
+   asked for, so that conversion is part of the pipeline too.  A summary
+   of the throughput is printed when the device is closed. */
+#define DISKENVR_SPEED           "SDL_DISKAUDIOSPEED"
+#define DISKENVR_DISCARD         "SDL_DISKAUDIODISCARD"
+#define DISKENVR_FORMAT          "SDL_DISKAUDIOFORMAT"
+#define DISKENVR_FREQ            "SDL_DISKAUDIOFREQ"
+#define DISKENVR_CHANNELS        "SDL_DISKAUDIOCHANNELS"
+
+static const struct
+{
+    const char *name;
+    SDL_AudioFormat format;
+} disk_formats[] = {
+    { "U8", AUDIO_U8 },
+    { "S8", AUDIO_S8 },
+    { "U16LSB", AUDIO_U16LSB },
+    { "S16LSB", AUDIO_S16LSB },
+    { "U16MSB", AUDIO_U16MSB },
+    { "S16MSB", AUDIO_S16MSB },
+    { "S32LSB", AUDIO_S32LSB },
+    { "S32MSB", AUDIO_S32MSB },
+    { "F32LSB", AUDIO_F32LSB },
+    { "F32MSB", AUDIO_F32MSB },
+    { "U16", AUDIO_U16SYS },
+    { "S16", AUDIO_S16SYS },
+    { "S32", AUDIO_S32SYS },
+    { "F32", AUDIO_F32SYS }
+};
+
 static const char *
 DISKAUD_GetOutputFilename(const char *devname)
 {
@@ -57,7 +91,37 @@ DISKAUD_GetOutputFilename(const char *devname)
 static void
 DISKAUD_WaitDevice(_THIS)
 {
-    SDL_Delay(this->hidden->write_delay);
+    struct SDL_PrivateAudioData *h = this->hidden;
+    Uint64 now;
+
+    if (!h->paced) {
+        SDL_Delay(h->write_delay);
+        return;
+    }
+
+    /* Don't spin on silence while paused, and leave it out of the summary */
+    if (this->paused) {
+        h->next_buffer = 0;
+        SDL_Delay((this->spec.samples * 1000) / this->spec.freq);
+        return;
+    }
+
+    /* Wait for a deadline that advances by one buffer each time, so the
+       pacing doesn't drift with the time spent rendering. */
+    now = SDL_GetPerformanceCounter();
+    if (h->next_buffer == 0) {
+        h->next_buffer = now;
+    } else {
+        h->active_ticks += now - h->last_wait;
+    }
+    h->last_wait = now;
+    if (h->buffer_ticks) {
+        h->next_buffer += h->buffer_ticks;
+        if (h->next_buffer > now) {
+            SDL_Delay((Uint32) (((h->next_buffer - now) * 1000) /
+                                SDL_GetPerformanceFrequency()));
+        }
+    }
 }
 
 static void
@@ -65,6 +129,13 @@ DISKAUD_PlayDevice(_THIS)
 {
     size_t written;
 
+    if (!this->paused) {
+        this->hidden->buffers++;
+    }
+    if (this->hidden->discard) {
+        return;
+    }
+
     /* Write the audio data */
     written = SDL_RWwrite(this->hidden->output,
                           this->hidden->mixbuf, 1, this->hidden->mixlen);
@@ -84,10 +155,58 @@ DISKAUD_GetDeviceBuf(_THIS)
     return (this->hidden->mixbuf);
 }
 
+/* MB per second of audio data processed in the given time */
+static double
+DISKAUD_Throughput(Uint64 bytes, Uint64 us)
+{
+    return us ? ((double) bytes / (double) us) * (1000000.0 / (1024.0 * 1024.0)) : 0.0;
+}
+
+static void
+DISKAUD_PrintSummary(_THIS)
+{
+#if HAVE_STDIO_H
+    const struct SDL_PrivateAudioData *h = this->hidden;
+    const SDL_AudioDeviceStats *stats = &this->stats;
+    const Uint32 callback_len = this->convert.needed ?
+        (Uint32) this->convert.len : this->spec.size;
+    const double audio_secs = ((double) h->buffers * this->spec.samples) /
+        this->spec.freq;
+    const double wall_secs = (double) h->active_ticks /
+        SDL_GetPerformanceFrequency();
+
+    fprintf(stderr,
+            "SDL disk audio: %u buffers, %.2f s of audio in %.2f s (%.1fx real time)\n",
+            (unsigned int) h->buffers, audio_secs, wall_secs,
+            (wall_secs > 0.0) ? (audio_secs / wall_secs) : 0.0);
+    if (stats->callback.count) {
+        fprintf(stderr,
+                " callback: %u calls, %.1f us avg, %u us max, %.1f MB/s\n",
+                (unsigned int) stats->callback.count,
+                (double) stats->callback.total_us / stats->callback.count,
+                (unsigned int) stats->callback.max_us,
+                DISKAUD_Throughput((Uint64) stats->callback.count * callback_len,
+                                   stats->callback.total_us));
+    }
+    if (stats->convert.count) {
+        fprintf(stderr,
+                " convert: %u calls, %.1f us avg, %u us max, %.1f MB/s\n",
+                (unsigned int) stats->convert.count,
+                (double) stats->convert.total_us / stats->convert.count,
+                (unsigned int) stats->convert.max_us,
+                DISKAUD_Throughput((Uint64) stats->convert.count * this->spec.size,
+                                   stats->convert.total_us));
+    }
+#endif
+}
+
 static void
 DISKAUD_CloseDevice(_THIS)
 {
     if (this->hidden != NULL) {
+        if (this->hidden->paced || this->hidden->discard) {
+            DISKAUD_PrintSummary(this);
+        }
         SDL_FreeAudioMem(this->hidden->mixbuf);
         this->hidden->mixbuf = NULL;
         if (this->hidden->output != NULL) {
@@ -99,11 +218,44 @@ DISKAUD_CloseDevice(_THIS)
     }
 }
 
+/* Apply any format the device was told to use instead of the app's */
+static int
+DISKAUD_ForceFormat(_THIS)
+{
+    const char *envr;
+    int i;
+
+    envr = SDL_getenv(DISKENVR_FORMAT);
+    if (envr) {
+        for (i = 0; i < SDL_arraysize(disk_formats); ++i) {
+            if (SDL_strcasecmp(envr, disk_formats[i].name) == 0) {
+                this->spec.format = disk_formats[i].format;
+                break;
+            }
+        }
+        if (i == SDL_arraysize(disk_formats)) {
+            return SDL_SetError("Unknown %s: %s", DISKENVR_FORMAT, envr);
+        }
+    }
+    envr = SDL_getenv(DISKENVR_FREQ);
+    if (envr && (SDL_atoi(envr) > 0)) {
+        this->spec.freq = SDL_atoi(envr);
+    }
+    envr = SDL_getenv(DISKENVR_CHANNELS);
+    if (envr && (SDL_atoi(envr) > 0)) {
+        this->spec.channels = (Uint8) SDL_atoi(envr);
+    }
+    SDL_CalculateAudioSpec(&this->spec);
+    return 0;
+}
+
 static int
 DISKAUD_OpenDevice(_THIS, const char *devname, int iscapture)
 {
     const char *envr = SDL_getenv(DISKENVR_WRITEDELAY);
     const char *fname = DISKAUD_GetOutputFilename(devname);
+    const char *speed = SDL_getenv(DISKENVR_SPEED);
+    const char *discard = SDL_getenv(DISKENVR_DISCARD);
 
     this->hidden = (struct SDL_PrivateAudioData *)
         SDL_malloc(sizeof(*this->hidden));
@@ -112,15 +264,32 @@ DISKAUD_OpenDevice(_THIS, const char *devname, int iscapture)
     }
     SDL_memset(this->hidden, 0, sizeof(*this->hidden));
 
+    if (DISKAUD_ForceFormat(this) < 0) {
+        DISKAUD_CloseDevice(this);
+        return -1;
+    }
+
     this->hidden->mixlen = this->spec.size;
     this->hidden->write_delay =
         (envr) ? SDL_atoi(envr) : DISKDEFAULT_WRITEDELAY;
+    this->hidden->discard = (discard && SDL_atoi(discard));
+    if (speed) {
+        const double multiple = SDL_atof(speed);
+        this->hidden->paced = 1;
+        if (multiple > 0.0) {
+            this->hidden->buffer_ticks = (Uint64)
+                ((((double) this->spec.samples / this->spec.freq) *
+                  SDL_GetPerformanceFrequency()) / multiple);
+        }
+    }
 
     /* Open the audio device */
-    this->hidden->output = SDL_RWFromFile(fname, "wb");
-    if (this->hidden->output == NULL) {
-        DISKAUD_CloseDevice(this);
-        return -1;
+    if (!this->hidden->discard) {
+        this->hidden->output = SDL_RWFromFile(fname, "wb");
+        if (this->hidden->output == NULL) {
+            DISKAUD_CloseDevice(this);
+            return -1;
+        }
     }
 
     /* Allocate mixing buffer */
@@ -132,9 +301,15 @@ DISKAUD_OpenDevice(_THIS, const char *devname, int iscapture)
     SDL_memset(this->hidden->mixbuf, this->spec.silence, this->spec.size);
 
 #if HAVE_STDIO_H
-    fprintf(stderr,
-            "WARNING: You are using the SDL disk writer audio driver!\n"
-            " Writing to file [%s].\n", fname);
+    if (this->hidden->discard) {
+        fprintf(stderr,
+                "WARNING: You are using the SDL disk writer audio driver!\n"
+                " Discarding output.\n");
+    } else {
+        fprintf(stderr,
+                "WARNING: You are using the SDL disk writer audio driver!\n"
+                " Writing to file [%s].\n", fname);
+    }
 #endif
 
     /* We're ready to rock and roll. :-) */
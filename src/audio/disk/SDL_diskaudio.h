@@ -36,6 +36,15 @@ struct SDL_PrivateAudioData
     Uint8 *mixbuf;
     Uint32 mixlen;
     Uint32 write_delay;
+
+    /* Benchmark mode: paced by the clock at a multiple of real time */
+    int paced;
+    int discard;
+    Uint64 buffer_ticks;        /* performance counter ticks per buffer, or 0 */
+    Uint64 next_buffer;         /* when the next buffer is due, 0 if paused */
+    Uint64 last_wait;
+    Uint64 active_ticks;        /* time spent unpaused */
+    Uint32 buffers;             /* buffers played unpaused */
 };
 
 #endif /* _SDL_diskaudio_h */
@@ -52,6 +52,8 @@ FillSound(void *device, void *stream, size_t len,
     if (!audio->enabled)
         return;
 
+    SDL_RunAudioCommands(audio);
+
     if (!audio->paused) {
         if (audio->convert.needed) {
             SDL_LockMutex(audio->mixer_lock);
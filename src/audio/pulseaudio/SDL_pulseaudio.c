@@ -42,6 +42,7 @@
 
 #include "SDL_timer.h"
 #include "SDL_audio.h"
+#include "SDL_hints.h"
 #include "../SDL_audiomem.h"
 #include "../SDL_audio_c.h"
 #include "SDL_pulseaudio.h"
@@ -103,6 +104,20 @@ static pa_operation * (*PULSEAUDIO_pa_stream_drain) (pa_stream *,
     pa_stream_success_cb_t, void *);
 static int (*PULSEAUDIO_pa_stream_disconnect) (pa_stream *);
 static void (*PULSEAUDIO_pa_stream_unref) (pa_stream *);
+static void (*PULSEAUDIO_pa_stream_set_write_callback) (pa_stream *,
+    pa_stream_request_cb_t, void *);
+static void (*PULSEAUDIO_pa_stream_set_underflow_callback) (pa_stream *,
+    pa_stream_notify_cb_t, void *);
+static pa_operation * (*PULSEAUDIO_pa_stream_set_buffer_attr) (pa_stream *,
+    const pa_buffer_attr *, pa_stream_success_cb_t, void *);
+static int (*PULSEAUDIO_pa_stream_get_latency) (pa_stream *, pa_usec_t *,
+    int *);
+static int (*PULSEAUDIO_pa_stream_connect_record) (pa_stream *, const char *,
+    const pa_buffer_attr *, pa_stream_flags_t);
+static int (*PULSEAUDIO_pa_stream_peek) (pa_stream *, const void **, size_t *);
+static int (*PULSEAUDIO_pa_stream_drop) (pa_stream *);
+static void (*PULSEAUDIO_pa_stream_set_overflow_callback) (pa_stream *,
+    pa_stream_notify_cb_t, void *);
 
 static int load_pulseaudio_syms(void);
 
@@ -201,6 +216,14 @@ load_pulseaudio_syms(void)
     SDL_PULSEAUDIO_SYM(pa_stream_drain);
     SDL_PULSEAUDIO_SYM(pa_stream_disconnect);
     SDL_PULSEAUDIO_SYM(pa_stream_unref);
+    SDL_PULSEAUDIO_SYM(pa_stream_set_write_callback);
+    SDL_PULSEAUDIO_SYM(pa_stream_set_underflow_callback);
+    SDL_PULSEAUDIO_SYM(pa_stream_set_buffer_attr);
+    SDL_PULSEAUDIO_SYM(pa_stream_get_latency);
+    SDL_PULSEAUDIO_SYM(pa_stream_connect_record);
+    SDL_PULSEAUDIO_SYM(pa_stream_peek);
+    SDL_PULSEAUDIO_SYM(pa_stream_drop);
+    SDL_PULSEAUDIO_SYM(pa_stream_set_overflow_callback);
     SDL_PULSEAUDIO_SYM(pa_channel_map_init_auto);
     SDL_PULSEAUDIO_SYM(pa_strerror);
     return 0;
@@ -228,23 +251,81 @@ CheckPulseAudioAvailable()
     }
 }
 
+/* The server wants more data; WaitDevice() sleeps until this happens. */
+static void
+stream_write_callback(pa_stream *s, size_t nbytes, void *userdata)
+{
+    struct SDL_PrivateAudioData *h = (struct SDL_PrivateAudioData *) userdata;
+    h->write_requested = 1;
+}
+
+/* We ran dry; trade a fragment of latency for stability, up to a limit. */
+static void
+stream_underflow_callback(pa_stream *s, void *userdata)
+{
+    SDL_AudioDevice *device = (SDL_AudioDevice *) userdata;
+    struct SDL_PrivateAudioData *h = device->hidden;
+    pa_operation *o;
+
+    SDL_AudioDeviceXrun(device);
+
+    if (h->attr.tlength >= h->max_tlength) {
+        return;
+    }
+
+    h->attr.tlength += h->attr.minreq;
+    if (h->attr.tlength > h->max_tlength) {
+        h->attr.tlength = h->max_tlength;
+    }
+
+    o = PULSEAUDIO_pa_stream_set_buffer_attr(s, &h->attr, NULL, NULL);
+    if (o) {
+        PULSEAUDIO_pa_operation_unref(o);
+    }
+}
+
+/* Capture data was lost because we didn't read it in time. */
+static void
+stream_overflow_callback(pa_stream *s, void *userdata)
+{
+    SDL_AudioDeviceXrun((SDL_AudioDevice *) userdata);
+}
+
+static void
+UpdateLatency(struct SDL_PrivateAudioData *h)
+{
+    pa_usec_t usec = 0;
+    int negative = 0;
+
+    if (PULSEAUDIO_pa_stream_get_latency(h->stream, &usec, &negative) == 0) {
+        if (negative) {
+            usec = 0;
+        } else if (usec > 0x7FFFFFFF) {
+            usec = 0x7FFFFFFF;
+        }
+        SDL_AtomicSet(&h->latency, (int) usec);
+    }
+}
+
 /* This function waits until it is possible to write a full sound buffer */
 static void
 PULSEAUDIO_WaitDevice(_THIS)
 {
     struct SDL_PrivateAudioData *h = this->hidden;
 
-    while(1) {
+    /* Sleep in the main loop until the server asks for a full buffer. */
+    while (!h->write_requested ||
+           PULSEAUDIO_pa_stream_writable_size(h->stream) < h->mixlen) {
+        h->write_requested = 0;
         if (PULSEAUDIO_pa_context_get_state(h->context) != PA_CONTEXT_READY ||
             PULSEAUDIO_pa_stream_get_state(h->stream) != PA_STREAM_READY ||
             PULSEAUDIO_pa_mainloop_iterate(h->mainloop, 1, NULL) < 0) {
             this->enabled = 0;
             return;
         }
-        if (PULSEAUDIO_pa_stream_writable_size(h->stream) >= h->mixlen) {
-            return;
-        }
     }
+
+    UpdateLatency(h);
 }
 
 static void
@@ -258,6 +339,62 @@ PULSEAUDIO_PlayDevice(_THIS)
     }
 }
 
+static int
+PULSEAUDIO_CaptureFromDevice(_THIS, void *buffer, int buflen)
+{
+    struct SDL_PrivateAudioData *h = this->hidden;
+    Uint8 *dst = (Uint8 *) buffer;
+    const void *data;
+    size_t nbytes, cpy;
+    int remaining = buflen;
+
+    while (remaining > 0) {
+        if (h->capturelen == 0) {
+            if (PULSEAUDIO_pa_stream_peek(h->stream, &data, &nbytes) < 0) {
+                return -1;
+            } else if (nbytes == 0) {
+                /* Nothing buffered; sleep in the main loop until there is. */
+                if (PULSEAUDIO_pa_context_get_state(h->context) != PA_CONTEXT_READY ||
+                    PULSEAUDIO_pa_stream_get_state(h->stream) != PA_STREAM_READY ||
+                    PULSEAUDIO_pa_mainloop_iterate(h->mainloop, 1, NULL) < 0) {
+                    return -1;
+                }
+                continue;
+            }
+            h->capturebuf = (const Uint8 *) data;
+            h->capturelen = nbytes;
+        }
+
+        cpy = SDL_min(h->capturelen, (size_t) remaining);
+        if (h->capturebuf) {
+            SDL_memcpy(dst, h->capturebuf, cpy);
+            h->capturebuf += cpy;
+        } else {
+            SDL_memset(dst, this->spec.silence, cpy);
+        }
+        dst += cpy;
+        remaining -= (int) cpy;
+        h->capturelen -= cpy;
+        if (h->capturelen == 0) {
+            PULSEAUDIO_pa_stream_drop(h->stream);
+            h->capturebuf = NULL;
+        }
+    }
+
+    UpdateLatency(h);
+    return buflen;
+}
+
+static int
+PULSEAUDIO_GetDeviceLatency(_THIS)
+{
+    const int latency = SDL_AtomicGet(&this->hidden->latency);
+    if (latency < 0) {
+        return SDL_SetError("PulseAudio hasn't reported the latency yet");
+    }
+    return latency;
+}
+
 static void
 stream_drain_complete(pa_stream *s, int success, void *userdata)
 {
@@ -353,6 +490,8 @@ PULSEAUDIO_OpenDevice(_THIS, const char *devname, int iscapture)
     pa_buffer_attr paattr;
     pa_channel_map pacmap;
     pa_stream_flags_t flags = 0;
+    const char *hint = SDL_GetHint(SDL_HINT_AUDIO_TARGET_LATENCY);
+    int target_ms = hint ? SDL_atoi(hint) : 0;
     int state = 0;
 
     /* Initialize all variables that we clean on shutdown */
@@ -363,6 +502,7 @@ PULSEAUDIO_OpenDevice(_THIS, const char *devname, int iscapture)
     }
     SDL_memset(this->hidden, 0, (sizeof *this->hidden));
     h = this->hidden;
+    SDL_AtomicSet(&h->latency, -1);
 
     paspec.format = PA_SAMPLE_INVALID;
 
@@ -409,9 +549,21 @@ PULSEAUDIO_OpenDevice(_THIS, const char *devname, int iscapture)
     this->spec.format = test_format;
 
     /* Calculate the final parameters for this audio specification */
+    if (target_ms > 0) {
+        /* Keep two fragments in flight within the target latency. */
+        const int frames = (this->spec.freq / 1000) * target_ms / 2;
+        Uint16 samples = 64;
+        while ((samples * 2 <= frames) && (samples * 2 <= this->spec.samples)) {
+            samples *= 2;
+        }
+        if (samples < this->spec.samples) {
+            this->spec.samples = samples;
+        }
+    } else {
 #ifdef PA_STREAM_ADJUST_LATENCY
-    this->spec.samples /= 2; /* Mix in smaller chunck to avoid underruns */
+        this->spec.samples /= 2; /* Mix in smaller chunck to avoid underruns */
 #endif
+    }
     SDL_CalculateAudioSpec(&this->spec);
 
     /* Allocate mixing buffer */
@@ -435,12 +587,31 @@ PULSEAUDIO_OpenDevice(_THIS, const char *devname, int iscapture)
     /* -1 can lead to pa_stream_writable_size() >= mixlen never being true */
     paattr.minreq = h->mixlen;
     flags = PA_STREAM_ADJUST_LATENCY;
+    if (target_ms > 0) {
+        const Uint32 framesize = (SDL_AUDIO_BITSIZE(this->spec.format) / 8) *
+                                 this->spec.channels;
+        paattr.tlength = ((this->spec.freq * target_ms) / 1000) * framesize;
+        if (paattr.tlength < (Uint32) (h->mixlen * 2)) {
+            paattr.tlength = h->mixlen * 2;
+        }
+        h->max_tlength = paattr.tlength * 4;
+    } else {
+        h->max_tlength = paattr.tlength;
+    }
 #else
     paattr.tlength = h->mixlen*2;
     paattr.prebuf = h->mixlen*2;
     paattr.maxlength = h->mixlen*2;
     paattr.minreq = h->mixlen;
+    h->max_tlength = paattr.tlength;
 #endif
+    if (iscapture) {
+        /* The server hands us data in fragments of this size */
+        paattr.fragsize = h->mixlen;
+        paattr.maxlength = -1;
+    }
+    flags |= PA_STREAM_INTERPOLATE_TIMING | PA_STREAM_AUTO_TIMING_UPDATE;
+    h->attr = paattr;
 
     /* The SDL ALSA output hints us that we use Windows' channel mapping */
     /* http://bugzilla.libsdl.org/show_bug.cgi?id=110 */
@@ -490,10 +661,25 @@ PULSEAUDIO_OpenDevice(_THIS, const char *devname, int iscapture)
         return SDL_SetError("Could not set up PulseAudio stream");
     }
 
-    if (PULSEAUDIO_pa_stream_connect_playback(h->stream, NULL, &paattr, flags,
-            NULL, NULL) < 0) {
-        PULSEAUDIO_CloseDevice(this);
-        return SDL_SetError("Could not connect PulseAudio stream");
+    if (iscapture) {
+        PULSEAUDIO_pa_stream_set_overflow_callback(h->stream,
+                                                   stream_overflow_callback, this);
+        if (PULSEAUDIO_pa_stream_connect_record(h->stream, NULL, &paattr,
+                                                flags) < 0) {
+            PULSEAUDIO_CloseDevice(this);
+            return SDL_SetError("Could not connect PulseAudio stream");
+        }
+    } else {
+        PULSEAUDIO_pa_stream_set_write_callback(h->stream,
+                                                stream_write_callback, h);
+        PULSEAUDIO_pa_stream_set_underflow_callback(h->stream,
+                                                    stream_underflow_callback,
+                                                    this);
+        if (PULSEAUDIO_pa_stream_connect_playback(h->stream, NULL, &paattr,
+                                                  flags, NULL, NULL) < 0) {
+            PULSEAUDIO_CloseDevice(this);
+            return SDL_SetError("Could not connect PulseAudio stream");
+        }
     }
 
     do {
@@ -538,8 +724,12 @@ PULSEAUDIO_Init(SDL_AudioDriverImpl * impl)
     impl->GetDeviceBuf = PULSEAUDIO_GetDeviceBuf;
     impl->CloseDevice = PULSEAUDIO_CloseDevice;
     impl->WaitDone = PULSEAUDIO_WaitDone;
+    impl->GetDeviceLatency = PULSEAUDIO_GetDeviceLatency;
+    impl->CaptureFromDevice = PULSEAUDIO_CaptureFromDevice;
     impl->Deinitialize = PULSEAUDIO_Deinitialize;
+    impl->HasCaptureSupport = 1;
     impl->OnlyHasDefaultOutputDevice = 1;
+    impl->OnlyHasDefaultInputDevice = 1;
 
     return 1;   /* this audio target is available. */
 }
@@ -25,6 +25,8 @@
 
 #include <pulse/simple.h>
 
+#include "SDL_atomic.h"
+
 #include "../SDL_sysaudio.h"
 
 /* Hidden "this" pointer for the audio functions */
@@ -41,6 +43,21 @@ struct SDL_PrivateAudioData
     /* Raw mixing buffer */
     Uint8 *mixbuf;
     int mixlen;
+
+    /* Server-side buffering, adjusted while playing */
+    pa_buffer_attr attr;
+    Uint32 max_tlength;
+
+    /* Set by the write callback when the server asks for more data */
+    int write_requested;
+
+    /* Last measured stream latency in microseconds, -1 if not known yet */
+    SDL_atomic_t latency;
+
+    /* Capture: what's left of the fragment from pa_stream_peek(), with
+       capturebuf NULL if it's a hole */
+    const Uint8 *capturebuf;
+    size_t capturelen;
 };
 
 #endif /* _SDL_pulseaudio_h */
@@ -576,3 +576,14 @@
 #define SDL_GetAssertionHandler SDL_GetAssertionHandler_REAL
 #define SDL_DXGIGetOutputInfo SDL_DXGIGetOutputInfo_REAL
 #define SDL_RenderIsClipEnabled SDL_RenderIsClipEnabled_REAL
+#define SDL_GetAudioDeviceLatency SDL_GetAudioDeviceLatency_REAL
+#define SDL_GetAudioDeviceStats SDL_GetAudioDeviceStats_REAL
+#define SDL_ResetAudioDeviceStats SDL_ResetAudioDeviceStats_REAL
+#define SDL_QueueAudioCommand SDL_QueueAudioCommand_REAL
+#define SDL_OpenWAVStream_RW SDL_OpenWAVStream_RW_REAL
+#define SDL_GetWAVStreamLength SDL_GetWAVStreamLength_REAL
+#define SDL_ReadWAVStream SDL_ReadWAVStream_REAL
+#define SDL_SeekWAVStream SDL_SeekWAVStream_REAL
+#define SDL_CloseWAVStream SDL_CloseWAVStream_REAL
+#define SDL_RenderFlush SDL_RenderFlush_REAL
+#define SDL_HasAVX2 SDL_HasAVX2_REAL
@@ -607,3 +607,14 @@ SDL_DYNAPI_PROC(SDL_AssertionHandler,SDL_GetAssertionHandler,(void **a),(a),retu
 SDL_DYNAPI_PROC(SDL_bool,SDL_DXGIGetOutputInfo,(int a,int *b, int *c),(a,b,c),return)
 #endif
 SDL_DYNAPI_PROC(SDL_bool,SDL_RenderIsClipEnabled,(SDL_Renderer *a),(a),return)
+SDL_DYNAPI_PROC(int,SDL_GetAudioDeviceLatency,(SDL_AudioDeviceID a),(a),return)
+SDL_DYNAPI_PROC(int,SDL_GetAudioDeviceStats,(SDL_AudioDeviceID a, SDL_AudioDeviceStats *b),(a,b),return)
+SDL_DYNAPI_PROC(void,SDL_ResetAudioDeviceStats,(SDL_AudioDeviceID a),(a),)
+SDL_DYNAPI_PROC(int,SDL_QueueAudioCommand,(SDL_AudioDeviceID a, SDL_AudioCommandCallback b, void *c),(a,b,c),return)
+SDL_DYNAPI_PROC(SDL_WAVStream*,SDL_OpenWAVStream_RW,(SDL_RWops *a, int b, SDL_AudioSpec *c),(a,b,c),return)
+SDL_DYNAPI_PROC(Uint32,SDL_GetWAVStreamLength,(SDL_WAVStream *a),(a),return)
+SDL_DYNAPI_PROC(int,SDL_ReadWAVStream,(SDL_WAVStream *a, void *b, int c),(a,b,c),return)
+SDL_DYNAPI_PROC(int,SDL_SeekWAVStream,(SDL_WAVStream *a, Uint32 b),(a,b),return)
+SDL_DYNAPI_PROC(void,SDL_CloseWAVStream,(SDL_WAVStream *a),(a),)
+SDL_DYNAPI_PROC(int,SDL_RenderFlush,(SDL_Renderer *a),(a),return)
+SDL_DYNAPI_PROC(SDL_bool,SDL_HasAVX2,(void),(),return)
@@ -102,6 +102,158 @@ SDL_GetRenderDriverInfo(int index, SDL_RendererInfo * info)
 #endif
 }
 
+/* How many runs back a draw may look for a run with the same texture */
+#define QUEUE_MERGE_DEPTH   8
+
+/* Submit the queued draws to the driver, one call per run.  Runs are drawn
+   in the order they were started, which is safe because a draw only joins
+   an earlier run if it doesn't overlap anything queued after that run.
+ */
+static int
+FlushRenderQueue(SDL_Renderer * renderer)
+{
+    SDL_RenderQueue *queue = &renderer->queue;
+    const SDL_Rect *srcrects = queue->srcrects;
+    const SDL_FRect *dstrects = queue->dstrects;
+    int first[SDL_RENDER_QUEUE_RUNS];
+    int i, n, num_runs;
+    int status = 0;
+
+    if (queue->count == 0) {
+        return 0;
+    }
+
+    /* Sort the draws by run, keeping them in order within each run */
+    num_runs = queue->num_runs;
+    if (num_runs > 1) {
+        for (i = 0, n = 0; i < num_runs; ++i) {
+            first[i] = n;
+            n += queue->runs[i].count;
+        }
+        for (i = 0; i < queue->count; ++i) {
+            n = first[queue->run[i]]++;
+            queue->sorted_srcrects[n] = queue->srcrects[i];
+            queue->sorted_dstrects[n] = queue->dstrects[i];
+        }
+        srcrects = queue->sorted_srcrects;
+        dstrects = queue->sorted_dstrects;
+    }
+    queue->count = 0;
+    queue->num_runs = 0;
+    queue->num_fill_runs = 0;
+
+    for (i = 0, n = 0; i < num_runs; ++i) {
+        const SDL_RenderRun *run = &queue->runs[i];
+
+        if (run->texture) {
+            if (renderer->RenderCopyBatch(renderer, run->texture, &srcrects[n],
+                                          &dstrects[n], run->count) < 0) {
+                status = -1;
+            }
+        } else {
+            if (renderer->RenderFillRects(renderer, &dstrects[n], run->count) < 0) {
+                status = -1;
+            }
+        }
+        n += run->count;
+    }
+    return status;
+}
+
+/* Flush the queue if any of the queued draws use the given texture */
+static int
+FlushRenderQueueTexture(SDL_Renderer * renderer, SDL_Texture * texture)
+{
+    SDL_RenderQueue *queue = &renderer->queue;
+    int i;
+
+    for (i = 0; i < queue->num_runs; ++i) {
+        if (queue->runs[i].texture == texture) {
+            return FlushRenderQueue(renderer);
+        }
+    }
+    return 0;
+}
+
+static int
+QueueRenderDraw(SDL_Renderer * renderer, SDL_Texture * texture,
+                const SDL_Rect * srcrect, const SDL_FRect * dstrect)
+{
+    SDL_RenderQueue *queue = &renderer->queue;
+    SDL_RenderRun *run = NULL;
+    const float minx = SDL_min(dstrect->x, dstrect->x + dstrect->w);
+    const float miny = SDL_min(dstrect->y, dstrect->y + dstrect->h);
+    const float maxx = SDL_max(dstrect->x, dstrect->x + dstrect->w);
+    const float maxy = SDL_max(dstrect->y, dstrect->y + dstrect->h);
+    int i;
+
+    if (!queue->run) {
+        queue->run = (Uint8 *) SDL_malloc(SDL_RENDER_QUEUE_SIZE *
+                                          (sizeof(Uint8) +
+                                           2 * sizeof(SDL_Rect) +
+                                           2 * sizeof(SDL_FRect)));
+        if (!queue->run) {
+            return SDL_OutOfMemory();
+        }
+        queue->srcrects = (SDL_Rect *) (queue->run + SDL_RENDER_QUEUE_SIZE * sizeof(Uint8));
+        queue->sorted_srcrects = queue->srcrects + SDL_RENDER_QUEUE_SIZE;
+        queue->dstrects = (SDL_FRect *) (queue->sorted_srcrects + SDL_RENDER_QUEUE_SIZE);
+        queue->sorted_dstrects = queue->dstrects + SDL_RENDER_QUEUE_SIZE;
+    }
+    if (queue->count == SDL_RENDER_QUEUE_SIZE) {
+        if (FlushRenderQueue(renderer) < 0) {
+            return -1;
+        }
+    }
+
+    /* Join a recent run with the same texture, as long as that doesn't
+       move this draw in front of anything it overlaps */
+    for (i = queue->num_runs - 1;
+         i >= 0 && i >= queue->num_runs - QUEUE_MERGE_DEPTH; --i) {
+        if (queue->runs[i].texture == texture) {
+            run = &queue->runs[i];
+            break;
+        }
+        if (minx < queue->runs[i].maxx && queue->runs[i].minx < maxx &&
+            miny < queue->runs[i].maxy && queue->runs[i].miny < maxy) {
+            break;
+        }
+    }
+
+    if (run) {
+        run->minx = SDL_min(run->minx, minx);
+        run->miny = SDL_min(run->miny, miny);
+        run->maxx = SDL_max(run->maxx, maxx);
+        run->maxy = SDL_max(run->maxy, maxy);
+    } else {
+        if (queue->num_runs == SDL_RENDER_QUEUE_RUNS) {
+            if (FlushRenderQueue(renderer) < 0) {
+                return -1;
+            }
+        }
+        i = queue->num_runs++;
+        run = &queue->runs[i];
+        run->texture = texture;
+        run->minx = minx;
+        run->miny = miny;
+        run->maxx = maxx;
+        run->maxy = maxy;
+        run->count = 0;
+        if (!texture) {
+            ++queue->num_fill_runs;
+        }
+    }
+    ++run->count;
+
+    queue->run[queue->count] = (Uint8) i;
+    if (srcrect) {
+        queue->srcrects[queue->count] = *srcrect;
+    }
+    queue->dstrects[queue->count] = *dstrect;
+    ++queue->count;
+    return 0;
+}
+
 static int
 SDL_RendererEventWatch(void *userdata, SDL_Event *event)
 {
@@ -110,6 +262,8 @@ SDL_RendererEventWatch(void *userdata, SDL_Event *event)
     if (event->type == SDL_WINDOWEVENT) {
         SDL_Window *window = SDL_GetWindowFromID(event->window.windowID);
         if (window == renderer->window) {
+            FlushRenderQueue(renderer);
+
             if (renderer->WindowEvent) {
                 renderer->WindowEvent(renderer, &event->window);
             }
@@ -209,6 +363,7 @@ SDL_CreateRenderer(SDL_Window * window, int index, Uint32 flags)
 #if !SDL_RENDER_DISABLED
     SDL_Renderer *renderer = NULL;
     int n = SDL_GetNumRenderDrivers();
+    SDL_bool batching = SDL_FALSE;
     const char *hint;
 
     if (!window) {
@@ -232,6 +387,11 @@ SDL_CreateRenderer(SDL_Window * window, int index, Uint32 flags)
 
     if (index < 0) {
         hint = SDL_GetHint(SDL_HINT_RENDER_DRIVER);
+
+        /* An application that picks its renderer may be mixing its own
+           drawing with ours, so it has to ask for batching */
+        batching = hint ? SDL_FALSE : SDL_TRUE;
+
         if (hint) {
             for (index = 0; index < n; ++index) {
                 const SDL_RenderDriver *driver = render_drivers[index];
@@ -278,6 +438,19 @@ SDL_CreateRenderer(SDL_Window * window, int index, Uint32 flags)
         renderer->scale.x = 1.0f;
         renderer->scale.y = 1.0f;
 
+        hint = SDL_GetHint(SDL_HINT_RENDER_BATCHING);
+        if (hint) {
+            batching = (*hint != '0') ? SDL_TRUE : SDL_FALSE;
+        }
+        if (renderer->RenderCopyBatch && batching) {
+            renderer->queue.enabled = SDL_TRUE;
+        }
+
+        hint = SDL_GetHint(SDL_HINT_RENDER_ATLAS);
+        if (hint && *hint == '1') {
+            renderer->atlas_enabled = SDL_TRUE;
+        }
+
         if (SDL_GetWindowFlags(window) & (SDL_WINDOW_HIDDEN|SDL_WINDOW_MINIMIZED)) {
             renderer->hidden = SDL_TRUE;
         } else {
@@ -305,6 +478,7 @@ SDL_CreateSoftwareRenderer(SDL_Surface * surface)
 {
 #if !SDL_RENDER_DISABLED
     SDL_Renderer *renderer;
+    const char *hint;
 
     renderer = SW_CreateRendererForSurface(surface);
 
@@ -313,6 +487,11 @@ SDL_CreateSoftwareRenderer(SDL_Surface * surface)
         renderer->scale.x = 1.0f;
         renderer->scale.y = 1.0f;
 
+        hint = SDL_GetHint(SDL_HINT_RENDER_ATLAS);
+        if (hint && *hint == '1') {
+            renderer->atlas_enabled = SDL_TRUE;
+        }
+
         SDL_RenderSetViewport(renderer, NULL);
     }
     return renderer;
@@ -380,6 +559,13 @@ GetClosestSupportedFormat(SDL_Renderer * renderer, Uint32 format)
                 return renderer->info.texture_formats[i];
             }
         }
+        /* Otherwise it's converted in software, so keep 8 bits per channel */
+        for (i = 0; i < renderer->info.num_texture_formats; ++i) {
+            if (!SDL_ISPIXELFORMAT_FOURCC(renderer->info.texture_formats[i]) &&
+                SDL_BYTESPERPIXEL(renderer->info.texture_formats[i]) == 4) {
+                return renderer->info.texture_formats[i];
+            }
+        }
     } else {
         SDL_bool hasAlpha = SDL_ISPIXELFORMAT_ALPHA(format);
 
@@ -394,6 +580,280 @@ GetClosestSupportedFormat(SDL_Renderer * renderer, Uint32 format)
     return renderer->info.texture_formats[0];
 }
 
+/* The size of the pages small textures are packed into */
+#define ATLAS_PAGE_SIZE     1024
+
+/* The largest texture that is packed into a page */
+#define ATLAS_MAX_SIZE      128
+
+/* Space around each texture in a page, holding a copy of its edges so
+   filtering at the edges doesn't pick up the texture next to it */
+#define ATLAS_PADDING       1
+
+static int
+GetScaleQuality(void)
+{
+    const char *hint = SDL_GetHint(SDL_HINT_RENDER_SCALE_QUALITY);
+
+    if (!hint || *hint == '0' || SDL_strcasecmp(hint, "nearest") == 0) {
+        return 0;
+    } else if (*hint == '1' || SDL_strcasecmp(hint, "linear") == 0) {
+        return 1;
+    } else {
+        return 2;
+    }
+}
+
+/* Find how high a w x h rectangle would sit if its left edge was at the
+   given node of the skyline, or -1 if it doesn't fit there */
+static int
+FitAtlasNode(const SDL_AtlasPage * page, int index, int w, int h)
+{
+    const SDL_AtlasNode *node = &page->nodes[index];
+    int y = 0;
+    int remaining = w;
+
+    if (node->x + w > page->texture->w) {
+        return -1;
+    }
+    while (remaining > 0) {
+        y = SDL_max(y, node->y);
+        if (y + h > page->texture->h) {
+            return -1;
+        }
+        remaining -= node->w;
+        ++node;
+    }
+    return y;
+}
+
+/* Place a w x h rectangle as low as possible on the skyline */
+static SDL_bool
+AllocAtlasRect(SDL_AtlasPage * page, int w, int h, SDL_Rect * rect)
+{
+    SDL_AtlasNode *nodes = page->nodes;
+    int i, y, best = -1;
+    int best_y = 0, best_w = 0;
+    int right;
+
+    for (i = 0; i < page->num_nodes; ++i) {
+        y = FitAtlasNode(page, i, w, h);
+        if (y < 0) {
+            continue;
+        }
+        if (best < 0 || y < best_y || (y == best_y && nodes[i].w < best_w)) {
+            best = i;
+            best_y = y;
+            best_w = nodes[i].w;
+        }
+    }
+    if (best < 0) {
+        return SDL_FALSE;
+    }
+
+    rect->x = nodes[best].x;
+    rect->y = best_y;
+    rect->w = w;
+    rect->h = h;
+
+    /* Raise the skyline over the new rectangle */
+    SDL_memmove(&nodes[best + 1], &nodes[best],
+                (page->num_nodes - best) * sizeof(*nodes));
+    ++page->num_nodes;
+    nodes[best].y = best_y + h;
+    nodes[best].w = w;
+    right = rect->x + w;
+    for (i = best + 1; i < page->num_nodes && nodes[i].x < right; ) {
+        if (nodes[i].x + nodes[i].w <= right) {
+            SDL_memmove(&nodes[i], &nodes[i + 1],
+                        (page->num_nodes - i - 1) * sizeof(*nodes));
+            --page->num_nodes;
+        } else {
+            nodes[i].w -= right - nodes[i].x;
+            nodes[i].x = right;
+            break;
+        }
+    }
+
+    /* Merge neighbours at the same height */
+    for (i = 0; i < page->num_nodes - 1; ) {
+        if (nodes[i].y == nodes[i + 1].y) {
+            nodes[i].w += nodes[i + 1].w;
+            SDL_memmove(&nodes[i + 1], &nodes[i + 2],
+                        (page->num_nodes - i - 2) * sizeof(*nodes));
+            --page->num_nodes;
+        } else {
+            ++i;
+        }
+    }
+    return SDL_TRUE;
+}
+
+static SDL_AtlasPage *
+CreateAtlasPage(SDL_Renderer * renderer, Uint32 format, int scale_quality)
+{
+    SDL_AtlasPage *page;
+    SDL_Texture *texture;
+    int w = ATLAS_PAGE_SIZE;
+    int h = ATLAS_PAGE_SIZE;
+
+    if (renderer->info.max_texture_width) {
+        w = SDL_min(w, renderer->info.max_texture_width);
+    }
+    if (renderer->info.max_texture_height) {
+        h = SDL_min(h, renderer->info.max_texture_height);
+    }
+
+    page = (SDL_AtlasPage *) SDL_calloc(1, sizeof(*page));
+    texture = (SDL_Texture *) SDL_calloc(1, sizeof(*texture));
+    if (page) {
+        /* There's never more than one node per column */
+        page->nodes = (SDL_AtlasNode *) SDL_malloc((w + 1) * sizeof(*page->nodes));
+    }
+    if (!page || !texture || !page->nodes) {
+        if (page) {
+            SDL_free(page->nodes);
+        }
+        SDL_free(page);
+        SDL_free(texture);
+        SDL_OutOfMemory();
+        return NULL;
+    }
+
+    /* The page isn't in the renderer's list of textures, it goes away
+       along with the last texture packed into it */
+    texture->magic = &texture_magic;
+    texture->format = format;
+    texture->access = SDL_TEXTUREACCESS_STATIC;
+    texture->w = w;
+    texture->h = h;
+    texture->r = 255;
+    texture->g = 255;
+    texture->b = 255;
+    texture->a = 255;
+    texture->renderer = renderer;
+    if (renderer->CreateTexture(renderer, texture) < 0) {
+        SDL_free(page->nodes);
+        SDL_free(page);
+        SDL_free(texture);
+        return NULL;
+    }
+
+    page->texture = texture;
+    page->scale_quality = scale_quality;
+    page->nodes[0].x = 0;
+    page->nodes[0].y = 0;
+    page->nodes[0].w = w;
+    page->num_nodes = 1;
+    page->next = renderer->atlas_pages;
+    renderer->atlas_pages = page;
+    return page;
+}
+
+/* Pack a texture into an atlas page, if it's small enough to be worth it */
+static SDL_bool
+AddTextureToAtlas(SDL_Renderer * renderer, SDL_Texture * texture)
+{
+    const int scale_quality = GetScaleQuality();
+    const int w = texture->w + 2 * ATLAS_PADDING;
+    const int h = texture->h + 2 * ATLAS_PADDING;
+    SDL_AtlasPage *page;
+    SDL_Rect rect;
+
+    if (!renderer->atlas_enabled ||
+        texture->access != SDL_TEXTUREACCESS_STATIC ||
+        texture->w > ATLAS_MAX_SIZE || texture->h > ATLAS_MAX_SIZE ||
+        SDL_ISPIXELFORMAT_FOURCC(texture->format)) {
+        return SDL_FALSE;
+    }
+
+    for (page = renderer->atlas_pages; page; page = page->next) {
+        if (page->texture->format == texture->format &&
+            page->scale_quality == scale_quality &&
+            AllocAtlasRect(page, w, h, &rect)) {
+            break;
+        }
+    }
+    if (!page) {
+        page = CreateAtlasPage(renderer, texture->format, scale_quality);
+        if (!page || !AllocAtlasRect(page, w, h, &rect)) {
+            return SDL_FALSE;
+        }
+    }
+
+    ++page->num_textures;
+    texture->atlas = page;
+    texture->atlas_rect.x = rect.x + ATLAS_PADDING;
+    texture->atlas_rect.y = rect.y + ATLAS_PADDING;
+    texture->atlas_rect.w = texture->w;
+    texture->atlas_rect.h = texture->h;
+    return SDL_TRUE;
+}
+
+/* Space is only reclaimed when everything in a page has been destroyed */
+static void
+RemoveTextureFromAtlas(SDL_Renderer * renderer, SDL_Texture * texture)
+{
+    SDL_AtlasPage *page = texture->atlas;
+    SDL_AtlasPage **prev;
+
+    texture->atlas = NULL;
+    if (--page->num_textures > 0) {
+        return;
+    }
+
+    FlushRenderQueueTexture(renderer, page->texture);
+    for (prev = &renderer->atlas_pages; *prev != page; prev = &(*prev)->next) {
+        continue;
+    }
+    *prev = page->next;
+
+    page->texture->magic = NULL;
+    renderer->DestroyTexture(renderer, page->texture);
+    SDL_free(page->texture);
+    SDL_free(page->nodes);
+    SDL_free(page);
+}
+
+/* Get the page to draw a packed texture from, with the texture's color
+   and alpha modulation and blend mode */
+static SDL_Texture *
+GetAtlasTexture(SDL_Renderer * renderer, SDL_Texture * texture, SDL_Rect * srcrect)
+{
+    SDL_Texture *page = texture->atlas->texture;
+
+    srcrect->x += texture->atlas_rect.x;
+    srcrect->y += texture->atlas_rect.y;
+
+    if (page->r != texture->r || page->g != texture->g ||
+        page->b != texture->b || page->a != texture->a ||
+        page->modMode != texture->modMode ||
+        page->blendMode != texture->blendMode) {
+        if (FlushRenderQueueTexture(renderer, page) < 0) {
+            return NULL;
+        }
+        page->r = texture->r;
+        page->g = texture->g;
+        page->b = texture->b;
+        page->a = texture->a;
+        page->modMode = texture->modMode;
+        page->blendMode = texture->blendMode;
+        if (renderer->SetTextureColorMod &&
+            renderer->SetTextureColorMod(renderer, page) < 0) {
+            return NULL;
+        }
+        if (renderer->SetTextureAlphaMod &&
+            renderer->SetTextureAlphaMod(renderer, page) < 0) {
+            return NULL;
+        }
+        if (renderer->SetTextureBlendMode &&
+            renderer->SetTextureBlendMode(renderer, page) < 0) {
+            return NULL;
+        }
+    }
+    return page;
+}
+
 SDL_Texture *
 SDL_CreateTexture(SDL_Renderer * renderer, Uint32 format, int access, int w, int h)
 {
@@ -443,6 +903,9 @@ SDL_CreateTexture(SDL_Renderer * renderer, Uint32 format, int access, int w, int
     renderer->textures = texture;
 
     if (IsSupportedFormat(renderer, format)) {
+        if (AddTextureToAtlas(renderer, texture)) {
+            return texture;
+        }
         if (renderer->CreateTexture(renderer, texture) < 0) {
             SDL_DestroyTexture(texture);
             return 0;
@@ -601,6 +1064,9 @@ SDL_SetTextureColorMod(SDL_Texture * texture, Uint8 r, Uint8 g, Uint8 b)
     CHECK_TEXTURE_MAGIC(texture, -1);
 
     renderer = texture->renderer;
+    if (FlushRenderQueueTexture(renderer, texture) < 0) {
+        return -1;
+    }
     if (r < 255 || g < 255 || b < 255) {
         texture->modMode |= SDL_TEXTUREMODULATE_COLOR;
     } else {
@@ -611,6 +1077,9 @@ SDL_SetTextureColorMod(SDL_Texture * texture, Uint8 r, Uint8 g, Uint8 b)
     texture->b = b;
     if (texture->native) {
         return SDL_SetTextureColorMod(texture->native, r, g, b);
+    } else if (texture->atlas) {
+        /* This is applied to the atlas page when the texture is drawn */
+        return 0;
     } else if (renderer->SetTextureColorMod) {
         return renderer->SetTextureColorMod(renderer, texture);
     } else {
@@ -644,6 +1113,9 @@ SDL_SetTextureAlphaMod(SDL_Texture * texture, Uint8 alpha)
     CHECK_TEXTURE_MAGIC(texture, -1);
 
     renderer = texture->renderer;
+    if (FlushRenderQueueTexture(renderer, texture) < 0) {
+        return -1;
+    }
     if (alpha < 255) {
         texture->modMode |= SDL_TEXTUREMODULATE_ALPHA;
     } else {
@@ -652,6 +1124,9 @@ SDL_SetTextureAlphaMod(SDL_Texture * texture, Uint8 alpha)
     texture->a = alpha;
     if (texture->native) {
         return SDL_SetTextureAlphaMod(texture->native, alpha);
+    } else if (texture->atlas) {
+        /* This is applied to the atlas page when the texture is drawn */
+        return 0;
     } else if (renderer->SetTextureAlphaMod) {
         return renderer->SetTextureAlphaMod(renderer, texture);
     } else {
@@ -678,9 +1153,15 @@ SDL_SetTextureBlendMode(SDL_Texture * texture, SDL_BlendMode blendMode)
     CHECK_TEXTURE_MAGIC(texture, -1);
 
     renderer = texture->renderer;
+    if (FlushRenderQueueTexture(renderer, texture) < 0) {
+        return -1;
+    }
     texture->blendMode = blendMode;
     if (texture->native) {
         return SDL_SetTextureBlendMode(texture->native, blendMode);
+    } else if (texture->atlas) {
+        /* This is applied to the atlas page when the texture is drawn */
+        return 0;
     } else if (renderer->SetTextureBlendMode) {
         return renderer->SetTextureBlendMode(renderer, texture);
     } else {
@@ -745,6 +1226,71 @@ SDL_UpdateTextureYUV(SDL_Texture * texture, const SDL_Rect * rect,
     return 0;
 }
 
+/* Update a packed texture, and the copy of its edges around it */
+static int
+SDL_UpdateTextureAtlas(SDL_Texture * texture, const SDL_Rect * rect,
+                       const void *pixels, int pitch)
+{
+    SDL_Renderer *renderer = texture->renderer;
+    SDL_Texture *page = texture->atlas->texture;
+    const int bpp = SDL_BYTESPERPIXEL(texture->format);
+    const Uint8 *src = (const Uint8 *) pixels;
+    const Uint8 *last_row = src + (rect->h - 1) * pitch;
+    const Uint8 *last_col = src + (rect->w - 1) * bpp;
+    const SDL_bool left = (rect->x == 0);
+    const SDL_bool top = (rect->y == 0);
+    const SDL_bool right = (rect->x + rect->w == texture->w);
+    const SDL_bool bottom = (rect->y + rect->h == texture->h);
+    SDL_Rect edges[9];
+    const Uint8 *sources[9];
+    int i, num_edges = 0;
+
+    if (FlushRenderQueueTexture(renderer, page) < 0) {
+        return -1;
+    }
+
+#define ADD_EDGE(X, Y, W, H, SRC) \
+    edges[num_edges].x = texture->atlas_rect.x + (X); \
+    edges[num_edges].y = texture->atlas_rect.y + (Y); \
+    edges[num_edges].w = (W); \
+    edges[num_edges].h = (H); \
+    sources[num_edges++] = (SRC)
+
+    ADD_EDGE(rect->x, rect->y, rect->w, rect->h, src);
+    if (left) {
+        ADD_EDGE(-1, rect->y, 1, rect->h, src);
+    }
+    if (right) {
+        ADD_EDGE(texture->w, rect->y, 1, rect->h, last_col);
+    }
+    if (top) {
+        ADD_EDGE(rect->x, -1, rect->w, 1, src);
+        if (left) {
+            ADD_EDGE(-1, -1, 1, 1, src);
+        }
+        if (right) {
+            ADD_EDGE(texture->w, -1, 1, 1, last_col);
+        }
+    }
+    if (bottom) {
+        ADD_EDGE(rect->x, texture->h, rect->w, 1, last_row);
+        if (left) {
+            ADD_EDGE(-1, texture->h, 1, 1, last_row);
+        }
+        if (right) {
+            ADD_EDGE(texture->w, texture->h, 1, 1, last_row + (rect->w - 1) * bpp);
+        }
+    }
+#undef ADD_EDGE
+
+    for (i = 0; i < num_edges; ++i) {
+        if (renderer->UpdateTexture(renderer, page, &edges[i], sources[i], pitch) < 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
 static int
 SDL_UpdateTextureNative(SDL_Texture * texture, const SDL_Rect * rect,
                         const void *pixels, int pitch)
@@ -810,8 +1356,13 @@ SDL_UpdateTexture(SDL_Texture * texture, const SDL_Rect * rect,
         return SDL_UpdateTextureYUV(texture, rect, pixels, pitch);
     } else if (texture->native) {
         return SDL_UpdateTextureNative(texture, rect, pixels, pitch);
+    } else if (texture->atlas) {
+        return SDL_UpdateTextureAtlas(texture, rect, pixels, pitch);
     } else {
         renderer = texture->renderer;
+        if (FlushRenderQueueTexture(renderer, texture) < 0) {
+            return -1;
+        }
         return renderer->UpdateTexture(renderer, texture, rect, pixels, pitch);
     }
 }
@@ -912,6 +1463,9 @@ int SDL_UpdateYUVTexture(SDL_Texture * texture, const SDL_Rect * rect,
         SDL_assert(!texture->native);
         renderer = texture->renderer;
         SDL_assert(renderer->UpdateTextureYUV);
+        if (FlushRenderQueueTexture(renderer, texture) < 0) {
+            return -1;
+        }
 		if (renderer->UpdateTextureYUV) {
 			return renderer->UpdateTextureYUV(renderer, texture, rect, Yplane, Ypitch, Uplane, Upitch, Vplane, Vpitch);
 		} else {
@@ -966,6 +1520,9 @@ SDL_LockTexture(SDL_Texture * texture, const SDL_Rect * rect,
         return SDL_LockTextureNative(texture, rect, pixels, pitch);
     } else {
         renderer = texture->renderer;
+        if (FlushRenderQueueTexture(renderer, texture) < 0) {
+            return -1;
+        }
         return renderer->LockTexture(renderer, texture, rect, pixels, pitch);
     }
 }
@@ -1051,6 +1608,9 @@ SDL_SetRenderTarget(SDL_Renderer *renderer, SDL_Texture *texture)
         /* Nothing to do! */
         return 0;
     }
+    if (FlushRenderQueue(renderer) < 0) {
+        return -1;
+    }
 
     /* texture == NULL is valid and means reset the target to the window */
     if (texture) {
@@ -1201,6 +1761,10 @@ SDL_RenderSetViewport(SDL_Renderer * renderer, const SDL_Rect * rect)
 {
     CHECK_RENDERER_MAGIC(renderer, -1);
 
+    if (FlushRenderQueue(renderer) < 0) {
+        return -1;
+    }
+
     if (rect) {
         renderer->viewport.x = (int)SDL_floor(rect->x * renderer->scale.x);
         renderer->viewport.y = (int)SDL_floor(rect->y * renderer->scale.y);
@@ -1234,6 +1798,10 @@ SDL_RenderSetClipRect(SDL_Renderer * renderer, const SDL_Rect * rect)
 {
     CHECK_RENDERER_MAGIC(renderer, -1)
 
+    if (FlushRenderQueue(renderer) < 0) {
+        return -1;
+    }
+
     if (rect) {
         renderer->clipping_enabled = SDL_TRUE;
         renderer->clip_rect.x = (int)SDL_floor(rect->x * renderer->scale.x);
@@ -1296,6 +1864,15 @@ SDL_SetRenderDrawColor(SDL_Renderer * renderer,
 {
     CHECK_RENDERER_MAGIC(renderer, -1);
 
+    /* Queued filled rectangles are drawn with the current color */
+    if (renderer->queue.num_fill_runs &&
+        (r != renderer->r || g != renderer->g ||
+         b != renderer->b || a != renderer->a)) {
+        if (FlushRenderQueue(renderer) < 0) {
+            return -1;
+        }
+    }
+
     renderer->r = r;
     renderer->g = g;
     renderer->b = b;
@@ -1329,6 +1906,12 @@ SDL_SetRenderDrawBlendMode(SDL_Renderer * renderer, SDL_BlendMode blendMode)
 {
     CHECK_RENDERER_MAGIC(renderer, -1);
 
+    if (renderer->queue.num_fill_runs && blendMode != renderer->blendMode) {
+        if (FlushRenderQueue(renderer) < 0) {
+            return -1;
+        }
+    }
+
     renderer->blendMode = blendMode;
     return 0;
 }
@@ -1351,6 +1934,9 @@ SDL_RenderClear(SDL_Renderer * renderer)
     if (renderer->hidden) {
         return 0;
     }
+    if (FlushRenderQueue(renderer) < 0) {
+        return -1;
+    }
     return renderer->RenderClear(renderer);
 }
 
@@ -1410,6 +1996,9 @@ SDL_RenderDrawPoints(SDL_Renderer * renderer,
     if (renderer->hidden) {
         return 0;
     }
+    if (FlushRenderQueue(renderer) < 0) {
+        return -1;
+    }
 
     if (renderer->scale.x != 1.0f || renderer->scale.y != 1.0f) {
         return RenderDrawPointsWithRects(renderer, points, count);
@@ -1519,6 +2108,9 @@ SDL_RenderDrawLines(SDL_Renderer * renderer,
     if (renderer->hidden) {
         return 0;
     }
+    if (FlushRenderQueue(renderer) < 0) {
+        return -1;
+    }
 
     if (renderer->scale.x != 1.0f || renderer->scale.y != 1.0f) {
         return RenderDrawLinesWithRects(renderer, points, count);
@@ -1645,7 +2237,14 @@ SDL_RenderFillRects(SDL_Renderer * renderer,
         frects[i].h = rects[i].h * renderer->scale.y;
     }
 
-    status = renderer->RenderFillRects(renderer, frects, count);
+    if (renderer->queue.enabled) {
+        status = 0;
+        for (i = 0; i < count && status == 0; ++i) {
+            status = QueueRenderDraw(renderer, NULL, NULL, &frects[i]);
+        }
+    } else {
+        status = renderer->RenderFillRects(renderer, frects, count);
+    }
 
     SDL_stack_free(frects);
 
@@ -1696,11 +2295,21 @@ SDL_RenderCopy(SDL_Renderer * renderer, SDL_Texture * texture,
         return 0;
     }
 
+    if (texture->atlas) {
+        texture = GetAtlasTexture(renderer, texture, &real_srcrect);
+        if (!texture) {
+            return -1;
+        }
+    }
+
     frect.x = real_dstrect.x * renderer->scale.x;
     frect.y = real_dstrect.y * renderer->scale.y;
     frect.w = real_dstrect.w * renderer->scale.x;
     frect.h = real_dstrect.h * renderer->scale.y;
 
+    if (renderer->queue.enabled) {
+        return QueueRenderDraw(renderer, texture, &real_srcrect, &frect);
+    }
     return renderer->RenderCopy(renderer, texture, &real_srcrect, &frect);
 }
 
@@ -1749,6 +2358,17 @@ SDL_RenderCopyEx(SDL_Renderer * renderer, SDL_Texture * texture,
         texture = texture->native;
     }
 
+    if (FlushRenderQueue(renderer) < 0) {
+        return -1;
+    }
+
+    if (texture->atlas) {
+        texture = GetAtlasTexture(renderer, texture, &real_srcrect);
+        if (!texture) {
+            return -1;
+        }
+    }
+
     if(center) real_center = *center;
     else {
         real_center.x = real_dstrect.w/2;
@@ -1777,6 +2397,9 @@ SDL_RenderReadPixels(SDL_Renderer * renderer, const SDL_Rect * rect,
     if (!renderer->RenderReadPixels) {
         return SDL_Unsupported();
     }
+    if (FlushRenderQueue(renderer) < 0) {
+        return -1;
+    }
 
     if (!format) {
         format = SDL_GetWindowPixelFormat(renderer->window);
@@ -1803,11 +2426,21 @@ SDL_RenderReadPixels(SDL_Renderer * renderer, const SDL_Rect * rect,
                                       format, pixels, pitch);
 }
 
+int
+SDL_RenderFlush(SDL_Renderer * renderer)
+{
+    CHECK_RENDERER_MAGIC(renderer, -1);
+
+    return FlushRenderQueue(renderer);
+}
+
 void
 SDL_RenderPresent(SDL_Renderer * renderer)
 {
     CHECK_RENDERER_MAGIC(renderer, );
 
+    FlushRenderQueue(renderer);
+
     /* Don't draw while we're hidden */
     if (renderer->hidden) {
         return;
@@ -1826,6 +2459,7 @@ SDL_DestroyTexture(SDL_Texture * texture)
     if (texture == renderer->target) {
         SDL_SetRenderTarget(renderer, NULL);
     }
+    FlushRenderQueueTexture(renderer, texture);
 
     texture->magic = NULL;
 
@@ -1846,7 +2480,11 @@ SDL_DestroyTexture(SDL_Texture * texture)
     }
     SDL_free(texture->pixels);
 
-    renderer->DestroyTexture(renderer, texture);
+    if (texture->atlas) {
+        RemoveTextureFromAtlas(renderer, texture);
+    } else {
+        renderer->DestroyTexture(renderer, texture);
+    }
     SDL_free(texture);
 }
 
@@ -1857,6 +2495,13 @@ SDL_DestroyRenderer(SDL_Renderer * renderer)
 
     SDL_DelEventWatch(SDL_RendererEventWatch, renderer);
 
+    /* Anything still queued is discarded, along with the queue */
+    renderer->queue.count = 0;
+    renderer->queue.num_runs = 0;
+    renderer->queue.num_fill_runs = 0;
+    SDL_free(renderer->queue.run);
+    renderer->queue.run = NULL;
+
     /* Free existing textures for this renderer */
     while (renderer->textures) {
         SDL_DestroyTexture(renderer->textures);
@@ -1881,7 +2526,13 @@ int SDL_GL_BindTexture(SDL_Texture *texture, float *texw, float *texh)
     renderer = texture->renderer;
     if (texture->native) {
         return SDL_GL_BindTexture(texture->native, texw, texh);
+    } else if (texture->atlas) {
+        return SDL_SetError("Texture is packed into an atlas");
     } else if (renderer && renderer->GL_BindTexture) {
+        /* The application is about to draw with OpenGL itself */
+        if (FlushRenderQueue(renderer) < 0) {
+            return -1;
+        }
         return renderer->GL_BindTexture(renderer, texture, texw, texh);
     } else {
         return SDL_Unsupported();
@@ -1896,6 +2547,8 @@ int SDL_GL_UnbindTexture(SDL_Texture *texture)
     renderer = texture->renderer;
     if (texture->native) {
         return SDL_GL_UnbindTexture(texture->native);
+    } else if (texture->atlas) {
+        return SDL_SetError("Texture is packed into an atlas");
     } else if (renderer && renderer->GL_UnbindTexture) {
         return renderer->GL_UnbindTexture(renderer, texture);
     }
@@ -45,6 +45,54 @@ typedef struct
     float h;
 } SDL_FRect;
 
+/* The most draws that can be queued before the queue is flushed */
+#define SDL_RENDER_QUEUE_SIZE   2048
+
+/* The most runs of draws sharing a texture that can be queued */
+#define SDL_RENDER_QUEUE_RUNS   256
+
+/* A run of queued draws that can be submitted to the driver in one call */
+typedef struct
+{
+    SDL_Texture *texture;       /**< The texture, or NULL for filled rectangles */
+    float minx, miny;           /**< The area covered by the draws in the run */
+    float maxx, maxy;
+    int count;                  /**< The number of draws in the run */
+} SDL_RenderRun;
+
+/* Copies and filled rectangles waiting to be submitted to the driver */
+typedef struct
+{
+    SDL_bool enabled;
+    int count;
+    int num_runs;
+    int num_fill_runs;
+    SDL_RenderRun runs[SDL_RENDER_QUEUE_RUNS];
+    Uint8 *run;                 /**< The run each draw belongs to */
+    SDL_Rect *srcrects;
+    SDL_FRect *dstrects;
+    SDL_Rect *sorted_srcrects;
+    SDL_FRect *sorted_dstrects;
+} SDL_RenderQueue;
+
+/* A span of the skyline of space used in an atlas page */
+typedef struct
+{
+    int x, y;
+    int w;
+} SDL_AtlasNode;
+
+/* A texture that small static textures are packed into */
+typedef struct SDL_AtlasPage
+{
+    SDL_Texture *texture;
+    int scale_quality;          /**< The scale quality the page was created with */
+    int num_textures;           /**< The number of textures packed into the page */
+    int num_nodes;
+    SDL_AtlasNode *nodes;       /**< The skyline, from left to right */
+    struct SDL_AtlasPage *next;
+} SDL_AtlasPage;
+
 /* Define the SDL texture structure */
 struct SDL_Texture
 {
@@ -66,6 +114,10 @@ struct SDL_Texture
     int pitch;
     SDL_Rect locked_rect;
 
+    /* Support for small textures packed into a shared texture */
+    SDL_AtlasPage *atlas;
+    SDL_Rect atlas_rect;        /**< Where the texture is in the atlas page */
+
     void *driverdata;           /**< Driver specific texture representation */
 
     SDL_Texture *prev;
@@ -112,6 +164,9 @@ struct SDL_Renderer
     int (*RenderCopyEx) (SDL_Renderer * renderer, SDL_Texture * texture,
                        const SDL_Rect * srcquad, const SDL_FRect * dstrect,
                        const double angle, const SDL_FPoint *center, const SDL_RendererFlip flip);
+    int (*RenderCopyBatch) (SDL_Renderer * renderer, SDL_Texture * texture,
+                            const SDL_Rect * srcrects,
+                            const SDL_FRect * dstrects, int count);
     int (*RenderReadPixels) (SDL_Renderer * renderer, const SDL_Rect * rect,
                              Uint32 format, void * pixels, int pitch);
     void (*RenderPresent) (SDL_Renderer * renderer);
@@ -158,6 +213,13 @@ struct SDL_Renderer
     Uint8 r, g, b, a;                   /**< Color for drawing operations values */
     SDL_BlendMode blendMode;            /**< The drawing blend mode */
 
+    /* Draws waiting to be batched, if the driver supports RenderCopyBatch */
+    SDL_RenderQueue queue;
+
+    /* Pages that small static textures are packed into */
+    SDL_bool atlas_enabled;
+    SDL_AtlasPage *atlas_pages;
+
     void *driverdata;
 };
 
@@ -86,8 +86,29 @@
 #include "SDL_video.h"
 #include "SDL_cpuinfo.h"
 #include "SDL_yuv_sw_c.h"
+#include "SDL_hints.h"
 
 
+/* The conversions that SDL_HINT_YUV_CONVERSION_MODE can choose from.
+   Luma has luma_offset taken away and is scaled by luma_scale, and the
+   chroma coefficients are for Cr and Cb centered on zero. */
+typedef struct
+{
+    const char *name;
+    int luma_offset;
+    double luma_scale;
+    double cr_r, cr_g, cb_g, cb_b;
+} SDL_YUVConversion;
+
+static const SDL_YUVConversion SDL_yuv_conversions[] = {
+    /* Full range, as in JPEG, and what this code has always done */
+    { "JPEG", 0, 1.0, 0.419 / 0.299, -0.299 / 0.419, -0.114 / 0.331, 0.587 / 0.331 },
+    /* Video range, for standard definition video */
+    { "BT601", 16, 255.0 / 219.0, 1.596, -0.813, -0.391, 2.018 },
+    /* Video range, for high definition video */
+    { "BT709", 16, 255.0 / 219.0, 1.793, -0.533, -0.213, 2.112 }
+};
+
 /* The colorspace conversion functions */
 
 #if (__GNUC__ > 2) && defined(__i386__) && __OPTIMIZE__ && SDL_ASSEMBLY_ROUTINES
@@ -856,6 +877,300 @@ Color32DitherYUY2Mod2X(int *colortab, Uint32 * rgb_2_pix,
     }
 }
 
+/* Convert one pixel with the tables */
+static SDL_INLINE void
+TableConvertPixel(const int *colortab, const Uint32 * rgb_2_pix, int bpp,
+                  int L, int cr, int cb, Uint8 * out)
+{
+    const Uint32 pixel =
+        rgb_2_pix[L + 0 * 768 + 256 + colortab[cr + 0 * 256]] |
+        rgb_2_pix[L + 1 * 768 + 256 + colortab[cr + 1 * 256] + colortab[cb + 2 * 256]] |
+        rgb_2_pix[L + 2 * 768 + 256 + colortab[cb + 3 * 256]];
+
+    if (bpp == 2) {
+        *(Uint16 *) out = (Uint16) pixel;
+    } else if (bpp == 3) {
+        out[0] = (pixel) & 0xFF;
+        out[1] = (pixel >> 8) & 0xFF;
+        out[2] = (pixel >> 16) & 0xFF;
+    } else {
+        *(Uint32 *) out = pixel;
+    }
+}
+
+/* NV12 and NV21 have the chroma samples interleaved in a second plane, so
+   cr and cb step by two, and each row of them is as wide as a row of luma.
+   There's no 2X version of these; that's done with a stretch instead. */
+static SDL_INLINE void
+ColorDitherNV12Mod1X(int *colortab, Uint32 * rgb_2_pix,
+                     unsigned char *lum, unsigned char *cr,
+                     unsigned char *cb, unsigned char *out,
+                     int rows, int cols, int mod, int bpp)
+{
+    int x, y;
+
+    for (y = 0; y < rows; ++y) {
+        const int chroma = (y / 2) * cols;
+
+        for (x = 0; x < cols; ++x) {
+            TableConvertPixel(colortab, rgb_2_pix, bpp, *lum++,
+                              cr[chroma + (x & ~1)], cb[chroma + (x & ~1)],
+                              out);
+            out += bpp;
+        }
+        out += mod * bpp;
+    }
+}
+
+static void
+Color16DitherNV12Mod1X(int *colortab, Uint32 * rgb_2_pix,
+                       unsigned char *lum, unsigned char *cr,
+                       unsigned char *cb, unsigned char *out,
+                       int rows, int cols, int mod)
+{
+    ColorDitherNV12Mod1X(colortab, rgb_2_pix, lum, cr, cb, out, rows, cols, mod, 2);
+}
+
+static void
+Color24DitherNV12Mod1X(int *colortab, Uint32 * rgb_2_pix,
+                       unsigned char *lum, unsigned char *cr,
+                       unsigned char *cb, unsigned char *out,
+                       int rows, int cols, int mod)
+{
+    ColorDitherNV12Mod1X(colortab, rgb_2_pix, lum, cr, cb, out, rows, cols, mod, 3);
+}
+
+static void
+Color32DitherNV12Mod1X(int *colortab, Uint32 * rgb_2_pix,
+                       unsigned char *lum, unsigned char *cr,
+                       unsigned char *cb, unsigned char *out,
+                       int rows, int cols, int mod)
+{
+    ColorDitherNV12Mod1X(colortab, rgb_2_pix, lum, cr, cb, out, rows, cols, mod, 4);
+}
+
+#ifdef __SSE2__
+/* The conversion and pixel layout, set up once for the whole texture */
+typedef struct
+{
+    __m128i offset, scale;
+    __m128i cr_r, cr_g, cb_g, cb_b;
+    __m128i rloss, gloss, bloss;
+    __m128i rshift, gshift, bshift;
+    __m128i amask;
+} SSE2_YUVConstants;
+
+/* Convert 8 pixels of Y, Cr and Cb, widened to 16 bits, to RGB values
+   clamped to 0..255.  This works out exactly what the tables do. */
+static SDL_INLINE void
+SSE2_ConvertYUV(const SSE2_YUVConstants * k,
+                __m128i y, __m128i cr, __m128i cb,
+                __m128i * r, __m128i * g, __m128i * b)
+{
+    const __m128i c128 = _mm_set1_epi16(128);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i max = _mm_set1_epi16(255);
+    __m128i v;
+
+    /* (c - 128) << 7 times a 1/512th coefficient, >> 16 */
+    cr = _mm_slli_epi16(_mm_sub_epi16(cr, c128), 7);
+    cb = _mm_slli_epi16(_mm_sub_epi16(cb, c128), 7);
+
+    v = _mm_add_epi16(y, _mm_mulhi_epi16(cr, k->cr_r));
+    v = _mm_mulhi_epi16(_mm_slli_epi16(_mm_sub_epi16(v, k->offset), 5), k->scale);
+    *r = _mm_min_epi16(_mm_max_epi16(v, zero), max);
+
+    v = _mm_add_epi16(y, _mm_add_epi16(_mm_mulhi_epi16(cr, k->cr_g),
+                                       _mm_mulhi_epi16(cb, k->cb_g)));
+    v = _mm_mulhi_epi16(_mm_slli_epi16(_mm_sub_epi16(v, k->offset), 5), k->scale);
+    *g = _mm_min_epi16(_mm_max_epi16(v, zero), max);
+
+    v = _mm_add_epi16(y, _mm_mulhi_epi16(cb, k->cb_b));
+    v = _mm_mulhi_epi16(_mm_slli_epi16(_mm_sub_epi16(v, k->offset), 5), k->scale);
+    *b = _mm_min_epi16(_mm_max_epi16(v, zero), max);
+}
+
+/* Pack 8 pixels into the target format and write them out */
+static SDL_INLINE void
+SSE2_StorePixels(const SSE2_YUVConstants * k, int bpp,
+                 __m128i r, __m128i g, __m128i b, Uint8 * out)
+{
+    const __m128i zero = _mm_setzero_si128();
+    __m128i pixels;
+
+    r = _mm_srl_epi16(r, k->rloss);
+    g = _mm_srl_epi16(g, k->gloss);
+    b = _mm_srl_epi16(b, k->bloss);
+    if (bpp == 2) {
+        pixels = _mm_or_si128(k->amask, _mm_sll_epi16(r, k->rshift));
+        pixels = _mm_or_si128(pixels, _mm_sll_epi16(g, k->gshift));
+        pixels = _mm_or_si128(pixels, _mm_sll_epi16(b, k->bshift));
+        _mm_storeu_si128((__m128i *) out, pixels);
+    } else {
+        pixels = _mm_or_si128(k->amask, _mm_sll_epi32(_mm_unpacklo_epi16(r, zero), k->rshift));
+        pixels = _mm_or_si128(pixels, _mm_sll_epi32(_mm_unpacklo_epi16(g, zero), k->gshift));
+        pixels = _mm_or_si128(pixels, _mm_sll_epi32(_mm_unpacklo_epi16(b, zero), k->bshift));
+        _mm_storeu_si128((__m128i *) out, pixels);
+
+        pixels = _mm_or_si128(k->amask, _mm_sll_epi32(_mm_unpackhi_epi16(r, zero), k->rshift));
+        pixels = _mm_or_si128(pixels, _mm_sll_epi32(_mm_unpackhi_epi16(g, zero), k->gshift));
+        pixels = _mm_or_si128(pixels, _mm_sll_epi32(_mm_unpackhi_epi16(b, zero), k->bshift));
+        _mm_storeu_si128((__m128i *) (out + 16), pixels);
+    }
+}
+
+/* Convert the whole texture with SSE2, for 16-bit targets and 32-bit
+   targets with 8 bits per channel.  The output is the same as the C code. */
+static void
+SSE2_DisplayYUV(const SDL_SW_YUVTexture * swdata,
+                const Uint8 * lum, const Uint8 * cr, const Uint8 * cb,
+                Uint8 * out, int pitch)
+{
+    const int bpp = SDL_BYTESPERPIXEL(swdata->target_format);
+    const int cols = swdata->w & ~1;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i lo_bytes = _mm_set1_epi16(0x00FF);
+    const __m128i lo_words = _mm_set1_epi32(0x0000FFFF);
+    SSE2_YUVConstants k;
+    __m128i y, c, u, v, r, g, b;
+    int x, row;
+
+    k.offset = _mm_set1_epi16((short) swdata->luma_offset);
+    k.scale = _mm_set1_epi16((short) swdata->luma_scale);
+    k.cr_r = _mm_set1_epi16((short) swdata->cr_r);
+    k.cr_g = _mm_set1_epi16((short) swdata->cr_g);
+    k.cb_g = _mm_set1_epi16((short) swdata->cb_g);
+    k.cb_b = _mm_set1_epi16((short) swdata->cb_b);
+    k.rloss = _mm_cvtsi32_si128(swdata->rloss);
+    k.gloss = _mm_cvtsi32_si128(swdata->gloss);
+    k.bloss = _mm_cvtsi32_si128(swdata->bloss);
+    k.rshift = _mm_cvtsi32_si128(swdata->rshift);
+    k.gshift = _mm_cvtsi32_si128(swdata->gshift);
+    k.bshift = _mm_cvtsi32_si128(swdata->bshift);
+    if (bpp == 2) {
+        k.amask = _mm_set1_epi16((short) swdata->Amask);
+    } else {
+        k.amask = _mm_set1_epi32((int) swdata->Amask);
+    }
+
+    switch (swdata->format) {
+    case SDL_PIXELFORMAT_YV12:
+    case SDL_PIXELFORMAT_IYUV:
+        for (row = 0; row < swdata->h; ++row) {
+            const Uint8 *L = lum + row * swdata->w;
+            const Uint8 *Cr = cr + (row / 2) * (swdata->w / 2);
+            const Uint8 *Cb = cb + (row / 2) * (swdata->w / 2);
+            Uint8 *dst = out + row * pitch;
+
+            for (x = 0; x + 16 <= cols; x += 16) {
+                const __m128i Y = _mm_loadu_si128((const __m128i *) (L + x));
+                const __m128i CR = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *) (Cr + x / 2)), zero);
+                const __m128i CB = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *) (Cb + x / 2)), zero);
+
+                SSE2_ConvertYUV(&k, _mm_unpacklo_epi8(Y, zero),
+                                _mm_unpacklo_epi16(CR, CR),
+                                _mm_unpacklo_epi16(CB, CB), &r, &g, &b);
+                SSE2_StorePixels(&k, bpp, r, g, b, dst + x * bpp);
+                SSE2_ConvertYUV(&k, _mm_unpackhi_epi8(Y, zero),
+                                _mm_unpackhi_epi16(CR, CR),
+                                _mm_unpackhi_epi16(CB, CB), &r, &g, &b);
+                SSE2_StorePixels(&k, bpp, r, g, b, dst + (x + 8) * bpp);
+            }
+            for (; x < cols; ++x) {
+                TableConvertPixel(swdata->colortab, swdata->rgb_2_pix, bpp,
+                                  L[x], Cr[x / 2], Cb[x / 2], dst + x * bpp);
+            }
+        }
+        break;
+    case SDL_PIXELFORMAT_YUY2:
+    case SDL_PIXELFORMAT_UYVY:
+    case SDL_PIXELFORMAT_YVYU:
+        {
+            /* Luma is in the odd bytes for UYVY, and Cb comes first
+               in each pair of chroma samples except for YVYU */
+            const int odd = (swdata->format == SDL_PIXELFORMAT_UYVY);
+            const int cb_first = (cb < cr);
+
+            for (row = 0; row < swdata->h; ++row) {
+                const Uint8 *src = swdata->planes[0] + row * swdata->pitches[0];
+                Uint8 *dst = out + row * pitch;
+
+                for (x = 0; x + 8 <= cols; x += 8) {
+                    const __m128i pixels = _mm_loadu_si128((const __m128i *) (src + x * 2));
+
+                    if (odd) {
+                        y = _mm_srli_epi16(pixels, 8);
+                        c = _mm_and_si128(pixels, lo_bytes);
+                    } else {
+                        y = _mm_and_si128(pixels, lo_bytes);
+                        c = _mm_srli_epi16(pixels, 8);
+                    }
+                    /* Give each pixel of a pair its chroma samples */
+                    u = _mm_and_si128(c, lo_words);
+                    u = _mm_or_si128(u, _mm_slli_epi32(u, 16));
+                    v = _mm_srli_epi32(c, 16);
+                    v = _mm_or_si128(v, _mm_slli_epi32(v, 16));
+                    if (cb_first) {
+                        SSE2_ConvertYUV(&k, y, v, u, &r, &g, &b);
+                    } else {
+                        SSE2_ConvertYUV(&k, y, u, v, &r, &g, &b);
+                    }
+                    SSE2_StorePixels(&k, bpp, r, g, b, dst + x * bpp);
+                }
+                for (; x < cols; ++x) {
+                    const int pair = (x / 2) * 4;
+                    TableConvertPixel(swdata->colortab, swdata->rgb_2_pix, bpp, src[x * 2 + odd],
+                                      cr[row * swdata->pitches[0] + pair],
+                                      cb[row * swdata->pitches[0] + pair],
+                                      dst + x * bpp);
+                }
+            }
+        }
+        break;
+    case SDL_PIXELFORMAT_NV12:
+    case SDL_PIXELFORMAT_NV21:
+        {
+            /* Cb comes first in each pair of chroma samples for NV12 */
+            const int cb_first = (cb < cr);
+
+            for (row = 0; row < swdata->h; ++row) {
+                const Uint8 *L = lum + row * swdata->w;
+                const int chroma = (row / 2) * swdata->pitches[1];
+                Uint8 *dst = out + row * pitch;
+
+                for (x = 0; x + 16 <= cols; x += 16) {
+                    const __m128i Y = _mm_loadu_si128((const __m128i *) (L + x));
+                    const __m128i C = _mm_loadu_si128((const __m128i *) (swdata->planes[1] + chroma + x));
+
+                    /* Give each pixel of a pair its chroma samples */
+                    u = _mm_and_si128(C, lo_bytes);
+                    v = _mm_srli_epi16(C, 8);
+                    if (cb_first) {
+                        c = u;
+                        u = v;
+                        v = c;
+                    }
+                    SSE2_ConvertYUV(&k, _mm_unpacklo_epi8(Y, zero),
+                                    _mm_unpacklo_epi16(u, u),
+                                    _mm_unpacklo_epi16(v, v), &r, &g, &b);
+                    SSE2_StorePixels(&k, bpp, r, g, b, dst + x * bpp);
+                    SSE2_ConvertYUV(&k, _mm_unpackhi_epi8(Y, zero),
+                                    _mm_unpackhi_epi16(u, u),
+                                    _mm_unpackhi_epi16(v, v), &r, &g, &b);
+                    SSE2_StorePixels(&k, bpp, r, g, b, dst + (x + 8) * bpp);
+                }
+                for (; x < cols; ++x) {
+                    TableConvertPixel(swdata->colortab, swdata->rgb_2_pix, bpp,
+                                      L[x], cr[chroma + (x & ~1)],
+                                      cb[chroma + (x & ~1)], dst + x * bpp);
+                }
+            }
+        }
+        break;
+    }
+}
+#endif /* __SSE2__ */
+
 /*
  * How many 1 bits are there in the Uint32.
  * Low performance, do not call often.
@@ -906,18 +1221,23 @@ SDL_SW_SetupYUVDisplay(SDL_SW_YUVTexture * swdata, Uint32 target_format)
     b_2_pix_alloc = &swdata->rgb_2_pix[2 * 768];
 
     /*
-     * Set up entries 0-255 in rgb-to-pixel value tables.
+     * Set up the rgb-to-pixel value tables.  Entries 256-511 are for the
+     * values 0-255 before luma scaling, and the rest cover how far the
+     * chroma can push them either side, so we do not need to check for
+     * overflow.
      */
-    for (i = 0; i < 256; ++i) {
-        r_2_pix_alloc[i + 256] = i >> (8 - number_of_bits_set(Rmask));
-        r_2_pix_alloc[i + 256] <<= free_bits_at_bottom(Rmask);
-        r_2_pix_alloc[i + 256] |= Amask;
-        g_2_pix_alloc[i + 256] = i >> (8 - number_of_bits_set(Gmask));
-        g_2_pix_alloc[i + 256] <<= free_bits_at_bottom(Gmask);
-        g_2_pix_alloc[i + 256] |= Amask;
-        b_2_pix_alloc[i + 256] = i >> (8 - number_of_bits_set(Bmask));
-        b_2_pix_alloc[i + 256] <<= free_bits_at_bottom(Bmask);
-        b_2_pix_alloc[i + 256] |= Amask;
+    for (i = 0; i < 768; ++i) {
+        int v = ((i - 256 - swdata->luma_offset) * swdata->luma_scale) >> 11;
+        v = SDL_max(0, SDL_min(v, 255));
+        r_2_pix_alloc[i] = v >> (8 - number_of_bits_set(Rmask));
+        r_2_pix_alloc[i] <<= free_bits_at_bottom(Rmask);
+        r_2_pix_alloc[i] |= Amask;
+        g_2_pix_alloc[i] = v >> (8 - number_of_bits_set(Gmask));
+        g_2_pix_alloc[i] <<= free_bits_at_bottom(Gmask);
+        g_2_pix_alloc[i] |= Amask;
+        b_2_pix_alloc[i] = v >> (8 - number_of_bits_set(Bmask));
+        b_2_pix_alloc[i] <<= free_bits_at_bottom(Bmask);
+        b_2_pix_alloc[i] |= Amask;
     }
 
     /*
@@ -928,25 +1248,31 @@ SDL_SW_SetupYUVDisplay(SDL_SW_YUVTexture * swdata, Uint32 target_format)
      * through a short pointer will lose the top bits anyway.
      */
     if (SDL_BYTESPERPIXEL(target_format) == 2) {
-        for (i = 0; i < 256; ++i) {
-            r_2_pix_alloc[i + 256] |= (r_2_pix_alloc[i + 256]) << 16;
-            g_2_pix_alloc[i + 256] |= (g_2_pix_alloc[i + 256]) << 16;
-            b_2_pix_alloc[i + 256] |= (b_2_pix_alloc[i + 256]) << 16;
+        for (i = 0; i < 768; ++i) {
+            r_2_pix_alloc[i] |= (r_2_pix_alloc[i]) << 16;
+            g_2_pix_alloc[i] |= (g_2_pix_alloc[i]) << 16;
+            b_2_pix_alloc[i] |= (b_2_pix_alloc[i]) << 16;
         }
     }
 
-    /*
-     * Spread out the values we have to the rest of the array so that
-     * we do not need to check for overflow.
-     */
-    for (i = 0; i < 256; ++i) {
-        r_2_pix_alloc[i] = r_2_pix_alloc[256];
-        r_2_pix_alloc[i + 512] = r_2_pix_alloc[511];
-        g_2_pix_alloc[i] = g_2_pix_alloc[256];
-        g_2_pix_alloc[i + 512] = g_2_pix_alloc[511];
-        b_2_pix_alloc[i] = b_2_pix_alloc[256];
-        b_2_pix_alloc[i + 512] = b_2_pix_alloc[511];
+    /* The SIMD code needs whole channels of at most 8 bits */
+    swdata->rloss = 8 - number_of_bits_set(Rmask);
+    swdata->gloss = 8 - number_of_bits_set(Gmask);
+    swdata->bloss = 8 - number_of_bits_set(Bmask);
+    swdata->rshift = free_bits_at_bottom(Rmask);
+    swdata->gshift = free_bits_at_bottom(Gmask);
+    swdata->bshift = free_bits_at_bottom(Bmask);
+    swdata->Amask = Amask;
+    swdata->simd = SDL_FALSE;
+#ifdef __SSE2__
+    if (SDL_HasSSE2() &&
+        (swdata->rloss >= 0 && swdata->gloss >= 0 && swdata->bloss >= 0) &&
+        ((SDL_BYTESPERPIXEL(target_format) == 2) ||
+         (SDL_BYTESPERPIXEL(target_format) == 4 &&
+          swdata->rloss == 0 && swdata->gloss == 0 && swdata->bloss == 0))) {
+        swdata->simd = SDL_TRUE;
     }
+#endif
 
     /* You have chosen wisely... */
     switch (swdata->format) {
@@ -955,7 +1281,7 @@ SDL_SW_SetupYUVDisplay(SDL_SW_YUVTexture * swdata, Uint32 target_format)
         if (SDL_BYTESPERPIXEL(target_format) == 2) {
 #if (__GNUC__ > 2) && defined(__i386__) && __OPTIMIZE__ && SDL_ASSEMBLY_ROUTINES
             /* inline assembly functions */
-            if (SDL_HasMMX() && (Rmask == 0xF800) &&
+            if (SDL_HasMMX() && swdata->conversion == 0 && (Rmask == 0xF800) &&
                 (Gmask == 0x07E0) && (Bmask == 0x001F)
                 && (swdata->w & 15) == 0) {
 /* printf("Using MMX 16-bit 565 dither\n"); */
@@ -976,7 +1302,7 @@ SDL_SW_SetupYUVDisplay(SDL_SW_YUVTexture * swdata, Uint32 target_format)
         if (SDL_BYTESPERPIXEL(target_format) == 4) {
 #if (__GNUC__ > 2) && defined(__i386__) && __OPTIMIZE__ && SDL_ASSEMBLY_ROUTINES
             /* inline assembly functions */
-            if (SDL_HasMMX() && (Rmask == 0x00FF0000) &&
+            if (SDL_HasMMX() && swdata->conversion == 0 && (Rmask == 0x00FF0000) &&
                 (Gmask == 0x0000FF00) &&
                 (Bmask == 0x000000FF) && (swdata->w & 15) == 0) {
 /* printf("Using MMX 32-bit dither\n"); */
@@ -991,6 +1317,19 @@ SDL_SW_SetupYUVDisplay(SDL_SW_YUVTexture * swdata, Uint32 target_format)
             swdata->Display2X = Color32DitherYV12Mod2X;
         }
         break;
+    case SDL_PIXELFORMAT_NV12:
+    case SDL_PIXELFORMAT_NV21:
+        if (SDL_BYTESPERPIXEL(target_format) == 2) {
+            swdata->Display1X = Color16DitherNV12Mod1X;
+        }
+        if (SDL_BYTESPERPIXEL(target_format) == 3) {
+            swdata->Display1X = Color24DitherNV12Mod1X;
+        }
+        if (SDL_BYTESPERPIXEL(target_format) == 4) {
+            swdata->Display1X = Color32DitherNV12Mod1X;
+        }
+        swdata->Display2X = NULL;
+        break;
     case SDL_PIXELFORMAT_YUY2:
     case SDL_PIXELFORMAT_UYVY:
     case SDL_PIXELFORMAT_YVYU:
@@ -1021,6 +1360,8 @@ SDL_SW_YUVTexture *
 SDL_SW_CreateYUVTexture(Uint32 format, int w, int h)
 {
     SDL_SW_YUVTexture *swdata;
+    const SDL_YUVConversion *conversion;
+    const char *hint;
     int *Cr_r_tab;
     int *Cr_g_tab;
     int *Cb_g_tab;
@@ -1034,6 +1375,8 @@ SDL_SW_CreateYUVTexture(Uint32 format, int w, int h)
     case SDL_PIXELFORMAT_YUY2:
     case SDL_PIXELFORMAT_UYVY:
     case SDL_PIXELFORMAT_YVYU:
+    case SDL_PIXELFORMAT_NV12:
+    case SDL_PIXELFORMAT_NV21:
         break;
     default:
         SDL_SetError("Unsupported YUV format");
@@ -1059,6 +1402,22 @@ SDL_SW_CreateYUVTexture(Uint32 format, int w, int h)
         return NULL;
     }
 
+    /* Choose the conversion, and put it in fixed point */
+    hint = SDL_GetHint(SDL_HINT_YUV_CONVERSION_MODE);
+    for (i = SDL_arraysize(SDL_yuv_conversions) - 1; i > 0; --i) {
+        if (hint && SDL_strcasecmp(hint, SDL_yuv_conversions[i].name) == 0) {
+            break;
+        }
+    }
+    conversion = &SDL_yuv_conversions[i];
+    swdata->conversion = i;
+    swdata->luma_offset = conversion->luma_offset;
+    swdata->luma_scale = (int) SDL_floor(conversion->luma_scale * 2048.0 + 0.5);
+    swdata->cr_r = (int) SDL_floor(conversion->cr_r / conversion->luma_scale * 512.0 + 0.5);
+    swdata->cr_g = (int) SDL_floor(conversion->cr_g / conversion->luma_scale * 512.0 + 0.5);
+    swdata->cb_g = (int) SDL_floor(conversion->cb_g / conversion->luma_scale * 512.0 + 0.5);
+    swdata->cb_b = (int) SDL_floor(conversion->cb_b / conversion->luma_scale * 512.0 + 0.5);
+
     /* Generate the tables for the display surface */
     Cr_r_tab = &swdata->colortab[0 * 256];
     Cr_g_tab = &swdata->colortab[1 * 256];
@@ -1069,10 +1428,10 @@ SDL_SW_CreateYUVTexture(Uint32 format, int w, int h)
            would be done here.  See the Berkeley mpeg_play sources.
          */
         CB = CR = (i - 128);
-        Cr_r_tab[i] = (int) ((0.419 / 0.299) * CR);
-        Cr_g_tab[i] = (int) (-(0.299 / 0.419) * CR);
-        Cb_g_tab[i] = (int) (-(0.114 / 0.331) * CB);
-        Cb_b_tab[i] = (int) ((0.587 / 0.331) * CB);
+        Cr_r_tab[i] = (CR * swdata->cr_r) >> 9;
+        Cr_g_tab[i] = (CR * swdata->cr_g) >> 9;
+        Cb_g_tab[i] = (CB * swdata->cb_g) >> 9;
+        Cb_b_tab[i] = (CB * swdata->cb_b) >> 9;
     }
 
     /* Find the pitch and offset values for the overlay */
@@ -1086,6 +1445,13 @@ SDL_SW_CreateYUVTexture(Uint32 format, int w, int h)
         swdata->planes[1] = swdata->planes[0] + swdata->pitches[0] * h;
         swdata->planes[2] = swdata->planes[1] + swdata->pitches[1] * h / 2;
         break;
+    case SDL_PIXELFORMAT_NV12:
+    case SDL_PIXELFORMAT_NV21:
+        swdata->pitches[0] = w;
+        swdata->pitches[1] = w;
+        swdata->planes[0] = swdata->pixels;
+        swdata->planes[1] = swdata->planes[0] + swdata->pitches[0] * h;
+        break;
     case SDL_PIXELFORMAT_YUY2:
     case SDL_PIXELFORMAT_UYVY:
     case SDL_PIXELFORMAT_YVYU:
@@ -1117,10 +1483,38 @@ SDL_SW_UpdateYUVTexture(SDL_SW_YUVTexture * swdata, const SDL_Rect * rect,
     switch (swdata->format) {
     case SDL_PIXELFORMAT_YV12:
     case SDL_PIXELFORMAT_IYUV:
+    case SDL_PIXELFORMAT_NV12:
+    case SDL_PIXELFORMAT_NV21:
         if (rect->x == 0 && rect->y == 0 &&
-            rect->w == swdata->w && rect->h == swdata->h) {
+            rect->w == swdata->w && rect->h == swdata->h &&
+            pitch == swdata->w) {
                 SDL_memcpy(swdata->pixels, pixels,
                            (swdata->h * swdata->w) + (swdata->h * swdata->w) / 2);
+        } else if (swdata->format == SDL_PIXELFORMAT_NV12 ||
+                   swdata->format == SDL_PIXELFORMAT_NV21) {
+            Uint8 *src, *dst;
+            int row;
+            size_t length;
+
+            /* Copy the Y plane */
+            src = (Uint8 *) pixels;
+            dst = swdata->planes[0] + rect->y * swdata->pitches[0] + rect->x;
+            length = rect->w;
+            for (row = 0; row < rect->h; ++row) {
+                SDL_memcpy(dst, src, length);
+                src += pitch;
+                dst += swdata->pitches[0];
+            }
+
+            /* Copy the interleaved U/V plane, which has the same pitch */
+            src = (Uint8 *) pixels + rect->h * pitch;
+            dst = swdata->planes[1] + rect->y/2 * swdata->pitches[1] + (rect->x/2) * 2;
+            length = (rect->w / 2) * 2;
+            for (row = 0; row < rect->h/2; ++row) {
+                SDL_memcpy(dst, src, length);
+                src += pitch;
+                dst += swdata->pitches[1];
+            }
         } else {
             Uint8 *src, *dst;
             int row;
@@ -1246,11 +1640,13 @@ SDL_SW_LockYUVTexture(SDL_SW_YUVTexture * swdata, const SDL_Rect * rect,
     switch (swdata->format) {
     case SDL_PIXELFORMAT_YV12:
     case SDL_PIXELFORMAT_IYUV:
+    case SDL_PIXELFORMAT_NV12:
+    case SDL_PIXELFORMAT_NV21:
         if (rect
             && (rect->x != 0 || rect->y != 0 || rect->w != swdata->w
                 || rect->h != swdata->h)) {
             return SDL_SetError
-                ("YV12 and IYUV textures only support full surface locks");
+                ("YV12, IYUV, NV12 and NV21 textures only support full surface locks");
         }
         break;
     }
@@ -1302,7 +1698,8 @@ SDL_SW_CopyYUVToRGB(SDL_SW_YUVTexture * swdata, const SDL_Rect * srcrect,
          */
         stretch = 1;
     } else if ((srcrect->w != w) || (srcrect->h != h)) {
-        if ((w == 2 * srcrect->w) && (h == 2 * srcrect->h)) {
+        if ((w == 2 * srcrect->w) && (h == 2 * srcrect->h) &&
+            swdata->Display2X) {
             scale_2x = 1;
         } else {
             stretch = 1;
@@ -1368,6 +1765,16 @@ SDL_SW_CopyYUVToRGB(SDL_SW_YUVTexture * swdata, const SDL_Rect * srcrect,
         Cr = lum + 1;
         Cb = lum + 3;
         break;
+    case SDL_PIXELFORMAT_NV12:
+        lum = swdata->planes[0];
+        Cr = swdata->planes[1] + 1;
+        Cb = swdata->planes[1];
+        break;
+    case SDL_PIXELFORMAT_NV21:
+        lum = swdata->planes[0];
+        Cr = swdata->planes[1];
+        Cb = swdata->planes[1] + 1;
+        break;
     default:
         return SDL_SetError("Unsupported YUV format in copy");
     }
@@ -1377,6 +1784,10 @@ SDL_SW_CopyYUVToRGB(SDL_SW_YUVTexture * swdata, const SDL_Rect * srcrect,
         mod -= (swdata->w * 2);
         swdata->Display2X(swdata->colortab, swdata->rgb_2_pix,
                           lum, Cr, Cb, pixels, swdata->h, swdata->w, mod);
+#ifdef __SSE2__
+    } else if (swdata->simd) {
+        SSE2_DisplayYUV(swdata, lum, Cr, Cb, (Uint8 *) pixels, pitch);
+#endif
     } else {
         mod -= swdata->w;
         swdata->Display1X(swdata->colortab, swdata->rgb_2_pix,
@@ -41,6 +41,20 @@ struct SDL_SW_YUVTexture
                        unsigned char *cb, unsigned char *out,
                        int rows, int cols, int mod);
 
+    /* The conversion from YUV, in fixed point: luma_offset is taken from Y
+       and the result scaled by luma_scale / 2048, with the chroma terms in
+       1/512ths of that.  The tables and the SIMD code both use these. */
+    int conversion;
+    int luma_offset;
+    int luma_scale;
+    int cr_r, cr_g, cb_g, cb_b;
+
+    /* The target pixel layout, for the SIMD code */
+    SDL_bool simd;
+    int rloss, gloss, bloss;
+    int rshift, gshift, bshift;
+    Uint32 Amask;
+
     /* These are just so we don't have to allocate them separately */
     Uint16 pitches[3];
     Uint8 *planes[3];
@@ -79,6 +79,9 @@ static int GL_RenderFillRects(SDL_Renderer * renderer,
                               const SDL_FRect * rects, int count);
 static int GL_RenderCopy(SDL_Renderer * renderer, SDL_Texture * texture,
                          const SDL_Rect * srcrect, const SDL_FRect * dstrect);
+static int GL_RenderCopyBatch(SDL_Renderer * renderer, SDL_Texture * texture,
+                              const SDL_Rect * srcrects,
+                              const SDL_FRect * dstrects, int count);
 static int GL_RenderCopyEx(SDL_Renderer * renderer, SDL_Texture * texture,
                          const SDL_Rect * srcrect, const SDL_FRect * dstrect,
                          const double angle, const SDL_FPoint *center, const SDL_RendererFlip flip);
@@ -110,6 +113,30 @@ struct GL_FBOList
     GL_FBOList *next;
 };
 
+/* Texture uploads are staged in a ring of pixel buffer objects, so the
+   copy to the GPU can overlap with rendering.  A fence on each buffer
+   tells us whether the GPU is done with it; if it isn't, the buffer is
+   orphaned rather than waited on. */
+#define GL_UPLOAD_BUFFERS   4
+
+typedef struct
+{
+    GLuint buffer;
+    GLsizeiptrARB size;
+    GLsync fence;
+} GL_UploadBuffer;
+
+/* One plane of an upload into a texture */
+typedef struct
+{
+    GLuint texture;
+    GLenum format;
+    int x, y, w, h;
+    int bpp;
+    const Uint8 *pixels;
+    int pitch;
+} GL_UploadPlane;
+
 typedef struct
 {
     SDL_GLContext context;
@@ -131,6 +158,10 @@ typedef struct
     SDL_bool GL_EXT_framebuffer_object_supported;
     GL_FBOList *framebuffers;
 
+    /* Scratch space for building vertex arrays */
+    GLfloat *vertices;
+    int vertices_size;
+
     /* OpenGL functions */
 #define SDL_PROC(ret,func,params) ret (APIENTRY *func) params;
 #include "SDL_glfuncs.h"
@@ -147,6 +178,21 @@ typedef struct
     PFNGLBINDFRAMEBUFFEREXTPROC glBindFramebufferEXT;
     PFNGLCHECKFRAMEBUFFERSTATUSEXTPROC glCheckFramebufferStatusEXT;
 
+    /* Pixel buffer object support */
+    SDL_bool GL_ARB_pixel_buffer_object_supported;
+    PFNGLGENBUFFERSARBPROC glGenBuffersARB;
+    PFNGLDELETEBUFFERSARBPROC glDeleteBuffersARB;
+    PFNGLBINDBUFFERARBPROC glBindBufferARB;
+    PFNGLBUFFERDATAARBPROC glBufferDataARB;
+    PFNGLMAPBUFFERARBPROC glMapBufferARB;
+    PFNGLUNMAPBUFFERARBPROC glUnmapBufferARB;
+    SDL_bool GL_ARB_sync_supported;
+    PFNGLFENCESYNCPROC glFenceSync;
+    PFNGLCLIENTWAITSYNCPROC glClientWaitSync;
+    PFNGLDELETESYNCPROC glDeleteSync;
+    GL_UploadBuffer upload_buffers[GL_UPLOAD_BUFFERS];
+    int upload_buffer;
+
     /* Shader support */
     GL_ShaderContext *shaders;
 
@@ -169,6 +215,9 @@ typedef struct
     GLuint utexture;
     GLuint vtexture;
 
+    /* NV12 texture support, with the U/V plane in utexture */
+    SDL_bool nv12;
+
     GL_FBOList *fbo;
 } GL_TextureData;
 
@@ -440,6 +489,7 @@ GL_CreateRenderer(SDL_Window * window, Uint32 flags)
     renderer->RenderDrawLines = GL_RenderDrawLines;
     renderer->RenderFillRects = GL_RenderFillRects;
     renderer->RenderCopy = GL_RenderCopy;
+    renderer->RenderCopyBatch = GL_RenderCopyBatch;
     renderer->RenderCopyEx = GL_RenderCopyEx;
     renderer->RenderReadPixels = GL_RenderReadPixels;
     renderer->RenderPresent = GL_RenderPresent;
@@ -534,6 +584,11 @@ GL_CreateRenderer(SDL_Window * window, Uint32 flags)
         renderer->info.texture_formats[renderer->info.num_texture_formats++] = SDL_PIXELFORMAT_YV12;
         renderer->info.texture_formats[renderer->info.num_texture_formats++] = SDL_PIXELFORMAT_IYUV;
     }
+    /* NV12 and NV21 textures use 2 textures, so frames can be uploaded as-is */
+    if (data->shaders && data->num_texture_units >= 2) {
+        renderer->info.texture_formats[renderer->info.num_texture_formats++] = SDL_PIXELFORMAT_NV12;
+        renderer->info.texture_formats[renderer->info.num_texture_formats++] = SDL_PIXELFORMAT_NV21;
+    }
 
 #ifdef __MACOSX__
     renderer->info.texture_formats[renderer->info.num_texture_formats++] = SDL_PIXELFORMAT_UYVY;
@@ -555,6 +610,43 @@ GL_CreateRenderer(SDL_Window * window, Uint32 flags)
     }
     data->framebuffers = NULL;
 
+    hint = SDL_GetHint(SDL_HINT_RENDER_OPENGL_PBO);
+    if ((!hint || *hint != '0') &&
+        SDL_GL_ExtensionSupported("GL_ARB_pixel_buffer_object") &&
+        SDL_GL_ExtensionSupported("GL_ARB_vertex_buffer_object")) {
+        data->glGenBuffersARB = (PFNGLGENBUFFERSARBPROC)
+            SDL_GL_GetProcAddress("glGenBuffersARB");
+        data->glDeleteBuffersARB = (PFNGLDELETEBUFFERSARBPROC)
+            SDL_GL_GetProcAddress("glDeleteBuffersARB");
+        data->glBindBufferARB = (PFNGLBINDBUFFERARBPROC)
+            SDL_GL_GetProcAddress("glBindBufferARB");
+        data->glBufferDataARB = (PFNGLBUFFERDATAARBPROC)
+            SDL_GL_GetProcAddress("glBufferDataARB");
+        data->glMapBufferARB = (PFNGLMAPBUFFERARBPROC)
+            SDL_GL_GetProcAddress("glMapBufferARB");
+        data->glUnmapBufferARB = (PFNGLUNMAPBUFFERARBPROC)
+            SDL_GL_GetProcAddress("glUnmapBufferARB");
+        if (data->glGenBuffersARB && data->glDeleteBuffersARB &&
+            data->glBindBufferARB && data->glBufferDataARB &&
+            data->glMapBufferARB && data->glUnmapBufferARB) {
+            data->GL_ARB_pixel_buffer_object_supported = SDL_TRUE;
+        }
+    }
+    if (data->GL_ARB_pixel_buffer_object_supported &&
+        SDL_GL_ExtensionSupported("GL_ARB_sync")) {
+        data->glFenceSync = (PFNGLFENCESYNCPROC)
+            SDL_GL_GetProcAddress("glFenceSync");
+        data->glClientWaitSync = (PFNGLCLIENTWAITSYNCPROC)
+            SDL_GL_GetProcAddress("glClientWaitSync");
+        data->glDeleteSync = (PFNGLDELETESYNCPROC)
+            SDL_GL_GetProcAddress("glDeleteSync");
+        if (data->glFenceSync && data->glClientWaitSync && data->glDeleteSync) {
+            data->GL_ARB_sync_supported = SDL_TRUE;
+        }
+    }
+    SDL_LogInfo(SDL_LOG_CATEGORY_RENDER, "OpenGL pixel buffer uploads: %s",
+                data->GL_ARB_pixel_buffer_object_supported ? "ENABLED" : "DISABLED");
+
     /* Set up parameters for rendering */
     GL_ResetState(renderer);
 
@@ -603,6 +695,8 @@ convert_format(GL_RenderData *renderdata, Uint32 pixel_format,
         break;
     case SDL_PIXELFORMAT_YV12:
     case SDL_PIXELFORMAT_IYUV:
+    case SDL_PIXELFORMAT_NV12:
+    case SDL_PIXELFORMAT_NV21:
         *internalFormat = GL_LUMINANCE;
         *format = GL_LUMINANCE;
         *type = GL_UNSIGNED_BYTE;
@@ -660,7 +754,9 @@ GL_CreateTexture(SDL_Renderer * renderer, SDL_Texture * texture)
         data->pitch = texture->w * SDL_BYTESPERPIXEL(texture->format);
         size = texture->h * data->pitch;
         if (texture->format == SDL_PIXELFORMAT_YV12 ||
-            texture->format == SDL_PIXELFORMAT_IYUV) {
+            texture->format == SDL_PIXELFORMAT_IYUV ||
+            texture->format == SDL_PIXELFORMAT_NV12 ||
+            texture->format == SDL_PIXELFORMAT_NV21) {
             /* Need to add size for the U and V planes */
             size += (2 * (texture->h * data->pitch) / 4);
         }
@@ -790,58 +886,202 @@ GL_CreateTexture(SDL_Renderer * renderer, SDL_Texture * texture)
         renderdata->glDisable(data->type);
     }
 
+    if (texture->format == SDL_PIXELFORMAT_NV12 ||
+        texture->format == SDL_PIXELFORMAT_NV21) {
+        data->nv12 = SDL_TRUE;
+
+        /* The interleaved U/V plane is sampled as luminance and alpha */
+        renderdata->glGenTextures(1, &data->utexture);
+        renderdata->glEnable(data->type);
+
+        renderdata->glBindTexture(data->type, data->utexture);
+        renderdata->glTexParameteri(data->type, GL_TEXTURE_MIN_FILTER,
+                                    scaleMode);
+        renderdata->glTexParameteri(data->type, GL_TEXTURE_MAG_FILTER,
+                                    scaleMode);
+        renderdata->glTexParameteri(data->type, GL_TEXTURE_WRAP_S,
+                                    GL_CLAMP_TO_EDGE);
+        renderdata->glTexParameteri(data->type, GL_TEXTURE_WRAP_T,
+                                    GL_CLAMP_TO_EDGE);
+        renderdata->glTexImage2D(data->type, 0, GL_LUMINANCE_ALPHA, texture_w/2,
+                                 texture_h/2, 0, GL_LUMINANCE_ALPHA, GL_UNSIGNED_BYTE, NULL);
+
+        renderdata->glDisable(data->type);
+    }
+
     return GL_CheckError("", renderer);
 }
 
+/* Copy the planes of an upload into the next buffer of the ring, tightly
+   packed, and return the buffer still bound, or NULL if it couldn't be used */
+static GL_UploadBuffer *
+GL_StageUpload(GL_RenderData *renderdata, const GL_UploadPlane *planes, int numplanes)
+{
+    GL_UploadBuffer *upload;
+    GLsizeiptrARB size = 0;
+    Uint8 *dst;
+    const Uint8 *src;
+    int i, row, length;
+
+    for (i = 0; i < numplanes; ++i) {
+        size += (GLsizeiptrARB) planes[i].w * planes[i].bpp * planes[i].h;
+    }
+    if (size == 0) {
+        return NULL;
+    }
+
+    upload = &renderdata->upload_buffers[renderdata->upload_buffer];
+    renderdata->upload_buffer = (renderdata->upload_buffer + 1) % GL_UPLOAD_BUFFERS;
+    if (!upload->buffer) {
+        renderdata->glGenBuffersARB(1, &upload->buffer);
+    }
+    renderdata->glBindBufferARB(GL_PIXEL_UNPACK_BUFFER_ARB, upload->buffer);
+
+    /* Reuse the storage if the GPU is done reading it, otherwise let the
+       driver hand us fresh storage instead of stalling until it is. */
+    if (upload->fence) {
+        const GLenum status = renderdata->glClientWaitSync(upload->fence, 0, 0);
+        if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) {
+            upload->size = 0;
+        }
+        renderdata->glDeleteSync(upload->fence);
+        upload->fence = NULL;
+    } else if (!renderdata->GL_ARB_sync_supported) {
+        upload->size = 0;
+    }
+    if (upload->size < size) {
+        renderdata->glBufferDataARB(GL_PIXEL_UNPACK_BUFFER_ARB, size, NULL, GL_STREAM_DRAW_ARB);
+        upload->size = size;
+    }
+
+    dst = (Uint8 *) renderdata->glMapBufferARB(GL_PIXEL_UNPACK_BUFFER_ARB, GL_WRITE_ONLY_ARB);
+    if (!dst) {
+        renderdata->glBindBufferARB(GL_PIXEL_UNPACK_BUFFER_ARB, 0);
+        upload->size = 0;
+        return NULL;
+    }
+    for (i = 0; i < numplanes; ++i) {
+        length = planes[i].w * planes[i].bpp;
+        src = planes[i].pixels;
+        if (length == planes[i].pitch) {
+            SDL_memcpy(dst, src, length * planes[i].h);
+            dst += length * planes[i].h;
+        } else {
+            for (row = planes[i].h; row--; ) {
+                SDL_memcpy(dst, src, length);
+                src += planes[i].pitch;
+                dst += length;
+            }
+        }
+    }
+    if (!renderdata->glUnmapBufferARB(GL_PIXEL_UNPACK_BUFFER_ARB)) {
+        /* The buffer contents were lost, upload from client memory */
+        renderdata->glBindBufferARB(GL_PIXEL_UNPACK_BUFFER_ARB, 0);
+        upload->size = 0;
+        return NULL;
+    }
+    return upload;
+}
+
 static int
-GL_UpdateTexture(SDL_Renderer * renderer, SDL_Texture * texture,
-                 const SDL_Rect * rect, const void *pixels, int pitch)
+GL_UploadPlanes(SDL_Renderer * renderer, GL_TextureData *data,
+                const GL_UploadPlane *planes, int numplanes)
 {
     GL_RenderData *renderdata = (GL_RenderData *) renderer->driverdata;
-    GL_TextureData *data = (GL_TextureData *) texture->driverdata;
-    const int texturebpp = SDL_BYTESPERPIXEL(texture->format);
-
-    SDL_assert(texturebpp != 0);  /* otherwise, division by zero later. */
+    GL_UploadBuffer *upload = NULL;
+    size_t offset = 0;
+    int i;
 
     GL_ActivateRenderer(renderer);
 
+    if (renderdata->GL_ARB_pixel_buffer_object_supported) {
+        upload = GL_StageUpload(renderdata, planes, numplanes);
+    }
+
     renderdata->glEnable(data->type);
-    renderdata->glBindTexture(data->type, data->texture);
     renderdata->glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-    renderdata->glPixelStorei(GL_UNPACK_ROW_LENGTH, (pitch / texturebpp));
-    renderdata->glTexSubImage2D(data->type, 0, rect->x, rect->y, rect->w,
-                                rect->h, data->format, data->formattype,
-                                pixels);
-    if (data->yuv) {
-        renderdata->glPixelStorei(GL_UNPACK_ROW_LENGTH, (pitch / 2));
-
-        /* Skip to the correct offset into the next texture */
-        pixels = (const void*)((const Uint8*)pixels + rect->h * pitch);
-        if (texture->format == SDL_PIXELFORMAT_YV12) {
-            renderdata->glBindTexture(data->type, data->vtexture);
-        } else {
-            renderdata->glBindTexture(data->type, data->utexture);
-        }
-        renderdata->glTexSubImage2D(data->type, 0, rect->x/2, rect->y/2,
-                                    rect->w/2, rect->h/2,
-                                    data->format, data->formattype, pixels);
-
-        /* Skip to the correct offset into the next texture */
-        pixels = (const void*)((const Uint8*)pixels + (rect->h * pitch)/4);
-        if (texture->format == SDL_PIXELFORMAT_YV12) {
-            renderdata->glBindTexture(data->type, data->utexture);
+    for (i = 0; i < numplanes; ++i) {
+        renderdata->glBindTexture(data->type, planes[i].texture);
+        if (upload) {
+            /* The pixels are an offset into the bound buffer */
+            renderdata->glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+            renderdata->glTexSubImage2D(data->type, 0, planes[i].x, planes[i].y,
+                                        planes[i].w, planes[i].h,
+                                        planes[i].format, data->formattype,
+                                        (const GLvoid *) offset);
+            offset += (size_t) planes[i].w * planes[i].bpp * planes[i].h;
         } else {
-            renderdata->glBindTexture(data->type, data->vtexture);
+            renderdata->glPixelStorei(GL_UNPACK_ROW_LENGTH, (planes[i].pitch / planes[i].bpp));
+            renderdata->glTexSubImage2D(data->type, 0, planes[i].x, planes[i].y,
+                                        planes[i].w, planes[i].h,
+                                        planes[i].format, data->formattype,
+                                        planes[i].pixels);
         }
-        renderdata->glTexSubImage2D(data->type, 0, rect->x/2, rect->y/2,
-                                    rect->w/2, rect->h/2,
-                                    data->format, data->formattype, pixels);
     }
     renderdata->glDisable(data->type);
 
+    if (upload) {
+        renderdata->glBindBufferARB(GL_PIXEL_UNPACK_BUFFER_ARB, 0);
+        if (renderdata->GL_ARB_sync_supported) {
+            upload->fence = renderdata->glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        }
+    }
+
     return GL_CheckError("glTexSubImage2D()", renderer);
 }
 
+static void
+GL_SetUploadPlane(GL_UploadPlane *plane, GLuint texture, GLenum format,
+                  const SDL_Rect * rect, int shift, int bpp,
+                  const void *pixels, int pitch)
+{
+    plane->texture = texture;
+    plane->format = format;
+    plane->x = rect->x >> shift;
+    plane->y = rect->y >> shift;
+    plane->w = rect->w >> shift;
+    plane->h = rect->h >> shift;
+    plane->bpp = bpp;
+    plane->pixels = (const Uint8 *) pixels;
+    plane->pitch = pitch;
+}
+
+static int
+GL_UpdateTexture(SDL_Renderer * renderer, SDL_Texture * texture,
+                 const SDL_Rect * rect, const void *pixels, int pitch)
+{
+    GL_TextureData *data = (GL_TextureData *) texture->driverdata;
+    const int texturebpp = SDL_BYTESPERPIXEL(texture->format);
+    GL_UploadPlane planes[3];
+    const Uint8 *src = (const Uint8 *) pixels;
+
+    SDL_assert(texturebpp != 0);  /* otherwise, division by zero later. */
+
+    GL_SetUploadPlane(&planes[0], data->texture, data->format, rect, 0,
+                      texturebpp, src, pitch);
+    if (data->nv12) {
+        /* The U/V plane goes up as it is, with the same pitch */
+        src += rect->h * pitch;
+        GL_SetUploadPlane(&planes[1], data->utexture, GL_LUMINANCE_ALPHA,
+                          rect, 1, 2, src, pitch);
+        return GL_UploadPlanes(renderer, data, planes, 2);
+    }
+    if (!data->yuv) {
+        return GL_UploadPlanes(renderer, data, planes, 1);
+    }
+
+    /* Skip to the correct offset into the next textures */
+    src += rect->h * pitch;
+    GL_SetUploadPlane(&planes[1], (texture->format == SDL_PIXELFORMAT_YV12) ?
+                      data->vtexture : data->utexture, data->format,
+                      rect, 1, 1, src, pitch / 2);
+    src += (rect->h * pitch) / 4;
+    GL_SetUploadPlane(&planes[2], (texture->format == SDL_PIXELFORMAT_YV12) ?
+                      data->utexture : data->vtexture, data->format,
+                      rect, 1, 1, src, pitch / 2);
+    return GL_UploadPlanes(renderer, data, planes, 3);
+}
+
 static int
 GL_UpdateTextureYUV(SDL_Renderer * renderer, SDL_Texture * texture,
                     const SDL_Rect * rect,
@@ -849,33 +1089,13 @@ GL_UpdateTextureYUV(SDL_Renderer * renderer, SDL_Texture * texture,
                     const Uint8 *Uplane, int Upitch,
                     const Uint8 *Vplane, int Vpitch)
 {
-    GL_RenderData *renderdata = (GL_RenderData *) renderer->driverdata;
     GL_TextureData *data = (GL_TextureData *) texture->driverdata;
+    GL_UploadPlane planes[3];
 
-    GL_ActivateRenderer(renderer);
-
-    renderdata->glEnable(data->type);
-    renderdata->glBindTexture(data->type, data->texture);
-    renderdata->glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-    renderdata->glPixelStorei(GL_UNPACK_ROW_LENGTH, Ypitch);
-    renderdata->glTexSubImage2D(data->type, 0, rect->x, rect->y, rect->w,
-                                rect->h, data->format, data->formattype,
-                                Yplane);
-
-    renderdata->glPixelStorei(GL_UNPACK_ROW_LENGTH, Upitch);
-    renderdata->glBindTexture(data->type, data->utexture);
-    renderdata->glTexSubImage2D(data->type, 0, rect->x/2, rect->y/2,
-                                rect->w/2, rect->h/2,
-                                data->format, data->formattype, Uplane);
-
-    renderdata->glPixelStorei(GL_UNPACK_ROW_LENGTH, Vpitch);
-    renderdata->glBindTexture(data->type, data->vtexture);
-    renderdata->glTexSubImage2D(data->type, 0, rect->x/2, rect->y/2,
-                                rect->w/2, rect->h/2,
-                                data->format, data->formattype, Vplane);
-    renderdata->glDisable(data->type);
-
-    return GL_CheckError("glTexSubImage2D()", renderer);
+    GL_SetUploadPlane(&planes[0], data->texture, data->format, rect, 0, 1, Yplane, Ypitch);
+    GL_SetUploadPlane(&planes[1], data->utexture, data->format, rect, 1, 1, Uplane, Upitch);
+    GL_SetUploadPlane(&planes[2], data->vtexture, data->format, rect, 1, 1, Vplane, Vpitch);
+    return GL_UploadPlanes(renderer, data, planes, 3);
 }
 
 static int
@@ -1156,30 +1376,62 @@ GL_RenderDrawLines(SDL_Renderer * renderer, const SDL_FPoint * points,
     return GL_CheckError("", renderer);
 }
 
+/* Get room for the given number of floats in the vertex scratch space */
+static GLfloat *
+GL_GetVertices(GL_RenderData * data, int count)
+{
+    if (count > data->vertices_size) {
+        GLfloat *vertices = (GLfloat *) SDL_realloc(data->vertices, count * sizeof(GLfloat));
+        if (!vertices) {
+            SDL_OutOfMemory();
+            return NULL;
+        }
+        data->vertices = vertices;
+        data->vertices_size = count;
+    }
+    return data->vertices;
+}
+
 static int
 GL_RenderFillRects(SDL_Renderer * renderer, const SDL_FRect * rects, int count)
 {
     GL_RenderData *data = (GL_RenderData *) renderer->driverdata;
+    GLfloat *vertices;
     int i;
 
     GL_SetDrawingState(renderer);
 
+    /* Draw all the rectangles as quads from a single vertex array */
+    vertices = GL_GetVertices(data, count * 8);
+    if (!vertices) {
+        return -1;
+    }
     for (i = 0; i < count; ++i) {
         const SDL_FRect *rect = &rects[i];
+        GLfloat *v = &vertices[i * 8];
+
+        v[0] = rect->x;
+        v[1] = rect->y;
+        v[2] = rect->x + rect->w;
+        v[3] = rect->y;
+        v[4] = rect->x + rect->w;
+        v[5] = rect->y + rect->h;
+        v[6] = rect->x;
+        v[7] = rect->y + rect->h;
+    }
+    data->glEnableClientState(GL_VERTEX_ARRAY);
+    data->glVertexPointer(2, GL_FLOAT, 0, vertices);
+    data->glDrawArrays(GL_QUADS, 0, count * 4);
+    data->glDisableClientState(GL_VERTEX_ARRAY);
 
-        data->glRectf(rect->x, rect->y, rect->x + rect->w, rect->y + rect->h);
-    }
     return GL_CheckError("", renderer);
 }
 
-static int
-GL_RenderCopy(SDL_Renderer * renderer, SDL_Texture * texture,
-              const SDL_Rect * srcrect, const SDL_FRect * dstrect)
+static void
+GL_SetupCopy(SDL_Renderer * renderer, SDL_Texture * texture)
 {
     GL_RenderData *data = (GL_RenderData *) renderer->driverdata;
     GL_TextureData *texturedata = (GL_TextureData *) texture->driverdata;
-    GLfloat minx, miny, maxx, maxy;
-    GLfloat minu, maxu, minv, maxv;
 
     GL_ActivateRenderer(renderer);
 
@@ -1191,6 +1443,11 @@ GL_RenderCopy(SDL_Renderer * renderer, SDL_Texture * texture,
         data->glActiveTextureARB(GL_TEXTURE1_ARB);
         data->glBindTexture(texturedata->type, texturedata->utexture);
 
+        data->glActiveTextureARB(GL_TEXTURE0_ARB);
+    } else if (texturedata->nv12) {
+        data->glActiveTextureARB(GL_TEXTURE1_ARB);
+        data->glBindTexture(texturedata->type, texturedata->utexture);
+
         data->glActiveTextureARB(GL_TEXTURE0_ARB);
     }
     data->glBindTexture(texturedata->type, texturedata->texture);
@@ -1205,9 +1462,27 @@ GL_RenderCopy(SDL_Renderer * renderer, SDL_Texture * texture,
 
     if (texturedata->yuv) {
         GL_SetShader(data, SHADER_YV12);
+    } else if (texturedata->nv12) {
+        if (texture->format == SDL_PIXELFORMAT_NV12) {
+            GL_SetShader(data, SHADER_NV12);
+        } else {
+            GL_SetShader(data, SHADER_NV21);
+        }
     } else {
         GL_SetShader(data, SHADER_RGB);
     }
+}
+
+static int
+GL_RenderCopy(SDL_Renderer * renderer, SDL_Texture * texture,
+              const SDL_Rect * srcrect, const SDL_FRect * dstrect)
+{
+    GL_RenderData *data = (GL_RenderData *) renderer->driverdata;
+    GL_TextureData *texturedata = (GL_TextureData *) texture->driverdata;
+    GLfloat minx, miny, maxx, maxy;
+    GLfloat minu, maxu, minv, maxv;
+
+    GL_SetupCopy(renderer, texture);
 
     minx = dstrect->x;
     miny = dstrect->y;
@@ -1239,6 +1514,55 @@ GL_RenderCopy(SDL_Renderer * renderer, SDL_Texture * texture,
     return GL_CheckError("", renderer);
 }
 
+static int
+GL_RenderCopyBatch(SDL_Renderer * renderer, SDL_Texture * texture,
+                   const SDL_Rect * srcrects, const SDL_FRect * dstrects,
+                   int count)
+{
+    GL_RenderData *data = (GL_RenderData *) renderer->driverdata;
+    GL_TextureData *texturedata = (GL_TextureData *) texture->driverdata;
+    GLfloat *vertices;
+    int i;
+
+    /* Each quad is four vertices of interleaved x, y, u, v */
+    vertices = GL_GetVertices(data, count * 16);
+    if (!vertices) {
+        return -1;
+    }
+    for (i = 0; i < count; ++i) {
+        const SDL_Rect *srcrect = &srcrects[i];
+        const SDL_FRect *dstrect = &dstrects[i];
+        const GLfloat minx = dstrect->x;
+        const GLfloat miny = dstrect->y;
+        const GLfloat maxx = dstrect->x + dstrect->w;
+        const GLfloat maxy = dstrect->y + dstrect->h;
+        const GLfloat minu = ((GLfloat) srcrect->x / texture->w) * texturedata->texw;
+        const GLfloat minv = ((GLfloat) srcrect->y / texture->h) * texturedata->texh;
+        const GLfloat maxu = ((GLfloat) (srcrect->x + srcrect->w) / texture->w) * texturedata->texw;
+        const GLfloat maxv = ((GLfloat) (srcrect->y + srcrect->h) / texture->h) * texturedata->texh;
+        GLfloat *v = &vertices[i * 16];
+
+        v[0] = minx;  v[1] = miny;  v[2] = minu;  v[3] = minv;
+        v[4] = maxx;  v[5] = miny;  v[6] = maxu;  v[7] = minv;
+        v[8] = maxx;  v[9] = maxy;  v[10] = maxu; v[11] = maxv;
+        v[12] = minx; v[13] = maxy; v[14] = minu; v[15] = maxv;
+    }
+
+    GL_SetupCopy(renderer, texture);
+
+    data->glEnableClientState(GL_VERTEX_ARRAY);
+    data->glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+    data->glVertexPointer(2, GL_FLOAT, 4 * sizeof(GLfloat), &vertices[0]);
+    data->glTexCoordPointer(2, GL_FLOAT, 4 * sizeof(GLfloat), &vertices[2]);
+    data->glDrawArrays(GL_QUADS, 0, count * 4);
+    data->glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+    data->glDisableClientState(GL_VERTEX_ARRAY);
+
+    data->glDisable(texturedata->type);
+
+    return GL_CheckError("", renderer);
+}
+
 static int
 GL_RenderCopyEx(SDL_Renderer * renderer, SDL_Texture * texture,
               const SDL_Rect * srcrect, const SDL_FRect * dstrect,
@@ -1260,6 +1584,11 @@ GL_RenderCopyEx(SDL_Renderer * renderer, SDL_Texture * texture,
         data->glActiveTextureARB(GL_TEXTURE1_ARB);
         data->glBindTexture(texturedata->type, texturedata->utexture);
 
+        data->glActiveTextureARB(GL_TEXTURE0_ARB);
+    } else if (texturedata->nv12) {
+        data->glActiveTextureARB(GL_TEXTURE1_ARB);
+        data->glBindTexture(texturedata->type, texturedata->utexture);
+
         data->glActiveTextureARB(GL_TEXTURE0_ARB);
     }
     data->glBindTexture(texturedata->type, texturedata->texture);
@@ -1274,6 +1603,12 @@ GL_RenderCopyEx(SDL_Renderer * renderer, SDL_Texture * texture,
 
     if (texturedata->yuv) {
         GL_SetShader(data, SHADER_YV12);
+    } else if (texturedata->nv12) {
+        if (texture->format == SDL_PIXELFORMAT_NV12) {
+            GL_SetShader(data, SHADER_NV12);
+        } else {
+            GL_SetShader(data, SHADER_NV21);
+        }
     } else {
         GL_SetShader(data, SHADER_RGB);
     }
@@ -1416,6 +1751,9 @@ GL_DestroyTexture(SDL_Renderer * renderer, SDL_Texture * texture)
         renderdata->glDeleteTextures(1, &data->utexture);
         renderdata->glDeleteTextures(1, &data->vtexture);
     }
+    if (data->nv12) {
+        renderdata->glDeleteTextures(1, &data->utexture);
+    }
     SDL_free(data->pixels);
     SDL_free(data);
     texture->driverdata = NULL;
@@ -1425,6 +1763,7 @@ static void
 GL_DestroyRenderer(SDL_Renderer * renderer)
 {
     GL_RenderData *data = (GL_RenderData *) renderer->driverdata;
+    int i;
 
     if (data) {
         GL_ClearErrors(renderer);
@@ -1447,8 +1786,18 @@ GL_DestroyRenderer(SDL_Renderer * renderer)
                 SDL_free(data->framebuffers);
                 data->framebuffers = nextnode;
             }
+            for (i = 0; i < GL_UPLOAD_BUFFERS; ++i) {
+                GL_UploadBuffer *upload = &data->upload_buffers[i];
+                if (upload->fence) {
+                    data->glDeleteSync(upload->fence);
+                }
+                if (upload->buffer) {
+                    data->glDeleteBuffersARB(1, &upload->buffer);
+                }
+            }
             SDL_GL_DeleteContext(data->context);
         }
+        SDL_free(data->vertices);
         SDL_free(data);
     }
     SDL_free(renderer);
@@ -1469,6 +1818,11 @@ GL_BindTexture (SDL_Renderer * renderer, SDL_Texture *texture, float *texw, floa
         data->glActiveTextureARB(GL_TEXTURE1_ARB);
         data->glBindTexture(texturedata->type, texturedata->utexture);
 
+        data->glActiveTextureARB(GL_TEXTURE0_ARB);
+    } else if (texturedata->nv12) {
+        data->glActiveTextureARB(GL_TEXTURE1_ARB);
+        data->glBindTexture(texturedata->type, texturedata->utexture);
+
         data->glActiveTextureARB(GL_TEXTURE0_ARB);
     }
     data->glBindTexture(texturedata->type, texturedata->texture);
@@ -1493,6 +1847,11 @@ GL_UnbindTexture (SDL_Renderer * renderer, SDL_Texture *texture)
         data->glActiveTextureARB(GL_TEXTURE1_ARB);
         data->glDisable(texturedata->type);
 
+        data->glActiveTextureARB(GL_TEXTURE0_ARB);
+    } else if (texturedata->nv12) {
+        data->glActiveTextureARB(GL_TEXTURE1_ARB);
+        data->glDisable(texturedata->type);
+
         data->glActiveTextureARB(GL_TEXTURE0_ARB);
     }
 
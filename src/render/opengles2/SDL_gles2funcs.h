@@ -22,13 +22,17 @@
 SDL_PROC(void, glActiveTexture, (GLenum))
 SDL_PROC(void, glAttachShader, (GLuint, GLuint))
 SDL_PROC(void, glBindAttribLocation, (GLuint, GLuint, const char *))
+SDL_PROC(void, glBindBuffer, (GLenum, GLuint))
 SDL_PROC(void, glBindTexture, (GLenum, GLuint))
 SDL_PROC(void, glBlendFuncSeparate, (GLenum, GLenum, GLenum, GLenum))
+SDL_PROC(void, glBufferData, (GLenum, GLsizeiptr, const GLvoid *, GLenum))
+SDL_PROC(void, glBufferSubData, (GLenum, GLintptr, GLsizeiptr, const GLvoid *))
 SDL_PROC(void, glClear, (GLbitfield))
 SDL_PROC(void, glClearColor, (GLclampf, GLclampf, GLclampf, GLclampf))
 SDL_PROC(void, glCompileShader, (GLuint))
 SDL_PROC(GLuint, glCreateProgram, (void))
 SDL_PROC(GLuint, glCreateShader, (GLenum))
+SDL_PROC(void, glDeleteBuffers, (GLsizei, const GLuint *))
 SDL_PROC(void, glDeleteProgram, (GLuint))
 SDL_PROC(void, glDeleteShader, (GLuint))
 SDL_PROC(void, glDeleteTextures, (GLsizei, const GLuint *))
@@ -38,6 +42,7 @@ SDL_PROC(void, glDrawArrays, (GLenum, GLint, GLsizei))
 SDL_PROC(void, glEnable, (GLenum))
 SDL_PROC(void, glEnableVertexAttribArray, (GLuint))
 SDL_PROC(void, glFinish, (void))
+SDL_PROC(void, glGenBuffers, (GLsizei, GLuint *))
 SDL_PROC(void, glGenFramebuffers, (GLsizei, GLuint *))
 SDL_PROC(void, glGenTextures, (GLsizei, GLuint *))
 SDL_PROC(void, glGetBooleanv, (GLenum, GLboolean *))
@@ -48,11 +48,13 @@ SDL_RenderDriver GLES2_RenderDriver = {
     {
         "opengles2",
         (SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC | SDL_RENDERER_TARGETTEXTURE),
-        4,
+        6,
         {SDL_PIXELFORMAT_ABGR8888,
         SDL_PIXELFORMAT_ARGB8888,
         SDL_PIXELFORMAT_RGB888,
-        SDL_PIXELFORMAT_BGR888},
+        SDL_PIXELFORMAT_BGR888,
+        SDL_PIXELFORMAT_NV12,
+        SDL_PIXELFORMAT_NV21},
         0,
         0
     }
@@ -79,6 +81,9 @@ typedef struct GLES2_TextureData
     GLenum pixel_type;
     void *pixel_data;
     size_t pitch;
+    /* NV12 texture support, with the U/V plane in texture_u */
+    SDL_bool nv12;
+    GLuint texture_u;
     GLES2_FBOList *fbo;
 } GLES2_TextureData;
 
@@ -133,7 +138,8 @@ typedef enum
     GLES2_UNIFORM_PROJECTION,
     GLES2_UNIFORM_TEXTURE,
     GLES2_UNIFORM_MODULATION,
-    GLES2_UNIFORM_COLOR
+    GLES2_UNIFORM_COLOR,
+    GLES2_UNIFORM_TEXTURE_U
 } GLES2_Uniform;
 
 typedef enum
@@ -142,9 +148,26 @@ typedef enum
     GLES2_IMAGESOURCE_TEXTURE_ABGR,
     GLES2_IMAGESOURCE_TEXTURE_ARGB,
     GLES2_IMAGESOURCE_TEXTURE_RGB,
-    GLES2_IMAGESOURCE_TEXTURE_BGR
+    GLES2_IMAGESOURCE_TEXTURE_BGR,
+    GLES2_IMAGESOURCE_TEXTURE_NV12,
+    GLES2_IMAGESOURCE_TEXTURE_NV21
 } GLES2_ImageSource;
 
+/* Vertex data is streamed through a ring of buffer objects.  Each frame
+   starts on the next buffer in the ring, and a buffer is orphaned before
+   it's reused, so the driver never has to wait for draws using it. */
+#define GLES2_VERTEX_BUFFERS        3
+#define GLES2_VERTEX_BUFFER_SIZE    (256 * 1024)
+
+typedef struct GLES2_VertexBuffers
+{
+    GLuint ids[GLES2_VERTEX_BUFFERS];
+    GLsizeiptr sizes[GLES2_VERTEX_BUFFERS];
+    int current;
+    GLsizeiptr offset;          /**< The write cursor in the current buffer */
+    SDL_bool bound;
+} GLES2_VertexBuffers;
+
 typedef struct GLES2_DriverContext
 {
     SDL_GLContext *context;
@@ -168,6 +191,11 @@ typedef struct GLES2_DriverContext
     GLES2_ProgramCache program_cache;
     GLES2_ProgramCacheEntry *current_program;
     Uint8 clear_r, clear_g, clear_b, clear_a;
+
+    /* Scratch space for building vertex arrays */
+    GLfloat *vertices;
+    int vertices_size;
+    GLES2_VertexBuffers vertex_buffers;
 } GLES2_DriverContext;
 
 #define GLES2_MAX_CACHED_PROGRAMS 8
@@ -307,6 +335,7 @@ GLES2_ActivateRenderer(SDL_Renderer * renderer)
     if (SDL_CurrentContext != data->context) {
         /* Null out the current program to ensure we set it again */
         data->current_program = NULL;
+        data->vertex_buffers.bound = SDL_FALSE;
 
         if (SDL_GL_MakeCurrent(renderer->window, data->context) < 0) {
             return -1;
@@ -411,6 +440,9 @@ GLES2_DestroyRenderer(SDL_Renderer *renderer)
             }
         }
         if (data->context) {
+            if (data->vertex_buffers.ids[0]) {
+                data->glDeleteBuffers(GLES2_VERTEX_BUFFERS, data->vertex_buffers.ids);
+            }
             while (data->framebuffers) {
                 GLES2_FBOList *nextnode = data->framebuffers->next;
                 data->glDeleteFramebuffers(1, &data->framebuffers->FBO);
@@ -421,6 +453,7 @@ GLES2_DestroyRenderer(SDL_Renderer *renderer)
             SDL_GL_DeleteContext(data->context);
         }
         SDL_free(data->shader_formats);
+        SDL_free(data->vertices);
         SDL_free(data);
     }
     SDL_free(renderer);
@@ -472,6 +505,11 @@ GLES2_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture)
         format = GL_RGBA;
         type = GL_UNSIGNED_BYTE;
         break;
+    case SDL_PIXELFORMAT_NV12:
+    case SDL_PIXELFORMAT_NV21:
+        format = GL_LUMINANCE;
+        type = GL_UNSIGNED_BYTE;
+        break;
     default:
         return SDL_SetError("Texture format not supported");
     }
@@ -485,12 +523,20 @@ GLES2_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture)
     data->texture_type = GL_TEXTURE_2D;
     data->pixel_format = format;
     data->pixel_type = type;
+    data->nv12 = ((texture->format == SDL_PIXELFORMAT_NV12) ||
+                  (texture->format == SDL_PIXELFORMAT_NV21));
     scaleMode = GetScaleQuality();
 
     /* Allocate a blob for image renderdata */
     if (texture->access == SDL_TEXTUREACCESS_STREAMING) {
+        size_t size;
         data->pitch = texture->w * SDL_BYTESPERPIXEL(texture->format);
-        data->pixel_data = SDL_calloc(1, data->pitch * texture->h);
+        size = texture->h * data->pitch;
+        if (data->nv12) {
+            /* Need to add size for the U/V plane */
+            size += ((texture->h + 1) / 2) * data->pitch;
+        }
+        data->pixel_data = SDL_calloc(1, size);
         if (!data->pixel_data) {
             SDL_free(data);
             return SDL_OutOfMemory();
@@ -499,6 +545,25 @@ GLES2_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture)
 
     /* Allocate the texture */
     GL_CheckError("", renderer);
+    if (data->nv12) {
+        /* The interleaved U/V plane is sampled as luminance and alpha */
+        renderdata->glGenTextures(1, &data->texture_u);
+        if (GL_CheckError("glGenTexures()", renderer) < 0) {
+            return -1;
+        }
+        renderdata->glActiveTexture(GL_TEXTURE1);
+        renderdata->glBindTexture(data->texture_type, data->texture_u);
+        renderdata->glTexParameteri(data->texture_type, GL_TEXTURE_MIN_FILTER, scaleMode);
+        renderdata->glTexParameteri(data->texture_type, GL_TEXTURE_MAG_FILTER, scaleMode);
+        renderdata->glTexParameteri(data->texture_type, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        renderdata->glTexParameteri(data->texture_type, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        renderdata->glTexImage2D(data->texture_type, 0, GL_LUMINANCE_ALPHA, texture->w / 2, texture->h / 2, 0, GL_LUMINANCE_ALPHA, GL_UNSIGNED_BYTE, NULL);
+        if (GL_CheckError("glTexImage2D()", renderer) < 0) {
+            return -1;
+        }
+        renderdata->glActiveTexture(GL_TEXTURE0);
+    }
+
     renderdata->glGenTextures(1, &data->texture);
     if (GL_CheckError("glGenTexures()", renderer) < 0) {
         return -1;
@@ -524,52 +589,77 @@ GLES2_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture)
 }
 
 static int
-GLES2_UpdateTexture(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_Rect *rect,
-                    const void *pixels, int pitch)
+GLES2_TexSubImage2D(GLES2_DriverContext *data, GLenum target, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const GLvoid *pixels, GLint pitch, GLint bpp)
 {
-    GLES2_DriverContext *data = (GLES2_DriverContext *)renderer->driverdata;
-    GLES2_TextureData *tdata = (GLES2_TextureData *)texture->driverdata;
     Uint8 *blob = NULL;
     Uint8 *src;
-    int srcPitch;
+    int src_pitch;
     int y;
 
-    GLES2_ActivateRenderer(renderer);
-
-    /* Bail out if we're supposed to update an empty rectangle */
-    if (rect->w <= 0 || rect->h <= 0)
-        return 0;
-
     /* Reformat the texture data into a tightly packed array */
-    srcPitch = rect->w * SDL_BYTESPERPIXEL(texture->format);
+    src_pitch = width * bpp;
     src = (Uint8 *)pixels;
-    if (pitch != srcPitch) {
-        blob = (Uint8 *)SDL_malloc(srcPitch * rect->h);
+    if (pitch != src_pitch) {
+        blob = (Uint8 *)SDL_malloc(src_pitch * height);
         if (!blob) {
             return SDL_OutOfMemory();
         }
         src = blob;
-        for (y = 0; y < rect->h; ++y)
+        for (y = 0; y < height; ++y)
         {
-            SDL_memcpy(src, pixels, srcPitch);
-            src += srcPitch;
+            SDL_memcpy(src, pixels, src_pitch);
+            src += src_pitch;
             pixels = (Uint8 *)pixels + pitch;
         }
         src = blob;
     }
 
+    data->glTexSubImage2D(target, 0, xoffset, yoffset, width, height, format, type, src);
+    SDL_free(blob);
+    return 0;
+}
+
+static int
+GLES2_UpdateTexture(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_Rect *rect,
+                    const void *pixels, int pitch)
+{
+    GLES2_DriverContext *data = (GLES2_DriverContext *)renderer->driverdata;
+    GLES2_TextureData *tdata = (GLES2_TextureData *)texture->driverdata;
+
+    GLES2_ActivateRenderer(renderer);
+
+    /* Bail out if we're supposed to update an empty rectangle */
+    if (rect->w <= 0 || rect->h <= 0)
+        return 0;
+
     /* Create a texture subimage with the supplied data */
     data->glBindTexture(tdata->texture_type, tdata->texture);
-    data->glTexSubImage2D(tdata->texture_type,
-                    0,
+    if (GLES2_TexSubImage2D(data, tdata->texture_type,
                     rect->x,
                     rect->y,
                     rect->w,
                     rect->h,
                     tdata->pixel_format,
                     tdata->pixel_type,
-                    src);
-    SDL_free(blob);
+                    pixels, pitch, SDL_BYTESPERPIXEL(texture->format)) < 0) {
+        return -1;
+    }
+
+    if (tdata->nv12) {
+        /* The U/V plane follows with the same pitch, and goes up as it is */
+        pixels = (const Uint8 *)pixels + rect->h * pitch;
+        data->glBindTexture(tdata->texture_type, tdata->texture_u);
+        if (GLES2_TexSubImage2D(data, tdata->texture_type,
+                    rect->x / 2,
+                    rect->y / 2,
+                    rect->w / 2,
+                    rect->h / 2,
+                    GL_LUMINANCE_ALPHA,
+                    GL_UNSIGNED_BYTE,
+                    pixels, pitch, 2) < 0) {
+            return -1;
+        }
+    }
 
     return GL_CheckError("glTexSubImage2D()", renderer);
 }
@@ -638,6 +728,9 @@ GLES2_DestroyTexture(SDL_Renderer *renderer, SDL_Texture *texture)
     if (tdata)
     {
         data->glDeleteTextures(1, &tdata->texture);
+        if (tdata->nv12) {
+            data->glDeleteTextures(1, &tdata->texture_u);
+        }
         SDL_free(tdata->pixel_data);
         SDL_free(tdata);
         texture->driverdata = NULL;
@@ -729,6 +822,8 @@ GLES2_CacheProgram(SDL_Renderer *renderer, GLES2_ShaderCacheEntry *vertex,
         data->glGetUniformLocation(entry->id, "u_modulation");
     entry->uniform_locations[GLES2_UNIFORM_COLOR] =
         data->glGetUniformLocation(entry->id, "u_color");
+    entry->uniform_locations[GLES2_UNIFORM_TEXTURE_U] =
+        data->glGetUniformLocation(entry->id, "u_texture_u");
 
     entry->modulation_r = entry->modulation_g = entry->modulation_b = entry->modulation_a = 255;
     entry->color_r = entry->color_g = entry->color_b = entry->color_a = 255;
@@ -736,6 +831,7 @@ GLES2_CacheProgram(SDL_Renderer *renderer, GLES2_ShaderCacheEntry *vertex,
     data->glUseProgram(entry->id);
     data->glUniformMatrix4fv(entry->uniform_locations[GLES2_UNIFORM_PROJECTION], 1, GL_FALSE, (GLfloat *)entry->projection);
     data->glUniform1i(entry->uniform_locations[GLES2_UNIFORM_TEXTURE], 0);  /* always texture unit 0. */
+    data->glUniform1i(entry->uniform_locations[GLES2_UNIFORM_TEXTURE_U], 1);  /* the U/V plane, if any */
     data->glUniform4f(entry->uniform_locations[GLES2_UNIFORM_MODULATION], 1.0f, 1.0f, 1.0f, 1.0f);
     data->glUniform4f(entry->uniform_locations[GLES2_UNIFORM_COLOR], 1.0f, 1.0f, 1.0f, 1.0f);
 
@@ -927,6 +1023,12 @@ GLES2_SelectProgram(SDL_Renderer *renderer, GLES2_ImageSource source, SDL_BlendM
     case GLES2_IMAGESOURCE_TEXTURE_BGR:
         ftype = GLES2_SHADER_FRAGMENT_TEXTURE_BGR_SRC;
         break;
+    case GLES2_IMAGESOURCE_TEXTURE_NV12:
+        ftype = GLES2_SHADER_FRAGMENT_TEXTURE_NV12_SRC;
+        break;
+    case GLES2_IMAGESOURCE_TEXTURE_NV21:
+        ftype = GLES2_SHADER_FRAGMENT_TEXTURE_NV21_SRC;
+        break;
     default:
         goto fault;
     }
@@ -1029,6 +1131,8 @@ static int GLES2_RenderDrawLines(SDL_Renderer *renderer, const SDL_FPoint *point
 static int GLES2_RenderFillRects(SDL_Renderer *renderer, const SDL_FRect *rects, int count);
 static int GLES2_RenderCopy(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_Rect *srcrect,
                             const SDL_FRect *dstrect);
+static int GLES2_RenderCopyBatch(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_Rect *srcrects,
+                                 const SDL_FRect *dstrects, int count);
 static int GLES2_RenderCopyEx(SDL_Renderer * renderer, SDL_Texture * texture,
                          const SDL_Rect * srcrect, const SDL_FRect * dstrect,
                          const double angle, const SDL_FPoint *center, const SDL_RendererFlip flip);
@@ -1126,6 +1230,60 @@ GLES2_SetTexCoords(GLES2_DriverContext * data, SDL_bool enabled)
     }
 }
 
+/* Get room for the given number of floats in the vertex scratch space */
+static GLfloat *
+GLES2_GetVertices(GLES2_DriverContext *data, int count)
+{
+    if (count > data->vertices_size) {
+        GLfloat *vertices = (GLfloat *)SDL_realloc(data->vertices, count * sizeof(GLfloat));
+        if (!vertices) {
+            SDL_OutOfMemory();
+            return NULL;
+        }
+        data->vertices = vertices;
+        data->vertices_size = count;
+    }
+    return data->vertices;
+}
+
+/* Copy vertex data into the streaming buffer, and point an attribute at it */
+static void
+GLES2_UpdateVertexBuffer(SDL_Renderer *renderer, GLES2_Attribute attr, GLint size,
+                         const GLfloat *vertexData, int count)
+{
+    GLES2_DriverContext *data = (GLES2_DriverContext *)renderer->driverdata;
+    GLES2_VertexBuffers *buffers = &data->vertex_buffers;
+    const GLsizeiptr length = count * sizeof(GLfloat);
+
+    if (!buffers->ids[0]) {
+        data->glGenBuffers(GLES2_VERTEX_BUFFERS, buffers->ids);
+    }
+    if (!buffers->bound) {
+        data->glBindBuffer(GL_ARRAY_BUFFER, buffers->ids[buffers->current]);
+        buffers->bound = SDL_TRUE;
+    }
+
+    if (buffers->offset + length > buffers->sizes[buffers->current]) {
+        if (buffers->offset > 0) {
+            /* This buffer is full, move on to the next one */
+            buffers->current = (buffers->current + 1) % GLES2_VERTEX_BUFFERS;
+            buffers->offset = 0;
+            data->glBindBuffer(GL_ARRAY_BUFFER, buffers->ids[buffers->current]);
+        }
+        if (length > buffers->sizes[buffers->current]) {
+            buffers->sizes[buffers->current] = SDL_max(GLES2_VERTEX_BUFFER_SIZE, length);
+        }
+    }
+    if (buffers->offset == 0) {
+        /* Orphan the old contents, which may still be in use by the GPU */
+        data->glBufferData(GL_ARRAY_BUFFER, buffers->sizes[buffers->current], NULL, GL_STREAM_DRAW);
+    }
+
+    data->glBufferSubData(GL_ARRAY_BUFFER, buffers->offset, length, vertexData);
+    data->glVertexAttribPointer(attr, size, GL_FLOAT, GL_FALSE, 0, (const GLvoid *)(uintptr_t)buffers->offset);
+    buffers->offset += length;
+}
+
 static int
 GLES2_SetDrawingState(SDL_Renderer * renderer)
 {
@@ -1184,7 +1342,10 @@ GLES2_RenderDrawPoints(SDL_Renderer *renderer, const SDL_FPoint *points, int cou
     }
 
     /* Emit the specified vertices as points */
-    vertices = SDL_stack_alloc(GLfloat, count * 2);
+    vertices = GLES2_GetVertices(data, count * 2);
+    if (!vertices) {
+        return -1;
+    }
     for (idx = 0; idx < count; ++idx) {
         GLfloat x = points[idx].x + 0.5f;
         GLfloat y = points[idx].y + 0.5f;
@@ -1192,9 +1353,8 @@ GLES2_RenderDrawPoints(SDL_Renderer *renderer, const SDL_FPoint *points, int cou
         vertices[idx * 2] = x;
         vertices[(idx * 2) + 1] = y;
     }
-    data->glVertexAttribPointer(GLES2_ATTRIBUTE_POSITION, 2, GL_FLOAT, GL_FALSE, 0, vertices);
+    GLES2_UpdateVertexBuffer(renderer, GLES2_ATTRIBUTE_POSITION, 2, vertices, count * 2);
     data->glDrawArrays(GL_POINTS, 0, count);
-    SDL_stack_free(vertices);
     return 0;
 }
 
@@ -1210,7 +1370,10 @@ GLES2_RenderDrawLines(SDL_Renderer *renderer, const SDL_FPoint *points, int coun
     }
 
     /* Emit a line strip including the specified vertices */
-    vertices = SDL_stack_alloc(GLfloat, count * 2);
+    vertices = GLES2_GetVertices(data, count * 2);
+    if (!vertices) {
+        return -1;
+    }
     for (idx = 0; idx < count; ++idx) {
         GLfloat x = points[idx].x + 0.5f;
         GLfloat y = points[idx].y + 0.5f;
@@ -1218,7 +1381,7 @@ GLES2_RenderDrawLines(SDL_Renderer *renderer, const SDL_FPoint *points, int coun
         vertices[idx * 2] = x;
         vertices[(idx * 2) + 1] = y;
     }
-    data->glVertexAttribPointer(GLES2_ATTRIBUTE_POSITION, 2, GL_FLOAT, GL_FALSE, 0, vertices);
+    GLES2_UpdateVertexBuffer(renderer, GLES2_ATTRIBUTE_POSITION, 2, vertices, count * 2);
     data->glDrawArrays(GL_LINE_STRIP, 0, count);
 
     /* We need to close the endpoint of the line */
@@ -1226,55 +1389,63 @@ GLES2_RenderDrawLines(SDL_Renderer *renderer, const SDL_FPoint *points, int coun
         points[0].x != points[count-1].x || points[0].y != points[count-1].y) {
         data->glDrawArrays(GL_POINTS, count-1, 1);
     }
-    SDL_stack_free(vertices);
 
     return GL_CheckError("", renderer);
 }
 
+/* Write the two triangles covering a rectangle */
+SDL_FORCE_INLINE void
+GLES2_EmitQuad(GLfloat *vertices, GLfloat xMin, GLfloat yMin, GLfloat xMax, GLfloat yMax)
+{
+    vertices[0] = xMin;
+    vertices[1] = yMin;
+    vertices[2] = xMax;
+    vertices[3] = yMin;
+    vertices[4] = xMin;
+    vertices[5] = yMax;
+    vertices[6] = xMax;
+    vertices[7] = yMin;
+    vertices[8] = xMax;
+    vertices[9] = yMax;
+    vertices[10] = xMin;
+    vertices[11] = yMax;
+}
+
 static int
 GLES2_RenderFillRects(SDL_Renderer *renderer, const SDL_FRect *rects, int count)
 {
     GLES2_DriverContext *data = (GLES2_DriverContext *)renderer->driverdata;
-    GLfloat vertices[8];
+    GLfloat *vertices;
     int idx;
 
     if (GLES2_SetDrawingState(renderer) < 0) {
         return -1;
     }
 
-    /* Emit a line loop for each rectangle */
+    /* Emit two triangles for each rectangle, all in one draw */
+    vertices = GLES2_GetVertices(data, count * 12);
+    if (!vertices) {
+        return -1;
+    }
     for (idx = 0; idx < count; ++idx) {
         const SDL_FRect *rect = &rects[idx];
 
-        GLfloat xMin = rect->x;
-        GLfloat xMax = (rect->x + rect->w);
-        GLfloat yMin = rect->y;
-        GLfloat yMax = (rect->y + rect->h);
-
-        vertices[0] = xMin;
-        vertices[1] = yMin;
-        vertices[2] = xMax;
-        vertices[3] = yMin;
-        vertices[4] = xMin;
-        vertices[5] = yMax;
-        vertices[6] = xMax;
-        vertices[7] = yMax;
-        data->glVertexAttribPointer(GLES2_ATTRIBUTE_POSITION, 2, GL_FLOAT, GL_FALSE, 0, vertices);
-        data->glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+        GLES2_EmitQuad(&vertices[idx * 12], rect->x, rect->y,
+                       (rect->x + rect->w), (rect->y + rect->h));
     }
+    GLES2_UpdateVertexBuffer(renderer, GLES2_ATTRIBUTE_POSITION, 2, vertices, count * 12);
+    data->glDrawArrays(GL_TRIANGLES, 0, count * 6);
+
     return GL_CheckError("", renderer);
 }
 
 static int
-GLES2_RenderCopy(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_Rect *srcrect,
-                 const SDL_FRect *dstrect)
+GLES2_SetupCopy(SDL_Renderer *renderer, SDL_Texture *texture)
 {
     GLES2_DriverContext *data = (GLES2_DriverContext *)renderer->driverdata;
     GLES2_TextureData *tdata = (GLES2_TextureData *)texture->driverdata;
     GLES2_ImageSource sourceType = GLES2_IMAGESOURCE_TEXTURE_ABGR;
     SDL_BlendMode blendMode;
-    GLfloat vertices[8];
-    GLfloat texCoords[8];
     GLES2_ProgramCacheEntry *program;
     Uint8 r, g, b, a;
 
@@ -1339,6 +1510,12 @@ GLES2_RenderCopy(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_Rect *s
                         break;
                 }
                 break;
+            case SDL_PIXELFORMAT_NV12:
+                sourceType = GLES2_IMAGESOURCE_TEXTURE_NV12;
+                break;
+            case SDL_PIXELFORMAT_NV21:
+                sourceType = GLES2_IMAGESOURCE_TEXTURE_NV21;
+                break;
             }
         }
         else sourceType = GLES2_IMAGESOURCE_TEXTURE_ABGR;   /* Texture formats match, use the non color mapping shader (even if the formats are not ABGR) */
@@ -1358,6 +1535,12 @@ GLES2_RenderCopy(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_Rect *s
             case SDL_PIXELFORMAT_RGB888:
                 sourceType = GLES2_IMAGESOURCE_TEXTURE_RGB;
                 break;
+            case SDL_PIXELFORMAT_NV12:
+                sourceType = GLES2_IMAGESOURCE_TEXTURE_NV12;
+                break;
+            case SDL_PIXELFORMAT_NV21:
+                sourceType = GLES2_IMAGESOURCE_TEXTURE_NV21;
+                break;
             default:
                 return -1;
         }
@@ -1368,6 +1551,11 @@ GLES2_RenderCopy(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_Rect *s
     }
 
     /* Select the target texture */
+    if (tdata->nv12) {
+        data->glActiveTexture(GL_TEXTURE1);
+        data->glBindTexture(tdata->texture_type, tdata->texture_u);
+        data->glActiveTexture(GL_TEXTURE0);
+    }
     data->glBindTexture(tdata->texture_type, tdata->texture);
 
     /* Configure color modulation */
@@ -1399,6 +1587,21 @@ GLES2_RenderCopy(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_Rect *s
 
     GLES2_SetTexCoords(data, SDL_TRUE);
 
+    return 0;
+}
+
+static int
+GLES2_RenderCopy(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_Rect *srcrect,
+                 const SDL_FRect *dstrect)
+{
+    GLES2_DriverContext *data = (GLES2_DriverContext *)renderer->driverdata;
+    GLfloat vertices[8];
+    GLfloat texCoords[8];
+
+    if (GLES2_SetupCopy(renderer, texture) < 0) {
+        return -1;
+    }
+
     /* Emit the textured quad */
     vertices[0] = dstrect->x;
     vertices[1] = dstrect->y;
@@ -1408,7 +1611,7 @@ GLES2_RenderCopy(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_Rect *s
     vertices[5] = (dstrect->y + dstrect->h);
     vertices[6] = (dstrect->x + dstrect->w);
     vertices[7] = (dstrect->y + dstrect->h);
-    data->glVertexAttribPointer(GLES2_ATTRIBUTE_POSITION, 2, GL_FLOAT, GL_FALSE, 0, vertices);
+    GLES2_UpdateVertexBuffer(renderer, GLES2_ATTRIBUTE_POSITION, 2, vertices, 8);
     texCoords[0] = srcrect->x / (GLfloat)texture->w;
     texCoords[1] = srcrect->y / (GLfloat)texture->h;
     texCoords[2] = (srcrect->x + srcrect->w) / (GLfloat)texture->w;
@@ -1417,12 +1620,50 @@ GLES2_RenderCopy(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_Rect *s
     texCoords[5] = (srcrect->y + srcrect->h) / (GLfloat)texture->h;
     texCoords[6] = (srcrect->x + srcrect->w) / (GLfloat)texture->w;
     texCoords[7] = (srcrect->y + srcrect->h) / (GLfloat)texture->h;
-    data->glVertexAttribPointer(GLES2_ATTRIBUTE_TEXCOORD, 2, GL_FLOAT, GL_FALSE, 0, texCoords);
+    GLES2_UpdateVertexBuffer(renderer, GLES2_ATTRIBUTE_TEXCOORD, 2, texCoords, 8);
     data->glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
 
     return GL_CheckError("", renderer);
 }
 
+static int
+GLES2_RenderCopyBatch(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_Rect *srcrects,
+                      const SDL_FRect *dstrects, int count)
+{
+    GLES2_DriverContext *data = (GLES2_DriverContext *)renderer->driverdata;
+    GLfloat *vertices;
+    GLfloat *texCoords;
+    int idx;
+
+    if (GLES2_SetupCopy(renderer, texture) < 0) {
+        return -1;
+    }
+
+    /* Emit two textured triangles for each copy, all in one draw */
+    vertices = GLES2_GetVertices(data, count * 24);
+    if (!vertices) {
+        return -1;
+    }
+    texCoords = &vertices[count * 12];
+    for (idx = 0; idx < count; ++idx) {
+        const SDL_Rect *srcrect = &srcrects[idx];
+        const SDL_FRect *dstrect = &dstrects[idx];
+
+        GLES2_EmitQuad(&vertices[idx * 12], dstrect->x, dstrect->y,
+                       (dstrect->x + dstrect->w), (dstrect->y + dstrect->h));
+        GLES2_EmitQuad(&texCoords[idx * 12],
+                       srcrect->x / (GLfloat)texture->w,
+                       srcrect->y / (GLfloat)texture->h,
+                       (srcrect->x + srcrect->w) / (GLfloat)texture->w,
+                       (srcrect->y + srcrect->h) / (GLfloat)texture->h);
+    }
+    GLES2_UpdateVertexBuffer(renderer, GLES2_ATTRIBUTE_POSITION, 2, vertices, count * 12);
+    GLES2_UpdateVertexBuffer(renderer, GLES2_ATTRIBUTE_TEXCOORD, 2, texCoords, count * 12);
+    data->glDrawArrays(GL_TRIANGLES, 0, count * 6);
+
+    return GL_CheckError("", renderer);
+}
+
 static int
 GLES2_RenderCopyEx(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_Rect *srcrect,
                  const SDL_FRect *dstrect, const double angle, const SDL_FPoint *center, const SDL_RendererFlip flip)
@@ -1507,6 +1748,12 @@ GLES2_RenderCopyEx(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_Rect
                         break;
                 }
                 break;
+            case SDL_PIXELFORMAT_NV12:
+                sourceType = GLES2_IMAGESOURCE_TEXTURE_NV12;
+                break;
+            case SDL_PIXELFORMAT_NV21:
+                sourceType = GLES2_IMAGESOURCE_TEXTURE_NV21;
+                break;
             }
         }
         else sourceType = GLES2_IMAGESOURCE_TEXTURE_ABGR;   /* Texture formats match, use the non color mapping shader (even if the formats are not ABGR) */
@@ -1526,6 +1773,12 @@ GLES2_RenderCopyEx(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_Rect
             case SDL_PIXELFORMAT_RGB888:
                 sourceType = GLES2_IMAGESOURCE_TEXTURE_RGB;
                 break;
+            case SDL_PIXELFORMAT_NV12:
+                sourceType = GLES2_IMAGESOURCE_TEXTURE_NV12;
+                break;
+            case SDL_PIXELFORMAT_NV21:
+                sourceType = GLES2_IMAGESOURCE_TEXTURE_NV21;
+                break;
             default:
                 return -1;
         }
@@ -1534,6 +1787,11 @@ GLES2_RenderCopyEx(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_Rect
         return -1;
 
     /* Select the target texture */
+    if (tdata->nv12) {
+        data->glActiveTexture(GL_TEXTURE1);
+        data->glBindTexture(tdata->texture_type, tdata->texture_u);
+        data->glActiveTexture(GL_TEXTURE0);
+    }
     data->glBindTexture(tdata->texture_type, tdata->texture);
 
     /* Configure color modulation */
@@ -1586,9 +1844,9 @@ GLES2_RenderCopyEx(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_Rect
         vertices[5] = vertices[7] = tmp;
     }
 
-    data->glVertexAttribPointer(GLES2_ATTRIBUTE_ANGLE, 1, GL_FLOAT, GL_FALSE, 0, &fAngle);
-    data->glVertexAttribPointer(GLES2_ATTRIBUTE_CENTER, 2, GL_FLOAT, GL_FALSE, 0, translate);
-    data->glVertexAttribPointer(GLES2_ATTRIBUTE_POSITION, 2, GL_FLOAT, GL_FALSE, 0, vertices);
+    GLES2_UpdateVertexBuffer(renderer, GLES2_ATTRIBUTE_ANGLE, 1, fAngle, 4);
+    GLES2_UpdateVertexBuffer(renderer, GLES2_ATTRIBUTE_CENTER, 2, translate, 8);
+    GLES2_UpdateVertexBuffer(renderer, GLES2_ATTRIBUTE_POSITION, 2, vertices, 8);
 
     texCoords[0] = srcrect->x / (GLfloat)texture->w;
     texCoords[1] = srcrect->y / (GLfloat)texture->h;
@@ -1598,7 +1856,7 @@ GLES2_RenderCopyEx(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_Rect
     texCoords[5] = (srcrect->y + srcrect->h) / (GLfloat)texture->h;
     texCoords[6] = (srcrect->x + srcrect->w) / (GLfloat)texture->w;
     texCoords[7] = (srcrect->y + srcrect->h) / (GLfloat)texture->h;
-    data->glVertexAttribPointer(GLES2_ATTRIBUTE_TEXCOORD, 2, GL_FLOAT, GL_FALSE, 0, texCoords);
+    GLES2_UpdateVertexBuffer(renderer, GLES2_ATTRIBUTE_TEXCOORD, 2, texCoords, 8);
     data->glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
     data->glDisableVertexAttribArray(GLES2_ATTRIBUTE_CENTER);
     data->glDisableVertexAttribArray(GLES2_ATTRIBUTE_ANGLE);
@@ -1660,8 +1918,18 @@ GLES2_RenderReadPixels(SDL_Renderer * renderer, const SDL_Rect * rect,
 static void
 GLES2_RenderPresent(SDL_Renderer *renderer)
 {
+    GLES2_DriverContext *data = (GLES2_DriverContext *)renderer->driverdata;
+    GLES2_VertexBuffers *buffers = &data->vertex_buffers;
+
     GLES2_ActivateRenderer(renderer);
 
+    /* Start the next frame's vertex data in a fresh buffer */
+    if (buffers->offset > 0) {
+        buffers->current = (buffers->current + 1) % GLES2_VERTEX_BUFFERS;
+        buffers->offset = 0;
+        buffers->bound = SDL_FALSE;
+    }
+
     /* Tell the video driver to swap buffers */
     SDL_GL_SwapWindow(renderer->window);
 }
@@ -1679,6 +1947,17 @@ static int GLES2_BindTexture (SDL_Renderer * renderer, SDL_Texture *texture, flo
     GLES2_TextureData *texturedata = (GLES2_TextureData *)texture->driverdata;
     GLES2_ActivateRenderer(renderer);
 
+    /* The application may draw from client-side arrays */
+    if (data->vertex_buffers.bound) {
+        data->glBindBuffer(GL_ARRAY_BUFFER, 0);
+        data->vertex_buffers.bound = SDL_FALSE;
+    }
+
+    if (texturedata->nv12) {
+        data->glActiveTexture(GL_TEXTURE1);
+        data->glBindTexture(texturedata->texture_type, texturedata->texture_u);
+        data->glActiveTexture(GL_TEXTURE0);
+    }
     data->glBindTexture(texturedata->texture_type, texturedata->texture);
 
     if(texw) *texw = 1.0;
@@ -1879,6 +2158,7 @@ GLES2_CreateRenderer(SDL_Window *window, Uint32 flags)
     renderer->RenderDrawLines     = &GLES2_RenderDrawLines;
     renderer->RenderFillRects     = &GLES2_RenderFillRects;
     renderer->RenderCopy          = &GLES2_RenderCopy;
+    renderer->RenderCopyBatch     = &GLES2_RenderCopyBatch;
     renderer->RenderCopyEx        = &GLES2_RenderCopyEx;
     renderer->RenderReadPixels    = &GLES2_RenderReadPixels;
     renderer->RenderPresent       = &GLES2_RenderPresent;
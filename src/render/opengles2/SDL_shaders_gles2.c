@@ -126,6 +126,68 @@ static const Uint8 GLES2_FragmentSrc_TextureBGRSrc_[] = " \
     } \
 ";
 
+/* NV12 (Y plane, then interleaved U/V) to ABGR conversion */
+static const Uint8 GLES2_FragmentSrc_TextureNV12Src_[] = " \
+    precision mediump float; \
+    uniform sampler2D u_texture; \
+    uniform sampler2D u_texture_u; \
+    uniform vec4 u_modulation; \
+    varying vec2 v_texCoord; \
+    \
+    const vec3 offset = vec3(-0.0625, -0.5, -0.5); \
+    const vec3 Rcoeff = vec3(1.164,  0.000,  1.596); \
+    const vec3 Gcoeff = vec3(1.164, -0.391, -0.813); \
+    const vec3 Bcoeff = vec3(1.164,  2.018,  0.000); \
+    \
+    void main() \
+    { \
+        mediump vec3 yuv; \
+        lowp vec3 rgb; \
+        \
+        yuv.x = texture2D(u_texture, v_texCoord).r; \
+        yuv.yz = texture2D(u_texture_u, v_texCoord).ra; \
+        \
+        yuv += offset; \
+        rgb.r = dot(yuv, Rcoeff); \
+        rgb.g = dot(yuv, Gcoeff); \
+        rgb.b = dot(yuv, Bcoeff); \
+        \
+        gl_FragColor = vec4(rgb, 1.0); \
+        gl_FragColor *= u_modulation; \
+    } \
+";
+
+/* NV21 (Y plane, then interleaved V/U) to ABGR conversion */
+static const Uint8 GLES2_FragmentSrc_TextureNV21Src_[] = " \
+    precision mediump float; \
+    uniform sampler2D u_texture; \
+    uniform sampler2D u_texture_u; \
+    uniform vec4 u_modulation; \
+    varying vec2 v_texCoord; \
+    \
+    const vec3 offset = vec3(-0.0625, -0.5, -0.5); \
+    const vec3 Rcoeff = vec3(1.164,  0.000,  1.596); \
+    const vec3 Gcoeff = vec3(1.164, -0.391, -0.813); \
+    const vec3 Bcoeff = vec3(1.164,  2.018,  0.000); \
+    \
+    void main() \
+    { \
+        mediump vec3 yuv; \
+        lowp vec3 rgb; \
+        \
+        yuv.x = texture2D(u_texture, v_texCoord).r; \
+        yuv.yz = texture2D(u_texture_u, v_texCoord).ar; \
+        \
+        yuv += offset; \
+        rgb.r = dot(yuv, Rcoeff); \
+        rgb.g = dot(yuv, Gcoeff); \
+        rgb.b = dot(yuv, Bcoeff); \
+        \
+        gl_FragColor = vec4(rgb, 1.0); \
+        gl_FragColor *= u_modulation; \
+    } \
+";
+
 static const GLES2_ShaderInstance GLES2_VertexSrc_Default = {
     GL_VERTEX_SHADER,
     GLES2_SOURCE_SHADER,
@@ -168,6 +230,20 @@ static const GLES2_ShaderInstance GLES2_FragmentSrc_TextureBGRSrc = {
     GLES2_FragmentSrc_TextureBGRSrc_
 };
 
+static const GLES2_ShaderInstance GLES2_FragmentSrc_TextureNV12Src = {
+    GL_FRAGMENT_SHADER,
+    GLES2_SOURCE_SHADER,
+    sizeof(GLES2_FragmentSrc_TextureNV12Src_),
+    GLES2_FragmentSrc_TextureNV12Src_
+};
+
+static const GLES2_ShaderInstance GLES2_FragmentSrc_TextureNV21Src = {
+    GL_FRAGMENT_SHADER,
+    GLES2_SOURCE_SHADER,
+    sizeof(GLES2_FragmentSrc_TextureNV21Src_),
+    GLES2_FragmentSrc_TextureNV21Src_
+};
+
 /*************************************************************************************************
  * Vertex/fragment shader binaries (NVIDIA Tegra 1/2)                                            *
  *************************************************************************************************/
@@ -692,6 +768,62 @@ static GLES2_Shader GLES2_FragmentShader_Modulated_TextureBGRSrc = {
     }
 };
 
+static GLES2_Shader GLES2_FragmentShader_None_TextureNV12Src = {
+    1,
+    {
+        &GLES2_FragmentSrc_TextureNV12Src
+    }
+};
+
+static GLES2_Shader GLES2_FragmentShader_Alpha_TextureNV12Src = {
+    1,
+    {
+        &GLES2_FragmentSrc_TextureNV12Src
+    }
+};
+
+static GLES2_Shader GLES2_FragmentShader_Additive_TextureNV12Src = {
+    1,
+    {
+        &GLES2_FragmentSrc_TextureNV12Src
+    }
+};
+
+static GLES2_Shader GLES2_FragmentShader_Modulated_TextureNV12Src = {
+    1,
+    {
+        &GLES2_FragmentSrc_TextureNV12Src
+    }
+};
+
+static GLES2_Shader GLES2_FragmentShader_None_TextureNV21Src = {
+    1,
+    {
+        &GLES2_FragmentSrc_TextureNV21Src
+    }
+};
+
+static GLES2_Shader GLES2_FragmentShader_Alpha_TextureNV21Src = {
+    1,
+    {
+        &GLES2_FragmentSrc_TextureNV21Src
+    }
+};
+
+static GLES2_Shader GLES2_FragmentShader_Additive_TextureNV21Src = {
+    1,
+    {
+        &GLES2_FragmentSrc_TextureNV21Src
+    }
+};
+
+static GLES2_Shader GLES2_FragmentShader_Modulated_TextureNV21Src = {
+    1,
+    {
+        &GLES2_FragmentSrc_TextureNV21Src
+    }
+};
+
 /*************************************************************************************************
  * Shader selector                                                                               *
  *************************************************************************************************/
@@ -775,6 +907,36 @@ const GLES2_Shader *GLES2_GetShader(GLES2_ShaderType type, SDL_BlendMode blendMo
             return NULL;
     }
 
+    case GLES2_SHADER_FRAGMENT_TEXTURE_NV12_SRC:
+        switch (blendMode)
+    {
+        case SDL_BLENDMODE_NONE:
+            return &GLES2_FragmentShader_None_TextureNV12Src;
+        case SDL_BLENDMODE_BLEND:
+            return &GLES2_FragmentShader_Alpha_TextureNV12Src;
+        case SDL_BLENDMODE_ADD:
+            return &GLES2_FragmentShader_Additive_TextureNV12Src;
+        case SDL_BLENDMODE_MOD:
+            return &GLES2_FragmentShader_Modulated_TextureNV12Src;
+        default:
+            return NULL;
+    }
+
+    case GLES2_SHADER_FRAGMENT_TEXTURE_NV21_SRC:
+        switch (blendMode)
+    {
+        case SDL_BLENDMODE_NONE:
+            return &GLES2_FragmentShader_None_TextureNV21Src;
+        case SDL_BLENDMODE_BLEND:
+            return &GLES2_FragmentShader_Alpha_TextureNV21Src;
+        case SDL_BLENDMODE_ADD:
+            return &GLES2_FragmentShader_Additive_TextureNV21Src;
+        case SDL_BLENDMODE_MOD:
+            return &GLES2_FragmentShader_Modulated_TextureNV21Src;
+        default:
+            return NULL;
+    }
+
     default:
         return NULL;
     }
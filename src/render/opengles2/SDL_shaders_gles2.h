@@ -46,7 +46,9 @@ typedef enum
     GLES2_SHADER_FRAGMENT_TEXTURE_ABGR_SRC,
     GLES2_SHADER_FRAGMENT_TEXTURE_ARGB_SRC,
     GLES2_SHADER_FRAGMENT_TEXTURE_BGR_SRC,
-    GLES2_SHADER_FRAGMENT_TEXTURE_RGB_SRC
+    GLES2_SHADER_FRAGMENT_TEXTURE_RGB_SRC,
+    GLES2_SHADER_FRAGMENT_TEXTURE_NV12_SRC,
+    GLES2_SHADER_FRAGMENT_TEXTURE_NV21_SRC
 } GLES2_ShaderType;
 
 #define GLES2_SOURCE_SHADER (GLenum)-1
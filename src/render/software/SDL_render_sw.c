@@ -33,6 +33,9 @@
 #include "SDL_drawline.h"
 #include "SDL_drawpoint.h"
 #include "SDL_rotate.h"
+#include "../../video/SDL_pixels_c.h"
+#include "../../video/SDL_stretch_c.h"
+#include "../../thread/SDL_threadpool_c.h"
 
 /* SDL surface based renderer implementation */
 
@@ -95,12 +98,67 @@ SDL_RenderDriver SW_RenderDriver = {
      0}
 };
 
+/* The size of the tiles a recorded frame is split into */
+#define SW_TILE_WIDTH   128
+#define SW_TILE_HEIGHT  64
+
+typedef enum
+{
+    SW_DRAW_FILL,
+    SW_DRAW_POINTS,
+    SW_DRAW_COPY
+} SW_DrawType;
+
+/* A draw recorded to be done later, with everything it depends on */
+typedef struct
+{
+    SW_DrawType type;
+    SDL_Rect bounds;            /* Everything the draw touches, clipped */
+    SDL_BlendMode blendMode;
+    Uint8 r, g, b, a;
+    Uint32 color;               /* The mapped color for SDL_BLENDMODE_NONE */
+    int first;                  /* The rects or points it uses */
+    int count;
+    SDL_Texture *texture;       /* The copy source, 0 count if it can't be */
+    SDL_Rect srcrect;           /* The part of the source copied to bounds */
+} SW_DrawCommand;
+
 typedef struct
 {
     SDL_Surface *surface;
     SDL_Surface *window;
+
+    /* Drawing is recorded instead of done right away when threads != 1 */
+    int threads;
+    SW_DrawCommand *commands;
+    int num_commands;
+    int max_commands;
+    SDL_Rect *rects;
+    int num_rects;
+    int max_rects;
+    SDL_Point *points;
+    int num_points;
+    int max_points;
+
+    /* The commands touching each tile, tile_cmds[tile_first[i]] onwards */
+    int tiles_x;
+    int num_tiles;
+    int *tile_first;
+    int max_tiles;
+    int *tile_cmds;
+    int max_tile_cmds;
+
+    /* The copy sources set up for the run of commands being prepared: a
+       hash table on the texture of the first command to use each, plus 1 */
+    int *sources;
+    int max_sources;
+
+    /* A row of texture pixels for SW_RenderCopyEx() to blit from */
+    SDL_Surface *span;
 } SW_RenderData;
 
+static int SW_FlushCommands(SW_RenderData * data);
+
 
 static SDL_Surface *
 SW_ActivateRenderer(SDL_Renderer * renderer)
@@ -127,6 +185,7 @@ SW_CreateRendererForSurface(SDL_Surface * surface)
 {
     SDL_Renderer *renderer;
     SW_RenderData *data;
+    const char *hint;
 
     if (!surface) {
         SDL_SetError("Can't create renderer for NULL surface");
@@ -146,6 +205,12 @@ SW_CreateRendererForSurface(SDL_Surface * surface)
         return NULL;
     }
     data->surface = surface;
+    data->window = surface;
+    data->threads = 1;
+    hint = SDL_GetHint(SDL_HINT_RENDER_SOFTWARE_THREADS);
+    if (hint) {
+        data->threads = SDL_max(SDL_atoi(hint), 0);
+    }
 
     renderer->WindowEvent = SW_WindowEvent;
     renderer->GetOutputSize = SW_GetOutputSize;
@@ -195,6 +260,7 @@ SW_WindowEvent(SDL_Renderer * renderer, const SDL_WindowEvent *event)
     SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
 
     if (event->event == SDL_WINDOWEVENT_SIZE_CHANGED) {
+        SW_FlushCommands(data);
         data->surface = NULL;
         data->window = NULL;
     }
@@ -279,6 +345,8 @@ SW_UpdateTexture(SDL_Renderer * renderer, SDL_Texture * texture,
     int row;
     size_t length;
 
+    SW_FlushCommands((SW_RenderData *) renderer->driverdata);
+
     if(SDL_MUSTLOCK(surface))
         SDL_LockSurface(surface);
     src = (Uint8 *) pixels;
@@ -302,6 +370,8 @@ SW_LockTexture(SDL_Renderer * renderer, SDL_Texture * texture,
 {
     SDL_Surface *surface = (SDL_Surface *) texture->driverdata;
 
+    SW_FlushCommands((SW_RenderData *) renderer->driverdata);
+
     *pixels =
         (void *) ((Uint8 *) surface->pixels + rect->y * surface->pitch +
                   rect->x * surface->format->BytesPerPixel);
@@ -319,6 +389,8 @@ SW_SetRenderTarget(SDL_Renderer * renderer, SDL_Texture * texture)
 {
     SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
 
+    SW_FlushCommands(data);
+
     if (texture ) {
         data->surface = (SDL_Surface *) texture->driverdata;
     } else {
@@ -357,9 +429,521 @@ SW_UpdateClipRect(SDL_Renderer * renderer)
     return 0;
 }
 
+/* Make room for needed items in a growing array */
+static int
+SW_GrowArray(void **array, int *max, int needed, size_t size)
+{
+    void *newarray;
+    int newmax;
+
+    if (needed <= *max) {
+        return 0;
+    }
+    newmax = SDL_max(*max * 2, 64);
+    while (newmax < needed) {
+        newmax *= 2;
+    }
+    newarray = SDL_realloc(*array, newmax * size);
+    if (!newarray) {
+        return SDL_OutOfMemory();
+    }
+    *array = newarray;
+    *max = newmax;
+    return 0;
+}
+
+static SW_DrawCommand *
+SW_AddCommand(SW_RenderData * data, SW_DrawType type)
+{
+    SW_DrawCommand *cmd;
+
+    if (SW_GrowArray((void **) &data->commands, &data->max_commands,
+                     data->num_commands + 1, sizeof(*cmd)) < 0) {
+        return NULL;
+    }
+
+    cmd = &data->commands[data->num_commands++];
+    SDL_zerop(cmd);
+    cmd->type = type;
+    return cmd;
+}
+
+/* Record the draw color and blend mode of a fill or points */
+static void
+SW_SetCommandColor(SW_DrawCommand * cmd, SDL_Renderer * renderer,
+                   SDL_Surface * surface)
+{
+    cmd->blendMode = renderer->blendMode;
+    cmd->r = renderer->r;
+    cmd->g = renderer->g;
+    cmd->b = renderer->b;
+    cmd->a = renderer->a;
+    cmd->color = SDL_MapRGBA(surface->format, cmd->r, cmd->g, cmd->b, cmd->a);
+}
+
+static int
+SW_SetSurfaceState(SDL_Surface * surface, Uint8 r, Uint8 g, Uint8 b, Uint8 a,
+                   SDL_BlendMode blendMode)
+{
+    if (SDL_SetSurfaceColorMod(surface, r, g, b) < 0 ||
+        SDL_SetSurfaceAlphaMod(surface, a) < 0 ||
+        SDL_SetSurfaceBlendMode(surface, blendMode) < 0) {
+        return -1;
+    }
+    return 0;
+}
+
+/* Set up a copy source the way SDL_UpperBlit() and SDL_LowerBlit() would,
+   so it can be blitted from several threads without changing */
+static int
+SW_PrepareCopy(SW_DrawCommand * cmd, SDL_Surface * surface)
+{
+    SDL_Surface *src = (SDL_Surface *) cmd->texture->driverdata;
+
+    if (SW_SetSurfaceState(src, cmd->r, cmd->g, cmd->b, cmd->a,
+                           cmd->blendMode) < 0) {
+        return -1;
+    }
+    if (src->map->info.flags & SDL_COPY_NEAREST) {
+        src->map->info.flags &= ~SDL_COPY_NEAREST;
+        SDL_InvalidateMap(src->map);
+    }
+    if ((src->map->dst != surface) ||
+        (surface->format->palette &&
+         src->map->dst_palette_version != surface->format->palette->version) ||
+        (src->format->palette &&
+         src->map->src_palette_version != src->format->palette->version)) {
+        if (SDL_MapSurface(src, surface) < 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/* Find the slot for a texture in the table of sources for this run */
+static int *
+SW_FindSource(SW_RenderData * data, int mask, SDL_Texture * texture)
+{
+    int i = (int) ((((size_t) texture >> 4) * 2654435761u) & mask);
+
+    while (data->sources[i] &&
+           data->commands[data->sources[i] - 1].texture != texture) {
+        i = (i + 1) & mask;
+    }
+    return &data->sources[i];
+}
+
+/* Get the copies from start onwards ready to draw, up to the first one that
+   needs a source in a different state than an earlier one, and return the
+   end of that run of commands. */
+static int
+SW_PrepareCommands(SW_RenderData * data, int start)
+{
+    SW_DrawCommand *cmd;
+    SW_DrawCommand *owner;
+    int *source;
+    int size, end;
+
+    /* Keep the table at most half full */
+    size = 64;
+    while (size < 2 * (data->num_commands - start)) {
+        size *= 2;
+    }
+    if (SW_GrowArray((void **) &data->sources, &data->max_sources, size,
+                     sizeof(int)) < 0) {
+        /* Without the table, each command is a run of its own */
+        cmd = &data->commands[start];
+        if (cmd->type == SW_DRAW_COPY &&
+            SW_PrepareCopy(cmd, data->surface) < 0) {
+            cmd->count = 0;
+        }
+        return start + 1;
+    }
+    SDL_memset(data->sources, 0, size * sizeof(int));
+
+    for (end = start; end < data->num_commands; ++end) {
+        cmd = &data->commands[end];
+        if (cmd->type != SW_DRAW_COPY) {
+            continue;
+        }
+        source = SW_FindSource(data, size - 1, cmd->texture);
+        if (!*source) {
+            if (SW_PrepareCopy(cmd, data->surface) < 0) {
+                cmd->count = 0;
+            }
+            *source = end + 1;
+            continue;
+        }
+        owner = &data->commands[*source - 1];
+        if (owner->r != cmd->r || owner->g != cmd->g ||
+            owner->b != cmd->b || owner->a != cmd->a ||
+            owner->blendMode != cmd->blendMode) {
+            break;
+        }
+        cmd->count = owner->count;
+    }
+    return end;
+}
+
+/* Sort the commands from start to end into the tiles they touch, keeping
+   them in order within each tile */
+static int
+SW_BinCommands(SW_RenderData * data, int start, int end)
+{
+    SDL_Surface *surface = data->surface;
+    SW_DrawCommand *cmd;
+    int *tile_first, *tile_cmds;
+    int i, x, y, x1, y1, x2, y2;
+
+    data->tiles_x = (surface->w + SW_TILE_WIDTH - 1) / SW_TILE_WIDTH;
+    data->num_tiles = data->tiles_x *
+        ((surface->h + SW_TILE_HEIGHT - 1) / SW_TILE_HEIGHT);
+    if (SW_GrowArray((void **) &data->tile_first, &data->max_tiles,
+                     data->num_tiles + 1, sizeof(int)) < 0) {
+        return -1;
+    }
+    tile_first = data->tile_first;
+    SDL_memset(tile_first, 0, (data->num_tiles + 1) * sizeof(int));
+
+    /* Count the commands in each tile, then turn that into offsets */
+    for (i = start; i < end; ++i) {
+        cmd = &data->commands[i];
+        x1 = cmd->bounds.x / SW_TILE_WIDTH;
+        y1 = cmd->bounds.y / SW_TILE_HEIGHT;
+        x2 = (cmd->bounds.x + cmd->bounds.w - 1) / SW_TILE_WIDTH;
+        y2 = (cmd->bounds.y + cmd->bounds.h - 1) / SW_TILE_HEIGHT;
+        for (y = y1; y <= y2; ++y) {
+            for (x = x1; x <= x2; ++x) {
+                ++tile_first[y * data->tiles_x + x + 1];
+            }
+        }
+    }
+    for (i = 0; i < data->num_tiles; ++i) {
+        tile_first[i + 1] += tile_first[i];
+    }
+    if (SW_GrowArray((void **) &data->tile_cmds, &data->max_tile_cmds,
+                     tile_first[data->num_tiles], sizeof(int)) < 0) {
+        return -1;
+    }
+    tile_cmds = data->tile_cmds;
+
+    /* Fill the tiles in using the offsets of the tiles before them, which
+       leaves each offset where the next tile's commands start */
+    for (i = start; i < end; ++i) {
+        cmd = &data->commands[i];
+        x1 = cmd->bounds.x / SW_TILE_WIDTH;
+        y1 = cmd->bounds.y / SW_TILE_HEIGHT;
+        x2 = (cmd->bounds.x + cmd->bounds.w - 1) / SW_TILE_WIDTH;
+        y2 = (cmd->bounds.y + cmd->bounds.h - 1) / SW_TILE_HEIGHT;
+        for (y = y1; y <= y2; ++y) {
+            for (x = x1; x <= x2; ++x) {
+                tile_cmds[tile_first[y * data->tiles_x + x]++] = i;
+            }
+        }
+    }
+    for (i = data->num_tiles; i > 0; --i) {
+        tile_first[i] = tile_first[i - 1];
+    }
+    tile_first[0] = 0;
+    return 0;
+}
+
+/* Draw the part of a recorded command inside area */
+static void
+SW_RunCommand(SW_RenderData * data, const SW_DrawCommand * cmd,
+              const SDL_Rect * area)
+{
+    SDL_Surface *surface = data->surface;
+    SDL_Rect rect, srcrect;
+    int i;
+
+    if (!SDL_IntersectRect(&cmd->bounds, area, &rect)) {
+        return;
+    }
+
+    switch (cmd->type) {
+    case SW_DRAW_FILL:
+        for (i = cmd->first; i < cmd->first + cmd->count; ++i) {
+            SDL_Rect fill;
+
+            if (!SDL_IntersectRect(&data->rects[i], &rect, &fill)) {
+                continue;
+            }
+            if (cmd->blendMode == SDL_BLENDMODE_NONE) {
+                SDL_FillRect(surface, &fill, cmd->color);
+            } else {
+                SDL_BlendFillRect(surface, &fill, cmd->blendMode,
+                                  cmd->r, cmd->g, cmd->b, cmd->a);
+            }
+        }
+        break;
+    case SW_DRAW_POINTS:
+        for (i = cmd->first; i < cmd->first + cmd->count; ++i) {
+            const SDL_Point *point = &data->points[i];
+
+            if (point->x < rect.x || point->x >= rect.x + rect.w ||
+                point->y < rect.y || point->y >= rect.y + rect.h) {
+                continue;
+            }
+            if (cmd->blendMode == SDL_BLENDMODE_NONE) {
+                SDL_DrawPoint(surface, point->x, point->y, cmd->color);
+            } else {
+                SDL_BlendPoint(surface, point->x, point->y, cmd->blendMode,
+                               cmd->r, cmd->g, cmd->b, cmd->a);
+            }
+        }
+        break;
+    case SW_DRAW_COPY:
+        if (cmd->count) {
+            SDL_Surface *src = (SDL_Surface *) cmd->texture->driverdata;
+
+            srcrect.x = cmd->srcrect.x + (rect.x - cmd->bounds.x);
+            srcrect.y = cmd->srcrect.y + (rect.y - cmd->bounds.y);
+            srcrect.w = rect.w;
+            srcrect.h = rect.h;
+
+            if (src->flags & SDL_RLEACCEL) {
+                /* This only reads the source */
+                src->map->blit(src, &srcrect, surface, &rect);
+            } else {
+                /* SDL_SoftBlit() keeps the blit info in the shared map, so
+                   run the blit function on a copy of it */
+                SDL_BlitInfo info = src->map->info;
+
+                info.src = (Uint8 *) src->pixels + srcrect.y * src->pitch +
+                    srcrect.x * info.src_fmt->BytesPerPixel;
+                info.src_w = srcrect.w;
+                info.src_h = srcrect.h;
+                info.src_pitch = src->pitch;
+                info.src_skip =
+                    info.src_pitch - info.src_w * info.src_fmt->BytesPerPixel;
+                info.dst = (Uint8 *) surface->pixels + rect.y * surface->pitch +
+                    rect.x * info.dst_fmt->BytesPerPixel;
+                info.dst_w = rect.w;
+                info.dst_h = rect.h;
+                info.dst_pitch = surface->pitch;
+                info.dst_skip =
+                    info.dst_pitch - info.dst_w * info.dst_fmt->BytesPerPixel;
+                ((SDL_BlitFunc) src->map->data) (&info);
+            }
+        }
+        break;
+    }
+}
+
+static void
+SW_DrawTile(void *userdata, int index)
+{
+    SW_RenderData *data = (SW_RenderData *) userdata;
+    SDL_Rect area;
+    int i;
+
+    area.x = (index % data->tiles_x) * SW_TILE_WIDTH;
+    area.y = (index / data->tiles_x) * SW_TILE_HEIGHT;
+    area.w = SDL_min(SW_TILE_WIDTH, data->surface->w - area.x);
+    area.h = SDL_min(SW_TILE_HEIGHT, data->surface->h - area.y);
+
+    for (i = data->tile_first[index]; i < data->tile_first[index + 1]; ++i) {
+        SW_RunCommand(data, &data->commands[data->tile_cmds[i]], &area);
+    }
+}
+
+/* Draw everything that was recorded, a tile per job */
+static int
+SW_FlushCommands(SW_RenderData * data)
+{
+    SDL_Surface *surface = data->surface;
+    SW_DrawCommand *cmd;
+    SDL_Rect clip_rect;
+    int i, start, end, threads, status = 0;
+
+    if (data->num_commands == 0) {
+        return 0;
+    }
+
+    /* Locking isn't thread safe, so surfaces that need it are drawn here */
+    threads = SDL_MUSTLOCK(surface) ? 1 : data->threads;
+
+    /* Everything was clipped when it was recorded */
+    clip_rect = surface->clip_rect;
+    SDL_SetClipRect(surface, NULL);
+    if (SDL_MUSTLOCK(surface)) {
+        SDL_LockSurface(surface);
+    }
+
+    for (start = 0; start < data->num_commands; start = end) {
+        end = SW_PrepareCommands(data, start);
+        if (SW_BinCommands(data, start, end) < 0) {
+            status = -1;
+            break;
+        }
+        SDL_RunParallel(SW_DrawTile, data, data->num_tiles, threads);
+    }
+
+    /* Put the textures back the way the app left them */
+    for (i = 0; i < data->num_commands; ++i) {
+        cmd = &data->commands[i];
+        if (cmd->type == SW_DRAW_COPY) {
+            SW_SetSurfaceState((SDL_Surface *) cmd->texture->driverdata,
+                               cmd->texture->r, cmd->texture->g,
+                               cmd->texture->b, cmd->texture->a,
+                               cmd->texture->blendMode);
+        }
+    }
+
+    if (SDL_MUSTLOCK(surface)) {
+        SDL_UnlockSurface(surface);
+    }
+    SDL_SetClipRect(surface, &clip_rect);
+
+    data->num_commands = 0;
+    data->num_rects = 0;
+    data->num_points = 0;
+    return status;
+}
+
+/* Record points or rects to be drawn in the current color and blend mode */
+static int
+SW_RecordPrimitives(SDL_Renderer * renderer, SDL_Surface * surface,
+                    SW_DrawType type, const SDL_FPoint * points,
+                    const SDL_FRect * rects, int count)
+{
+    SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
+    SW_DrawCommand *cmd;
+    SDL_Rect extent;
+    int i, x = renderer->viewport.x, y = renderer->viewport.y;
+
+    if (count <= 0) {
+        return 0;
+    }
+
+    if (type == SW_DRAW_POINTS) {
+        SDL_Point *final_points;
+
+        if (SW_GrowArray((void **) &data->points, &data->max_points,
+                         data->num_points + count, sizeof(SDL_Point)) < 0) {
+            return -1;
+        }
+        final_points = &data->points[data->num_points];
+        for (i = 0; i < count; ++i) {
+            final_points[i].x = (int)(x + points[i].x);
+            final_points[i].y = (int)(y + points[i].y);
+        }
+        if (!SDL_EnclosePoints(final_points, count, NULL, &extent)) {
+            return 0;
+        }
+    } else {
+        SDL_Rect *final_rects;
+
+        if (SW_GrowArray((void **) &data->rects, &data->max_rects,
+                         data->num_rects + count, sizeof(SDL_Rect)) < 0) {
+            return -1;
+        }
+        final_rects = &data->rects[data->num_rects];
+        for (i = 0; i < count; ++i) {
+            final_rects[i].x = (int)(x + rects[i].x);
+            final_rects[i].y = (int)(y + rects[i].y);
+            final_rects[i].w = SDL_max((int)rects[i].w, 1);
+            final_rects[i].h = SDL_max((int)rects[i].h, 1);
+        }
+        extent = final_rects[0];
+        for (i = 1; i < count; ++i) {
+            SDL_UnionRect(&extent, &final_rects[i], &extent);
+        }
+    }
+
+    if (!SDL_IntersectRect(&extent, &surface->clip_rect, &extent)) {
+        return 0;
+    }
+    cmd = SW_AddCommand(data, type);
+    if (!cmd) {
+        return -1;
+    }
+    SW_SetCommandColor(cmd, renderer, surface);
+    cmd->bounds = extent;
+    cmd->count = count;
+    if (type == SW_DRAW_POINTS) {
+        cmd->first = data->num_points;
+        data->num_points += count;
+    } else {
+        cmd->first = data->num_rects;
+        data->num_rects += count;
+    }
+    return 0;
+}
+
+/* Record an unscaled copy, clipped the way SDL_UpperBlit() would */
+static int
+SW_RecordCopy(SDL_Renderer * renderer, SDL_Surface * surface,
+              SDL_Texture * texture, const SDL_Rect * srcrect,
+              const SDL_Rect * dstrect)
+{
+    SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
+    SDL_Surface *src = (SDL_Surface *) texture->driverdata;
+    const SDL_Rect *clip = &surface->clip_rect;
+    SW_DrawCommand *cmd;
+    SDL_Rect sr = *srcrect, dr = *dstrect;
+    int dx, dy;
+
+    if (sr.x < 0) {
+        sr.w += sr.x;
+        dr.x -= sr.x;
+        sr.x = 0;
+    }
+    sr.w = SDL_min(sr.w, src->w - sr.x);
+    if (sr.y < 0) {
+        sr.h += sr.y;
+        dr.y -= sr.y;
+        sr.y = 0;
+    }
+    sr.h = SDL_min(sr.h, src->h - sr.y);
+
+    dx = clip->x - dr.x;
+    if (dx > 0) {
+        sr.w -= dx;
+        dr.x += dx;
+        sr.x += dx;
+    }
+    dx = dr.x + sr.w - clip->x - clip->w;
+    if (dx > 0) {
+        sr.w -= dx;
+    }
+    dy = clip->y - dr.y;
+    if (dy > 0) {
+        sr.h -= dy;
+        dr.y += dy;
+        sr.y += dy;
+    }
+    dy = dr.y + sr.h - clip->y - clip->h;
+    if (dy > 0) {
+        sr.h -= dy;
+    }
+    if (sr.w <= 0 || sr.h <= 0) {
+        return 0;
+    }
+    dr.w = sr.w;
+    dr.h = sr.h;
+
+    cmd = SW_AddCommand(data, SW_DRAW_COPY);
+    if (!cmd) {
+        return -1;
+    }
+    cmd->bounds = dr;
+    cmd->blendMode = texture->blendMode;
+    cmd->r = texture->r;
+    cmd->g = texture->g;
+    cmd->b = texture->b;
+    cmd->a = texture->a;
+    cmd->count = 1;
+    cmd->texture = texture;
+    cmd->srcrect = sr;
+    return 0;
+}
+
 static int
 SW_RenderClear(SDL_Renderer * renderer)
 {
+    SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
     SDL_Surface *surface = SW_ActivateRenderer(renderer);
     Uint32 color;
     SDL_Rect clip_rect;
@@ -368,6 +952,33 @@ SW_RenderClear(SDL_Renderer * renderer)
         return -1;
     }
 
+    if (data->threads != 1) {
+        SW_DrawCommand *cmd;
+
+        /* Nothing drawn before this would be seen */
+        data->num_commands = 0;
+        data->num_rects = 0;
+        data->num_points = 0;
+
+        cmd = SW_AddCommand(data, SW_DRAW_FILL);
+        if (!cmd) {
+            return -1;
+        }
+        SW_SetCommandColor(cmd, renderer, surface);
+        cmd->blendMode = SDL_BLENDMODE_NONE;
+        cmd->bounds.w = surface->w;
+        cmd->bounds.h = surface->h;
+        cmd->first = 0;
+        cmd->count = 1;
+        if (SW_GrowArray((void **) &data->rects, &data->max_rects,
+                         1, sizeof(SDL_Rect)) < 0) {
+            data->num_commands = 0;
+            return -1;
+        }
+        data->rects[data->num_rects++] = cmd->bounds;
+        return 0;
+    }
+
     color = SDL_MapRGBA(surface->format,
                         renderer->r, renderer->g, renderer->b, renderer->a);
 
@@ -383,6 +994,7 @@ static int
 SW_RenderDrawPoints(SDL_Renderer * renderer, const SDL_FPoint * points,
                     int count)
 {
+    SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
     SDL_Surface *surface = SW_ActivateRenderer(renderer);
     SDL_Point *final_points;
     int i, status;
@@ -391,6 +1003,11 @@ SW_RenderDrawPoints(SDL_Renderer * renderer, const SDL_FPoint * points,
         return -1;
     }
 
+    if (data->threads != 1) {
+        return SW_RecordPrimitives(renderer, surface, SW_DRAW_POINTS,
+                                   points, NULL, count);
+    }
+
     final_points = SDL_stack_alloc(SDL_Point, count);
     if (!final_points) {
         return SDL_OutOfMemory();
@@ -440,6 +1057,9 @@ SW_RenderDrawLines(SDL_Renderer * renderer, const SDL_FPoint * points,
         return -1;
     }
 
+    /* Lines aren't split into tiles, so they're drawn in order right now */
+    SW_FlushCommands((SW_RenderData *) renderer->driverdata);
+
     final_points = SDL_stack_alloc(SDL_Point, count);
     if (!final_points) {
         return SDL_OutOfMemory();
@@ -480,6 +1100,7 @@ SW_RenderDrawLines(SDL_Renderer * renderer, const SDL_FPoint * points,
 static int
 SW_RenderFillRects(SDL_Renderer * renderer, const SDL_FRect * rects, int count)
 {
+    SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
     SDL_Surface *surface = SW_ActivateRenderer(renderer);
     SDL_Rect *final_rects;
     int i, status;
@@ -488,6 +1109,11 @@ SW_RenderFillRects(SDL_Renderer * renderer, const SDL_FRect * rects, int count)
         return -1;
     }
 
+    if (data->threads != 1) {
+        return SW_RecordPrimitives(renderer, surface, SW_DRAW_FILL,
+                                   NULL, rects, count);
+    }
+
     final_rects = SDL_stack_alloc(SDL_Rect, count);
     if (!final_rects) {
         return SDL_OutOfMemory();
@@ -527,10 +1153,23 @@ SW_RenderFillRects(SDL_Renderer * renderer, const SDL_FRect * rects, int count)
     return status;
 }
 
+static int
+GetScaleQuality(void)
+{
+    const char *hint = SDL_GetHint(SDL_HINT_RENDER_SCALE_QUALITY);
+
+    if (!hint || *hint == '0' || SDL_strcasecmp(hint, "nearest") == 0) {
+        return 0;
+    } else {
+        return 1;
+    }
+}
+
 static int
 SW_RenderCopy(SDL_Renderer * renderer, SDL_Texture * texture,
               const SDL_Rect * srcrect, const SDL_FRect * dstrect)
 {
+    SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
     SDL_Surface *surface = SW_ActivateRenderer(renderer);
     SDL_Surface *src = (SDL_Surface *) texture->driverdata;
     SDL_Rect final_rect;
@@ -550,21 +1189,17 @@ SW_RenderCopy(SDL_Renderer * renderer, SDL_Texture * texture,
     final_rect.h = (int)dstrect->h;
 
     if ( srcrect->w == final_rect.w && srcrect->h == final_rect.h ) {
+        if (data->threads != 1) {
+            return SW_RecordCopy(renderer, surface, texture, srcrect,
+                                 &final_rect);
+        }
         return SDL_BlitSurface(src, srcrect, surface, &final_rect);
     } else {
-        return SDL_BlitScaled(src, srcrect, surface, &final_rect);
-    }
-}
-
-static int
-GetScaleQuality(void)
-{
-    const char *hint = SDL_GetHint(SDL_HINT_RENDER_SCALE_QUALITY);
-
-    if (!hint || *hint == '0' || SDL_strcasecmp(hint, "nearest") == 0) {
-        return 0;
-    } else {
-        return 1;
+        SW_FlushCommands(data);
+        return SDL_PrivateUpperBlitScaled(src, srcrect, surface, &final_rect,
+                                          GetScaleQuality() ?
+                                          SDL_STRETCH_LINEAR :
+                                          SDL_STRETCH_NEAREST);
     }
 }
 
@@ -575,16 +1210,15 @@ SW_RenderCopyEx(SDL_Renderer * renderer, SDL_Texture * texture,
 {
     SDL_Surface *surface = SW_ActivateRenderer(renderer);
     SDL_Surface *src = (SDL_Surface *) texture->driverdata;
-    SDL_Rect final_rect, tmp_rect;
-    SDL_Surface *surface_rotated, *surface_scaled;
-    Uint32 colorkey;
-    int retval, dstwidth, dstheight, abscenterx, abscentery;
-    double cangle, sangle, px, py, p1x, p1y, p2x, p2y, p3x, p3y, p4x, p4y;
+    SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
+    SDL_Rect final_rect;
 
     if (!surface) {
         return -1;
     }
 
+    SW_FlushCommands(data);
+
     if (renderer->viewport.x || renderer->viewport.y) {
         final_rect.x = (int)(renderer->viewport.x + dstrect->x);
         final_rect.y = (int)(renderer->viewport.y + dstrect->y);
@@ -595,66 +1229,13 @@ SW_RenderCopyEx(SDL_Renderer * renderer, SDL_Texture * texture,
     final_rect.w = (int)dstrect->w;
     final_rect.h = (int)dstrect->h;
 
-    surface_scaled = SDL_CreateRGBSurface(SDL_SWSURFACE, final_rect.w, final_rect.h, src->format->BitsPerPixel,
-                                          src->format->Rmask, src->format->Gmask,
-                                          src->format->Bmask, src->format->Amask );
-    if (surface_scaled) {
-        SDL_GetColorKey(src, &colorkey);
-        SDL_SetColorKey(surface_scaled, SDL_TRUE, colorkey);
-        tmp_rect = final_rect;
-        tmp_rect.x = 0;
-        tmp_rect.y = 0;
-
-        retval = SDL_BlitScaled(src, srcrect, surface_scaled, &tmp_rect);
-        if (!retval) {
-            SDLgfx_rotozoomSurfaceSizeTrig(tmp_rect.w, tmp_rect.h, -angle, &dstwidth, &dstheight, &cangle, &sangle);
-            surface_rotated = SDLgfx_rotateSurface(surface_scaled, -angle, dstwidth/2, dstheight/2, GetScaleQuality(), flip & SDL_FLIP_HORIZONTAL, flip & SDL_FLIP_VERTICAL, dstwidth, dstheight, cangle, sangle);
-            if(surface_rotated) {
-                /* Find out where the new origin is by rotating the four final_rect points around the center and then taking the extremes */
-                abscenterx = final_rect.x + (int)center->x;
-                abscentery = final_rect.y + (int)center->y;
-                /* Compensate the angle inversion to match the behaviour of the other backends */
-                sangle = -sangle;
-
-                /* Top Left */
-                px = final_rect.x - abscenterx;
-                py = final_rect.y - abscentery;
-                p1x = px * cangle - py * sangle + abscenterx;
-                p1y = px * sangle + py * cangle + abscentery;
-
-                /* Top Right */
-                px = final_rect.x + final_rect.w - abscenterx;
-                py = final_rect.y - abscentery;
-                p2x = px * cangle - py * sangle + abscenterx;
-                p2y = px * sangle + py * cangle + abscentery;
-
-                /* Bottom Left */
-                px = final_rect.x - abscenterx;
-                py = final_rect.y + final_rect.h - abscentery;
-                p3x = px * cangle - py * sangle + abscenterx;
-                p3y = px * sangle + py * cangle + abscentery;
-
-                /* Bottom Right */
-                px = final_rect.x + final_rect.w - abscenterx;
-                py = final_rect.y + final_rect.h - abscentery;
-                p4x = px * cangle - py * sangle + abscenterx;
-                p4y = px * sangle + py * cangle + abscentery;
-
-                tmp_rect.x = (int)MIN(MIN(p1x, p2x), MIN(p3x, p4x));
-                tmp_rect.y = (int)MIN(MIN(p1y, p2y), MIN(p3y, p4y));
-                tmp_rect.w = dstwidth;
-                tmp_rect.h = dstheight;
-
-                retval = SDL_BlitSurface(surface_rotated, NULL, surface, &tmp_rect);
-                SDL_FreeSurface(surface_scaled);
-                SDL_FreeSurface(surface_rotated);
-                return retval;
-            }
-        }
-        return retval;
-    }
-
-    return -1;
+    /* Sample the texture straight onto the target, one row at a time */
+    return SDLgfx_transformSurface(src, srcrect, surface, &final_rect,
+                                   angle, center->x, center->y,
+                                   GetScaleQuality(),
+                                   (flip & SDL_FLIP_HORIZONTAL) != 0,
+                                   (flip & SDL_FLIP_VERTICAL) != 0,
+                                   &data->span);
 }
 
 static int
@@ -670,6 +1251,8 @@ SW_RenderReadPixels(SDL_Renderer * renderer, const SDL_Rect * rect,
         return -1;
     }
 
+    SW_FlushCommands((SW_RenderData *) renderer->driverdata);
+
     if (renderer->viewport.x || renderer->viewport.y) {
         final_rect.x = renderer->viewport.x + rect->x;
         final_rect.y = renderer->viewport.y + rect->y;
@@ -698,6 +1281,8 @@ SW_RenderPresent(SDL_Renderer * renderer)
 {
     SDL_Window *window = renderer->window;
 
+    SW_FlushCommands((SW_RenderData *) renderer->driverdata);
+
     if (window) {
         SDL_UpdateWindowSurface(window);
     }
@@ -708,6 +1293,8 @@ SW_DestroyTexture(SDL_Renderer * renderer, SDL_Texture * texture)
 {
     SDL_Surface *surface = (SDL_Surface *) texture->driverdata;
 
+    SW_FlushCommands((SW_RenderData *) renderer->driverdata);
+
     SDL_FreeSurface(surface);
 }
 
@@ -716,6 +1303,15 @@ SW_DestroyRenderer(SDL_Renderer * renderer)
 {
     SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
 
+    if (data) {
+        SDL_free(data->commands);
+        SDL_free(data->rects);
+        SDL_free(data->points);
+        SDL_free(data->tile_first);
+        SDL_free(data->tile_cmds);
+        SDL_free(data->sources);
+        SDL_FreeSurface(data->span);
+    }
     SDL_free(data);
     SDL_free(renderer);
 }
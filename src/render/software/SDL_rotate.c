@@ -1,6 +1,6 @@
 /*
 
-SDL_rotate.c: rotates 32bit or 8bit surfaces
+SDL_rotate.c: draws surfaces rotated, scaled and flipped
 
 Shamelessly stolen from SDL_gfx by Andreas Schiffler. Original copyright follows:
 
@@ -30,472 +30,289 @@ Andreas Schiffler -- aschiffler at ferzkopp dot net
 */
 #include "../../SDL_internal.h"
 
-#if defined(__WIN32__)
-#include "../../core/windows/SDL_windows.h"
-#endif
-
-#include <stdlib.h>
-#include <string.h>
-
 #include "SDL.h"
 #include "SDL_rotate.h"
 
-/* ---- Internally used structures */
-
 /* !
-\brief A 32 bit RGBA pixel.
-*/
-typedef struct tColorRGBA {
-    Uint8 r;
-    Uint8 g;
-    Uint8 b;
-    Uint8 a;
-} tColorRGBA;
+\brief Gets a one row surface to hold the pixels of a source surface.
 
-/* !
-\brief A 8bit Y/palette pixel.
+The surface is kept by the caller between calls, and only replaced when it's
+too narrow or has the wrong format.
 */
-typedef struct tColorY {
-    Uint8 y;
-} tColorY;
-
-/* !
-\brief Returns maximum of two numbers a and b.
-*/
-#define MAX(a,b)    (((a) > (b)) ? (a) : (b))
-
-/* !
-\brief Number of guard rows added to destination surfaces.
-
-This is a simple but effective workaround for observed issues.
-These rows allocate extra memory and are then hidden from the surface.
-Rows are added to the end of destination surfaces when they are allocated.
-This catches any potential overflows which seem to happen with
-just the right src image dimensions and scale/rotation and can lead
-to a situation where the program can segfault.
-*/
-#define GUARD_ROWS (2)
+static SDL_Surface *
+_spanSurface(SDL_Surface * src, int width, SDL_Surface ** span)
+{
+    SDL_PixelFormat *fmt = src->format;
 
-/* !
-\brief Lower limit of absolute zoom factor or rotation degrees.
-*/
-#define VALUE_LIMIT 0.001
+    if (*span && ((*span)->format->format != fmt->format ||
+                  (*span)->w < width)) {
+        SDL_FreeSurface(*span);
+        *span = NULL;
+    }
+    if (!*span) {
+        *span = SDL_CreateRGBSurface(SDL_SWSURFACE, MAX(width, 256), 1,
+                                     fmt->BitsPerPixel, fmt->Rmask, fmt->Gmask,
+                                     fmt->Bmask, fmt->Amask);
+        if (!*span) {
+            return NULL;
+        }
+    }
+    if (fmt->palette && (*span)->format->palette != fmt->palette) {
+        SDL_SetSurfacePalette(*span, fmt->palette);
+    }
+    return *span;
+}
 
 /* !
-\brief Returns colorkey info for a surface
+\brief Makes a span surface draw the way its source surface would.
 */
-static Uint32
-_colorkey(SDL_Surface *src)
+static int
+_copySurfaceState(SDL_Surface * src, SDL_Surface * span)
 {
-    Uint32 key = 0;
-    SDL_GetColorKey(src, &key);
-    return key;
+    Uint8 r, g, b, a;
+    SDL_BlendMode blendMode;
+    Uint32 colorkey;
+
+    SDL_GetSurfaceColorMod(src, &r, &g, &b);
+    SDL_GetSurfaceAlphaMod(src, &a);
+    SDL_GetSurfaceBlendMode(src, &blendMode);
+    if (SDL_SetSurfaceColorMod(span, r, g, b) < 0 ||
+        SDL_SetSurfaceAlphaMod(span, a) < 0 ||
+        SDL_SetSurfaceBlendMode(span, blendMode) < 0) {
+        return -1;
+    }
+    if (SDL_GetColorKey(src, &colorkey) == 0) {
+        return SDL_SetColorKey(span, SDL_TRUE, colorkey);
+    }
+    return SDL_SetColorKey(span, SDL_FALSE, 0);
 }
 
-
 /* !
-\brief Internal target surface sizing function for rotations with trig result return.
-
-\param width The source surface width.
-\param height The source surface height.
-\param angle The angle to rotate in degrees.
-\param dstwidth The calculated width of the destination surface.
-\param dstheight The calculated height of the destination surface.
-\param cangle The sine of the angle
-\param sangle The cosine of the angle
-
+\brief Blends four 32 bit pixels a byte at a time, weighted by fx and fy out of 256.
 */
-void
-SDLgfx_rotozoomSurfaceSizeTrig(int width, int height, double angle,
-                               int *dstwidth, int *dstheight,
-                               double *cangle, double *sangle)
+static Uint32
+_bilinear(Uint32 c00, Uint32 c01, Uint32 c10, Uint32 c11, Uint32 fx, Uint32 fy)
 {
-    double x, y, cx, cy, sx, sy;
-    double radangle;
-    int dstwidthhalf, dstheighthalf;
-
-    /*
-    * Determine destination width and height by rotating a centered source box
-    */
-    radangle = angle * (M_PI / 180.0);
-    *sangle = SDL_sin(radangle);
-    *cangle = SDL_cos(radangle);
-    x = (double)(width / 2);
-    y = (double)(height / 2);
-    cx = *cangle * x;
-    cy = *cangle * y;
-    sx = *sangle * x;
-    sy = *sangle * y;
-
-    dstwidthhalf = MAX((int)
-        SDL_ceil(MAX(MAX(MAX(SDL_fabs(cx + sy), SDL_fabs(cx - sy)), SDL_fabs(-cx + sy)), SDL_fabs(-cx - sy))), 1);
-    dstheighthalf = MAX((int)
-        SDL_ceil(MAX(MAX(MAX(SDL_fabs(sx + cy), SDL_fabs(sx - cy)), SDL_fabs(-sx + cy)), SDL_fabs(-sx - cy))), 1);
-    *dstwidth = 2 * dstwidthhalf;
-    *dstheight = 2 * dstheighthalf;
+    Uint32 t0, t1, t2, t3;
+
+    /* Two bytes at a time, each in its own 16 bits */
+    t0 = ((((c00 & 0x00ff00ff) * (256 - fx) + (c01 & 0x00ff00ff) * fx) >> 8) & 0x00ff00ff);
+    t1 = ((((c10 & 0x00ff00ff) * (256 - fx) + (c11 & 0x00ff00ff) * fx) >> 8) & 0x00ff00ff);
+    t2 = (((((c00 >> 8) & 0x00ff00ff) * (256 - fx) + ((c01 >> 8) & 0x00ff00ff) * fx) >> 8) & 0x00ff00ff);
+    t3 = (((((c10 >> 8) & 0x00ff00ff) * (256 - fx) + ((c11 >> 8) & 0x00ff00ff) * fx) >> 8) & 0x00ff00ff);
+    t0 = (((t0 * (256 - fy) + t1 * fy) >> 8) & 0x00ff00ff);
+    t2 = ((t2 * (256 - fy) + t3 * fy) & 0xff00ff00);
+    return t0 | t2;
 }
 
-
 /* !
-\brief Internal 32 bit rotozoomer with optional anti-aliasing.
-
-Rotates and zooms 32 bit RGBA/ABGR 'src' surface to 'dst' surface based on the control
-parameters by scanning the destination surface and applying optionally anti-aliasing
-by bilinear interpolation.
-Assumes src and dst surfaces are of 32 bit depth.
-Assumes dst surface was allocated with the correct dimensions.
-
-\param src Source surface.
-\param dst Destination surface.
-\param cx Horizontal center coordinate.
-\param cy Vertical center coordinate.
-\param isin Integer version of sine of angle.
-\param icos Integer version of cosine of angle.
-\param flipx Flag indicating horizontal mirroring should be applied.
-\param flipy Flag indicating vertical mirroring should be applied.
-\param smooth Flag indicating anti-aliasing should be used.
+\brief Narrows the range of columns [*x1, *x2] to those where start + x * step is within [0, size).
 */
 static void
-_transformSurfaceRGBA(SDL_Surface * src, SDL_Surface * dst, int cx, int cy, int isin, int icos, int flipx, int flipy, int smooth)
+_clipSpan(double start, double step, double size, int *x1, int *x2)
 {
-    int x, y, t1, t2, dx, dy, xd, yd, sdx, sdy, ax, ay, ex, ey, sw, sh;
-    tColorRGBA c00, c01, c10, c11, cswap;
-    tColorRGBA *pc, *sp;
-    int gap;
-
-    /*
-    * Variable setup
-    */
-    xd = ((src->w - dst->w) << 15);
-    yd = ((src->h - dst->h) << 15);
-    ax = (cx << 16) - (icos * cx);
-    ay = (cy << 16) - (isin * cx);
-    sw = src->w - 1;
-    sh = src->h - 1;
-    pc = (tColorRGBA*) dst->pixels;
-    gap = dst->pitch - dst->w * 4;
-
-    /*
-    * Switch between interpolating and non-interpolating code
-    */
-    if (smooth) {
-        for (y = 0; y < dst->h; y++) {
-            dy = cy - y;
-            sdx = (ax + (isin * dy)) + xd;
-            sdy = (ay - (icos * dy)) + yd;
-            for (x = 0; x < dst->w; x++) {
-                dx = (sdx >> 16);
-                dy = (sdy >> 16);
-                if (flipx) dx = sw - dx;
-                if (flipy) dy = sh - dy;
-                if ((dx > -1) && (dy > -1) && (dx < (src->w-1)) && (dy < (src->h-1))) {
-                    sp = (tColorRGBA *)src->pixels;
-                    sp += ((src->pitch/4) * dy);
-                    sp += dx;
-                    c00 = *sp;
-                    sp += 1;
-                    c01 = *sp;
-                    sp += (src->pitch/4);
-                    c11 = *sp;
-                    sp -= 1;
-                    c10 = *sp;
-                    if (flipx) {
-                        cswap = c00; c00=c01; c01=cswap;
-                        cswap = c10; c10=c11; c11=cswap;
-                    }
-                    if (flipy) {
-                        cswap = c00; c00=c10; c10=cswap;
-                        cswap = c01; c01=c11; c11=cswap;
-                    }
-                    /*
-                    * Interpolate colors
-                    */
-                    ex = (sdx & 0xffff);
-                    ey = (sdy & 0xffff);
-                    t1 = ((((c01.r - c00.r) * ex) >> 16) + c00.r) & 0xff;
-                    t2 = ((((c11.r - c10.r) * ex) >> 16) + c10.r) & 0xff;
-                    pc->r = (((t2 - t1) * ey) >> 16) + t1;
-                    t1 = ((((c01.g - c00.g) * ex) >> 16) + c00.g) & 0xff;
-                    t2 = ((((c11.g - c10.g) * ex) >> 16) + c10.g) & 0xff;
-                    pc->g = (((t2 - t1) * ey) >> 16) + t1;
-                    t1 = ((((c01.b - c00.b) * ex) >> 16) + c00.b) & 0xff;
-                    t2 = ((((c11.b - c10.b) * ex) >> 16) + c10.b) & 0xff;
-                    pc->b = (((t2 - t1) * ey) >> 16) + t1;
-                    t1 = ((((c01.a - c00.a) * ex) >> 16) + c00.a) & 0xff;
-                    t2 = ((((c11.a - c10.a) * ex) >> 16) + c10.a) & 0xff;
-                    pc->a = (((t2 - t1) * ey) >> 16) + t1;
-                }
-                sdx += icos;
-                sdy += isin;
-                pc++;
-            }
-            pc = (tColorRGBA *) ((Uint8 *) pc + gap);
+    double lo, hi;
+
+    if (SDL_fabs(step) < 1e-9) {
+        if (start < 0.0 || start >= size) {
+            *x2 = *x1 - 1;
         }
+        return;
+    }
+    lo = -start / step;
+    hi = (size - start) / step;
+    if (step > 0.0) {
+        *x1 = MAX(*x1, (int) SDL_ceil(lo));
+        *x2 = MIN(*x2, (int) SDL_ceil(hi) - 1);
     } else {
-        for (y = 0; y < dst->h; y++) {
-            dy = cy - y;
-            sdx = (ax + (isin * dy)) + xd;
-            sdy = (ay - (icos * dy)) + yd;
-            for (x = 0; x < dst->w; x++) {
-                dx = (short) (sdx >> 16);
-                dy = (short) (sdy >> 16);
-                if (flipx) dx = (src->w-1)-dx;
-                if (flipy) dy = (src->h-1)-dy;
-                if ((dx >= 0) && (dy >= 0) && (dx < src->w) && (dy < src->h)) {
-                    sp = (tColorRGBA *) ((Uint8 *) src->pixels + src->pitch * dy);
-                    sp += dx;
-                    *pc = *sp;
-                }
-                sdx += icos;
-                sdy += isin;
-                pc++;
-            }
-            pc = (tColorRGBA *) ((Uint8 *) pc + gap);
-        }
+        *x1 = MAX(*x1, (int) SDL_floor(hi) + 1);
+        *x2 = MIN(*x2, (int) SDL_floor(lo));
     }
 }
 
 /* !
-
-\brief Rotates and zooms 8 bit palette/Y 'src' surface to 'dst' surface without smoothing.
-
-Rotates and zooms 8 bit RGBA/ABGR 'src' surface to 'dst' surface based on the control
-parameters by scanning the destination surface.
-Assumes src and dst surfaces are of 8 bit depth.
-Assumes dst surface was allocated with the correct dimensions.
-
-\param src Source surface.
-\param dst Destination surface.
-\param cx Horizontal center coordinate.
-\param cy Vertical center coordinate.
-\param isin Integer version of sine of angle.
-\param icos Integer version of cosine of angle.
-\param flipx Flag indicating horizontal mirroring should be applied.
-\param flipy Flag indicating vertical mirroring should be applied.
+\brief Draws part of a surface rotated, scaled and flipped straight onto another.
+
+Each destination pixel inside the clip rectangle is mapped back into the
+source rectangle, and each row of pixels that land inside it is sampled into
+a one row surface and blitted from there, so the blend mode, color and alpha
+modulation, color key and format conversion of an ordinary blit all apply.
+Sampling is bilinear for 32 bit sources without a color key when 'smooth' is
+set, and nearest otherwise.
+
+\param src The surface to draw.
+\param srcrect The part of the source to draw.
+\param dst The surface to draw onto.
+\param dstrect Where the source would be drawn without rotation.
+\param angle The clockwise rotation in degrees.
+\param centerx The horizontal center of rotation, relative to dstrect.
+\param centery The vertical center of rotation, relative to dstrect.
+\param smooth Set to 1 for bilinear filtering.
+\param flipx Set to 1 to flip the image horizontally.
+\param flipy Set to 1 to flip the image vertically.
+\param span A one row surface kept by the caller between calls.
+\return 0 on success, or -1 on error.
 */
-static void
-transformSurfaceY(SDL_Surface * src, SDL_Surface * dst, int cx, int cy, int isin, int icos, int flipx, int flipy)
+int
+SDLgfx_transformSurface(SDL_Surface * src, const SDL_Rect * srcrect,
+                        SDL_Surface * dst, const SDL_Rect * dstrect,
+                        double angle, double centerx, double centery,
+                        int smooth, int flipx, int flipy, SDL_Surface ** span)
 {
-    int x, y, dx, dy, xd, yd, sdx, sdy, ax, ay;
-    tColorY *pc, *sp;
-    int gap;
-
-    /*
-    * Variable setup
-    */
-    xd = ((src->w - dst->w) << 15);
-    yd = ((src->h - dst->h) << 15);
-    ax = (cx << 16) - (icos * cx);
-    ay = (cy << 16) - (isin * cx);
-    pc = (tColorY*) dst->pixels;
-    gap = dst->pitch - dst->w;
-    /*
-    * Clear surface to colorkey
-    */
-    SDL_memset(pc, (int)(_colorkey(src) & 0xff), dst->pitch * dst->h);
-    /*
-    * Iterate through destination surface
-    */
-    for (y = 0; y < dst->h; y++) {
-        dy = cy - y;
-        sdx = (ax + (isin * dy)) + xd;
-        sdy = (ay - (icos * dy)) + yd;
-        for (x = 0; x < dst->w; x++) {
-            dx = (short) (sdx >> 16);
-            dy = (short) (sdy >> 16);
-            if (flipx) dx = (src->w-1)-dx;
-            if (flipy) dy = (src->h-1)-dy;
-            if ((dx >= 0) && (dy >= 0) && (dx < src->w) && (dy < src->h)) {
-                sp = (tColorY *) (src->pixels);
-                sp += (src->pitch * dy + dx);
-                *pc = *sp;
-            }
-            sdx += icos;
-            sdy += isin;
-            pc++;
-        }
-        pc += gap;
+    const SDL_Rect *clip = &dst->clip_rect;
+    const int bpp = src->format->BytesPerPixel;
+    SDL_Surface *row;
+    SDL_Rect sr, dr;
+    double radangle, cangle, sangle, ox, oy;
+    double dudx, dudy, dvdx, dvdy, u0, v0, px, py;
+    double cornersx[4], cornersy[4];
+    int x1, x2, y1, y2, x, y, i, status = 0;
+    int u, v, du, dv, su, sv;
+    Uint32 colorkey;
+    Uint8 *pixels;
+
+    if (srcrect->w <= 0 || srcrect->h <= 0 ||
+        dstrect->w <= 0 || dstrect->h <= 0) {
+        return 0;
     }
-}
-
 
-/* !
-\brief Rotates and zooms a surface with different horizontal and vertival scaling factors and optional anti-aliasing.
-
-Rotates a 32bit or 8bit 'src' surface to newly created 'dst' surface.
-'angle' is the rotation in degrees, 'centerx' and 'centery' the rotation center. If 'smooth' is set
-then the destination 32bit surface is anti-aliased. If the surface is not 8bit
-or 32bit RGBA/ABGR it will be converted into a 32bit RGBA format on the fly.
-
-\param src The surface to rotozoom.
-\param angle The angle to rotate in degrees.
-\param centerx The horizontal coordinate of the center of rotation
-\param zoomy The vertical coordinate of the center of rotation
-\param smooth Antialiasing flag; set to SMOOTHING_ON to enable.
-\param flipx Set to 1 to flip the image horizontally
-\param flipy Set to 1 to flip the image vertically
-\param dstwidth The destination surface width
-\param dstheight The destination surface height
-\param cangle The angle cosine
-\param sangle The angle sine
-\return The new rotated surface.
-
-*/
-
-SDL_Surface *
-SDLgfx_rotateSurface(SDL_Surface * src, double angle, int centerx, int centery, int smooth, int flipx, int flipy, int dstwidth, int dstheight, double cangle, double sangle)
-{
-    SDL_Surface *rz_src;
-    SDL_Surface *rz_dst;
-    int is32bit;
-    int i, src_converted;
-    Uint8 r,g,b;
-    Uint32 colorkey = 0;
-    int colorKeyAvailable = 0;
-    double sangleinv, cangleinv;
-
-    /*
-    * Sanity check
-    */
-    if (src == NULL)
-        return (NULL);
-
-    if (src->flags & SDL_TRUE/* SDL_SRCCOLORKEY */)
-    {
-        colorkey = _colorkey(src);
-        SDL_GetRGB(colorkey, src->format, &r, &g, &b);
-        colorKeyAvailable = 1;
+    radangle = angle * (M_PI / 180.0);
+    cangle = SDL_cos(radangle);
+    sangle = SDL_sin(radangle);
+    ox = dstrect->x + centerx;
+    oy = dstrect->y + centery;
+
+    /* Find the destination rows and columns the rotated rectangle covers */
+    for (i = 0; i < 4; i++) {
+        px = ((i & 1) ? dstrect->w : 0) - centerx;
+        py = ((i & 2) ? dstrect->h : 0) - centery;
+        cornersx[i] = ox + px * cangle - py * sangle;
+        cornersy[i] = oy + px * sangle + py * cangle;
     }
-    /*
-    * Determine if source surface is 32bit or 8bit
-    */
-    is32bit = (src->format->BitsPerPixel == 32);
-    if ((is32bit) || (src->format->BitsPerPixel == 8)) {
-        /*
-        * Use source surface 'as is'
-        */
-        rz_src = src;
-        src_converted = 0;
-    } else {
-        /*
-        * New source surface is 32bit with a defined RGBA ordering
-        */
-        rz_src =
-            SDL_CreateRGBSurface(SDL_SWSURFACE, src->w, src->h, 32,
-#if SDL_BYTEORDER == SDL_LIL_ENDIAN
-            0x000000ff, 0x0000ff00, 0x00ff0000, 0xff000000
-#else
-            0xff000000,  0x00ff0000, 0x0000ff00, 0x000000ff
-#endif
-            );
-        if(colorKeyAvailable)
-            SDL_SetColorKey(src, 0, 0);
-
-        SDL_BlitSurface(src, NULL, rz_src, NULL);
-
-        if(colorKeyAvailable)
-            SDL_SetColorKey(src, SDL_TRUE /* SDL_SRCCOLORKEY */, colorkey);
-        src_converted = 1;
-        is32bit = 1;
+    x1 = (int) SDL_floor(MIN(MIN(cornersx[0], cornersx[1]), MIN(cornersx[2], cornersx[3])));
+    x2 = (int) SDL_ceil(MAX(MAX(cornersx[0], cornersx[1]), MAX(cornersx[2], cornersx[3])));
+    y1 = (int) SDL_floor(MIN(MIN(cornersy[0], cornersy[1]), MIN(cornersy[2], cornersy[3])));
+    y2 = (int) SDL_ceil(MAX(MAX(cornersy[0], cornersy[1]), MAX(cornersy[2], cornersy[3])));
+    x1 = MAX(x1, clip->x);
+    x2 = MIN(x2, clip->x + clip->w - 1);
+    y1 = MAX(y1, clip->y);
+    y2 = MIN(y2, clip->y + clip->h - 1);
+    if (x1 > x2 || y1 > y2) {
+        return 0;
     }
 
-
-    /* Determine target size */
-    /* _rotozoomSurfaceSizeTrig(rz_src->w, rz_src->h, angle, &dstwidth, &dstheight, &cangle, &sangle); */
-
-    /*
-    * Calculate target factors from sin/cos and zoom
-    */
-    sangleinv = sangle*65536.0;
-    cangleinv = cangle*65536.0;
-
-    /*
-    * Alloc space to completely contain the rotated surface
-    */
-    rz_dst = NULL;
-    if (is32bit) {
-        /*
-        * Target surface is 32bit with source RGBA/ABGR ordering
-        */
-        rz_dst =
-            SDL_CreateRGBSurface(SDL_SWSURFACE, dstwidth, dstheight + GUARD_ROWS, 32,
-            rz_src->format->Rmask, rz_src->format->Gmask,
-            rz_src->format->Bmask, rz_src->format->Amask);
-    } else {
-        /*
-        * Target surface is 8bit
-        */
-        rz_dst = SDL_CreateRGBSurface(SDL_SWSURFACE, dstwidth, dstheight + GUARD_ROWS, 8, 0, 0, 0, 0);
+    row = _spanSurface(src, x2 - x1 + 1, span);
+    if (!row || _copySurfaceState(src, row) < 0) {
+        return -1;
+    }
+    if (bpp != 4 || SDL_GetColorKey(src, &colorkey) == 0) {
+        smooth = 0;
     }
 
-    /* Check target */
-    if (rz_dst == NULL)
-        return NULL;
-
-    /* Adjust for guard rows */
-    rz_dst->h = dstheight;
-
-    if (colorKeyAvailable == 1){
-        colorkey = SDL_MapRGB(rz_dst->format, r, g, b);
-
-        SDL_FillRect(rz_dst, NULL, colorkey );
+    /* The source position of a destination pixel center is linear in x and
+       y; work out where (0, 0) lands and how far a step in x or y moves */
+    dudx = cangle * srcrect->w / dstrect->w;
+    dudy = sangle * srcrect->w / dstrect->w;
+    dvdx = -sangle * srcrect->h / dstrect->h;
+    dvdy = cangle * srcrect->h / dstrect->h;
+    px = 0.5 - ox;
+    py = 0.5 - oy;
+    u0 = (centerx + px * cangle + py * sangle) * srcrect->w / dstrect->w;
+    v0 = (centery - px * sangle + py * cangle) * srcrect->h / dstrect->h;
+    if (flipx) {
+        u0 = srcrect->w - u0;
+        dudx = -dudx;
+        dudy = -dudy;
     }
+    if (flipy) {
+        v0 = srcrect->h - v0;
+        dvdx = -dvdx;
+        dvdy = -dvdy;
+    }
+    if (smooth) {
+        /* Sample between the texel centers */
+        u0 -= 0.5;
+        v0 -= 0.5;
+    }
+    du = (int) (dudx * 65536.0);
+    dv = (int) (dvdx * 65536.0);
 
-    /*
-    * Lock source surface
-    */
-    if (SDL_MUSTLOCK(rz_src)) {
-        SDL_LockSurface(rz_src);
+    if (SDL_MUSTLOCK(src)) {
+        SDL_LockSurface(src);
     }
+    pixels = (Uint8 *) src->pixels + srcrect->y * src->pitch + srcrect->x * bpp;
+
+    for (y = y1; y <= y2 && status == 0; y++) {
+        const double ur = u0 + y * dudy;
+        const double vr = v0 + y * dvdy;
+        int sx1 = x1, sx2 = x2;
+
+        if (smooth) {
+            _clipSpan(ur + 0.5, dudx, srcrect->w, &sx1, &sx2);
+            _clipSpan(vr + 0.5, dvdx, srcrect->h, &sx1, &sx2);
+        } else {
+            _clipSpan(ur, dudx, srcrect->w, &sx1, &sx2);
+            _clipSpan(vr, dvdx, srcrect->h, &sx1, &sx2);
+        }
+        if (sx1 > sx2) {
+            continue;
+        }
 
-    /*
-    * Check which kind of surface we have
-    */
-    if (is32bit) {
-        /*
-        * Call the 32bit transformation routine to do the rotation (using alpha)
-        */
-        _transformSurfaceRGBA(rz_src, rz_dst, centerx, centery,
-            (int) (sangleinv), (int) (cangleinv),
-            flipx, flipy,
-            smooth);
-        /*
-        * Turn on source-alpha support
-        */
-        /* SDL_SetAlpha(rz_dst, SDL_SRCALPHA, 255); */
-        SDL_SetColorKey(rz_dst, /* SDL_SRCCOLORKEY */ SDL_TRUE | SDL_RLEACCEL, _colorkey(rz_src));
-    } else {
-        /*
-        * Copy palette and colorkey info
-        */
-        for (i = 0; i < rz_src->format->palette->ncolors; i++) {
-            rz_dst->format->palette->colors[i] = rz_src->format->palette->colors[i];
+        u = (int) ((ur + sx1 * dudx) * 65536.0);
+        v = (int) ((vr + sx1 * dvdx) * 65536.0);
+        if (smooth) {
+            Uint32 *out = (Uint32 *) row->pixels;
+            const int maxu = srcrect->w - 1, maxv = srcrect->h - 1;
+            for (x = sx1; x <= sx2; x++, u += du, v += dv) {
+                const Uint32 *row0, *row1;
+                int u1, v1;
+
+                /* Clamp to the edges of the source rectangle */
+                su = (u < 0) ? 0 : MIN(u >> 16, maxu);
+                sv = (v < 0) ? 0 : MIN(v >> 16, maxv);
+                u1 = (u < 0) ? 0 : MIN(su + 1, maxu);
+                v1 = (v < 0) ? 0 : MIN(sv + 1, maxv);
+                row0 = (const Uint32 *) (pixels + sv * src->pitch);
+                row1 = (const Uint32 *) (pixels + v1 * src->pitch);
+                *out++ = _bilinear(row0[su], row0[u1], row1[su], row1[u1],
+                                   (u < 0) ? 0 : ((u >> 8) & 0xff),
+                                   (v < 0) ? 0 : ((v >> 8) & 0xff));
+            }
+        } else {
+            Uint8 *out = (Uint8 *) row->pixels;
+            const int maxu = srcrect->w - 1, maxv = srcrect->h - 1;
+            for (x = sx1; x <= sx2; x++, u += du, v += dv, out += bpp) {
+                const Uint8 *in;
+
+                /* Rounding can step a hair outside the span */
+                su = (u < 0) ? 0 : MIN(u >> 16, maxu);
+                sv = (v < 0) ? 0 : MIN(v >> 16, maxv);
+                in = pixels + sv * src->pitch + su * bpp;
+                switch (bpp) {
+                case 4:
+                    *(Uint32 *) out = *(const Uint32 *) in;
+                    break;
+                case 2:
+                    *(Uint16 *) out = *(const Uint16 *) in;
+                    break;
+                default:
+                    SDL_memcpy(out, in, bpp);
+                    break;
+                }
+            }
         }
-        rz_dst->format->palette->ncolors = rz_src->format->palette->ncolors;
-        /*
-        * Call the 8bit transformation routine to do the rotation
-        */
-        transformSurfaceY(rz_src, rz_dst, centerx, centery,
-            (int) (sangleinv), (int) (cangleinv),
-            flipx, flipy);
-        SDL_SetColorKey(rz_dst, /* SDL_SRCCOLORKEY */ SDL_TRUE | SDL_RLEACCEL, _colorkey(rz_src));
-    }
-    /*
-    * Unlock source surface
-    */
-    if (SDL_MUSTLOCK(rz_src)) {
-        SDL_UnlockSurface(rz_src);
-    }
 
-    /*
-    * Cleanup temp surface
-    */
-    if (src_converted) {
-        SDL_FreeSurface(rz_src);
+        sr.x = 0;
+        sr.y = 0;
+        sr.w = dr.w = sx2 - sx1 + 1;
+        sr.h = dr.h = 1;
+        dr.x = sx1;
+        dr.y = y;
+        status = SDL_LowerBlit(row, &sr, dst, &dr);
     }
 
-    /*
-    * Return destination surface
-    */
-    return (rz_dst);
+    if (SDL_MUSTLOCK(src)) {
+        SDL_UnlockSurface(src);
+    }
+    return status;
 }
@@ -296,6 +296,22 @@ SDL_RunThread(void *data)
     }
 }
 
+SDL_Thread *
+SDL_CreateThreadInternal(SDL_ThreadFunction fn, const char *name, void *data)
+{
+/* !!! FIXME: this is nasty. */
+#if defined(__WIN32__) && !defined(HAVE_LIBC)
+#undef SDL_CreateThread
+#if SDL_DYNAMIC_API
+    return SDL_CreateThread_REAL(fn, name, data, NULL, NULL);
+#else
+    return SDL_CreateThread(fn, name, data, NULL, NULL);
+#endif
+#else
+    return SDL_CreateThread(fn, name, data);
+#endif
+}
+
 #ifdef SDL_CreateThread
 #undef SDL_CreateThread
 #endif
@@ -65,6 +65,10 @@ struct SDL_Thread
 /* This is the function called to run a thread */
 extern void SDL_RunThread(void *data);
 
+/* Create a thread for SDL's own use, with the C runtime SDL was built with */
+extern SDL_Thread *SDL_CreateThreadInternal(SDL_ThreadFunction fn,
+                                            const char *name, void *data);
+
 /* This is the system-independent thread local storage structure */
 typedef struct {
     unsigned int limit;
@@ -0,0 +1,165 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2014 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../SDL_internal.h"
+
+#include "SDL_atomic.h"
+#include "SDL_cpuinfo.h"
+#include "SDL_thread.h"
+#include "SDL_thread_c.h"
+#include "SDL_threadpool_c.h"
+
+static SDL_SpinLock pool_lock;
+static SDL_atomic_t pool_busy;          /* Set while a set of calls runs */
+static SDL_sem *pool_work = NULL;       /* Posted once for each worker wanted */
+static SDL_sem *pool_done = NULL;       /* Posted by each worker when it's done */
+static SDL_Thread *pool_threads[SDL_THREADPOOL_MAX_THREADS];
+static int pool_numthreads = 0;
+static SDL_bool pool_quit = SDL_FALSE;
+
+static struct
+{
+    SDL_ParallelFunc func;
+    void *data;
+    int count;
+    SDL_atomic_t next;
+} pool_job;
+
+static void
+SDL_RunPoolJob(void)
+{
+    int index;
+
+    while ((index = SDL_AtomicAdd(&pool_job.next, 1)) < pool_job.count) {
+        pool_job.func(pool_job.data, index);
+    }
+}
+
+static int SDLCALL
+SDL_PoolThread(void *unused)
+{
+    for (;;) {
+        SDL_SemWait(pool_work);
+        if (pool_quit) {
+            break;
+        }
+        SDL_RunPoolJob();
+        SDL_SemPost(pool_done);
+    }
+    return 0;
+}
+
+static SDL_bool
+SDL_InitThreadPool(void)
+{
+    SDL_AtomicLock(&pool_lock);
+    if (!pool_work) {
+        pool_work = SDL_CreateSemaphore(0);
+        pool_done = SDL_CreateSemaphore(0);
+        if (!pool_work || !pool_done) {
+            if (pool_work) {
+                SDL_DestroySemaphore(pool_work);
+                pool_work = NULL;
+            }
+            if (pool_done) {
+                SDL_DestroySemaphore(pool_done);
+                pool_done = NULL;
+            }
+        }
+    }
+    SDL_AtomicUnlock(&pool_lock);
+    return (pool_work != NULL);
+}
+
+void
+SDL_RunParallel(SDL_ParallelFunc func, void *data, int count, int numthreads)
+{
+    int i, helpers;
+
+    if (numthreads <= 0) {
+        numthreads = SDL_GetCPUCount();
+    }
+    helpers = SDL_min(numthreads, count) - 1;
+    helpers = SDL_min(helpers, SDL_THREADPOOL_MAX_THREADS);
+
+    /* Not a mutex, since those are recursive and this has to refuse a
+       call made from inside func on the calling thread */
+    if (helpers > 0 && SDL_InitThreadPool() &&
+        SDL_AtomicCAS(&pool_busy, 0, 1)) {
+        while (pool_numthreads < helpers) {
+            pool_threads[pool_numthreads] = SDL_CreateThreadInternal(SDL_PoolThread, "SDLWorker", NULL);
+            if (!pool_threads[pool_numthreads]) {
+                break;
+            }
+            ++pool_numthreads;
+        }
+        helpers = SDL_min(helpers, pool_numthreads);
+
+        pool_job.func = func;
+        pool_job.data = data;
+        pool_job.count = count;
+        SDL_AtomicSet(&pool_job.next, 0);
+        for (i = 0; i < helpers; ++i) {
+            SDL_SemPost(pool_work);
+        }
+        SDL_RunPoolJob();
+
+        /* Every worker that was woken has to check in, even if it was too
+           late to get anything to do, so none of them touch the job after
+           we return */
+        for (i = 0; i < helpers; ++i) {
+            SDL_SemWait(pool_done);
+        }
+        SDL_AtomicSet(&pool_busy, 0);
+        return;
+    }
+
+    for (i = 0; i < count; ++i) {
+        func(data, i);
+    }
+}
+
+void
+SDL_QuitThreadPool(void)
+{
+    int i;
+
+    if (!pool_work) {
+        return;
+    }
+
+    pool_quit = SDL_TRUE;
+    for (i = 0; i < pool_numthreads; ++i) {
+        SDL_SemPost(pool_work);
+    }
+    for (i = 0; i < pool_numthreads; ++i) {
+        SDL_WaitThread(pool_threads[i], NULL);
+        pool_threads[i] = NULL;
+    }
+    pool_numthreads = 0;
+    pool_quit = SDL_FALSE;
+
+    SDL_DestroySemaphore(pool_done);
+    SDL_DestroySemaphore(pool_work);
+    pool_done = NULL;
+    pool_work = NULL;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,47 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2014 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../SDL_internal.h"
+
+#ifndef _SDL_threadpool_c_h
+#define _SDL_threadpool_c_h
+
+/* A pool of worker threads shared by the parts of SDL that split work up */
+
+/* The most worker threads the pool will start */
+#define SDL_THREADPOOL_MAX_THREADS  64
+
+typedef void (*SDL_ParallelFunc) (void *data, int index);
+
+/* Call func(data, 0) to func(data, count - 1), shared out between the
+   calling thread and up to numthreads - 1 workers, and return when they
+   have all finished.  A numthreads of 0 or less means one per CPU.  The
+   pool runs one set of calls at a time; a call made while it's busy,
+   including one from inside func, runs everything on the calling thread.
+ */
+extern void SDL_RunParallel(SDL_ParallelFunc func, void *data, int count,
+                            int numthreads);
+
+/* Stop the worker threads, done by SDL_Quit() */
+extern void SDL_QuitThreadPool(void);
+
+#endif /* _SDL_threadpool_c_h */
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -89,6 +89,8 @@
 #include "SDL_sysvideo.h"
 #include "SDL_blit.h"
 #include "SDL_RLEaccel_c.h"
+#include "SDL_pixels_c.h"
+#include "../thread/SDL_threadpool_c.h"
 
 #ifndef MAX
 #define MAX(a, b) ((a) > (b) ? (a) : (b))
@@ -979,7 +981,9 @@ copy_32(void *dst, Uint32 * src, int n,
     for (i = 0; i < n; i++) {
         unsigned r, g, b, a;
         RGBA_FROM_8888(*src, sfmt, r, g, b, a);
-        PIXEL_FROM_RGBA(*d, dfmt, r, g, b, a);
+        /* the blitters expect alpha in the unused high byte */
+        PIXEL_FROM_RGB(*d, dfmt, r, g, b);
+        *d |= a << 24;
         d++;
         src++;
     }
@@ -1009,21 +1013,468 @@ uncopy_32(Uint32 * dst, void *src, int n,
 #define ISTRANSL(pixel, fmt)    \
     ((unsigned)((((pixel) & fmt->Amask) >> fmt->Ashift) - 1U) < 254U)
 
+static Uint32
+getpix_8(Uint8 * srcbuf)
+{
+    return *srcbuf;
+}
+
+static Uint32
+getpix_16(Uint8 * srcbuf)
+{
+    return *(Uint16 *) srcbuf;
+}
+
+static Uint32
+getpix_24(Uint8 * srcbuf)
+{
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+    return srcbuf[0] + (srcbuf[1] << 8) + (srcbuf[2] << 16);
+#else
+    return (srcbuf[0] << 16) + (srcbuf[1] << 8) + srcbuf[2];
+#endif
+}
+
+static Uint32
+getpix_32(Uint8 * srcbuf)
+{
+    return *(Uint32 *) srcbuf;
+}
+
+typedef Uint32(*getpix_func) (Uint8 *);
+
+static const getpix_func getpixes[4] = {
+    getpix_8, getpix_16, getpix_24, getpix_32
+};
+
+typedef int (*RLECopyFunc) (void *, Uint32 *, int,
+                            SDL_PixelFormat *, SDL_PixelFormat *);
+
+/*
+ * The encoders work a scan line at a time, in bands of lines that can be
+ * run on different threads.  A first pass works out how long each line's
+ * encoding is, so that the second can write every line straight to its
+ * place in a buffer of exactly the right size.
+ */
+typedef struct
+{
+    SDL_Surface *surface;
+    SDL_PixelFormat *df;        /* destination format, NULL for colorkey */
+    RLECopyFunc copy_opaque;
+    RLECopyFunc copy_transl;
+    Uint32 ckey;
+    Uint32 rgbmask;
+    SDL_bool simd;              /* run detection can use SSE2 */
+    Uint8 *rlebuf;              /* NULL in the first pass */
+    size_t *offsets;            /* where each line goes, after the first pass */
+    Uint8 *blank;               /* whether each line is fully transparent */
+    int lines;
+    int bands;
+} RLEEncodeJob;
+
+/* return the first pixel from x on that does (or doesn't) match the colorkey,
+   or the width of the surface if there is none */
+static int
+RLEFindColorkey(const RLEEncodeJob * job, Uint8 * srcbuf, int x,
+                SDL_bool keyed)
+{
+    const int bpp = job->surface->format->BytesPerPixel;
+    const int w = job->surface->w;
+    const Uint32 rgbmask = job->rgbmask;
+    const Uint32 ckey = job->ckey;
+    getpix_func getpix = getpixes[bpp - 1];
+
+#ifdef __SSE2__
+    /* Skip over 16 bytes of pixels at a time while they're all the same,
+       leaving the rest of the line to find the exact pixel */
+    if (job->simd) {
+        const int same = keyed ? 0 : 0xFFFF;
+        __m128i mask, key;
+
+        switch (bpp) {
+        case 1:
+            mask = _mm_set1_epi8((char) rgbmask);
+            key = _mm_set1_epi8((char) ckey);
+            for (; x + 16 <= w; x += 16) {
+                __m128i v = _mm_loadu_si128((const __m128i *) (srcbuf + x));
+                v = _mm_cmpeq_epi8(_mm_and_si128(v, mask), key);
+                if (_mm_movemask_epi8(v) != same) {
+                    break;
+                }
+            }
+            break;
+        case 2:
+            mask = _mm_set1_epi16((short) rgbmask);
+            key = _mm_set1_epi16((short) ckey);
+            for (; x + 8 <= w; x += 8) {
+                __m128i v = _mm_loadu_si128((const __m128i *) (srcbuf + x * 2));
+                v = _mm_cmpeq_epi16(_mm_and_si128(v, mask), key);
+                if (_mm_movemask_epi8(v) != same) {
+                    break;
+                }
+            }
+            break;
+        case 4:
+            mask = _mm_set1_epi32((int) rgbmask);
+            key = _mm_set1_epi32((int) ckey);
+            for (; x + 4 <= w; x += 4) {
+                __m128i v = _mm_loadu_si128((const __m128i *) (srcbuf + x * 4));
+                v = _mm_cmpeq_epi32(_mm_and_si128(v, mask), key);
+                if (_mm_movemask_epi8(v) != same) {
+                    break;
+                }
+            }
+            break;
+        }
+    }
+#endif
+    while (x < w && ((getpix(srcbuf + x * bpp) & rgbmask) == ckey) != keyed) {
+        x++;
+    }
+    return x;
+}
+
+/* return the first pixel from x on that is (or isn't) opaque, or translucent,
+   or the width of the surface if there is none */
+static int
+RLEFindAlpha(const RLEEncodeJob * job, Uint32 * src, int x,
+             SDL_bool transl, SDL_bool match)
+{
+    SDL_PixelFormat *sf = job->surface->format;
+    const int w = job->surface->w;
+
+#ifdef __SSE2__
+    /* Skip over 4 pixels at a time while they're all the same, leaving the
+       rest of the line to find the exact pixel.  This is only used for
+       8 bit alpha, where opaque means all of the alpha bits are set. */
+    if (job->simd) {
+        const __m128i amask = _mm_set1_epi32((int) sf->Amask);
+        const __m128i zero = _mm_setzero_si128();
+        const int same = match ? 0 : 0xFFFF;
+
+        for (; x + 4 <= w; x += 4) {
+            const __m128i a =
+                _mm_and_si128(_mm_loadu_si128((const __m128i *) (src + x)), amask);
+            int found = _mm_movemask_epi8(_mm_cmpeq_epi32(a, amask));
+            if (transl) {
+                found = ~(found | _mm_movemask_epi8(_mm_cmpeq_epi32(a, zero))) & 0xFFFF;
+            }
+            if (found != same) {
+                break;
+            }
+        }
+    }
+#endif
+    if (transl) {
+        while (x < w && (ISTRANSL(src[x], sf) ? !match : match)) {
+            x++;
+        }
+    } else {
+        while (x < w && (ISOPAQUE(src[x], sf) ? !match : match)) {
+            x++;
+        }
+    }
+    return x;
+}
+
+/* encode one scan line of a pixel-alpha surface, or just work out its length
+   if dst is NULL */
+static int
+RLEAlphaLine(const RLEEncodeJob * job, int y, Uint8 * dst, SDL_bool * blank)
+{
+    SDL_Surface *surface = job->surface;
+    SDL_PixelFormat *sf = surface->format;
+    SDL_PixelFormat *df = job->df;
+    Uint32 *src = (Uint32 *) ((Uint8 *) surface->pixels + y * surface->pitch);
+    const int w = surface->w;
+    const int max_opaque_run = 255; /* runs stored as bytes or short ints */
+    const int max_transl_run = 65535;
+    int x, size = 0;
+
+    /* opaque counts are 8 or 16 bits, depending on target depth */
+#define ADD_OPAQUE_COUNTS(n, m)         \
+    do {                                \
+        if (df->BytesPerPixel == 4) {   \
+            if (dst) {                  \
+                ((Uint16 *)(dst + size))[0] = n; \
+                ((Uint16 *)(dst + size))[1] = m; \
+            }                           \
+            size += 4;                  \
+        } else {                        \
+            if (dst) {                  \
+                dst[size] = n;          \
+                dst[size + 1] = m;      \
+            }                           \
+            size += 2;                  \
+        }                               \
+    } while (0)
+
+    /* translucent counts are always 16 bit */
+#define ADD_TRANSL_COUNTS(n, m)         \
+    do {                                \
+        if (dst) {                      \
+            ((Uint16 *)(dst + size))[0] = n; \
+            ((Uint16 *)(dst + size))[1] = m; \
+        }                               \
+        size += 4;                      \
+    } while (0)
+
+#define COPY_RUN(copy, bytes)           \
+    do {                                \
+        if (dst) {                      \
+            copy(dst + size, src + runstart, len, sf, df); \
+        }                               \
+        size += len * (bytes);          \
+    } while (0)
+
+    *blank = SDL_FALSE;
+
+    /* First encode all opaque pixels of a scan line */
+    x = 0;
+    do {
+        int run, skip, len;
+        int runstart, skipstart = x;
+        x = RLEFindAlpha(job, src, x, SDL_FALSE, SDL_TRUE);
+        runstart = x;
+        x = RLEFindAlpha(job, src, x, SDL_FALSE, SDL_FALSE);
+        skip = runstart - skipstart;
+        if (skip == w)
+            *blank = SDL_TRUE;
+        run = x - runstart;
+        while (skip > max_opaque_run) {
+            ADD_OPAQUE_COUNTS(max_opaque_run, 0);
+            skip -= max_opaque_run;
+        }
+        len = MIN(run, max_opaque_run);
+        ADD_OPAQUE_COUNTS(skip, len);
+        COPY_RUN(job->copy_opaque, df->BytesPerPixel);
+        runstart += len;
+        run -= len;
+        while (run) {
+            len = MIN(run, max_opaque_run);
+            ADD_OPAQUE_COUNTS(0, len);
+            COPY_RUN(job->copy_opaque, df->BytesPerPixel);
+            runstart += len;
+            run -= len;
+        }
+    } while (x < w);
+
+    /* Make sure the translucent pixels are 32-bit aligned; every line
+       starts aligned, since the line before it ends with them */
+    if (size & 2) {
+        if (dst) {
+            dst[size] = dst[size + 1] = 0;
+        }
+        size += 2;
+    }
+
+    /* Next, encode all translucent pixels of the same scan line */
+    x = 0;
+    do {
+        int run, skip, len;
+        int runstart, skipstart = x;
+        x = RLEFindAlpha(job, src, x, SDL_TRUE, SDL_TRUE);
+        runstart = x;
+        x = RLEFindAlpha(job, src, x, SDL_TRUE, SDL_FALSE);
+        skip = runstart - skipstart;
+        if (skip != w)
+            *blank = SDL_FALSE;
+        run = x - runstart;
+        while (skip > max_transl_run) {
+            ADD_TRANSL_COUNTS(max_transl_run, 0);
+            skip -= max_transl_run;
+        }
+        len = MIN(run, max_transl_run);
+        ADD_TRANSL_COUNTS(skip, len);
+        COPY_RUN(job->copy_transl, 4);
+        runstart += len;
+        run -= len;
+        while (run) {
+            len = MIN(run, max_transl_run);
+            ADD_TRANSL_COUNTS(0, len);
+            COPY_RUN(job->copy_transl, 4);
+            runstart += len;
+            run -= len;
+        }
+    } while (x < w);
+
+#undef ADD_OPAQUE_COUNTS
+#undef ADD_TRANSL_COUNTS
+#undef COPY_RUN
+
+    return size;
+}
+
+/* encode one scan line of a colorkeyed surface, or just work out its length
+   if dst is NULL */
+static int
+RLEColorkeyLine(const RLEEncodeJob * job, int y, Uint8 * dst, SDL_bool * blank)
+{
+    SDL_Surface *surface = job->surface;
+    Uint8 *srcbuf = (Uint8 *) surface->pixels + y * surface->pitch;
+    const int bpp = surface->format->BytesPerPixel;
+    const int maxn = bpp == 4 ? 65535 : 255;
+    const int w = surface->w;
+    int x = 0, size = 0;
+
+#define ADD_COUNTS(n, m)                \
+    do {                                \
+        if (bpp == 4) {                 \
+            if (dst) {                  \
+                ((Uint16 *)(dst + size))[0] = n; \
+                ((Uint16 *)(dst + size))[1] = m; \
+            }                           \
+            size += 4;                  \
+        } else {                        \
+            if (dst) {                  \
+                dst[size] = n;          \
+                dst[size + 1] = m;      \
+            }                           \
+            size += 2;                  \
+        }                               \
+    } while (0)
+
+#define COPY_RUN()                      \
+    do {                                \
+        if (dst) {                      \
+            SDL_memcpy(dst + size, srcbuf + runstart * bpp, len * bpp); \
+        }                               \
+        size += len * bpp;              \
+    } while (0)
+
+    *blank = SDL_FALSE;
+    do {
+        int run, skip, len;
+        int runstart;
+        int skipstart = x;
+
+        /* find run of transparent, then opaque pixels */
+        x = RLEFindColorkey(job, srcbuf, x, SDL_FALSE);
+        runstart = x;
+        x = RLEFindColorkey(job, srcbuf, x, SDL_TRUE);
+        skip = runstart - skipstart;
+        if (skip == w)
+            *blank = SDL_TRUE;
+        run = x - runstart;
+
+        /* encode segment */
+        while (skip > maxn) {
+            ADD_COUNTS(maxn, 0);
+            skip -= maxn;
+        }
+        len = MIN(run, maxn);
+        ADD_COUNTS(skip, len);
+        COPY_RUN();
+        run -= len;
+        runstart += len;
+        while (run) {
+            len = MIN(run, maxn);
+            ADD_COUNTS(0, len);
+            COPY_RUN();
+            runstart += len;
+            run -= len;
+        }
+    } while (x < w);
+
+#undef ADD_COUNTS
+#undef COPY_RUN
+
+    return size;
+}
+
+static void
+RLEEncodeBand(void *data, int index)
+{
+    const RLEEncodeJob *job = (const RLEEncodeJob *) data;
+    int y = (job->lines * index) / job->bands;
+    int end = (job->lines * (index + 1)) / job->bands;
+    SDL_bool blank;
+    int size;
+
+    for (; y < end; ++y) {
+        Uint8 *dst = job->rlebuf ? job->rlebuf + job->offsets[y] : NULL;
+        if (job->df) {
+            size = RLEAlphaLine(job, y, dst, &blank);
+        } else {
+            size = RLEColorkeyLine(job, y, dst, &blank);
+        }
+        if (!dst) {
+            job->offsets[y + 1] = size;
+            job->blank[y] = blank;
+        }
+    }
+}
+
+/* Encode the whole surface, after a header of the given size, and end it
+   with a zero <skip>,<run> pair of the given size.  Returns the new buffer,
+   or NULL if out of memory. */
+static Uint8 *
+RLEEncode(RLEEncodeJob * job, size_t header, size_t end)
+{
+    SDL_Surface *surface = job->surface;
+    const int h = surface->h;
+    size_t *offsets;
+    Uint8 *rlebuf;
+    int y, last;
+
+    offsets = (size_t *) SDL_malloc((h + 1) * sizeof(size_t) + h);
+    if (!offsets) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    job->offsets = offsets;
+    job->blank = (Uint8 *) (offsets + h + 1);
+    job->bands = SDL_GetBlitBands(surface, NULL, surface->w, h);
+
+    /* Work out the length of every line */
+    job->rlebuf = NULL;
+    job->lines = h;
+    if (job->bands > 1) {
+        SDL_RunParallel(RLEEncodeBand, job, job->bands, 0);
+    } else {
+        RLEEncodeBand(job, 0);
+    }
+
+    /* Lay the lines out one after another, leaving off trailing blank lines */
+    offsets[0] = header;
+    last = 0;
+    for (y = 0; y < h; y++) {
+        offsets[y + 1] += offsets[y];
+        if (!job->blank[y]) {
+            last = y + 1;
+        }
+    }
+
+    rlebuf = (Uint8 *) SDL_malloc(offsets[last] + end);
+    if (!rlebuf) {
+        SDL_free(offsets);
+        SDL_OutOfMemory();
+        return NULL;
+    }
+
+    /* Now do the actual encoding */
+    job->rlebuf = rlebuf;
+    job->lines = last;
+    if (job->bands > 1) {
+        SDL_RunParallel(RLEEncodeBand, job, job->bands, 0);
+    } else {
+        RLEEncodeBand(job, 0);
+    }
+    SDL_memset(rlebuf + offsets[last], 0, end);
+
+    SDL_free(offsets);
+    return rlebuf;
+}
+
 /* convert surface to be quickly alpha-blittable onto dest, if possible */
 static int
 RLEAlphaSurface(SDL_Surface * surface)
 {
     SDL_Surface *dest;
     SDL_PixelFormat *df;
-    int maxsize = 0;
-    int max_opaque_run;
-    int max_transl_run = 65535;
     unsigned masksum;
-    Uint8 *rlebuf, *dst;
-    int (*copy_opaque) (void *, Uint32 *, int,
-                        SDL_PixelFormat *, SDL_PixelFormat *);
-    int (*copy_transl) (void *, Uint32 *, int,
-                        SDL_PixelFormat *, SDL_PixelFormat *);
+    Uint8 *rlebuf;
+    RLEEncodeJob job;
 
     dest = surface->map->dst;
     if (!dest)
@@ -1032,8 +1483,11 @@ RLEAlphaSurface(SDL_Surface * surface)
     if (surface->format->BitsPerPixel != 32)
         return -1;              /* only 32bpp source supported */
 
-    /* find out whether the destination is one we support,
-       and determine the max size of the encoded result */
+    SDL_zero(job);
+    job.surface = surface;
+    job.df = df;
+
+    /* find out whether the destination is one we support */
     masksum = df->Rmask | df->Gmask | df->Bmask;
     switch (df->BytesPerPixel) {
     case 2:
@@ -1042,50 +1496,46 @@ RLEAlphaSurface(SDL_Surface * surface)
         case 0xffff:
             if (df->Gmask == 0x07e0
                 || df->Rmask == 0x07e0 || df->Bmask == 0x07e0) {
-                copy_opaque = copy_opaque_16;
-                copy_transl = copy_transl_565;
+                job.copy_opaque = copy_opaque_16;
+                job.copy_transl = copy_transl_565;
             } else
                 return -1;
             break;
         case 0x7fff:
             if (df->Gmask == 0x03e0
                 || df->Rmask == 0x03e0 || df->Bmask == 0x03e0) {
-                copy_opaque = copy_opaque_16;
-                copy_transl = copy_transl_555;
+                job.copy_opaque = copy_opaque_16;
+                job.copy_transl = copy_transl_555;
             } else
                 return -1;
             break;
         default:
             return -1;
         }
-        max_opaque_run = 255;   /* runs stored as bytes */
-
-        /* worst case is alternating opaque and translucent pixels,
-           with room for alignment padding between lines */
-        maxsize = surface->h * (2 + (4 + 2) * (surface->w + 1)) + 2;
         break;
     case 4:
         if (masksum != 0x00ffffff)
             return -1;          /* requires unused high byte */
-        copy_opaque = copy_32;
-        copy_transl = copy_32;
-        max_opaque_run = 255;   /* runs stored as short ints */
-
-        /* worst case is alternating opaque and translucent pixels */
-        maxsize = surface->h * 2 * 4 * (surface->w + 1) + 4;
+        job.copy_opaque = copy_32;
+        job.copy_transl = copy_32;
         break;
     default:
         return -1;              /* anything else unsupported right now */
     }
 
-    maxsize += sizeof(RLEDestFormat);
-    rlebuf = (Uint8 *) SDL_malloc(maxsize);
+#ifdef __SSE2__
+    job.simd = (SDL_HasSSE2() &&
+                (surface->format->Amask >> surface->format->Ashift) == 0xFF);
+#endif
+
+    rlebuf = RLEEncode(&job, sizeof(RLEDestFormat), df->BytesPerPixel);
     if (!rlebuf) {
-        return SDL_OutOfMemory();
+        return -1;
     }
     {
         /* save the destination format so we can undo the encoding later */
         RLEDestFormat *r = (RLEDestFormat *) rlebuf;
+        SDL_zerop(r);
         r->BytesPerPixel = df->BytesPerPixel;
         r->Rmask = df->Rmask;
         r->Gmask = df->Gmask;
@@ -1100,286 +1550,44 @@ RLEAlphaSurface(SDL_Surface * surface)
         r->Bshift = df->Bshift;
         r->Ashift = df->Ashift;
     }
-    dst = rlebuf + sizeof(RLEDestFormat);
-
-    /* Do the actual encoding */
-    {
-        int x, y;
-        int h = surface->h, w = surface->w;
-        SDL_PixelFormat *sf = surface->format;
-        Uint32 *src = (Uint32 *) surface->pixels;
-        Uint8 *lastline = dst;  /* end of last non-blank line */
-
-        /* opaque counts are 8 or 16 bits, depending on target depth */
-#define ADD_OPAQUE_COUNTS(n, m)         \
-    if(df->BytesPerPixel == 4) {        \
-        ((Uint16 *)dst)[0] = n;     \
-        ((Uint16 *)dst)[1] = m;     \
-        dst += 4;               \
-    } else {                \
-        dst[0] = n;             \
-        dst[1] = m;             \
-        dst += 2;               \
-    }
-
-        /* translucent counts are always 16 bit */
-#define ADD_TRANSL_COUNTS(n, m)     \
-    (((Uint16 *)dst)[0] = n, ((Uint16 *)dst)[1] = m, dst += 4)
-
-        for (y = 0; y < h; y++) {
-            int runstart, skipstart;
-            int blankline = 0;
-            /* First encode all opaque pixels of a scan line */
-            x = 0;
-            do {
-                int run, skip, len;
-                skipstart = x;
-                while (x < w && !ISOPAQUE(src[x], sf))
-                    x++;
-                runstart = x;
-                while (x < w && ISOPAQUE(src[x], sf))
-                    x++;
-                skip = runstart - skipstart;
-                if (skip == w)
-                    blankline = 1;
-                run = x - runstart;
-                while (skip > max_opaque_run) {
-                    ADD_OPAQUE_COUNTS(max_opaque_run, 0);
-                    skip -= max_opaque_run;
-                }
-                len = MIN(run, max_opaque_run);
-                ADD_OPAQUE_COUNTS(skip, len);
-                dst += copy_opaque(dst, src + runstart, len, sf, df);
-                runstart += len;
-                run -= len;
-                while (run) {
-                    len = MIN(run, max_opaque_run);
-                    ADD_OPAQUE_COUNTS(0, len);
-                    dst += copy_opaque(dst, src + runstart, len, sf, df);
-                    runstart += len;
-                    run -= len;
-                }
-            } while (x < w);
-
-            /* Make sure the next output address is 32-bit aligned */
-            dst += (uintptr_t) dst & 2;
-
-            /* Next, encode all translucent pixels of the same scan line */
-            x = 0;
-            do {
-                int run, skip, len;
-                skipstart = x;
-                while (x < w && !ISTRANSL(src[x], sf))
-                    x++;
-                runstart = x;
-                while (x < w && ISTRANSL(src[x], sf))
-                    x++;
-                skip = runstart - skipstart;
-                blankline &= (skip == w);
-                run = x - runstart;
-                while (skip > max_transl_run) {
-                    ADD_TRANSL_COUNTS(max_transl_run, 0);
-                    skip -= max_transl_run;
-                }
-                len = MIN(run, max_transl_run);
-                ADD_TRANSL_COUNTS(skip, len);
-                dst += copy_transl(dst, src + runstart, len, sf, df);
-                runstart += len;
-                run -= len;
-                while (run) {
-                    len = MIN(run, max_transl_run);
-                    ADD_TRANSL_COUNTS(0, len);
-                    dst += copy_transl(dst, src + runstart, len, sf, df);
-                    runstart += len;
-                    run -= len;
-                }
-                if (!blankline)
-                    lastline = dst;
-            } while (x < w);
-
-            src += surface->pitch >> 2;
-        }
-        dst = lastline;         /* back up past trailing blank lines */
-        ADD_OPAQUE_COUNTS(0, 0);
-    }
-
-#undef ADD_OPAQUE_COUNTS
-#undef ADD_TRANSL_COUNTS
 
     /* Now that we have it encoded, release the original pixels */
     if (!(surface->flags & SDL_PREALLOC)) {
-        SDL_free(surface->pixels);
-        surface->pixels = NULL;
-    }
-
-    /* realloc the buffer to release unused memory */
-    {
-        Uint8 *p = SDL_realloc(rlebuf, dst - rlebuf);
-        if (!p)
-            p = rlebuf;
-        surface->map->data = p;
+        SDL_FreeSurfacePixels(surface);
     }
+    surface->map->data = rlebuf;
 
     return 0;
 }
 
-static Uint32
-getpix_8(Uint8 * srcbuf)
-{
-    return *srcbuf;
-}
-
-static Uint32
-getpix_16(Uint8 * srcbuf)
-{
-    return *(Uint16 *) srcbuf;
-}
-
-static Uint32
-getpix_24(Uint8 * srcbuf)
-{
-#if SDL_BYTEORDER == SDL_LIL_ENDIAN
-    return srcbuf[0] + (srcbuf[1] << 8) + (srcbuf[2] << 16);
-#else
-    return (srcbuf[0] << 16) + (srcbuf[1] << 8) + srcbuf[2];
-#endif
-}
-
-static Uint32
-getpix_32(Uint8 * srcbuf)
-{
-    return *(Uint32 *) srcbuf;
-}
-
-typedef Uint32(*getpix_func) (Uint8 *);
-
-static const getpix_func getpixes[4] = {
-    getpix_8, getpix_16, getpix_24, getpix_32
-};
-
 static int
 RLEColorkeySurface(SDL_Surface * surface)
 {
-    Uint8 *rlebuf, *dst;
-    int maxn;
-    int y;
-    Uint8 *srcbuf, *lastline;
-    int maxsize = 0;
-    int bpp = surface->format->BytesPerPixel;
-    getpix_func getpix;
-    Uint32 ckey, rgbmask;
-    int w, h;
-
-    /* calculate the worst case size for the compressed surface */
-    switch (bpp) {
-    case 1:
-        /* worst case is alternating opaque and transparent pixels,
-           starting with an opaque pixel */
-        maxsize = surface->h * 3 * (surface->w / 2 + 1) + 2;
-        break;
-    case 2:
-    case 3:
-        /* worst case is solid runs, at most 255 pixels wide */
-        maxsize = surface->h * (2 * (surface->w / 255 + 1)
-                                + surface->w * bpp) + 2;
-        break;
-    case 4:
-        /* worst case is solid runs, at most 65535 pixels wide */
-        maxsize = surface->h * (4 * (surface->w / 65535 + 1)
-                                + surface->w * 4) + 4;
-        break;
-    }
-
-    rlebuf = (Uint8 *) SDL_malloc(maxsize);
-    if (rlebuf == NULL) {
-        return SDL_OutOfMemory();
-    }
+    const int bpp = surface->format->BytesPerPixel;
+    Uint8 *rlebuf;
+    RLEEncodeJob job;
 
     /* Set up the conversion */
-    srcbuf = (Uint8 *) surface->pixels;
-    maxn = bpp == 4 ? 65535 : 255;
-    dst = rlebuf;
-    rgbmask = ~surface->format->Amask;
-    ckey = surface->map->info.colorkey & rgbmask;
-    lastline = dst;
-    getpix = getpixes[bpp - 1];
-    w = surface->w;
-    h = surface->h;
-
-#define ADD_COUNTS(n, m)            \
-    if(bpp == 4) {              \
-        ((Uint16 *)dst)[0] = n;     \
-        ((Uint16 *)dst)[1] = m;     \
-        dst += 4;               \
-    } else {                \
-        dst[0] = n;             \
-        dst[1] = m;             \
-        dst += 2;               \
-    }
-
-    for (y = 0; y < h; y++) {
-        int x = 0;
-        int blankline = 0;
-        do {
-            int run, skip, len;
-            int runstart;
-            int skipstart = x;
-
-            /* find run of transparent, then opaque pixels */
-            while (x < w && (getpix(srcbuf + x * bpp) & rgbmask) == ckey)
-                x++;
-            runstart = x;
-            while (x < w && (getpix(srcbuf + x * bpp) & rgbmask) != ckey)
-                x++;
-            skip = runstart - skipstart;
-            if (skip == w)
-                blankline = 1;
-            run = x - runstart;
-
-            /* encode segment */
-            while (skip > maxn) {
-                ADD_COUNTS(maxn, 0);
-                skip -= maxn;
-            }
-            len = MIN(run, maxn);
-            ADD_COUNTS(skip, len);
-            SDL_memcpy(dst, srcbuf + runstart * bpp, len * bpp);
-            dst += len * bpp;
-            run -= len;
-            runstart += len;
-            while (run) {
-                len = MIN(run, maxn);
-                ADD_COUNTS(0, len);
-                SDL_memcpy(dst, srcbuf + runstart * bpp, len * bpp);
-                dst += len * bpp;
-                runstart += len;
-                run -= len;
-            }
-            if (!blankline)
-                lastline = dst;
-        } while (x < w);
+    SDL_zero(job);
+    job.surface = surface;
+    job.rgbmask = ~surface->format->Amask;
+    job.ckey = surface->map->info.colorkey & job.rgbmask;
+#ifdef __SSE2__
+    /* a colorkey that doesn't fit in a pixel never matches anything */
+    job.simd = (SDL_HasSSE2() &&
+                (bpp == 4 || (job.ckey >> (bpp * 8)) == 0));
+#endif
 
-        srcbuf += surface->pitch;
+    rlebuf = RLEEncode(&job, 0, bpp == 4 ? 4 : 2);
+    if (!rlebuf) {
+        return -1;
     }
-    dst = lastline;             /* back up bast trailing blank lines */
-    ADD_COUNTS(0, 0);
-
-#undef ADD_COUNTS
 
     /* Now that we have it encoded, release the original pixels */
     if (!(surface->flags & SDL_PREALLOC)) {
-        SDL_free(surface->pixels);
-        surface->pixels = NULL;
-    }
-
-    /* realloc the buffer to release unused memory */
-    {
-        /* If realloc returns NULL, the original block is left intact */
-        Uint8 *p = SDL_realloc(rlebuf, dst - rlebuf);
-        if (!p)
-            p = rlebuf;
-        surface->map->data = p;
+        SDL_FreeSurfacePixels(surface);
     }
+    surface->map->data = rlebuf;
 
     return (0);
 }
@@ -1469,8 +1677,7 @@ UnRLEAlpha(SDL_Surface * surface)
         uncopy_opaque = uncopy_transl = uncopy_32;
     }
 
-    surface->pixels = SDL_malloc(surface->h * surface->pitch);
-    if (!surface->pixels) {
+    if (SDL_AllocSurfacePixels(surface) < 0) {
         return (SDL_FALSE);
     }
     /* fill background with transparent pixels */
@@ -1532,8 +1739,7 @@ SDL_UnRLESurface(SDL_Surface * surface, int recode)
                 SDL_Rect full;
 
                 /* re-create the original surface */
-                surface->pixels = SDL_malloc(surface->h * surface->pitch);
-                if (!surface->pixels) {
+                if (SDL_AllocSurfacePixels(surface) < 0) {
                     /* Oh crap... */
                     surface->flags |= SDL_RLEACCEL;
                     return;
@@ -21,6 +21,8 @@
 #include "../SDL_internal.h"
 
 #include "SDL_video.h"
+#include "SDL_hints.h"
+#include "SDL_atomic.h"
 #include "SDL_sysvideo.h"
 #include "SDL_blit.h"
 #include "SDL_blit_auto.h"
@@ -28,6 +30,91 @@
 #include "SDL_blit_slow.h"
 #include "SDL_RLEaccel_c.h"
 #include "SDL_pixels_c.h"
+#include "../thread/SDL_threadpool_c.h"
+
+/* Blits smaller than this are never split up between threads */
+#define SDL_BLIT_MIN_PARALLEL_PIXELS    (128 * 128)
+
+/* The fewest rows in each band of a blit split between threads */
+#define SDL_BLIT_MIN_BAND_ROWS          8
+
+/* The number of blit functions remembered by SDL_CalculateBlit() */
+#define SDL_BLIT_CACHE_SIZE             64
+
+/* Marks a cache key for a mapping that's a straight copy */
+#define SDL_BLIT_CACHE_IDENTITY         0x80000000
+
+/* A blit function chosen before for a pair of formats and copy flags */
+typedef struct
+{
+    Uint32 src_format;
+    Uint32 dst_format;
+    Uint32 flags;
+    SDL_BlitFunc blit;
+} SDL_BlitCacheEntry;
+
+static SDL_BlitCacheEntry SDL_blit_cache[SDL_BLIT_CACHE_SIZE];
+static SDL_SpinLock SDL_blit_cache_lock;
+
+/* A blit split into bands of destination rows */
+typedef struct
+{
+    const SDL_BlitInfo *info;
+    SDL_BlitFunc blit;
+    int bands;
+} SDL_BlitBandJob;
+
+/* Work out how many bands of rows a w x h blit should be split into, to be
+   run on different threads, or 1 if it should be run in one go */
+int
+SDL_GetBlitBands(SDL_Surface * src, SDL_Surface * dst, int w, int h)
+{
+    const char *hint;
+    int threshold;
+
+    /* A blit within one surface has to go in order */
+    if (src == dst || w * h < SDL_BLIT_MIN_PARALLEL_PIXELS) {
+        return 1;
+    }
+    hint = SDL_GetHint(SDL_HINT_BLIT_THREADS_THRESHOLD);
+    threshold = hint ? SDL_atoi(hint) : 0;
+    if (threshold <= 0 || w * h < threshold) {
+        return 1;
+    }
+    /* A few bands per thread, so threads that finish early can help out */
+    return SDL_max(SDL_min(SDL_GetCPUCount() * 4, h / SDL_BLIT_MIN_BAND_ROWS), 1);
+}
+
+static void
+SDL_BlitBand(void *data, int index)
+{
+    const SDL_BlitBandJob *job = (const SDL_BlitBandJob *) data;
+    const SDL_BlitInfo *info = job->info;
+    SDL_BlitInfo band = *info;
+    int y = (info->dst_h * index) / job->bands;
+    int end = (info->dst_h * (index + 1)) / job->bands;
+
+    if (info->flags & SDL_COPY_NEAREST) {
+        /* Scaling blits step through the source from the first row, so
+           each row is done on its own, starting from the source row the
+           whole blit would have got to */
+        const Sint64 incy = ((Sint64) info->src_h << 16) / info->dst_h;
+
+        for (; y < end; ++y) {
+            band.src = info->src + (int) ((y * incy) >> 16) * info->src_pitch;
+            band.src_h = 1;
+            band.dst = info->dst + y * info->dst_pitch;
+            band.dst_h = 1;
+            job->blit(&band);
+        }
+    } else {
+        band.src = info->src + y * info->src_pitch;
+        band.src_h = end - y;
+        band.dst = info->dst + y * info->dst_pitch;
+        band.dst_h = end - y;
+        job->blit(&band);
+    }
+}
 
 /* The general purpose software blit routine */
 static int
@@ -64,6 +151,7 @@ SDL_SoftBlit(SDL_Surface * src, SDL_Rect * srcrect,
     if (okay && !SDL_RectEmpty(srcrect)) {
         SDL_BlitFunc RunBlit;
         SDL_BlitInfo *info = &src->map->info;
+        int bands;
 
         /* Set up the blit information */
         info->src = (Uint8 *) src->pixels +
@@ -85,7 +173,17 @@ SDL_SoftBlit(SDL_Surface * src, SDL_Rect * srcrect,
         RunBlit = (SDL_BlitFunc) src->map->data;
 
         /* Run the actual software blit */
-        RunBlit(info);
+        bands = SDL_GetBlitBands(src, dst, info->dst_w, info->dst_h);
+        if (bands > 1) {
+            SDL_BlitBandJob job;
+
+            job.info = info;
+            job.blit = RunBlit;
+            job.bands = bands;
+            SDL_RunParallel(SDL_BlitBand, &job, bands, 0);
+        } else {
+            RunBlit(info);
+        }
     }
 
     /* We need to unlock the surfaces if they're locked */
@@ -211,31 +309,14 @@ SDL_ChooseBlitFunc(Uint32 src_format, Uint32 dst_format, int flags,
     return NULL;
 }
 
-/* Figure out which of many blit routines to set up on a surface */
-int
-SDL_CalculateBlit(SDL_Surface * surface)
+/* Search the blit tables for the best function for a mapping */
+static SDL_BlitFunc
+SDL_ChooseBlit(SDL_Surface * surface)
 {
     SDL_BlitFunc blit = NULL;
     SDL_BlitMap *map = surface->map;
     SDL_Surface *dst = map->dst;
 
-    /* Clean everything out to start */
-    if ((surface->flags & SDL_RLEACCEL) == SDL_RLEACCEL) {
-        SDL_UnRLESurface(surface, 1);
-    }
-    map->blit = SDL_SoftBlit;
-    map->info.src_fmt = surface->format;
-    map->info.src_pitch = surface->pitch;
-    map->info.dst_fmt = dst->format;
-    map->info.dst_pitch = dst->pitch;
-
-    /* See if we can do RLE acceleration */
-    if (map->info.flags & SDL_COPY_RLE_DESIRED) {
-        if (SDL_RLESurface(surface) == 0) {
-            return 0;
-        }
-    }
-
     /* Choose a standard blit function */
     if (map->identity && !(map->info.flags & ~SDL_COPY_RLE_DESIRED)) {
         blit = SDL_BlitCopy;
@@ -272,6 +353,82 @@ SDL_CalculateBlit(SDL_Surface * surface)
             blit = SDL_Blit_Slow;
         }
     }
+    return blit;
+}
+
+/* Look up the blit function for a mapping, using the one chosen last time
+   for the same formats and flags if there is one.  The CPU features the
+   choice depends on don't change while running, so they aren't part of the
+   key.  Paletted and unknown formats aren't cached, since the format alone
+   doesn't say everything about them. */
+static SDL_BlitFunc
+SDL_LookupBlit(SDL_Surface * surface)
+{
+    SDL_BlitMap *map = surface->map;
+    const Uint32 src_format = surface->format->format;
+    const Uint32 dst_format = map->dst->format->format;
+    const Uint32 flags = map->info.flags |
+        (map->identity ? SDL_BLIT_CACHE_IDENTITY : 0);
+    SDL_BlitCacheEntry *entry;
+    SDL_BlitFunc blit = NULL;
+
+    if (src_format == SDL_PIXELFORMAT_UNKNOWN ||
+        dst_format == SDL_PIXELFORMAT_UNKNOWN ||
+        SDL_ISPIXELFORMAT_INDEXED(src_format) ||
+        SDL_ISPIXELFORMAT_INDEXED(dst_format)) {
+        return SDL_ChooseBlit(surface);
+    }
+
+    entry = &SDL_blit_cache[((src_format * 31 + dst_format) * 31 + flags) %
+                            SDL_BLIT_CACHE_SIZE];
+    SDL_AtomicLock(&SDL_blit_cache_lock);
+    if (entry->blit && entry->src_format == src_format &&
+        entry->dst_format == dst_format && entry->flags == flags) {
+        blit = entry->blit;
+    }
+    SDL_AtomicUnlock(&SDL_blit_cache_lock);
+    if (blit) {
+        return blit;
+    }
+
+    blit = SDL_ChooseBlit(surface);
+    if (blit) {
+        SDL_AtomicLock(&SDL_blit_cache_lock);
+        entry->src_format = src_format;
+        entry->dst_format = dst_format;
+        entry->flags = flags;
+        entry->blit = blit;
+        SDL_AtomicUnlock(&SDL_blit_cache_lock);
+    }
+    return blit;
+}
+
+/* Figure out which of many blit routines to set up on a surface */
+int
+SDL_CalculateBlit(SDL_Surface * surface)
+{
+    SDL_BlitFunc blit = NULL;
+    SDL_BlitMap *map = surface->map;
+    SDL_Surface *dst = map->dst;
+
+    /* Clean everything out to start */
+    if ((surface->flags & SDL_RLEACCEL) == SDL_RLEACCEL) {
+        SDL_UnRLESurface(surface, 1);
+    }
+    map->blit = SDL_SoftBlit;
+    map->info.src_fmt = surface->format;
+    map->info.src_pitch = surface->pitch;
+    map->info.dst_fmt = dst->format;
+    map->info.dst_pitch = dst->pitch;
+
+    /* See if we can do RLE acceleration */
+    if (map->info.flags & SDL_COPY_RLE_DESIRED) {
+        if (SDL_RLESurface(surface) == 0) {
+            return 0;
+        }
+    }
+
+    blit = SDL_LookupBlit(surface);
     map->data = blit;
 
     /* Make sure we have a blit function */
@@ -283,4 +440,24 @@ SDL_CalculateBlit(SDL_Surface * surface)
     return 0;
 }
 
+/* Called when only the modulation or blend flags of a surface changed.  Its
+   mapping to the destination still holds, so only the blit function has to
+   be chosen again, unless the source is paletted or RLE encoded, where the
+   mapping itself depends on them.  Returns -1 if no blitter supports the new
+   flags, leaving the map invalid for the next blit to report again. */
+int
+SDL_UpdateBlitFlags(SDL_Surface * surface)
+{
+    SDL_BlitMap *map = surface->map;
+
+    if (!map->dst || SDL_ISPIXELFORMAT_INDEXED(surface->format->format) ||
+        (map->info.flags & SDL_COPY_RLE_DESIRED) ||
+        (surface->flags & SDL_RLEACCEL)) {
+        SDL_InvalidateMap(map);
+        return 0;
+    }
+
+    return SDL_CalculateBlit(surface);
+}
+
 /* vi: set ts=4 sw=4 expandtab: */
@@ -90,6 +90,12 @@ typedef struct SDL_BlitMap
     void *data;
     SDL_BlitInfo info;
 
+    /* Filtered pixels for scaled linear blits, kept between blits */
+    SDL_Surface *scratch;
+
+    /* Set when info.table is a palette's shared inverse colormap */
+    struct SDL_InverseColormap *colormap;
+
     /* the version count matches the destination; mismatch indicates
        an invalid mapping */
     Uint32 dst_palette_version;
@@ -98,6 +104,8 @@ typedef struct SDL_BlitMap
 
 /* Functions found in SDL_blit.c */
 extern int SDL_CalculateBlit(SDL_Surface * surface);
+extern int SDL_UpdateBlitFlags(SDL_Surface * surface);
+extern int SDL_GetBlitBands(SDL_Surface * src, SDL_Surface * dst, int w, int h);
 
 /* Functions found in SDL_blit_*.c */
 extern SDL_BlitFunc SDL_CalculateBlit0(SDL_Surface * surface);
@@ -117,6 +125,32 @@ extern SDL_BlitFunc SDL_CalculateBlitA(SDL_Surface * surface);
 #define DECLARE_ALIGNED(t,v,a)  t v
 #endif
 
+/* AVX2 code can be built into functions marked SDL_TARGETING_AVX2, even
+   when the rest of SDL isn't built for it, and picked with SDL_HasAVX2() */
+#if defined(__AVX2__)
+#define SDL_AVX2_INTRINSICS 1
+#define SDL_TARGETING_AVX2
+#elif defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__)) && \
+      ((defined(__clang__) && ((__clang_major__ > 3) || (__clang_major__ == 3 && __clang_minor__ >= 8))) || \
+       (!defined(__clang__) && ((__GNUC__ > 4) || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))))
+#define SDL_AVX2_INTRINSICS 1
+#define SDL_TARGETING_AVX2 __attribute__((target("avx2")))
+#elif defined(_MSC_VER) && (_MSC_VER >= 1700) && (defined(_M_IX86) || defined(_M_X64))
+#define SDL_AVX2_INTRINSICS 1
+#define SDL_TARGETING_AVX2
+#endif
+#ifdef SDL_AVX2_INTRINSICS
+#include <immintrin.h>
+#endif
+
+/* The alignment of the pixels of SDL_SIMD_ALIGNED surfaces, and the most
+   that SDL_HINT_SURFACE_ALIGNMENT can ask of their rows */
+#define SDL_SIMD_ALIGNMENT  64
+
+/* Fills and copies writing at least this many bytes use non-temporal
+   stores where they can, since they won't fit in the cache anyway */
+#define SDL_BLIT_NONTEMPORAL_BYTES  (8 * 1024 * 1024)
+
 /* Load pixel of the specified format from a buffer and get its R-G-B values */
 #define RGB_FROM_PIXEL(Pixel, fmt, r, g, b)                             \
 {                                                                       \
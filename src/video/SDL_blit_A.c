@@ -60,7 +60,8 @@ BlitNto1SurfaceAlpha(SDL_BlitInfo * info)
 		if ( palmap == NULL ) {
 		    *dst =((dR>>5)<<(3+2))|((dG>>5)<<(2))|((dB>>6)<<(0));
 		} else {
-		    *dst = palmap[((dR>>5)<<(3+2))|((dG>>5)<<(2))|((dB>>6)<<(0))];
+		    RGB555_FROM_RGB(Pixel, dR, dG, dB);
+		    *dst = palmap[Pixel];
 		}
 		dst++;
 		src += srcbpp;
@@ -106,7 +107,8 @@ BlitNto1PixelAlpha(SDL_BlitInfo * info)
 		if ( palmap == NULL ) {
 		    *dst =((dR>>5)<<(3+2))|((dG>>5)<<(2))|((dB>>6)<<(0));
 		} else {
-		    *dst = palmap[((dR>>5)<<(3+2))|((dG>>5)<<(2))|((dB>>6)<<(0))];
+		    RGB555_FROM_RGB(Pixel, dR, dG, dB);
+		    *dst = palmap[Pixel];
 		}
 		dst++;
 		src += srcbpp;
@@ -155,7 +157,8 @@ BlitNto1SurfaceAlphaKey(SDL_BlitInfo * info)
 		    if ( palmap == NULL ) {
                 *dst =((dR>>5)<<(3+2))|((dG>>5)<<(2))|((dB>>6)<<(0));
 		    } else {
-                *dst = palmap[((dR>>5)<<(3+2))|((dG>>5)<<(2))|((dB>>6)<<(0))];
+                RGB555_FROM_RGB(Pixel, dR, dG, dB);
+                *dst = palmap[Pixel];
 		    }
 		}
 		dst++;
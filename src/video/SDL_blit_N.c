@@ -889,6 +889,12 @@ GetBlitFeatures(void)
                   (((src)&0x0000E000)>>11)| \
                   (((src)&0x000000C0)>>6)); \
 }
+/* Index of an RGB 8-8-8 pixel in the 5-5-5 inverse colormap */
+#define RGB888_INDEX555(dst, src) { \
+    dst = (int)((((src)&0x00F80000)>>9)| \
+                (((src)&0x0000F800)>>6)| \
+                (((src)&0x000000F8)>>3)); \
+}
 static void
 Blit_RGB888_index8(SDL_BlitInfo * info)
 {
@@ -951,7 +957,7 @@ Blit_RGB888_index8(SDL_BlitInfo * info)
 #ifdef USE_DUFFS_LOOP
             /* *INDENT-OFF* */
             DUFFS_LOOP(
-                RGB888_RGB332(Pixel, *src);
+                RGB888_INDEX555(Pixel, *src);
                 *dst++ = map[Pixel];
                 ++src;
             , width);
@@ -959,30 +965,30 @@ Blit_RGB888_index8(SDL_BlitInfo * info)
 #else
             for (c = width / 4; c; --c) {
                 /* Pack RGB into 8bit pixel */
-                RGB888_RGB332(Pixel, *src);
+                RGB888_INDEX555(Pixel, *src);
                 *dst++ = map[Pixel];
                 ++src;
-                RGB888_RGB332(Pixel, *src);
+                RGB888_INDEX555(Pixel, *src);
                 *dst++ = map[Pixel];
                 ++src;
-                RGB888_RGB332(Pixel, *src);
+                RGB888_INDEX555(Pixel, *src);
                 *dst++ = map[Pixel];
                 ++src;
-                RGB888_RGB332(Pixel, *src);
+                RGB888_INDEX555(Pixel, *src);
                 *dst++ = map[Pixel];
                 ++src;
             }
             switch (width & 3) {
             case 3:
-                RGB888_RGB332(Pixel, *src);
+                RGB888_INDEX555(Pixel, *src);
                 *dst++ = map[Pixel];
                 ++src;
             case 2:
-                RGB888_RGB332(Pixel, *src);
+                RGB888_INDEX555(Pixel, *src);
                 *dst++ = map[Pixel];
                 ++src;
             case 1:
-                RGB888_RGB332(Pixel, *src);
+                RGB888_INDEX555(Pixel, *src);
                 *dst++ = map[Pixel];
                 ++src;
             }
@@ -999,6 +1005,12 @@ Blit_RGB888_index8(SDL_BlitInfo * info)
                   (((src)&0x000E0000)>>15)| \
                   (((src)&0x00000300)>>8)); \
 }
+/* Index of an RGB 10-10-10 pixel in the 5-5-5 inverse colormap */
+#define RGB101010_INDEX555(dst, src) { \
+    dst = (int)((((src)&0x3E000000)>>15)| \
+                (((src)&0x000F8000)>>10)| \
+                (((src)&0x000003E0)>>5)); \
+}
 static void
 Blit_RGB101010_index8(SDL_BlitInfo * info)
 {
@@ -1061,7 +1073,7 @@ Blit_RGB101010_index8(SDL_BlitInfo * info)
 #ifdef USE_DUFFS_LOOP
             /* *INDENT-OFF* */
             DUFFS_LOOP(
-                RGB101010_RGB332(Pixel, *src);
+                RGB101010_INDEX555(Pixel, *src);
                 *dst++ = map[Pixel];
                 ++src;
             , width);
@@ -1069,30 +1081,30 @@ Blit_RGB101010_index8(SDL_BlitInfo * info)
 #else
             for (c = width / 4; c; --c) {
                 /* Pack RGB into 8bit pixel */
-                RGB101010_RGB332(Pixel, *src);
+                RGB101010_INDEX555(Pixel, *src);
                 *dst++ = map[Pixel];
                 ++src;
-                RGB101010_RGB332(Pixel, *src);
+                RGB101010_INDEX555(Pixel, *src);
                 *dst++ = map[Pixel];
                 ++src;
-                RGB101010_RGB332(Pixel, *src);
+                RGB101010_INDEX555(Pixel, *src);
                 *dst++ = map[Pixel];
                 ++src;
-                RGB101010_RGB332(Pixel, *src);
+                RGB101010_INDEX555(Pixel, *src);
                 *dst++ = map[Pixel];
                 ++src;
             }
             switch (width & 3) {
             case 3:
-                RGB101010_RGB332(Pixel, *src);
+                RGB101010_INDEX555(Pixel, *src);
                 *dst++ = map[Pixel];
                 ++src;
             case 2:
-                RGB101010_RGB332(Pixel, *src);
+                RGB101010_INDEX555(Pixel, *src);
                 *dst++ = map[Pixel];
                 ++src;
             case 1:
-                RGB101010_RGB332(Pixel, *src);
+                RGB101010_INDEX555(Pixel, *src);
                 *dst++ = map[Pixel];
                 ++src;
             }
@@ -2038,9 +2050,8 @@ BlitNto1(SDL_BlitInfo * info)
                                 sR, sG, sB);
                 if ( 1 ) {
                     /* Pack RGB into 8bit pixel */
-                    *dst = map[((sR>>5)<<(3+2))|
-                           ((sG>>5)<<(2))  |
-                           ((sB>>6)<<(0))  ];
+                    RGB555_FROM_RGB(Pixel, sR, sG, sB);
+                    *dst = map[Pixel];
                 }
                 dst++;
                 src += srcbpp;
@@ -2051,8 +2062,8 @@ BlitNto1(SDL_BlitInfo * info)
                 DISEMBLE_RGB(src, srcbpp, srcfmt, Pixel, sR, sG, sB);
                 if (1) {
                     /* Pack RGB into 8bit pixel */
-                    *dst = map[((sR >> 5) << (3 + 2)) |
-                               ((sG >> 5) << (2)) | ((sB >> 6) << (0))];
+                    RGB555_FROM_RGB(Pixel, sR, sG, sB);
+                    *dst = map[Pixel];
                 }
                 dst++;
                 src += srcbpp;
@@ -2229,9 +2240,8 @@ BlitNto1Key(SDL_BlitInfo * info)
                                 sR, sG, sB);
                 if ( (Pixel & rgbmask) != ckey ) {
                     /* Pack RGB into 8bit pixel */
-                    *dst = (Uint8)palmap[((sR>>5)<<(3+2))|
-                                         ((sG>>5)<<(2))  |
-                                         ((sB>>6)<<(0))  ];
+                    RGB555_FROM_RGB(Pixel, sR, sG, sB);
+                    *dst = palmap[Pixel];
                 }
                 dst++;
                 src += srcbpp;
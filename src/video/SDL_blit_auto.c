@@ -7284,7 +7284,7152 @@ static void SDL_Blit_BGRA8888_ARGB8888_Modulate_Blend_Scale(SDL_BlitInfo *info)
     }
 }
 
+#ifdef __SSE2__
+
+/* The SSE2 blitters work on pixels widened to 16 bits per channel, two to a
+   register, with the source shuffled into the order of the destination so
+   that alpha (or the unused byte) is always in lane 3.  They give exactly
+   the same results as the C blitters above. */
+
+/* x / 255 in each lane, exact for x <= 255 * 255 */
+static SDL_INLINE __m128i
+SDL_Blit_Div255_SSE2(__m128i x)
+{
+    return _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(x, _mm_set1_epi16(1)), _mm_srli_epi16(x, 8)), 8);
+}
+
+static SDL_INLINE __m128i
+SDL_Blit_Modulate_SSE2(__m128i x, __m128i modulate)
+{
+    return SDL_Blit_Div255_SSE2(_mm_mullo_epi16(x, modulate));
+}
+
+static SDL_INLINE __m128i
+SDL_Blit_Blend_SSE2(__m128i src, __m128i dst, int flags)
+{
+    const __m128i alpha = _mm_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0);
+    const __m128i opaque = _mm_set1_epi16(255);
+    const __m128i srcA = _mm_shufflehi_epi16(_mm_shufflelo_epi16(src, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+
+    if (flags & (SDL_COPY_BLEND|SDL_COPY_ADD)) {
+        /* Premultiply the color, but not the alpha */
+        src = SDL_Blit_Modulate_SSE2(src, _mm_or_si128(_mm_andnot_si128(alpha, srcA), _mm_and_si128(alpha, opaque)));
+    }
+    switch (flags & (SDL_COPY_BLEND|SDL_COPY_ADD|SDL_COPY_MOD)) {
+    case SDL_COPY_BLEND:
+        return _mm_add_epi16(src, SDL_Blit_Div255_SSE2(_mm_mullo_epi16(_mm_sub_epi16(opaque, srcA), dst)));
+    case SDL_COPY_ADD:
+        src = _mm_min_epi16(_mm_add_epi16(src, dst), opaque);
+        break;
+    case SDL_COPY_MOD:
+        src = SDL_Blit_Modulate_SSE2(src, dst);
+        break;
+    default:
+        return dst;
+    }
+    /* Add and mod leave the destination alpha alone */
+    return _mm_or_si128(_mm_andnot_si128(alpha, src), _mm_and_si128(alpha, dst));
+}
+
+static void SDL_Blit_RGB888_RGB888_Scale_SSE2(SDL_BlitInfo *info)
+{
+    int srcy, posy, incy, incx;
+
+    srcy = 0;
+    posy = 0;
+    incy = (info->src_h << 16) / info->dst_h;
+    incx = (info->src_w << 16) / info->dst_w;
+
+    while (info->dst_h--) {
+        const Uint32 *src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        int posx = 0;
+        while (posy >= 0x10000L) {
+            ++srcy;
+            posy -= 0x10000L;
+        }
+        src = (const Uint32 *)(info->src + (srcy * info->src_pitch));
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_set_epi32((int)src[(posx + 3 * incx) >> 16], (int)src[(posx + 2 * incx) >> 16],
+                                  (int)src[(posx + incx) >> 16], (int)src[posx >> 16]);
+            } else {
+                s = _mm_cvtsi32_si128((int)src[posx >> 16]);
+            }
+            posx += count * incx;
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        posy += incy;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_RGB888_RGB888_Blend_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i opaque = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_loadu_si128((const __m128i *)src);
+            } else {
+                s = _mm_cvtsi32_si128((int)*src);
+            }
+            src += count;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                __m128i d;
+                sl = _mm_or_si128(sl, opaque);
+                sh = _mm_or_si128(sh, opaque);
+                if (count == 4) {
+                    d = _mm_loadu_si128((const __m128i *)dst);
+                } else {
+                    d = _mm_cvtsi32_si128((int)*dst);
+                }
+                sl = SDL_Blit_Blend_SSE2(sl, _mm_unpacklo_epi8(d, zero), flags);
+                sh = SDL_Blit_Blend_SSE2(sh, _mm_unpackhi_epi8(d, zero), flags);
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_RGB888_RGB888_Blend_Scale_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i opaque = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+    int srcy, posy, incy, incx;
+
+    srcy = 0;
+    posy = 0;
+    incy = (info->src_h << 16) / info->dst_h;
+    incx = (info->src_w << 16) / info->dst_w;
+
+    while (info->dst_h--) {
+        const Uint32 *src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        int posx = 0;
+        while (posy >= 0x10000L) {
+            ++srcy;
+            posy -= 0x10000L;
+        }
+        src = (const Uint32 *)(info->src + (srcy * info->src_pitch));
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_set_epi32((int)src[(posx + 3 * incx) >> 16], (int)src[(posx + 2 * incx) >> 16],
+                                  (int)src[(posx + incx) >> 16], (int)src[posx >> 16]);
+            } else {
+                s = _mm_cvtsi32_si128((int)src[posx >> 16]);
+            }
+            posx += count * incx;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                __m128i d;
+                sl = _mm_or_si128(sl, opaque);
+                sh = _mm_or_si128(sh, opaque);
+                if (count == 4) {
+                    d = _mm_loadu_si128((const __m128i *)dst);
+                } else {
+                    d = _mm_cvtsi32_si128((int)*dst);
+                }
+                sl = SDL_Blit_Blend_SSE2(sl, _mm_unpacklo_epi8(d, zero), flags);
+                sh = SDL_Blit_Blend_SSE2(sh, _mm_unpackhi_epi8(d, zero), flags);
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        posy += incy;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_RGB888_RGB888_Modulate_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i opaque = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_loadu_si128((const __m128i *)src);
+            } else {
+                s = _mm_cvtsi32_si128((int)*src);
+            }
+            src += count;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                sl = _mm_or_si128(sl, opaque);
+                sh = _mm_or_si128(sh, opaque);
+                sl = SDL_Blit_Modulate_SSE2(sl, modulate);
+                sh = SDL_Blit_Modulate_SSE2(sh, modulate);
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_RGB888_RGB888_Modulate_Scale_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i opaque = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+    int srcy, posy, incy, incx;
+
+    srcy = 0;
+    posy = 0;
+    incy = (info->src_h << 16) / info->dst_h;
+    incx = (info->src_w << 16) / info->dst_w;
+
+    while (info->dst_h--) {
+        const Uint32 *src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        int posx = 0;
+        while (posy >= 0x10000L) {
+            ++srcy;
+            posy -= 0x10000L;
+        }
+        src = (const Uint32 *)(info->src + (srcy * info->src_pitch));
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_set_epi32((int)src[(posx + 3 * incx) >> 16], (int)src[(posx + 2 * incx) >> 16],
+                                  (int)src[(posx + incx) >> 16], (int)src[posx >> 16]);
+            } else {
+                s = _mm_cvtsi32_si128((int)src[posx >> 16]);
+            }
+            posx += count * incx;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                sl = _mm_or_si128(sl, opaque);
+                sh = _mm_or_si128(sh, opaque);
+                sl = SDL_Blit_Modulate_SSE2(sl, modulate);
+                sh = SDL_Blit_Modulate_SSE2(sh, modulate);
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        posy += incy;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_RGB888_RGB888_Modulate_Blend_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i opaque = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_loadu_si128((const __m128i *)src);
+            } else {
+                s = _mm_cvtsi32_si128((int)*src);
+            }
+            src += count;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                __m128i d;
+                sl = _mm_or_si128(sl, opaque);
+                sh = _mm_or_si128(sh, opaque);
+                sl = SDL_Blit_Modulate_SSE2(sl, modulate);
+                sh = SDL_Blit_Modulate_SSE2(sh, modulate);
+                if (count == 4) {
+                    d = _mm_loadu_si128((const __m128i *)dst);
+                } else {
+                    d = _mm_cvtsi32_si128((int)*dst);
+                }
+                sl = SDL_Blit_Blend_SSE2(sl, _mm_unpacklo_epi8(d, zero), flags);
+                sh = SDL_Blit_Blend_SSE2(sh, _mm_unpackhi_epi8(d, zero), flags);
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_RGB888_RGB888_Modulate_Blend_Scale_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i opaque = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+    int srcy, posy, incy, incx;
+
+    srcy = 0;
+    posy = 0;
+    incy = (info->src_h << 16) / info->dst_h;
+    incx = (info->src_w << 16) / info->dst_w;
+
+    while (info->dst_h--) {
+        const Uint32 *src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        int posx = 0;
+        while (posy >= 0x10000L) {
+            ++srcy;
+            posy -= 0x10000L;
+        }
+        src = (const Uint32 *)(info->src + (srcy * info->src_pitch));
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_set_epi32((int)src[(posx + 3 * incx) >> 16], (int)src[(posx + 2 * incx) >> 16],
+                                  (int)src[(posx + incx) >> 16], (int)src[posx >> 16]);
+            } else {
+                s = _mm_cvtsi32_si128((int)src[posx >> 16]);
+            }
+            posx += count * incx;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                __m128i d;
+                sl = _mm_or_si128(sl, opaque);
+                sh = _mm_or_si128(sh, opaque);
+                sl = SDL_Blit_Modulate_SSE2(sl, modulate);
+                sh = SDL_Blit_Modulate_SSE2(sh, modulate);
+                if (count == 4) {
+                    d = _mm_loadu_si128((const __m128i *)dst);
+                } else {
+                    d = _mm_cvtsi32_si128((int)*dst);
+                }
+                sl = SDL_Blit_Blend_SSE2(sl, _mm_unpacklo_epi8(d, zero), flags);
+                sh = SDL_Blit_Blend_SSE2(sh, _mm_unpackhi_epi8(d, zero), flags);
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        posy += incy;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_RGB888_BGR888_Scale_SSE2(SDL_BlitInfo *info)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i opaque = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+    int srcy, posy, incy, incx;
+
+    srcy = 0;
+    posy = 0;
+    incy = (info->src_h << 16) / info->dst_h;
+    incx = (info->src_w << 16) / info->dst_w;
+
+    while (info->dst_h--) {
+        const Uint32 *src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        int posx = 0;
+        while (posy >= 0x10000L) {
+            ++srcy;
+            posy -= 0x10000L;
+        }
+        src = (const Uint32 *)(info->src + (srcy * info->src_pitch));
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_set_epi32((int)src[(posx + 3 * incx) >> 16], (int)src[(posx + 2 * incx) >> 16],
+                                  (int)src[(posx + incx) >> 16], (int)src[posx >> 16]);
+            } else {
+                s = _mm_cvtsi32_si128((int)src[posx >> 16]);
+            }
+            posx += count * incx;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                sl = _mm_or_si128(sl, opaque);
+                sh = _mm_or_si128(sh, opaque);
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        posy += incy;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_RGB888_BGR888_Blend_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i opaque = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_loadu_si128((const __m128i *)src);
+            } else {
+                s = _mm_cvtsi32_si128((int)*src);
+            }
+            src += count;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                __m128i d;
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                sl = _mm_or_si128(sl, opaque);
+                sh = _mm_or_si128(sh, opaque);
+                if (count == 4) {
+                    d = _mm_loadu_si128((const __m128i *)dst);
+                } else {
+                    d = _mm_cvtsi32_si128((int)*dst);
+                }
+                sl = SDL_Blit_Blend_SSE2(sl, _mm_unpacklo_epi8(d, zero), flags);
+                sh = SDL_Blit_Blend_SSE2(sh, _mm_unpackhi_epi8(d, zero), flags);
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_RGB888_BGR888_Blend_Scale_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i opaque = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+    int srcy, posy, incy, incx;
+
+    srcy = 0;
+    posy = 0;
+    incy = (info->src_h << 16) / info->dst_h;
+    incx = (info->src_w << 16) / info->dst_w;
+
+    while (info->dst_h--) {
+        const Uint32 *src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        int posx = 0;
+        while (posy >= 0x10000L) {
+            ++srcy;
+            posy -= 0x10000L;
+        }
+        src = (const Uint32 *)(info->src + (srcy * info->src_pitch));
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_set_epi32((int)src[(posx + 3 * incx) >> 16], (int)src[(posx + 2 * incx) >> 16],
+                                  (int)src[(posx + incx) >> 16], (int)src[posx >> 16]);
+            } else {
+                s = _mm_cvtsi32_si128((int)src[posx >> 16]);
+            }
+            posx += count * incx;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                __m128i d;
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                sl = _mm_or_si128(sl, opaque);
+                sh = _mm_or_si128(sh, opaque);
+                if (count == 4) {
+                    d = _mm_loadu_si128((const __m128i *)dst);
+                } else {
+                    d = _mm_cvtsi32_si128((int)*dst);
+                }
+                sl = SDL_Blit_Blend_SSE2(sl, _mm_unpacklo_epi8(d, zero), flags);
+                sh = SDL_Blit_Blend_SSE2(sh, _mm_unpackhi_epi8(d, zero), flags);
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        posy += incy;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_RGB888_BGR888_Modulate_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i opaque = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_loadu_si128((const __m128i *)src);
+            } else {
+                s = _mm_cvtsi32_si128((int)*src);
+            }
+            src += count;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                sl = _mm_or_si128(sl, opaque);
+                sh = _mm_or_si128(sh, opaque);
+                sl = SDL_Blit_Modulate_SSE2(sl, modulate);
+                sh = SDL_Blit_Modulate_SSE2(sh, modulate);
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_RGB888_BGR888_Modulate_Scale_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i opaque = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+    int srcy, posy, incy, incx;
+
+    srcy = 0;
+    posy = 0;
+    incy = (info->src_h << 16) / info->dst_h;
+    incx = (info->src_w << 16) / info->dst_w;
+
+    while (info->dst_h--) {
+        const Uint32 *src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        int posx = 0;
+        while (posy >= 0x10000L) {
+            ++srcy;
+            posy -= 0x10000L;
+        }
+        src = (const Uint32 *)(info->src + (srcy * info->src_pitch));
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_set_epi32((int)src[(posx + 3 * incx) >> 16], (int)src[(posx + 2 * incx) >> 16],
+                                  (int)src[(posx + incx) >> 16], (int)src[posx >> 16]);
+            } else {
+                s = _mm_cvtsi32_si128((int)src[posx >> 16]);
+            }
+            posx += count * incx;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                sl = _mm_or_si128(sl, opaque);
+                sh = _mm_or_si128(sh, opaque);
+                sl = SDL_Blit_Modulate_SSE2(sl, modulate);
+                sh = SDL_Blit_Modulate_SSE2(sh, modulate);
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        posy += incy;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_RGB888_BGR888_Modulate_Blend_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i opaque = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_loadu_si128((const __m128i *)src);
+            } else {
+                s = _mm_cvtsi32_si128((int)*src);
+            }
+            src += count;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                __m128i d;
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                sl = _mm_or_si128(sl, opaque);
+                sh = _mm_or_si128(sh, opaque);
+                sl = SDL_Blit_Modulate_SSE2(sl, modulate);
+                sh = SDL_Blit_Modulate_SSE2(sh, modulate);
+                if (count == 4) {
+                    d = _mm_loadu_si128((const __m128i *)dst);
+                } else {
+                    d = _mm_cvtsi32_si128((int)*dst);
+                }
+                sl = SDL_Blit_Blend_SSE2(sl, _mm_unpacklo_epi8(d, zero), flags);
+                sh = SDL_Blit_Blend_SSE2(sh, _mm_unpackhi_epi8(d, zero), flags);
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_RGB888_BGR888_Modulate_Blend_Scale_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i opaque = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+    int srcy, posy, incy, incx;
+
+    srcy = 0;
+    posy = 0;
+    incy = (info->src_h << 16) / info->dst_h;
+    incx = (info->src_w << 16) / info->dst_w;
+
+    while (info->dst_h--) {
+        const Uint32 *src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        int posx = 0;
+        while (posy >= 0x10000L) {
+            ++srcy;
+            posy -= 0x10000L;
+        }
+        src = (const Uint32 *)(info->src + (srcy * info->src_pitch));
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_set_epi32((int)src[(posx + 3 * incx) >> 16], (int)src[(posx + 2 * incx) >> 16],
+                                  (int)src[(posx + incx) >> 16], (int)src[posx >> 16]);
+            } else {
+                s = _mm_cvtsi32_si128((int)src[posx >> 16]);
+            }
+            posx += count * incx;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                __m128i d;
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                sl = _mm_or_si128(sl, opaque);
+                sh = _mm_or_si128(sh, opaque);
+                sl = SDL_Blit_Modulate_SSE2(sl, modulate);
+                sh = SDL_Blit_Modulate_SSE2(sh, modulate);
+                if (count == 4) {
+                    d = _mm_loadu_si128((const __m128i *)dst);
+                } else {
+                    d = _mm_cvtsi32_si128((int)*dst);
+                }
+                sl = SDL_Blit_Blend_SSE2(sl, _mm_unpacklo_epi8(d, zero), flags);
+                sh = SDL_Blit_Blend_SSE2(sh, _mm_unpackhi_epi8(d, zero), flags);
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        posy += incy;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_RGB888_ARGB8888_Scale_SSE2(SDL_BlitInfo *info)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i opaque = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+    int srcy, posy, incy, incx;
+
+    srcy = 0;
+    posy = 0;
+    incy = (info->src_h << 16) / info->dst_h;
+    incx = (info->src_w << 16) / info->dst_w;
+
+    while (info->dst_h--) {
+        const Uint32 *src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        int posx = 0;
+        while (posy >= 0x10000L) {
+            ++srcy;
+            posy -= 0x10000L;
+        }
+        src = (const Uint32 *)(info->src + (srcy * info->src_pitch));
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_set_epi32((int)src[(posx + 3 * incx) >> 16], (int)src[(posx + 2 * incx) >> 16],
+                                  (int)src[(posx + incx) >> 16], (int)src[posx >> 16]);
+            } else {
+                s = _mm_cvtsi32_si128((int)src[posx >> 16]);
+            }
+            posx += count * incx;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                sl = _mm_or_si128(sl, opaque);
+                sh = _mm_or_si128(sh, opaque);
+                s = _mm_packus_epi16(sl, sh);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        posy += incy;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_RGB888_ARGB8888_Blend_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i opaque = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_loadu_si128((const __m128i *)src);
+            } else {
+                s = _mm_cvtsi32_si128((int)*src);
+            }
+            src += count;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                __m128i d;
+                sl = _mm_or_si128(sl, opaque);
+                sh = _mm_or_si128(sh, opaque);
+                if (count == 4) {
+                    d = _mm_loadu_si128((const __m128i *)dst);
+                } else {
+                    d = _mm_cvtsi32_si128((int)*dst);
+                }
+                sl = SDL_Blit_Blend_SSE2(sl, _mm_unpacklo_epi8(d, zero), flags);
+                sh = SDL_Blit_Blend_SSE2(sh, _mm_unpackhi_epi8(d, zero), flags);
+                s = _mm_packus_epi16(sl, sh);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_RGB888_ARGB8888_Blend_Scale_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i opaque = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+    int srcy, posy, incy, incx;
+
+    srcy = 0;
+    posy = 0;
+    incy = (info->src_h << 16) / info->dst_h;
+    incx = (info->src_w << 16) / info->dst_w;
+
+    while (info->dst_h--) {
+        const Uint32 *src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        int posx = 0;
+        while (posy >= 0x10000L) {
+            ++srcy;
+            posy -= 0x10000L;
+        }
+        src = (const Uint32 *)(info->src + (srcy * info->src_pitch));
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_set_epi32((int)src[(posx + 3 * incx) >> 16], (int)src[(posx + 2 * incx) >> 16],
+                                  (int)src[(posx + incx) >> 16], (int)src[posx >> 16]);
+            } else {
+                s = _mm_cvtsi32_si128((int)src[posx >> 16]);
+            }
+            posx += count * incx;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                __m128i d;
+                sl = _mm_or_si128(sl, opaque);
+                sh = _mm_or_si128(sh, opaque);
+                if (count == 4) {
+                    d = _mm_loadu_si128((const __m128i *)dst);
+                } else {
+                    d = _mm_cvtsi32_si128((int)*dst);
+                }
+                sl = SDL_Blit_Blend_SSE2(sl, _mm_unpacklo_epi8(d, zero), flags);
+                sh = SDL_Blit_Blend_SSE2(sh, _mm_unpackhi_epi8(d, zero), flags);
+                s = _mm_packus_epi16(sl, sh);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        posy += incy;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_RGB888_ARGB8888_Modulate_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i opaque = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_loadu_si128((const __m128i *)src);
+            } else {
+                s = _mm_cvtsi32_si128((int)*src);
+            }
+            src += count;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                sl = _mm_or_si128(sl, opaque);
+                sh = _mm_or_si128(sh, opaque);
+                sl = SDL_Blit_Modulate_SSE2(sl, modulate);
+                sh = SDL_Blit_Modulate_SSE2(sh, modulate);
+                s = _mm_packus_epi16(sl, sh);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_RGB888_ARGB8888_Modulate_Scale_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i opaque = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+    int srcy, posy, incy, incx;
+
+    srcy = 0;
+    posy = 0;
+    incy = (info->src_h << 16) / info->dst_h;
+    incx = (info->src_w << 16) / info->dst_w;
+
+    while (info->dst_h--) {
+        const Uint32 *src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        int posx = 0;
+        while (posy >= 0x10000L) {
+            ++srcy;
+            posy -= 0x10000L;
+        }
+        src = (const Uint32 *)(info->src + (srcy * info->src_pitch));
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_set_epi32((int)src[(posx + 3 * incx) >> 16], (int)src[(posx + 2 * incx) >> 16],
+                                  (int)src[(posx + incx) >> 16], (int)src[posx >> 16]);
+            } else {
+                s = _mm_cvtsi32_si128((int)src[posx >> 16]);
+            }
+            posx += count * incx;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                sl = _mm_or_si128(sl, opaque);
+                sh = _mm_or_si128(sh, opaque);
+                sl = SDL_Blit_Modulate_SSE2(sl, modulate);
+                sh = SDL_Blit_Modulate_SSE2(sh, modulate);
+                s = _mm_packus_epi16(sl, sh);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        posy += incy;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_RGB888_ARGB8888_Modulate_Blend_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i opaque = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_loadu_si128((const __m128i *)src);
+            } else {
+                s = _mm_cvtsi32_si128((int)*src);
+            }
+            src += count;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                __m128i d;
+                sl = _mm_or_si128(sl, opaque);
+                sh = _mm_or_si128(sh, opaque);
+                sl = SDL_Blit_Modulate_SSE2(sl, modulate);
+                sh = SDL_Blit_Modulate_SSE2(sh, modulate);
+                if (count == 4) {
+                    d = _mm_loadu_si128((const __m128i *)dst);
+                } else {
+                    d = _mm_cvtsi32_si128((int)*dst);
+                }
+                sl = SDL_Blit_Blend_SSE2(sl, _mm_unpacklo_epi8(d, zero), flags);
+                sh = SDL_Blit_Blend_SSE2(sh, _mm_unpackhi_epi8(d, zero), flags);
+                s = _mm_packus_epi16(sl, sh);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_RGB888_ARGB8888_Modulate_Blend_Scale_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i opaque = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+    int srcy, posy, incy, incx;
+
+    srcy = 0;
+    posy = 0;
+    incy = (info->src_h << 16) / info->dst_h;
+    incx = (info->src_w << 16) / info->dst_w;
+
+    while (info->dst_h--) {
+        const Uint32 *src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        int posx = 0;
+        while (posy >= 0x10000L) {
+            ++srcy;
+            posy -= 0x10000L;
+        }
+        src = (const Uint32 *)(info->src + (srcy * info->src_pitch));
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_set_epi32((int)src[(posx + 3 * incx) >> 16], (int)src[(posx + 2 * incx) >> 16],
+                                  (int)src[(posx + incx) >> 16], (int)src[posx >> 16]);
+            } else {
+                s = _mm_cvtsi32_si128((int)src[posx >> 16]);
+            }
+            posx += count * incx;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                __m128i d;
+                sl = _mm_or_si128(sl, opaque);
+                sh = _mm_or_si128(sh, opaque);
+                sl = SDL_Blit_Modulate_SSE2(sl, modulate);
+                sh = SDL_Blit_Modulate_SSE2(sh, modulate);
+                if (count == 4) {
+                    d = _mm_loadu_si128((const __m128i *)dst);
+                } else {
+                    d = _mm_cvtsi32_si128((int)*dst);
+                }
+                sl = SDL_Blit_Blend_SSE2(sl, _mm_unpacklo_epi8(d, zero), flags);
+                sh = SDL_Blit_Blend_SSE2(sh, _mm_unpackhi_epi8(d, zero), flags);
+                s = _mm_packus_epi16(sl, sh);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        posy += incy;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_BGR888_RGB888_Scale_SSE2(SDL_BlitInfo *info)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i opaque = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+    int srcy, posy, incy, incx;
+
+    srcy = 0;
+    posy = 0;
+    incy = (info->src_h << 16) / info->dst_h;
+    incx = (info->src_w << 16) / info->dst_w;
+
+    while (info->dst_h--) {
+        const Uint32 *src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        int posx = 0;
+        while (posy >= 0x10000L) {
+            ++srcy;
+            posy -= 0x10000L;
+        }
+        src = (const Uint32 *)(info->src + (srcy * info->src_pitch));
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_set_epi32((int)src[(posx + 3 * incx) >> 16], (int)src[(posx + 2 * incx) >> 16],
+                                  (int)src[(posx + incx) >> 16], (int)src[posx >> 16]);
+            } else {
+                s = _mm_cvtsi32_si128((int)src[posx >> 16]);
+            }
+            posx += count * incx;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                sl = _mm_or_si128(sl, opaque);
+                sh = _mm_or_si128(sh, opaque);
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        posy += incy;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_BGR888_RGB888_Blend_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i opaque = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_loadu_si128((const __m128i *)src);
+            } else {
+                s = _mm_cvtsi32_si128((int)*src);
+            }
+            src += count;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                __m128i d;
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                sl = _mm_or_si128(sl, opaque);
+                sh = _mm_or_si128(sh, opaque);
+                if (count == 4) {
+                    d = _mm_loadu_si128((const __m128i *)dst);
+                } else {
+                    d = _mm_cvtsi32_si128((int)*dst);
+                }
+                sl = SDL_Blit_Blend_SSE2(sl, _mm_unpacklo_epi8(d, zero), flags);
+                sh = SDL_Blit_Blend_SSE2(sh, _mm_unpackhi_epi8(d, zero), flags);
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_BGR888_RGB888_Blend_Scale_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i opaque = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+    int srcy, posy, incy, incx;
+
+    srcy = 0;
+    posy = 0;
+    incy = (info->src_h << 16) / info->dst_h;
+    incx = (info->src_w << 16) / info->dst_w;
+
+    while (info->dst_h--) {
+        const Uint32 *src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        int posx = 0;
+        while (posy >= 0x10000L) {
+            ++srcy;
+            posy -= 0x10000L;
+        }
+        src = (const Uint32 *)(info->src + (srcy * info->src_pitch));
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_set_epi32((int)src[(posx + 3 * incx) >> 16], (int)src[(posx + 2 * incx) >> 16],
+                                  (int)src[(posx + incx) >> 16], (int)src[posx >> 16]);
+            } else {
+                s = _mm_cvtsi32_si128((int)src[posx >> 16]);
+            }
+            posx += count * incx;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                __m128i d;
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                sl = _mm_or_si128(sl, opaque);
+                sh = _mm_or_si128(sh, opaque);
+                if (count == 4) {
+                    d = _mm_loadu_si128((const __m128i *)dst);
+                } else {
+                    d = _mm_cvtsi32_si128((int)*dst);
+                }
+                sl = SDL_Blit_Blend_SSE2(sl, _mm_unpacklo_epi8(d, zero), flags);
+                sh = SDL_Blit_Blend_SSE2(sh, _mm_unpackhi_epi8(d, zero), flags);
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        posy += incy;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_BGR888_RGB888_Modulate_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i opaque = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_loadu_si128((const __m128i *)src);
+            } else {
+                s = _mm_cvtsi32_si128((int)*src);
+            }
+            src += count;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                sl = _mm_or_si128(sl, opaque);
+                sh = _mm_or_si128(sh, opaque);
+                sl = SDL_Blit_Modulate_SSE2(sl, modulate);
+                sh = SDL_Blit_Modulate_SSE2(sh, modulate);
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_BGR888_RGB888_Modulate_Scale_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i opaque = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+    int srcy, posy, incy, incx;
+
+    srcy = 0;
+    posy = 0;
+    incy = (info->src_h << 16) / info->dst_h;
+    incx = (info->src_w << 16) / info->dst_w;
+
+    while (info->dst_h--) {
+        const Uint32 *src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        int posx = 0;
+        while (posy >= 0x10000L) {
+            ++srcy;
+            posy -= 0x10000L;
+        }
+        src = (const Uint32 *)(info->src + (srcy * info->src_pitch));
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_set_epi32((int)src[(posx + 3 * incx) >> 16], (int)src[(posx + 2 * incx) >> 16],
+                                  (int)src[(posx + incx) >> 16], (int)src[posx >> 16]);
+            } else {
+                s = _mm_cvtsi32_si128((int)src[posx >> 16]);
+            }
+            posx += count * incx;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                sl = _mm_or_si128(sl, opaque);
+                sh = _mm_or_si128(sh, opaque);
+                sl = SDL_Blit_Modulate_SSE2(sl, modulate);
+                sh = SDL_Blit_Modulate_SSE2(sh, modulate);
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        posy += incy;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_BGR888_RGB888_Modulate_Blend_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i opaque = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_loadu_si128((const __m128i *)src);
+            } else {
+                s = _mm_cvtsi32_si128((int)*src);
+            }
+            src += count;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                __m128i d;
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                sl = _mm_or_si128(sl, opaque);
+                sh = _mm_or_si128(sh, opaque);
+                sl = SDL_Blit_Modulate_SSE2(sl, modulate);
+                sh = SDL_Blit_Modulate_SSE2(sh, modulate);
+                if (count == 4) {
+                    d = _mm_loadu_si128((const __m128i *)dst);
+                } else {
+                    d = _mm_cvtsi32_si128((int)*dst);
+                }
+                sl = SDL_Blit_Blend_SSE2(sl, _mm_unpacklo_epi8(d, zero), flags);
+                sh = SDL_Blit_Blend_SSE2(sh, _mm_unpackhi_epi8(d, zero), flags);
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_BGR888_RGB888_Modulate_Blend_Scale_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i opaque = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+    int srcy, posy, incy, incx;
+
+    srcy = 0;
+    posy = 0;
+    incy = (info->src_h << 16) / info->dst_h;
+    incx = (info->src_w << 16) / info->dst_w;
+
+    while (info->dst_h--) {
+        const Uint32 *src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        int posx = 0;
+        while (posy >= 0x10000L) {
+            ++srcy;
+            posy -= 0x10000L;
+        }
+        src = (const Uint32 *)(info->src + (srcy * info->src_pitch));
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_set_epi32((int)src[(posx + 3 * incx) >> 16], (int)src[(posx + 2 * incx) >> 16],
+                                  (int)src[(posx + incx) >> 16], (int)src[posx >> 16]);
+            } else {
+                s = _mm_cvtsi32_si128((int)src[posx >> 16]);
+            }
+            posx += count * incx;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                __m128i d;
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                sl = _mm_or_si128(sl, opaque);
+                sh = _mm_or_si128(sh, opaque);
+                sl = SDL_Blit_Modulate_SSE2(sl, modulate);
+                sh = SDL_Blit_Modulate_SSE2(sh, modulate);
+                if (count == 4) {
+                    d = _mm_loadu_si128((const __m128i *)dst);
+                } else {
+                    d = _mm_cvtsi32_si128((int)*dst);
+                }
+                sl = SDL_Blit_Blend_SSE2(sl, _mm_unpacklo_epi8(d, zero), flags);
+                sh = SDL_Blit_Blend_SSE2(sh, _mm_unpackhi_epi8(d, zero), flags);
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        posy += incy;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_BGR888_BGR888_Scale_SSE2(SDL_BlitInfo *info)
+{
+    int srcy, posy, incy, incx;
+
+    srcy = 0;
+    posy = 0;
+    incy = (info->src_h << 16) / info->dst_h;
+    incx = (info->src_w << 16) / info->dst_w;
+
+    while (info->dst_h--) {
+        const Uint32 *src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        int posx = 0;
+        while (posy >= 0x10000L) {
+            ++srcy;
+            posy -= 0x10000L;
+        }
+        src = (const Uint32 *)(info->src + (srcy * info->src_pitch));
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_set_epi32((int)src[(posx + 3 * incx) >> 16], (int)src[(posx + 2 * incx) >> 16],
+                                  (int)src[(posx + incx) >> 16], (int)src[posx >> 16]);
+            } else {
+                s = _mm_cvtsi32_si128((int)src[posx >> 16]);
+            }
+            posx += count * incx;
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        posy += incy;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_BGR888_BGR888_Blend_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i opaque = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_loadu_si128((const __m128i *)src);
+            } else {
+                s = _mm_cvtsi32_si128((int)*src);
+            }
+            src += count;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                __m128i d;
+                sl = _mm_or_si128(sl, opaque);
+                sh = _mm_or_si128(sh, opaque);
+                if (count == 4) {
+                    d = _mm_loadu_si128((const __m128i *)dst);
+                } else {
+                    d = _mm_cvtsi32_si128((int)*dst);
+                }
+                sl = SDL_Blit_Blend_SSE2(sl, _mm_unpacklo_epi8(d, zero), flags);
+                sh = SDL_Blit_Blend_SSE2(sh, _mm_unpackhi_epi8(d, zero), flags);
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_BGR888_BGR888_Blend_Scale_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i opaque = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+    int srcy, posy, incy, incx;
+
+    srcy = 0;
+    posy = 0;
+    incy = (info->src_h << 16) / info->dst_h;
+    incx = (info->src_w << 16) / info->dst_w;
+
+    while (info->dst_h--) {
+        const Uint32 *src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        int posx = 0;
+        while (posy >= 0x10000L) {
+            ++srcy;
+            posy -= 0x10000L;
+        }
+        src = (const Uint32 *)(info->src + (srcy * info->src_pitch));
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_set_epi32((int)src[(posx + 3 * incx) >> 16], (int)src[(posx + 2 * incx) >> 16],
+                                  (int)src[(posx + incx) >> 16], (int)src[posx >> 16]);
+            } else {
+                s = _mm_cvtsi32_si128((int)src[posx >> 16]);
+            }
+            posx += count * incx;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                __m128i d;
+                sl = _mm_or_si128(sl, opaque);
+                sh = _mm_or_si128(sh, opaque);
+                if (count == 4) {
+                    d = _mm_loadu_si128((const __m128i *)dst);
+                } else {
+                    d = _mm_cvtsi32_si128((int)*dst);
+                }
+                sl = SDL_Blit_Blend_SSE2(sl, _mm_unpacklo_epi8(d, zero), flags);
+                sh = SDL_Blit_Blend_SSE2(sh, _mm_unpackhi_epi8(d, zero), flags);
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        posy += incy;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_BGR888_BGR888_Modulate_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i opaque = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_loadu_si128((const __m128i *)src);
+            } else {
+                s = _mm_cvtsi32_si128((int)*src);
+            }
+            src += count;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                sl = _mm_or_si128(sl, opaque);
+                sh = _mm_or_si128(sh, opaque);
+                sl = SDL_Blit_Modulate_SSE2(sl, modulate);
+                sh = SDL_Blit_Modulate_SSE2(sh, modulate);
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_BGR888_BGR888_Modulate_Scale_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i opaque = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+    int srcy, posy, incy, incx;
+
+    srcy = 0;
+    posy = 0;
+    incy = (info->src_h << 16) / info->dst_h;
+    incx = (info->src_w << 16) / info->dst_w;
+
+    while (info->dst_h--) {
+        const Uint32 *src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        int posx = 0;
+        while (posy >= 0x10000L) {
+            ++srcy;
+            posy -= 0x10000L;
+        }
+        src = (const Uint32 *)(info->src + (srcy * info->src_pitch));
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_set_epi32((int)src[(posx + 3 * incx) >> 16], (int)src[(posx + 2 * incx) >> 16],
+                                  (int)src[(posx + incx) >> 16], (int)src[posx >> 16]);
+            } else {
+                s = _mm_cvtsi32_si128((int)src[posx >> 16]);
+            }
+            posx += count * incx;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                sl = _mm_or_si128(sl, opaque);
+                sh = _mm_or_si128(sh, opaque);
+                sl = SDL_Blit_Modulate_SSE2(sl, modulate);
+                sh = SDL_Blit_Modulate_SSE2(sh, modulate);
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        posy += incy;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_BGR888_BGR888_Modulate_Blend_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i opaque = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_loadu_si128((const __m128i *)src);
+            } else {
+                s = _mm_cvtsi32_si128((int)*src);
+            }
+            src += count;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                __m128i d;
+                sl = _mm_or_si128(sl, opaque);
+                sh = _mm_or_si128(sh, opaque);
+                sl = SDL_Blit_Modulate_SSE2(sl, modulate);
+                sh = SDL_Blit_Modulate_SSE2(sh, modulate);
+                if (count == 4) {
+                    d = _mm_loadu_si128((const __m128i *)dst);
+                } else {
+                    d = _mm_cvtsi32_si128((int)*dst);
+                }
+                sl = SDL_Blit_Blend_SSE2(sl, _mm_unpacklo_epi8(d, zero), flags);
+                sh = SDL_Blit_Blend_SSE2(sh, _mm_unpackhi_epi8(d, zero), flags);
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_BGR888_BGR888_Modulate_Blend_Scale_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i opaque = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+    int srcy, posy, incy, incx;
+
+    srcy = 0;
+    posy = 0;
+    incy = (info->src_h << 16) / info->dst_h;
+    incx = (info->src_w << 16) / info->dst_w;
+
+    while (info->dst_h--) {
+        const Uint32 *src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        int posx = 0;
+        while (posy >= 0x10000L) {
+            ++srcy;
+            posy -= 0x10000L;
+        }
+        src = (const Uint32 *)(info->src + (srcy * info->src_pitch));
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_set_epi32((int)src[(posx + 3 * incx) >> 16], (int)src[(posx + 2 * incx) >> 16],
+                                  (int)src[(posx + incx) >> 16], (int)src[posx >> 16]);
+            } else {
+                s = _mm_cvtsi32_si128((int)src[posx >> 16]);
+            }
+            posx += count * incx;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                __m128i d;
+                sl = _mm_or_si128(sl, opaque);
+                sh = _mm_or_si128(sh, opaque);
+                sl = SDL_Blit_Modulate_SSE2(sl, modulate);
+                sh = SDL_Blit_Modulate_SSE2(sh, modulate);
+                if (count == 4) {
+                    d = _mm_loadu_si128((const __m128i *)dst);
+                } else {
+                    d = _mm_cvtsi32_si128((int)*dst);
+                }
+                sl = SDL_Blit_Blend_SSE2(sl, _mm_unpacklo_epi8(d, zero), flags);
+                sh = SDL_Blit_Blend_SSE2(sh, _mm_unpackhi_epi8(d, zero), flags);
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        posy += incy;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_BGR888_ARGB8888_Scale_SSE2(SDL_BlitInfo *info)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i opaque = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+    int srcy, posy, incy, incx;
+
+    srcy = 0;
+    posy = 0;
+    incy = (info->src_h << 16) / info->dst_h;
+    incx = (info->src_w << 16) / info->dst_w;
+
+    while (info->dst_h--) {
+        const Uint32 *src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        int posx = 0;
+        while (posy >= 0x10000L) {
+            ++srcy;
+            posy -= 0x10000L;
+        }
+        src = (const Uint32 *)(info->src + (srcy * info->src_pitch));
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_set_epi32((int)src[(posx + 3 * incx) >> 16], (int)src[(posx + 2 * incx) >> 16],
+                                  (int)src[(posx + incx) >> 16], (int)src[posx >> 16]);
+            } else {
+                s = _mm_cvtsi32_si128((int)src[posx >> 16]);
+            }
+            posx += count * incx;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                sl = _mm_or_si128(sl, opaque);
+                sh = _mm_or_si128(sh, opaque);
+                s = _mm_packus_epi16(sl, sh);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        posy += incy;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_BGR888_ARGB8888_Blend_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i opaque = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_loadu_si128((const __m128i *)src);
+            } else {
+                s = _mm_cvtsi32_si128((int)*src);
+            }
+            src += count;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                __m128i d;
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                sl = _mm_or_si128(sl, opaque);
+                sh = _mm_or_si128(sh, opaque);
+                if (count == 4) {
+                    d = _mm_loadu_si128((const __m128i *)dst);
+                } else {
+                    d = _mm_cvtsi32_si128((int)*dst);
+                }
+                sl = SDL_Blit_Blend_SSE2(sl, _mm_unpacklo_epi8(d, zero), flags);
+                sh = SDL_Blit_Blend_SSE2(sh, _mm_unpackhi_epi8(d, zero), flags);
+                s = _mm_packus_epi16(sl, sh);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_BGR888_ARGB8888_Blend_Scale_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i opaque = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+    int srcy, posy, incy, incx;
+
+    srcy = 0;
+    posy = 0;
+    incy = (info->src_h << 16) / info->dst_h;
+    incx = (info->src_w << 16) / info->dst_w;
+
+    while (info->dst_h--) {
+        const Uint32 *src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        int posx = 0;
+        while (posy >= 0x10000L) {
+            ++srcy;
+            posy -= 0x10000L;
+        }
+        src = (const Uint32 *)(info->src + (srcy * info->src_pitch));
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_set_epi32((int)src[(posx + 3 * incx) >> 16], (int)src[(posx + 2 * incx) >> 16],
+                                  (int)src[(posx + incx) >> 16], (int)src[posx >> 16]);
+            } else {
+                s = _mm_cvtsi32_si128((int)src[posx >> 16]);
+            }
+            posx += count * incx;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                __m128i d;
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                sl = _mm_or_si128(sl, opaque);
+                sh = _mm_or_si128(sh, opaque);
+                if (count == 4) {
+                    d = _mm_loadu_si128((const __m128i *)dst);
+                } else {
+                    d = _mm_cvtsi32_si128((int)*dst);
+                }
+                sl = SDL_Blit_Blend_SSE2(sl, _mm_unpacklo_epi8(d, zero), flags);
+                sh = SDL_Blit_Blend_SSE2(sh, _mm_unpackhi_epi8(d, zero), flags);
+                s = _mm_packus_epi16(sl, sh);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        posy += incy;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_BGR888_ARGB8888_Modulate_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i opaque = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_loadu_si128((const __m128i *)src);
+            } else {
+                s = _mm_cvtsi32_si128((int)*src);
+            }
+            src += count;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                sl = _mm_or_si128(sl, opaque);
+                sh = _mm_or_si128(sh, opaque);
+                sl = SDL_Blit_Modulate_SSE2(sl, modulate);
+                sh = SDL_Blit_Modulate_SSE2(sh, modulate);
+                s = _mm_packus_epi16(sl, sh);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_BGR888_ARGB8888_Modulate_Scale_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i opaque = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+    int srcy, posy, incy, incx;
+
+    srcy = 0;
+    posy = 0;
+    incy = (info->src_h << 16) / info->dst_h;
+    incx = (info->src_w << 16) / info->dst_w;
+
+    while (info->dst_h--) {
+        const Uint32 *src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        int posx = 0;
+        while (posy >= 0x10000L) {
+            ++srcy;
+            posy -= 0x10000L;
+        }
+        src = (const Uint32 *)(info->src + (srcy * info->src_pitch));
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_set_epi32((int)src[(posx + 3 * incx) >> 16], (int)src[(posx + 2 * incx) >> 16],
+                                  (int)src[(posx + incx) >> 16], (int)src[posx >> 16]);
+            } else {
+                s = _mm_cvtsi32_si128((int)src[posx >> 16]);
+            }
+            posx += count * incx;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                sl = _mm_or_si128(sl, opaque);
+                sh = _mm_or_si128(sh, opaque);
+                sl = SDL_Blit_Modulate_SSE2(sl, modulate);
+                sh = SDL_Blit_Modulate_SSE2(sh, modulate);
+                s = _mm_packus_epi16(sl, sh);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        posy += incy;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_BGR888_ARGB8888_Modulate_Blend_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i opaque = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_loadu_si128((const __m128i *)src);
+            } else {
+                s = _mm_cvtsi32_si128((int)*src);
+            }
+            src += count;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                __m128i d;
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                sl = _mm_or_si128(sl, opaque);
+                sh = _mm_or_si128(sh, opaque);
+                sl = SDL_Blit_Modulate_SSE2(sl, modulate);
+                sh = SDL_Blit_Modulate_SSE2(sh, modulate);
+                if (count == 4) {
+                    d = _mm_loadu_si128((const __m128i *)dst);
+                } else {
+                    d = _mm_cvtsi32_si128((int)*dst);
+                }
+                sl = SDL_Blit_Blend_SSE2(sl, _mm_unpacklo_epi8(d, zero), flags);
+                sh = SDL_Blit_Blend_SSE2(sh, _mm_unpackhi_epi8(d, zero), flags);
+                s = _mm_packus_epi16(sl, sh);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_BGR888_ARGB8888_Modulate_Blend_Scale_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i opaque = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+    int srcy, posy, incy, incx;
+
+    srcy = 0;
+    posy = 0;
+    incy = (info->src_h << 16) / info->dst_h;
+    incx = (info->src_w << 16) / info->dst_w;
+
+    while (info->dst_h--) {
+        const Uint32 *src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        int posx = 0;
+        while (posy >= 0x10000L) {
+            ++srcy;
+            posy -= 0x10000L;
+        }
+        src = (const Uint32 *)(info->src + (srcy * info->src_pitch));
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_set_epi32((int)src[(posx + 3 * incx) >> 16], (int)src[(posx + 2 * incx) >> 16],
+                                  (int)src[(posx + incx) >> 16], (int)src[posx >> 16]);
+            } else {
+                s = _mm_cvtsi32_si128((int)src[posx >> 16]);
+            }
+            posx += count * incx;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                __m128i d;
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                sl = _mm_or_si128(sl, opaque);
+                sh = _mm_or_si128(sh, opaque);
+                sl = SDL_Blit_Modulate_SSE2(sl, modulate);
+                sh = SDL_Blit_Modulate_SSE2(sh, modulate);
+                if (count == 4) {
+                    d = _mm_loadu_si128((const __m128i *)dst);
+                } else {
+                    d = _mm_cvtsi32_si128((int)*dst);
+                }
+                sl = SDL_Blit_Blend_SSE2(sl, _mm_unpacklo_epi8(d, zero), flags);
+                sh = SDL_Blit_Blend_SSE2(sh, _mm_unpackhi_epi8(d, zero), flags);
+                s = _mm_packus_epi16(sl, sh);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        posy += incy;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_ARGB8888_RGB888_Scale_SSE2(SDL_BlitInfo *info)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+    int srcy, posy, incy, incx;
+
+    srcy = 0;
+    posy = 0;
+    incy = (info->src_h << 16) / info->dst_h;
+    incx = (info->src_w << 16) / info->dst_w;
+
+    while (info->dst_h--) {
+        const Uint32 *src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        int posx = 0;
+        while (posy >= 0x10000L) {
+            ++srcy;
+            posy -= 0x10000L;
+        }
+        src = (const Uint32 *)(info->src + (srcy * info->src_pitch));
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_set_epi32((int)src[(posx + 3 * incx) >> 16], (int)src[(posx + 2 * incx) >> 16],
+                                  (int)src[(posx + incx) >> 16], (int)src[posx >> 16]);
+            } else {
+                s = _mm_cvtsi32_si128((int)src[posx >> 16]);
+            }
+            posx += count * incx;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        posy += incy;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_ARGB8888_RGB888_Blend_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_loadu_si128((const __m128i *)src);
+            } else {
+                s = _mm_cvtsi32_si128((int)*src);
+            }
+            src += count;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                __m128i d;
+                if (count == 4) {
+                    d = _mm_loadu_si128((const __m128i *)dst);
+                } else {
+                    d = _mm_cvtsi32_si128((int)*dst);
+                }
+                sl = SDL_Blit_Blend_SSE2(sl, _mm_unpacklo_epi8(d, zero), flags);
+                sh = SDL_Blit_Blend_SSE2(sh, _mm_unpackhi_epi8(d, zero), flags);
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_ARGB8888_RGB888_Blend_Scale_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+    int srcy, posy, incy, incx;
+
+    srcy = 0;
+    posy = 0;
+    incy = (info->src_h << 16) / info->dst_h;
+    incx = (info->src_w << 16) / info->dst_w;
+
+    while (info->dst_h--) {
+        const Uint32 *src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        int posx = 0;
+        while (posy >= 0x10000L) {
+            ++srcy;
+            posy -= 0x10000L;
+        }
+        src = (const Uint32 *)(info->src + (srcy * info->src_pitch));
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_set_epi32((int)src[(posx + 3 * incx) >> 16], (int)src[(posx + 2 * incx) >> 16],
+                                  (int)src[(posx + incx) >> 16], (int)src[posx >> 16]);
+            } else {
+                s = _mm_cvtsi32_si128((int)src[posx >> 16]);
+            }
+            posx += count * incx;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                __m128i d;
+                if (count == 4) {
+                    d = _mm_loadu_si128((const __m128i *)dst);
+                } else {
+                    d = _mm_cvtsi32_si128((int)*dst);
+                }
+                sl = SDL_Blit_Blend_SSE2(sl, _mm_unpacklo_epi8(d, zero), flags);
+                sh = SDL_Blit_Blend_SSE2(sh, _mm_unpackhi_epi8(d, zero), flags);
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        posy += incy;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_ARGB8888_RGB888_Modulate_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_loadu_si128((const __m128i *)src);
+            } else {
+                s = _mm_cvtsi32_si128((int)*src);
+            }
+            src += count;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                sl = SDL_Blit_Modulate_SSE2(sl, modulate);
+                sh = SDL_Blit_Modulate_SSE2(sh, modulate);
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_ARGB8888_RGB888_Modulate_Scale_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+    int srcy, posy, incy, incx;
+
+    srcy = 0;
+    posy = 0;
+    incy = (info->src_h << 16) / info->dst_h;
+    incx = (info->src_w << 16) / info->dst_w;
+
+    while (info->dst_h--) {
+        const Uint32 *src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        int posx = 0;
+        while (posy >= 0x10000L) {
+            ++srcy;
+            posy -= 0x10000L;
+        }
+        src = (const Uint32 *)(info->src + (srcy * info->src_pitch));
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_set_epi32((int)src[(posx + 3 * incx) >> 16], (int)src[(posx + 2 * incx) >> 16],
+                                  (int)src[(posx + incx) >> 16], (int)src[posx >> 16]);
+            } else {
+                s = _mm_cvtsi32_si128((int)src[posx >> 16]);
+            }
+            posx += count * incx;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                sl = SDL_Blit_Modulate_SSE2(sl, modulate);
+                sh = SDL_Blit_Modulate_SSE2(sh, modulate);
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        posy += incy;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_ARGB8888_RGB888_Modulate_Blend_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_loadu_si128((const __m128i *)src);
+            } else {
+                s = _mm_cvtsi32_si128((int)*src);
+            }
+            src += count;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                __m128i d;
+                sl = SDL_Blit_Modulate_SSE2(sl, modulate);
+                sh = SDL_Blit_Modulate_SSE2(sh, modulate);
+                if (count == 4) {
+                    d = _mm_loadu_si128((const __m128i *)dst);
+                } else {
+                    d = _mm_cvtsi32_si128((int)*dst);
+                }
+                sl = SDL_Blit_Blend_SSE2(sl, _mm_unpacklo_epi8(d, zero), flags);
+                sh = SDL_Blit_Blend_SSE2(sh, _mm_unpackhi_epi8(d, zero), flags);
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_ARGB8888_RGB888_Modulate_Blend_Scale_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+    int srcy, posy, incy, incx;
+
+    srcy = 0;
+    posy = 0;
+    incy = (info->src_h << 16) / info->dst_h;
+    incx = (info->src_w << 16) / info->dst_w;
+
+    while (info->dst_h--) {
+        const Uint32 *src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        int posx = 0;
+        while (posy >= 0x10000L) {
+            ++srcy;
+            posy -= 0x10000L;
+        }
+        src = (const Uint32 *)(info->src + (srcy * info->src_pitch));
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_set_epi32((int)src[(posx + 3 * incx) >> 16], (int)src[(posx + 2 * incx) >> 16],
+                                  (int)src[(posx + incx) >> 16], (int)src[posx >> 16]);
+            } else {
+                s = _mm_cvtsi32_si128((int)src[posx >> 16]);
+            }
+            posx += count * incx;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                __m128i d;
+                sl = SDL_Blit_Modulate_SSE2(sl, modulate);
+                sh = SDL_Blit_Modulate_SSE2(sh, modulate);
+                if (count == 4) {
+                    d = _mm_loadu_si128((const __m128i *)dst);
+                } else {
+                    d = _mm_cvtsi32_si128((int)*dst);
+                }
+                sl = SDL_Blit_Blend_SSE2(sl, _mm_unpacklo_epi8(d, zero), flags);
+                sh = SDL_Blit_Blend_SSE2(sh, _mm_unpackhi_epi8(d, zero), flags);
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        posy += incy;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_ARGB8888_BGR888_Scale_SSE2(SDL_BlitInfo *info)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+    int srcy, posy, incy, incx;
+
+    srcy = 0;
+    posy = 0;
+    incy = (info->src_h << 16) / info->dst_h;
+    incx = (info->src_w << 16) / info->dst_w;
+
+    while (info->dst_h--) {
+        const Uint32 *src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        int posx = 0;
+        while (posy >= 0x10000L) {
+            ++srcy;
+            posy -= 0x10000L;
+        }
+        src = (const Uint32 *)(info->src + (srcy * info->src_pitch));
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_set_epi32((int)src[(posx + 3 * incx) >> 16], (int)src[(posx + 2 * incx) >> 16],
+                                  (int)src[(posx + incx) >> 16], (int)src[posx >> 16]);
+            } else {
+                s = _mm_cvtsi32_si128((int)src[posx >> 16]);
+            }
+            posx += count * incx;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        posy += incy;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_ARGB8888_BGR888_Blend_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_loadu_si128((const __m128i *)src);
+            } else {
+                s = _mm_cvtsi32_si128((int)*src);
+            }
+            src += count;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                __m128i d;
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                if (count == 4) {
+                    d = _mm_loadu_si128((const __m128i *)dst);
+                } else {
+                    d = _mm_cvtsi32_si128((int)*dst);
+                }
+                sl = SDL_Blit_Blend_SSE2(sl, _mm_unpacklo_epi8(d, zero), flags);
+                sh = SDL_Blit_Blend_SSE2(sh, _mm_unpackhi_epi8(d, zero), flags);
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_ARGB8888_BGR888_Blend_Scale_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+    int srcy, posy, incy, incx;
+
+    srcy = 0;
+    posy = 0;
+    incy = (info->src_h << 16) / info->dst_h;
+    incx = (info->src_w << 16) / info->dst_w;
+
+    while (info->dst_h--) {
+        const Uint32 *src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        int posx = 0;
+        while (posy >= 0x10000L) {
+            ++srcy;
+            posy -= 0x10000L;
+        }
+        src = (const Uint32 *)(info->src + (srcy * info->src_pitch));
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_set_epi32((int)src[(posx + 3 * incx) >> 16], (int)src[(posx + 2 * incx) >> 16],
+                                  (int)src[(posx + incx) >> 16], (int)src[posx >> 16]);
+            } else {
+                s = _mm_cvtsi32_si128((int)src[posx >> 16]);
+            }
+            posx += count * incx;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                __m128i d;
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                if (count == 4) {
+                    d = _mm_loadu_si128((const __m128i *)dst);
+                } else {
+                    d = _mm_cvtsi32_si128((int)*dst);
+                }
+                sl = SDL_Blit_Blend_SSE2(sl, _mm_unpacklo_epi8(d, zero), flags);
+                sh = SDL_Blit_Blend_SSE2(sh, _mm_unpackhi_epi8(d, zero), flags);
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        posy += incy;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_ARGB8888_BGR888_Modulate_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_loadu_si128((const __m128i *)src);
+            } else {
+                s = _mm_cvtsi32_si128((int)*src);
+            }
+            src += count;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                sl = SDL_Blit_Modulate_SSE2(sl, modulate);
+                sh = SDL_Blit_Modulate_SSE2(sh, modulate);
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_ARGB8888_BGR888_Modulate_Scale_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+    int srcy, posy, incy, incx;
+
+    srcy = 0;
+    posy = 0;
+    incy = (info->src_h << 16) / info->dst_h;
+    incx = (info->src_w << 16) / info->dst_w;
+
+    while (info->dst_h--) {
+        const Uint32 *src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        int posx = 0;
+        while (posy >= 0x10000L) {
+            ++srcy;
+            posy -= 0x10000L;
+        }
+        src = (const Uint32 *)(info->src + (srcy * info->src_pitch));
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_set_epi32((int)src[(posx + 3 * incx) >> 16], (int)src[(posx + 2 * incx) >> 16],
+                                  (int)src[(posx + incx) >> 16], (int)src[posx >> 16]);
+            } else {
+                s = _mm_cvtsi32_si128((int)src[posx >> 16]);
+            }
+            posx += count * incx;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                sl = SDL_Blit_Modulate_SSE2(sl, modulate);
+                sh = SDL_Blit_Modulate_SSE2(sh, modulate);
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        posy += incy;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_ARGB8888_BGR888_Modulate_Blend_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_loadu_si128((const __m128i *)src);
+            } else {
+                s = _mm_cvtsi32_si128((int)*src);
+            }
+            src += count;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                __m128i d;
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                sl = SDL_Blit_Modulate_SSE2(sl, modulate);
+                sh = SDL_Blit_Modulate_SSE2(sh, modulate);
+                if (count == 4) {
+                    d = _mm_loadu_si128((const __m128i *)dst);
+                } else {
+                    d = _mm_cvtsi32_si128((int)*dst);
+                }
+                sl = SDL_Blit_Blend_SSE2(sl, _mm_unpacklo_epi8(d, zero), flags);
+                sh = SDL_Blit_Blend_SSE2(sh, _mm_unpackhi_epi8(d, zero), flags);
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_ARGB8888_BGR888_Modulate_Blend_Scale_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+    int srcy, posy, incy, incx;
+
+    srcy = 0;
+    posy = 0;
+    incy = (info->src_h << 16) / info->dst_h;
+    incx = (info->src_w << 16) / info->dst_w;
+
+    while (info->dst_h--) {
+        const Uint32 *src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        int posx = 0;
+        while (posy >= 0x10000L) {
+            ++srcy;
+            posy -= 0x10000L;
+        }
+        src = (const Uint32 *)(info->src + (srcy * info->src_pitch));
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_set_epi32((int)src[(posx + 3 * incx) >> 16], (int)src[(posx + 2 * incx) >> 16],
+                                  (int)src[(posx + incx) >> 16], (int)src[posx >> 16]);
+            } else {
+                s = _mm_cvtsi32_si128((int)src[posx >> 16]);
+            }
+            posx += count * incx;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                __m128i d;
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                sl = SDL_Blit_Modulate_SSE2(sl, modulate);
+                sh = SDL_Blit_Modulate_SSE2(sh, modulate);
+                if (count == 4) {
+                    d = _mm_loadu_si128((const __m128i *)dst);
+                } else {
+                    d = _mm_cvtsi32_si128((int)*dst);
+                }
+                sl = SDL_Blit_Blend_SSE2(sl, _mm_unpacklo_epi8(d, zero), flags);
+                sh = SDL_Blit_Blend_SSE2(sh, _mm_unpackhi_epi8(d, zero), flags);
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        posy += incy;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_ARGB8888_ARGB8888_Scale_SSE2(SDL_BlitInfo *info)
+{
+    int srcy, posy, incy, incx;
+
+    srcy = 0;
+    posy = 0;
+    incy = (info->src_h << 16) / info->dst_h;
+    incx = (info->src_w << 16) / info->dst_w;
+
+    while (info->dst_h--) {
+        const Uint32 *src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        int posx = 0;
+        while (posy >= 0x10000L) {
+            ++srcy;
+            posy -= 0x10000L;
+        }
+        src = (const Uint32 *)(info->src + (srcy * info->src_pitch));
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_set_epi32((int)src[(posx + 3 * incx) >> 16], (int)src[(posx + 2 * incx) >> 16],
+                                  (int)src[(posx + incx) >> 16], (int)src[posx >> 16]);
+            } else {
+                s = _mm_cvtsi32_si128((int)src[posx >> 16]);
+            }
+            posx += count * incx;
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        posy += incy;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_ARGB8888_ARGB8888_Blend_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_loadu_si128((const __m128i *)src);
+            } else {
+                s = _mm_cvtsi32_si128((int)*src);
+            }
+            src += count;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                __m128i d;
+                if (count == 4) {
+                    d = _mm_loadu_si128((const __m128i *)dst);
+                } else {
+                    d = _mm_cvtsi32_si128((int)*dst);
+                }
+                sl = SDL_Blit_Blend_SSE2(sl, _mm_unpacklo_epi8(d, zero), flags);
+                sh = SDL_Blit_Blend_SSE2(sh, _mm_unpackhi_epi8(d, zero), flags);
+                s = _mm_packus_epi16(sl, sh);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_ARGB8888_ARGB8888_Blend_Scale_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    int srcy, posy, incy, incx;
+
+    srcy = 0;
+    posy = 0;
+    incy = (info->src_h << 16) / info->dst_h;
+    incx = (info->src_w << 16) / info->dst_w;
+
+    while (info->dst_h--) {
+        const Uint32 *src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        int posx = 0;
+        while (posy >= 0x10000L) {
+            ++srcy;
+            posy -= 0x10000L;
+        }
+        src = (const Uint32 *)(info->src + (srcy * info->src_pitch));
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_set_epi32((int)src[(posx + 3 * incx) >> 16], (int)src[(posx + 2 * incx) >> 16],
+                                  (int)src[(posx + incx) >> 16], (int)src[posx >> 16]);
+            } else {
+                s = _mm_cvtsi32_si128((int)src[posx >> 16]);
+            }
+            posx += count * incx;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                __m128i d;
+                if (count == 4) {
+                    d = _mm_loadu_si128((const __m128i *)dst);
+                } else {
+                    d = _mm_cvtsi32_si128((int)*dst);
+                }
+                sl = SDL_Blit_Blend_SSE2(sl, _mm_unpacklo_epi8(d, zero), flags);
+                sh = SDL_Blit_Blend_SSE2(sh, _mm_unpackhi_epi8(d, zero), flags);
+                s = _mm_packus_epi16(sl, sh);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        posy += incy;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_ARGB8888_ARGB8888_Modulate_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB);
+    const __m128i zero = _mm_setzero_si128();
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_loadu_si128((const __m128i *)src);
+            } else {
+                s = _mm_cvtsi32_si128((int)*src);
+            }
+            src += count;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                sl = SDL_Blit_Modulate_SSE2(sl, modulate);
+                sh = SDL_Blit_Modulate_SSE2(sh, modulate);
+                s = _mm_packus_epi16(sl, sh);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_ARGB8888_ARGB8888_Modulate_Scale_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB);
+    const __m128i zero = _mm_setzero_si128();
+    int srcy, posy, incy, incx;
+
+    srcy = 0;
+    posy = 0;
+    incy = (info->src_h << 16) / info->dst_h;
+    incx = (info->src_w << 16) / info->dst_w;
+
+    while (info->dst_h--) {
+        const Uint32 *src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        int posx = 0;
+        while (posy >= 0x10000L) {
+            ++srcy;
+            posy -= 0x10000L;
+        }
+        src = (const Uint32 *)(info->src + (srcy * info->src_pitch));
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_set_epi32((int)src[(posx + 3 * incx) >> 16], (int)src[(posx + 2 * incx) >> 16],
+                                  (int)src[(posx + incx) >> 16], (int)src[posx >> 16]);
+            } else {
+                s = _mm_cvtsi32_si128((int)src[posx >> 16]);
+            }
+            posx += count * incx;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                sl = SDL_Blit_Modulate_SSE2(sl, modulate);
+                sh = SDL_Blit_Modulate_SSE2(sh, modulate);
+                s = _mm_packus_epi16(sl, sh);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        posy += incy;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_ARGB8888_ARGB8888_Modulate_Blend_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB);
+    const __m128i zero = _mm_setzero_si128();
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_loadu_si128((const __m128i *)src);
+            } else {
+                s = _mm_cvtsi32_si128((int)*src);
+            }
+            src += count;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                __m128i d;
+                sl = SDL_Blit_Modulate_SSE2(sl, modulate);
+                sh = SDL_Blit_Modulate_SSE2(sh, modulate);
+                if (count == 4) {
+                    d = _mm_loadu_si128((const __m128i *)dst);
+                } else {
+                    d = _mm_cvtsi32_si128((int)*dst);
+                }
+                sl = SDL_Blit_Blend_SSE2(sl, _mm_unpacklo_epi8(d, zero), flags);
+                sh = SDL_Blit_Blend_SSE2(sh, _mm_unpackhi_epi8(d, zero), flags);
+                s = _mm_packus_epi16(sl, sh);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_ARGB8888_ARGB8888_Modulate_Blend_Scale_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB);
+    const __m128i zero = _mm_setzero_si128();
+    int srcy, posy, incy, incx;
+
+    srcy = 0;
+    posy = 0;
+    incy = (info->src_h << 16) / info->dst_h;
+    incx = (info->src_w << 16) / info->dst_w;
+
+    while (info->dst_h--) {
+        const Uint32 *src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        int posx = 0;
+        while (posy >= 0x10000L) {
+            ++srcy;
+            posy -= 0x10000L;
+        }
+        src = (const Uint32 *)(info->src + (srcy * info->src_pitch));
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_set_epi32((int)src[(posx + 3 * incx) >> 16], (int)src[(posx + 2 * incx) >> 16],
+                                  (int)src[(posx + incx) >> 16], (int)src[posx >> 16]);
+            } else {
+                s = _mm_cvtsi32_si128((int)src[posx >> 16]);
+            }
+            posx += count * incx;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                __m128i d;
+                sl = SDL_Blit_Modulate_SSE2(sl, modulate);
+                sh = SDL_Blit_Modulate_SSE2(sh, modulate);
+                if (count == 4) {
+                    d = _mm_loadu_si128((const __m128i *)dst);
+                } else {
+                    d = _mm_cvtsi32_si128((int)*dst);
+                }
+                sl = SDL_Blit_Blend_SSE2(sl, _mm_unpacklo_epi8(d, zero), flags);
+                sh = SDL_Blit_Blend_SSE2(sh, _mm_unpackhi_epi8(d, zero), flags);
+                s = _mm_packus_epi16(sl, sh);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        posy += incy;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_RGBA8888_RGB888_Scale_SSE2(SDL_BlitInfo *info)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+    int srcy, posy, incy, incx;
+
+    srcy = 0;
+    posy = 0;
+    incy = (info->src_h << 16) / info->dst_h;
+    incx = (info->src_w << 16) / info->dst_w;
+
+    while (info->dst_h--) {
+        const Uint32 *src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        int posx = 0;
+        while (posy >= 0x10000L) {
+            ++srcy;
+            posy -= 0x10000L;
+        }
+        src = (const Uint32 *)(info->src + (srcy * info->src_pitch));
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_set_epi32((int)src[(posx + 3 * incx) >> 16], (int)src[(posx + 2 * incx) >> 16],
+                                  (int)src[(posx + incx) >> 16], (int)src[posx >> 16]);
+            } else {
+                s = _mm_cvtsi32_si128((int)src[posx >> 16]);
+            }
+            posx += count * incx;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(0, 3, 2, 1)), _MM_SHUFFLE(0, 3, 2, 1));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(0, 3, 2, 1)), _MM_SHUFFLE(0, 3, 2, 1));
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        posy += incy;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_RGBA8888_RGB888_Blend_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_loadu_si128((const __m128i *)src);
+            } else {
+                s = _mm_cvtsi32_si128((int)*src);
+            }
+            src += count;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                __m128i d;
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(0, 3, 2, 1)), _MM_SHUFFLE(0, 3, 2, 1));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(0, 3, 2, 1)), _MM_SHUFFLE(0, 3, 2, 1));
+                if (count == 4) {
+                    d = _mm_loadu_si128((const __m128i *)dst);
+                } else {
+                    d = _mm_cvtsi32_si128((int)*dst);
+                }
+                sl = SDL_Blit_Blend_SSE2(sl, _mm_unpacklo_epi8(d, zero), flags);
+                sh = SDL_Blit_Blend_SSE2(sh, _mm_unpackhi_epi8(d, zero), flags);
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_RGBA8888_RGB888_Blend_Scale_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+    int srcy, posy, incy, incx;
+
+    srcy = 0;
+    posy = 0;
+    incy = (info->src_h << 16) / info->dst_h;
+    incx = (info->src_w << 16) / info->dst_w;
+
+    while (info->dst_h--) {
+        const Uint32 *src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        int posx = 0;
+        while (posy >= 0x10000L) {
+            ++srcy;
+            posy -= 0x10000L;
+        }
+        src = (const Uint32 *)(info->src + (srcy * info->src_pitch));
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_set_epi32((int)src[(posx + 3 * incx) >> 16], (int)src[(posx + 2 * incx) >> 16],
+                                  (int)src[(posx + incx) >> 16], (int)src[posx >> 16]);
+            } else {
+                s = _mm_cvtsi32_si128((int)src[posx >> 16]);
+            }
+            posx += count * incx;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                __m128i d;
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(0, 3, 2, 1)), _MM_SHUFFLE(0, 3, 2, 1));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(0, 3, 2, 1)), _MM_SHUFFLE(0, 3, 2, 1));
+                if (count == 4) {
+                    d = _mm_loadu_si128((const __m128i *)dst);
+                } else {
+                    d = _mm_cvtsi32_si128((int)*dst);
+                }
+                sl = SDL_Blit_Blend_SSE2(sl, _mm_unpacklo_epi8(d, zero), flags);
+                sh = SDL_Blit_Blend_SSE2(sh, _mm_unpackhi_epi8(d, zero), flags);
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        posy += incy;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_RGBA8888_RGB888_Modulate_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_loadu_si128((const __m128i *)src);
+            } else {
+                s = _mm_cvtsi32_si128((int)*src);
+            }
+            src += count;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(0, 3, 2, 1)), _MM_SHUFFLE(0, 3, 2, 1));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(0, 3, 2, 1)), _MM_SHUFFLE(0, 3, 2, 1));
+                sl = SDL_Blit_Modulate_SSE2(sl, modulate);
+                sh = SDL_Blit_Modulate_SSE2(sh, modulate);
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_RGBA8888_RGB888_Modulate_Scale_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+    int srcy, posy, incy, incx;
+
+    srcy = 0;
+    posy = 0;
+    incy = (info->src_h << 16) / info->dst_h;
+    incx = (info->src_w << 16) / info->dst_w;
+
+    while (info->dst_h--) {
+        const Uint32 *src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        int posx = 0;
+        while (posy >= 0x10000L) {
+            ++srcy;
+            posy -= 0x10000L;
+        }
+        src = (const Uint32 *)(info->src + (srcy * info->src_pitch));
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_set_epi32((int)src[(posx + 3 * incx) >> 16], (int)src[(posx + 2 * incx) >> 16],
+                                  (int)src[(posx + incx) >> 16], (int)src[posx >> 16]);
+            } else {
+                s = _mm_cvtsi32_si128((int)src[posx >> 16]);
+            }
+            posx += count * incx;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(0, 3, 2, 1)), _MM_SHUFFLE(0, 3, 2, 1));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(0, 3, 2, 1)), _MM_SHUFFLE(0, 3, 2, 1));
+                sl = SDL_Blit_Modulate_SSE2(sl, modulate);
+                sh = SDL_Blit_Modulate_SSE2(sh, modulate);
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        posy += incy;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_RGBA8888_RGB888_Modulate_Blend_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_loadu_si128((const __m128i *)src);
+            } else {
+                s = _mm_cvtsi32_si128((int)*src);
+            }
+            src += count;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                __m128i d;
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(0, 3, 2, 1)), _MM_SHUFFLE(0, 3, 2, 1));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(0, 3, 2, 1)), _MM_SHUFFLE(0, 3, 2, 1));
+                sl = SDL_Blit_Modulate_SSE2(sl, modulate);
+                sh = SDL_Blit_Modulate_SSE2(sh, modulate);
+                if (count == 4) {
+                    d = _mm_loadu_si128((const __m128i *)dst);
+                } else {
+                    d = _mm_cvtsi32_si128((int)*dst);
+                }
+                sl = SDL_Blit_Blend_SSE2(sl, _mm_unpacklo_epi8(d, zero), flags);
+                sh = SDL_Blit_Blend_SSE2(sh, _mm_unpackhi_epi8(d, zero), flags);
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_RGBA8888_RGB888_Modulate_Blend_Scale_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+    int srcy, posy, incy, incx;
+
+    srcy = 0;
+    posy = 0;
+    incy = (info->src_h << 16) / info->dst_h;
+    incx = (info->src_w << 16) / info->dst_w;
+
+    while (info->dst_h--) {
+        const Uint32 *src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        int posx = 0;
+        while (posy >= 0x10000L) {
+            ++srcy;
+            posy -= 0x10000L;
+        }
+        src = (const Uint32 *)(info->src + (srcy * info->src_pitch));
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_set_epi32((int)src[(posx + 3 * incx) >> 16], (int)src[(posx + 2 * incx) >> 16],
+                                  (int)src[(posx + incx) >> 16], (int)src[posx >> 16]);
+            } else {
+                s = _mm_cvtsi32_si128((int)src[posx >> 16]);
+            }
+            posx += count * incx;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                __m128i d;
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(0, 3, 2, 1)), _MM_SHUFFLE(0, 3, 2, 1));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(0, 3, 2, 1)), _MM_SHUFFLE(0, 3, 2, 1));
+                sl = SDL_Blit_Modulate_SSE2(sl, modulate);
+                sh = SDL_Blit_Modulate_SSE2(sh, modulate);
+                if (count == 4) {
+                    d = _mm_loadu_si128((const __m128i *)dst);
+                } else {
+                    d = _mm_cvtsi32_si128((int)*dst);
+                }
+                sl = SDL_Blit_Blend_SSE2(sl, _mm_unpacklo_epi8(d, zero), flags);
+                sh = SDL_Blit_Blend_SSE2(sh, _mm_unpackhi_epi8(d, zero), flags);
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        posy += incy;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_RGBA8888_BGR888_Scale_SSE2(SDL_BlitInfo *info)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+    int srcy, posy, incy, incx;
+
+    srcy = 0;
+    posy = 0;
+    incy = (info->src_h << 16) / info->dst_h;
+    incx = (info->src_w << 16) / info->dst_w;
+
+    while (info->dst_h--) {
+        const Uint32 *src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        int posx = 0;
+        while (posy >= 0x10000L) {
+            ++srcy;
+            posy -= 0x10000L;
+        }
+        src = (const Uint32 *)(info->src + (srcy * info->src_pitch));
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_set_epi32((int)src[(posx + 3 * incx) >> 16], (int)src[(posx + 2 * incx) >> 16],
+                                  (int)src[(posx + incx) >> 16], (int)src[posx >> 16]);
+            } else {
+                s = _mm_cvtsi32_si128((int)src[posx >> 16]);
+            }
+            posx += count * incx;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(0, 1, 2, 3)), _MM_SHUFFLE(0, 1, 2, 3));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(0, 1, 2, 3)), _MM_SHUFFLE(0, 1, 2, 3));
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        posy += incy;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_RGBA8888_BGR888_Blend_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_loadu_si128((const __m128i *)src);
+            } else {
+                s = _mm_cvtsi32_si128((int)*src);
+            }
+            src += count;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                __m128i d;
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(0, 1, 2, 3)), _MM_SHUFFLE(0, 1, 2, 3));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(0, 1, 2, 3)), _MM_SHUFFLE(0, 1, 2, 3));
+                if (count == 4) {
+                    d = _mm_loadu_si128((const __m128i *)dst);
+                } else {
+                    d = _mm_cvtsi32_si128((int)*dst);
+                }
+                sl = SDL_Blit_Blend_SSE2(sl, _mm_unpacklo_epi8(d, zero), flags);
+                sh = SDL_Blit_Blend_SSE2(sh, _mm_unpackhi_epi8(d, zero), flags);
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_RGBA8888_BGR888_Blend_Scale_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+    int srcy, posy, incy, incx;
+
+    srcy = 0;
+    posy = 0;
+    incy = (info->src_h << 16) / info->dst_h;
+    incx = (info->src_w << 16) / info->dst_w;
+
+    while (info->dst_h--) {
+        const Uint32 *src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        int posx = 0;
+        while (posy >= 0x10000L) {
+            ++srcy;
+            posy -= 0x10000L;
+        }
+        src = (const Uint32 *)(info->src + (srcy * info->src_pitch));
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_set_epi32((int)src[(posx + 3 * incx) >> 16], (int)src[(posx + 2 * incx) >> 16],
+                                  (int)src[(posx + incx) >> 16], (int)src[posx >> 16]);
+            } else {
+                s = _mm_cvtsi32_si128((int)src[posx >> 16]);
+            }
+            posx += count * incx;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                __m128i d;
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(0, 1, 2, 3)), _MM_SHUFFLE(0, 1, 2, 3));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(0, 1, 2, 3)), _MM_SHUFFLE(0, 1, 2, 3));
+                if (count == 4) {
+                    d = _mm_loadu_si128((const __m128i *)dst);
+                } else {
+                    d = _mm_cvtsi32_si128((int)*dst);
+                }
+                sl = SDL_Blit_Blend_SSE2(sl, _mm_unpacklo_epi8(d, zero), flags);
+                sh = SDL_Blit_Blend_SSE2(sh, _mm_unpackhi_epi8(d, zero), flags);
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        posy += incy;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_RGBA8888_BGR888_Modulate_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_loadu_si128((const __m128i *)src);
+            } else {
+                s = _mm_cvtsi32_si128((int)*src);
+            }
+            src += count;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(0, 1, 2, 3)), _MM_SHUFFLE(0, 1, 2, 3));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(0, 1, 2, 3)), _MM_SHUFFLE(0, 1, 2, 3));
+                sl = SDL_Blit_Modulate_SSE2(sl, modulate);
+                sh = SDL_Blit_Modulate_SSE2(sh, modulate);
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_RGBA8888_BGR888_Modulate_Scale_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+    int srcy, posy, incy, incx;
+
+    srcy = 0;
+    posy = 0;
+    incy = (info->src_h << 16) / info->dst_h;
+    incx = (info->src_w << 16) / info->dst_w;
+
+    while (info->dst_h--) {
+        const Uint32 *src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        int posx = 0;
+        while (posy >= 0x10000L) {
+            ++srcy;
+            posy -= 0x10000L;
+        }
+        src = (const Uint32 *)(info->src + (srcy * info->src_pitch));
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_set_epi32((int)src[(posx + 3 * incx) >> 16], (int)src[(posx + 2 * incx) >> 16],
+                                  (int)src[(posx + incx) >> 16], (int)src[posx >> 16]);
+            } else {
+                s = _mm_cvtsi32_si128((int)src[posx >> 16]);
+            }
+            posx += count * incx;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(0, 1, 2, 3)), _MM_SHUFFLE(0, 1, 2, 3));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(0, 1, 2, 3)), _MM_SHUFFLE(0, 1, 2, 3));
+                sl = SDL_Blit_Modulate_SSE2(sl, modulate);
+                sh = SDL_Blit_Modulate_SSE2(sh, modulate);
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        posy += incy;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_RGBA8888_BGR888_Modulate_Blend_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_loadu_si128((const __m128i *)src);
+            } else {
+                s = _mm_cvtsi32_si128((int)*src);
+            }
+            src += count;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                __m128i d;
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(0, 1, 2, 3)), _MM_SHUFFLE(0, 1, 2, 3));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(0, 1, 2, 3)), _MM_SHUFFLE(0, 1, 2, 3));
+                sl = SDL_Blit_Modulate_SSE2(sl, modulate);
+                sh = SDL_Blit_Modulate_SSE2(sh, modulate);
+                if (count == 4) {
+                    d = _mm_loadu_si128((const __m128i *)dst);
+                } else {
+                    d = _mm_cvtsi32_si128((int)*dst);
+                }
+                sl = SDL_Blit_Blend_SSE2(sl, _mm_unpacklo_epi8(d, zero), flags);
+                sh = SDL_Blit_Blend_SSE2(sh, _mm_unpackhi_epi8(d, zero), flags);
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_RGBA8888_BGR888_Modulate_Blend_Scale_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+    int srcy, posy, incy, incx;
+
+    srcy = 0;
+    posy = 0;
+    incy = (info->src_h << 16) / info->dst_h;
+    incx = (info->src_w << 16) / info->dst_w;
+
+    while (info->dst_h--) {
+        const Uint32 *src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        int posx = 0;
+        while (posy >= 0x10000L) {
+            ++srcy;
+            posy -= 0x10000L;
+        }
+        src = (const Uint32 *)(info->src + (srcy * info->src_pitch));
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_set_epi32((int)src[(posx + 3 * incx) >> 16], (int)src[(posx + 2 * incx) >> 16],
+                                  (int)src[(posx + incx) >> 16], (int)src[posx >> 16]);
+            } else {
+                s = _mm_cvtsi32_si128((int)src[posx >> 16]);
+            }
+            posx += count * incx;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                __m128i d;
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(0, 1, 2, 3)), _MM_SHUFFLE(0, 1, 2, 3));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(0, 1, 2, 3)), _MM_SHUFFLE(0, 1, 2, 3));
+                sl = SDL_Blit_Modulate_SSE2(sl, modulate);
+                sh = SDL_Blit_Modulate_SSE2(sh, modulate);
+                if (count == 4) {
+                    d = _mm_loadu_si128((const __m128i *)dst);
+                } else {
+                    d = _mm_cvtsi32_si128((int)*dst);
+                }
+                sl = SDL_Blit_Blend_SSE2(sl, _mm_unpacklo_epi8(d, zero), flags);
+                sh = SDL_Blit_Blend_SSE2(sh, _mm_unpackhi_epi8(d, zero), flags);
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        posy += incy;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_RGBA8888_ARGB8888_Scale_SSE2(SDL_BlitInfo *info)
+{
+    const __m128i zero = _mm_setzero_si128();
+    int srcy, posy, incy, incx;
+
+    srcy = 0;
+    posy = 0;
+    incy = (info->src_h << 16) / info->dst_h;
+    incx = (info->src_w << 16) / info->dst_w;
+
+    while (info->dst_h--) {
+        const Uint32 *src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        int posx = 0;
+        while (posy >= 0x10000L) {
+            ++srcy;
+            posy -= 0x10000L;
+        }
+        src = (const Uint32 *)(info->src + (srcy * info->src_pitch));
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_set_epi32((int)src[(posx + 3 * incx) >> 16], (int)src[(posx + 2 * incx) >> 16],
+                                  (int)src[(posx + incx) >> 16], (int)src[posx >> 16]);
+            } else {
+                s = _mm_cvtsi32_si128((int)src[posx >> 16]);
+            }
+            posx += count * incx;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(0, 3, 2, 1)), _MM_SHUFFLE(0, 3, 2, 1));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(0, 3, 2, 1)), _MM_SHUFFLE(0, 3, 2, 1));
+                s = _mm_packus_epi16(sl, sh);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        posy += incy;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_RGBA8888_ARGB8888_Blend_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_loadu_si128((const __m128i *)src);
+            } else {
+                s = _mm_cvtsi32_si128((int)*src);
+            }
+            src += count;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                __m128i d;
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(0, 3, 2, 1)), _MM_SHUFFLE(0, 3, 2, 1));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(0, 3, 2, 1)), _MM_SHUFFLE(0, 3, 2, 1));
+                if (count == 4) {
+                    d = _mm_loadu_si128((const __m128i *)dst);
+                } else {
+                    d = _mm_cvtsi32_si128((int)*dst);
+                }
+                sl = SDL_Blit_Blend_SSE2(sl, _mm_unpacklo_epi8(d, zero), flags);
+                sh = SDL_Blit_Blend_SSE2(sh, _mm_unpackhi_epi8(d, zero), flags);
+                s = _mm_packus_epi16(sl, sh);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_RGBA8888_ARGB8888_Blend_Scale_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    int srcy, posy, incy, incx;
+
+    srcy = 0;
+    posy = 0;
+    incy = (info->src_h << 16) / info->dst_h;
+    incx = (info->src_w << 16) / info->dst_w;
+
+    while (info->dst_h--) {
+        const Uint32 *src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        int posx = 0;
+        while (posy >= 0x10000L) {
+            ++srcy;
+            posy -= 0x10000L;
+        }
+        src = (const Uint32 *)(info->src + (srcy * info->src_pitch));
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_set_epi32((int)src[(posx + 3 * incx) >> 16], (int)src[(posx + 2 * incx) >> 16],
+                                  (int)src[(posx + incx) >> 16], (int)src[posx >> 16]);
+            } else {
+                s = _mm_cvtsi32_si128((int)src[posx >> 16]);
+            }
+            posx += count * incx;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                __m128i d;
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(0, 3, 2, 1)), _MM_SHUFFLE(0, 3, 2, 1));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(0, 3, 2, 1)), _MM_SHUFFLE(0, 3, 2, 1));
+                if (count == 4) {
+                    d = _mm_loadu_si128((const __m128i *)dst);
+                } else {
+                    d = _mm_cvtsi32_si128((int)*dst);
+                }
+                sl = SDL_Blit_Blend_SSE2(sl, _mm_unpacklo_epi8(d, zero), flags);
+                sh = SDL_Blit_Blend_SSE2(sh, _mm_unpackhi_epi8(d, zero), flags);
+                s = _mm_packus_epi16(sl, sh);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        posy += incy;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_RGBA8888_ARGB8888_Modulate_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB);
+    const __m128i zero = _mm_setzero_si128();
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_loadu_si128((const __m128i *)src);
+            } else {
+                s = _mm_cvtsi32_si128((int)*src);
+            }
+            src += count;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(0, 3, 2, 1)), _MM_SHUFFLE(0, 3, 2, 1));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(0, 3, 2, 1)), _MM_SHUFFLE(0, 3, 2, 1));
+                sl = SDL_Blit_Modulate_SSE2(sl, modulate);
+                sh = SDL_Blit_Modulate_SSE2(sh, modulate);
+                s = _mm_packus_epi16(sl, sh);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_RGBA8888_ARGB8888_Modulate_Scale_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB);
+    const __m128i zero = _mm_setzero_si128();
+    int srcy, posy, incy, incx;
+
+    srcy = 0;
+    posy = 0;
+    incy = (info->src_h << 16) / info->dst_h;
+    incx = (info->src_w << 16) / info->dst_w;
+
+    while (info->dst_h--) {
+        const Uint32 *src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        int posx = 0;
+        while (posy >= 0x10000L) {
+            ++srcy;
+            posy -= 0x10000L;
+        }
+        src = (const Uint32 *)(info->src + (srcy * info->src_pitch));
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_set_epi32((int)src[(posx + 3 * incx) >> 16], (int)src[(posx + 2 * incx) >> 16],
+                                  (int)src[(posx + incx) >> 16], (int)src[posx >> 16]);
+            } else {
+                s = _mm_cvtsi32_si128((int)src[posx >> 16]);
+            }
+            posx += count * incx;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(0, 3, 2, 1)), _MM_SHUFFLE(0, 3, 2, 1));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(0, 3, 2, 1)), _MM_SHUFFLE(0, 3, 2, 1));
+                sl = SDL_Blit_Modulate_SSE2(sl, modulate);
+                sh = SDL_Blit_Modulate_SSE2(sh, modulate);
+                s = _mm_packus_epi16(sl, sh);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        posy += incy;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_RGBA8888_ARGB8888_Modulate_Blend_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB);
+    const __m128i zero = _mm_setzero_si128();
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_loadu_si128((const __m128i *)src);
+            } else {
+                s = _mm_cvtsi32_si128((int)*src);
+            }
+            src += count;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                __m128i d;
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(0, 3, 2, 1)), _MM_SHUFFLE(0, 3, 2, 1));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(0, 3, 2, 1)), _MM_SHUFFLE(0, 3, 2, 1));
+                sl = SDL_Blit_Modulate_SSE2(sl, modulate);
+                sh = SDL_Blit_Modulate_SSE2(sh, modulate);
+                if (count == 4) {
+                    d = _mm_loadu_si128((const __m128i *)dst);
+                } else {
+                    d = _mm_cvtsi32_si128((int)*dst);
+                }
+                sl = SDL_Blit_Blend_SSE2(sl, _mm_unpacklo_epi8(d, zero), flags);
+                sh = SDL_Blit_Blend_SSE2(sh, _mm_unpackhi_epi8(d, zero), flags);
+                s = _mm_packus_epi16(sl, sh);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_RGBA8888_ARGB8888_Modulate_Blend_Scale_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB);
+    const __m128i zero = _mm_setzero_si128();
+    int srcy, posy, incy, incx;
+
+    srcy = 0;
+    posy = 0;
+    incy = (info->src_h << 16) / info->dst_h;
+    incx = (info->src_w << 16) / info->dst_w;
+
+    while (info->dst_h--) {
+        const Uint32 *src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        int posx = 0;
+        while (posy >= 0x10000L) {
+            ++srcy;
+            posy -= 0x10000L;
+        }
+        src = (const Uint32 *)(info->src + (srcy * info->src_pitch));
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_set_epi32((int)src[(posx + 3 * incx) >> 16], (int)src[(posx + 2 * incx) >> 16],
+                                  (int)src[(posx + incx) >> 16], (int)src[posx >> 16]);
+            } else {
+                s = _mm_cvtsi32_si128((int)src[posx >> 16]);
+            }
+            posx += count * incx;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                __m128i d;
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(0, 3, 2, 1)), _MM_SHUFFLE(0, 3, 2, 1));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(0, 3, 2, 1)), _MM_SHUFFLE(0, 3, 2, 1));
+                sl = SDL_Blit_Modulate_SSE2(sl, modulate);
+                sh = SDL_Blit_Modulate_SSE2(sh, modulate);
+                if (count == 4) {
+                    d = _mm_loadu_si128((const __m128i *)dst);
+                } else {
+                    d = _mm_cvtsi32_si128((int)*dst);
+                }
+                sl = SDL_Blit_Blend_SSE2(sl, _mm_unpacklo_epi8(d, zero), flags);
+                sh = SDL_Blit_Blend_SSE2(sh, _mm_unpackhi_epi8(d, zero), flags);
+                s = _mm_packus_epi16(sl, sh);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        posy += incy;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_ABGR8888_RGB888_Scale_SSE2(SDL_BlitInfo *info)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+    int srcy, posy, incy, incx;
+
+    srcy = 0;
+    posy = 0;
+    incy = (info->src_h << 16) / info->dst_h;
+    incx = (info->src_w << 16) / info->dst_w;
+
+    while (info->dst_h--) {
+        const Uint32 *src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        int posx = 0;
+        while (posy >= 0x10000L) {
+            ++srcy;
+            posy -= 0x10000L;
+        }
+        src = (const Uint32 *)(info->src + (srcy * info->src_pitch));
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_set_epi32((int)src[(posx + 3 * incx) >> 16], (int)src[(posx + 2 * incx) >> 16],
+                                  (int)src[(posx + incx) >> 16], (int)src[posx >> 16]);
+            } else {
+                s = _mm_cvtsi32_si128((int)src[posx >> 16]);
+            }
+            posx += count * incx;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        posy += incy;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_ABGR8888_RGB888_Blend_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_loadu_si128((const __m128i *)src);
+            } else {
+                s = _mm_cvtsi32_si128((int)*src);
+            }
+            src += count;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                __m128i d;
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                if (count == 4) {
+                    d = _mm_loadu_si128((const __m128i *)dst);
+                } else {
+                    d = _mm_cvtsi32_si128((int)*dst);
+                }
+                sl = SDL_Blit_Blend_SSE2(sl, _mm_unpacklo_epi8(d, zero), flags);
+                sh = SDL_Blit_Blend_SSE2(sh, _mm_unpackhi_epi8(d, zero), flags);
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_ABGR8888_RGB888_Blend_Scale_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+    int srcy, posy, incy, incx;
+
+    srcy = 0;
+    posy = 0;
+    incy = (info->src_h << 16) / info->dst_h;
+    incx = (info->src_w << 16) / info->dst_w;
+
+    while (info->dst_h--) {
+        const Uint32 *src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        int posx = 0;
+        while (posy >= 0x10000L) {
+            ++srcy;
+            posy -= 0x10000L;
+        }
+        src = (const Uint32 *)(info->src + (srcy * info->src_pitch));
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_set_epi32((int)src[(posx + 3 * incx) >> 16], (int)src[(posx + 2 * incx) >> 16],
+                                  (int)src[(posx + incx) >> 16], (int)src[posx >> 16]);
+            } else {
+                s = _mm_cvtsi32_si128((int)src[posx >> 16]);
+            }
+            posx += count * incx;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                __m128i d;
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                if (count == 4) {
+                    d = _mm_loadu_si128((const __m128i *)dst);
+                } else {
+                    d = _mm_cvtsi32_si128((int)*dst);
+                }
+                sl = SDL_Blit_Blend_SSE2(sl, _mm_unpacklo_epi8(d, zero), flags);
+                sh = SDL_Blit_Blend_SSE2(sh, _mm_unpackhi_epi8(d, zero), flags);
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        posy += incy;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_ABGR8888_RGB888_Modulate_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_loadu_si128((const __m128i *)src);
+            } else {
+                s = _mm_cvtsi32_si128((int)*src);
+            }
+            src += count;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                sl = SDL_Blit_Modulate_SSE2(sl, modulate);
+                sh = SDL_Blit_Modulate_SSE2(sh, modulate);
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_ABGR8888_RGB888_Modulate_Scale_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+    int srcy, posy, incy, incx;
+
+    srcy = 0;
+    posy = 0;
+    incy = (info->src_h << 16) / info->dst_h;
+    incx = (info->src_w << 16) / info->dst_w;
+
+    while (info->dst_h--) {
+        const Uint32 *src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        int posx = 0;
+        while (posy >= 0x10000L) {
+            ++srcy;
+            posy -= 0x10000L;
+        }
+        src = (const Uint32 *)(info->src + (srcy * info->src_pitch));
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_set_epi32((int)src[(posx + 3 * incx) >> 16], (int)src[(posx + 2 * incx) >> 16],
+                                  (int)src[(posx + incx) >> 16], (int)src[posx >> 16]);
+            } else {
+                s = _mm_cvtsi32_si128((int)src[posx >> 16]);
+            }
+            posx += count * incx;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                sl = SDL_Blit_Modulate_SSE2(sl, modulate);
+                sh = SDL_Blit_Modulate_SSE2(sh, modulate);
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        posy += incy;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_ABGR8888_RGB888_Modulate_Blend_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_loadu_si128((const __m128i *)src);
+            } else {
+                s = _mm_cvtsi32_si128((int)*src);
+            }
+            src += count;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                __m128i d;
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                sl = SDL_Blit_Modulate_SSE2(sl, modulate);
+                sh = SDL_Blit_Modulate_SSE2(sh, modulate);
+                if (count == 4) {
+                    d = _mm_loadu_si128((const __m128i *)dst);
+                } else {
+                    d = _mm_cvtsi32_si128((int)*dst);
+                }
+                sl = SDL_Blit_Blend_SSE2(sl, _mm_unpacklo_epi8(d, zero), flags);
+                sh = SDL_Blit_Blend_SSE2(sh, _mm_unpackhi_epi8(d, zero), flags);
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_ABGR8888_RGB888_Modulate_Blend_Scale_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+    int srcy, posy, incy, incx;
+
+    srcy = 0;
+    posy = 0;
+    incy = (info->src_h << 16) / info->dst_h;
+    incx = (info->src_w << 16) / info->dst_w;
+
+    while (info->dst_h--) {
+        const Uint32 *src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        int posx = 0;
+        while (posy >= 0x10000L) {
+            ++srcy;
+            posy -= 0x10000L;
+        }
+        src = (const Uint32 *)(info->src + (srcy * info->src_pitch));
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_set_epi32((int)src[(posx + 3 * incx) >> 16], (int)src[(posx + 2 * incx) >> 16],
+                                  (int)src[(posx + incx) >> 16], (int)src[posx >> 16]);
+            } else {
+                s = _mm_cvtsi32_si128((int)src[posx >> 16]);
+            }
+            posx += count * incx;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                __m128i d;
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                sl = SDL_Blit_Modulate_SSE2(sl, modulate);
+                sh = SDL_Blit_Modulate_SSE2(sh, modulate);
+                if (count == 4) {
+                    d = _mm_loadu_si128((const __m128i *)dst);
+                } else {
+                    d = _mm_cvtsi32_si128((int)*dst);
+                }
+                sl = SDL_Blit_Blend_SSE2(sl, _mm_unpacklo_epi8(d, zero), flags);
+                sh = SDL_Blit_Blend_SSE2(sh, _mm_unpackhi_epi8(d, zero), flags);
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        posy += incy;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_ABGR8888_BGR888_Scale_SSE2(SDL_BlitInfo *info)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+    int srcy, posy, incy, incx;
+
+    srcy = 0;
+    posy = 0;
+    incy = (info->src_h << 16) / info->dst_h;
+    incx = (info->src_w << 16) / info->dst_w;
+
+    while (info->dst_h--) {
+        const Uint32 *src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        int posx = 0;
+        while (posy >= 0x10000L) {
+            ++srcy;
+            posy -= 0x10000L;
+        }
+        src = (const Uint32 *)(info->src + (srcy * info->src_pitch));
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_set_epi32((int)src[(posx + 3 * incx) >> 16], (int)src[(posx + 2 * incx) >> 16],
+                                  (int)src[(posx + incx) >> 16], (int)src[posx >> 16]);
+            } else {
+                s = _mm_cvtsi32_si128((int)src[posx >> 16]);
+            }
+            posx += count * incx;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        posy += incy;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_ABGR8888_BGR888_Blend_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_loadu_si128((const __m128i *)src);
+            } else {
+                s = _mm_cvtsi32_si128((int)*src);
+            }
+            src += count;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                __m128i d;
+                if (count == 4) {
+                    d = _mm_loadu_si128((const __m128i *)dst);
+                } else {
+                    d = _mm_cvtsi32_si128((int)*dst);
+                }
+                sl = SDL_Blit_Blend_SSE2(sl, _mm_unpacklo_epi8(d, zero), flags);
+                sh = SDL_Blit_Blend_SSE2(sh, _mm_unpackhi_epi8(d, zero), flags);
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_ABGR8888_BGR888_Blend_Scale_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+    int srcy, posy, incy, incx;
+
+    srcy = 0;
+    posy = 0;
+    incy = (info->src_h << 16) / info->dst_h;
+    incx = (info->src_w << 16) / info->dst_w;
+
+    while (info->dst_h--) {
+        const Uint32 *src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        int posx = 0;
+        while (posy >= 0x10000L) {
+            ++srcy;
+            posy -= 0x10000L;
+        }
+        src = (const Uint32 *)(info->src + (srcy * info->src_pitch));
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_set_epi32((int)src[(posx + 3 * incx) >> 16], (int)src[(posx + 2 * incx) >> 16],
+                                  (int)src[(posx + incx) >> 16], (int)src[posx >> 16]);
+            } else {
+                s = _mm_cvtsi32_si128((int)src[posx >> 16]);
+            }
+            posx += count * incx;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                __m128i d;
+                if (count == 4) {
+                    d = _mm_loadu_si128((const __m128i *)dst);
+                } else {
+                    d = _mm_cvtsi32_si128((int)*dst);
+                }
+                sl = SDL_Blit_Blend_SSE2(sl, _mm_unpacklo_epi8(d, zero), flags);
+                sh = SDL_Blit_Blend_SSE2(sh, _mm_unpackhi_epi8(d, zero), flags);
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        posy += incy;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_ABGR8888_BGR888_Modulate_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_loadu_si128((const __m128i *)src);
+            } else {
+                s = _mm_cvtsi32_si128((int)*src);
+            }
+            src += count;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                sl = SDL_Blit_Modulate_SSE2(sl, modulate);
+                sh = SDL_Blit_Modulate_SSE2(sh, modulate);
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_ABGR8888_BGR888_Modulate_Scale_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+    int srcy, posy, incy, incx;
+
+    srcy = 0;
+    posy = 0;
+    incy = (info->src_h << 16) / info->dst_h;
+    incx = (info->src_w << 16) / info->dst_w;
+
+    while (info->dst_h--) {
+        const Uint32 *src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        int posx = 0;
+        while (posy >= 0x10000L) {
+            ++srcy;
+            posy -= 0x10000L;
+        }
+        src = (const Uint32 *)(info->src + (srcy * info->src_pitch));
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_set_epi32((int)src[(posx + 3 * incx) >> 16], (int)src[(posx + 2 * incx) >> 16],
+                                  (int)src[(posx + incx) >> 16], (int)src[posx >> 16]);
+            } else {
+                s = _mm_cvtsi32_si128((int)src[posx >> 16]);
+            }
+            posx += count * incx;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                sl = SDL_Blit_Modulate_SSE2(sl, modulate);
+                sh = SDL_Blit_Modulate_SSE2(sh, modulate);
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        posy += incy;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_ABGR8888_BGR888_Modulate_Blend_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_loadu_si128((const __m128i *)src);
+            } else {
+                s = _mm_cvtsi32_si128((int)*src);
+            }
+            src += count;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                __m128i d;
+                sl = SDL_Blit_Modulate_SSE2(sl, modulate);
+                sh = SDL_Blit_Modulate_SSE2(sh, modulate);
+                if (count == 4) {
+                    d = _mm_loadu_si128((const __m128i *)dst);
+                } else {
+                    d = _mm_cvtsi32_si128((int)*dst);
+                }
+                sl = SDL_Blit_Blend_SSE2(sl, _mm_unpacklo_epi8(d, zero), flags);
+                sh = SDL_Blit_Blend_SSE2(sh, _mm_unpackhi_epi8(d, zero), flags);
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_ABGR8888_BGR888_Modulate_Blend_Scale_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+    int srcy, posy, incy, incx;
+
+    srcy = 0;
+    posy = 0;
+    incy = (info->src_h << 16) / info->dst_h;
+    incx = (info->src_w << 16) / info->dst_w;
+
+    while (info->dst_h--) {
+        const Uint32 *src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        int posx = 0;
+        while (posy >= 0x10000L) {
+            ++srcy;
+            posy -= 0x10000L;
+        }
+        src = (const Uint32 *)(info->src + (srcy * info->src_pitch));
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_set_epi32((int)src[(posx + 3 * incx) >> 16], (int)src[(posx + 2 * incx) >> 16],
+                                  (int)src[(posx + incx) >> 16], (int)src[posx >> 16]);
+            } else {
+                s = _mm_cvtsi32_si128((int)src[posx >> 16]);
+            }
+            posx += count * incx;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                __m128i d;
+                sl = SDL_Blit_Modulate_SSE2(sl, modulate);
+                sh = SDL_Blit_Modulate_SSE2(sh, modulate);
+                if (count == 4) {
+                    d = _mm_loadu_si128((const __m128i *)dst);
+                } else {
+                    d = _mm_cvtsi32_si128((int)*dst);
+                }
+                sl = SDL_Blit_Blend_SSE2(sl, _mm_unpacklo_epi8(d, zero), flags);
+                sh = SDL_Blit_Blend_SSE2(sh, _mm_unpackhi_epi8(d, zero), flags);
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        posy += incy;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_ABGR8888_ARGB8888_Scale_SSE2(SDL_BlitInfo *info)
+{
+    const __m128i zero = _mm_setzero_si128();
+    int srcy, posy, incy, incx;
+
+    srcy = 0;
+    posy = 0;
+    incy = (info->src_h << 16) / info->dst_h;
+    incx = (info->src_w << 16) / info->dst_w;
+
+    while (info->dst_h--) {
+        const Uint32 *src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        int posx = 0;
+        while (posy >= 0x10000L) {
+            ++srcy;
+            posy -= 0x10000L;
+        }
+        src = (const Uint32 *)(info->src + (srcy * info->src_pitch));
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_set_epi32((int)src[(posx + 3 * incx) >> 16], (int)src[(posx + 2 * incx) >> 16],
+                                  (int)src[(posx + incx) >> 16], (int)src[posx >> 16]);
+            } else {
+                s = _mm_cvtsi32_si128((int)src[posx >> 16]);
+            }
+            posx += count * incx;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                s = _mm_packus_epi16(sl, sh);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        posy += incy;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_ABGR8888_ARGB8888_Blend_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_loadu_si128((const __m128i *)src);
+            } else {
+                s = _mm_cvtsi32_si128((int)*src);
+            }
+            src += count;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                __m128i d;
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                if (count == 4) {
+                    d = _mm_loadu_si128((const __m128i *)dst);
+                } else {
+                    d = _mm_cvtsi32_si128((int)*dst);
+                }
+                sl = SDL_Blit_Blend_SSE2(sl, _mm_unpacklo_epi8(d, zero), flags);
+                sh = SDL_Blit_Blend_SSE2(sh, _mm_unpackhi_epi8(d, zero), flags);
+                s = _mm_packus_epi16(sl, sh);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_ABGR8888_ARGB8888_Blend_Scale_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    int srcy, posy, incy, incx;
+
+    srcy = 0;
+    posy = 0;
+    incy = (info->src_h << 16) / info->dst_h;
+    incx = (info->src_w << 16) / info->dst_w;
+
+    while (info->dst_h--) {
+        const Uint32 *src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        int posx = 0;
+        while (posy >= 0x10000L) {
+            ++srcy;
+            posy -= 0x10000L;
+        }
+        src = (const Uint32 *)(info->src + (srcy * info->src_pitch));
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_set_epi32((int)src[(posx + 3 * incx) >> 16], (int)src[(posx + 2 * incx) >> 16],
+                                  (int)src[(posx + incx) >> 16], (int)src[posx >> 16]);
+            } else {
+                s = _mm_cvtsi32_si128((int)src[posx >> 16]);
+            }
+            posx += count * incx;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                __m128i d;
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                if (count == 4) {
+                    d = _mm_loadu_si128((const __m128i *)dst);
+                } else {
+                    d = _mm_cvtsi32_si128((int)*dst);
+                }
+                sl = SDL_Blit_Blend_SSE2(sl, _mm_unpacklo_epi8(d, zero), flags);
+                sh = SDL_Blit_Blend_SSE2(sh, _mm_unpackhi_epi8(d, zero), flags);
+                s = _mm_packus_epi16(sl, sh);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        posy += incy;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_ABGR8888_ARGB8888_Modulate_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB);
+    const __m128i zero = _mm_setzero_si128();
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_loadu_si128((const __m128i *)src);
+            } else {
+                s = _mm_cvtsi32_si128((int)*src);
+            }
+            src += count;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                sl = SDL_Blit_Modulate_SSE2(sl, modulate);
+                sh = SDL_Blit_Modulate_SSE2(sh, modulate);
+                s = _mm_packus_epi16(sl, sh);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_ABGR8888_ARGB8888_Modulate_Scale_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB);
+    const __m128i zero = _mm_setzero_si128();
+    int srcy, posy, incy, incx;
+
+    srcy = 0;
+    posy = 0;
+    incy = (info->src_h << 16) / info->dst_h;
+    incx = (info->src_w << 16) / info->dst_w;
+
+    while (info->dst_h--) {
+        const Uint32 *src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        int posx = 0;
+        while (posy >= 0x10000L) {
+            ++srcy;
+            posy -= 0x10000L;
+        }
+        src = (const Uint32 *)(info->src + (srcy * info->src_pitch));
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_set_epi32((int)src[(posx + 3 * incx) >> 16], (int)src[(posx + 2 * incx) >> 16],
+                                  (int)src[(posx + incx) >> 16], (int)src[posx >> 16]);
+            } else {
+                s = _mm_cvtsi32_si128((int)src[posx >> 16]);
+            }
+            posx += count * incx;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                sl = SDL_Blit_Modulate_SSE2(sl, modulate);
+                sh = SDL_Blit_Modulate_SSE2(sh, modulate);
+                s = _mm_packus_epi16(sl, sh);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        posy += incy;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_ABGR8888_ARGB8888_Modulate_Blend_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB);
+    const __m128i zero = _mm_setzero_si128();
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_loadu_si128((const __m128i *)src);
+            } else {
+                s = _mm_cvtsi32_si128((int)*src);
+            }
+            src += count;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                __m128i d;
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                sl = SDL_Blit_Modulate_SSE2(sl, modulate);
+                sh = SDL_Blit_Modulate_SSE2(sh, modulate);
+                if (count == 4) {
+                    d = _mm_loadu_si128((const __m128i *)dst);
+                } else {
+                    d = _mm_cvtsi32_si128((int)*dst);
+                }
+                sl = SDL_Blit_Blend_SSE2(sl, _mm_unpacklo_epi8(d, zero), flags);
+                sh = SDL_Blit_Blend_SSE2(sh, _mm_unpackhi_epi8(d, zero), flags);
+                s = _mm_packus_epi16(sl, sh);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_ABGR8888_ARGB8888_Modulate_Blend_Scale_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB);
+    const __m128i zero = _mm_setzero_si128();
+    int srcy, posy, incy, incx;
+
+    srcy = 0;
+    posy = 0;
+    incy = (info->src_h << 16) / info->dst_h;
+    incx = (info->src_w << 16) / info->dst_w;
+
+    while (info->dst_h--) {
+        const Uint32 *src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        int posx = 0;
+        while (posy >= 0x10000L) {
+            ++srcy;
+            posy -= 0x10000L;
+        }
+        src = (const Uint32 *)(info->src + (srcy * info->src_pitch));
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_set_epi32((int)src[(posx + 3 * incx) >> 16], (int)src[(posx + 2 * incx) >> 16],
+                                  (int)src[(posx + incx) >> 16], (int)src[posx >> 16]);
+            } else {
+                s = _mm_cvtsi32_si128((int)src[posx >> 16]);
+            }
+            posx += count * incx;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                __m128i d;
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2));
+                sl = SDL_Blit_Modulate_SSE2(sl, modulate);
+                sh = SDL_Blit_Modulate_SSE2(sh, modulate);
+                if (count == 4) {
+                    d = _mm_loadu_si128((const __m128i *)dst);
+                } else {
+                    d = _mm_cvtsi32_si128((int)*dst);
+                }
+                sl = SDL_Blit_Blend_SSE2(sl, _mm_unpacklo_epi8(d, zero), flags);
+                sh = SDL_Blit_Blend_SSE2(sh, _mm_unpackhi_epi8(d, zero), flags);
+                s = _mm_packus_epi16(sl, sh);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        posy += incy;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_BGRA8888_RGB888_Scale_SSE2(SDL_BlitInfo *info)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+    int srcy, posy, incy, incx;
+
+    srcy = 0;
+    posy = 0;
+    incy = (info->src_h << 16) / info->dst_h;
+    incx = (info->src_w << 16) / info->dst_w;
+
+    while (info->dst_h--) {
+        const Uint32 *src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        int posx = 0;
+        while (posy >= 0x10000L) {
+            ++srcy;
+            posy -= 0x10000L;
+        }
+        src = (const Uint32 *)(info->src + (srcy * info->src_pitch));
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_set_epi32((int)src[(posx + 3 * incx) >> 16], (int)src[(posx + 2 * incx) >> 16],
+                                  (int)src[(posx + incx) >> 16], (int)src[posx >> 16]);
+            } else {
+                s = _mm_cvtsi32_si128((int)src[posx >> 16]);
+            }
+            posx += count * incx;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(0, 1, 2, 3)), _MM_SHUFFLE(0, 1, 2, 3));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(0, 1, 2, 3)), _MM_SHUFFLE(0, 1, 2, 3));
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        posy += incy;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_BGRA8888_RGB888_Blend_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_loadu_si128((const __m128i *)src);
+            } else {
+                s = _mm_cvtsi32_si128((int)*src);
+            }
+            src += count;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                __m128i d;
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(0, 1, 2, 3)), _MM_SHUFFLE(0, 1, 2, 3));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(0, 1, 2, 3)), _MM_SHUFFLE(0, 1, 2, 3));
+                if (count == 4) {
+                    d = _mm_loadu_si128((const __m128i *)dst);
+                } else {
+                    d = _mm_cvtsi32_si128((int)*dst);
+                }
+                sl = SDL_Blit_Blend_SSE2(sl, _mm_unpacklo_epi8(d, zero), flags);
+                sh = SDL_Blit_Blend_SSE2(sh, _mm_unpackhi_epi8(d, zero), flags);
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_BGRA8888_RGB888_Blend_Scale_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+    int srcy, posy, incy, incx;
+
+    srcy = 0;
+    posy = 0;
+    incy = (info->src_h << 16) / info->dst_h;
+    incx = (info->src_w << 16) / info->dst_w;
+
+    while (info->dst_h--) {
+        const Uint32 *src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        int posx = 0;
+        while (posy >= 0x10000L) {
+            ++srcy;
+            posy -= 0x10000L;
+        }
+        src = (const Uint32 *)(info->src + (srcy * info->src_pitch));
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_set_epi32((int)src[(posx + 3 * incx) >> 16], (int)src[(posx + 2 * incx) >> 16],
+                                  (int)src[(posx + incx) >> 16], (int)src[posx >> 16]);
+            } else {
+                s = _mm_cvtsi32_si128((int)src[posx >> 16]);
+            }
+            posx += count * incx;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                __m128i d;
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(0, 1, 2, 3)), _MM_SHUFFLE(0, 1, 2, 3));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(0, 1, 2, 3)), _MM_SHUFFLE(0, 1, 2, 3));
+                if (count == 4) {
+                    d = _mm_loadu_si128((const __m128i *)dst);
+                } else {
+                    d = _mm_cvtsi32_si128((int)*dst);
+                }
+                sl = SDL_Blit_Blend_SSE2(sl, _mm_unpacklo_epi8(d, zero), flags);
+                sh = SDL_Blit_Blend_SSE2(sh, _mm_unpackhi_epi8(d, zero), flags);
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        posy += incy;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_BGRA8888_RGB888_Modulate_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_loadu_si128((const __m128i *)src);
+            } else {
+                s = _mm_cvtsi32_si128((int)*src);
+            }
+            src += count;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(0, 1, 2, 3)), _MM_SHUFFLE(0, 1, 2, 3));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(0, 1, 2, 3)), _MM_SHUFFLE(0, 1, 2, 3));
+                sl = SDL_Blit_Modulate_SSE2(sl, modulate);
+                sh = SDL_Blit_Modulate_SSE2(sh, modulate);
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_BGRA8888_RGB888_Modulate_Scale_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+    int srcy, posy, incy, incx;
+
+    srcy = 0;
+    posy = 0;
+    incy = (info->src_h << 16) / info->dst_h;
+    incx = (info->src_w << 16) / info->dst_w;
+
+    while (info->dst_h--) {
+        const Uint32 *src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        int posx = 0;
+        while (posy >= 0x10000L) {
+            ++srcy;
+            posy -= 0x10000L;
+        }
+        src = (const Uint32 *)(info->src + (srcy * info->src_pitch));
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_set_epi32((int)src[(posx + 3 * incx) >> 16], (int)src[(posx + 2 * incx) >> 16],
+                                  (int)src[(posx + incx) >> 16], (int)src[posx >> 16]);
+            } else {
+                s = _mm_cvtsi32_si128((int)src[posx >> 16]);
+            }
+            posx += count * incx;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(0, 1, 2, 3)), _MM_SHUFFLE(0, 1, 2, 3));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(0, 1, 2, 3)), _MM_SHUFFLE(0, 1, 2, 3));
+                sl = SDL_Blit_Modulate_SSE2(sl, modulate);
+                sh = SDL_Blit_Modulate_SSE2(sh, modulate);
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        posy += incy;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_BGRA8888_RGB888_Modulate_Blend_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_loadu_si128((const __m128i *)src);
+            } else {
+                s = _mm_cvtsi32_si128((int)*src);
+            }
+            src += count;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                __m128i d;
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(0, 1, 2, 3)), _MM_SHUFFLE(0, 1, 2, 3));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(0, 1, 2, 3)), _MM_SHUFFLE(0, 1, 2, 3));
+                sl = SDL_Blit_Modulate_SSE2(sl, modulate);
+                sh = SDL_Blit_Modulate_SSE2(sh, modulate);
+                if (count == 4) {
+                    d = _mm_loadu_si128((const __m128i *)dst);
+                } else {
+                    d = _mm_cvtsi32_si128((int)*dst);
+                }
+                sl = SDL_Blit_Blend_SSE2(sl, _mm_unpacklo_epi8(d, zero), flags);
+                sh = SDL_Blit_Blend_SSE2(sh, _mm_unpackhi_epi8(d, zero), flags);
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_BGRA8888_RGB888_Modulate_Blend_Scale_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+    int srcy, posy, incy, incx;
+
+    srcy = 0;
+    posy = 0;
+    incy = (info->src_h << 16) / info->dst_h;
+    incx = (info->src_w << 16) / info->dst_w;
+
+    while (info->dst_h--) {
+        const Uint32 *src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        int posx = 0;
+        while (posy >= 0x10000L) {
+            ++srcy;
+            posy -= 0x10000L;
+        }
+        src = (const Uint32 *)(info->src + (srcy * info->src_pitch));
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_set_epi32((int)src[(posx + 3 * incx) >> 16], (int)src[(posx + 2 * incx) >> 16],
+                                  (int)src[(posx + incx) >> 16], (int)src[posx >> 16]);
+            } else {
+                s = _mm_cvtsi32_si128((int)src[posx >> 16]);
+            }
+            posx += count * incx;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                __m128i d;
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(0, 1, 2, 3)), _MM_SHUFFLE(0, 1, 2, 3));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(0, 1, 2, 3)), _MM_SHUFFLE(0, 1, 2, 3));
+                sl = SDL_Blit_Modulate_SSE2(sl, modulate);
+                sh = SDL_Blit_Modulate_SSE2(sh, modulate);
+                if (count == 4) {
+                    d = _mm_loadu_si128((const __m128i *)dst);
+                } else {
+                    d = _mm_cvtsi32_si128((int)*dst);
+                }
+                sl = SDL_Blit_Blend_SSE2(sl, _mm_unpacklo_epi8(d, zero), flags);
+                sh = SDL_Blit_Blend_SSE2(sh, _mm_unpackhi_epi8(d, zero), flags);
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        posy += incy;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_BGRA8888_BGR888_Scale_SSE2(SDL_BlitInfo *info)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+    int srcy, posy, incy, incx;
+
+    srcy = 0;
+    posy = 0;
+    incy = (info->src_h << 16) / info->dst_h;
+    incx = (info->src_w << 16) / info->dst_w;
+
+    while (info->dst_h--) {
+        const Uint32 *src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        int posx = 0;
+        while (posy >= 0x10000L) {
+            ++srcy;
+            posy -= 0x10000L;
+        }
+        src = (const Uint32 *)(info->src + (srcy * info->src_pitch));
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_set_epi32((int)src[(posx + 3 * incx) >> 16], (int)src[(posx + 2 * incx) >> 16],
+                                  (int)src[(posx + incx) >> 16], (int)src[posx >> 16]);
+            } else {
+                s = _mm_cvtsi32_si128((int)src[posx >> 16]);
+            }
+            posx += count * incx;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(0, 3, 2, 1)), _MM_SHUFFLE(0, 3, 2, 1));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(0, 3, 2, 1)), _MM_SHUFFLE(0, 3, 2, 1));
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        posy += incy;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_BGRA8888_BGR888_Blend_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_loadu_si128((const __m128i *)src);
+            } else {
+                s = _mm_cvtsi32_si128((int)*src);
+            }
+            src += count;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                __m128i d;
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(0, 3, 2, 1)), _MM_SHUFFLE(0, 3, 2, 1));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(0, 3, 2, 1)), _MM_SHUFFLE(0, 3, 2, 1));
+                if (count == 4) {
+                    d = _mm_loadu_si128((const __m128i *)dst);
+                } else {
+                    d = _mm_cvtsi32_si128((int)*dst);
+                }
+                sl = SDL_Blit_Blend_SSE2(sl, _mm_unpacklo_epi8(d, zero), flags);
+                sh = SDL_Blit_Blend_SSE2(sh, _mm_unpackhi_epi8(d, zero), flags);
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_BGRA8888_BGR888_Blend_Scale_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+    int srcy, posy, incy, incx;
+
+    srcy = 0;
+    posy = 0;
+    incy = (info->src_h << 16) / info->dst_h;
+    incx = (info->src_w << 16) / info->dst_w;
+
+    while (info->dst_h--) {
+        const Uint32 *src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        int posx = 0;
+        while (posy >= 0x10000L) {
+            ++srcy;
+            posy -= 0x10000L;
+        }
+        src = (const Uint32 *)(info->src + (srcy * info->src_pitch));
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_set_epi32((int)src[(posx + 3 * incx) >> 16], (int)src[(posx + 2 * incx) >> 16],
+                                  (int)src[(posx + incx) >> 16], (int)src[posx >> 16]);
+            } else {
+                s = _mm_cvtsi32_si128((int)src[posx >> 16]);
+            }
+            posx += count * incx;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                __m128i d;
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(0, 3, 2, 1)), _MM_SHUFFLE(0, 3, 2, 1));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(0, 3, 2, 1)), _MM_SHUFFLE(0, 3, 2, 1));
+                if (count == 4) {
+                    d = _mm_loadu_si128((const __m128i *)dst);
+                } else {
+                    d = _mm_cvtsi32_si128((int)*dst);
+                }
+                sl = SDL_Blit_Blend_SSE2(sl, _mm_unpacklo_epi8(d, zero), flags);
+                sh = SDL_Blit_Blend_SSE2(sh, _mm_unpackhi_epi8(d, zero), flags);
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        posy += incy;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_BGRA8888_BGR888_Modulate_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_loadu_si128((const __m128i *)src);
+            } else {
+                s = _mm_cvtsi32_si128((int)*src);
+            }
+            src += count;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(0, 3, 2, 1)), _MM_SHUFFLE(0, 3, 2, 1));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(0, 3, 2, 1)), _MM_SHUFFLE(0, 3, 2, 1));
+                sl = SDL_Blit_Modulate_SSE2(sl, modulate);
+                sh = SDL_Blit_Modulate_SSE2(sh, modulate);
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_BGRA8888_BGR888_Modulate_Scale_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+    int srcy, posy, incy, incx;
+
+    srcy = 0;
+    posy = 0;
+    incy = (info->src_h << 16) / info->dst_h;
+    incx = (info->src_w << 16) / info->dst_w;
+
+    while (info->dst_h--) {
+        const Uint32 *src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        int posx = 0;
+        while (posy >= 0x10000L) {
+            ++srcy;
+            posy -= 0x10000L;
+        }
+        src = (const Uint32 *)(info->src + (srcy * info->src_pitch));
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_set_epi32((int)src[(posx + 3 * incx) >> 16], (int)src[(posx + 2 * incx) >> 16],
+                                  (int)src[(posx + incx) >> 16], (int)src[posx >> 16]);
+            } else {
+                s = _mm_cvtsi32_si128((int)src[posx >> 16]);
+            }
+            posx += count * incx;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(0, 3, 2, 1)), _MM_SHUFFLE(0, 3, 2, 1));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(0, 3, 2, 1)), _MM_SHUFFLE(0, 3, 2, 1));
+                sl = SDL_Blit_Modulate_SSE2(sl, modulate);
+                sh = SDL_Blit_Modulate_SSE2(sh, modulate);
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        posy += incy;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_BGRA8888_BGR888_Modulate_Blend_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_loadu_si128((const __m128i *)src);
+            } else {
+                s = _mm_cvtsi32_si128((int)*src);
+            }
+            src += count;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                __m128i d;
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(0, 3, 2, 1)), _MM_SHUFFLE(0, 3, 2, 1));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(0, 3, 2, 1)), _MM_SHUFFLE(0, 3, 2, 1));
+                sl = SDL_Blit_Modulate_SSE2(sl, modulate);
+                sh = SDL_Blit_Modulate_SSE2(sh, modulate);
+                if (count == 4) {
+                    d = _mm_loadu_si128((const __m128i *)dst);
+                } else {
+                    d = _mm_cvtsi32_si128((int)*dst);
+                }
+                sl = SDL_Blit_Blend_SSE2(sl, _mm_unpacklo_epi8(d, zero), flags);
+                sh = SDL_Blit_Blend_SSE2(sh, _mm_unpackhi_epi8(d, zero), flags);
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_BGRA8888_BGR888_Modulate_Blend_Scale_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateB, modulateG, modulateR, modulateA, modulateB, modulateG, modulateR);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+    int srcy, posy, incy, incx;
+
+    srcy = 0;
+    posy = 0;
+    incy = (info->src_h << 16) / info->dst_h;
+    incx = (info->src_w << 16) / info->dst_w;
+
+    while (info->dst_h--) {
+        const Uint32 *src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        int posx = 0;
+        while (posy >= 0x10000L) {
+            ++srcy;
+            posy -= 0x10000L;
+        }
+        src = (const Uint32 *)(info->src + (srcy * info->src_pitch));
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_set_epi32((int)src[(posx + 3 * incx) >> 16], (int)src[(posx + 2 * incx) >> 16],
+                                  (int)src[(posx + incx) >> 16], (int)src[posx >> 16]);
+            } else {
+                s = _mm_cvtsi32_si128((int)src[posx >> 16]);
+            }
+            posx += count * incx;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                __m128i d;
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(0, 3, 2, 1)), _MM_SHUFFLE(0, 3, 2, 1));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(0, 3, 2, 1)), _MM_SHUFFLE(0, 3, 2, 1));
+                sl = SDL_Blit_Modulate_SSE2(sl, modulate);
+                sh = SDL_Blit_Modulate_SSE2(sh, modulate);
+                if (count == 4) {
+                    d = _mm_loadu_si128((const __m128i *)dst);
+                } else {
+                    d = _mm_cvtsi32_si128((int)*dst);
+                }
+                sl = SDL_Blit_Blend_SSE2(sl, _mm_unpacklo_epi8(d, zero), flags);
+                sh = SDL_Blit_Blend_SSE2(sh, _mm_unpackhi_epi8(d, zero), flags);
+                s = _mm_packus_epi16(sl, sh);
+                s = _mm_and_si128(s, rgbmask);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        posy += incy;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_BGRA8888_ARGB8888_Scale_SSE2(SDL_BlitInfo *info)
+{
+    const __m128i zero = _mm_setzero_si128();
+    int srcy, posy, incy, incx;
+
+    srcy = 0;
+    posy = 0;
+    incy = (info->src_h << 16) / info->dst_h;
+    incx = (info->src_w << 16) / info->dst_w;
+
+    while (info->dst_h--) {
+        const Uint32 *src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        int posx = 0;
+        while (posy >= 0x10000L) {
+            ++srcy;
+            posy -= 0x10000L;
+        }
+        src = (const Uint32 *)(info->src + (srcy * info->src_pitch));
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_set_epi32((int)src[(posx + 3 * incx) >> 16], (int)src[(posx + 2 * incx) >> 16],
+                                  (int)src[(posx + incx) >> 16], (int)src[posx >> 16]);
+            } else {
+                s = _mm_cvtsi32_si128((int)src[posx >> 16]);
+            }
+            posx += count * incx;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(0, 1, 2, 3)), _MM_SHUFFLE(0, 1, 2, 3));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(0, 1, 2, 3)), _MM_SHUFFLE(0, 1, 2, 3));
+                s = _mm_packus_epi16(sl, sh);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        posy += incy;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_BGRA8888_ARGB8888_Blend_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_loadu_si128((const __m128i *)src);
+            } else {
+                s = _mm_cvtsi32_si128((int)*src);
+            }
+            src += count;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                __m128i d;
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(0, 1, 2, 3)), _MM_SHUFFLE(0, 1, 2, 3));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(0, 1, 2, 3)), _MM_SHUFFLE(0, 1, 2, 3));
+                if (count == 4) {
+                    d = _mm_loadu_si128((const __m128i *)dst);
+                } else {
+                    d = _mm_cvtsi32_si128((int)*dst);
+                }
+                sl = SDL_Blit_Blend_SSE2(sl, _mm_unpacklo_epi8(d, zero), flags);
+                sh = SDL_Blit_Blend_SSE2(sh, _mm_unpackhi_epi8(d, zero), flags);
+                s = _mm_packus_epi16(sl, sh);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_BGRA8888_ARGB8888_Blend_Scale_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const __m128i zero = _mm_setzero_si128();
+    int srcy, posy, incy, incx;
+
+    srcy = 0;
+    posy = 0;
+    incy = (info->src_h << 16) / info->dst_h;
+    incx = (info->src_w << 16) / info->dst_w;
+
+    while (info->dst_h--) {
+        const Uint32 *src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        int posx = 0;
+        while (posy >= 0x10000L) {
+            ++srcy;
+            posy -= 0x10000L;
+        }
+        src = (const Uint32 *)(info->src + (srcy * info->src_pitch));
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_set_epi32((int)src[(posx + 3 * incx) >> 16], (int)src[(posx + 2 * incx) >> 16],
+                                  (int)src[(posx + incx) >> 16], (int)src[posx >> 16]);
+            } else {
+                s = _mm_cvtsi32_si128((int)src[posx >> 16]);
+            }
+            posx += count * incx;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                __m128i d;
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(0, 1, 2, 3)), _MM_SHUFFLE(0, 1, 2, 3));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(0, 1, 2, 3)), _MM_SHUFFLE(0, 1, 2, 3));
+                if (count == 4) {
+                    d = _mm_loadu_si128((const __m128i *)dst);
+                } else {
+                    d = _mm_cvtsi32_si128((int)*dst);
+                }
+                sl = SDL_Blit_Blend_SSE2(sl, _mm_unpacklo_epi8(d, zero), flags);
+                sh = SDL_Blit_Blend_SSE2(sh, _mm_unpackhi_epi8(d, zero), flags);
+                s = _mm_packus_epi16(sl, sh);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        posy += incy;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_BGRA8888_ARGB8888_Modulate_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB);
+    const __m128i zero = _mm_setzero_si128();
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_loadu_si128((const __m128i *)src);
+            } else {
+                s = _mm_cvtsi32_si128((int)*src);
+            }
+            src += count;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(0, 1, 2, 3)), _MM_SHUFFLE(0, 1, 2, 3));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(0, 1, 2, 3)), _MM_SHUFFLE(0, 1, 2, 3));
+                sl = SDL_Blit_Modulate_SSE2(sl, modulate);
+                sh = SDL_Blit_Modulate_SSE2(sh, modulate);
+                s = _mm_packus_epi16(sl, sh);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_BGRA8888_ARGB8888_Modulate_Scale_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB);
+    const __m128i zero = _mm_setzero_si128();
+    int srcy, posy, incy, incx;
+
+    srcy = 0;
+    posy = 0;
+    incy = (info->src_h << 16) / info->dst_h;
+    incx = (info->src_w << 16) / info->dst_w;
+
+    while (info->dst_h--) {
+        const Uint32 *src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        int posx = 0;
+        while (posy >= 0x10000L) {
+            ++srcy;
+            posy -= 0x10000L;
+        }
+        src = (const Uint32 *)(info->src + (srcy * info->src_pitch));
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_set_epi32((int)src[(posx + 3 * incx) >> 16], (int)src[(posx + 2 * incx) >> 16],
+                                  (int)src[(posx + incx) >> 16], (int)src[posx >> 16]);
+            } else {
+                s = _mm_cvtsi32_si128((int)src[posx >> 16]);
+            }
+            posx += count * incx;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(0, 1, 2, 3)), _MM_SHUFFLE(0, 1, 2, 3));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(0, 1, 2, 3)), _MM_SHUFFLE(0, 1, 2, 3));
+                sl = SDL_Blit_Modulate_SSE2(sl, modulate);
+                sh = SDL_Blit_Modulate_SSE2(sh, modulate);
+                s = _mm_packus_epi16(sl, sh);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        posy += incy;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_BGRA8888_ARGB8888_Modulate_Blend_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB);
+    const __m128i zero = _mm_setzero_si128();
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_loadu_si128((const __m128i *)src);
+            } else {
+                s = _mm_cvtsi32_si128((int)*src);
+            }
+            src += count;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                __m128i d;
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(0, 1, 2, 3)), _MM_SHUFFLE(0, 1, 2, 3));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(0, 1, 2, 3)), _MM_SHUFFLE(0, 1, 2, 3));
+                sl = SDL_Blit_Modulate_SSE2(sl, modulate);
+                sh = SDL_Blit_Modulate_SSE2(sh, modulate);
+                if (count == 4) {
+                    d = _mm_loadu_si128((const __m128i *)dst);
+                } else {
+                    d = _mm_cvtsi32_si128((int)*dst);
+                }
+                sl = SDL_Blit_Blend_SSE2(sl, _mm_unpacklo_epi8(d, zero), flags);
+                sh = SDL_Blit_Blend_SSE2(sh, _mm_unpackhi_epi8(d, zero), flags);
+                s = _mm_packus_epi16(sl, sh);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void SDL_Blit_BGRA8888_ARGB8888_Modulate_Blend_Scale_SSE2(SDL_BlitInfo *info)
+{
+    const int flags = info->flags;
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_set_epi16(modulateA, modulateR, modulateG, modulateB, modulateA, modulateR, modulateG, modulateB);
+    const __m128i zero = _mm_setzero_si128();
+    int srcy, posy, incy, incx;
+
+    srcy = 0;
+    posy = 0;
+    incy = (info->src_h << 16) / info->dst_h;
+    incx = (info->src_w << 16) / info->dst_w;
+
+    while (info->dst_h--) {
+        const Uint32 *src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        int posx = 0;
+        while (posy >= 0x10000L) {
+            ++srcy;
+            posy -= 0x10000L;
+        }
+        src = (const Uint32 *)(info->src + (srcy * info->src_pitch));
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_set_epi32((int)src[(posx + 3 * incx) >> 16], (int)src[(posx + 2 * incx) >> 16],
+                                  (int)src[(posx + incx) >> 16], (int)src[posx >> 16]);
+            } else {
+                s = _mm_cvtsi32_si128((int)src[posx >> 16]);
+            }
+            posx += count * incx;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+                __m128i d;
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, _MM_SHUFFLE(0, 1, 2, 3)), _MM_SHUFFLE(0, 1, 2, 3));
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, _MM_SHUFFLE(0, 1, 2, 3)), _MM_SHUFFLE(0, 1, 2, 3));
+                sl = SDL_Blit_Modulate_SSE2(sl, modulate);
+                sh = SDL_Blit_Modulate_SSE2(sh, modulate);
+                if (count == 4) {
+                    d = _mm_loadu_si128((const __m128i *)dst);
+                } else {
+                    d = _mm_cvtsi32_si128((int)*dst);
+                }
+                sl = SDL_Blit_Blend_SSE2(sl, _mm_unpacklo_epi8(d, zero), flags);
+                sh = SDL_Blit_Blend_SSE2(sh, _mm_unpackhi_epi8(d, zero), flags);
+                s = _mm_packus_epi16(sl, sh);
+            }
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+        posy += incy;
+        info->dst += info->dst_pitch;
+    }
+}
+
+#endif /* __SSE2__ */
+
 SDL_BlitFuncEntry SDL_GeneratedBlitFuncTable[] = {
+#ifdef __SSE2__
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_RGB888_RGB888_Scale_SSE2 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE2, SDL_Blit_RGB888_RGB888_Blend_SSE2 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_RGB888_RGB888_Blend_Scale_SSE2 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_SSE2, SDL_Blit_RGB888_RGB888_Modulate_SSE2 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_RGB888_RGB888_Modulate_Scale_SSE2 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE2, SDL_Blit_RGB888_RGB888_Modulate_Blend_SSE2 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_RGB888_RGB888_Modulate_Blend_Scale_SSE2 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_RGB888_BGR888_Scale_SSE2 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE2, SDL_Blit_RGB888_BGR888_Blend_SSE2 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_RGB888_BGR888_Blend_Scale_SSE2 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_SSE2, SDL_Blit_RGB888_BGR888_Modulate_SSE2 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_RGB888_BGR888_Modulate_Scale_SSE2 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE2, SDL_Blit_RGB888_BGR888_Modulate_Blend_SSE2 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_RGB888_BGR888_Modulate_Blend_Scale_SSE2 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_RGB888_ARGB8888_Scale_SSE2 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE2, SDL_Blit_RGB888_ARGB8888_Blend_SSE2 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_RGB888_ARGB8888_Blend_Scale_SSE2 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_SSE2, SDL_Blit_RGB888_ARGB8888_Modulate_SSE2 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_RGB888_ARGB8888_Modulate_Scale_SSE2 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE2, SDL_Blit_RGB888_ARGB8888_Modulate_Blend_SSE2 },
+    { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_RGB888_ARGB8888_Modulate_Blend_Scale_SSE2 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_BGR888_RGB888_Scale_SSE2 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE2, SDL_Blit_BGR888_RGB888_Blend_SSE2 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_BGR888_RGB888_Blend_Scale_SSE2 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_SSE2, SDL_Blit_BGR888_RGB888_Modulate_SSE2 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_BGR888_RGB888_Modulate_Scale_SSE2 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE2, SDL_Blit_BGR888_RGB888_Modulate_Blend_SSE2 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_BGR888_RGB888_Modulate_Blend_Scale_SSE2 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_BGR888_BGR888_Scale_SSE2 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE2, SDL_Blit_BGR888_BGR888_Blend_SSE2 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_BGR888_BGR888_Blend_Scale_SSE2 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_SSE2, SDL_Blit_BGR888_BGR888_Modulate_SSE2 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_BGR888_BGR888_Modulate_Scale_SSE2 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE2, SDL_Blit_BGR888_BGR888_Modulate_Blend_SSE2 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_BGR888_BGR888_Modulate_Blend_Scale_SSE2 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_BGR888_ARGB8888_Scale_SSE2 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE2, SDL_Blit_BGR888_ARGB8888_Blend_SSE2 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_BGR888_ARGB8888_Blend_Scale_SSE2 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_SSE2, SDL_Blit_BGR888_ARGB8888_Modulate_SSE2 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_BGR888_ARGB8888_Modulate_Scale_SSE2 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE2, SDL_Blit_BGR888_ARGB8888_Modulate_Blend_SSE2 },
+    { SDL_PIXELFORMAT_BGR888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_BGR888_ARGB8888_Modulate_Blend_Scale_SSE2 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_ARGB8888_RGB888_Scale_SSE2 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE2, SDL_Blit_ARGB8888_RGB888_Blend_SSE2 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_ARGB8888_RGB888_Blend_Scale_SSE2 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_SSE2, SDL_Blit_ARGB8888_RGB888_Modulate_SSE2 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_ARGB8888_RGB888_Modulate_Scale_SSE2 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE2, SDL_Blit_ARGB8888_RGB888_Modulate_Blend_SSE2 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_ARGB8888_RGB888_Modulate_Blend_Scale_SSE2 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_ARGB8888_BGR888_Scale_SSE2 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE2, SDL_Blit_ARGB8888_BGR888_Blend_SSE2 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_ARGB8888_BGR888_Blend_Scale_SSE2 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_SSE2, SDL_Blit_ARGB8888_BGR888_Modulate_SSE2 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_ARGB8888_BGR888_Modulate_Scale_SSE2 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE2, SDL_Blit_ARGB8888_BGR888_Modulate_Blend_SSE2 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_ARGB8888_BGR888_Modulate_Blend_Scale_SSE2 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_ARGB8888_ARGB8888_Scale_SSE2 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE2, SDL_Blit_ARGB8888_ARGB8888_Blend_SSE2 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_ARGB8888_ARGB8888_Blend_Scale_SSE2 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_SSE2, SDL_Blit_ARGB8888_ARGB8888_Modulate_SSE2 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_ARGB8888_ARGB8888_Modulate_Scale_SSE2 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE2, SDL_Blit_ARGB8888_ARGB8888_Modulate_Blend_SSE2 },
+    { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_ARGB8888_ARGB8888_Modulate_Blend_Scale_SSE2 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_RGBA8888_RGB888_Scale_SSE2 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE2, SDL_Blit_RGBA8888_RGB888_Blend_SSE2 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_RGBA8888_RGB888_Blend_Scale_SSE2 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_SSE2, SDL_Blit_RGBA8888_RGB888_Modulate_SSE2 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_RGBA8888_RGB888_Modulate_Scale_SSE2 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE2, SDL_Blit_RGBA8888_RGB888_Modulate_Blend_SSE2 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_RGBA8888_RGB888_Modulate_Blend_Scale_SSE2 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_RGBA8888_BGR888_Scale_SSE2 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE2, SDL_Blit_RGBA8888_BGR888_Blend_SSE2 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_RGBA8888_BGR888_Blend_Scale_SSE2 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_SSE2, SDL_Blit_RGBA8888_BGR888_Modulate_SSE2 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_RGBA8888_BGR888_Modulate_Scale_SSE2 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE2, SDL_Blit_RGBA8888_BGR888_Modulate_Blend_SSE2 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_RGBA8888_BGR888_Modulate_Blend_Scale_SSE2 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_RGBA8888_ARGB8888_Scale_SSE2 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE2, SDL_Blit_RGBA8888_ARGB8888_Blend_SSE2 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_RGBA8888_ARGB8888_Blend_Scale_SSE2 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_SSE2, SDL_Blit_RGBA8888_ARGB8888_Modulate_SSE2 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_RGBA8888_ARGB8888_Modulate_Scale_SSE2 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE2, SDL_Blit_RGBA8888_ARGB8888_Modulate_Blend_SSE2 },
+    { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_RGBA8888_ARGB8888_Modulate_Blend_Scale_SSE2 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_ABGR8888_RGB888_Scale_SSE2 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE2, SDL_Blit_ABGR8888_RGB888_Blend_SSE2 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_ABGR8888_RGB888_Blend_Scale_SSE2 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_SSE2, SDL_Blit_ABGR8888_RGB888_Modulate_SSE2 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_ABGR8888_RGB888_Modulate_Scale_SSE2 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE2, SDL_Blit_ABGR8888_RGB888_Modulate_Blend_SSE2 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_ABGR8888_RGB888_Modulate_Blend_Scale_SSE2 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_ABGR8888_BGR888_Scale_SSE2 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE2, SDL_Blit_ABGR8888_BGR888_Blend_SSE2 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_ABGR8888_BGR888_Blend_Scale_SSE2 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_SSE2, SDL_Blit_ABGR8888_BGR888_Modulate_SSE2 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_ABGR8888_BGR888_Modulate_Scale_SSE2 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE2, SDL_Blit_ABGR8888_BGR888_Modulate_Blend_SSE2 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_ABGR8888_BGR888_Modulate_Blend_Scale_SSE2 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_ABGR8888_ARGB8888_Scale_SSE2 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE2, SDL_Blit_ABGR8888_ARGB8888_Blend_SSE2 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_ABGR8888_ARGB8888_Blend_Scale_SSE2 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_SSE2, SDL_Blit_ABGR8888_ARGB8888_Modulate_SSE2 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_ABGR8888_ARGB8888_Modulate_Scale_SSE2 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE2, SDL_Blit_ABGR8888_ARGB8888_Modulate_Blend_SSE2 },
+    { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_ABGR8888_ARGB8888_Modulate_Blend_Scale_SSE2 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_BGRA8888_RGB888_Scale_SSE2 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE2, SDL_Blit_BGRA8888_RGB888_Blend_SSE2 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_BGRA8888_RGB888_Blend_Scale_SSE2 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_SSE2, SDL_Blit_BGRA8888_RGB888_Modulate_SSE2 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_BGRA8888_RGB888_Modulate_Scale_SSE2 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE2, SDL_Blit_BGRA8888_RGB888_Modulate_Blend_SSE2 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_BGRA8888_RGB888_Modulate_Blend_Scale_SSE2 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_BGRA8888_BGR888_Scale_SSE2 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE2, SDL_Blit_BGRA8888_BGR888_Blend_SSE2 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_BGRA8888_BGR888_Blend_Scale_SSE2 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_SSE2, SDL_Blit_BGRA8888_BGR888_Modulate_SSE2 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_BGRA8888_BGR888_Modulate_Scale_SSE2 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE2, SDL_Blit_BGRA8888_BGR888_Modulate_Blend_SSE2 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_BGR888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_BGRA8888_BGR888_Modulate_Blend_Scale_SSE2 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_BGRA8888_ARGB8888_Scale_SSE2 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE2, SDL_Blit_BGRA8888_ARGB8888_Blend_SSE2 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_BGRA8888_ARGB8888_Blend_Scale_SSE2 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA), SDL_CPU_SSE2, SDL_Blit_BGRA8888_ARGB8888_Modulate_SSE2 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_BGRA8888_ARGB8888_Modulate_Scale_SSE2 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_SSE2, SDL_Blit_BGRA8888_ARGB8888_Modulate_Blend_SSE2 },
+    { SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_ARGB8888, (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_SSE2, SDL_Blit_BGRA8888_ARGB8888_Modulate_Blend_Scale_SSE2 },
+#endif /* __SSE2__ */
     { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_RGB888_RGB888_Scale },
     { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD), SDL_CPU_ANY, SDL_Blit_RGB888_RGB888_Blend },
     { SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_NEAREST), SDL_CPU_ANY, SDL_Blit_RGB888_RGB888_Blend_Scale },
@@ -28,7 +28,7 @@
 #ifdef __SSE__
 /* This assumes 16-byte aligned src and dst */
 static SDL_INLINE void
-SDL_memcpySSE(Uint8 * dst, const Uint8 * src, int len)
+SDL_memcpySSE(Uint8 * dst, const Uint8 * src, int len, SDL_bool stream)
 {
     int i;
 
@@ -39,10 +39,17 @@ SDL_memcpySSE(Uint8 * dst, const Uint8 * src, int len)
         values[1] = *(__m128 *) (src + 16);
         values[2] = *(__m128 *) (src + 32);
         values[3] = *(__m128 *) (src + 48);
-        _mm_stream_ps((float *) (dst + 0), values[0]);
-        _mm_stream_ps((float *) (dst + 16), values[1]);
-        _mm_stream_ps((float *) (dst + 32), values[2]);
-        _mm_stream_ps((float *) (dst + 48), values[3]);
+        if (stream) {
+            _mm_stream_ps((float *) (dst + 0), values[0]);
+            _mm_stream_ps((float *) (dst + 16), values[1]);
+            _mm_stream_ps((float *) (dst + 32), values[2]);
+            _mm_stream_ps((float *) (dst + 48), values[3]);
+        } else {
+            _mm_store_ps((float *) (dst + 0), values[0]);
+            _mm_store_ps((float *) (dst + 16), values[1]);
+            _mm_store_ps((float *) (dst + 32), values[2]);
+            _mm_store_ps((float *) (dst + 48), values[3]);
+        }
         src += 64;
         dst += 64;
     }
@@ -52,6 +59,120 @@ SDL_memcpySSE(Uint8 * dst, const Uint8 * src, int len)
 }
 #endif /* __SSE__ */
 
+#ifdef SDL_AVX2_INTRINSICS
+/* Stream 4 bytes at a time from a source of any alignment */
+static SDL_INLINE void SDL_TARGETING_AVX2
+SDL_stream32(Uint8 * dst, const Uint8 * src)
+{
+    int value;
+    SDL_memcpy(&value, src, sizeof (value));
+    _mm_stream_si32((int *) dst, value);
+}
+
+/* Copy 128 bytes at a time.  Cached stores are lined up with 32 bytes, and
+   the unaligned ends are done with overlapping stores.  Non-temporal stores
+   cover the whole row, down to 4 bytes at a time, so that the cache lines
+   shared by the end of one row and the start of the next aren't read back
+   in. */
+static SDL_INLINE void SDL_TARGETING_AVX2
+SDL_memcpyAVX2(Uint8 * dst, const Uint8 * src, int len, SDL_bool stream)
+{
+    const Uint8 *src_end = src + len;
+    Uint8 *dst_end = dst + len;
+    __m256i values[4];
+    int i, adjust;
+
+    if (len < 32) {
+        SDL_memcpy(dst, src, len);
+        return;
+    }
+
+    if (stream) {
+        adjust = (int) (-(intptr_t) dst & 3);
+        SDL_memcpy(dst, src, adjust);
+        src += adjust;
+        dst += adjust;
+        len -= adjust;
+        for (; ((intptr_t) dst & 31) && len >= 4; len -= 4) {
+            SDL_stream32(dst, src);
+            src += 4;
+            dst += 4;
+        }
+        for (i = len / 128; i--;) {
+            values[0] = _mm256_loadu_si256((const __m256i *) (src + 0));
+            values[1] = _mm256_loadu_si256((const __m256i *) (src + 32));
+            values[2] = _mm256_loadu_si256((const __m256i *) (src + 64));
+            values[3] = _mm256_loadu_si256((const __m256i *) (src + 96));
+            _mm256_stream_si256((__m256i *) (dst + 0), values[0]);
+            _mm256_stream_si256((__m256i *) (dst + 32), values[1]);
+            _mm256_stream_si256((__m256i *) (dst + 64), values[2]);
+            _mm256_stream_si256((__m256i *) (dst + 96), values[3]);
+            src += 128;
+            dst += 128;
+        }
+        for (len &= 127; len >= 32; len -= 32) {
+            _mm256_stream_si256((__m256i *) dst, _mm256_loadu_si256((const __m256i *) src));
+            src += 32;
+            dst += 32;
+        }
+        for (; len >= 4; len -= 4) {
+            SDL_stream32(dst, src);
+            src += 4;
+            dst += 4;
+        }
+        SDL_memcpy(dst, src, len);
+        return;
+    }
+
+    adjust = (int) (-(intptr_t) dst & 31);
+    if (len - adjust >= 128) {
+        if (adjust > 0) {
+            _mm256_storeu_si256((__m256i *) dst, _mm256_loadu_si256((const __m256i *) src));
+        }
+        src += adjust;
+        dst += adjust;
+        len -= adjust;
+        for (i = len / 128; i--;) {
+            values[0] = _mm256_loadu_si256((const __m256i *) (src + 0));
+            values[1] = _mm256_loadu_si256((const __m256i *) (src + 32));
+            values[2] = _mm256_loadu_si256((const __m256i *) (src + 64));
+            values[3] = _mm256_loadu_si256((const __m256i *) (src + 96));
+            _mm256_store_si256((__m256i *) (dst + 0), values[0]);
+            _mm256_store_si256((__m256i *) (dst + 32), values[1]);
+            _mm256_store_si256((__m256i *) (dst + 64), values[2]);
+            _mm256_store_si256((__m256i *) (dst + 96), values[3]);
+            src += 128;
+            dst += 128;
+        }
+        len &= 127;
+    }
+    for (; len >= 32; len -= 32) {
+        _mm256_storeu_si256((__m256i *) dst, _mm256_loadu_si256((const __m256i *) src));
+        src += 32;
+        dst += 32;
+    }
+    if (len > 0) {
+        _mm256_storeu_si256((__m256i *) (dst_end - 32),
+                            _mm256_loadu_si256((const __m256i *) (src_end - 32)));
+    }
+}
+
+/* Every row, and the fence after streaming them, built for AVX2 */
+static void SDL_TARGETING_AVX2
+SDL_BlitCopyAVX2(Uint8 * dst, int dstskip, const Uint8 * src, int srcskip,
+                 int w, int h, SDL_bool stream)
+{
+    while (h--) {
+        SDL_memcpyAVX2(dst, src, w, stream);
+        src += srcskip;
+        dst += dstskip;
+    }
+    if (stream) {
+        _mm_sfence();
+    }
+}
+#endif /* SDL_AVX2_INTRINSICS */
+
 #ifdef __MMX__
 #ifdef _MSC_VER
 #pragma warning(disable:4799)
@@ -91,6 +212,7 @@ void
 SDL_BlitCopy(SDL_BlitInfo * info)
 {
     SDL_bool overlap;
+    SDL_bool stream;
     Uint8 *src, *dst;
     int w, h;
     int srcskip, dstskip;
@@ -117,15 +239,30 @@ SDL_BlitCopy(SDL_BlitInfo * info)
         return;
     }
 
+    /* Copies too big for the cache go around it */
+    stream = ((size_t) w * h >= SDL_BLIT_NONTEMPORAL_BYTES);
+
+#ifdef SDL_AVX2_INTRINSICS
+    if (SDL_HasAVX2()) {
+        SDL_BlitCopyAVX2(dst, dstskip, src, srcskip, w, h, stream);
+        return;
+    }
+#endif
+
 #ifdef __SSE__
+    /* Rows that start on 16 byte boundaries in both surfaces, as they do in
+       surfaces created with SDL_HINT_SURFACE_ALIGNMENT, need no lining up */
     if (SDL_HasSSE() &&
         !((uintptr_t) src & 15) && !(srcskip & 15) &&
         !((uintptr_t) dst & 15) && !(dstskip & 15)) {
         while (h--) {
-            SDL_memcpySSE(dst, src, w);
+            SDL_memcpySSE(dst, src, w, stream);
             src += srcskip;
             dst += dstskip;
         }
+        if (stream) {
+            _mm_sfence();
+        }
         return;
     }
 #endif
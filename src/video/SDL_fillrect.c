@@ -46,15 +46,28 @@
 #endif
 
 #define SSE_WORK \
-    for (i = n / 64; i--;) { \
-        _mm_stream_ps((float *)(p+0), c128); \
-        _mm_stream_ps((float *)(p+16), c128); \
-        _mm_stream_ps((float *)(p+32), c128); \
-        _mm_stream_ps((float *)(p+48), c128); \
-        p += 64; \
+    if (stream) { \
+        for (i = n / 64; i--;) { \
+            _mm_stream_ps((float *)(p+0), c128); \
+            _mm_stream_ps((float *)(p+16), c128); \
+            _mm_stream_ps((float *)(p+32), c128); \
+            _mm_stream_ps((float *)(p+48), c128); \
+            p += 64; \
+        } \
+    } else { \
+        for (i = n / 64; i--;) { \
+            _mm_store_ps((float *)(p+0), c128); \
+            _mm_store_ps((float *)(p+16), c128); \
+            _mm_store_ps((float *)(p+32), c128); \
+            _mm_store_ps((float *)(p+48), c128); \
+            p += 64; \
+        } \
     }
 
-#define SSE_END
+#define SSE_END \
+    if (stream) { \
+        _mm_sfence(); \
+    }
 
 #define DEFINE_SSE_FILLRECT(bpp, type) \
 static void \
@@ -62,6 +75,7 @@ SDL_FillRect##bpp##SSE(Uint8 *pixels, int pitch, Uint32 color, int w, int h) \
 { \
     int i, n; \
     Uint8 *p = NULL; \
+    const SDL_bool stream = ((size_t) w * bpp * h >= SDL_BLIT_NONTEMPORAL_BYTES); \
  \
     SSE_BEGIN; \
  \
@@ -99,6 +113,7 @@ static void
 SDL_FillRect1SSE(Uint8 *pixels, int pitch, Uint32 color, int w, int h)
 {
     int i, n;
+    const SDL_bool stream = ((size_t) w * h >= SDL_BLIT_NONTEMPORAL_BYTES);
 
     SSE_BEGIN;
     while (h--) {
@@ -130,6 +145,109 @@ DEFINE_SSE_FILLRECT(4, Uint32)
 /* *INDENT-ON* */
 #endif /* __SSE__ */
 
+#ifdef SDL_AVX2_INTRINSICS
+/* Fill n bytes of 1, 2 or 4 byte pixels, with the color repeated to 32 bits */
+static SDL_INLINE void
+SDL_FillBytes(Uint8 * p, Uint32 color, int bpp, int n)
+{
+    switch (bpp) {
+    case 1:
+        SDL_memset(p, color, n);
+        break;
+    case 2:
+        for (n /= 2; n--; p += 2) {
+            *(Uint16 *) p = (Uint16) color;
+        }
+        break;
+    case 4:
+        SDL_memset4(p, color, n / 4);
+        break;
+    }
+}
+
+/* Fill 1, 2 or 4 byte pixels 128 bytes at a time.  Cached stores are lined
+   up with 32 bytes where the pixels allow it, and the unaligned ends are done
+   with overlapping stores.  Non-temporal stores cover the whole row, down to
+   4 bytes at a time, so that the cache lines shared by the end of one row and
+   the start of the next aren't read back in. */
+static void SDL_TARGETING_AVX2
+SDL_FillRectAVX2(Uint8 * pixels, int pitch, Uint32 color, int bpp, int w, int h)
+{
+    const __m256i c256 = _mm256_set1_epi32((int) color);
+    SDL_bool stream = ((size_t) w * bpp * h >= SDL_BLIT_NONTEMPORAL_BYTES);
+    int i, n, adjust;
+    Uint8 *p, *end;
+
+    /* Pixels that straddle 4 byte boundaries can't be streamed */
+    if (((intptr_t) pixels | pitch) & (bpp - 1)) {
+        stream = SDL_FALSE;
+    }
+
+    while (h--) {
+        p = pixels;
+        n = w * bpp;
+        pixels += pitch;
+
+        if (n < 32) {
+            SDL_FillBytes(p, color, bpp, n);
+            continue;
+        }
+
+        if (stream) {
+            adjust = (int) (-(intptr_t) p & 3);
+            SDL_FillBytes(p, color, bpp, adjust);
+            p += adjust;
+            n -= adjust;
+            for (; ((intptr_t) p & 31) && n >= 4; n -= 4, p += 4) {
+                _mm_stream_si32((int *) p, (int) color);
+            }
+            for (i = n / 128; i--; p += 128) {
+                _mm256_stream_si256((__m256i *) (p + 0), c256);
+                _mm256_stream_si256((__m256i *) (p + 32), c256);
+                _mm256_stream_si256((__m256i *) (p + 64), c256);
+                _mm256_stream_si256((__m256i *) (p + 96), c256);
+            }
+            for (n &= 127; n >= 32; n -= 32, p += 32) {
+                _mm256_stream_si256((__m256i *) p, c256);
+            }
+            for (; n >= 4; n -= 4, p += 4) {
+                _mm_stream_si32((int *) p, (int) color);
+            }
+            SDL_FillBytes(p, color, bpp, n);
+            continue;
+        }
+
+        end = p + n;
+        adjust = (int) (-(intptr_t) p & 31);
+        if ((adjust % bpp) == 0 && n - adjust >= 128) {
+            if (adjust > 0) {
+                _mm256_storeu_si256((__m256i *) p, c256);
+            }
+            p += adjust;
+            n -= adjust;
+            for (i = n / 128; i--; p += 128) {
+                _mm256_store_si256((__m256i *) (p + 0), c256);
+                _mm256_store_si256((__m256i *) (p + 32), c256);
+                _mm256_store_si256((__m256i *) (p + 64), c256);
+                _mm256_store_si256((__m256i *) (p + 96), c256);
+            }
+            n &= 127;
+        }
+
+        /* The rest, including rows whose pixels straddle 32 byte boundaries */
+        for (; n >= 32; n -= 32, p += 32) {
+            _mm256_storeu_si256((__m256i *) p, c256);
+        }
+        if (n > 0) {
+            _mm256_storeu_si256((__m256i *) (end - 32), c256);
+        }
+    }
+    if (stream) {
+        _mm_sfence();
+    }
+}
+#endif /* SDL_AVX2_INTRINSICS */
+
 static void
 SDL_FillRect1(Uint8 * pixels, int pitch, Uint32 color, int w, int h)
 {
@@ -266,6 +384,12 @@ SDL_FillRect(SDL_Surface * dst, const SDL_Rect * rect, Uint32 color)
         {
             color |= (color << 8);
             color |= (color << 16);
+#ifdef SDL_AVX2_INTRINSICS
+            if (SDL_HasAVX2()) {
+                SDL_FillRectAVX2(pixels, dst->pitch, color, 1, rect->w, rect->h);
+                break;
+            }
+#endif
 #ifdef __SSE__
             if (SDL_HasSSE()) {
                 SDL_FillRect1SSE(pixels, dst->pitch, color, rect->w, rect->h);
@@ -279,6 +403,12 @@ SDL_FillRect(SDL_Surface * dst, const SDL_Rect * rect, Uint32 color)
     case 2:
         {
             color |= (color << 16);
+#ifdef SDL_AVX2_INTRINSICS
+            if (SDL_HasAVX2()) {
+                SDL_FillRectAVX2(pixels, dst->pitch, color, 2, rect->w, rect->h);
+                break;
+            }
+#endif
 #ifdef __SSE__
             if (SDL_HasSSE()) {
                 SDL_FillRect2SSE(pixels, dst->pitch, color, rect->w, rect->h);
@@ -298,6 +428,12 @@ SDL_FillRect(SDL_Surface * dst, const SDL_Rect * rect, Uint32 color)
 
     case 4:
         {
+#ifdef SDL_AVX2_INTRINSICS
+            if (SDL_HasAVX2()) {
+                SDL_FillRectAVX2(pixels, dst->pitch, color, 4, rect->w, rect->h);
+                break;
+            }
+#endif
 #ifdef __SSE__
             if (SDL_HasSSE()) {
                 SDL_FillRect4SSE(pixels, dst->pitch, color, rect->w, rect->h);
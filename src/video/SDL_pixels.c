@@ -23,6 +23,8 @@
 /* General (mostly internal) pixel/color manipulation routines for SDL */
 
 #include "SDL_endian.h"
+#include "SDL_atomic.h"
+#include "SDL_hints.h"
 #include "SDL_video.h"
 #include "SDL_sysvideo.h"
 #include "SDL_blit.h"
@@ -122,6 +124,8 @@ SDL_GetPixelFormatName(Uint32 format)
     CASE(SDL_PIXELFORMAT_YUY2)
     CASE(SDL_PIXELFORMAT_UYVY)
     CASE(SDL_PIXELFORMAT_YVYU)
+    CASE(SDL_PIXELFORMAT_NV12)
+    CASE(SDL_PIXELFORMAT_NV21)
 #undef CASE
     default:
         return "SDL_PIXELFORMAT_UNKNOWN";
@@ -611,6 +615,273 @@ SDL_FreeFormat(SDL_PixelFormat *format)
     SDL_free(format);
 }
 
+/*
+ * Palettes allocated by SDL_AllocPalette() get a cache that speeds up
+ * matching colors against them.  It holds the color indices sorted by
+ * green, so a search can start at the green of the color it's looking
+ * for and stop once the green difference alone is further away than the
+ * best match so far, and on demand a 5:5:5 inverse colormap holding the
+ * closest color to each cell, which blits to 8-bit surfaces index
+ * directly and which gives searches a good first guess.
+ *
+ * The cache is rebuilt whenever the palette version changes, so code
+ * that writes to the colors directly must bump the version, as it
+ * already has to for blit mappings to notice.
+ */
+#define SDL_PALETTE_CACHE_BUCKETS   64
+#define SDL_INVERSE_COLORMAP_SIZE   (1 << 15)
+
+/* An inverse colormap, shared by a palette's cache and the blit maps to
+   that palette, and freed when the last of them lets go of it */
+typedef struct SDL_InverseColormap
+{
+    SDL_atomic_t refcount;
+    Uint8 map[SDL_INVERSE_COLORMAP_SIZE];
+} SDL_InverseColormap;
+
+typedef struct SDL_PaletteCache
+{
+    SDL_Palette *palette;
+    Uint32 version;             /* 0 until the tables have been built */
+    SDL_Color *colors;
+    int ncolors;
+    Uint8 order[256];           /* color indices sorted by green */
+    Uint16 first[256];          /* first position in order with this green or more */
+    SDL_InverseColormap *inverse;   /* NULL until a blit map needs it */
+    struct SDL_PaletteCache *next;
+} SDL_PaletteCache;
+
+static SDL_PaletteCache *SDL_palette_caches[SDL_PALETTE_CACHE_BUCKETS];
+static SDL_SpinLock SDL_palette_cache_lock;
+
+#define SDL_PALETTE_CACHE_BUCKET(palette) \
+    (&SDL_palette_caches[((size_t) (palette) >> 4) % SDL_PALETTE_CACHE_BUCKETS])
+
+static void
+SDL_ReleaseInverseColormap(SDL_InverseColormap * colormap)
+{
+    if (colormap && SDL_AtomicDecRef(&colormap->refcount)) {
+        SDL_free(colormap);
+    }
+}
+
+/* The cache lock must be held when calling this */
+static SDL_PaletteCache **
+SDL_FindPaletteCache(const SDL_Palette * palette)
+{
+    SDL_PaletteCache **link;
+
+    link = SDL_PALETTE_CACHE_BUCKET(palette);
+    while (*link && (*link)->palette != palette) {
+        link = &(*link)->next;
+    }
+    return link;
+}
+
+static void
+SDL_AddPaletteCache(SDL_Palette * palette)
+{
+    SDL_PaletteCache *cache;
+    SDL_PaletteCache **link;
+
+    /* If this fails, matching colors just isn't accelerated */
+    cache = (SDL_PaletteCache *) SDL_calloc(1, sizeof(*cache));
+    if (!cache) {
+        return;
+    }
+    cache->palette = palette;
+
+    SDL_AtomicLock(&SDL_palette_cache_lock);
+    link = SDL_PALETTE_CACHE_BUCKET(palette);
+    cache->next = *link;
+    *link = cache;
+    SDL_AtomicUnlock(&SDL_palette_cache_lock);
+}
+
+static void
+SDL_RemovePaletteCache(SDL_Palette * palette)
+{
+    SDL_PaletteCache *cache;
+    SDL_PaletteCache **link;
+
+    SDL_AtomicLock(&SDL_palette_cache_lock);
+    link = SDL_FindPaletteCache(palette);
+    cache = *link;
+    if (cache) {
+        *link = cache->next;
+    }
+    SDL_AtomicUnlock(&SDL_palette_cache_lock);
+
+    if (cache) {
+        SDL_ReleaseInverseColormap(cache->inverse);
+        SDL_free(cache);
+    }
+}
+
+/* Bring the sorted colors up to date, returns SDL_FALSE if the palette
+   can't be handled by the cache.  The cache lock must be held. */
+static SDL_bool
+SDL_UpdatePaletteCache(SDL_PaletteCache * cache, const SDL_Palette * pal)
+{
+    int count[256];
+    int i, g, pos;
+
+    if (pal->ncolors < 1 || pal->ncolors > 256) {
+        return SDL_FALSE;
+    }
+    if (cache->version == pal->version &&
+        cache->colors == pal->colors && cache->ncolors == pal->ncolors) {
+        return SDL_TRUE;
+    }
+
+    /* Counting sort by green */
+    SDL_zero(count);
+    for (i = 0; i < pal->ncolors; ++i) {
+        ++count[pal->colors[i].g];
+    }
+    for (g = 0, pos = 0; g < 256; ++g) {
+        cache->first[g] = pos;
+        pos += count[g];
+        count[g] = cache->first[g];
+    }
+    for (i = 0; i < pal->ncolors; ++i) {
+        cache->order[count[pal->colors[i].g]++] = (Uint8) i;
+    }
+
+    cache->version = pal->version;
+    cache->colors = pal->colors;
+    cache->ncolors = pal->ncolors;
+    SDL_ReleaseInverseColormap(cache->inverse);
+    cache->inverse = NULL;
+    return SDL_TRUE;
+}
+
+/* Find exactly the color SDL_FindColor() would, starting from a guess */
+static Uint8
+SDL_SearchPaletteCache(const SDL_PaletteCache * cache,
+                       Uint8 r, Uint8 g, Uint8 b, Uint8 a, int guess)
+{
+    const SDL_Color *colors = cache->colors;
+    int smallest, distance;
+    int rd, gd, bd, ad;
+    int i, pos;
+    int pixel;
+
+    rd = colors[guess].r - r;
+    gd = colors[guess].g - g;
+    bd = colors[guess].b - b;
+    ad = colors[guess].a - a;
+    smallest = (rd * rd) + (gd * gd) + (bd * bd) + (ad * ad);
+    pixel = guess;
+
+    /* Walk outwards in green from the color we're looking for, until the
+       green difference alone is more than the best distance.  Ties go to
+       the lowest index, as they do for a linear search. */
+    for (pos = cache->first[g]; pos < cache->ncolors; ++pos) {
+        i = cache->order[pos];
+        gd = colors[i].g - g;
+        if (gd * gd > smallest) {
+            break;
+        }
+        rd = colors[i].r - r;
+        bd = colors[i].b - b;
+        ad = colors[i].a - a;
+        distance = (rd * rd) + (gd * gd) + (bd * bd) + (ad * ad);
+        if (distance < smallest || (distance == smallest && i < pixel)) {
+            smallest = distance;
+            pixel = i;
+        }
+    }
+    for (pos = cache->first[g] - 1; pos >= 0; --pos) {
+        i = cache->order[pos];
+        gd = colors[i].g - g;
+        if (gd * gd > smallest) {
+            break;
+        }
+        rd = colors[i].r - r;
+        bd = colors[i].b - b;
+        ad = colors[i].a - a;
+        distance = (rd * rd) + (gd * gd) + (bd * bd) + (ad * ad);
+        if (distance < smallest || (distance == smallest && i < pixel)) {
+            smallest = distance;
+            pixel = i;
+        }
+    }
+    return (Uint8) pixel;
+}
+
+/* Squared distance from a value to the nearest and furthest ends of a range */
+#define RANGE_DISTANCES(v, lo, hi, mind, maxd)                          \
+{                                                                       \
+    int dlo = (v) - (lo), dhi = (v) - (hi);                             \
+    mind += ((v) < (lo)) ? dlo * dlo : ((v) > (hi)) ? dhi * dhi : 0;    \
+    maxd += SDL_max(dlo * dlo, dhi * dhi);                              \
+}
+
+/* Fill in the opaque color closest to each color of a 5:5:5 colormap.
+   The cells are done in blocks of 4x4x4, each only searching the colors
+   that could be closest to something inside the block: those no further
+   from it than the furthest point of the block is from some color. */
+static void
+SDL_BuildInverseColormap(const SDL_Palette * pal, Uint8 * inverse)
+{
+    const Uint8 *expand = SDL_expand_byte[3];
+    const SDL_Color *colors = pal->colors;
+    const int ncolors = SDL_min(pal->ncolors, 256);
+    int mind[256], maxd;
+    Uint8 candidates[256];
+    int ncandidates;
+    int bound, smallest, distance;
+    int rd, gd, bd, ad;
+    int r, g, b, br, bg, bb;
+    int i, j;
+    Uint8 pixel;
+
+    for (br = 0; br < 32; br += 4) {
+        for (bg = 0; bg < 32; bg += 4) {
+            for (bb = 0; bb < 32; bb += 4) {
+                bound = 0x7FFFFFFF;
+                for (i = 0; i < ncolors; ++i) {
+                    ad = colors[i].a - SDL_ALPHA_OPAQUE;
+                    mind[i] = maxd = ad * ad;
+                    RANGE_DISTANCES(colors[i].r, expand[br], expand[br + 3], mind[i], maxd);
+                    RANGE_DISTANCES(colors[i].g, expand[bg], expand[bg + 3], mind[i], maxd);
+                    RANGE_DISTANCES(colors[i].b, expand[bb], expand[bb + 3], mind[i], maxd);
+                    bound = SDL_min(bound, maxd);
+                }
+                ncandidates = 0;
+                for (i = 0; i < ncolors; ++i) {
+                    if (mind[i] <= bound) {
+                        candidates[ncandidates++] = (Uint8) i;
+                    }
+                }
+
+                for (r = br; r < br + 4; ++r) {
+                    for (g = bg; g < bg + 4; ++g) {
+                        for (b = bb; b < bb + 4; ++b) {
+                            smallest = 0x7FFFFFFF;
+                            pixel = 0;
+                            for (j = 0; j < ncandidates; ++j) {
+                                i = candidates[j];
+                                rd = colors[i].r - expand[r];
+                                gd = colors[i].g - expand[g];
+                                bd = colors[i].b - expand[b];
+                                ad = colors[i].a - SDL_ALPHA_OPAQUE;
+                                distance = (rd * rd) + (gd * gd) + (bd * bd) + (ad * ad);
+                                if (distance < smallest) {
+                                    smallest = distance;
+                                    pixel = (Uint8) i;
+                                }
+                            }
+                            inverse[(r << 10) | (g << 5) | b] = pixel;
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
 SDL_Palette *
 SDL_AllocPalette(int ncolors)
 {
@@ -639,6 +910,8 @@ SDL_AllocPalette(int ncolors)
 
     SDL_memset(palette->colors, 0xFF, ncolors * sizeof(*palette->colors));
 
+    SDL_AddPaletteCache(palette);
+
     return palette;
 }
 
@@ -707,47 +980,37 @@ SDL_FreePalette(SDL_Palette * palette)
     if (--palette->refcount > 0) {
         return;
     }
+    SDL_RemovePaletteCache(palette);
     SDL_free(palette->colors);
     SDL_free(palette);
 }
 
 /*
- * Calculate an 8-bit (3 red, 3 green, 2 blue) dithered palette of colors
+ * Get the row alignment asked for by SDL_HINT_SURFACE_ALIGNMENT
  */
-void
-SDL_DitherColors(SDL_Color * colors, int bpp)
+int
+SDL_GetSurfaceAlignment(void)
 {
-    int i;
-    if (bpp != 8)
-        return;                 /* only 8bpp supported right now */
-
-    for (i = 0; i < 256; i++) {
-        int r, g, b;
-        /* map each bit field to the full [0, 255] interval,
-           so 0 is mapped to (0, 0, 0) and 255 to (255, 255, 255) */
-        r = i & 0xe0;
-        r |= r >> 3 | r >> 6;
-        colors[i].r = r;
-        g = (i << 3) & 0xe0;
-        g |= g >> 3 | g >> 6;
-        colors[i].g = g;
-        b = i & 0x3;
-        b |= b << 2;
-        b |= b << 4;
-        colors[i].b = b;
-        colors[i].a = SDL_ALPHA_OPAQUE;
+    const char *hint = SDL_GetHint(SDL_HINT_SURFACE_ALIGNMENT);
+    int alignment = hint ? SDL_atoi(hint) : 0;
+
+    /* Only powers of two are any use, and rows are always 4-byte aligned */
+    if (alignment <= 4 || alignment > SDL_SIMD_ALIGNMENT ||
+        (alignment & (alignment - 1))) {
+        return 4;
     }
+    return alignment;
 }
 
 /*
  * Calculate the pad-aligned scanline width of a surface
  */
 int
-SDL_CalculatePitch(SDL_Surface * surface)
+SDL_CalculatePitch(SDL_Surface * surface, int alignment)
 {
     int pitch;
 
-    /* Surface should be 4-byte aligned for speed */
+    /* Surface should be at least 4-byte aligned for speed */
     pitch = surface->w * surface->format->BytesPerPixel;
     switch (surface->format->BitsPerPixel) {
     case 1:
@@ -759,15 +1022,57 @@ SDL_CalculatePitch(SDL_Surface * surface)
     default:
         break;
     }
-    pitch = (pitch + 3) & ~3;   /* 4-byte aligning */
+    pitch = (pitch + alignment - 1) & ~(alignment - 1);
     return (pitch);
 }
 
+/*
+ * Allocate the pixels of a surface, aligned to SDL_SIMD_ALIGNMENT bytes if
+ * it's flagged as SDL_SIMD_ALIGNED.  The pointer that was really allocated
+ * is kept just before the pixels.
+ */
+int
+SDL_AllocSurfacePixels(SDL_Surface * surface)
+{
+    const size_t size = (size_t) surface->h * surface->pitch;
+    Uint8 *mem;
+
+    if (!(surface->flags & SDL_SIMD_ALIGNED)) {
+        surface->pixels = SDL_malloc(size);
+        if (!surface->pixels) {
+            return SDL_OutOfMemory();
+        }
+        return 0;
+    }
+
+    mem = (Uint8 *) SDL_malloc(size + sizeof(void *) + SDL_SIMD_ALIGNMENT - 1);
+    if (!mem) {
+        surface->pixels = NULL;
+        return SDL_OutOfMemory();
+    }
+    surface->pixels = (void *) (((uintptr_t) (mem + sizeof(void *)) +
+                                 SDL_SIMD_ALIGNMENT - 1) &
+                                ~(uintptr_t) (SDL_SIMD_ALIGNMENT - 1));
+    ((void **) surface->pixels)[-1] = mem;
+    return 0;
+}
+
+void
+SDL_FreeSurfacePixels(SDL_Surface * surface)
+{
+    if (surface->pixels && (surface->flags & SDL_SIMD_ALIGNED)) {
+        SDL_free(((void **) surface->pixels)[-1]);
+    } else {
+        SDL_free(surface->pixels);
+    }
+    surface->pixels = NULL;
+}
+
 /*
  * Match an RGB value to a particular palette index
  */
-Uint8
-SDL_FindColor(SDL_Palette * pal, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
+static Uint8
+SDL_FindColorLinear(const SDL_Palette * pal, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
 {
     /* Do colorspace distance matching */
     unsigned int smallest;
@@ -794,6 +1099,31 @@ SDL_FindColor(SDL_Palette * pal, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
     return (pixel);
 }
 
+Uint8
+SDL_FindColor(SDL_Palette * pal, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
+{
+    SDL_PaletteCache *cache;
+    int guess;
+    Uint8 pixel;
+
+    SDL_AtomicLock(&SDL_palette_cache_lock);
+    cache = *SDL_FindPaletteCache(pal);
+    if (cache && SDL_UpdatePaletteCache(cache, pal)) {
+        if (cache->inverse) {
+            RGB555_FROM_RGB(guess, r, g, b);
+            guess = cache->inverse->map[guess];
+        } else {
+            guess = cache->order[SDL_min(cache->first[g], cache->ncolors - 1)];
+        }
+        pixel = SDL_SearchPaletteCache(cache, r, g, b, a, guess);
+        SDL_AtomicUnlock(&SDL_palette_cache_lock);
+        return pixel;
+    }
+    SDL_AtomicUnlock(&SDL_palette_cache_lock);
+
+    return SDL_FindColorLinear(pal, r, g, b, a);
+}
+
 /* Find the opaque pixel value corresponding to an RGB triple */
 Uint32
 SDL_MapRGB(const SDL_PixelFormat * format, Uint8 r, Uint8 g, Uint8 b)
@@ -933,19 +1263,58 @@ Map1toN(SDL_PixelFormat * src, Uint8 Rmod, Uint8 Gmod, Uint8 Bmod, Uint8 Amod,
     return (map);
 }
 
-/* Map from BitField to Dithered-Palette to Palette */
-static Uint8 *
+/* Map from BitField to Palette, through a 5:5:5 inverse colormap indexed
+   with RGB555_FROM_RGB().  Palettes are usually blitted to many times, so
+   cached ones share a single colormap between all the maps to them. */
+static SDL_InverseColormap *
 MapNto1(SDL_PixelFormat * src, SDL_PixelFormat * dst, int *identical)
 {
-    /* Generate a 256 color dither palette */
-    SDL_Palette dithered;
-    SDL_Color colors[256];
     SDL_Palette *pal = dst->palette;
+    SDL_PaletteCache *cache;
+    SDL_InverseColormap *colormap = NULL;
+    SDL_bool cached = SDL_FALSE;
+    Uint32 version = 0;
+
+    *identical = 0;
+
+    SDL_AtomicLock(&SDL_palette_cache_lock);
+    cache = *SDL_FindPaletteCache(pal);
+    if (cache && SDL_UpdatePaletteCache(cache, pal)) {
+        colormap = cache->inverse;
+        if (colormap) {
+            SDL_AtomicIncRef(&colormap->refcount);
+        }
+        cached = SDL_TRUE;
+        version = cache->version;
+    }
+    SDL_AtomicUnlock(&SDL_palette_cache_lock);
+    if (colormap) {
+        return (colormap);
+    }
 
-    dithered.ncolors = 256;
-    SDL_DitherColors(colors, 8);
-    dithered.colors = colors;
-    return (Map1to1(&dithered, pal, identical));
+    /* Building it takes a while, so don't hold up other threads' color
+       matching meanwhile */
+    colormap = (SDL_InverseColormap *) SDL_malloc(sizeof(*colormap));
+    if (colormap == NULL) {
+        SDL_OutOfMemory();
+        return (NULL);
+    }
+    SDL_AtomicSet(&colormap->refcount, 1);
+    SDL_BuildInverseColormap(pal, colormap->map);
+
+    /* Keep it with the palette, unless another thread got there first or
+       the palette has changed since */
+    if (cached) {
+        SDL_AtomicLock(&SDL_palette_cache_lock);
+        cache = *SDL_FindPaletteCache(pal);
+        if (cache && SDL_UpdatePaletteCache(cache, pal) &&
+            cache->version == version && !cache->inverse) {
+            SDL_AtomicIncRef(&colormap->refcount);
+            cache->inverse = colormap;
+        }
+        SDL_AtomicUnlock(&SDL_palette_cache_lock);
+    }
+    return (colormap);
 }
 
 SDL_BlitMap *
@@ -983,7 +1352,12 @@ SDL_InvalidateMap(SDL_BlitMap * map)
     map->dst = NULL;
     map->src_palette_version = 0;
     map->dst_palette_version = 0;
-    SDL_free(map->info.table);
+    if (map->colormap) {
+        SDL_ReleaseInverseColormap(map->colormap);
+        map->colormap = NULL;
+    } else {
+        SDL_free(map->info.table);
+    }
     map->info.table = NULL;
 }
 
@@ -1029,12 +1403,11 @@ SDL_MapSurface(SDL_Surface * src, SDL_Surface * dst)
     } else {
         if (SDL_ISPIXELFORMAT_INDEXED(dstfmt->format)) {
             /* BitField --> Palette */
-            map->info.table = MapNto1(srcfmt, dstfmt, &map->identity);
-            if (!map->identity) {
-                if (map->info.table == NULL) {
-                    return (-1);
-                }
+            map->colormap = MapNto1(srcfmt, dstfmt, &map->identity);
+            if (map->colormap == NULL) {
+                return (-1);
             }
+            map->info.table = map->colormap->map;
             map->identity = 0;  /* Don't optimize to copy */
         } else {
             /* BitField --> BitField */
@@ -1078,6 +1451,7 @@ SDL_FreeBlitMap(SDL_BlitMap * map)
 {
     if (map) {
         SDL_InvalidateMap(map);
+        SDL_FreeSurface(map->scratch);
         SDL_free(map);
     }
 }
@@ -34,8 +34,10 @@ extern int SDL_MapSurface(SDL_Surface * src, SDL_Surface * dst);
 extern void SDL_FreeBlitMap(SDL_BlitMap * map);
 
 /* Miscellaneous functions */
-extern int SDL_CalculatePitch(SDL_Surface * surface);
-extern void SDL_DitherColors(SDL_Color * colors, int bpp);
+extern int SDL_GetSurfaceAlignment(void);
+extern int SDL_CalculatePitch(SDL_Surface * surface, int alignment);
+extern int SDL_AllocSurfacePixels(SDL_Surface * surface);
+extern void SDL_FreeSurfacePixels(SDL_Surface * surface);
 extern Uint8 SDL_FindColor(SDL_Palette * pal, Uint8 r, Uint8 g, Uint8 b, Uint8 a);
 
 /* vi: set ts=4 sw=4 expandtab: */
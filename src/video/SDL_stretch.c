@@ -28,125 +28,8 @@
 
 #include "SDL_video.h"
 #include "SDL_blit.h"
-
-/* This isn't ready for general consumption yet - it should be folded
-   into the general blitting mechanism.
-*/
-
-#if ((defined(_MFC_VER) && defined(_M_IX86)) || \
-     defined(__WATCOMC__) || \
-     (defined(__GNUC__) && defined(__i386__))) && SDL_ASSEMBLY_ROUTINES
-/* There's a bug with gcc 4.4.1 and -O2 where srcp doesn't get the correct
- * value after the first scanline.  FIXME? */
-/* #define USE_ASM_STRETCH */
-#endif
-
-#ifdef USE_ASM_STRETCH
-
-#ifdef HAVE_MPROTECT
-#include <sys/types.h>
-#include <sys/mman.h>
-#endif
-#ifdef __GNUC__
-#define PAGE_ALIGNED __attribute__((__aligned__(4096)))
-#else
-#define PAGE_ALIGNED
-#endif
-
-#if defined(_M_IX86) || defined(i386)
-#define PREFIX16    0x66
-#define STORE_BYTE  0xAA
-#define STORE_WORD  0xAB
-#define LOAD_BYTE   0xAC
-#define LOAD_WORD   0xAD
-#define RETURN      0xC3
-#else
-#error Need assembly opcodes for this architecture
-#endif
-
-static unsigned char copy_row[4096] PAGE_ALIGNED;
-
-static int
-generate_rowbytes(int src_w, int dst_w, int bpp)
-{
-    static struct
-    {
-        int bpp;
-        int src_w;
-        int dst_w;
-        int status;
-    } last;
-
-    int i;
-    int pos, inc;
-    unsigned char *eip, *fence;
-    unsigned char load, store;
-
-    /* See if we need to regenerate the copy buffer */
-    if ((src_w == last.src_w) && (dst_w == last.dst_w) && (bpp == last.bpp)) {
-        return (last.status);
-    }
-    last.bpp = bpp;
-    last.src_w = src_w;
-    last.dst_w = dst_w;
-    last.status = -1;
-
-    switch (bpp) {
-    case 1:
-        load = LOAD_BYTE;
-        store = STORE_BYTE;
-        break;
-    case 2:
-    case 4:
-        load = LOAD_WORD;
-        store = STORE_WORD;
-        break;
-    default:
-        return SDL_SetError("ASM stretch of %d bytes isn't supported\n", bpp);
-    }
-#ifdef HAVE_MPROTECT
-    /* Make the code writeable */
-    if (mprotect(copy_row, sizeof(copy_row), PROT_READ | PROT_WRITE) < 0) {
-        return SDL_SetError("Couldn't make copy buffer writeable");
-    }
-#endif
-    pos = 0x10000;
-    inc = (src_w << 16) / dst_w;
-    eip = copy_row;
-    fence = copy_row + sizeof(copy_row)-2;
-    for (i = 0; i < dst_w; ++i) {
-        while (pos >= 0x10000L) {
-            if (eip == fence) {
-                return -1;
-            }
-            if (bpp == 2) {
-                *eip++ = PREFIX16;
-            }
-            *eip++ = load;
-            pos -= 0x10000L;
-        }
-        if (eip == fence) {
-            return -1;
-        }
-        if (bpp == 2) {
-            *eip++ = PREFIX16;
-        }
-        *eip++ = store;
-        pos += inc;
-    }
-    *eip++ = RETURN;
-
-#ifdef HAVE_MPROTECT
-    /* Make the code executable but not writeable */
-    if (mprotect(copy_row, sizeof(copy_row), PROT_READ | PROT_EXEC) < 0) {
-        return SDL_SetError("Couldn't make copy buffer executable");
-    }
-#endif
-    last.status = 0;
-    return (0);
-}
-
-#endif /* USE_ASM_STRETCH */
+#include "SDL_stretch_c.h"
+#include "../thread/SDL_threadpool_c.h"
 
 #define DEFINE_COPY_ROW(name, type)         \
 static void name(type *src, int src_w, type *dst, int dst_w)    \
@@ -172,7 +55,6 @@ DEFINE_COPY_ROW(copy_row2, Uint16)
 DEFINE_COPY_ROW(copy_row4, Uint32)
 /* *INDENT-ON* */
 
-/* The ASM code doesn't handle 24-bpp stretch blits */
 static void
 copy_row3(Uint8 * src, int src_w, Uint8 * dst, int dst_w)
 {
@@ -196,34 +78,245 @@ copy_row3(Uint8 * src, int src_w, Uint8 * dst, int dst_w)
     }
 }
 
-/* Perform a stretch blit between two surfaces of the same format.
-   NOTE:  This function is not safe to call from multiple threads!
-*/
+/* Where a pixel of the destination samples a source span for filtering:
+   the two source pixels either side of its middle and the weight of the
+   second one, out of 256 */
+typedef struct
+{
+    int p0;
+    int p1;
+    int weight;
+} SDL_StretchSample;
+
+static void
+SDL_GetStretchSample(int i, int dst_size, int src_size, SDL_StretchSample * sample)
+{
+    Sint64 pos;
+
+    /* The middle of the pixel, in 16.16 source pixels, minus half a pixel */
+    pos = ((((Sint64) (2 * i + 1) * src_size) << 16) / (2 * dst_size)) - 0x8000;
+    if (pos < 0) {
+        pos = 0;
+    }
+    sample->p0 = (int) (pos >> 16);
+    sample->weight = (int) ((pos >> 8) & 0xFF);
+    if (sample->p0 >= src_size - 1) {
+        sample->p0 = src_size - 1;
+        sample->weight = 0;
+    }
+    sample->p1 = sample->weight ? sample->p0 + 1 : sample->p0;
+}
+
+/* Each 8-bit channel of a and b mixed, with weight out of 256 for b */
+static SDL_INLINE Uint32
+SDL_LerpPixel(Uint32 a, Uint32 b, int weight)
+{
+    const Uint32 rb = ((a & 0x00FF00FF) * (256 - weight) +
+                       (b & 0x00FF00FF) * weight) >> 8;
+    const Uint32 ag = (((a >> 8) & 0x00FF00FF) * (256 - weight) +
+                       ((b >> 8) & 0x00FF00FF) * weight) >> 8;
+    return (rb & 0x00FF00FF) | ((ag & 0x00FF00FF) << 8);
+}
+
+/* Mix two rows of pixels together */
+static void
+SDL_LerpRows(const Uint32 * row0, const Uint32 * row1, int weight,
+             Uint32 * dst, int width, SDL_bool simd)
+{
+    int i = 0;
+
+#ifdef __SSE2__
+    if (simd) {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i w0 = _mm_set1_epi16((short) (256 - weight));
+        const __m128i w1 = _mm_set1_epi16((short) weight);
+        __m128i a, b, lo, hi;
+
+        for (; i + 4 <= width; i += 4) {
+            a = _mm_loadu_si128((const __m128i *) (row0 + i));
+            b = _mm_loadu_si128((const __m128i *) (row1 + i));
+            lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(a, zero), w0),
+                               _mm_mullo_epi16(_mm_unpacklo_epi8(b, zero), w1));
+            hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(a, zero), w0),
+                               _mm_mullo_epi16(_mm_unpackhi_epi8(b, zero), w1));
+            _mm_storeu_si128((__m128i *) (dst + i),
+                             _mm_packus_epi16(_mm_srli_epi16(lo, 8),
+                                              _mm_srli_epi16(hi, 8)));
+        }
+    }
+#endif
+    for (; i < width; ++i) {
+        dst[i] = SDL_LerpPixel(row0[i], row1[i], weight);
+    }
+}
+
+/* Filter a row of source pixels across to the destination width */
+static void
+SDL_LerpColumns(const Uint32 * src, const SDL_StretchSample * columns,
+                Uint32 * dst, int width, SDL_bool simd)
+{
+    int i = 0;
+
+#ifdef __SSE2__
+    if (simd) {
+        const __m128i zero = _mm_setzero_si128();
+        const SDL_StretchSample *c0, *c1;
+        __m128i p0, p1, w0, w1;
+
+        /* Each pixel is its two source pixels side by side, times the
+           weights of each, added together */
+        for (; i + 2 <= width; i += 2) {
+            c0 = &columns[i];
+            c1 = &columns[i + 1];
+            p0 = _mm_unpacklo_epi8(_mm_unpacklo_epi32(_mm_cvtsi32_si128(src[c0->p0]),
+                                                      _mm_cvtsi32_si128(src[c0->p1])), zero);
+            p1 = _mm_unpacklo_epi8(_mm_unpacklo_epi32(_mm_cvtsi32_si128(src[c1->p0]),
+                                                      _mm_cvtsi32_si128(src[c1->p1])), zero);
+            w0 = _mm_unpacklo_epi64(_mm_set1_epi16((short) (256 - c0->weight)),
+                                    _mm_set1_epi16((short) c0->weight));
+            w1 = _mm_unpacklo_epi64(_mm_set1_epi16((short) (256 - c1->weight)),
+                                    _mm_set1_epi16((short) c1->weight));
+            p0 = _mm_mullo_epi16(p0, w0);
+            p1 = _mm_mullo_epi16(p1, w1);
+            p0 = _mm_add_epi16(p0, _mm_srli_si128(p0, 8));
+            p1 = _mm_add_epi16(p1, _mm_srli_si128(p1, 8));
+            p0 = _mm_srli_epi16(_mm_unpacklo_epi64(p0, p1), 8);
+            _mm_storel_epi64((__m128i *) (dst + i), _mm_packus_epi16(p0, p0));
+        }
+    }
+#endif
+    for (; i < width; ++i) {
+        dst[i] = SDL_LerpPixel(src[columns[i].p0], src[columns[i].p1],
+                               columns[i].weight);
+    }
+}
+
+/* A stretch blit, split into bands of destination rows */
+typedef struct
+{
+    SDL_Surface *src;
+    const SDL_Rect *srcrect;
+    SDL_Surface *dst;
+    const SDL_Rect *dstrect;
+    int inc;
+    int bands;
+    SDL_StretchSample *columns; /* Only for linear filtering */
+    SDL_bool simd;              /* Filter with SSE2 */
+    Uint32 *rows;               /* A row of filtered pixels for each band */
+} SDL_StretchJob;
+
+/* Stretch the destination rows from first up to last */
+static void
+SDL_StretchRows(const SDL_StretchJob * job, int first, int last)
+{
+    const SDL_Surface *src = job->src;
+    const SDL_Surface *dst = job->dst;
+    const SDL_Rect *srcrect = job->srcrect;
+    const SDL_Rect *dstrect = job->dstrect;
+    const int bpp = dst->format->BytesPerPixel;
+    int row;
+    Uint8 *srcp;
+    Uint8 *dstp;
+
+    for (row = first; row < last; ++row) {
+        dstp = (Uint8 *) dst->pixels + ((dstrect->y + row) * dst->pitch)
+            + (dstrect->x * bpp);
+        /* The source row the stepping from the top would have got to */
+        srcp = (Uint8 *) src->pixels +
+            ((srcrect->y + (int) (((Sint64) row * job->inc) >> 16)) * src->pitch)
+            + (srcrect->x * bpp);
+        switch (bpp) {
+        case 1:
+            copy_row1(srcp, srcrect->w, dstp, dstrect->w);
+            break;
+        case 2:
+            copy_row2((Uint16 *) srcp, srcrect->w,
+                      (Uint16 *) dstp, dstrect->w);
+            break;
+        case 3:
+            copy_row3(srcp, srcrect->w, dstp, dstrect->w);
+            break;
+        case 4:
+            copy_row4((Uint32 *) srcp, srcrect->w,
+                      (Uint32 *) dstp, dstrect->w);
+            break;
+        }
+    }
+}
+
+/* Filter the destination rows from first up to last, from the two source
+   rows nearest each one */
+static void
+SDL_StretchRowsLinear(const SDL_StretchJob * job, int first, int last,
+                      Uint32 * filtered)
+{
+    const SDL_Surface *src = job->src;
+    const SDL_Surface *dst = job->dst;
+    const SDL_Rect *srcrect = job->srcrect;
+    const SDL_Rect *dstrect = job->dstrect;
+    SDL_StretchSample sample;
+    const Uint32 *row0;
+    const Uint32 *row1;
+    int row;
+
+    for (row = first; row < last; ++row) {
+        SDL_GetStretchSample(row, dstrect->h, srcrect->h, &sample);
+        row0 = (const Uint32 *) ((Uint8 *) src->pixels +
+                                 (srcrect->y + sample.p0) * src->pitch) + srcrect->x;
+        row1 = (const Uint32 *) ((Uint8 *) src->pixels +
+                                 (srcrect->y + sample.p1) * src->pitch) + srcrect->x;
+        if (sample.weight) {
+            SDL_LerpRows(row0, row1, sample.weight, filtered, srcrect->w,
+                         job->simd);
+            row0 = filtered;
+        }
+        SDL_LerpColumns(row0, job->columns,
+                        (Uint32 *) ((Uint8 *) dst->pixels +
+                                    (dstrect->y + row) * dst->pitch) + dstrect->x,
+                        dstrect->w, job->simd);
+    }
+}
+
+static void
+SDL_StretchBand(void *data, int index)
+{
+    const SDL_StretchJob *job = (const SDL_StretchJob *) data;
+    const int h = job->dstrect->h;
+    const int first = (h * index) / job->bands;
+    const int last = (h * (index + 1)) / job->bands;
+
+    if (job->columns) {
+        SDL_StretchRowsLinear(job, first, last,
+                              job->rows + index * job->srcrect->w);
+    } else {
+        SDL_StretchRows(job, first, last);
+    }
+}
+
+/* Perform a stretch blit between two surfaces of the same format */
 int
 SDL_SoftStretch(SDL_Surface * src, const SDL_Rect * srcrect,
                 SDL_Surface * dst, const SDL_Rect * dstrect)
+{
+    return SDL_PrivateSoftStretch(src, srcrect, dst, dstrect,
+                                  SDL_STRETCH_NEAREST);
+}
+
+int
+SDL_PrivateSoftStretch(SDL_Surface * src, const SDL_Rect * srcrect,
+                       SDL_Surface * dst, const SDL_Rect * dstrect,
+                       SDL_StretchMode mode)
 {
     int src_locked;
     int dst_locked;
-    int pos, inc;
-    int dst_maxrow;
-    int src_row, dst_row;
-    Uint8 *srcp = NULL;
-    Uint8 *dstp;
     SDL_Rect full_src;
     SDL_Rect full_dst;
-#ifdef USE_ASM_STRETCH
-    SDL_bool use_asm = SDL_TRUE;
-#ifdef __GNUC__
-    int u1, u2;
-#endif
-#endif /* USE_ASM_STRETCH */
-    const int bpp = dst->format->BytesPerPixel;
+    SDL_StretchJob job;
+    int i;
 
     if (src->format->format != dst->format->format) {
         return SDL_SetError("Only works with same format surfaces");
     }
-
     /* Verify the blit rectangles */
     if (srcrect) {
         if ((srcrect->x < 0) || (srcrect->y < 0) ||
@@ -252,10 +345,46 @@ SDL_SoftStretch(SDL_Surface * src, const SDL_Rect * srcrect,
         dstrect = &full_dst;
     }
 
+    /* Filtering only handles 8-bit channels, and isn't needed for copies */
+    if (mode == SDL_STRETCH_LINEAR &&
+        (SDL_PIXELLAYOUT(dst->format->format) != SDL_PACKEDLAYOUT_8888 ||
+         (srcrect->w == dstrect->w && srcrect->h == dstrect->h))) {
+        mode = SDL_STRETCH_NEAREST;
+    }
+
+    /* Set up the data... */
+    SDL_zero(job);
+    job.src = src;
+    job.srcrect = srcrect;
+    job.dst = dst;
+    job.dstrect = dstrect;
+    job.inc = (srcrect->h << 16) / dstrect->h;
+    job.bands = SDL_GetBlitBands(src, dst, dstrect->w, dstrect->h);
+
+    if (mode == SDL_STRETCH_LINEAR) {
+        job.columns = (SDL_StretchSample *)
+            SDL_malloc(dstrect->w * sizeof(*job.columns));
+        job.rows = (Uint32 *)
+            SDL_malloc(job.bands * srcrect->w * sizeof(*job.rows));
+        if (!job.columns || !job.rows) {
+            SDL_free(job.columns);
+            SDL_free(job.rows);
+            return SDL_OutOfMemory();
+        }
+        for (i = 0; i < dstrect->w; ++i) {
+            SDL_GetStretchSample(i, dstrect->w, srcrect->w, &job.columns[i]);
+        }
+#ifdef __SSE2__
+        job.simd = SDL_HasSSE2();
+#endif
+    }
+
     /* Lock the destination if it's in hardware */
     dst_locked = 0;
     if (SDL_MUSTLOCK(dst)) {
         if (SDL_LockSurface(dst) < 0) {
+            SDL_free(job.columns);
+            SDL_free(job.rows);
             return SDL_SetError("Unable to lock destination surface");
         }
         dst_locked = 1;
@@ -267,77 +396,18 @@ SDL_SoftStretch(SDL_Surface * src, const SDL_Rect * srcrect,
             if (dst_locked) {
                 SDL_UnlockSurface(dst);
             }
+            SDL_free(job.columns);
+            SDL_free(job.rows);
             return SDL_SetError("Unable to lock source surface");
         }
         src_locked = 1;
     }
 
-    /* Set up the data... */
-    pos = 0x10000;
-    inc = (srcrect->h << 16) / dstrect->h;
-    src_row = srcrect->y;
-    dst_row = dstrect->y;
-
-#ifdef USE_ASM_STRETCH
-    /* Write the opcodes for this stretch */
-    if ((bpp == 3) || (generate_rowbytes(srcrect->w, dstrect->w, bpp) < 0)) {
-        use_asm = SDL_FALSE;
-    }
-#endif
-
     /* Perform the stretch blit */
-    for (dst_maxrow = dst_row + dstrect->h; dst_row < dst_maxrow; ++dst_row) {
-        dstp = (Uint8 *) dst->pixels + (dst_row * dst->pitch)
-            + (dstrect->x * bpp);
-        while (pos >= 0x10000L) {
-            srcp = (Uint8 *) src->pixels + (src_row * src->pitch)
-                + (srcrect->x * bpp);
-            ++src_row;
-            pos -= 0x10000L;
-        }
-#ifdef USE_ASM_STRETCH
-        if (use_asm) {
-#ifdef __GNUC__
-            __asm__ __volatile__("call *%4":"=&D"(u1), "=&S"(u2)
-                                 :"0"(dstp), "1"(srcp), "r"(copy_row)
-                                 :"memory");
-#elif defined(_MSC_VER) || defined(__WATCOMC__)
-            /* *INDENT-OFF* */
-            {
-                void *code = copy_row;
-                __asm {
-                    push edi
-                    push esi
-                    mov edi, dstp
-                    mov esi, srcp
-                    call dword ptr code
-                    pop esi
-                    pop edi
-                }
-            }
-            /* *INDENT-ON* */
-#else
-#error Need inline assembly for this compiler
-#endif
-        } else
-#endif
-            switch (bpp) {
-            case 1:
-                copy_row1(srcp, srcrect->w, dstp, dstrect->w);
-                break;
-            case 2:
-                copy_row2((Uint16 *) srcp, srcrect->w,
-                          (Uint16 *) dstp, dstrect->w);
-                break;
-            case 3:
-                copy_row3(srcp, srcrect->w, dstp, dstrect->w);
-                break;
-            case 4:
-                copy_row4((Uint32 *) srcp, srcrect->w,
-                          (Uint32 *) dstp, dstrect->w);
-                break;
-            }
-        pos += inc;
+    if (job.bands > 1) {
+        SDL_RunParallel(SDL_StretchBand, &job, job.bands, 0);
+    } else {
+        SDL_StretchBand(&job, 0);
     }
 
     /* We need to unlock the surfaces if they're locked */
@@ -347,6 +417,8 @@ SDL_SoftStretch(SDL_Surface * src, const SDL_Rect * srcrect,
     if (src_locked) {
         SDL_UnlockSurface(src);
     }
+    SDL_free(job.columns);
+    SDL_free(job.rows);
     return (0);
 }
 
@@ -0,0 +1,38 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2014 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../SDL_internal.h"
+
+/* Stretch blits with a choice of filtering */
+
+typedef enum
+{
+    SDL_STRETCH_NEAREST,
+    SDL_STRETCH_LINEAR      /* Only for 8888 formats, others use nearest */
+} SDL_StretchMode;
+
+extern int SDL_PrivateSoftStretch(SDL_Surface * src, const SDL_Rect * srcrect,
+                                  SDL_Surface * dst, const SDL_Rect * dstrect,
+                                  SDL_StretchMode mode);
+extern int SDL_PrivateUpperBlitScaled(SDL_Surface * src, const SDL_Rect * srcrect,
+                                      SDL_Surface * dst, SDL_Rect * dstrect,
+                                      SDL_StretchMode mode);
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -25,6 +25,7 @@
 #include "SDL_blit.h"
 #include "SDL_RLEaccel_c.h"
 #include "SDL_pixels_c.h"
+#include "SDL_stretch_c.h"
 
 
 /* Public routines */
@@ -38,6 +39,7 @@ SDL_CreateRGBSurface(Uint32 flags,
 {
     SDL_Surface *surface;
     Uint32 format;
+    int alignment;
 
     /* The flags are no longer used, make the compiler happy */
     (void)flags;
@@ -63,7 +65,8 @@ SDL_CreateRGBSurface(Uint32 flags,
     }
     surface->w = width;
     surface->h = height;
-    surface->pitch = SDL_CalculatePitch(surface);
+    alignment = SDL_GetSurfaceAlignment();
+    surface->pitch = SDL_CalculatePitch(surface, alignment);
     SDL_SetClipRect(surface, NULL);
 
     if (SDL_ISPIXELFORMAT_INDEXED(surface->format->format)) {
@@ -88,10 +91,11 @@ SDL_CreateRGBSurface(Uint32 flags,
 
     /* Get the pixels */
     if (surface->w && surface->h) {
-        surface->pixels = SDL_malloc(surface->h * surface->pitch);
-        if (!surface->pixels) {
+        if (alignment > 4) {
+            surface->flags |= SDL_SIMD_ALIGNED;
+        }
+        if (SDL_AllocSurfacePixels(surface) < 0) {
             SDL_FreeSurface(surface);
-            SDL_OutOfMemory();
             return NULL;
         }
         /* This is important for bitmaps */
@@ -322,7 +326,7 @@ SDL_SetSurfaceColorMod(SDL_Surface * surface, Uint8 r, Uint8 g, Uint8 b)
         surface->map->info.flags &= ~SDL_COPY_MODULATE_COLOR;
     }
     if (surface->map->info.flags != flags) {
-        SDL_InvalidateMap(surface->map);
+        return SDL_UpdateBlitFlags(surface);
     }
     return 0;
 }
@@ -365,7 +369,7 @@ SDL_SetSurfaceAlphaMod(SDL_Surface * surface, Uint8 alpha)
         surface->map->info.flags &= ~SDL_COPY_MODULATE_ALPHA;
     }
     if (surface->map->info.flags != flags) {
-        SDL_InvalidateMap(surface->map);
+        return SDL_UpdateBlitFlags(surface);
     }
     return 0;
 }
@@ -413,8 +417,9 @@ SDL_SetSurfaceBlendMode(SDL_Surface * surface, SDL_BlendMode blendMode)
         break;
     }
 
-    if (surface->map->info.flags != flags) {
-        SDL_InvalidateMap(surface->map);
+    if (surface->map->info.flags != flags &&
+        SDL_UpdateBlitFlags(surface) < 0) {
+        return -1;
     }
 
     return status;
@@ -599,7 +604,9 @@ SDL_UpperBlit(SDL_Surface * src, const SDL_Rect * srcrect,
     /* Switch back to a fast blit if we were previously stretching */
     if (src->map->info.flags & SDL_COPY_NEAREST) {
         src->map->info.flags &= ~SDL_COPY_NEAREST;
-        SDL_InvalidateMap(src->map);
+        if (SDL_UpdateBlitFlags(src) < 0) {
+            return -1;
+        }
     }
 
     if (w > 0 && h > 0) {
@@ -614,9 +621,23 @@ SDL_UpperBlit(SDL_Surface * src, const SDL_Rect * srcrect,
     return 0;
 }
 
+static int
+SDL_PrivateLowerBlitScaled(SDL_Surface * src, SDL_Rect * srcrect,
+                           SDL_Surface * dst, SDL_Rect * dstrect,
+                           SDL_StretchMode mode);
+
 int
 SDL_UpperBlitScaled(SDL_Surface * src, const SDL_Rect * srcrect,
               SDL_Surface * dst, SDL_Rect * dstrect)
+{
+    return SDL_PrivateUpperBlitScaled(src, srcrect, dst, dstrect,
+                                      SDL_STRETCH_NEAREST);
+}
+
+int
+SDL_PrivateUpperBlitScaled(SDL_Surface * src, const SDL_Rect * srcrect,
+                           SDL_Surface * dst, SDL_Rect * dstrect,
+                           SDL_StretchMode mode)
 {
     SDL_Rect final_src, final_dst, fulldst;
 
@@ -696,7 +717,8 @@ SDL_UpperBlitScaled(SDL_Surface * src, const SDL_Rect * srcrect,
     }
 
     if (final_dst.w > 0 && final_dst.h > 0) {
-        return SDL_LowerBlitScaled(src, &final_src, dst, &final_dst);
+        return SDL_PrivateLowerBlitScaled(src, &final_src, dst, &final_dst,
+                                          mode);
     }
 
     return 0;
@@ -709,6 +731,63 @@ SDL_UpperBlitScaled(SDL_Surface * src, const SDL_Rect * srcrect,
 int
 SDL_LowerBlitScaled(SDL_Surface * src, SDL_Rect * srcrect,
                 SDL_Surface * dst, SDL_Rect * dstrect)
+{
+    return SDL_PrivateLowerBlitScaled(src, srcrect, dst, dstrect,
+                                      SDL_STRETCH_NEAREST);
+}
+
+/* Filter the source into a scratch surface the size of the destination,
+   then blit that with the modulation and blending of the source.  The
+   scratch surface is kept with the source's blit map, so drawing the same
+   surface every frame doesn't allocate or remap each time. */
+static int
+SDL_LowerBlitScaledLinear(SDL_Surface * src, SDL_Rect * srcrect,
+                          SDL_Surface * dst, SDL_Rect * dstrect)
+{
+    const SDL_PixelFormat *fmt = src->format;
+    SDL_Surface *filtered = src->map->scratch;
+    SDL_BlendMode blendMode;
+    SDL_Rect rect;
+    int status;
+
+    if (filtered && (filtered->format->format != fmt->format ||
+                     filtered->w < dstrect->w || filtered->h < dstrect->h)) {
+        SDL_FreeSurface(filtered);
+        filtered = src->map->scratch = NULL;
+    }
+    if (!filtered) {
+        filtered = SDL_CreateRGBSurface(0, dstrect->w, dstrect->h,
+                                        fmt->BitsPerPixel, fmt->Rmask,
+                                        fmt->Gmask, fmt->Bmask, fmt->Amask);
+        if (!filtered) {
+            return -1;
+        }
+        src->map->scratch = filtered;
+    }
+    SDL_GetSurfaceBlendMode(src, &blendMode);
+    if (SDL_SetSurfaceBlendMode(filtered, blendMode) < 0 ||
+        SDL_SetSurfaceColorMod(filtered, src->map->info.r, src->map->info.g,
+                               src->map->info.b) < 0 ||
+        SDL_SetSurfaceAlphaMod(filtered, src->map->info.a) < 0) {
+        return -1;
+    }
+
+    rect.x = 0;
+    rect.y = 0;
+    rect.w = dstrect->w;
+    rect.h = dstrect->h;
+    status = SDL_PrivateSoftStretch(src, srcrect, filtered, &rect,
+                                    SDL_STRETCH_LINEAR);
+    if (status == 0) {
+        status = SDL_LowerBlit(filtered, &rect, dst, dstrect);
+    }
+    return status;
+}
+
+static int
+SDL_PrivateLowerBlitScaled(SDL_Surface * src, SDL_Rect * srcrect,
+                           SDL_Surface * dst, SDL_Rect * dstrect,
+                           SDL_StretchMode mode)
 {
     static const Uint32 complex_copy_flags = (
         SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA |
@@ -755,7 +834,21 @@ SDL_LowerBlitScaled(SDL_Surface * src, SDL_Rect * srcrect,
 
     if (!(src->map->info.flags & SDL_COPY_NEAREST)) {
         src->map->info.flags |= SDL_COPY_NEAREST;
-        SDL_InvalidateMap(src->map);
+        if (SDL_UpdateBlitFlags(src) < 0) {
+            return -1;
+        }
+    }
+
+    /* Filtering would smear the colorkey into the pixels around it */
+    if (mode == SDL_STRETCH_LINEAR &&
+        SDL_PIXELLAYOUT(src->format->format) == SDL_PACKEDLAYOUT_8888 &&
+        !(src->map->info.flags & SDL_COPY_COLORKEY)) {
+        if (!(src->map->info.flags & complex_copy_flags) &&
+            src->format->format == dst->format->format) {
+            return SDL_PrivateSoftStretch(src, &final_src, dst, &final_dst,
+                                          SDL_STRETCH_LINEAR);
+        }
+        return SDL_LowerBlitScaledLinear(src, &final_src, dst, &final_dst);
     }
 
     if ( !(src->map->info.flags & complex_copy_flags) &&
@@ -1019,6 +1112,8 @@ int SDL_ConvertPixels(int width, int height,
             case SDL_PIXELFORMAT_YUY2:
             case SDL_PIXELFORMAT_UYVY:
             case SDL_PIXELFORMAT_YVYU:
+            case SDL_PIXELFORMAT_NV12:
+            case SDL_PIXELFORMAT_NV21:
                 bpp = 2;
                 break;
             default:
@@ -1086,7 +1181,7 @@ SDL_FreeSurface(SDL_Surface * surface)
         surface->map = NULL;
     }
     if (!(surface->flags & SDL_PREALLOC)) {
-        SDL_free(surface->pixels);
+        SDL_FreeSurfacePixels(surface);
     }
     SDL_free(surface);
 }
@@ -85,6 +85,18 @@ my %set_rgba_string = (
     "BGRA8888" => "_pixel = ((Uint32)_B << 24) | ((Uint32)_G << 16) | ((Uint32)_R << 8) | _A;",
 );
 
+# The byte of a little endian pixel holding each of R, G, B and A, used to
+# shuffle pixels between formats in the SIMD blitters.  Formats without alpha
+# give the unused byte, which is filled in or masked off.
+my %format_lanes = (
+    "RGB888" => [ 2, 1, 0, 3 ],
+    "BGR888" => [ 0, 1, 2, 3 ],
+    "ARGB8888" => [ 2, 1, 0, 3 ],
+    "RGBA8888" => [ 3, 2, 1, 0 ],
+    "ABGR8888" => [ 0, 1, 2, 3 ],
+    "BGRA8888" => [ 1, 2, 3, 0 ],
+);
+
 sub open_file {
     my $name = shift;
     open(FILE, ">$name.new") || die "Cant' open $name.new: $!";
@@ -149,6 +161,7 @@ sub output_copyfuncname
     my $scale = shift;
     my $args = shift;
     my $suffix = shift;
+    my $cpu = shift;
 
     print FILE "$prefix SDL_Blit_${src}_${dst}";
     if ( $modulate ) {
@@ -160,6 +173,9 @@ sub output_copyfuncname
     if ( $scale ) {
         print FILE "_Scale";
     }
+    if ( $cpu ) {
+        print FILE "_$cpu";
+    }
     if ( $args ) {
         print FILE "(SDL_BlitInfo *info)";
     }
@@ -426,6 +442,253 @@ __EOF__
 __EOF__
 }
 
+sub output_copyfuncs_sse2_header
+{
+    print FILE <<__EOF__;
+#ifdef __SSE2__
+
+/* The SSE2 blitters work on pixels widened to 16 bits per channel, two to a
+   register, with the source shuffled into the order of the destination so
+   that alpha (or the unused byte) is always in lane 3.  They give exactly
+   the same results as the C blitters above. */
+
+/* x / 255 in each lane, exact for x <= 255 * 255 */
+static SDL_INLINE __m128i
+SDL_Blit_Div255_SSE2(__m128i x)
+{
+    return _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(x, _mm_set1_epi16(1)), _mm_srli_epi16(x, 8)), 8);
+}
+
+static SDL_INLINE __m128i
+SDL_Blit_Modulate_SSE2(__m128i x, __m128i modulate)
+{
+    return SDL_Blit_Div255_SSE2(_mm_mullo_epi16(x, modulate));
+}
+
+static SDL_INLINE __m128i
+SDL_Blit_Blend_SSE2(__m128i src, __m128i dst, int flags)
+{
+    const __m128i alpha = _mm_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0);
+    const __m128i opaque = _mm_set1_epi16(255);
+    const __m128i srcA = _mm_shufflehi_epi16(_mm_shufflelo_epi16(src, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+
+    if (flags & (SDL_COPY_BLEND|SDL_COPY_ADD)) {
+        /* Premultiply the color, but not the alpha */
+        src = SDL_Blit_Modulate_SSE2(src, _mm_or_si128(_mm_andnot_si128(alpha, srcA), _mm_and_si128(alpha, opaque)));
+    }
+    switch (flags & (SDL_COPY_BLEND|SDL_COPY_ADD|SDL_COPY_MOD)) {
+    case SDL_COPY_BLEND:
+        return _mm_add_epi16(src, SDL_Blit_Div255_SSE2(_mm_mullo_epi16(_mm_sub_epi16(opaque, srcA), dst)));
+    case SDL_COPY_ADD:
+        src = _mm_min_epi16(_mm_add_epi16(src, dst), opaque);
+        break;
+    case SDL_COPY_MOD:
+        src = SDL_Blit_Modulate_SSE2(src, dst);
+        break;
+    default:
+        return dst;
+    }
+    /* Add and mod leave the destination alpha alone */
+    return _mm_or_si128(_mm_andnot_si128(alpha, src), _mm_and_si128(alpha, dst));
+}
+
+__EOF__
+}
+
+sub output_copyfuncs_sse2_footer
+{
+    print FILE <<__EOF__;
+#endif /* __SSE2__ */
+
+__EOF__
+}
+
+sub output_copyfunc_sse2
+{
+    my $src = shift;
+    my $dst = shift;
+    my $modulate = shift;
+    my $blend = shift;
+    my $scale = shift;
+
+    my $src_has_alpha = ($src =~ /A/) ? 1 : 0;
+    my $dst_has_alpha = ($dst =~ /A/) ? 1 : 0;
+    my $convert = ( $src ne $dst || $modulate || $blend );
+
+    # Which source byte each destination byte comes from
+    my @lanes = (0, 0, 0, 0);
+    my @modulate_lanes = ("", "", "", "");
+    my @channels = ("R", "G", "B", "A");
+    for (my $c = 0; $c < 4; ++$c) {
+        $lanes[$format_lanes{$dst}[$c]] = $format_lanes{$src}[$c];
+        $modulate_lanes[$format_lanes{$dst}[$c]] = "modulate$channels[$c]";
+    }
+    my $shuffle = "_MM_SHUFFLE($lanes[3], $lanes[2], $lanes[1], $lanes[0])";
+    my $identity = ($lanes[0] == 0 && $lanes[1] == 1 && $lanes[2] == 2 && $lanes[3] == 3);
+    my $modulate_vector = join(", ", reverse(@modulate_lanes), reverse(@modulate_lanes));
+
+    output_copyfuncname("static void", $src, $dst, $modulate, $blend, $scale, 1, "\n", "SSE2");
+    print FILE <<__EOF__;
+{
+__EOF__
+    if ( $modulate || $blend ) {
+        print FILE <<__EOF__;
+    const int flags = info->flags;
+__EOF__
+    }
+    if ( $modulate ) {
+        print FILE <<__EOF__;
+    const short modulateR = (flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    const short modulateG = (flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    const short modulateB = (flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    const short modulateA = (flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+    const __m128i modulate = _mm_set_epi16($modulate_vector);
+__EOF__
+    }
+    if ( $convert ) {
+        print FILE <<__EOF__;
+    const __m128i zero = _mm_setzero_si128();
+__EOF__
+    }
+    if ( $convert && !$src_has_alpha ) {
+        print FILE <<__EOF__;
+    const __m128i opaque = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+__EOF__
+    }
+    if ( $convert && !$dst_has_alpha ) {
+        print FILE <<__EOF__;
+    const __m128i rgbmask = _mm_set1_epi32(0x00FFFFFF);
+__EOF__
+    }
+    if ( $scale ) {
+        print FILE <<__EOF__;
+    int srcy, posy, incy, incx;
+
+    srcy = 0;
+    posy = 0;
+    incy = (info->src_h << 16) / info->dst_h;
+    incx = (info->src_w << 16) / info->dst_w;
+
+    while (info->dst_h--) {
+        const Uint32 *src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        int posx = 0;
+        while (posy >= 0x10000L) {
+            ++srcy;
+            posy -= 0x10000L;
+        }
+        src = (const Uint32 *)(info->src + (srcy * info->src_pitch));
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_set_epi32((int)src[(posx + 3 * incx) >> 16], (int)src[(posx + 2 * incx) >> 16],
+                                  (int)src[(posx + incx) >> 16], (int)src[posx >> 16]);
+            } else {
+                s = _mm_cvtsi32_si128((int)src[posx >> 16]);
+            }
+            posx += count * incx;
+__EOF__
+    } else {
+        print FILE <<__EOF__;
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+        while (n > 0) {
+            const int count = (n >= 4) ? 4 : 1;
+            __m128i s;
+            if (count == 4) {
+                s = _mm_loadu_si128((const __m128i *)src);
+            } else {
+                s = _mm_cvtsi32_si128((int)*src);
+            }
+            src += count;
+__EOF__
+    }
+    if ( $convert ) {
+        print FILE <<__EOF__;
+            {
+                __m128i sl = _mm_unpacklo_epi8(s, zero);
+                __m128i sh = _mm_unpackhi_epi8(s, zero);
+__EOF__
+        if ( $blend ) {
+            print FILE <<__EOF__;
+                __m128i d;
+__EOF__
+        }
+        if ( !$identity ) {
+            print FILE <<__EOF__;
+                sl = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sl, $shuffle), $shuffle);
+                sh = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sh, $shuffle), $shuffle);
+__EOF__
+        }
+        if ( !$src_has_alpha ) {
+            print FILE <<__EOF__;
+                sl = _mm_or_si128(sl, opaque);
+                sh = _mm_or_si128(sh, opaque);
+__EOF__
+        }
+        if ( $modulate ) {
+            print FILE <<__EOF__;
+                sl = SDL_Blit_Modulate_SSE2(sl, modulate);
+                sh = SDL_Blit_Modulate_SSE2(sh, modulate);
+__EOF__
+        }
+        if ( $blend ) {
+            print FILE <<__EOF__;
+                if (count == 4) {
+                    d = _mm_loadu_si128((const __m128i *)dst);
+                } else {
+                    d = _mm_cvtsi32_si128((int)*dst);
+                }
+                sl = SDL_Blit_Blend_SSE2(sl, _mm_unpacklo_epi8(d, zero), flags);
+                sh = SDL_Blit_Blend_SSE2(sh, _mm_unpackhi_epi8(d, zero), flags);
+__EOF__
+        }
+        print FILE <<__EOF__;
+                s = _mm_packus_epi16(sl, sh);
+__EOF__
+        if ( !$dst_has_alpha ) {
+            print FILE <<__EOF__;
+                s = _mm_and_si128(s, rgbmask);
+__EOF__
+        }
+        print FILE <<__EOF__;
+            }
+__EOF__
+    }
+    print FILE <<__EOF__;
+            if (count == 4) {
+                _mm_storeu_si128((__m128i *)dst, s);
+            } else {
+                *dst = (Uint32)_mm_cvtsi128_si32(s);
+            }
+            dst += count;
+            n -= count;
+        }
+__EOF__
+    if ( $scale ) {
+        print FILE <<__EOF__;
+        posy += incy;
+        info->dst += info->dst_pitch;
+    }
+}
+
+__EOF__
+    } else {
+        print FILE <<__EOF__;
+        info->src += info->src_pitch;
+        info->dst += info->dst_pitch;
+    }
+}
+
+__EOF__
+    }
+}
+
 sub output_copyfunc_h
 {
 }
@@ -440,11 +703,10 @@ sub output_copyinc
 __EOF__
 }
 
-sub output_copyfunctable
+sub output_copyfunctable_entries
 {
-    print FILE <<__EOF__;
-SDL_BlitFuncEntry SDL_GeneratedBlitFuncTable[] = {
-__EOF__
+    my $cpu = shift;
+
     for (my $i = 0; $i <= $#src_formats; ++$i) {
         my $src = $src_formats[$i];
         for (my $j = 0; $j <= $#dst_formats; ++$j) {
@@ -483,14 +745,32 @@ __EOF__
                             if ( $flags eq "" ) {
                                 $flags = "0";
                             }
-                            print FILE "($flags), SDL_CPU_ANY,";
-                            output_copyfuncname("", $src_formats[$i], $dst_formats[$j], $modulate, $blend, $scale, 0, " },\n");
+                            if ( $cpu ) {
+                                print FILE "($flags), SDL_CPU_$cpu,";
+                            } else {
+                                print FILE "($flags), SDL_CPU_ANY,";
+                            }
+                            output_copyfuncname("", $src_formats[$i], $dst_formats[$j], $modulate, $blend, $scale, 0, " },\n", $cpu);
                         }
                     }
                 }
             }
         }
     }
+}
+
+sub output_copyfunctable
+{
+    print FILE <<__EOF__;
+SDL_BlitFuncEntry SDL_GeneratedBlitFuncTable[] = {
+#ifdef __SSE2__
+__EOF__
+    # These come first, so they're chosen over the C versions when possible
+    output_copyfunctable_entries("SSE2");
+    print FILE <<__EOF__;
+#endif /* __SSE2__ */
+__EOF__
+    output_copyfunctable_entries("");
     print FILE <<__EOF__;
     { 0, 0, 0, 0, NULL }
 };
@@ -502,12 +782,17 @@ sub output_copyfunc_c
 {
     my $src = shift;
     my $dst = shift;
+    my $cpu = shift;
 
     for (my $modulate = 0; $modulate <= 1; ++$modulate) {
         for (my $blend = 0; $blend <= 1; ++$blend) {
             for (my $scale = 0; $scale <= 1; ++$scale) {
                 if ( $modulate || $blend || $scale ) {
-                    output_copyfunc($src, $dst, $modulate, $blend, $scale);
+                    if ( $cpu ) {
+                        output_copyfunc_sse2($src, $dst, $modulate, $blend, $scale);
+                    } else {
+                        output_copyfunc($src, $dst, $modulate, $blend, $scale);
+                    }
                 }
             }
         }
@@ -528,8 +813,15 @@ open_file("SDL_blit_auto.c");
 output_copyinc();
 for (my $i = 0; $i <= $#src_formats; ++$i) {
     for (my $j = 0; $j <= $#dst_formats; ++$j) {
-        output_copyfunc_c($src_formats[$i], $dst_formats[$j]);
+        output_copyfunc_c($src_formats[$i], $dst_formats[$j], "");
+    }
+}
+output_copyfuncs_sse2_header();
+for (my $i = 0; $i <= $#src_formats; ++$i) {
+    for (my $j = 0; $j <= $#dst_formats; ++$j) {
+        output_copyfunc_c($src_formats[$i], $dst_formats[$j], "SSE2");
     }
 }
+output_copyfuncs_sse2_footer();
 output_copyfunctable();
 close_file("SDL_blit_auto.c");
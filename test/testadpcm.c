@@ -0,0 +1,199 @@
+/*
+  Copyright (C) 1997-2014 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Benchmark ADPCM decoding in SDL_LoadWAV_RW() for each codec.
+
+   The second argument sets SDL_AUDIO_DECODE_THREADS, so the block-parallel
+   decoder can be compared with the single-threaded one.
+*/
+
+#include "SDL.h"
+
+typedef struct
+{
+    const char *name;
+    Uint16 encoding;
+    Uint16 channels;
+    Uint16 blockalign;
+} Codec;
+
+static const Codec codecs[] = {
+    { "IMA ADPCM mono", 0x0011, 1, 1024 },
+    { "IMA ADPCM stereo", 0x0011, 2, 2048 },
+    { "MS ADPCM mono", 0x0002, 1, 1024 },
+    { "MS ADPCM stereo", 0x0002, 2, 2048 },
+};
+
+static const Sint16 ms_coeff[7][2] = {
+    { 256, 0 }, { 512, -256 }, { 0, 0 }, { 192, 64 },
+    { 240, 0 }, { 460, -208 }, { 392, -232 }
+};
+
+/* Build a WAVE file of noise in memory, returning its size */
+static Uint32
+build_wav(Uint8 **wav, const Codec *codec, int seconds)
+{
+    const Uint16 channels = codec->channels;
+    const Uint16 blockalign = codec->blockalign;
+    const int ms = (codec->encoding == 0x0002);
+    const Uint16 samplesperblock = ms ?
+        ((blockalign - 7 * channels) * 2 / channels + 2) :
+        ((blockalign - 4 * channels) * 2 / channels + 1);
+    const Uint32 blocks = (Uint32) (((Sint64) seconds * 44100) / samplesperblock);
+    const Uint32 fmtlen = ms ? (20 + 2 + 7 * 4) : 20;
+    const Uint32 size = 12 + 8 + fmtlen + 8 + blocks * blockalign;
+    Uint32 seed = 12345;
+    Uint8 *block;
+    SDL_RWops *dst;
+    Uint32 b;
+    int i;
+
+    *wav = (Uint8 *) SDL_malloc(size);
+    if (*wav == NULL) {
+        return 0;
+    }
+    dst = SDL_RWFromMem(*wav, size);
+    SDL_WriteLE32(dst, 0x46464952);     /* RIFF */
+    SDL_WriteLE32(dst, size - 8);
+    SDL_WriteLE32(dst, 0x45564157);     /* WAVE */
+    SDL_WriteLE32(dst, 0x20746D66);     /* fmt */
+    SDL_WriteLE32(dst, fmtlen);
+    SDL_WriteLE16(dst, codec->encoding);
+    SDL_WriteLE16(dst, channels);
+    SDL_WriteLE32(dst, 44100);
+    SDL_WriteLE32(dst, (44100 * blockalign) / samplesperblock);
+    SDL_WriteLE16(dst, blockalign);
+    SDL_WriteLE16(dst, 4);
+    SDL_WriteLE16(dst, fmtlen - 18);
+    SDL_WriteLE16(dst, samplesperblock);
+    if (ms) {
+        SDL_WriteLE16(dst, 7);
+        for (i = 0; i < 7; i++) {
+            SDL_WriteLE16(dst, (Uint16) ms_coeff[i][0]);
+            SDL_WriteLE16(dst, (Uint16) ms_coeff[i][1]);
+        }
+    }
+    SDL_WriteLE32(dst, 0x61746164);     /* data */
+    SDL_WriteLE32(dst, blocks * blockalign);
+
+    block = *wav + SDL_RWtell(dst);
+    SDL_RWclose(dst);
+    for (b = 0; b < blocks; b++, block += blockalign) {
+        for (i = 0; i < blockalign; i++) {
+            seed = seed * 1103515245 + 12345;
+            block[i] = (Uint8) (seed >> 16);
+        }
+        /* Keep the block headers valid */
+        for (i = 0; i < channels; i++) {
+            if (ms) {
+                block[i] %= 7;                      /* predictor */
+                block[channels + i * 2] = 16;       /* initial delta */
+                block[channels + i * 2 + 1] = 0;
+            } else {
+                block[i * 4 + 2] %= 89;             /* step index */
+                block[i * 4 + 3] = 0;               /* reserved */
+            }
+        }
+    }
+    return size;
+}
+
+static Uint32
+checksum(const Uint8 *buf, Uint32 len)
+{
+    Uint32 sum = 2166136261u;
+    Uint32 i;
+    for (i = 0; i < len; i++) {
+        sum = (sum ^ buf[i]) * 16777619u;
+    }
+    return sum;
+}
+
+static void
+run_codec(const Codec *codec, int seconds, int iterations)
+{
+    SDL_AudioSpec spec;
+    Uint8 *wav = NULL;
+    Uint8 *buf = NULL;
+    Uint32 wavlen, len = 0, sum = 0;
+    Uint64 start, ticks = 0;
+    double secs;
+    int i;
+
+    wavlen = build_wav(&wav, codec, seconds);
+    if (wavlen == 0) {
+        SDL_Log("%-20s  out of memory\n", codec->name);
+        return;
+    }
+
+    for (i = 0; i < iterations; i++) {
+        start = SDL_GetPerformanceCounter();
+        if (SDL_LoadWAV_RW(SDL_RWFromConstMem(wav, wavlen), 1, &spec, &buf, &len) == NULL) {
+            SDL_Log("%-20s  failed: %s\n", codec->name, SDL_GetError());
+            SDL_free(wav);
+            return;
+        }
+        ticks += SDL_GetPerformanceCounter() - start;
+        if (i == 0) {
+            sum = checksum(buf, len);
+        }
+        SDL_FreeWAV(buf);
+    }
+
+    secs = (double) ticks / (double) SDL_GetPerformanceFrequency();
+    SDL_Log("%-20s  %8.1f MB/s in  %8.1f MB/s out  (%u bytes, checksum %08x)\n",
+            codec->name, ((double) wavlen * iterations) / (secs * 1024.0 * 1024.0),
+            ((double) len * iterations) / (secs * 1024.0 * 1024.0),
+            (unsigned int) len, sum);
+    SDL_free(wav);
+}
+
+int
+main(int argc, char **argv)
+{
+    int seconds = 60;
+    int iterations = 5;
+    int i;
+
+    /* Enable standard application logging */
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    if (argc > 1) {
+        seconds = SDL_atoi(argv[1]);
+    }
+    if (argc > 2) {
+        SDL_SetHint(SDL_HINT_AUDIO_DECODE_THREADS, argv[2]);
+    }
+    if (argc > 3) {
+        iterations = SDL_atoi(argv[3]);
+    }
+    if ((seconds <= 0) || (iterations <= 0)) {
+        SDL_Log("USAGE: %s [seconds] [threads] [iterations]\n", argv[0]);
+        return 1;
+    }
+
+    if (SDL_Init(0) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    SDL_Log("Decoding %d seconds of audio, %d iterations per codec, %s decode threads\n",
+            seconds, iterations, (argc > 2) ? argv[2] : "default");
+    for (i = 0; i < SDL_arraysize(codecs); i++) {
+        run_codec(&codecs[i], seconds, iterations);
+    }
+
+    SDL_Quit();
+    return 0;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
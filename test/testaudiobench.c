@@ -0,0 +1,160 @@
+/*
+  Copyright (C) 1997-2014 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Profile the audio pipeline end to end, without sound hardware.
+
+   This runs the disk audio driver faster than real time with its output
+   thrown away, while the callback mixes a number of voices together:
+     ./testaudiobench [seconds of audio] [voices] [speed]
+
+   A speed of 0 (the default) runs as fast as possible.  To include format
+   conversion, force a device format, e.g.
+     SDL_DISKAUDIOFORMAT=F32 SDL_DISKAUDIOFREQ=48000 ./testaudiobench
+*/
+
+#include "SDL.h"
+
+#define MAX_VOICES 64
+
+static SDL_AudioSpec have;
+static Sint16 *voice_data = NULL;
+static int voice_frames = 0;
+static int voices = 8;
+static int position = 0;
+static int frames_wanted = 0;
+static SDL_atomic_t frames_done;
+static SDL_sem *finished = NULL;
+
+static void SDLCALL
+fill_audio(void *userdata, Uint8 *stream, int len)
+{
+    const int frame_size = 2 * sizeof(Sint16);
+    int i, pos, chunk, done;
+
+    SDL_memset(stream, have.silence, len);
+    for (i = 0; i < voices; i++) {
+        /* Each voice starts at a different point in the same loop */
+        pos = (position + i * 997) % voice_frames;
+        for (done = 0; done < len; done += chunk) {
+            chunk = SDL_min(len - done, (voice_frames - pos) * frame_size);
+            SDL_MixAudioFormat(stream + done, (const Uint8 *) (voice_data + pos * 2),
+                               have.format, chunk, SDL_MIX_MAXVOLUME / 4);
+            pos = 0;
+        }
+    }
+    position = (position + len / frame_size) % voice_frames;
+    if (SDL_AtomicAdd(&frames_done, len / frame_size) < frames_wanted &&
+        SDL_AtomicGet(&frames_done) >= frames_wanted) {
+        SDL_SemPost(finished);
+    }
+}
+
+int
+main(int argc, char **argv)
+{
+    SDL_AudioSpec wanted;
+    SDL_AudioDeviceID dev;
+    SDL_AudioDeviceStats stats;
+    int seconds = 60;
+    const char *speed = "0";
+    Uint64 start;
+    double elapsed;
+    int i;
+
+    /* Enable standard application logging */
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    if (argc > 1) {
+        seconds = SDL_atoi(argv[1]);
+    }
+    if (argc > 2) {
+        voices = SDL_atoi(argv[2]);
+    }
+    if (argc > 3) {
+        speed = argv[3];
+    }
+    if ((seconds <= 0) || (voices < 0) || (voices > MAX_VOICES)) {
+        SDL_Log("USAGE: %s [seconds] [voices] [speed]\n", argv[0]);
+        return 1;
+    }
+
+    /* Run the disk driver unthrottled, without writing anything */
+    SDL_setenv("SDL_DISKAUDIOSPEED", speed, 1);
+    SDL_setenv("SDL_DISKAUDIODISCARD", "1", 0);
+    SDL_setenv("SDL_AUDIODRIVER", "disk", 1);
+
+    if (SDL_Init(SDL_INIT_AUDIO) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    SDL_zero(wanted);
+    wanted.freq = 44100;
+    wanted.format = AUDIO_S16SYS;
+    wanted.channels = 2;
+    wanted.samples = 1024;
+    wanted.callback = fill_audio;
+
+    /* The app format never changes, so a forced device format is converted */
+    dev = SDL_OpenAudioDevice(NULL, 0, &wanted, &have, 0);
+    if (dev == 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't open audio: %s\n", SDL_GetError());
+        SDL_Quit();
+        return 2;
+    }
+
+    /* One second of a chord to loop over */
+    voice_frames = have.freq;
+    voice_data = (Sint16 *) SDL_malloc(voice_frames * 2 * sizeof(Sint16));
+    if (voice_data == NULL) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Out of memory\n");
+        SDL_CloseAudioDevice(dev);
+        SDL_Quit();
+        return 2;
+    }
+    for (i = 0; i < voice_frames; i++) {
+        const double t = (double) i / have.freq;
+        const Sint16 val = (Sint16) ((SDL_sin(2.0 * M_PI * 220.0 * t) +
+                                      SDL_sin(2.0 * M_PI * 277.0 * t) +
+                                      SDL_sin(2.0 * M_PI * 330.0 * t)) * 8000.0);
+        voice_data[i * 2] = voice_data[i * 2 + 1] = val;
+    }
+
+    SDL_Log("Mixing %d voices for %d seconds of audio at speed %s\n", voices, seconds, speed);
+    frames_wanted = seconds * have.freq;
+    finished = SDL_CreateSemaphore(0);
+    start = SDL_GetPerformanceCounter();
+    SDL_PauseAudioDevice(dev, 0);
+    SDL_SemWait(finished);
+    SDL_PauseAudioDevice(dev, 1);
+    elapsed = (double) (SDL_GetPerformanceCounter() - start) / SDL_GetPerformanceFrequency();
+
+    SDL_Log("%.2f s of audio in %.2f s, %.1fx real time\n",
+            (double) SDL_AtomicGet(&frames_done) / have.freq, elapsed,
+            ((double) SDL_AtomicGet(&frames_done) / have.freq) / elapsed);
+    if (SDL_GetAudioDeviceStats(dev, &stats) == 0) {
+        SDL_Log("%u buffers; callback avg %.1f us, max %u us; convert avg %.1f us, max %u us\n",
+                (unsigned int) stats.buffers,
+                stats.callback.count ? (double) stats.callback.total_us / stats.callback.count : 0.0,
+                (unsigned int) stats.callback.max_us,
+                stats.convert.count ? (double) stats.convert.total_us / stats.convert.count : 0.0,
+                (unsigned int) stats.convert.max_us);
+    }
+
+    SDL_CloseAudioDevice(dev);
+    SDL_DestroySemaphore(finished);
+    SDL_free(voice_data);
+    SDL_Quit();
+    return 0;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,112 @@
+/*
+  Copyright (C) 1997-2014 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Record from the default capture device and report levels and timing.
+
+   To run this without sound hardware on PulseAudio, record a null sink:
+     pactl load-module module-null-sink sink_name=sdlbench
+     PULSE_SOURCE=sdlbench.monitor ./testaudiocapture 5 256
+
+   With ALSA, AUDIODEV=null (or a snd-aloop loopback device) works too.
+*/
+
+#include "SDL.h"
+
+static SDL_atomic_t callbacks;
+static int total_bytes = 0;
+static int peak = 0;
+
+static void SDLCALL
+capture_audio(void *userdata, Uint8 *stream, int len)
+{
+    const Sint16 *samples = (const Sint16 *) stream;
+    int i;
+
+    for (i = 0; i < len / 2; i++) {
+        const int val = SDL_abs(samples[i]);
+        if (val > peak) {
+            peak = val;
+        }
+    }
+    total_bytes += len;
+    SDL_AtomicAdd(&callbacks, 1);
+}
+
+int
+main(int argc, char **argv)
+{
+    SDL_AudioSpec wanted, have;
+    SDL_AudioDeviceID dev;
+    SDL_AudioDeviceStats stats;
+    int seconds = 5;
+    int latency;
+
+    /* Enable standard application logging */
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    if (SDL_Init(SDL_INIT_AUDIO) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    SDL_zero(wanted);
+    wanted.freq = 48000;
+    wanted.format = AUDIO_S16SYS;
+    wanted.channels = 1;
+    wanted.samples = 512;
+    wanted.callback = capture_audio;
+
+    if (argc > 1) {
+        seconds = SDL_atoi(argv[1]);
+    }
+    if (argc > 2) {
+        wanted.samples = (Uint16) SDL_atoi(argv[2]);
+    }
+
+    dev = SDL_OpenAudioDevice(NULL, 1, &wanted, &have, 0);
+    if (dev == 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't open capture device: %s\n", SDL_GetError());
+        SDL_Quit();
+        return 2;
+    }
+
+    SDL_Log("Driver %s, %d Hz, %d sample fragments (%.2f ms)\n",
+            SDL_GetCurrentAudioDriver(), have.freq, have.samples,
+            (have.samples * 1000.0) / have.freq);
+
+    SDL_PauseAudioDevice(dev, 0);
+    SDL_Delay(seconds * 1000);
+    SDL_PauseAudioDevice(dev, 1);
+
+    SDL_LockAudioDevice(dev);
+    SDL_Log("%d callbacks, %d bytes (%.2f s), peak level %d\n",
+            SDL_AtomicGet(&callbacks), total_bytes,
+            (double) total_bytes / (have.freq * 2.0), peak);
+    SDL_UnlockAudioDevice(dev);
+
+    latency = SDL_GetAudioDeviceLatency(dev);
+    if (latency >= 0) {
+        SDL_Log("Latency %.2f ms\n", latency / 1000.0);
+    }
+    if (SDL_GetAudioDeviceStats(dev, &stats) == 0) {
+        SDL_Log("%u buffers, %u dropped, %u overruns; device wait max %u us, callback max %u us\n",
+                (unsigned int) stats.buffers, (unsigned int) stats.late_buffers,
+                (unsigned int) stats.xruns, (unsigned int) stats.wait_device.max_us,
+                (unsigned int) stats.callback.max_us);
+    }
+
+    SDL_CloseAudioDevice(dev);
+    SDL_Quit();
+    return 0;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
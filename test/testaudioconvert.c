@@ -0,0 +1,169 @@
+/*
+  Copyright (C) 1997-2014 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Benchmark SDL_ConvertAudio() over a set of common conversion chains. */
+
+#include <stdlib.h>
+
+#include "SDL.h"
+
+typedef struct
+{
+    const char *name;
+    SDL_AudioFormat src_format;
+    Uint8 src_channels;
+    int src_rate;
+    SDL_AudioFormat dst_format;
+    Uint8 dst_channels;
+    int dst_rate;
+} ConvertChain;
+
+static const ConvertChain chains[] = {
+    { "S16 stereo -> F32 stereo", AUDIO_S16SYS, 2, 44100, AUDIO_F32SYS, 2, 44100 },
+    { "F32 stereo -> S16 stereo", AUDIO_F32SYS, 2, 44100, AUDIO_S16SYS, 2, 44100 },
+    { "S16 mono -> S16 stereo", AUDIO_S16SYS, 1, 44100, AUDIO_S16SYS, 2, 44100 },
+    { "U8 mono -> S16 stereo", AUDIO_U8, 1, 44100, AUDIO_S16SYS, 2, 44100 },
+    { "S16 mono -> F32 stereo", AUDIO_S16SYS, 1, 44100, AUDIO_F32SYS, 2, 44100 },
+    { "S16 stereo -> S16 5.1", AUDIO_S16SYS, 2, 44100, AUDIO_S16SYS, 6, 44100 },
+    { "S16 stereo -> F32 5.1", AUDIO_S16SYS, 2, 44100, AUDIO_F32SYS, 6, 44100 },
+    { "F32 5.1 -> S16 stereo", AUDIO_F32SYS, 6, 44100, AUDIO_S16SYS, 2, 44100 },
+    { "S32 stereo -> U8 mono", AUDIO_S32SYS, 2, 44100, AUDIO_U8, 1, 44100 },
+    { "S16 stereo 22050 -> S16 stereo 44100", AUDIO_S16SYS, 2, 22050, AUDIO_S16SYS, 2, 44100 },
+    { "S16 stereo 48000 -> S16 stereo 44100", AUDIO_S16SYS, 2, 48000, AUDIO_S16SYS, 2, 44100 },
+    { "S16 mono 22050 -> F32 stereo 48000", AUDIO_S16SYS, 1, 22050, AUDIO_F32SYS, 2, 48000 },
+};
+
+/* A cheap hash of the output, so runs of different builds can be compared. */
+static Uint32
+hash_buffer(const Uint8 *buf, int len)
+{
+    Uint32 hash = 2166136261u;
+    int i;
+    for (i = 0; i < len; i++) {
+        hash = (hash ^ buf[i]) * 16777619u;
+    }
+    return hash;
+}
+
+static void
+fill_source(Uint8 *buf, int len, SDL_AudioFormat format, int channels)
+{
+    const int samples = len / (SDL_AUDIO_BITSIZE(format) / 8);
+    int i;
+
+    /* a slow sweep, so the float paths see sane values. */
+    for (i = 0; i < samples; i++) {
+        const float val = (float) (((i / channels) % 200) - 100) / 100.0f;
+        switch (format) {
+        case AUDIO_U8:
+            buf[i] = (Uint8) (128 + (int) (val * 127.0f));
+            break;
+        case AUDIO_S16SYS:
+            ((Sint16 *) buf)[i] = (Sint16) (val * 32767.0f);
+            break;
+        case AUDIO_S32SYS:
+            ((Sint32 *) buf)[i] = (Sint32) (val * 2147483647.0f);
+            break;
+        case AUDIO_F32SYS:
+            ((float *) buf)[i] = val;
+            break;
+        default:
+            buf[i % len] = (Uint8) i;
+            break;
+        }
+    }
+}
+
+static void
+run_chain(const ConvertChain *chain, int frames, int iterations)
+{
+    const int frame_size = (SDL_AUDIO_BITSIZE(chain->src_format) / 8) * chain->src_channels;
+    const int len = frames * frame_size;
+    Uint8 *source = NULL;
+    Uint8 *buf = NULL;
+    Uint64 start, ticks = 0;
+    Uint32 hash = 0;
+    SDL_AudioCVT cvt;
+    double seconds;
+    int i;
+
+    if (SDL_BuildAudioCVT(&cvt, chain->src_format, chain->src_channels, chain->src_rate,
+                          chain->dst_format, chain->dst_channels, chain->dst_rate) < 0) {
+        SDL_Log("%-40s  failed to build CVT: %s\n", chain->name, SDL_GetError());
+        return;
+    }
+
+    source = (Uint8 *) SDL_malloc(len);
+    buf = (Uint8 *) SDL_malloc(len * cvt.len_mult);
+    if (!source || !buf) {
+        SDL_Log("%-40s  out of memory\n", chain->name);
+        SDL_free(source);
+        SDL_free(buf);
+        return;
+    }
+    fill_source(source, len, chain->src_format, chain->src_channels);
+
+    for (i = 0; i < iterations; i++) {
+        SDL_memcpy(buf, source, len);
+        cvt.buf = buf;
+        cvt.len = len;
+        start = SDL_GetPerformanceCounter();
+        SDL_ConvertAudio(&cvt);
+        ticks += SDL_GetPerformanceCounter() - start;
+    }
+    hash = hash_buffer(cvt.buf, cvt.len_cvt);
+
+    seconds = (double) ticks / (double) SDL_GetPerformanceFrequency();
+    SDL_Log("%-40s  %8.1f MB/s in  %7.2f ns/frame  (out %d bytes, hash %08x)\n",
+            chain->name, ((double) len * iterations) / (seconds * 1024.0 * 1024.0),
+            (seconds * 1e9) / ((double) frames * iterations), cvt.len_cvt, hash);
+
+    SDL_free(source);
+    SDL_free(buf);
+}
+
+int
+main(int argc, char **argv)
+{
+    int frames = 4096;
+    int iterations = 200;
+    int i;
+
+    /* Enable standard application logging */
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    if (argc > 1) {
+        frames = SDL_atoi(argv[1]);
+    }
+    if (argc > 2) {
+        iterations = SDL_atoi(argv[2]);
+    }
+    if ((frames <= 0) || (iterations <= 0)) {
+        SDL_Log("USAGE: %s [frames] [iterations]\n", argv[0]);
+        return 1;
+    }
+
+    if (SDL_Init(0) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    SDL_Log("Converting %d frames, %d iterations per chain\n", frames, iterations);
+    for (i = 0; i < SDL_arraysize(chains); i++) {
+        run_chain(&chains[i], frames, iterations);
+    }
+
+    SDL_Quit();
+    return 0;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,155 @@
+/*
+  Copyright (C) 1997-2014 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Measure output latency and callback regularity of an audio device.
+
+   To run this without sound hardware on PulseAudio, play into a null sink:
+     pactl load-module module-null-sink sink_name=sdlbench
+     PULSE_SINK=sdlbench ./testaudiolatency 5 10
+
+   Set SDL_AUDIO_STATS_INTERVAL=1000 to log the device statistics every second.
+
+   The third argument holds the device lock for that many milliseconds every
+   100ms, like a game updating mixer state; compare the late buffer count with
+   and without SDL_AUDIO_RENDER_AHEAD=3.
+*/
+
+#include "SDL.h"
+
+static SDL_atomic_t callbacks;
+static Uint64 last_callback = 0;
+static Uint64 max_interval = 0;
+static double phase = 0.0;
+static int frequency = 48000;
+
+static void SDLCALL
+fill_audio(void *userdata, Uint8 *stream, int len)
+{
+    const Uint64 now = SDL_GetPerformanceCounter();
+    Sint16 *samples = (Sint16 *) stream;
+    int i;
+
+    if (last_callback && ((now - last_callback) > max_interval)) {
+        max_interval = now - last_callback;
+    }
+    last_callback = now;
+    SDL_AtomicAdd(&callbacks, 1);
+
+    /* a quiet 440Hz tone on both channels */
+    for (i = 0; i < len / 4; i++) {
+        const Sint16 val = (Sint16) (SDL_sin(phase) * 3000.0);
+        samples[i * 2] = samples[i * 2 + 1] = val;
+        phase += (2.0 * M_PI * 440.0) / frequency;
+        if (phase > 2.0 * M_PI) {
+            phase -= 2.0 * M_PI;
+        }
+    }
+}
+
+int
+main(int argc, char **argv)
+{
+    SDL_AudioSpec wanted, have;
+    SDL_AudioDeviceID dev;
+    SDL_AudioDeviceStats stats;
+    int seconds = 5;
+    int lock_ms = 0;
+    int minlat = -1, maxlat = -1, measurements = 0;
+    double totallat = 0.0;
+    Uint32 start;
+
+    /* Enable standard application logging */
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_AUDIO, SDL_LOG_PRIORITY_INFO);
+
+    if (argc > 1) {
+        SDL_SetHint(SDL_HINT_AUDIO_TARGET_LATENCY, argv[1]);
+    }
+    if (argc > 2) {
+        seconds = SDL_atoi(argv[2]);
+    }
+    if (argc > 3) {
+        lock_ms = SDL_atoi(argv[3]);
+    }
+
+    if (SDL_Init(SDL_INIT_AUDIO) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    SDL_zero(wanted);
+    wanted.freq = frequency;
+    wanted.format = AUDIO_S16SYS;
+    wanted.channels = 2;
+    wanted.samples = 1024;
+    wanted.callback = fill_audio;
+
+    dev = SDL_OpenAudioDevice(NULL, 0, &wanted, &have, 0);
+    if (dev == 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't open audio: %s\n", SDL_GetError());
+        SDL_Quit();
+        return 2;
+    }
+
+    SDL_Log("Driver %s, target latency %s ms, %d sample fragments (%.2f ms)\n",
+            SDL_GetCurrentAudioDriver(), argc > 1 ? argv[1] : "(unset)",
+            have.samples, (have.samples * 1000.0) / have.freq);
+
+    SDL_PauseAudioDevice(dev, 0);
+    start = SDL_GetTicks();
+    while (!SDL_TICKS_PASSED(SDL_GetTicks(), start + seconds * 1000)) {
+        const int latency = SDL_GetAudioDeviceLatency(dev);
+        if (latency >= 0) {
+            if ((minlat < 0) || (latency < minlat)) {
+                minlat = latency;
+            }
+            if (latency > maxlat) {
+                maxlat = latency;
+            }
+            totallat += latency;
+            measurements++;
+        }
+        if (lock_ms > 0) {
+            SDL_LockAudioDevice(dev);
+            SDL_Delay(lock_ms);
+            SDL_UnlockAudioDevice(dev);
+            SDL_Delay(100 - SDL_min(lock_ms, 100));
+        } else {
+            SDL_Delay(10);
+        }
+    }
+    SDL_PauseAudioDevice(dev, 1);
+
+    SDL_Log("%d callbacks, longest gap between callbacks %.2f ms\n",
+            SDL_AtomicGet(&callbacks),
+            (max_interval * 1000.0) / SDL_GetPerformanceFrequency());
+    if (measurements > 0) {
+        SDL_Log("Latency min %.2f ms, avg %.2f ms, max %.2f ms\n",
+                minlat / 1000.0, (totallat / measurements) / 1000.0,
+                maxlat / 1000.0);
+    } else {
+        SDL_Log("Latency not available: %s\n", SDL_GetError());
+    }
+
+    if (SDL_GetAudioDeviceStats(dev, &stats) == 0) {
+        SDL_Log("%u buffers, %u late, %u xruns; callback max %u us, device wait max %u us\n",
+                (unsigned int) stats.buffers, (unsigned int) stats.late_buffers,
+                (unsigned int) stats.xruns, (unsigned int) stats.callback.max_us,
+                (unsigned int) stats.wait_device.max_us);
+    }
+
+    SDL_CloseAudioDevice(dev);
+    SDL_Quit();
+    return 0;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
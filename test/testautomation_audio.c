@@ -759,6 +759,97 @@ int audio_convertAudio()
 }
 
 
+/**
+ * \brief Checks that large buffers, which are converted in cache-sized blocks, match small ones converted in a single pass
+ *
+ * \sa http://wiki.libsdl.org/moin.cgi/SDL_ConvertAudio
+ */
+int audio_convertAudioBlocked()
+{
+  int result;
+  SDL_AudioCVT  cvt;
+  SDL_AudioFormat srcFormat, dstFormat;
+  Uint8 *data;
+  Uint8 *whole;
+  Uint8 *chunked;
+  int i, ii, j, jj, k;
+  int pos, outpos, wholeLen;
+  const int len = 384 * 1024 + 480;
+  const int chunk = 96;
+
+  data = (Uint8 *)SDL_malloc(len);
+  SDLTest_AssertCheck(data != NULL, "Check source data buffer is not NULL");
+  if (data == NULL) return TEST_ABORTED;
+  for (k = 0; k < len; k++) {
+    data[k] = (Uint8)SDLTest_RandomUint8();
+  }
+
+  for (j = 0; j < _numAudioChannels; j++) {
+    for (jj = 0; jj < _numAudioChannels; jj++) {
+      i = SDLTest_RandomIntegerInRange(0, _numAudioFormats - 1);
+      ii = SDLTest_RandomIntegerInRange(0, _numAudioFormats - 1);
+      srcFormat = _audioFormats[i];
+      dstFormat = _audioFormats[ii];
+
+      /* Avoid float conversions from random bits, which may be NaN */
+      if (SDL_AUDIO_ISFLOAT(srcFormat)) {
+        srcFormat = AUDIO_S32SYS;
+      }
+
+      result = SDL_BuildAudioCVT(&cvt, srcFormat, _audioChannels[j], 44100,
+                                       dstFormat, _audioChannels[jj], 44100);
+      SDLTest_AssertPass("Call to SDL_BuildAudioCVT(format=%i,channels=%i ==> format=%s(%i),channels=%i)",
+        srcFormat, _audioChannels[j], _audioFormatsVerbose[ii], dstFormat, _audioChannels[jj]);
+      SDLTest_AssertCheck(result >= 0, "Verify result value; expected: >=0, got: %i", result);
+      if (result < 0) {
+        SDLTest_LogError(SDL_GetError());
+        continue;
+      }
+
+      whole = (Uint8 *)SDL_malloc(len * cvt.len_mult);
+      chunked = (Uint8 *)SDL_malloc(len * cvt.len_mult);
+      SDLTest_AssertCheck(whole != NULL && chunked != NULL, "Check conversion buffers are not NULL");
+      if (whole == NULL || chunked == NULL) {
+        SDL_free(whole);
+        SDL_free(chunked);
+        SDL_free(data);
+        return TEST_ABORTED;
+      }
+
+      /* Convert everything at once */
+      SDL_memcpy(whole, data, len);
+      cvt.buf = whole;
+      cvt.len = len;
+      result = SDL_ConvertAudio(&cvt);
+      SDLTest_AssertCheck(result == 0, "Verify result value of whole conversion; expected: 0; got: %i", result);
+      wholeLen = cvt.len_cvt;
+
+      /* Convert the same data in chunks that are too small to be blocked */
+      cvt.buf = (Uint8 *)SDL_malloc(chunk * cvt.len_mult);
+      outpos = 0;
+      for (pos = 0; (cvt.buf != NULL) && (pos < len); pos += chunk) {
+        SDL_memcpy(cvt.buf, data + pos, chunk);
+        cvt.len = chunk;
+        SDL_ConvertAudio(&cvt);
+        SDL_memcpy(chunked + outpos, cvt.buf, cvt.len_cvt);
+        outpos += cvt.len_cvt;
+      }
+      SDL_free(cvt.buf);
+
+      SDLTest_AssertCheck(outpos == wholeLen, "Verify converted length; expected: %i; got: %i", wholeLen, outpos);
+      SDLTest_AssertCheck(SDL_memcmp(whole, chunked, outpos) == 0, "Verify blocked and single-pass conversions are identical");
+
+      SDL_free(whole);
+      SDL_free(chunked);
+    }
+  }
+
+  SDL_free(data);
+
+  return TEST_COMPLETED;
+}
+
+
 /**
  * \brief Opens, checks current connected status, and closes a device.
  *
@@ -821,6 +912,398 @@ int audio_openCloseAudioDeviceConnected()
 
 
 
+/**
+ * \brief Checks that an open, running device collects timing statistics.
+ *
+ * \sa SDL_GetAudioDeviceStats
+ * \sa SDL_ResetAudioDeviceStats
+ */
+int audio_getAudioDeviceStats()
+{
+   SDL_AudioDeviceStats stats;
+   SDL_AudioSpec desired, obtained;
+   SDL_AudioDeviceID id;
+   Uint32 buffers, sum;
+   int result;
+   int i;
+
+   /* Invalid device */
+   result = SDL_GetAudioDeviceStats(0, &stats);
+   SDLTest_AssertPass("Call to SDL_GetAudioDeviceStats(0, ...)");
+   SDLTest_AssertCheck(result == -1, "Validate result; expected: -1, got: %i", result);
+
+   if (SDL_GetNumAudioDevices(0) <= 0) {
+     SDLTest_Log("No devices to test with");
+     return TEST_COMPLETED;
+   }
+
+   desired.freq=22050;
+   desired.format=AUDIO_S16SYS;
+   desired.channels=2;
+   desired.samples=512;
+   desired.callback=_audio_testCallback;
+   desired.userdata=NULL;
+
+   id = SDL_OpenAudioDevice(NULL, 0, &desired, &obtained, SDL_AUDIO_ALLOW_ANY_CHANGE);
+   SDLTest_AssertPass("SDL_OpenAudioDevice(NULL,...)");
+   SDLTest_AssertCheck(id > 1, "Validate device ID; expected: >=2, got: %i", id);
+   if (id <= 1) {
+     return TEST_ABORTED;
+   }
+
+   result = SDL_GetAudioDeviceStats(id, NULL);
+   SDLTest_AssertPass("Call to SDL_GetAudioDeviceStats(%i, NULL)", id);
+   SDLTest_AssertCheck(result == -1, "Validate result; expected: -1, got: %i", result);
+
+   /* Let the device thread produce a few buffers */
+   SDL_PauseAudioDevice(id, 0);
+   SDL_Delay(200);
+   SDL_PauseAudioDevice(id, 1);
+
+   result = SDL_GetAudioDeviceStats(id, &stats);
+   SDLTest_AssertPass("Call to SDL_GetAudioDeviceStats(%i, ...)", id);
+   SDLTest_AssertCheck(result == 0, "Validate result; expected: 0, got: %i", result);
+   SDLTest_AssertCheck(stats.buffers > 0, "Validate buffers; expected: >0, got: %u", (unsigned int) stats.buffers);
+   SDLTest_AssertCheck(stats.callback.count > 0, "Validate callback count; expected: >0, got: %u", (unsigned int) stats.callback.count);
+   /* The buffer being worked on may already have its lock wait recorded */
+   SDLTest_AssertCheck(stats.lock_wait.count <= stats.buffers + 1, "Validate lock wait count; expected: <=%u, got: %u",
+       (unsigned int) stats.buffers + 1, (unsigned int) stats.lock_wait.count);
+   sum = 0;
+   for (i = 0; i < SDL_AUDIO_HISTOGRAM_BUCKETS; i++) {
+     sum += stats.callback.histogram[i];
+   }
+   SDLTest_AssertCheck(sum == stats.callback.count, "Validate callback histogram total; expected: %u, got: %u",
+       (unsigned int) stats.callback.count, (unsigned int) sum);
+
+   /* Resetting starts counting again; the thread may finish one more buffer */
+   buffers = stats.buffers;
+   SDL_ResetAudioDeviceStats(id);
+   SDLTest_AssertPass("Call to SDL_ResetAudioDeviceStats(%i)", id);
+   result = SDL_GetAudioDeviceStats(id, &stats);
+   SDLTest_AssertCheck(result == 0, "Validate result; expected: 0, got: %i", result);
+   SDLTest_AssertCheck(stats.buffers <= 1 && stats.buffers < buffers,
+       "Validate reset buffers; expected: <=1, got: %u", (unsigned int) stats.buffers);
+
+   SDL_CloseAudioDevice(id);
+   SDLTest_AssertPass("Call to SDL_CloseAudioDevice()");
+
+   return TEST_COMPLETED;
+}
+
+/* Records the order commands ran in, and which thread ran them */
+static SDL_atomic_t _audio_commandsRun;
+static int _audio_commandOrder[4];
+static SDL_threadID _audio_commandThread;
+
+void SDLCALL _audio_testCommand(void *userdata)
+{
+   const int n = SDL_AtomicAdd(&_audio_commandsRun, 1);
+   if (n < SDL_arraysize(_audio_commandOrder)) {
+     _audio_commandOrder[n] = (int) (intptr_t) userdata;
+   }
+   _audio_commandThread = SDL_ThreadID();
+}
+
+/**
+ * \brief Queues commands for the audio thread, with and without render-ahead.
+ *
+ * \sa SDL_QueueAudioCommand
+ * \sa SDL_HINT_AUDIO_RENDER_AHEAD
+ */
+int audio_queueAudioCommand()
+{
+   SDL_AudioSpec desired, obtained;
+   SDL_AudioDeviceStats stats;
+   SDL_AudioDeviceID id;
+   const char *modes[] = { "0", "3" };
+   int result;
+   int i, j;
+
+   /* Invalid device and callback */
+   result = SDL_QueueAudioCommand(0, _audio_testCommand, NULL);
+   SDLTest_AssertPass("Call to SDL_QueueAudioCommand(0, ...)");
+   SDLTest_AssertCheck(result == -1, "Validate result; expected: -1, got: %i", result);
+
+   if (SDL_GetNumAudioDevices(0) <= 0) {
+     SDLTest_Log("No devices to test with");
+     return TEST_COMPLETED;
+   }
+
+   for (i = 0; i < SDL_arraysize(modes); i++) {
+     SDL_SetHint(SDL_HINT_AUDIO_RENDER_AHEAD, modes[i]);
+     SDLTest_AssertPass("Call to SDL_SetHint(SDL_HINT_AUDIO_RENDER_AHEAD, \"%s\")", modes[i]);
+
+     desired.freq=22050;
+     desired.format=AUDIO_S16SYS;
+     desired.channels=2;
+     desired.samples=512;
+     desired.callback=_audio_testCallback;
+     desired.userdata=NULL;
+
+     id = SDL_OpenAudioDevice(NULL, 0, &desired, &obtained, SDL_AUDIO_ALLOW_ANY_CHANGE);
+     SDLTest_AssertPass("SDL_OpenAudioDevice(NULL,...)");
+     SDLTest_AssertCheck(id > 1, "Validate device ID; expected: >=2, got: %i", id);
+     if (id <= 1) {
+       SDL_SetHint(SDL_HINT_AUDIO_RENDER_AHEAD, "0");
+       return TEST_ABORTED;
+     }
+
+     result = SDL_QueueAudioCommand(id, NULL, NULL);
+     SDLTest_AssertPass("Call to SDL_QueueAudioCommand(%i, NULL, NULL)", id);
+     SDLTest_AssertCheck(result == -1, "Validate result; expected: -1, got: %i", result);
+
+     SDL_AtomicSet(&_audio_commandsRun, 0);
+     _audio_commandThread = 0;
+     for (j = 0; j < SDL_arraysize(_audio_commandOrder); j++) {
+       _audio_commandOrder[j] = -1;
+       result = SDL_QueueAudioCommand(id, _audio_testCommand, (void *) (intptr_t) j);
+       SDLTest_AssertCheck(result == 0, "Validate result of SDL_QueueAudioCommand(%i, ...); expected: 0, got: %i", id, result);
+     }
+
+     SDL_PauseAudioDevice(id, 0);
+     SDL_Delay(200);
+     SDL_PauseAudioDevice(id, 1);
+
+     result = SDL_AtomicGet(&_audio_commandsRun);
+     SDLTest_AssertCheck(result == SDL_arraysize(_audio_commandOrder), "Validate commands run; expected: %i, got: %i",
+        (int) SDL_arraysize(_audio_commandOrder), result);
+     for (j = 0; j < SDL_arraysize(_audio_commandOrder); j++) {
+       SDLTest_AssertCheck(_audio_commandOrder[j] == j, "Validate command order; expected: %i, got: %i", j, _audio_commandOrder[j]);
+     }
+     SDLTest_AssertCheck(_audio_commandThread != 0 && _audio_commandThread != SDL_ThreadID(),
+        "Validate commands ran on the audio thread");
+
+     result = SDL_GetAudioDeviceStats(id, &stats);
+     SDLTest_AssertCheck(result == 0, "Validate result; expected: 0, got: %i", result);
+     SDLTest_AssertCheck(stats.buffers > 0, "Validate buffers; expected: >0, got: %u", (unsigned int) stats.buffers);
+     SDLTest_AssertCheck(stats.callback.count > 0, "Validate callback count; expected: >0, got: %u", (unsigned int) stats.callback.count);
+
+     SDL_CloseAudioDevice(id);
+     SDLTest_AssertPass("Call to SDL_CloseAudioDevice()");
+   }
+
+   SDL_SetHint(SDL_HINT_AUDIO_RENDER_AHEAD, "0");
+   return TEST_COMPLETED;
+}
+
+/* Writes a little-endian value into a WAVE file being built */
+static Uint8 *_audio_putLE(Uint8 *dst, Uint32 value, int bytes)
+{
+   int i;
+   for (i = 0; i < bytes; i++) {
+     *dst++ = (Uint8) (value >> (i * 8));
+   }
+   return dst;
+}
+
+/* Builds a WAVE file with a LIST chunk between the fmt and data chunks */
+static int _audio_buildWAV(Uint8 *wav, Uint16 encoding, Uint16 channels, Uint16 blockalign, Uint16 bits,
+                           const Uint8 *extra, int extralen, const Uint8 *data, int datalen)
+{
+   Uint8 *dst = wav;
+   dst = _audio_putLE(dst, 0x46464952, 4); /* RIFF */
+   dst = _audio_putLE(dst, 4 + 8 + 16 + extralen + 8 + 4 + 8 + datalen, 4);
+   dst = _audio_putLE(dst, 0x45564157, 4); /* WAVE */
+   dst = _audio_putLE(dst, 0x20746D66, 4); /* fmt */
+   dst = _audio_putLE(dst, 16 + extralen, 4);
+   dst = _audio_putLE(dst, encoding, 2);
+   dst = _audio_putLE(dst, channels, 2);
+   dst = _audio_putLE(dst, 22050, 4);
+   dst = _audio_putLE(dst, 22050 * blockalign, 4);
+   dst = _audio_putLE(dst, blockalign, 2);
+   dst = _audio_putLE(dst, bits, 2);
+   SDL_memcpy(dst, extra, extralen);
+   dst += extralen;
+   dst = _audio_putLE(dst, 0x5453494c, 4); /* LIST */
+   dst = _audio_putLE(dst, 4, 4);
+   dst = _audio_putLE(dst, 0, 4);
+   dst = _audio_putLE(dst, 0x61746164, 4); /* data */
+   dst = _audio_putLE(dst, datalen, 4);
+   SDL_memcpy(dst, data, datalen);
+   dst += datalen;
+   return (int) (dst - wav);
+}
+
+/**
+ * \brief Compares streamed WAVE data with the data SDL_LoadWAV_RW loads.
+ *
+ * \sa SDL_OpenWAVStream_RW
+ * \sa SDL_ReadWAVStream
+ * \sa SDL_SeekWAVStream
+ */
+int audio_wavStream()
+{
+   const Sint16 ms_coeff[7][2] = {
+     { 256, 0 }, { 512, -256 }, { 0, 0 }, { 192, 64 },
+     { 240, 0 }, { 460, -208 }, { 392, -232 }
+   };
+   const char *names[] = { "PCM", "IMA ADPCM", "MS ADPCM" };
+   Uint8 data[4000], extra[64], wav[4200], readbuf[4096];
+   Uint8 *loaded;
+   Uint32 loaded_len, length;
+   SDL_AudioSpec loadspec, streamspec;
+   SDL_WAVStream *stream;
+   Uint16 encoding, channels, blockalign, bits;
+   int wavlen, extralen, datalen, framesize, total, result, i, t;
+   Uint32 frame;
+
+   for (t = 0; t < SDL_arraysize(names); t++) {
+     for (i = 0; i < sizeof(data); i++) {
+       data[i] = (Uint8) SDLTest_RandomIntegerInRange(0, 255);
+     }
+     extralen = 0;
+     if (t == 0) {
+       /* 1000 frames of 16-bit stereo */
+       encoding = 0x0001; channels = 2; blockalign = 4; bits = 16;
+       datalen = 4000;
+     } else if (t == 1) {
+       /* 33 stereo frames per block, plus a partial block to ignore */
+       encoding = 0x0011; channels = 2; blockalign = 40; bits = 4;
+       extra[0] = 2; extra[1] = 0;
+       extra[2] = 33; extra[3] = 0;
+       extralen = 4;
+       datalen = 40 * 50 + 17;
+       for (i = 0; i < datalen; i += blockalign) {
+         data[i + 3] = data[i + 7] = 0;
+       }
+     } else {
+       /* 34 mono frames per block */
+       encoding = 0x0002; channels = 1; blockalign = 23; bits = 4;
+       extra[0] = 32; extra[1] = 0;
+       extra[2] = 34; extra[3] = 0;
+       extra[4] = 7; extra[5] = 0;
+       for (i = 0; i < 7; i++) {
+         _audio_putLE(&extra[6 + i * 4], (Uint16) ms_coeff[i][0], 2);
+         _audio_putLE(&extra[8 + i * 4], (Uint16) ms_coeff[i][1], 2);
+       }
+       extralen = 34;
+       datalen = 23 * 100;
+       for (i = 0; i < datalen; i += blockalign) {
+         data[i] = (Uint8) ((i / blockalign) % 7);
+       }
+     }
+     wavlen = _audio_buildWAV(wav, encoding, channels, blockalign, bits, extra, extralen, data, datalen);
+
+     loaded = NULL;
+     loaded_len = 0;
+     SDL_LoadWAV_RW(SDL_RWFromConstMem(wav, wavlen), 1, &loadspec, &loaded, &loaded_len);
+     SDLTest_AssertPass("Call to SDL_LoadWAV_RW() with %s data", names[t]);
+     SDLTest_AssertCheck(loaded != NULL && loaded_len > 0, "Validate loaded data; got %u bytes", (unsigned int) loaded_len);
+     if (loaded == NULL) {
+       SDLTest_LogError("%s", SDL_GetError());
+       return TEST_ABORTED;
+     }
+
+     stream = SDL_OpenWAVStream_RW(SDL_RWFromConstMem(wav, wavlen), 1, &streamspec);
+     SDLTest_AssertPass("Call to SDL_OpenWAVStream_RW() with %s data", names[t]);
+     SDLTest_AssertCheck(stream != NULL, "Validate stream is not NULL");
+     if (stream == NULL) {
+       SDLTest_LogError("%s", SDL_GetError());
+       SDL_FreeWAV(loaded);
+       return TEST_ABORTED;
+     }
+     SDLTest_AssertCheck(streamspec.format == loadspec.format && streamspec.channels == loadspec.channels &&
+        streamspec.freq == loadspec.freq, "Validate stream spec matches the loaded spec");
+
+     framesize = (SDL_AUDIO_BITSIZE(streamspec.format) / 8) * streamspec.channels;
+     length = SDL_GetWAVStreamLength(stream);
+     SDLTest_AssertCheck(length * framesize == loaded_len, "Validate stream length; expected: %u bytes, got: %u",
+        (unsigned int) loaded_len, (unsigned int) (length * framesize));
+
+     /* Read it all in pieces that don't line up with the blocks */
+     total = 0;
+     while ((result = SDL_ReadWAVStream(stream, readbuf + (total % 2048), 100)) > 0) {
+       if (SDL_memcmp(readbuf + (total % 2048), loaded + total, result) != 0) {
+         break;
+       }
+       total += result;
+     }
+     SDLTest_AssertCheck(result == 0, "Validate last read result; expected: 0, got: %i", result);
+     SDLTest_AssertCheck(total == loaded_len, "Validate streamed data matches; expected: %u bytes, got: %i",
+        (unsigned int) loaded_len, total);
+
+     /* Seek back into the middle and read the rest in one go */
+     frame = length / 2 + 3;
+     result = SDL_SeekWAVStream(stream, frame);
+     SDLTest_AssertPass("Call to SDL_SeekWAVStream(stream, %u)", (unsigned int) frame);
+     SDLTest_AssertCheck(result == 0, "Validate result; expected: 0, got: %i", result);
+     result = SDL_ReadWAVStream(stream, readbuf, sizeof(readbuf));
+     SDLTest_AssertCheck(result == (length - frame) * framesize, "Validate read after seek; expected: %u bytes, got: %i",
+        (unsigned int) ((length - frame) * framesize), result);
+     SDLTest_AssertCheck(result > 0 && SDL_memcmp(readbuf, loaded + frame * framesize, result) == 0,
+        "Validate data after seek matches");
+
+     result = SDL_SeekWAVStream(stream, length + 1);
+     SDLTest_AssertPass("Call to SDL_SeekWAVStream(stream, length + 1)");
+     SDLTest_AssertCheck(result == -1, "Validate result; expected: -1, got: %i", result);
+
+     SDL_CloseWAVStream(stream);
+     SDLTest_AssertPass("Call to SDL_CloseWAVStream()");
+     SDL_FreeWAV(loaded);
+   }
+
+   /* Not a WAVE file */
+   stream = SDL_OpenWAVStream_RW(SDL_RWFromConstMem(data, 64), 1, &streamspec);
+   SDLTest_AssertPass("Call to SDL_OpenWAVStream_RW() with random data");
+   SDLTest_AssertCheck(stream == NULL, "Validate stream is NULL");
+
+   return TEST_COMPLETED;
+}
+
+/**
+ * \brief Compares ADPCM data decoded on several threads with a single thread.
+ *
+ * \sa SDL_LoadWAV_RW
+ * \sa SDL_HINT_AUDIO_DECODE_THREADS
+ */
+int audio_loadWAVDecodeThreads()
+{
+   const int blocks = 1500;
+   const char *threads[] = { "1", "4" };
+   Uint8 extra[4] = { 2, 0, 33, 0 };
+   Uint8 *data, *wav;
+   Uint8 *loaded[2] = { NULL, NULL };
+   Uint32 loaded_len[2] = { 0, 0 };
+   SDL_AudioSpec spec;
+   int wavlen, i;
+
+   data = (Uint8 *) SDL_malloc(blocks * 40);
+   wav = (Uint8 *) SDL_malloc(blocks * 40 + 128);
+   SDLTest_AssertCheck(data != NULL && wav != NULL, "Validate buffers were allocated");
+   if (data == NULL || wav == NULL) {
+     SDL_free(data);
+     SDL_free(wav);
+     return TEST_ABORTED;
+   }
+
+   /* Stereo IMA ADPCM, 33 frames in each 40 byte block */
+   for (i = 0; i < blocks * 40; i++) {
+     data[i] = (Uint8) SDLTest_RandomIntegerInRange(0, 255);
+   }
+   wavlen = _audio_buildWAV(wav, 0x0011, 2, 40, 4, extra, sizeof(extra), data, blocks * 40);
+
+   for (i = 0; i < SDL_arraysize(threads); i++) {
+     SDL_SetHint(SDL_HINT_AUDIO_DECODE_THREADS, threads[i]);
+     SDL_LoadWAV_RW(SDL_RWFromConstMem(wav, wavlen), 1, &spec, &loaded[i], &loaded_len[i]);
+     SDLTest_AssertPass("Call to SDL_LoadWAV_RW() with %s decode threads", threads[i]);
+     SDLTest_AssertCheck(loaded[i] != NULL, "Validate data was loaded");
+     SDLTest_AssertCheck(loaded_len[i] == blocks * 33 * 4, "Validate loaded length; expected: %i, got: %u",
+        blocks * 33 * 4, (unsigned int) loaded_len[i]);
+   }
+   SDL_SetHint(SDL_HINT_AUDIO_DECODE_THREADS, "1");
+
+   if (loaded[0] && loaded[1]) {
+     SDLTest_AssertCheck(loaded_len[0] == loaded_len[1] && SDL_memcmp(loaded[0], loaded[1], loaded_len[0]) == 0,
+        "Validate threaded decode matches");
+   }
+
+   SDL_FreeWAV(loaded[0]);
+   SDL_FreeWAV(loaded[1]);
+   SDL_free(wav);
+   SDL_free(data);
+   return TEST_COMPLETED;
+}
+
 /* ================= Test Case References ================== */
 
 /* Audio test cases */
@@ -877,11 +1360,27 @@ static const SDLTest_TestCaseReference audioTest13 =
 static const SDLTest_TestCaseReference audioTest14 =
         { (SDLTest_TestCaseFp)audio_initOpenCloseQuitAudio, "audio_initOpenCloseQuitAudio", "Cycle through init, open, close and quit with various audio specs.", TEST_DISABLED };
 
+static const SDLTest_TestCaseReference audioTest15 =
+        { (SDLTest_TestCaseFp)audio_convertAudioBlocked, "audio_convertAudioBlocked", "Compare blocked and single-pass conversion of the same data.", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference audioTest16 =
+        { (SDLTest_TestCaseFp)audio_getAudioDeviceStats, "audio_getAudioDeviceStats", "Checks statistics collected for a running device.", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference audioTest17 =
+        { (SDLTest_TestCaseFp)audio_queueAudioCommand, "audio_queueAudioCommand", "Queues commands for the audio thread, with and without render-ahead.", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference audioTest18 =
+        { (SDLTest_TestCaseFp)audio_wavStream, "audio_wavStream", "Compares streamed WAVE data with the data SDL_LoadWAV_RW loads.", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference audioTest19 =
+        { (SDLTest_TestCaseFp)audio_loadWAVDecodeThreads, "audio_loadWAVDecodeThreads", "Compares ADPCM data decoded on several threads with a single thread.", TEST_ENABLED };
+
 /* Sequence of Audio test cases */
 static const SDLTest_TestCaseReference *audioTests[] =  {
     &audioTest1, &audioTest2, &audioTest3, &audioTest4, &audioTest5, &audioTest6,
     &audioTest7, &audioTest8, &audioTest9, &audioTest10, &audioTest11,
-    &audioTest12, &audioTest13, &audioTest14, NULL
+    &audioTest12, &audioTest13, &audioTest14, &audioTest15,
+    &audioTest16, &audioTest17, &audioTest18, &audioTest19, NULL
 };
 
 /* Audio test suite (global) */
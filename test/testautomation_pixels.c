@@ -79,14 +79,16 @@ char* _RGBPixelFormatsVerbose[] =
   };
 
 /* Definition of all Non-RGB formats used to test pixel conversions */
-const int _numNonRGBPixelFormats = 5;
+const int _numNonRGBPixelFormats = 7;
 Uint32 _nonRGBPixelFormats[] =
   {
     SDL_PIXELFORMAT_YV12,
     SDL_PIXELFORMAT_IYUV,
     SDL_PIXELFORMAT_YUY2,
     SDL_PIXELFORMAT_UYVY,
-    SDL_PIXELFORMAT_YVYU
+    SDL_PIXELFORMAT_YVYU,
+    SDL_PIXELFORMAT_NV12,
+    SDL_PIXELFORMAT_NV21
   };
 char* _nonRGBPixelFormatsVerbose[] =
   {
@@ -94,7 +96,9 @@ char* _nonRGBPixelFormatsVerbose[] =
     "SDL_PIXELFORMAT_IYUV",
     "SDL_PIXELFORMAT_YUY2",
     "SDL_PIXELFORMAT_UYVY",
-    "SDL_PIXELFORMAT_YVYU"
+    "SDL_PIXELFORMAT_YVYU",
+    "SDL_PIXELFORMAT_NV12",
+    "SDL_PIXELFORMAT_NV21"
   };
 
 /* Definition of some invalid formats for negative tests */
@@ -496,6 +500,139 @@ pixels_calcGammaRamp(void *arg)
   return TEST_COMPLETED;
 }
 
+/* Reference for matching a color to a palette: the closest color, lowest index first */
+static Uint8
+_nearestColor(const SDL_Palette *palette, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
+{
+  int i, rd, gd, bd, ad, distance;
+  int smallest = 0x7FFFFFFF;
+  Uint8 nearest = 0;
+
+  for (i = 0; i < palette->ncolors; i++) {
+    rd = palette->colors[i].r - r;
+    gd = palette->colors[i].g - g;
+    bd = palette->colors[i].b - b;
+    ad = palette->colors[i].a - a;
+    distance = rd * rd + gd * gd + bd * bd + ad * ad;
+    if (distance < smallest) {
+      smallest = distance;
+      nearest = (Uint8)i;
+    }
+  }
+  return nearest;
+}
+
+/* Fill a palette with random colors, some of them repeated and some translucent */
+static void
+_randomPalette(SDL_Palette *palette)
+{
+  SDL_Color colors[256];
+  int i;
+
+  for (i = 0; i < palette->ncolors; i++) {
+    if (i > 0 && SDLTest_RandomIntegerInRange(0, 7) == 0) {
+      colors[i] = colors[SDLTest_RandomIntegerInRange(0, i - 1)];
+    } else {
+      colors[i].r = SDLTest_RandomUint8();
+      colors[i].g = SDLTest_RandomUint8();
+      colors[i].b = SDLTest_RandomUint8();
+      colors[i].a = SDLTest_RandomIntegerInRange(0, 3) ? SDL_ALPHA_OPAQUE : SDLTest_RandomUint8();
+    }
+  }
+  SDL_SetPaletteColors(palette, colors, 0, palette->ncolors);
+}
+
+/**
+ * @brief Match colors to a palette with SDL_MapRGB, SDL_MapRGBA and blits to 8-bit surfaces
+ *
+ * @sa http://wiki.libsdl.org/moin.fcg/SDL_MapRGB
+ * @sa http://wiki.libsdl.org/moin.fcg/SDL_MapRGBA
+ */
+int
+pixels_findColor(void *arg)
+{
+  SDL_Surface *src, *dst;
+  SDL_PixelFormat *rgb555;
+  Uint32 *srcpixels;
+  Uint8 *dstpixels;
+  Uint8 r, g, b, a;
+  Uint32 pixel, expected;
+  int variation;
+  int i, x, y;
+  int mismatches;
+
+  src = SDL_CreateRGBSurface(0, 64, 64, 32, 0x00FF0000, 0x0000FF00, 0x000000FF, 0);
+  dst = SDL_CreateRGBSurface(0, 64, 64, 8, 0, 0, 0, 0);
+  rgb555 = SDL_AllocFormat(SDL_PIXELFORMAT_RGB555);
+  SDLTest_AssertCheck(src != NULL && dst != NULL && rgb555 != NULL, "Verify surfaces and format were created");
+  if (src == NULL || dst == NULL || rgb555 == NULL) {
+    SDL_FreeSurface(src);
+    SDL_FreeSurface(dst);
+    SDL_FreeFormat(rgb555);
+    return TEST_ABORTED;
+  }
+
+  /* Changing the colors must be picked up by the next lookup or blit */
+  for (variation = 0; variation < 3; variation++) {
+    _randomPalette(dst->format->palette);
+    SDLTest_AssertPass("Call to SDL_SetPaletteColors()");
+
+    mismatches = 0;
+    for (i = 0; i < 4096; i++) {
+      r = SDLTest_RandomUint8();
+      g = SDLTest_RandomUint8();
+      b = SDLTest_RandomUint8();
+      a = (i & 1) ? SDL_ALPHA_OPAQUE : SDLTest_RandomUint8();
+      pixel = SDL_MapRGBA(dst->format, r, g, b, a);
+      expected = _nearestColor(dst->format->palette, r, g, b, a);
+      if (pixel != expected) {
+        if (mismatches++ == 0) {
+          SDLTest_AssertCheck(pixel == expected, "Validate SDL_MapRGBA(%u,%u,%u,%u); expected: %u, got: %u", r, g, b, a, expected, pixel);
+        }
+      }
+      pixel = SDL_MapRGB(dst->format, r, g, b);
+      expected = _nearestColor(dst->format->palette, r, g, b, SDL_ALPHA_OPAQUE);
+      if (pixel != expected) {
+        if (mismatches++ == 0) {
+          SDLTest_AssertCheck(pixel == expected, "Validate SDL_MapRGB(%u,%u,%u); expected: %u, got: %u", r, g, b, expected, pixel);
+        }
+      }
+    }
+    SDLTest_AssertCheck(mismatches == 0, "Validate colors mapped to the closest palette entry; expected: 0 mismatches, got: %d", mismatches);
+
+    /* Blits match each 5:5:5 color exactly */
+    srcpixels = (Uint32 *)src->pixels;
+    for (i = 0; i < src->w * src->h; i++) {
+      SDL_GetRGB(SDLTest_RandomIntegerInRange(0, 0x7FFF), rgb555, &r, &g, &b);
+      srcpixels[i] = ((Uint32)r << 16) | ((Uint32)g << 8) | b;
+    }
+    SDL_BlitSurface(src, NULL, dst, NULL);
+    SDLTest_AssertPass("Call to SDL_BlitSurface()");
+
+    mismatches = 0;
+    for (y = 0; y < dst->h; y++) {
+      srcpixels = (Uint32 *)((Uint8 *)src->pixels + y * src->pitch);
+      dstpixels = (Uint8 *)dst->pixels + y * dst->pitch;
+      for (x = 0; x < dst->w; x++) {
+        expected = _nearestColor(dst->format->palette, (Uint8)(srcpixels[x] >> 16),
+                                 (Uint8)(srcpixels[x] >> 8), (Uint8)srcpixels[x], SDL_ALPHA_OPAQUE);
+        if (dstpixels[x] != expected) {
+          if (mismatches++ == 0) {
+            SDLTest_AssertCheck(dstpixels[x] == expected, "Validate blitted pixel %d,%d; expected: %u, got: %u", x, y, expected, dstpixels[x]);
+          }
+        }
+      }
+    }
+    SDLTest_AssertCheck(mismatches == 0, "Validate blitted pixels mapped to the closest palette entry; expected: 0 mismatches, got: %d", mismatches);
+  }
+
+  SDL_FreeSurface(src);
+  SDL_FreeSurface(dst);
+  SDL_FreeFormat(rgb555);
+
+  return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Pixels test cases */
@@ -511,9 +648,12 @@ static const SDLTest_TestCaseReference pixelsTest3 =
 static const SDLTest_TestCaseReference pixelsTest4 =
         { (SDLTest_TestCaseFp)pixels_getPixelFormatName, "pixels_getPixelFormatName", "Call to SDL_GetPixelFormatName", TEST_ENABLED };
 
+static const SDLTest_TestCaseReference pixelsTest5 =
+        { (SDLTest_TestCaseFp)pixels_findColor, "pixels_findColor", "Match colors to a palette with SDL_MapRGB, SDL_MapRGBA and blits", TEST_ENABLED };
+
 /* Sequence of Pixels test cases */
 static const SDLTest_TestCaseReference *pixelsTests[] =  {
-    &pixelsTest1, &pixelsTest2, &pixelsTest3, &pixelsTest4, NULL
+    &pixelsTest1, &pixelsTest2, &pixelsTest3, &pixelsTest4, &pixelsTest5, NULL
 };
 
 /* Pixels test suite (global) */
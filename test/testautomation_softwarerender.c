@@ -0,0 +1,788 @@
+/**
+ * Software renderer test suite
+ *
+ * These tests draw into surfaces with SDL_CreateSoftwareRenderer(), so they
+ * don't need a window or an accelerated renderer, and run headless too.
+ */
+
+#include <stdio.h>
+
+#include "SDL.h"
+#include "SDL_test.h"
+
+/* ================= Test Case Implementation ================== */
+
+#define TESTRENDER_SCREEN_W     80
+#define TESTRENDER_SCREEN_H     60
+
+#define RENDER_COMPARE_FORMAT  SDL_PIXELFORMAT_ARGB8888
+#define RENDER_COMPARE_AMASK   0xff000000 /**< Alpha bit mask. */
+#define RENDER_COMPARE_RMASK   0x00ff0000 /**< Red bit mask. */
+#define RENDER_COMPARE_GMASK   0x0000ff00 /**< Green bit mask. */
+#define RENDER_COMPARE_BMASK   0x000000ff /**< Blue bit mask. */
+
+/* Draws a scene with a software renderer onto its surface; returns -1 to abort */
+typedef int (*_DrawSceneFp)(SDL_Renderer *swrenderer, SDL_Surface *surface);
+
+/**
+ * @brief Draws a scene into a new surface, with a hint set while the
+ *        software renderer is created.
+ */
+static SDL_Surface *
+_drawSceneWithHint(_DrawSceneFp draw, const char *hint, const char *value)
+{
+   SDL_Surface *surface;
+   SDL_Renderer *swrenderer;
+   int ret;
+
+   surface = SDL_CreateRGBSurface(SDL_SWSURFACE, TESTRENDER_SCREEN_W * 2, TESTRENDER_SCREEN_H * 2, 32,
+                                  RENDER_COMPARE_RMASK, RENDER_COMPARE_GMASK, RENDER_COMPARE_BMASK, RENDER_COMPARE_AMASK);
+   SDLTest_AssertCheck(surface != NULL, "Verify result from SDL_CreateRGBSurface is not NULL");
+   if (surface == NULL) {
+      return NULL;
+   }
+   SDL_SetHint(hint, value);
+   swrenderer = SDL_CreateSoftwareRenderer(surface);
+   SDLTest_AssertCheck(swrenderer != NULL, "Verify result from SDL_CreateSoftwareRenderer is not NULL");
+   if (swrenderer == NULL) {
+      SDL_FreeSurface(surface);
+      return NULL;
+   }
+
+   ret = draw(swrenderer, surface);
+   SDL_RenderPresent(swrenderer);
+   SDL_DestroyRenderer(swrenderer);
+   if (ret < 0) {
+      SDL_FreeSurface(surface);
+      return NULL;
+   }
+   return surface;
+}
+
+/**
+ * @brief Draws a scene with a hint at its reference value and again at
+ *        another, and checks both give the same picture.  The hint is
+ *        left at the reference value.
+ */
+static int
+_compareScenes(_DrawSceneFp draw, const char *hint, const char *reference, const char *value)
+{
+   SDL_Surface *expected;
+   SDL_Surface *actual;
+   int ret;
+
+   expected = _drawSceneWithHint(draw, hint, reference);
+   actual = _drawSceneWithHint(draw, hint, value);
+   SDL_SetHint(hint, reference);
+   if (expected == NULL || actual == NULL) {
+      SDL_FreeSurface(expected);
+      SDL_FreeSurface(actual);
+      return TEST_ABORTED;
+   }
+
+   ret = SDLTest_CompareSurfaces(actual, expected, 0);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDLTest_CompareSurfaces with %s set to %s, expected: 0, got: %i",
+                       hint, value, ret);
+
+   SDL_FreeSurface(expected);
+   SDL_FreeSurface(actual);
+   return TEST_COMPLETED;
+}
+
+/**
+ * @brief Draws small textures of many sizes, replacing some as it goes.
+ */
+static int
+_drawAtlasScene(SDL_Renderer *swrenderer, SDL_Surface *surface)
+{
+   SDL_Texture *textures[40];
+   Uint32 pixels[20 * 20];
+   SDL_Rect rect;
+   int i, x, y, w, h;
+   int checkFailCount1 = 0;
+
+   /* Textures of different sizes, with a different pattern each */
+   for (i = 0; i < SDL_arraysize(textures); i++) {
+      w = 3 + (i * 7) % 18;
+      h = 2 + (i * 5) % 19;
+      for (y = 0; y < h; y++) {
+         for (x = 0; x < w; x++) {
+            pixels[y * w + x] = ((x * 40 + i * 8) & 0xff) << 16 | ((y * 30 + i * 4) & 0xff) << 8 |
+                                ((x + y) * 20 & 0xff) | ((i % 3) == 0 ? 0x80000000 : 0xff000000);
+         }
+      }
+      textures[i] = SDL_CreateTexture(swrenderer, RENDER_COMPARE_FORMAT, SDL_TEXTUREACCESS_STATIC, w, h);
+      if (textures[i] == NULL || SDL_UpdateTexture(textures[i], NULL, pixels, w * sizeof(Uint32)) != 0) {
+         checkFailCount1++;
+         continue;
+      }
+      if ((i % 3) == 0) {
+         SDL_SetTextureBlendMode(textures[i], SDL_BLENDMODE_BLEND);
+      }
+      if ((i % 4) == 1) {
+         SDL_SetTextureColorMod(textures[i], 255, 128, 64);
+      }
+   }
+   SDLTest_AssertCheck(checkFailCount1 == 0, "Validate results from calls to SDL_CreateTexture and SDL_UpdateTexture, expected: 0, got: %i", checkFailCount1);
+
+   /* Replace some of them, so freed space gets reused */
+   for (i = 0; i < SDL_arraysize(textures); i += 5) {
+      if (textures[i]) {
+         SDL_DestroyTexture(textures[i]);
+      }
+      textures[i] = SDL_CreateTexture(swrenderer, RENDER_COMPARE_FORMAT, SDL_TEXTUREACCESS_STATIC, 6, 6);
+      for (x = 0; x < 36; x++) {
+         pixels[x] = 0xff000000 | (x * 7);
+      }
+      if (textures[i]) {
+         rect.x = 1;
+         rect.y = 2;
+         rect.w = 4;
+         rect.h = 3;
+         SDL_UpdateTexture(textures[i], NULL, pixels, 6 * sizeof(Uint32));
+         SDL_UpdateTexture(textures[i], &rect, pixels + 6, 6 * sizeof(Uint32));
+      }
+   }
+
+   SDL_SetRenderDrawColor(swrenderer, 32, 64, 96, SDL_ALPHA_OPAQUE);
+   SDL_RenderClear(swrenderer);
+   checkFailCount1 = 0;
+   for (i = 0; i < SDL_arraysize(textures); i++) {
+      if (textures[i] == NULL) {
+         continue;
+      }
+      SDL_QueryTexture(textures[i], NULL, NULL, &w, &h);
+      rect.x = (i % 8) * 20;
+      rect.y = (i / 8) * 24;
+      rect.w = (i % 2) ? w * 2 : w;
+      rect.h = (i % 2) ? h : h * 2;
+      if (SDL_RenderCopy(swrenderer, textures[i], NULL, &rect) != 0) {
+         checkFailCount1++;
+      }
+      rect.x += 4;
+      rect.y += 3;
+      if (SDL_RenderCopyEx(swrenderer, textures[i], NULL, &rect, 90.0, NULL, SDL_FLIP_HORIZONTAL) != 0) {
+         checkFailCount1++;
+      }
+   }
+   SDLTest_AssertCheck(checkFailCount1 == 0, "Validate results from calls to SDL_RenderCopy, expected: 0, got: %i", checkFailCount1);
+
+   for (i = 0; i < SDL_arraysize(textures); i++) {
+      if (textures[i]) {
+         SDL_DestroyTexture(textures[i]);
+      }
+   }
+   return 0;
+}
+
+/**
+ * @brief Tests that packing textures into an atlas doesn't change what's drawn.
+ *
+ * \sa
+ * http://wiki.libsdl.org/moin.cgi/SDL_CreateTexture
+ * http://wiki.libsdl.org/moin.cgi/SDL_RenderCopy
+ */
+int
+softwarerender_testAtlas(void *arg)
+{
+   return _compareScenes(_drawAtlasScene, SDL_HINT_RENDER_ATLAS, "0", "1");
+}
+
+/**
+ * @brief Draws fills, copies, points and lines across tile edges, with
+ *        blending, render targets, clipping and viewports.
+ */
+static int
+_drawThreadedScene(SDL_Renderer *swrenderer, SDL_Surface *surface)
+{
+   SDL_Texture *textures[3];
+   SDL_Texture *target;
+   Uint32 pixels[48 * 40];
+   SDL_Rect rect;
+   SDL_Point points[64];
+   int i, x, y, ret;
+   int checkFailCount1 = 0;
+
+   /* A static texture, which gets RLE encoded, and two streaming ones */
+   for (y = 0; y < 40; y++) {
+      for (x = 0; x < 48; x++) {
+         pixels[y * 48 + x] = ((x * 5) & 0xff) << 16 | ((y * 6) & 0xff) << 8 | ((x ^ y) * 8 & 0xff) |
+                              ((x + y) % 7 == 0 ? 0x00000000 : (x < 24 ? 0xff000000 : 0x80000000));
+      }
+   }
+   for (i = 0; i < SDL_arraysize(textures); i++) {
+      textures[i] = SDL_CreateTexture(swrenderer, RENDER_COMPARE_FORMAT,
+                                      i == 0 ? SDL_TEXTUREACCESS_STATIC : SDL_TEXTUREACCESS_STREAMING, 48, 40);
+      if (textures[i] == NULL || SDL_UpdateTexture(textures[i], NULL, pixels, 48 * sizeof(Uint32)) != 0) {
+         checkFailCount1++;
+      }
+   }
+   target = SDL_CreateTexture(swrenderer, RENDER_COMPARE_FORMAT, SDL_TEXTUREACCESS_TARGET, 100, 80);
+   SDLTest_AssertCheck(checkFailCount1 == 0 && target != NULL, "Validate results from calls to SDL_CreateTexture and SDL_UpdateTexture");
+   if (checkFailCount1 != 0 || target == NULL) {
+      /* Destroying the renderer frees the textures */
+      return -1;
+   }
+   SDL_SetTextureBlendMode(textures[0], SDL_BLENDMODE_BLEND);
+   SDL_SetTextureBlendMode(textures[1], SDL_BLENDMODE_ADD);
+
+   /* Draw into the target texture, to be copied later */
+   ret = SDL_SetRenderTarget(swrenderer, target);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_SetRenderTarget, expected: 0, got: %i", ret);
+   SDL_SetRenderDrawColor(swrenderer, 200, 40, 40, SDL_ALPHA_OPAQUE);
+   SDL_RenderClear(swrenderer);
+   SDL_RenderCopy(swrenderer, textures[0], NULL, NULL);
+   SDL_SetRenderTarget(swrenderer, NULL);
+
+   SDL_SetRenderDrawColor(swrenderer, 32, 64, 96, SDL_ALPHA_OPAQUE);
+   SDL_RenderClear(swrenderer);
+   checkFailCount1 = 0;
+   for (i = 0; i < 60; i++) {
+      /* Fills, some blended, across tile edges */
+      rect.x = (i * 37) % (surface->w + 40) - 20;
+      rect.y = (i * 53) % (surface->h + 40) - 20;
+      rect.w = 30 + (i * 11) % 150;
+      rect.h = 20 + (i * 7) % 90;
+      SDL_SetRenderDrawBlendMode(swrenderer, (SDL_BlendMode) (i % 4 == 3 ? SDL_BLENDMODE_MOD : i % 4));
+      SDL_SetRenderDrawColor(swrenderer, (Uint8) (i * 4), (Uint8) (255 - i * 3), (Uint8) (i * 9), (Uint8) (64 + i * 3));
+      if (SDL_RenderFillRect(swrenderer, &rect) != 0) {
+         checkFailCount1++;
+      }
+
+      /* The same texture with a different color between copies */
+      SDL_SetTextureColorMod(textures[i % 3], (Uint8) (255 - i * 2), 255, (Uint8) (i * 4));
+      SDL_SetTextureAlphaMod(textures[i % 3], (Uint8) (128 + i));
+      rect.x = (i * 71) % (surface->w + 48) - 48;
+      rect.y = (i * 29) % (surface->h + 40) - 40;
+      rect.w = 48;
+      rect.h = 40;
+      if (SDL_RenderCopy(swrenderer, textures[i % 3], NULL, &rect) != 0) {
+         checkFailCount1++;
+      }
+
+      if (i % 10 == 5) {
+         for (x = 0; x < SDL_arraysize(points); x++) {
+            points[x].x = (i * 13 + x * 29) % surface->w;
+            points[x].y = (i * 17 + x * 31) % surface->h;
+         }
+         SDL_RenderDrawPoints(swrenderer, points, SDL_arraysize(points));
+         SDL_RenderDrawLine(swrenderer, 0, i * 5, surface->w - 1, surface->h - 1 - i * 5);
+      }
+      if (i % 20 == 10) {
+         /* Scaled and rotated copies are drawn straight away */
+         rect.w = 96;
+         rect.h = 60;
+         SDL_RenderCopy(swrenderer, textures[0], NULL, &rect);
+         SDL_RenderCopyEx(swrenderer, textures[2], NULL, &rect, 30.0, NULL, SDL_FLIP_NONE);
+      }
+      if (i == 30) {
+         /* Clipped and offset draws */
+         rect.x = 100;
+         rect.y = 50;
+         rect.w = 300;
+         rect.h = 200;
+         SDL_RenderSetViewport(swrenderer, &rect);
+         rect.x = 20;
+         rect.y = 30;
+         rect.w = 150;
+         rect.h = 100;
+         SDL_RenderSetClipRect(swrenderer, &rect);
+      } else if (i == 45) {
+         SDL_RenderSetClipRect(swrenderer, NULL);
+         SDL_RenderSetViewport(swrenderer, NULL);
+      }
+   }
+   rect.x = 250;
+   rect.y = 190;
+   rect.w = 100;
+   rect.h = 80;
+   SDL_RenderCopy(swrenderer, target, NULL, &rect);
+   SDLTest_AssertCheck(checkFailCount1 == 0, "Validate results from calls to SDL_RenderFillRect and SDL_RenderCopy, expected: 0, got: %i", checkFailCount1);
+
+   for (i = 0; i < SDL_arraysize(textures); i++) {
+      SDL_DestroyTexture(textures[i]);
+   }
+   SDL_DestroyTexture(target);
+   return 0;
+}
+
+/**
+ * @brief Tests that drawing with several threads in the software renderer
+ *        doesn't change what's drawn.
+ *
+ * \sa
+ * http://wiki.libsdl.org/moin.cgi/SDL_CreateSoftwareRenderer
+ * http://wiki.libsdl.org/moin.cgi/SDL_RenderPresent
+ */
+int
+softwarerender_testThreads(void *arg)
+{
+   return _compareScenes(_drawThreadedScene, SDL_HINT_RENDER_SOFTWARE_THREADS, "1", "4");
+}
+
+/**
+ * @brief Copies the software renderer's surface, to compare with later.
+ */
+static SDL_Surface *
+_copyRenderSurface(SDL_Surface *surface)
+{
+   SDL_Surface *copy = SDL_ConvertSurface(surface, surface->format, 0);
+   SDLTest_AssertCheck(copy != NULL, "Verify result from SDL_ConvertSurface is not NULL");
+   return copy;
+}
+
+/**
+ * @brief Tests rotated and flipped copies in the software renderer against
+ *        copies that give the same result without rotation.
+ *
+ * \sa
+ * http://wiki.libsdl.org/moin.cgi/SDL_RenderCopyEx
+ */
+int
+softwarerender_testCopyEx(void *arg)
+{
+   SDL_Surface *surface;
+   SDL_Surface *expected[4];
+   SDL_Surface *actual[4];
+   SDL_Renderer *swrenderer;
+   SDL_Texture *texture;
+   SDL_Texture *rotated;
+   Uint32 pixels[32 * 32];
+   Uint32 turned[32 * 32];
+   SDL_Rect rect;
+   int i, x, y, ret;
+   int checkFailCount1 = 0;
+
+   surface = SDL_CreateRGBSurface(SDL_SWSURFACE, 160, 120, 32,
+                                  RENDER_COMPARE_RMASK, RENDER_COMPARE_GMASK, RENDER_COMPARE_BMASK, RENDER_COMPARE_AMASK);
+   SDLTest_AssertCheck(surface != NULL, "Verify result from SDL_CreateRGBSurface is not NULL");
+   if (surface == NULL) {
+      return TEST_ABORTED;
+   }
+   swrenderer = SDL_CreateSoftwareRenderer(surface);
+   SDLTest_AssertCheck(swrenderer != NULL, "Verify result from SDL_CreateSoftwareRenderer is not NULL");
+   if (swrenderer == NULL) {
+      SDL_FreeSurface(surface);
+      return TEST_ABORTED;
+   }
+
+   /* A texture with some see-through pixels, and the same turned clockwise */
+   for (y = 0; y < 32; y++) {
+      for (x = 0; x < 32; x++) {
+         pixels[y * 32 + x] = ((x * 8) & 0xff) << 16 | ((y * 7) & 0xff) << 8 | ((x ^ y) * 8 & 0xff) |
+                              ((x + y) % 5 == 0 ? 0x40000000 : 0xff000000);
+      }
+   }
+   for (y = 0; y < 32; y++) {
+      for (x = 0; x < 32; x++) {
+         turned[y * 32 + x] = pixels[(31 - x) * 32 + y];
+      }
+   }
+   texture = SDL_CreateTexture(swrenderer, RENDER_COMPARE_FORMAT, SDL_TEXTUREACCESS_STATIC, 32, 32);
+   rotated = SDL_CreateTexture(swrenderer, RENDER_COMPARE_FORMAT, SDL_TEXTUREACCESS_STATIC, 32, 32);
+   if (texture == NULL || rotated == NULL ||
+       SDL_UpdateTexture(texture, NULL, pixels, 32 * sizeof(Uint32)) != 0 ||
+       SDL_UpdateTexture(rotated, NULL, turned, 32 * sizeof(Uint32)) != 0) {
+      checkFailCount1++;
+   }
+   SDLTest_AssertCheck(checkFailCount1 == 0, "Validate results from calls to SDL_CreateTexture and SDL_UpdateTexture");
+   if (checkFailCount1 != 0) {
+      SDL_DestroyRenderer(swrenderer);
+      SDL_FreeSurface(surface);
+      return TEST_ABORTED;
+   }
+   for (i = 0; i < 2; i++) {
+      SDL_Texture *t = i ? rotated : texture;
+      SDL_SetTextureBlendMode(t, SDL_BLENDMODE_BLEND);
+      SDL_SetTextureColorMod(t, 255, 200, 128);
+      SDL_SetTextureAlphaMod(t, 192);
+   }
+
+   /* Each case draws the expected result first, then the rotated one */
+   for (i = 0; i < SDL_arraysize(expected); i++) {
+      SDL_SetRenderDrawColor(swrenderer, 32, 64, 96, SDL_ALPHA_OPAQUE);
+      SDL_RenderClear(swrenderer);
+      rect.x = 20;
+      rect.y = 10;
+      rect.w = (i == 1) ? 64 : 32;
+      rect.h = (i == 1) ? 64 : 32;
+      switch (i) {
+      case 0:   /* No rotation, drawn with filtering */
+      case 1:   /* No rotation, scaled */
+         ret = SDL_RenderCopy(swrenderer, texture, NULL, &rect);
+         break;
+      case 2:   /* Turned half way round */
+         ret = SDL_RenderCopyEx(swrenderer, texture, NULL, &rect, 0.0, NULL,
+                                (SDL_RendererFlip) (SDL_FLIP_HORIZONTAL | SDL_FLIP_VERTICAL));
+         break;
+      default:  /* Turned a quarter of the way round */
+         ret = SDL_RenderCopy(swrenderer, rotated, NULL, &rect);
+         break;
+      }
+      SDLTest_AssertCheck(ret == 0, "Validate result from drawing the expected image, expected: 0, got: %i", ret);
+      expected[i] = _copyRenderSurface(surface);
+
+      SDL_RenderClear(swrenderer);
+      if (i == 0) {
+         SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "linear");
+      }
+      ret = SDL_RenderCopyEx(swrenderer, texture, NULL, &rect, (i < 2) ? 0.0 : (i == 2) ? 180.0 : 90.0,
+                             NULL, SDL_FLIP_NONE);
+      SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "nearest");
+      SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderCopyEx, expected: 0, got: %i", ret);
+      actual[i] = _copyRenderSurface(surface);
+   }
+
+   for (i = 0; i < SDL_arraysize(expected); i++) {
+      if (expected[i] != NULL && actual[i] != NULL) {
+         ret = SDLTest_CompareSurfaces(actual[i], expected[i], 0);
+         SDLTest_AssertCheck(ret == 0, "Validate result from SDLTest_CompareSurfaces for case %i, expected: 0, got: %i", i, ret);
+      }
+      SDL_FreeSurface(expected[i]);
+      SDL_FreeSurface(actual[i]);
+   }
+
+   SDL_DestroyTexture(texture);
+   SDL_DestroyTexture(rotated);
+   SDL_DestroyRenderer(swrenderer);
+   SDL_FreeSurface(surface);
+   return TEST_COMPLETED;
+}
+
+/**
+ * @brief Reference for where a destination pixel samples the source when
+ *        filtering: the source pixels either side and the second's weight.
+ */
+static void
+_linearSample(int i, int dstSize, int srcSize, int *p0, int *p1, int *weight)
+{
+   /* The middle of the pixel in 1/65536ths of a source pixel, less half a pixel */
+   Sint64 pos = ((Sint64)(2 * i + 1) * srcSize * 65536) / (2 * dstSize) - 32768;
+   if (pos < 0) {
+      pos = 0;
+   }
+   *p0 = (int)(pos / 65536);
+   *weight = (int)((pos / 256) % 256);
+   if (*p0 >= srcSize - 1) {
+      *p0 = srcSize - 1;
+      *weight = 0;
+   }
+   *p1 = *weight ? *p0 + 1 : *p0;
+}
+
+static Uint32
+_linearMix(Uint32 a, Uint32 b, int weight)
+{
+   Uint32 result = 0;
+   int shift;
+   for (shift = 0; shift < 32; shift += 8) {
+      result |= ((((a >> shift) & 0xff) * (256 - weight) + ((b >> shift) & 0xff) * weight) >> 8) << shift;
+   }
+   return result;
+}
+
+/**
+ * @brief Reference bilinear scaling: rows are mixed first, then columns.
+ */
+static void
+_linearScale(const Uint32 *src, int sw, int sh, Uint32 *dst, int dw, int dh)
+{
+   int x, y, x0, x1, wx, y0, y1, wy;
+   for (y = 0; y < dh; y++) {
+      _linearSample(y, dh, sh, &y0, &y1, &wy);
+      for (x = 0; x < dw; x++) {
+         _linearSample(x, dw, sw, &x0, &x1, &wx);
+         dst[y * dw + x] = _linearMix(_linearMix(src[y0 * sw + x0], src[y1 * sw + x0], wy),
+                                      _linearMix(src[y0 * sw + x1], src[y1 * sw + x1], wy), wx);
+      }
+   }
+}
+
+/**
+ * @brief Tests scaled copies in the software renderer with linear filtering
+ *        against a reference, with and without blending.
+ *
+ * \sa
+ * http://wiki.libsdl.org/moin.cgi/SDL_RenderCopy
+ * http://wiki.libsdl.org/moin.cgi/SDL_HINT_RENDER_SCALE_QUALITY
+ */
+int
+softwarerender_testScaleQuality(void *arg)
+{
+   const SDL_Rect rects[] = {
+      { 10, 10, 64, 64 },    /* Twice the size */
+      { 10, 10, 20, 24 },    /* Smaller */
+      { 10, 10, 75, 50 },    /* Larger one way, smaller the other */
+      { 30, 20, 75, 50 }     /* The same, blended and modulated */
+   };
+   SDL_Surface *surface;
+   SDL_Surface *expected;
+   SDL_Surface *actual;
+   SDL_Renderer *swrenderer;
+   SDL_Texture *texture;
+   SDL_Texture *filtered;
+   Uint32 pixels[32 * 32];
+   Uint32 scaled[75 * 64];
+   const SDL_Rect *rect;
+   int i, x, y, ret;
+
+   surface = SDL_CreateRGBSurface(SDL_SWSURFACE, 160, 120, 32,
+                                  RENDER_COMPARE_RMASK, RENDER_COMPARE_GMASK, RENDER_COMPARE_BMASK, RENDER_COMPARE_AMASK);
+   SDLTest_AssertCheck(surface != NULL, "Verify result from SDL_CreateRGBSurface is not NULL");
+   if (surface == NULL) {
+      return TEST_ABORTED;
+   }
+   swrenderer = SDL_CreateSoftwareRenderer(surface);
+   SDLTest_AssertCheck(swrenderer != NULL, "Verify result from SDL_CreateSoftwareRenderer is not NULL");
+   if (swrenderer == NULL) {
+      SDL_FreeSurface(surface);
+      return TEST_ABORTED;
+   }
+
+   for (y = 0; y < 32; y++) {
+      for (x = 0; x < 32; x++) {
+         pixels[y * 32 + x] = ((x * 8) & 0xff) << 16 | ((y * 7) & 0xff) << 8 | ((x ^ y) * 8 & 0xff) |
+                              (Uint32)(((x + y) * 4) & 0xff) << 24;
+      }
+   }
+   texture = SDL_CreateTexture(swrenderer, RENDER_COMPARE_FORMAT, SDL_TEXTUREACCESS_STATIC, 32, 32);
+   SDLTest_AssertCheck(texture != NULL, "Verify result from SDL_CreateTexture is not NULL");
+   if (texture == NULL) {
+      SDL_DestroyRenderer(swrenderer);
+      SDL_FreeSurface(surface);
+      return TEST_ABORTED;
+   }
+   SDL_UpdateTexture(texture, NULL, pixels, 32 * sizeof(Uint32));
+
+   for (i = 0; i < SDL_arraysize(rects); i++) {
+      rect = &rects[i];
+      if (i == 3) {
+         SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+         SDL_SetTextureColorMod(texture, 255, 200, 128);
+         SDL_SetTextureAlphaMod(texture, 192);
+      }
+
+      /* The expected result is the reference scaled image, copied unscaled */
+      _linearScale(pixels, 32, 32, scaled, rect->w, rect->h);
+      filtered = SDL_CreateTexture(swrenderer, RENDER_COMPARE_FORMAT, SDL_TEXTUREACCESS_STATIC, rect->w, rect->h);
+      SDLTest_AssertCheck(filtered != NULL, "Verify result from SDL_CreateTexture is not NULL");
+      if (filtered == NULL) {
+         continue;
+      }
+      SDL_UpdateTexture(filtered, NULL, scaled, rect->w * sizeof(Uint32));
+      if (i == 3) {
+         SDL_SetTextureBlendMode(filtered, SDL_BLENDMODE_BLEND);
+         SDL_SetTextureColorMod(filtered, 255, 200, 128);
+         SDL_SetTextureAlphaMod(filtered, 192);
+      }
+      SDL_SetRenderDrawColor(swrenderer, 32, 64, 96, SDL_ALPHA_OPAQUE);
+      SDL_RenderClear(swrenderer);
+      ret = SDL_RenderCopy(swrenderer, filtered, NULL, rect);
+      SDLTest_AssertCheck(ret == 0, "Validate result from drawing the expected image, expected: 0, got: %i", ret);
+      expected = _copyRenderSurface(surface);
+      SDL_DestroyTexture(filtered);
+
+      SDL_RenderClear(swrenderer);
+      SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "linear");
+      ret = SDL_RenderCopy(swrenderer, texture, NULL, rect);
+      SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "nearest");
+      SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderCopy, expected: 0, got: %i", ret);
+      actual = _copyRenderSurface(surface);
+
+      if (expected != NULL && actual != NULL) {
+         ret = SDLTest_CompareSurfaces(actual, expected, 0);
+         SDLTest_AssertCheck(ret == 0, "Validate result from SDLTest_CompareSurfaces for case %i, expected: 0, got: %i", i, ret);
+      }
+      SDL_FreeSurface(expected);
+      SDL_FreeSurface(actual);
+   }
+
+   SDL_DestroyTexture(texture);
+   SDL_DestroyRenderer(swrenderer);
+   SDL_FreeSurface(surface);
+   return TEST_COMPLETED;
+}
+
+/**
+ * @brief Reads the Y, Cr and Cb of a pixel from YUV data laid out as
+ *        SDL_UpdateTexture() takes it.
+ */
+static void
+_yuvSample(Uint32 format, const Uint8 *data, int w, int h, int x, int y, int *Y, int *Cr, int *Cb)
+{
+   const Uint8 *plane1 = data + w * h;
+   const Uint8 *plane2 = plane1 + (w / 2) * (h / 2);
+   const Uint8 *pair = data + y * w * 2 + (x / 2) * 4;
+   const int chroma = (y / 2) * (w / 2) + x / 2;
+   const Uint8 *interleaved = plane1 + (y / 2) * w + (x / 2) * 2;
+
+   switch (format) {
+   case SDL_PIXELFORMAT_YV12:
+      *Y = data[y * w + x];
+      *Cr = plane1[chroma];
+      *Cb = plane2[chroma];
+      break;
+   case SDL_PIXELFORMAT_IYUV:
+      *Y = data[y * w + x];
+      *Cr = plane2[chroma];
+      *Cb = plane1[chroma];
+      break;
+   case SDL_PIXELFORMAT_YUY2:
+      *Y = pair[(x & 1) * 2];
+      *Cr = pair[3];
+      *Cb = pair[1];
+      break;
+   case SDL_PIXELFORMAT_UYVY:
+      *Y = pair[(x & 1) * 2 + 1];
+      *Cr = pair[2];
+      *Cb = pair[0];
+      break;
+   case SDL_PIXELFORMAT_YVYU:
+      *Y = pair[(x & 1) * 2];
+      *Cr = pair[1];
+      *Cb = pair[3];
+      break;
+   case SDL_PIXELFORMAT_NV12:
+      *Y = data[y * w + x];
+      *Cr = interleaved[1];
+      *Cb = interleaved[0];
+      break;
+   case SDL_PIXELFORMAT_NV21:
+      *Y = data[y * w + x];
+      *Cr = interleaved[0];
+      *Cb = interleaved[1];
+      break;
+   default:
+      *Y = 0;
+      *Cr = 128;
+      *Cb = 128;
+      break;
+   }
+}
+
+static int
+_yuvClamp(double v)
+{
+   return (v < 0.0) ? 0 : (v > 255.0) ? 255 : (int)(v + 0.5);
+}
+
+/**
+ * @brief Tests converting YUV textures to RGB in the software renderer
+ *        against a reference, for each YUV format and conversion mode.
+ *
+ * \sa
+ * http://wiki.libsdl.org/moin.cgi/SDL_CreateTexture
+ * http://wiki.libsdl.org/moin.cgi/SDL_UpdateTexture
+ */
+int
+softwarerender_testYUVConversion(void *arg)
+{
+   const Uint32 formats[] = {
+      SDL_PIXELFORMAT_YV12, SDL_PIXELFORMAT_IYUV,
+      SDL_PIXELFORMAT_YUY2, SDL_PIXELFORMAT_UYVY, SDL_PIXELFORMAT_YVYU,
+      SDL_PIXELFORMAT_NV12, SDL_PIXELFORMAT_NV21
+   };
+   const struct {
+      const char *name;
+      double luma_offset, luma_scale, cr_r, cr_g, cb_g, cb_b;
+   } modes[] = {
+      { "JPEG", 0.0, 1.0, 1.402, -0.714, -0.344, 1.772 },
+      { "BT601", 16.0, 255.0 / 219.0, 1.596, -0.813, -0.391, 2.018 },
+      { "BT709", 16.0, 255.0 / 219.0, 1.793, -0.533, -0.213, 2.112 }
+   };
+   /* Wide enough for the SIMD code, and not a multiple of its width */
+   const int w = 38, h = 10;
+   Uint8 data[38 * 10 * 2];
+   SDL_Surface *surface;
+   SDL_Renderer *swrenderer;
+   SDL_Texture *texture;
+   Uint8 r, g, b;
+   int Y, Cr, Cb, er, eg, eb;
+   int i, m, x, y, ret, mismatches;
+
+   surface = SDL_CreateRGBSurface(SDL_SWSURFACE, w, h, 32,
+                                  RENDER_COMPARE_RMASK, RENDER_COMPARE_GMASK, RENDER_COMPARE_BMASK, RENDER_COMPARE_AMASK);
+   SDLTest_AssertCheck(surface != NULL, "Verify result from SDL_CreateRGBSurface is not NULL");
+   if (surface == NULL) {
+      return TEST_ABORTED;
+   }
+   swrenderer = SDL_CreateSoftwareRenderer(surface);
+   SDLTest_AssertCheck(swrenderer != NULL, "Verify result from SDL_CreateSoftwareRenderer is not NULL");
+   if (swrenderer == NULL) {
+      SDL_FreeSurface(surface);
+      return TEST_ABORTED;
+   }
+
+   for (i = 0; i < sizeof(data); i++) {
+      data[i] = SDLTest_RandomUint8();
+   }
+
+   for (m = 0; m < SDL_arraysize(modes); m++) {
+      SDL_SetHint(SDL_HINT_YUV_CONVERSION_MODE, modes[m].name);
+      for (i = 0; i < SDL_arraysize(formats); i++) {
+         texture = SDL_CreateTexture(swrenderer, formats[i], SDL_TEXTUREACCESS_STATIC, w, h);
+         SDLTest_AssertCheck(texture != NULL, "Verify result from SDL_CreateTexture is not NULL");
+         if (texture == NULL) {
+            continue;
+         }
+         /* The planar formats have a byte of Y per pixel, the packed ones two bytes */
+         ret = SDL_UpdateTexture(texture, NULL, data, (SDL_BYTESPERPIXEL(formats[i]) == 1) ? w : w * 2);
+         SDLTest_AssertCheck(ret == 0, "Validate result from SDL_UpdateTexture, expected: 0, got: %i", ret);
+         ret = SDL_RenderCopy(swrenderer, texture, NULL, NULL);
+         SDLTest_AssertCheck(ret == 0, "Validate result from SDL_RenderCopy, expected: 0, got: %i", ret);
+
+         /* Allow for the rounding of the fixed point conversion */
+         mismatches = 0;
+         for (y = 0; y < h; y++) {
+            for (x = 0; x < w; x++) {
+               _yuvSample(formats[i], data, w, h, x, y, &Y, &Cr, &Cb);
+               SDL_GetRGB(((Uint32 *)surface->pixels)[y * (surface->pitch / 4) + x], surface->format, &r, &g, &b);
+               er = _yuvClamp((Y - modes[m].luma_offset) * modes[m].luma_scale + (Cr - 128) * modes[m].cr_r);
+               eg = _yuvClamp((Y - modes[m].luma_offset) * modes[m].luma_scale + (Cr - 128) * modes[m].cr_g + (Cb - 128) * modes[m].cb_g);
+               eb = _yuvClamp((Y - modes[m].luma_offset) * modes[m].luma_scale + (Cb - 128) * modes[m].cb_b);
+               if (SDL_abs(r - er) > 3 || SDL_abs(g - eg) > 3 || SDL_abs(b - eb) > 3) {
+                  mismatches++;
+               }
+            }
+         }
+         SDLTest_AssertCheck(mismatches == 0, "Validate %s conversion of %s, expected: 0 mismatched pixels, got: %i",
+                             modes[m].name, SDL_GetPixelFormatName(formats[i]), mismatches);
+         SDL_DestroyTexture(texture);
+      }
+   }
+   SDL_SetHint(SDL_HINT_YUV_CONVERSION_MODE, "JPEG");
+
+   SDL_DestroyRenderer(swrenderer);
+   SDL_FreeSurface(surface);
+   return TEST_COMPLETED;
+}
+/* ================= Test References ================== */
+
+/* Software renderer test cases */
+static const SDLTest_TestCaseReference softwarerenderTest1 =
+        { (SDLTest_TestCaseFp)softwarerender_testAtlas, "softwarerender_testAtlas", "Tests packing textures into an atlas", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference softwarerenderTest2 =
+        { (SDLTest_TestCaseFp)softwarerender_testThreads, "softwarerender_testThreads", "Tests drawing with several threads", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference softwarerenderTest3 =
+        { (SDLTest_TestCaseFp)softwarerender_testCopyEx, "softwarerender_testCopyEx", "Tests rotated copies", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference softwarerenderTest4 =
+        { (SDLTest_TestCaseFp)softwarerender_testScaleQuality, "softwarerender_testScaleQuality", "Tests linear filtering of scaled copies", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference softwarerenderTest5 =
+        { (SDLTest_TestCaseFp)softwarerender_testYUVConversion, "softwarerender_testYUVConversion", "Tests converting YUV textures to RGB", TEST_ENABLED };
+
+/* Sequence of Software renderer test cases */
+static const SDLTest_TestCaseReference *softwarerenderTests[] =  {
+    &softwarerenderTest1, &softwarerenderTest2, &softwarerenderTest3, &softwarerenderTest4, &softwarerenderTest5, NULL
+};
+
+/* Software renderer test suite (global) */
+SDLTest_TestSuiteReference softwarerenderTestSuite = {
+    "SoftwareRender",
+    NULL,
+    softwarerenderTests,
+    NULL
+};
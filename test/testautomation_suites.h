@@ -21,6 +21,7 @@ extern SDLTest_TestSuiteReference rectTestSuite;
 extern SDLTest_TestSuiteReference renderTestSuite;
 extern SDLTest_TestSuiteReference rwopsTestSuite;
 extern SDLTest_TestSuiteReference sdltestTestSuite;
+extern SDLTest_TestSuiteReference softwarerenderTestSuite;
 extern SDLTest_TestSuiteReference stdlibTestSuite;
 extern SDLTest_TestSuiteReference surfaceTestSuite;
 extern SDLTest_TestSuiteReference syswmTestSuite;
@@ -42,6 +43,7 @@ SDLTest_TestSuiteReference *testSuites[] =  {
     &renderTestSuite,
     &rwopsTestSuite,
     &sdltestTestSuite,
+    &softwarerenderTestSuite,
     &stdlibTestSuite,
     &surfaceTestSuite,
     &syswmTestSuite,
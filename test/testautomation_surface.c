@@ -585,6 +585,741 @@ surface_testBlitBlendLoop(void *arg) {
 
 }
 
+/**
+ * Helper that creates a surface of the given pixel format
+ */
+static SDL_Surface *
+_createSurfaceWithFormat(int w, int h, Uint32 format)
+{
+   int bpp;
+   Uint32 rmask, gmask, bmask, amask;
+
+   if (!SDL_PixelFormatEnumToMasks(format, &bpp, &rmask, &gmask, &bmask, &amask)) {
+      return NULL;
+   }
+   return SDL_CreateRGBSurface(SDL_SWSURFACE, w, h, bpp, rmask, gmask, bmask, amask);
+}
+
+/**
+ * @brief Tests that blits split between threads match blits done in one go.
+ */
+int
+surface_testBlitThreads(void *arg)
+{
+   const Uint32 formats[] = { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB565 };
+   const SDL_Rect dstrects[] = { { 10, 7, 320, 240 }, { -13, 5, 517, 391 }, { 40, 30, 201, 133 } };
+   SDL_Surface *source;
+   SDL_Surface *serial;
+   SDL_Surface *threaded;
+   SDL_Rect rect;
+   Uint32 *pixels;
+   Uint32 seed = 1234;
+   int i, f, r, mode, ret;
+   int checkFailCount1 = 0;
+   int checkFailCount2 = 0;
+
+   /* A source with noise in every channel, alpha included */
+   source = _createSurfaceWithFormat(320, 240, SDL_PIXELFORMAT_ARGB8888);
+   SDLTest_AssertCheck(source != NULL, "Verify source surface is not NULL");
+   if (source == NULL) {
+      return TEST_ABORTED;
+   }
+   pixels = (Uint32 *) source->pixels;
+   for (i = 0; i < source->w * source->h; i++) {
+      seed = seed * 1103515245 + 12345;
+      pixels[i] = seed ^ (seed >> 15);
+   }
+
+   for (f = 0; f < SDL_arraysize(formats); f++) {
+      serial = _createSurfaceWithFormat(500, 400, formats[f]);
+      threaded = _createSurfaceWithFormat(500, 400, formats[f]);
+      SDLTest_AssertCheck(serial != NULL && threaded != NULL, "Verify destination surfaces are not NULL");
+      if (serial == NULL || threaded == NULL) {
+         SDL_FreeSurface(serial);
+         SDL_FreeSurface(threaded);
+         break;
+      }
+
+      for (mode = 0; mode < 3; mode++) {
+         SDL_SetSurfaceBlendMode(source, mode == 0 ? SDL_BLENDMODE_NONE : SDL_BLENDMODE_BLEND);
+         SDL_SetSurfaceColorMod(source, 255, mode == 2 ? 128 : 255, mode == 2 ? 64 : 255);
+         for (r = 0; r < SDL_arraysize(dstrects); r++) {
+            SDL_FillRect(serial, NULL, SDL_MapRGB(serial->format, 20, 40, 60));
+            SDL_FillRect(threaded, NULL, SDL_MapRGB(threaded->format, 20, 40, 60));
+
+            SDL_SetHint(SDL_HINT_BLIT_THREADS_THRESHOLD, "0");
+            rect = dstrects[r];
+            ret = (r == 0) ? SDL_BlitSurface(source, NULL, serial, &rect) : SDL_BlitScaled(source, NULL, serial, &rect);
+            SDL_SetHint(SDL_HINT_BLIT_THREADS_THRESHOLD, "1");
+            rect = dstrects[r];
+            ret |= (r == 0) ? SDL_BlitSurface(source, NULL, threaded, &rect) : SDL_BlitScaled(source, NULL, threaded, &rect);
+            SDL_SetHint(SDL_HINT_BLIT_THREADS_THRESHOLD, "0");
+            if (ret != 0) {
+               checkFailCount1++;
+            }
+
+            ret = SDLTest_CompareSurfaces(threaded, serial, 0);
+            if (ret != 0) {
+               SDLTest_LogError("Format %s, blend mode %d, rect %d: %d pixels differ",
+                                SDL_GetPixelFormatName(formats[f]), mode, r, ret);
+               checkFailCount2++;
+            }
+         }
+      }
+      SDL_FreeSurface(serial);
+      SDL_FreeSurface(threaded);
+   }
+   SDLTest_AssertCheck(checkFailCount1 == 0, "Validate results from calls to SDL_BlitSurface and SDL_BlitScaled, expected: 0, got: %i", checkFailCount1);
+   SDLTest_AssertCheck(checkFailCount2 == 0, "Validate results from SDLTest_CompareSurfaces, expected: 0, got: %i", checkFailCount2);
+
+   SDL_FreeSurface(source);
+   return TEST_COMPLETED;
+}
+
+/**
+ * @brief Works out what a blit should give for one pixel, the slow way.
+ */
+static Uint32
+_blitPixel(Uint32 srcpixel, SDL_PixelFormat *srcfmt, Uint32 dstpixel, SDL_PixelFormat *dstfmt,
+           SDL_BlendMode blendMode, const Uint8 mod[4])
+{
+   Uint8 r, g, b, a, dr, dg, db, da;
+   Uint32 sR, sG, sB, sA, dR, dG, dB, dA;
+
+   SDL_GetRGBA(srcpixel, srcfmt, &r, &g, &b, &a);
+   SDL_GetRGBA(dstpixel, dstfmt, &dr, &dg, &db, &da);
+   sR = r * mod[0] / 255;
+   sG = g * mod[1] / 255;
+   sB = b * mod[2] / 255;
+   sA = a * mod[3] / 255;
+   dR = dr;
+   dG = dg;
+   dB = db;
+   dA = da;
+   if (blendMode == SDL_BLENDMODE_BLEND || blendMode == SDL_BLENDMODE_ADD) {
+      sR = sR * sA / 255;
+      sG = sG * sA / 255;
+      sB = sB * sA / 255;
+   }
+   switch (blendMode) {
+   case SDL_BLENDMODE_BLEND:
+      dR = sR + (255 - sA) * dR / 255;
+      dG = sG + (255 - sA) * dG / 255;
+      dB = sB + (255 - sA) * dB / 255;
+      dA = sA + (255 - sA) * dA / 255;
+      break;
+   case SDL_BLENDMODE_ADD:
+      dR = SDL_min(sR + dR, 255);
+      dG = SDL_min(sG + dG, 255);
+      dB = SDL_min(sB + dB, 255);
+      break;
+   case SDL_BLENDMODE_MOD:
+      dR = sR * dR / 255;
+      dG = sG * dG / 255;
+      dB = sB * dB / 255;
+      break;
+   default:
+      dR = sR;
+      dG = sG;
+      dB = sB;
+      dA = sA;
+      break;
+   }
+   return SDL_MapRGBA(dstfmt, (Uint8) dR, (Uint8) dG, (Uint8) dB, (Uint8) dA);
+}
+
+/**
+ * @brief Tests 32 bit blits with every blend mode and modulation, plain and
+ *        scaled, against a pixel by pixel reference.
+ *
+ * This covers the generated blitters, including the SIMD ones, which must
+ * give exactly the same results as the C ones.  Unscaled blits without
+ * modulation are left out, since other blitters with their own rounding
+ * handle those.
+ */
+int
+surface_testBlitExact(void *arg)
+{
+   const Uint32 srcformats[] = { SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888 };
+   const Uint32 dstformats[] = { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_BGR888 };
+   const SDL_BlendMode modes[] = { SDL_BLENDMODE_NONE, SDL_BLENDMODE_BLEND, SDL_BLENDMODE_ADD, SDL_BLENDMODE_MOD };
+   const Uint8 mods[2][4] = { { 255, 255, 255, 255 }, { 200, 77, 255, 130 } };
+   SDL_Surface *source;
+   SDL_Surface *dest;
+   SDL_Rect rect;
+   Uint32 *before;
+   Uint32 used;
+   Uint32 seed = 4321;
+   int s, d, m, mod, scaled, x, y, ret;
+   int checkFailCount1 = 0;
+   int checkFailCount2 = 0;
+
+   before = (Uint32 *) SDL_malloc(61 * 43 * sizeof(Uint32));
+   SDLTest_AssertCheck(before != NULL, "Verify result from SDL_malloc is not NULL");
+   if (before == NULL) {
+      return TEST_ABORTED;
+   }
+
+   for (s = 0; s < SDL_arraysize(srcformats); s++) {
+      /* An odd width, so the SIMD blitters have pixels left over on each row */
+      source = _createSurfaceWithFormat(37, 21, srcformats[s]);
+      SDLTest_AssertCheck(source != NULL, "Verify source surface is not NULL");
+      if (source == NULL) {
+         SDL_free(before);
+         return TEST_ABORTED;
+      }
+      for (y = 0; y < source->h; y++) {
+         Uint32 *row = (Uint32 *) ((Uint8 *) source->pixels + y * source->pitch);
+         for (x = 0; x < source->w; x++) {
+            seed = seed * 1103515245 + 12345;
+            /* Include fully transparent and opaque pixels */
+            row[x] = (seed >> 8) | ((x % 5 == 0) ? 0 : (x % 5 == 1) ? 0xff000000 : (seed << 24));
+         }
+      }
+
+      for (d = 0; d < SDL_arraysize(dstformats); d++) {
+         for (m = 0; m < SDL_arraysize(modes); m++) {
+            for (mod = 0; mod < SDL_arraysize(mods); mod++) {
+               for (scaled = 0; scaled < 2; scaled++) {
+                  if (!mod && !scaled) {
+                     continue;
+                  }
+                  dest = _createSurfaceWithFormat(61, 43, dstformats[d]);
+                  if (dest == NULL) {
+                     checkFailCount1++;
+                     continue;
+                  }
+                  for (x = 0; x < dest->w * dest->h; x++) {
+                     seed = seed * 1103515245 + 12345;
+                     before[x] = ((Uint32 *) dest->pixels)[x] = seed ^ (seed >> 13);
+                  }
+                  SDL_SetSurfaceBlendMode(source, modes[m]);
+                  SDL_SetSurfaceColorMod(source, mods[mod][0], mods[mod][1], mods[mod][2]);
+                  SDL_SetSurfaceAlphaMod(source, mods[mod][3]);
+                  rect.x = 3;
+                  rect.y = 2;
+                  rect.w = scaled ? 53 : source->w;
+                  rect.h = scaled ? 39 : source->h;
+                  ret = scaled ? SDL_BlitScaled(source, NULL, dest, &rect) : SDL_BlitSurface(source, NULL, dest, &rect);
+                  if (ret != 0) {
+                     checkFailCount1++;
+                  }
+
+                  /* Whatever ends up in unused bits doesn't matter */
+                  used = dest->format->Rmask | dest->format->Gmask | dest->format->Bmask | dest->format->Amask;
+                  for (y = 0; y < rect.h; y++) {
+                     const int incy = (source->h << 16) / rect.h;
+                     const int incx = (source->w << 16) / rect.w;
+                     const Uint32 *srcrow = (const Uint32 *) ((Uint8 *) source->pixels + ((y * incy) >> 16) * source->pitch);
+                     const int offset = (rect.y + y) * dest->w + rect.x;
+                     for (x = 0; x < rect.w; x++) {
+                        const Uint32 expected = _blitPixel(srcrow[(x * incx) >> 16], source->format,
+                                                           before[offset + x], dest->format, modes[m], mods[mod]);
+                        if ((((Uint32 *) dest->pixels)[offset + x] & used) != expected) {
+                           if (checkFailCount2 == 0) {
+                              SDLTest_LogError("Format %s to %s, blend mode %i, modulation %i, scaled %i: pixel %i,%i is 0x%08x, expected 0x%08x",
+                                 SDL_GetPixelFormatName(srcformats[s]), SDL_GetPixelFormatName(dstformats[d]),
+                                 modes[m], mod, scaled, x, y, ((Uint32 *) dest->pixels)[offset + x], expected);
+                           }
+                           checkFailCount2++;
+                        }
+                     }
+                  }
+                  SDL_FreeSurface(dest);
+               }
+            }
+         }
+      }
+      SDL_FreeSurface(source);
+   }
+   SDL_free(before);
+
+   SDLTest_AssertCheck(checkFailCount1 == 0, "Validate results from calls to SDL_BlitSurface and SDL_BlitScaled, expected: 0, got: %i", checkFailCount1);
+   SDLTest_AssertCheck(checkFailCount2 == 0, "Validate blitted pixels against the reference, expected: 0 wrong, got: %i", checkFailCount2);
+   return TEST_COMPLETED;
+}
+
+/**
+ * @brief Tests that changing a surface's modulation and blend mode between
+ *        blits gives the same results as blitting fresh surfaces.
+ */
+int
+surface_testBlitStateChanges(void *arg)
+{
+   const SDL_BlendMode modes[] = { SDL_BLENDMODE_NONE, SDL_BLENDMODE_BLEND, SDL_BLENDMODE_ADD, SDL_BLENDMODE_MOD };
+   SDL_Surface *source;
+   SDL_Surface *pristine;
+   SDL_Surface *fresh;
+   SDL_Surface *reused;
+   SDL_Surface *expected;
+   SDL_Rect rect;
+   Uint32 *pixels;
+   Uint32 seed = 2468;
+   int i, ret;
+   int checkFailCount1 = 0;
+
+   source = _createSurfaceWithFormat(40, 30, SDL_PIXELFORMAT_ARGB8888);
+   reused = _createSurfaceWithFormat(100, 80, SDL_PIXELFORMAT_RGB888);
+   expected = _createSurfaceWithFormat(100, 80, SDL_PIXELFORMAT_RGB888);
+   SDLTest_AssertCheck(source != NULL && reused != NULL && expected != NULL, "Verify surfaces are not NULL");
+   if (source == NULL || reused == NULL || expected == NULL) {
+      SDL_FreeSurface(source);
+      SDL_FreeSurface(reused);
+      SDL_FreeSurface(expected);
+      return TEST_ABORTED;
+   }
+   pixels = (Uint32 *) source->pixels;
+   for (i = 0; i < source->w * source->h; i++) {
+      seed = seed * 1103515245 + 12345;
+      pixels[i] = seed ^ (seed >> 15);
+   }
+   /* Copying a surface maps it again, so copies come from one kept aside */
+   pristine = SDL_ConvertSurface(source, source->format, 0);
+   SDLTest_AssertCheck(pristine != NULL, "Verify result from SDL_ConvertSurface is not NULL");
+   if (pristine == NULL) {
+      SDL_FreeSurface(source);
+      SDL_FreeSurface(reused);
+      SDL_FreeSurface(expected);
+      return TEST_ABORTED;
+   }
+   SDL_FillRect(reused, NULL, SDL_MapRGB(reused->format, 40, 90, 160));
+   SDL_FillRect(expected, NULL, SDL_MapRGB(expected->format, 40, 90, 160));
+
+   for (i = 0; i < 24; i++) {
+      const Uint8 alpha = (i % 3 == 0) ? 255 : (Uint8) (i * 10);
+      const Uint8 color = (i % 4 == 1) ? 255 : (Uint8) (i * 9);
+
+      rect.x = (i * 7) % 60;
+      rect.y = (i * 5) % 50;
+      rect.w = (i % 2) ? source->w : 31 + i;
+      rect.h = (i % 2) ? source->h : 17 + i;
+
+      /* The same surface with its state changed between blits... */
+      SDL_SetSurfaceBlendMode(source, modes[i % SDL_arraysize(modes)]);
+      SDL_SetSurfaceColorMod(source, 255, color, 255 - color);
+      SDL_SetSurfaceAlphaMod(source, alpha);
+      ret = (i % 2) ? SDL_BlitSurface(source, NULL, reused, &rect) : SDL_BlitScaled(source, NULL, reused, &rect);
+
+      /* ...and a new one set up the same way */
+      fresh = SDL_ConvertSurface(pristine, pristine->format, 0);
+      if (fresh == NULL) {
+         checkFailCount1++;
+         continue;
+      }
+      SDL_SetSurfaceBlendMode(fresh, modes[i % SDL_arraysize(modes)]);
+      SDL_SetSurfaceColorMod(fresh, 255, color, 255 - color);
+      SDL_SetSurfaceAlphaMod(fresh, alpha);
+      rect.x = (i * 7) % 60;
+      rect.y = (i * 5) % 50;
+      rect.w = (i % 2) ? source->w : 31 + i;
+      rect.h = (i % 2) ? source->h : 17 + i;
+      ret |= (i % 2) ? SDL_BlitSurface(fresh, NULL, expected, &rect) : SDL_BlitScaled(fresh, NULL, expected, &rect);
+      SDL_FreeSurface(fresh);
+      if (ret != 0) {
+         checkFailCount1++;
+      }
+   }
+   SDLTest_AssertCheck(checkFailCount1 == 0, "Validate results from calls to SDL_BlitSurface and SDL_BlitScaled, expected: 0, got: %i", checkFailCount1);
+
+   ret = SDLTest_CompareSurfaces(reused, expected, 0);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDLTest_CompareSurfaces, expected: 0, got: %i", ret);
+
+   SDL_FreeSurface(source);
+   SDL_FreeSurface(pristine);
+   SDL_FreeSurface(reused);
+   SDL_FreeSurface(expected);
+   return TEST_COMPLETED;
+}
+
+/**
+ * @brief Tests RLE accelerated blits against plain ones, with the encoding
+ *        done in one go and split between threads.
+ */
+int
+surface_testBlitRLE(void *arg)
+{
+   /* RLE blending is less exact, using 5 bits of alpha for 16 bit targets */
+   const struct {
+      Uint32 src;
+      Uint32 dst;
+      SDL_bool alpha;
+      int allowable_error;
+   } cases[] = {
+      { SDL_PIXELFORMAT_RGB332, SDL_PIXELFORMAT_RGB332, SDL_FALSE, 0 },
+      { SDL_PIXELFORMAT_RGB565, SDL_PIXELFORMAT_RGB565, SDL_FALSE, 0 },
+      { SDL_PIXELFORMAT_RGB24, SDL_PIXELFORMAT_RGB24, SDL_FALSE, 0 },
+      { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, SDL_FALSE, 0 },
+      { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB565, SDL_TRUE, 300 },
+      { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, SDL_TRUE, 30 }
+   };
+   const char *thresholds[] = { "0", "1" };
+   SDL_Surface *noise;
+   SDL_Surface *source;
+   SDL_Surface *plain;
+   SDL_Surface *rle;
+   SDL_Rect rect;
+   Uint32 *pixels;
+   Uint32 seed = 4321;
+   Uint32 pixel = 0;
+   int i, c, t, x, y, run, state, ret;
+   int checkFailCount1 = 0;
+   int checkFailCount2 = 0;
+   int checkFailCount3 = 0;
+
+   /* Runs of transparent, opaque and translucent noise, of all lengths,
+      with some lines and the last few fully transparent */
+   noise = _createSurfaceWithFormat(301, 211, SDL_PIXELFORMAT_ARGB8888);
+   SDLTest_AssertCheck(noise != NULL, "Verify noise surface is not NULL");
+   if (noise == NULL) {
+      return TEST_ABORTED;
+   }
+   pixels = (Uint32 *) noise->pixels;
+   for (y = 0; y < noise->h; y++) {
+      run = 0;
+      state = 0;
+      for (x = 0; x < noise->w; x++) {
+         if (run-- == 0) {
+            seed = seed * 1103515245 + 12345;
+            state = (seed >> 16) % 3;
+            run = (seed >> 20) % (((seed >> 8) % 8) ? 20 : 300);
+         }
+         seed = seed * 1103515245 + 12345;
+         if (y % 37 == 5 || y >= noise->h - 10) {
+            pixel = 0x00FF00FF;
+         } else if (state == 0) {
+            pixel = 0x00FF00FF;
+         } else if (state == 1) {
+            pixel = 0xFF000000 | (seed >> 8);
+         } else {
+            pixel = (((seed & 0xFF) % 254 + 1) << 24) | (seed >> 8);
+         }
+         pixels[y * noise->w + x] = pixel;
+      }
+   }
+
+   for (c = 0; c < SDL_arraysize(cases); c++) {
+      plain = _createSurfaceWithFormat(320, 240, cases[c].dst);
+      rle = _createSurfaceWithFormat(320, 240, cases[c].dst);
+      SDLTest_AssertCheck(plain != NULL && rle != NULL, "Verify destination surfaces are not NULL");
+      if (plain == NULL || rle == NULL) {
+         SDL_FreeSurface(plain);
+         SDL_FreeSurface(rle);
+         break;
+      }
+
+      for (t = 0; t < SDL_arraysize(thresholds); t++) {
+         SDL_FillRect(plain, NULL, SDL_MapRGB(plain->format, 20, 40, 60));
+         SDL_FillRect(rle, NULL, SDL_MapRGB(rle->format, 20, 40, 60));
+         SDL_SetHint(SDL_HINT_BLIT_THREADS_THRESHOLD, thresholds[t]);
+
+         /* The RLE encoding is thrown away with the surface, so each blit
+            gets a new one, of the same pixels */
+         for (i = 0; i < 2; i++) {
+            source = SDL_ConvertSurfaceFormat(noise, cases[c].src, 0);
+            if (source == NULL) {
+               checkFailCount1++;
+               continue;
+            }
+            if (cases[c].alpha) {
+               SDL_SetSurfaceBlendMode(source, SDL_BLENDMODE_BLEND);
+            } else {
+               SDL_SetSurfaceBlendMode(source, SDL_BLENDMODE_NONE);
+               SDL_SetColorKey(source, SDL_TRUE, SDL_MapRGB(source->format, 255, 0, 255));
+            }
+            SDL_SetSurfaceRLE(source, i);
+            rect.x = -3;
+            rect.y = 7;
+            ret = SDL_BlitSurface(source, NULL, i ? rle : plain, &rect);
+            if (ret != 0) {
+               checkFailCount1++;
+            }
+            if (i && !(source->flags & SDL_RLEACCEL)) {
+               SDLTest_LogError("Format %s was not RLE encoded", SDL_GetPixelFormatName(cases[c].src));
+               checkFailCount2++;
+            }
+            SDL_FreeSurface(source);
+         }
+         SDL_SetHint(SDL_HINT_BLIT_THREADS_THRESHOLD, "0");
+
+         ret = SDLTest_CompareSurfaces(rle, plain, cases[c].allowable_error);
+         if (ret != 0) {
+            SDLTest_LogError("Format %s to %s, threshold %s: %d pixels differ",
+                             SDL_GetPixelFormatName(cases[c].src),
+                             SDL_GetPixelFormatName(cases[c].dst), thresholds[t], ret);
+            checkFailCount3++;
+         }
+      }
+      SDL_FreeSurface(plain);
+      SDL_FreeSurface(rle);
+   }
+   SDLTest_AssertCheck(checkFailCount1 == 0, "Validate results from calls to SDL_BlitSurface, expected: 0, got: %i", checkFailCount1);
+   SDLTest_AssertCheck(checkFailCount2 == 0, "Validate that the sources were RLE encoded, expected: 0, got: %i", checkFailCount2);
+   SDLTest_AssertCheck(checkFailCount3 == 0, "Validate results from SDLTest_CompareSurfaces, expected: 0, got: %i", checkFailCount3);
+
+   SDL_FreeSurface(noise);
+   return TEST_COMPLETED;
+}
+
+/**
+ * @brief Tests surfaces created with SDL_HINT_SURFACE_ALIGNMENT.
+ */
+int
+surface_testSurfaceAlignment(void *arg)
+{
+   const Uint32 formats[] = { SDL_PIXELFORMAT_RGB332, SDL_PIXELFORMAT_RGB565, SDL_PIXELFORMAT_RGB24, SDL_PIXELFORMAT_ARGB8888 };
+   const int widths[] = { 1, 37, 301 };
+   const struct {
+      const char *hint;
+      int alignment;
+   } alignments[] = {
+      { "4", 4 }, { "16", 16 }, { "32", 32 }, { "64", 64 }, { "24", 4 }, { "128", 4 }
+   };
+   SDL_Surface *surface;
+   SDL_Surface *source;
+   SDL_Surface *plain;
+   SDL_Surface *aligned;
+   SDL_Rect rect;
+   Uint32 *pixels;
+   Uint32 seed = 5678;
+   int a, f, w, i, row, ret;
+   int checkFailCount1 = 0;
+   int checkFailCount2 = 0;
+   int checkFailCount3 = 0;
+   int checkFailCount4 = 0;
+
+   /* Pitch, pixels and flags of new surfaces */
+   for (a = 0; a < SDL_arraysize(alignments); a++) {
+      SDL_SetHint(SDL_HINT_SURFACE_ALIGNMENT, alignments[a].hint);
+      for (f = 0; f < SDL_arraysize(formats); f++) {
+         for (w = 0; w < SDL_arraysize(widths); w++) {
+            surface = _createSurfaceWithFormat(widths[w], 3, formats[f]);
+            if (surface == NULL) {
+               checkFailCount1++;
+               continue;
+            }
+            row = widths[w] * SDL_BYTESPERPIXEL(formats[f]);
+            if (surface->pitch != ((row + alignments[a].alignment - 1) & ~(alignments[a].alignment - 1))) {
+               SDLTest_LogError("Alignment %s, format %s, width %d: pitch %d",
+                                alignments[a].hint, SDL_GetPixelFormatName(formats[f]), widths[w], surface->pitch);
+               checkFailCount2++;
+            }
+            if (alignments[a].alignment > 4 &&
+                (((uintptr_t) surface->pixels & 63) || !(surface->flags & SDL_SIMD_ALIGNED))) {
+               SDLTest_LogError("Alignment %s, format %s, width %d: pixels not aligned",
+                                alignments[a].hint, SDL_GetPixelFormatName(formats[f]), widths[w]);
+               checkFailCount2++;
+            }
+            if (alignments[a].alignment == 4 && (surface->flags & SDL_SIMD_ALIGNED)) {
+               checkFailCount2++;
+            }
+            SDL_FreeSurface(surface);
+         }
+      }
+   }
+   SDLTest_AssertCheck(checkFailCount1 == 0, "Validate results from calls to SDL_CreateRGBSurface, expected: 0, got: %i", checkFailCount1);
+   SDLTest_AssertCheck(checkFailCount2 == 0, "Validate pitch and pixels of new surfaces, expected: 0, got: %i", checkFailCount2);
+
+   /* Plain and RLE encoded blits to an aligned surface, from an aligned
+      copy of the source, against the same blits between unaligned ones */
+   SDL_SetHint(SDL_HINT_SURFACE_ALIGNMENT, "4");
+   source = _createSurfaceWithFormat(301, 211, SDL_PIXELFORMAT_ARGB8888);
+   plain = _createSurfaceWithFormat(320, 240, SDL_PIXELFORMAT_ARGB8888);
+   SDL_SetHint(SDL_HINT_SURFACE_ALIGNMENT, "64");
+   aligned = _createSurfaceWithFormat(320, 240, SDL_PIXELFORMAT_ARGB8888);
+   SDLTest_AssertCheck(source != NULL && plain != NULL && aligned != NULL, "Verify surfaces are not NULL");
+   if (source == NULL || plain == NULL || aligned == NULL) {
+      SDL_SetHint(SDL_HINT_SURFACE_ALIGNMENT, "4");
+      SDL_FreeSurface(source);
+      SDL_FreeSurface(plain);
+      SDL_FreeSurface(aligned);
+      return TEST_ABORTED;
+   }
+   pixels = (Uint32 *) source->pixels;
+   for (i = 0; i < source->w * source->h; i++) {
+      seed = seed * 1103515245 + 12345;
+      pixels[i] = ((seed >> 8) % 5) ? (seed >> 8) : 0x00FF00FF;
+   }
+   SDL_SetSurfaceBlendMode(source, SDL_BLENDMODE_NONE);
+   surface = SDL_ConvertSurface(source, source->format, 0);
+   SDL_SetHint(SDL_HINT_SURFACE_ALIGNMENT, "4");
+   if (surface == NULL) {
+      checkFailCount3++;
+   } else {
+      SDL_SetSurfaceBlendMode(surface, SDL_BLENDMODE_NONE);
+      for (i = 0; i < 3; i++) {
+         if (i > 0) {
+            SDL_SetColorKey(source, SDL_TRUE, 0x00FF00FF);
+            SDL_SetColorKey(surface, SDL_TRUE, 0x00FF00FF);
+            SDL_SetSurfaceRLE(surface, 1);
+         }
+         SDL_FillRect(plain, NULL, 0);
+         SDL_FillRect(aligned, NULL, 0);
+         rect.x = 16;
+         rect.y = 3;
+         ret = SDL_BlitSurface(source, NULL, plain, &rect);
+         rect.x = 16;
+         rect.y = 3;
+         ret |= SDL_BlitSurface(surface, NULL, aligned, &rect);
+         if (ret != 0) {
+            checkFailCount3++;
+         }
+         ret = SDLTest_CompareSurfaces(aligned, plain, 0);
+         if (ret != 0) {
+            SDLTest_LogError("Blit %d: %d pixels differ", i, ret);
+            checkFailCount4++;
+         }
+         if (i > 0 && !(surface->flags & SDL_RLEACCEL)) {
+            SDLTest_LogError("Aligned surface was not RLE encoded");
+            checkFailCount4++;
+         }
+         /* Unpacking the encoding allocates the pixels again */
+         SDL_LockSurface(surface);
+         if (((uintptr_t) surface->pixels & 63) || !(surface->flags & SDL_SIMD_ALIGNED)) {
+            SDLTest_LogError("Blit %d: pixels not aligned", i);
+            checkFailCount4++;
+         }
+         SDL_SetSurfaceRLE(surface, 0);
+         SDL_UnlockSurface(surface);
+      }
+      SDL_FreeSurface(surface);
+   }
+   SDLTest_AssertCheck(checkFailCount3 == 0, "Validate results from calls to SDL_BlitSurface, expected: 0, got: %i", checkFailCount3);
+   SDLTest_AssertCheck(checkFailCount4 == 0, "Validate blits between aligned surfaces, expected: 0, got: %i", checkFailCount4);
+
+   SDL_FreeSurface(source);
+   SDL_FreeSurface(plain);
+   SDL_FreeSurface(aligned);
+   return TEST_COMPLETED;
+}
+
+/* Fills every byte of a surface, padding included, with a repeatable pattern */
+static void
+_fillPattern(SDL_Surface *surface, Uint32 seed)
+{
+   Uint8 *pixels = (Uint8 *) surface->pixels;
+   int i;
+
+   for (i = 0; i < surface->pitch * surface->h; i++) {
+      seed = seed * 1103515245 + 12345;
+      pixels[i] = (Uint8) (seed >> 16);
+   }
+}
+
+/**
+ * @brief Tests fills and plain copies starting and ending at every alignment,
+ *        on small surfaces and on ones big enough to be written around the
+ *        cache.
+ */
+int
+surface_testFillAndCopy(void *arg)
+{
+   const Uint32 formats[] = { SDL_PIXELFORMAT_RGB332, SDL_PIXELFORMAT_RGB565, SDL_PIXELFORMAT_ARGB8888 };
+   const int widths[] = { 1, 3, 31, 33, 63, 129, 301 };
+   SDL_Surface *source;
+   SDL_Surface *surface;
+   SDL_Surface *expected;
+   SDL_Rect srcrect;
+   SDL_Rect rect;
+   Uint8 *row;
+   Uint32 color;
+   int big, f, w, x, y, i, bpp, width, height, ret;
+   int checkFailCount1 = 0;
+   int checkFailCount2 = 0;
+   int checkFailCount3 = 0;
+   int checkFailCount4 = 0;
+
+   for (big = 0; big < 2; big++) {
+      for (f = 0; f < SDL_arraysize(formats); f++) {
+         bpp = SDL_BYTESPERPIXEL(formats[f]);
+         /* Big fills and copies are over 8MB, so they're streamed */
+         width = big ? (4104 / bpp) : 320;
+         height = big ? 2100 : 4;
+         source = _createSurfaceWithFormat(width, height, formats[f]);
+         surface = _createSurfaceWithFormat(width, height, formats[f]);
+         expected = _createSurfaceWithFormat(width, height, formats[f]);
+         if (source == NULL || surface == NULL || expected == NULL) {
+            checkFailCount1++;
+            SDL_FreeSurface(source);
+            SDL_FreeSurface(surface);
+            SDL_FreeSurface(expected);
+            continue;
+         }
+         SDL_SetSurfaceBlendMode(source, SDL_BLENDMODE_NONE);
+         _fillPattern(source, 1234);
+         color = SDL_MapRGB(surface->format, 0x12, 0x9A, 0xE7);
+
+         for (w = 0; w < (big ? 1 : SDL_arraysize(widths)); w++) {
+            for (x = 0; x < 4; x++) {
+               /* Copy from a source lined up differently to the destination */
+               srcrect.x = (x + 1) % 4;
+               srcrect.y = 0;
+               srcrect.w = big ? width - 4 : widths[w];
+               srcrect.h = height - 1;
+               rect.x = x;
+               rect.y = 1;
+               _fillPattern(surface, 5678);
+               _fillPattern(expected, 5678);
+               for (y = 0; y < srcrect.h; y++) {
+                  SDL_memcpy((Uint8 *) expected->pixels + (rect.y + y) * expected->pitch + rect.x * bpp,
+                             (Uint8 *) source->pixels + (srcrect.y + y) * source->pitch + srcrect.x * bpp,
+                             srcrect.w * bpp);
+               }
+               ret = SDL_BlitSurface(source, &srcrect, surface, &rect);
+               if (ret != 0) {
+                  checkFailCount2++;
+               }
+               if (SDL_memcmp(surface->pixels, expected->pixels, surface->pitch * surface->h) != 0) {
+                  SDLTest_LogError("Copy of %s, x %d, width %d: pixels differ",
+                                   SDL_GetPixelFormatName(formats[f]), x, srcrect.w);
+                  checkFailCount3++;
+               }
+
+               rect.x = x;
+               rect.y = 1;
+               rect.w = srcrect.w;
+               rect.h = srcrect.h;
+               _fillPattern(surface, 9012);
+               _fillPattern(expected, 9012);
+               for (y = 0; y < rect.h; y++) {
+                  row = (Uint8 *) expected->pixels + (rect.y + y) * expected->pitch + rect.x * bpp;
+                  for (i = 0; i < rect.w; i++) {
+                     switch (bpp) {
+                     case 1:
+                        row[i] = (Uint8) color;
+                        break;
+                     case 2:
+                        ((Uint16 *) row)[i] = (Uint16) color;
+                        break;
+                     default:
+                        ((Uint32 *) row)[i] = color;
+                        break;
+                     }
+                  }
+               }
+               ret = SDL_FillRect(surface, &rect, color);
+               if (ret != 0) {
+                  checkFailCount2++;
+               }
+               if (SDL_memcmp(surface->pixels, expected->pixels, surface->pitch * surface->h) != 0) {
+                  SDLTest_LogError("Fill of %s, x %d, width %d: pixels differ",
+                                   SDL_GetPixelFormatName(formats[f]), x, rect.w);
+                  checkFailCount4++;
+               }
+            }
+         }
+         SDL_FreeSurface(source);
+         SDL_FreeSurface(surface);
+         SDL_FreeSurface(expected);
+      }
+   }
+   SDLTest_AssertCheck(checkFailCount1 == 0, "Validate results from calls to SDL_CreateRGBSurface, expected: 0, got: %i", checkFailCount1);
+   SDLTest_AssertCheck(checkFailCount2 == 0, "Validate results from calls to SDL_BlitSurface and SDL_FillRect, expected: 0, got: %i", checkFailCount2);
+   SDLTest_AssertCheck(checkFailCount3 == 0, "Validate copied pixels, expected: 0, got: %i", checkFailCount3);
+   SDLTest_AssertCheck(checkFailCount4 == 0, "Validate filled pixels, expected: 0, got: %i", checkFailCount4);
+
+   return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Surface test cases */
@@ -627,11 +1362,30 @@ static const SDLTest_TestCaseReference surfaceTest11 =
 static const SDLTest_TestCaseReference surfaceTest12 =
         { (SDLTest_TestCaseFp)surface_testBlitBlendMod, "surface_testBlitBlendMod", "Tests blitting routines with mod blending mode.", TEST_ENABLED};
 
+static const SDLTest_TestCaseReference surfaceTest13 =
+        { (SDLTest_TestCaseFp)surface_testBlitThreads, "surface_testBlitThreads", "Tests blits split between threads against blits done in one go.", TEST_ENABLED};
+
+static const SDLTest_TestCaseReference surfaceTest14 =
+        { (SDLTest_TestCaseFp)surface_testBlitExact, "surface_testBlitExact", "Tests 32 bit blits against a pixel by pixel reference.", TEST_ENABLED};
+
+static const SDLTest_TestCaseReference surfaceTest15 =
+        { (SDLTest_TestCaseFp)surface_testBlitStateChanges, "surface_testBlitStateChanges", "Tests changing modulation and blend mode between blits.", TEST_ENABLED};
+
+static const SDLTest_TestCaseReference surfaceTest16 =
+        { (SDLTest_TestCaseFp)surface_testBlitRLE, "surface_testBlitRLE", "Tests RLE accelerated blits against plain ones.", TEST_ENABLED};
+
+static const SDLTest_TestCaseReference surfaceTest17 =
+        { (SDLTest_TestCaseFp)surface_testSurfaceAlignment, "surface_testSurfaceAlignment", "Tests surfaces with aligned rows and pixels.", TEST_ENABLED};
+
+static const SDLTest_TestCaseReference surfaceTest18 =
+        { (SDLTest_TestCaseFp)surface_testFillAndCopy, "surface_testFillAndCopy", "Tests fills and copies at every alignment, cached and streamed.", TEST_ENABLED};
+
 /* Sequence of Surface test cases */
 static const SDLTest_TestCaseReference *surfaceTests[] =  {
     &surfaceTest1, &surfaceTest2, &surfaceTest3, &surfaceTest4, &surfaceTest5,
     &surfaceTest6, &surfaceTest7, &surfaceTest8, &surfaceTest9, &surfaceTest10,
-    &surfaceTest11, &surfaceTest12, NULL
+    &surfaceTest11, &surfaceTest12, &surfaceTest13, &surfaceTest14, &surfaceTest15,
+    &surfaceTest16, &surfaceTest17, &surfaceTest18, NULL
 };
 
 /* Surface test suite (global) */
@@ -0,0 +1,189 @@
+/*
+  Copyright (C) 1997-2014 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Benchmark large surface blits, done in one go and split between threads
+   with SDL_BLIT_THREADS_THRESHOLD:
+     ./testblitbench [width height] [iterations]
+
+   The default is a 4K frame.  Each line is one kind of blit, with its
+   throughput in megapixels per second written.  The "render" lines draw
+   through the software renderer with SDL_HINT_RENDER_SCALE_QUALITY set,
+   to compare filtered scaling with the nearest pixel.
+*/
+
+#include "SDL.h"
+
+typedef struct
+{
+    const char *name;
+    Uint32 src_format;
+    Uint32 dst_format;
+    SDL_BlendMode blendMode;
+    int scaled;     /* The source is half the size of the destination */
+    const char *quality;    /* Draw with the software renderer if set */
+} Blit;
+
+static const Blit blits[] = {
+    { "copy ARGB8888", SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, SDL_BLENDMODE_NONE, 0 },
+    { "ARGB8888 to RGB565", SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB565, SDL_BLENDMODE_NONE, 0 },
+    { "RGB565 to ARGB8888", SDL_PIXELFORMAT_RGB565, SDL_PIXELFORMAT_ARGB8888, SDL_BLENDMODE_NONE, 0 },
+    { "ARGB8888 to ABGR8888", SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ABGR8888, SDL_BLENDMODE_NONE, 0 },
+    { "blend ARGB8888", SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, SDL_BLENDMODE_BLEND, 0 },
+    { "blend to RGB565", SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB565, SDL_BLENDMODE_BLEND, 0 },
+    { "scale ARGB8888", SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, SDL_BLENDMODE_NONE, 1 },
+    { "scale blend ARGB8888", SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, SDL_BLENDMODE_BLEND, 1 },
+    { "render scale nearest", SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, SDL_BLENDMODE_NONE, 1, "nearest" },
+    { "render scale linear", SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888, SDL_BLENDMODE_NONE, 1, "linear" },
+    { "render blend nearest", SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, SDL_BLENDMODE_BLEND, 1, "nearest" },
+    { "render blend linear", SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, SDL_BLENDMODE_BLEND, 1, "linear" },
+};
+
+static SDL_Surface *
+create_surface(int w, int h, Uint32 format)
+{
+    SDL_Surface *surface;
+    Uint32 rmask, gmask, bmask, amask;
+    Uint32 seed = 12345;
+    Uint8 *pixels;
+    int bpp, i;
+
+    SDL_PixelFormatEnumToMasks(format, &bpp, &rmask, &gmask, &bmask, &amask);
+    surface = SDL_CreateRGBSurface(0, w, h, bpp, rmask, gmask, bmask, amask);
+    if (surface) {
+        pixels = (Uint8 *) surface->pixels;
+        for (i = 0; i < surface->h * surface->pitch; i++) {
+            seed = seed * 1103515245 + 12345;
+            pixels[i] = (Uint8) (seed >> 16);
+        }
+    }
+    return surface;
+}
+
+/* Returns megapixels per second, or a negative number on error */
+/* Draw with the software renderer instead of blitting */
+static int
+render(const Blit *blit, SDL_Surface *src, SDL_Surface *dst, int iterations, Uint64 *ticks)
+{
+    SDL_Renderer *renderer;
+    SDL_Texture *texture;
+    Uint64 start;
+    int i, status = 0;
+
+    renderer = SDL_CreateSoftwareRenderer(dst);
+    if (!renderer) {
+        return -1;
+    }
+    texture = SDL_CreateTextureFromSurface(renderer, src);
+    if (!texture) {
+        SDL_DestroyRenderer(renderer);
+        return -1;
+    }
+    SDL_SetTextureBlendMode(texture, blit->blendMode);
+    SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, blit->quality);
+
+    SDL_RenderCopy(renderer, texture, NULL, NULL);
+    start = SDL_GetPerformanceCounter();
+    for (i = 0; i < iterations; i++) {
+        status |= SDL_RenderCopy(renderer, texture, NULL, NULL);
+    }
+    *ticks = SDL_GetPerformanceCounter() - start;
+
+    SDL_DestroyTexture(texture);
+    SDL_DestroyRenderer(renderer);
+    return status;
+}
+
+static double
+run(const Blit *blit, int w, int h, int iterations, const char *threshold)
+{
+    SDL_Surface *src, *dst;
+    Uint64 start, ticks;
+    int i, status = 0;
+
+    src = create_surface(blit->scaled ? w / 2 : w, blit->scaled ? h / 2 : h, blit->src_format);
+    dst = create_surface(w, h, blit->dst_format);
+    if (!src || !dst) {
+        SDL_FreeSurface(src);
+        SDL_FreeSurface(dst);
+        return -1.0;
+    }
+    SDL_SetSurfaceBlendMode(src, blit->blendMode);
+    SDL_SetHint(SDL_HINT_BLIT_THREADS_THRESHOLD, threshold);
+
+    if (blit->quality) {
+        status = render(blit, src, dst, iterations, &ticks);
+    } else {
+        /* The first blit sets up the blit mapping */
+        SDL_BlitScaled(src, NULL, dst, NULL);
+        start = SDL_GetPerformanceCounter();
+        for (i = 0; i < iterations; i++) {
+            status |= SDL_BlitScaled(src, NULL, dst, NULL);
+        }
+        ticks = SDL_GetPerformanceCounter() - start;
+    }
+
+    SDL_FreeSurface(src);
+    SDL_FreeSurface(dst);
+    if (status < 0) {
+        return -1.0;
+    }
+    return ((double) w * h * iterations / 1000000.0) *
+           SDL_GetPerformanceFrequency() / (ticks ? ticks : 1);
+}
+
+int
+main(int argc, char **argv)
+{
+    int w = 3840, h = 2160;
+    int iterations = 20;
+    double serial, threaded;
+    int i;
+
+    /* Enable standard application logging */
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    if (argc > 2) {
+        w = SDL_atoi(argv[1]);
+        h = SDL_atoi(argv[2]);
+    }
+    if (argc > 3) {
+        iterations = SDL_atoi(argv[3]);
+    }
+    if ((w <= 1) || (h <= 1) || (iterations <= 0)) {
+        SDL_Log("USAGE: %s [width height] [iterations]\n", argv[0]);
+        return 1;
+    }
+
+    if (SDL_Init(0) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    SDL_Log("%d blits of %dx%d on %d CPUs, in megapixels per second\n",
+            iterations, w, h, SDL_GetCPUCount());
+    SDL_Log("%-22s  %10s  %10s\n", "", "1 thread", "threaded");
+    for (i = 0; i < SDL_arraysize(blits); i++) {
+        serial = run(&blits[i], w, h, iterations, "0");
+        threaded = run(&blits[i], w, h, iterations, "1");
+        if (serial < 0.0 || threaded < 0.0) {
+            SDL_Log("%-22s  failed: %s\n", blits[i].name, SDL_GetError());
+            continue;
+        }
+        SDL_Log("%-22s  %10.1f  %10.1f  %5.2fx\n", blits[i].name,
+                serial, threaded, threaded / serial);
+    }
+
+    SDL_Quit();
+    return 0;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,156 @@
+/*
+  Copyright (C) 1997-2014 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Benchmark SDL_FillRect() and plain surface copies over a matrix of pixel
+   sizes, widths and row alignments:
+     ./testfillbench [height] [iterations]
+
+   The rows of each surface start the given number of bytes past a 64 byte
+   boundary.  Fills and copies of 8 MB or more use non-temporal stores, so
+   the widest surfaces show those, as long as they're tall enough.  The
+   throughput is written in megabytes per second.
+*/
+
+#include "SDL.h"
+
+static const Uint32 formats[] = {
+    SDL_PIXELFORMAT_RGB332,
+    SDL_PIXELFORMAT_RGB565,
+    SDL_PIXELFORMAT_RGB24,
+    SDL_PIXELFORMAT_ARGB8888
+};
+static const int widths[] = { 64, 640, 1920, 3840 };
+static const int offsets[] = { 0, 4, 16 };
+
+/* A surface with its pixels starting offset bytes past a 64 byte boundary,
+   and its pitch a multiple of 64 */
+static SDL_Surface *
+create_surface(int w, int h, Uint32 format, int offset, void **mem)
+{
+    SDL_Surface *surface;
+    Uint32 rmask, gmask, bmask, amask;
+    Uint8 *pixels;
+    int bpp, pitch;
+
+    SDL_PixelFormatEnumToMasks(format, &bpp, &rmask, &gmask, &bmask, &amask);
+    pitch = ((w * SDL_BYTESPERPIXEL(format)) + 63) & ~63;
+    *mem = SDL_malloc(h * pitch + 128);
+    if (!*mem) {
+        return NULL;
+    }
+    pixels = (Uint8 *) (((uintptr_t) *mem + 63) & ~(uintptr_t) 63) + offset;
+    SDL_memset(pixels, 0x55, h * pitch);
+    surface = SDL_CreateRGBSurfaceFrom(pixels, w, h, bpp, pitch, rmask, gmask, bmask, amask);
+    if (!surface) {
+        SDL_free(*mem);
+        *mem = NULL;
+    }
+    return surface;
+}
+
+/* Returns megabytes per second for fills and copies, or negative numbers
+   on error */
+static void
+run(Uint32 format, int w, int h, int offset, int iterations, double *fill, double *copy)
+{
+    SDL_Surface *src, *dst;
+    void *srcmem = NULL, *dstmem = NULL;
+    Uint64 start, ticks;
+    double bytes;
+    int i, status = 0;
+
+    *fill = *copy = -1.0;
+    src = create_surface(w, h, format, offset, &srcmem);
+    dst = create_surface(w, h, format, offset, &dstmem);
+    if (!src || !dst) {
+        goto done;
+    }
+    bytes = (double) w * SDL_BYTESPERPIXEL(format) * h * iterations;
+
+    start = SDL_GetPerformanceCounter();
+    for (i = 0; i < iterations; i++) {
+        status |= SDL_FillRect(dst, NULL, (Uint32) i * 0x01010101);
+    }
+    ticks = SDL_GetPerformanceCounter() - start;
+    if (status == 0) {
+        *fill = (bytes / (1024.0 * 1024.0)) * SDL_GetPerformanceFrequency() / (ticks ? ticks : 1);
+    }
+
+    /* The first blit sets up the blit mapping */
+    SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_NONE);
+    status = SDL_BlitSurface(src, NULL, dst, NULL);
+    start = SDL_GetPerformanceCounter();
+    for (i = 0; i < iterations; i++) {
+        status |= SDL_BlitSurface(src, NULL, dst, NULL);
+    }
+    ticks = SDL_GetPerformanceCounter() - start;
+    if (status == 0) {
+        *copy = (bytes / (1024.0 * 1024.0)) * SDL_GetPerformanceFrequency() / (ticks ? ticks : 1);
+    }
+
+done:
+    SDL_FreeSurface(src);
+    SDL_FreeSurface(dst);
+    SDL_free(srcmem);
+    SDL_free(dstmem);
+}
+
+int
+main(int argc, char **argv)
+{
+    int h = 2160;
+    int iterations = 20;
+    double fill, copy;
+    int f, w, o;
+
+    /* Enable standard application logging */
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    if (argc > 1) {
+        h = SDL_atoi(argv[1]);
+    }
+    if (argc > 2) {
+        iterations = SDL_atoi(argv[2]);
+    }
+    if ((h <= 0) || (iterations <= 0)) {
+        SDL_Log("USAGE: %s [height] [iterations]\n", argv[0]);
+        return 1;
+    }
+
+    if (SDL_Init(0) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    SDL_Log("%d fills and copies of %d rows, in megabytes per second%s%s\n",
+            iterations, h, SDL_HasSSE2() ? ", SSE2" : "", SDL_HasAVX2() ? ", AVX2" : "");
+    SDL_Log("%-24s  %6s  %6s  %10s  %10s\n", "format", "width", "offset", "fill", "copy");
+    for (f = 0; f < SDL_arraysize(formats); f++) {
+        for (w = 0; w < SDL_arraysize(widths); w++) {
+            for (o = 0; o < SDL_arraysize(offsets); o++) {
+                run(formats[f], widths[w], h, offsets[o], iterations, &fill, &copy);
+                if (fill < 0.0 || copy < 0.0) {
+                    SDL_Log("%-24s  %6d  %6d  failed: %s\n", SDL_GetPixelFormatName(formats[f]),
+                            widths[w], offsets[o], SDL_GetError());
+                    continue;
+                }
+                SDL_Log("%-24s  %6d  %6d  %10.1f  %10.1f\n", SDL_GetPixelFormatName(formats[f]),
+                        widths[w], offsets[o], fill, copy);
+            }
+        }
+    }
+
+    SDL_Quit();
+    return 0;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
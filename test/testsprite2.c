@@ -34,6 +34,9 @@ static SDL_Rect *velocities;
 static int sprite_w, sprite_h;
 static SDL_BlendMode blendMode = SDL_BLENDMODE_BLEND;
 
+/* Number of copies and fills drawn, for the benchmark */
+static Uint32 draws = 0;
+
 /* Number of iterations to move sprites - used for visual tests. */
 /* -1: infinite random moves (default); >=0: enables N deterministic moves */
 static int iterations = -1;
@@ -225,6 +228,7 @@ MoveSprites(SDL_Renderer * renderer, SDL_Texture * sprite)
         /* Blit the sprite onto the screen */
         SDL_RenderCopy(renderer, sprite, NULL, position);
     }
+    draws += 8 + num_sprites;
 
     /* Update the screen! */
     SDL_RenderPresent(renderer);
@@ -282,6 +286,12 @@ main(int argc, char *argv[])
             } else if (SDL_strcasecmp(argv[i], "--cyclealpha") == 0) {
                 cycle_alpha = SDL_TRUE;
                 consumed = 1;
+            } else if (SDL_strcasecmp(argv[i], "--batch") == 0) {
+                SDL_SetHint(SDL_HINT_RENDER_BATCHING, "1");
+                consumed = 1;
+            } else if (SDL_strcasecmp(argv[i], "--nobatch") == 0) {
+                SDL_SetHint(SDL_HINT_RENDER_BATCHING, "0");
+                consumed = 1;
             } else if (SDL_isdigit(*argv[i])) {
                 num_sprites = SDL_atoi(argv[i]);
                 consumed = 1;
@@ -291,7 +301,7 @@ main(int argc, char *argv[])
             }
         }
         if (consumed < 0) {
-            SDL_Log("Usage: %s %s [--blend none|blend|add|mod] [--cyclecolor] [--cyclealpha] [--iterations N] [num_sprites] [icon.bmp]\n",
+            SDL_Log("Usage: %s %s [--blend none|blend|add|mod] [--cyclecolor] [--cyclealpha] [--batch|--nobatch] [--iterations N] [num_sprites] [icon.bmp]\n",
                     argv[0], SDLTest_CommonUsage(state));
             quit(1);
         }
@@ -369,6 +379,8 @@ main(int argc, char *argv[])
     if (now > then) {
         double fps = ((double) frames * 1000) / (now - then);
         SDL_Log("%2.2f frames per second\n", fps);
+        SDL_Log("%2.2f draws per second (%d sprites)\n",
+                ((double) draws * 1000) / (now - then), num_sprites);
     }
     quit(0);
     return 0;
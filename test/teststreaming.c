@@ -15,6 +15,13 @@
  *                                                                              *
  ********************************************************************************/
 
+/* With --benchmark this streams a large texture as fast as possible instead,
+   and reports the texture upload rate:
+     ./teststreaming --benchmark [width height] [frames] [--update]
+   --update uploads with SDL_UpdateTexture() rather than lock and unlock.
+   SDL_RENDER_OPENGL_PBO=0 turns off pixel buffer uploads for comparison.
+*/
+
 #include <stdlib.h>
 #include <stdio.h>
 
@@ -82,6 +89,67 @@ void UpdateTexture(SDL_Texture *texture, int frame)
     SDL_UnlockTexture(texture);
 }
 
+/* Upload a new frame of a moving gradient every frame, and report MB/s */
+void Benchmark(SDL_Renderer *renderer, int w, int h, int frames, SDL_bool update)
+{
+    SDL_Texture *texture;
+    Uint32 *frame;
+    Uint32 *dst;
+    void *pixels;
+    int pitch;
+    int i, row, col;
+    Uint64 start, upload_start, upload_ticks = 0;
+    double elapsed, upload, mb;
+
+    texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, w, h);
+    frame = (Uint32 *) SDL_malloc(w * h * sizeof(Uint32));
+    if (!texture || !frame) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't set create texture: %s\n", SDL_GetError());
+        quit(5);
+    }
+
+    start = SDL_GetPerformanceCounter();
+    for (i = 0; i < frames; ++i) {
+        /* Generating the frame isn't part of the upload time */
+        dst = frame;
+        for (row = 0; row < h; ++row) {
+            for (col = 0; col < w; ++col) {
+                *dst++ = 0xFF000000 | ((row + i) & 0xFF) << 16 | ((col + i) & 0xFF) << 8 | (i & 0xFF);
+            }
+        }
+
+        upload_start = SDL_GetPerformanceCounter();
+        if (update) {
+            SDL_UpdateTexture(texture, NULL, frame, w * sizeof(Uint32));
+        } else {
+            if (SDL_LockTexture(texture, NULL, &pixels, &pitch) < 0) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't lock texture: %s\n", SDL_GetError());
+                quit(5);
+            }
+            for (row = 0; row < h; ++row) {
+                SDL_memcpy((Uint8 *)pixels + row * pitch, frame + row * w, w * sizeof(Uint32));
+            }
+            SDL_UnlockTexture(texture);
+        }
+        upload_ticks += SDL_GetPerformanceCounter() - upload_start;
+
+        SDL_RenderCopy(renderer, texture, NULL, NULL);
+        SDL_RenderPresent(renderer);
+        SDL_PumpEvents();
+    }
+    elapsed = (double)(SDL_GetPerformanceCounter() - start) / SDL_GetPerformanceFrequency();
+    upload = (double)upload_ticks / SDL_GetPerformanceFrequency();
+
+    mb = ((double)w * h * sizeof(Uint32) * frames) / (1024.0 * 1024.0);
+    SDL_Log("%d frames of %dx%d with %s: %.1f frames per second\n",
+            frames, w, h, update ? "SDL_UpdateTexture" : "SDL_LockTexture", frames / elapsed);
+    SDL_Log("Upload: %.1f MB/s in upload calls, %.1f MB/s overall\n",
+            upload > 0.0 ? mb / upload : 0.0, mb / elapsed);
+
+    SDL_free(frame);
+    SDL_DestroyTexture(texture);
+}
+
 int
 main(int argc, char **argv)
 {
@@ -92,23 +160,51 @@ main(int argc, char **argv)
     SDL_Event event;
     SDL_bool done = SDL_FALSE;
     int frame;
+    SDL_bool benchmark = SDL_FALSE;
+    SDL_bool update = SDL_FALSE;
+    int bench_w = 1920, bench_h = 1080, bench_frames = 300;
+    int i, arg = 0;
 
 	/* Enable standard application logging */
     SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
 
+    for (i = 1; i < argc; ++i) {
+        if (SDL_strcmp(argv[i], "--benchmark") == 0) {
+            benchmark = SDL_TRUE;
+        } else if (SDL_strcmp(argv[i], "--update") == 0) {
+            update = SDL_TRUE;
+        } else if (benchmark && arg == 0 && i + 1 < argc && *argv[i + 1] != '-') {
+            bench_w = SDL_atoi(argv[i]);
+            bench_h = SDL_atoi(argv[++i]);
+            ++arg;
+        } else if (benchmark && arg <= 1) {
+            bench_frames = SDL_atoi(argv[i]);
+            arg = 2;
+        } else {
+            SDL_Log("USAGE: %s [--benchmark [width height] [frames] [--update]]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (benchmark && (bench_w <= 0 || bench_h <= 0 || bench_frames <= 0)) {
+        SDL_Log("USAGE: %s [--benchmark [width height] [frames] [--update]]\n", argv[0]);
+        return 1;
+    }
+
     if (SDL_Init(SDL_INIT_VIDEO) < 0) {
         SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s\n", SDL_GetError());
         return 1;
     }
 
     /* load the moose images */
-    handle = SDL_RWFromFile("moose.dat", "rb");
-    if (handle == NULL) {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Can't find the file moose.dat !\n");
-        quit(2);
+    if (!benchmark) {
+        handle = SDL_RWFromFile("moose.dat", "rb");
+        if (handle == NULL) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Can't find the file moose.dat !\n");
+            quit(2);
+        }
+        SDL_RWread(handle, MooseFrames, MOOSEFRAME_SIZE, MOOSEFRAMES_COUNT);
+        SDL_RWclose(handle);
     }
-    SDL_RWread(handle, MooseFrames, MOOSEFRAME_SIZE, MOOSEFRAMES_COUNT);
-    SDL_RWclose(handle);
 
 
     /* Create the window and renderer */
@@ -128,6 +224,15 @@ main(int argc, char **argv)
         quit(4);
     }
 
+    if (benchmark) {
+        SDL_RendererInfo info;
+        SDL_GetRendererInfo(renderer, &info);
+        SDL_Log("Using %s renderer\n", info.name);
+        Benchmark(renderer, bench_w, bench_h, bench_frames, update);
+        SDL_DestroyRenderer(renderer);
+        quit(0);
+    }
+
     MooseTexture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, MOOSEPIC_W, MOOSEPIC_H);
     if (!MooseTexture) {
         SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't set create texture: %s\n", SDL_GetError());
@@ -0,0 +1,176 @@
+/*
+  Copyright (C) 1997-2014 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Benchmark the software renderer with SDL_RENDER_SOFTWARE_THREADS set
+   from 1 up to a number of threads, drawing offscreen:
+     ./testswrender [max threads] [frames] [sprites] [width height]
+
+   Each frame is a clear, a blended fill per 16 sprites, and the sprites,
+   half of them alpha blended.  The max threads default to the CPU count.
+*/
+
+#include "SDL.h"
+
+#define SPRITE_W    64
+#define SPRITE_H    64
+
+static SDL_Texture *
+create_sprite(SDL_Renderer *renderer, int blended)
+{
+    Uint32 pixels[SPRITE_W * SPRITE_H];
+    SDL_Texture *texture;
+    int x, y, dx, dy;
+
+    for (y = 0; y < SPRITE_H; y++) {
+        for (x = 0; x < SPRITE_W; x++) {
+            dx = x - SPRITE_W / 2;
+            dy = y - SPRITE_H / 2;
+            pixels[y * SPRITE_W + x] =
+                ((dx * dx + dy * dy) < (SPRITE_W * SPRITE_W / 4) ? 0xff000000 : 0) |
+                ((x * 4) & 0xff) << 16 | ((y * 4) & 0xff) << 8 | 0x80;
+        }
+    }
+    texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888,
+                                SDL_TEXTUREACCESS_STATIC, SPRITE_W, SPRITE_H);
+    if (texture) {
+        SDL_UpdateTexture(texture, NULL, pixels, SPRITE_W * sizeof(Uint32));
+        SDL_SetTextureBlendMode(texture, blended ? SDL_BLENDMODE_BLEND : SDL_BLENDMODE_NONE);
+    }
+    return texture;
+}
+
+/* Returns frames per second, or a negative number on error */
+static double
+run(int threads, int frames, int sprites, int w, int h, Uint32 *sum)
+{
+    SDL_Surface *surface;
+    SDL_Renderer *renderer;
+    SDL_Texture *textures[2];
+    SDL_Rect rect;
+    char hint[16];
+    Uint64 start, ticks;
+    Uint32 seed;
+    int i, frame;
+
+    surface = SDL_CreateRGBSurface(0, w, h, 32, 0x00FF0000, 0x0000FF00, 0x000000FF, 0);
+    if (!surface) {
+        return -1.0;
+    }
+    SDL_snprintf(hint, sizeof(hint), "%d", threads);
+    SDL_SetHint(SDL_HINT_RENDER_SOFTWARE_THREADS, hint);
+    renderer = SDL_CreateSoftwareRenderer(surface);
+    if (!renderer) {
+        SDL_FreeSurface(surface);
+        return -1.0;
+    }
+    textures[0] = create_sprite(renderer, 0);
+    textures[1] = create_sprite(renderer, 1);
+
+    start = SDL_GetPerformanceCounter();
+    for (frame = 0; frame < frames; frame++) {
+        seed = 12345 + frame;
+        SDL_SetRenderDrawColor(renderer, 16, 32, 48, 255);
+        SDL_RenderClear(renderer);
+        for (i = 0; i < sprites; i++) {
+            seed = seed * 1103515245 + 12345;
+            rect.x = (int) ((seed >> 8) % (w + SPRITE_W)) - SPRITE_W;
+            seed = seed * 1103515245 + 12345;
+            rect.y = (int) ((seed >> 8) % (h + SPRITE_H)) - SPRITE_H;
+            rect.w = SPRITE_W;
+            rect.h = SPRITE_H;
+            if ((i % 16) == 0) {
+                rect.w *= 4;
+                rect.h *= 2;
+                SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+                SDL_SetRenderDrawColor(renderer, (Uint8) i, 128, 64, 96);
+                SDL_RenderFillRect(renderer, &rect);
+                rect.w = SPRITE_W;
+                rect.h = SPRITE_H;
+            }
+            SDL_RenderCopy(renderer, textures[i & 1], NULL, &rect);
+        }
+        SDL_RenderPresent(renderer);
+    }
+    ticks = SDL_GetPerformanceCounter() - start;
+
+    /* A checksum of the last frame, which should be the same for every run */
+    *sum = 2166136261u;
+    for (i = 0; i < surface->h * surface->pitch; i++) {
+        *sum = (*sum ^ ((Uint8 *) surface->pixels)[i]) * 16777619u;
+    }
+
+    SDL_DestroyRenderer(renderer);
+    SDL_FreeSurface(surface);
+    return (double) frames * SDL_GetPerformanceFrequency() / (ticks ? ticks : 1);
+}
+
+int
+main(int argc, char **argv)
+{
+    int maxthreads = 0;
+    int frames = 100;
+    int sprites = 2000;
+    int w = 1920, h = 1080;
+    int threads;
+    double fps, serial = 0.0;
+    Uint32 sum;
+
+    /* Enable standard application logging */
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    if (argc > 1) {
+        maxthreads = SDL_atoi(argv[1]);
+    }
+    if (argc > 2) {
+        frames = SDL_atoi(argv[2]);
+    }
+    if (argc > 3) {
+        sprites = SDL_atoi(argv[3]);
+    }
+    if (argc > 5) {
+        w = SDL_atoi(argv[4]);
+        h = SDL_atoi(argv[5]);
+    }
+    if (maxthreads <= 0) {
+        maxthreads = SDL_GetCPUCount();
+    }
+    if ((frames <= 0) || (sprites < 0) || (w <= 0) || (h <= 0)) {
+        SDL_Log("USAGE: %s [max threads] [frames] [sprites] [width height]\n", argv[0]);
+        return 1;
+    }
+
+    if (SDL_Init(0) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    SDL_Log("%d frames of %d sprites at %dx%d on %d CPUs\n",
+            frames, sprites, w, h, SDL_GetCPUCount());
+    for (threads = 1; threads <= maxthreads; threads++) {
+        fps = run(threads, frames, sprites, w, h, &sum);
+        if (fps < 0.0) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't create renderer: %s\n", SDL_GetError());
+            SDL_Quit();
+            return 2;
+        }
+        if (threads == 1) {
+            serial = fps;
+        }
+        SDL_Log("%2d threads: %8.1f frames/s  %5.2fx  (checksum %08x)\n",
+                threads, fps, fps / serial, sum);
+    }
+
+    SDL_Quit();
+    return 0;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,214 @@
+/*
+  Copyright (C) 1997-2014 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Compare loading a WAVE file whole with SDL_LoadWAV_RW() against streaming
+   it with SDL_OpenWAVStream_RW(): time until the first sample is available,
+   time to decode everything, and peak memory use.
+
+   Peak memory only ever grows, so run each mode in its own process:
+     ./testwavstream --generate long.wav 600
+     ./testwavstream long.wav load
+     ./testwavstream long.wav stream
+*/
+
+#include "SDL.h"
+
+#if defined(__LINUX__) || defined(__MACOSX__) || defined(__FREEBSD__)
+#include <sys/resource.h>
+#define HAVE_PEAK_RSS 1
+#endif
+
+/* Peak resident set size of this process in kilobytes, or -1 if unknown */
+static long
+peak_rss(void)
+{
+#ifdef HAVE_PEAK_RSS
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#ifdef __MACOSX__
+        return usage.ru_maxrss / 1024;  /* bytes on Mac OS X */
+#else
+        return usage.ru_maxrss;
+#endif
+    }
+#endif
+    return -1;
+}
+
+static double
+elapsed_ms(Uint64 start)
+{
+    return ((SDL_GetPerformanceCounter() - start) * 1000.0) / SDL_GetPerformanceFrequency();
+}
+
+/* Write a stereo 44.1kHz IMA ADPCM file of noise, like a long ambience track */
+static int
+generate(const char *file, int seconds)
+{
+    const Uint16 channels = 2;
+    const Uint16 blockalign = 2048;
+    const Uint16 samplesperblock = (blockalign - 4 * channels) * 2 / channels + 1;
+    const Uint32 blocks = (Uint32) (((Sint64) seconds * 44100) / samplesperblock);
+    Uint32 seed = 12345;
+    Uint8 block[2048];
+    SDL_RWops *dst;
+    Uint32 b;
+    int i;
+
+    dst = SDL_RWFromFile(file, "wb");
+    if (dst == NULL) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't open %s: %s\n", file, SDL_GetError());
+        return 1;
+    }
+    SDL_WriteLE32(dst, 0x46464952);     /* RIFF */
+    SDL_WriteLE32(dst, 4 + 8 + 20 + 8 + blocks * blockalign);
+    SDL_WriteLE32(dst, 0x45564157);     /* WAVE */
+    SDL_WriteLE32(dst, 0x20746D66);     /* fmt */
+    SDL_WriteLE32(dst, 20);
+    SDL_WriteLE16(dst, 0x0011);         /* IMA ADPCM */
+    SDL_WriteLE16(dst, channels);
+    SDL_WriteLE32(dst, 44100);
+    SDL_WriteLE32(dst, (44100 * blockalign) / samplesperblock);
+    SDL_WriteLE16(dst, blockalign);
+    SDL_WriteLE16(dst, 4);
+    SDL_WriteLE16(dst, 2);
+    SDL_WriteLE16(dst, samplesperblock);
+    SDL_WriteLE32(dst, 0x61746164);     /* data */
+    SDL_WriteLE32(dst, blocks * blockalign);
+
+    for (b = 0; b < blocks; b++) {
+        for (i = 0; i < sizeof(block); i++) {
+            seed = seed * 1103515245 + 12345;
+            block[i] = (Uint8) (seed >> 16);
+        }
+        for (i = 0; i < channels; i++) {
+            block[i * 4 + 0] = 0;       /* first sample */
+            block[i * 4 + 1] = 0;
+            block[i * 4 + 2] = 20;      /* step index */
+            block[i * 4 + 3] = 0;       /* reserved */
+        }
+        if (SDL_RWwrite(dst, block, sizeof(block), 1) != 1) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't write %s: %s\n", file, SDL_GetError());
+            SDL_RWclose(dst);
+            return 1;
+        }
+    }
+    SDL_RWclose(dst);
+    SDL_Log("Wrote %u blocks (%.1f seconds) to %s\n", (unsigned int) blocks,
+            (double) blocks * samplesperblock / 44100.0, file);
+    return 0;
+}
+
+/* A cheap checksum, so both modes can be seen to decode the same data */
+static Uint32
+checksum(Uint32 sum, const Uint8 *buf, int len)
+{
+    int i;
+    for (i = 0; i < len; i++) {
+        sum = (sum ^ buf[i]) * 16777619u;
+    }
+    return sum;
+}
+
+static int
+run_load(const char *file)
+{
+    SDL_AudioSpec spec;
+    Uint8 *buf = NULL;
+    Uint32 len = 0;
+    Uint64 start = SDL_GetPerformanceCounter();
+    double ms;
+
+    if (SDL_LoadWAV(file, &spec, &buf, &len) == NULL) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't load %s: %s\n", file, SDL_GetError());
+        return 1;
+    }
+    /* Everything is decoded by the time the first sample is available */
+    ms = elapsed_ms(start);
+    SDL_Log("load:   first sample after %8.2f ms, all %u bytes after %8.2f ms, peak RSS %ld KB, checksum %08x\n",
+            ms, (unsigned int) len, ms, peak_rss(),
+            checksum(2166136261u, buf, len));
+    SDL_FreeWAV(buf);
+    return 0;
+}
+
+static int
+run_stream(const char *file)
+{
+    SDL_AudioSpec spec;
+    SDL_WAVStream *stream;
+    Uint8 buf[16384];
+    Uint32 sum = 2166136261u;
+    Uint32 total = 0;
+    double first = 0.0;
+    Uint64 start = SDL_GetPerformanceCounter();
+    int len;
+
+    stream = SDL_OpenWAVStream_RW(SDL_RWFromFile(file, "rb"), 1, &spec);
+    if (stream == NULL) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't open %s: %s\n", file, SDL_GetError());
+        return 1;
+    }
+    while ((len = SDL_ReadWAVStream(stream, buf, sizeof(buf))) > 0) {
+        if (total == 0) {
+            first = elapsed_ms(start);
+        }
+        sum = checksum(sum, buf, len);
+        total += len;
+    }
+    if (len < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't read %s: %s\n", file, SDL_GetError());
+    }
+    SDL_Log("stream: first sample after %8.2f ms, all %u bytes after %8.2f ms, peak RSS %ld KB, checksum %08x\n",
+            first, (unsigned int) total, elapsed_ms(start), peak_rss(), sum);
+    SDL_CloseWAVStream(stream);
+    return (len < 0) ? 1 : 0;
+}
+
+int
+main(int argc, char **argv)
+{
+    const char *mode;
+    int result = 0;
+
+    /* Enable standard application logging */
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    if ((argc == 4) && (SDL_strcmp(argv[1], "--generate") == 0)) {
+        return generate(argv[2], SDL_atoi(argv[3]));
+    }
+    if (argc < 2) {
+        SDL_Log("USAGE: %s file.wav [load|stream]\n"
+                "       %s --generate file.wav seconds\n", argv[0], argv[0]);
+        return 1;
+    }
+    mode = (argc > 2) ? argv[2] : NULL;
+
+    if (SDL_Init(0) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    SDL_Log("Baseline peak RSS %ld KB\n", peak_rss());
+    /* Streaming first, so the loader's peak doesn't hide it */
+    if (!mode || (SDL_strcmp(mode, "stream") == 0)) {
+        result |= run_stream(argv[1]);
+    }
+    if (!mode || (SDL_strcmp(mode, "load") == 0)) {
+        result |= run_load(argv[1]);
+    }
+
+    SDL_Quit();
+    return result;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
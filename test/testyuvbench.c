@@ -0,0 +1,148 @@
+/*
+  Copyright (C) 1997-2014 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Benchmark converting YUV video frames to RGB in the software renderer,
+   the way a video player would update a streaming texture every frame:
+     ./testyuvbench [JPEG|BT601|BT709] [iterations]
+
+   Each line is one YUV format at 1080p and 4K, with its throughput in
+   megapixels per second written.
+*/
+
+#include "SDL.h"
+
+static const Uint32 formats[] = {
+    SDL_PIXELFORMAT_YV12,
+    SDL_PIXELFORMAT_IYUV,
+    SDL_PIXELFORMAT_YUY2,
+    SDL_PIXELFORMAT_UYVY,
+    SDL_PIXELFORMAT_YVYU,
+    SDL_PIXELFORMAT_NV12,
+    SDL_PIXELFORMAT_NV21
+};
+
+static const struct
+{
+    int w, h;
+} sizes[] = {
+    { 1920, 1080 },
+    { 3840, 2160 }
+};
+
+/* Megapixels per second for updating a texture from a frame of noise */
+static double
+run(Uint32 format, int w, int h, int iterations)
+{
+    const int planar = (SDL_BYTESPERPIXEL(format) == 1);
+    const int pitch = planar ? w : w * 2;
+    const int size = planar ? (w * h + w * h / 2) : (w * h * 2);
+    SDL_Surface *surface;
+    SDL_Renderer *renderer;
+    SDL_Texture *texture;
+    Uint8 *frame;
+    Uint32 seed = 12345;
+    Uint64 start, ticks;
+    int i, status = 0;
+
+    surface = SDL_CreateRGBSurface(0, w, h, 32, 0x00FF0000, 0x0000FF00, 0x000000FF, 0);
+    frame = (Uint8 *) SDL_malloc(size);
+    if (!surface || !frame) {
+        SDL_FreeSurface(surface);
+        SDL_free(frame);
+        return -1.0;
+    }
+    for (i = 0; i < size; i++) {
+        seed = seed * 1103515245 + 12345;
+        frame[i] = (Uint8) (seed >> 16);
+    }
+
+    renderer = SDL_CreateSoftwareRenderer(surface);
+    texture = renderer ? SDL_CreateTexture(renderer, format, SDL_TEXTUREACCESS_STREAMING, w, h) : NULL;
+    if (!texture) {
+        if (renderer) {
+            SDL_DestroyRenderer(renderer);
+        }
+        SDL_FreeSurface(surface);
+        SDL_free(frame);
+        return -1.0;
+    }
+
+    /* The first update sets up the conversion tables */
+    SDL_UpdateTexture(texture, NULL, frame, pitch);
+    start = SDL_GetPerformanceCounter();
+    for (i = 0; i < iterations; i++) {
+        status |= SDL_UpdateTexture(texture, NULL, frame, pitch);
+    }
+    ticks = SDL_GetPerformanceCounter() - start;
+
+    SDL_DestroyTexture(texture);
+    SDL_DestroyRenderer(renderer);
+    SDL_FreeSurface(surface);
+    SDL_free(frame);
+
+    if (status < 0) {
+        return -1.0;
+    }
+    return ((double) w * h * iterations / 1000000.0) /
+           ((double) ticks / SDL_GetPerformanceFrequency());
+}
+
+int
+main(int argc, char **argv)
+{
+    int iterations = 20;
+    double mpps;
+    int i, j;
+
+    /* Enable standard application logging */
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    if (argc > 1) {
+        SDL_SetHint(SDL_HINT_YUV_CONVERSION_MODE, argv[1]);
+    }
+    if (argc > 2) {
+        iterations = SDL_atoi(argv[2]);
+    }
+    if (iterations <= 0) {
+        SDL_Log("USAGE: %s [JPEG|BT601|BT709] [iterations]\n", argv[0]);
+        return 1;
+    }
+
+    if (SDL_Init(0) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    SDL_Log("%d frames of each format, %s conversion, in megapixels per second\n",
+            iterations, (argc > 1) ? argv[1] : "default");
+    SDL_Log("%-24s  %10s  %10s\n", "", "1080p", "4K");
+    for (i = 0; i < SDL_arraysize(formats); i++) {
+        char line[128];
+        SDL_snprintf(line, sizeof(line), "%-24s", SDL_GetPixelFormatName(formats[i]));
+        for (j = 0; j < SDL_arraysize(sizes); j++) {
+            mpps = run(formats[i], sizes[j].w, sizes[j].h, iterations);
+            if (mpps < 0.0) {
+                SDL_Log("%s  failed: %s\n", line, SDL_GetError());
+                break;
+            }
+            SDL_snprintf(line + SDL_strlen(line), sizeof(line) - SDL_strlen(line), "  %10.1f", mpps);
+        }
+        if (j == SDL_arraysize(sizes)) {
+            SDL_Log("%s\n", line);
+        }
+    }
+
+    SDL_Quit();
+    return 0;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */